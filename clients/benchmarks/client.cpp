@@ -4,6 +4,8 @@
 
 #include "program_options.hpp"
 
+#include "../../library/src/include/rocblas_launch_tuning.hpp"
+#include "client_cache.hpp"
 #include "rocblas.h"
 #include "rocblas.hpp"
 #include "rocblas_data.hpp"
@@ -15,12 +17,17 @@
 #include <cctype>
 #include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <vector>
 // aux
+#include "testing_ostream_throughput.hpp"
 #include "testing_set_get_matrix.hpp"
 #include "testing_set_get_matrix_async.hpp"
 #include "testing_set_get_vector.hpp"
@@ -29,9 +36,11 @@
 #include "testing_asum.hpp"
 #include "testing_asum_batched.hpp"
 #include "testing_asum_strided_batched.hpp"
+#include "testing_axpby.hpp"
 #include "testing_axpy.hpp"
 #include "testing_axpy_batched.hpp"
 #include "testing_axpy_batched_ex.hpp"
+#include "testing_axpy_dot.hpp"
 #include "testing_axpy_ex.hpp"
 #include "testing_axpy_strided_batched.hpp"
 #include "testing_axpy_strided_batched_ex.hpp"
@@ -47,6 +56,7 @@
 #include "testing_iamax_iamin.hpp"
 #include "testing_iamax_iamin_batched.hpp"
 #include "testing_iamax_iamin_strided_batched.hpp"
+#include "testing_multi_dot.hpp"
 #include "testing_nrm2.hpp"
 #include "testing_nrm2_batched.hpp"
 #include "testing_nrm2_batched_ex.hpp"
@@ -72,6 +82,7 @@
 #include "testing_scal_batched.hpp"
 #include "testing_scal_batched_ex.hpp"
 #include "testing_scal_ex.hpp"
+#include "testing_scal_nrm2.hpp"
 #include "testing_scal_strided_batched.hpp"
 #include "testing_scal_strided_batched_ex.hpp"
 #include "testing_swap.hpp"
@@ -204,7 +215,9 @@ void run_function(const func_map& map, const Arguments& arg, const std::string&
 #include "testing_gemm.hpp"
 #include "testing_gemm_batched.hpp"
 #include "testing_gemm_batched_ex.hpp"
+#include "testing_gemm_grouped_batched_ex.hpp"
 #include "testing_gemm_ex.hpp"
+#include "testing_gemm_ex_epilogue.hpp"
 #include "testing_gemm_strided_batched.hpp"
 #include "testing_gemm_strided_batched_ex.hpp"
 #include "testing_trmm.hpp"
@@ -241,6 +254,9 @@ struct perf_gemm_ex<Ti,
         static const func_map map = {
             {"gemm_ex", testing_gemm_ex<Ti, To, Tc>},
             {"gemm_batched_ex", testing_gemm_batched_ex<Ti, To, Tc>},
+            {"gemm_grouped_batched_ex", testing_gemm_grouped_batched_ex<Ti, To, Tc>},
+            {"gemm_ex_epilogue", testing_gemm_ex_epilogue<Ti, To, Tc>},
+            {"gemm_strided_batched_ex_epilogue", testing_gemm_ex_epilogue<Ti, To, Tc>},
         };
         run_function(map, arg);
     }
@@ -289,6 +305,7 @@ struct perf_blas<T, U, std::enable_if_t<std::is_same<T, float>{} || std::is_same
                 {"set_get_vector_async", testing_set_get_vector_async<T>},
                 {"set_get_matrix", testing_set_get_matrix<T>},
                 {"set_get_matrix_async", testing_set_get_matrix_async<T>},
+                {"ostream_throughput", testing_ostream_throughput},
                 // L1
                 {"asum", testing_asum<T>},
                 {"asum_batched", testing_asum_batched<T>},
@@ -297,6 +314,18 @@ struct perf_blas<T, U, std::enable_if_t<std::is_same<T, float>{} || std::is_same
                 {"axpy_batched", testing_axpy_batched<T>},
                 {"axpy_strided_batched", testing_axpy_strided_batched<T>},
                 {"copy", testing_copy<T>},
+                {"axpby", testing_axpby<T>},
+                {"axpby_batched", testing_axpby_batched<T>},
+                {"axpby_strided_batched", testing_axpby_strided_batched<T>},
+                {"axpy_dot", testing_axpy_dot<T>},
+                {"axpy_dot_batched", testing_axpy_dot_batched<T>},
+                {"axpy_dot_strided_batched", testing_axpy_dot_strided_batched<T>},
+                {"multi_dot", testing_multi_dot<T>},
+                {"multi_dot_batched", testing_multi_dot_batched<T>},
+                {"multi_dot_strided_batched", testing_multi_dot_strided_batched<T>},
+                {"scal_nrm2", testing_scal_nrm2<T>},
+                {"scal_nrm2_batched", testing_scal_nrm2_batched<T>},
+                {"scal_nrm2_strided_batched", testing_scal_nrm2_strided_batched<T>},
                 {"copy_batched", testing_copy_batched<T>},
                 {"copy_strided_batched", testing_copy_strided_batched<T>},
                 {"dot", testing_dot<T>},
@@ -467,6 +496,18 @@ struct perf_blas<T,
                 {"axpy_batched", testing_axpy_batched<T>},
                 {"axpy_strided_batched", testing_axpy_strided_batched<T>},
                 {"copy", testing_copy<T>},
+                {"axpby", testing_axpby<T>},
+                {"axpby_batched", testing_axpby_batched<T>},
+                {"axpby_strided_batched", testing_axpby_strided_batched<T>},
+                {"axpy_dot", testing_axpy_dot<T>},
+                {"axpy_dot_batched", testing_axpy_dot_batched<T>},
+                {"axpy_dot_strided_batched", testing_axpy_dot_strided_batched<T>},
+                {"multi_dot", testing_multi_dot<T>},
+                {"multi_dot_batched", testing_multi_dot_batched<T>},
+                {"multi_dot_strided_batched", testing_multi_dot_strided_batched<T>},
+                {"scal_nrm2", testing_scal_nrm2<T>},
+                {"scal_nrm2_batched", testing_scal_nrm2_batched<T>},
+                {"scal_nrm2_strided_batched", testing_scal_nrm2_strided_batched<T>},
                 {"copy_batched", testing_copy_batched<T>},
                 {"copy_strided_batched", testing_copy_strided_batched<T>},
                 {"dot", testing_dot<T>},
@@ -883,6 +924,9 @@ int run_bench_test(Arguments& arg)
 {
     rocblas_initialize(); // Initialize rocBLAS
 
+    // In batch mode, where results are logged to a sink, only results go to standard output
+    auto& info = ArgumentModel_get_log_sink() ? rocblas_cerr : rocblas_cout;
+
     rocblas_cout << std::setiosflags(std::ios::fixed)
                  << std::setprecision(7); // Set precision to 7 digits
 
@@ -892,6 +936,9 @@ int run_bench_test(Arguments& arg)
     // enable timing check,otherwise no performance data collected
     arg.timing = 1;
 
+    // Samples left by a previous command which failed before logging them are not this one's
+    rocblas_timing_clear_last();
+
     // One stream and one thread (0 indicates to use default behavior)
     arg.streams = 0;
     arg.threads = 0;
@@ -912,23 +959,23 @@ int run_bench_test(Arguments& arg)
 
         if(arg.lda < min_lda)
         {
-            rocblas_cout << "rocblas-bench INFO: lda < min_lda, set lda = " << min_lda << std::endl;
+            info << "rocblas-bench INFO: lda < min_lda, set lda = " << min_lda << std::endl;
             arg.lda = min_lda;
         }
         if(arg.ldb < min_ldb)
         {
-            rocblas_cout << "rocblas-bench INFO: ldb < min_ldb, set ldb = " << min_ldb << std::endl;
+            info << "rocblas-bench INFO: ldb < min_ldb, set ldb = " << min_ldb << std::endl;
             arg.ldb = min_ldb;
         }
         if(arg.ldc < min_ldc)
         {
-            rocblas_cout << "rocblas-bench INFO: ldc < min_ldc, set ldc = " << min_ldc << std::endl;
+            info << "rocblas-bench INFO: ldc < min_ldc, set ldc = " << min_ldc << std::endl;
             arg.ldc = min_ldc;
         }
         if(!strcmp(function, "gemm") && arg.batch_count > 1)
         {
-            rocblas_cout << "rocblas-bench INFO: batch_count can only be 1 for function gemm"
-                         << ", set batch_count = 1" << std::endl;
+            info << "rocblas-bench INFO: batch_count can only be 1 for function gemm"
+                 << ", set batch_count = 1" << std::endl;
             arg.batch_count = 1;
         }
     }
@@ -940,17 +987,17 @@ int run_bench_test(Arguments& arg)
         rocblas_int min_ldc = arg.M;
         if(arg.lda < min_lda)
         {
-            rocblas_cout << "rocblas-bench INFO: lda < min_lda, set lda = " << min_lda << std::endl;
+            info << "rocblas-bench INFO: lda < min_lda, set lda = " << min_lda << std::endl;
             arg.lda = min_lda;
         }
         if(arg.ldb < min_ldb)
         {
-            rocblas_cout << "rocblas-bench INFO: ldb < min_ldb, set ldb = " << min_ldb << std::endl;
+            info << "rocblas-bench INFO: ldb < min_ldb, set ldb = " << min_ldb << std::endl;
             arg.ldb = min_ldb;
         }
         if(arg.ldc < min_ldc)
         {
-            rocblas_cout << "rocblas-bench INFO: ldc < min_ldc, set ldc = " << min_ldc << std::endl;
+            info << "rocblas-bench INFO: ldc < min_ldc, set ldc = " << min_ldc << std::endl;
             arg.ldc = min_ldc;
         }
 
@@ -977,13 +1024,15 @@ int run_bench_test(Arguments& arg)
         //      }
         if(arg.stride_c < min_stride_c)
         {
-            rocblas_cout << "rocblas-bench INFO: stride_c < min_stride_c, set stride_c = "
-                         << min_stride_c << std::endl;
+            info << "rocblas-bench INFO: stride_c < min_stride_c, set stride_c = "
+                 << min_stride_c << std::endl;
             arg.stride_c = min_stride_c;
         }
     }
 
-    if(!strcmp(function, "gemm_ex") || !strcmp(function, "gemm_batched_ex"))
+    if(!strcmp(function, "gemm_ex") || !strcmp(function, "gemm_batched_ex")
+       || !strcmp(function, "gemm_grouped_batched_ex") || !strcmp(function, "gemm_ex_epilogue")
+       || !strcmp(function, "gemm_strided_batched_ex_epilogue"))
     {
         // adjust dimension for GEMM routines
         rocblas_int min_lda = arg.transA == 'N' ? arg.M : arg.K;
@@ -993,28 +1042,28 @@ int run_bench_test(Arguments& arg)
 
         if(arg.lda < min_lda)
         {
-            rocblas_cout << "rocblas-bench INFO: lda < min_lda, set lda = " << min_lda << std::endl;
+            info << "rocblas-bench INFO: lda < min_lda, set lda = " << min_lda << std::endl;
             arg.lda = min_lda;
         }
         if(arg.ldb < min_ldb)
         {
-            rocblas_cout << "rocblas-bench INFO: ldb < min_ldb, set ldb = " << min_ldb << std::endl;
+            info << "rocblas-bench INFO: ldb < min_ldb, set ldb = " << min_ldb << std::endl;
             arg.ldb = min_ldb;
         }
         if(arg.ldc < min_ldc)
         {
-            rocblas_cout << "rocblas-bench INFO: ldc < min_ldc, set ldc = " << min_ldc << std::endl;
+            info << "rocblas-bench INFO: ldc < min_ldc, set ldc = " << min_ldc << std::endl;
             arg.ldc = min_ldc;
         }
         if(arg.ldd < min_ldd)
         {
-            rocblas_cout << "rocblas-bench INFO: ldd < min_ldd, set ldd = " << min_ldc << std::endl;
+            info << "rocblas-bench INFO: ldd < min_ldd, set ldd = " << min_ldc << std::endl;
             arg.ldd = min_ldd;
         }
         if(!strcmp(function, "gemm_ex") && arg.batch_count > 1)
         {
-            rocblas_cout << "rocblas-bench INFO: batch_count can only be 1 for function gemm_ex"
-                         << ", set batch_count = 1" << std::endl;
+            info << "rocblas-bench INFO: batch_count can only be 1 for function gemm_ex"
+                 << ", set batch_count = 1" << std::endl;
             arg.batch_count = 1;
         }
         rocblas_gemm_dispatch<perf_gemm_ex>(arg);
@@ -1028,29 +1077,29 @@ int run_bench_test(Arguments& arg)
         rocblas_int min_ldd = arg.M;
         if(arg.lda < min_lda)
         {
-            rocblas_cout << "rocblas-bench INFO: lda < min_lda, set lda = " << min_lda << std::endl;
+            info << "rocblas-bench INFO: lda < min_lda, set lda = " << min_lda << std::endl;
             arg.lda = min_lda;
         }
         if(arg.ldb < min_ldb)
         {
-            rocblas_cout << "rocblas-bench INFO: ldb < min_ldb, set ldb = " << min_ldb << std::endl;
+            info << "rocblas-bench INFO: ldb < min_ldb, set ldb = " << min_ldb << std::endl;
             arg.ldb = min_ldb;
         }
         if(arg.ldc < min_ldc)
         {
-            rocblas_cout << "rocblas-bench INFO: ldc < min_ldc, set ldc = " << min_ldc << std::endl;
+            info << "rocblas-bench INFO: ldc < min_ldc, set ldc = " << min_ldc << std::endl;
             arg.ldc = min_ldc;
         }
         if(arg.ldd < min_ldd)
         {
-            rocblas_cout << "rocblas-bench INFO: ldd < min_ldd, set ldd = " << min_ldc << std::endl;
+            info << "rocblas-bench INFO: ldd < min_ldd, set ldd = " << min_ldc << std::endl;
             arg.ldd = min_ldd;
         }
         rocblas_int min_stride_c = arg.ldc * arg.N;
         if(arg.stride_c < min_stride_c)
         {
-            rocblas_cout << "rocblas-bench INFO: stride_c < min_stride_c, set stride_c = "
-                         << min_stride_c << std::endl;
+            info << "rocblas-bench INFO: stride_c < min_stride_c, set stride_c = "
+                 << min_stride_c << std::endl;
             arg.stride_c = min_stride_c;
         }
 
@@ -1093,9 +1142,12 @@ int run_bench_test(Arguments& arg)
 
 int rocblas_bench_datafile()
 {
+    // Tests of the data file reuse handles and buffers, as in batch mode
+    rocblas_client_cache_enable(true);
     int ret = 0;
     for(Arguments arg : RocBLAS_TestData())
         ret |= run_bench_test(arg);
+    rocblas_client_cache_enable(false);
     test_cleanup::cleanup();
     return ret;
 }
@@ -1116,249 +1168,750 @@ void fix_batch(int argc, char* argv[])
         }
 }
 
-int main(int argc, char* argv[])
-try
+// Options of one rocblas-bench command. Batch mode parses one for each line of its file, so
+// that every line starts from the defaults.
+struct bench_options
 {
-    fix_batch(argc, argv);
-    Arguments   arg;
-    std::string function;
-    std::string precision;
-    std::string a_type;
-    std::string b_type;
-    std::string c_type;
-    std::string d_type;
-    std::string compute_type;
-    std::string initialization;
-    rocblas_int device_id;
-    bool        datafile            = rocblas_parse_data(argc, argv);
-    bool        atomics_not_allowed = false;
-    bool        log_function_name   = false;
-
-    options_description desc("rocblas-bench command line options");
-    desc.add_options()
-        // clang-format off
-        ("sizem,m",
-         value<rocblas_int>(&arg.M)->default_value(128),
-         "Specific matrix size: sizem is only applicable to BLAS-2 & BLAS-3: the number of "
-         "rows or columns in matrix.")
-
-        ("sizen,n",
-         value<rocblas_int>(&arg.N)->default_value(128),
-         "Specific matrix/vector size: BLAS-1: the length of the vector. BLAS-2 & "
-         "BLAS-3: the number of rows or columns in matrix")
-
-        ("sizek,k",
-         value<rocblas_int>(&arg.K)->default_value(128),
-         "Specific matrix size: BLAS-2: the number of sub or super-diagonals of A. BLAS-3: "
-         "the number of columns in A and rows in B.")
-
-        ("kl",
-         value<rocblas_int>(&arg.KL)->default_value(128),
-         "Specific matrix size: kl is only applicable to BLAS-2: The number of sub-diagonals "
-         "of the banded matrix A.")
-
-        ("ku",
-         value<rocblas_int>(&arg.KU)->default_value(128),
-         "Specific matrix size: ku is only applicable to BLAS-2: The number of super-diagonals "
-         "of the banded matrix A.")
-
-        ("lda",
-         value<rocblas_int>(&arg.lda)->default_value(128),
-         "Leading dimension of matrix A, is only applicable to BLAS-2 & BLAS-3.")
-
-        ("ldb",
-         value<rocblas_int>(&arg.ldb)->default_value(128),
-         "Leading dimension of matrix B, is only applicable to BLAS-2 & BLAS-3.")
-
-        ("ldc",
-         value<rocblas_int>(&arg.ldc)->default_value(128),
-         "Leading dimension of matrix C, is only applicable to BLAS-2 & BLAS-3.")
-
-        ("ldd",
-         value<rocblas_int>(&arg.ldd)->default_value(128),
-         "Leading dimension of matrix D, is only applicable to BLAS-EX ")
-
-        ("stride_a",
-         value<rocblas_int>(&arg.stride_a)->default_value(128*128),
-         "Specific stride of strided_batched matrix A, is only applicable to strided batched"
-         "BLAS-2 and BLAS-3: second dimension * leading dimension.")
-
-        ("stride_b",
-         value<rocblas_int>(&arg.stride_b)->default_value(128*128),
-         "Specific stride of strided_batched matrix B, is only applicable to strided batched"
-         "BLAS-2 and BLAS-3: second dimension * leading dimension.")
-
-        ("stride_c",
-         value<rocblas_int>(&arg.stride_c)->default_value(128*128),
-         "Specific stride of strided_batched matrix C, is only applicable to strided batched"
-         "BLAS-2 and BLAS-3: second dimension * leading dimension.")
-
-        ("stride_d",
-         value<rocblas_int>(&arg.stride_d)->default_value(128*128),
-         "Specific stride of strided_batched matrix D, is only applicable to strided batched"
-         "BLAS_EX: second dimension * leading dimension.")
-
-        ("stride_x",
-         value<rocblas_int>(&arg.stride_x)->default_value(128*128),
-         "Specific stride of strided_batched vector x, is only applicable to strided batched"
-         "BLAS_2: second dimension.")
-
-        ("stride_y",
-         value<rocblas_int>(&arg.stride_y)->default_value(128*128),
-         "Specific stride of strided_batched vector y, is only applicable to strided batched"
-         "BLAS_2: leading dimension.")
-
-        ("incx",
-         value<rocblas_int>(&arg.incx)->default_value(1),
-         "increment between values in x vector")
-
-        ("incy",
-         value<rocblas_int>(&arg.incy)->default_value(1),
-         "increment between values in y vector")
-
-        ("incb",
-         value<rocblas_int>(&arg.incb)->default_value(1),
-         "increment between values in b vector")
-
-        ("alpha",
-          value<double>(&arg.alpha)->default_value(1.0), "specifies the scalar alpha")
-
-        ("alphai",
-         value<double>(&arg.alphai)->default_value(0.0), "specifies the imaginary part of the scalar alpha")
-
-        ("beta",
-         value<double>(&arg.beta)->default_value(0.0), "specifies the scalar beta")
-
-        ("betai",
-         value<double>(&arg.betai)->default_value(0.0), "specifies the imaginary part of the scalar beta")
-
-        ("function,f",
-         value<std::string>(&function),
-         "BLAS function to test.")
-
-        ("precision,r",
-         value<std::string>(&precision)->default_value("f32_r"), "Precision. "
-         "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
-
-        ("a_type",
-         value<std::string>(&a_type), "Precision of matrix A. "
-         "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
-
-        ("b_type",
-         value<std::string>(&b_type), "Precision of matrix B. "
-         "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
-
-        ("c_type",
-         value<std::string>(&c_type), "Precision of matrix C. "
-         "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
+    Arguments           arg;
+    std::string         function;
+    std::string         precision;
+    std::string         a_type;
+    std::string         b_type;
+    std::string         c_type;
+    std::string         d_type;
+    std::string         compute_type;
+    std::string         initialization;
+    std::string         batch_file;
+    std::string         batch_format;
+    std::string         tune;
+    std::string         tune_sizes;
+    rocblas_int         device_id;
+    bool                atomics_not_allowed = false;
+    bool                log_function_name   = false;
+    bool                timing_samples      = false;
+    double              converge            = 0;
+    rocblas_int         converge_max_iters  = 0;
+    options_description desc{"rocblas-bench command line options"};
+    variables_map       vm;
+
+    bench_options()
+    {
+        desc.add_options()
+            // clang-format off
+            ("sizem,m",
+             value<rocblas_int>(&arg.M)->default_value(128),
+             "Specific matrix size: sizem is only applicable to BLAS-2 & BLAS-3: the number of "
+             "rows or columns in matrix.")
+
+            ("sizen,n",
+             value<rocblas_int>(&arg.N)->default_value(128),
+             "Specific matrix/vector size: BLAS-1: the length of the vector. BLAS-2 & "
+             "BLAS-3: the number of rows or columns in matrix")
+
+            ("sizek,k",
+             value<rocblas_int>(&arg.K)->default_value(128),
+             "Specific matrix size: BLAS-2: the number of sub or super-diagonals of A. BLAS-3: "
+             "the number of columns in A and rows in B.")
+
+            ("kl",
+             value<rocblas_int>(&arg.KL)->default_value(128),
+             "Specific matrix size: kl is only applicable to BLAS-2: The number of sub-diagonals "
+             "of the banded matrix A.")
+
+            ("ku",
+             value<rocblas_int>(&arg.KU)->default_value(128),
+             "Specific matrix size: ku is only applicable to BLAS-2: The number of super-diagonals "
+             "of the banded matrix A.")
+
+            ("lda",
+             value<rocblas_int>(&arg.lda)->default_value(128),
+             "Leading dimension of matrix A, is only applicable to BLAS-2 & BLAS-3.")
+
+            ("ldb",
+             value<rocblas_int>(&arg.ldb)->default_value(128),
+             "Leading dimension of matrix B, is only applicable to BLAS-2 & BLAS-3.")
+
+            ("ldc",
+             value<rocblas_int>(&arg.ldc)->default_value(128),
+             "Leading dimension of matrix C, is only applicable to BLAS-2 & BLAS-3.")
+
+            ("ldd",
+             value<rocblas_int>(&arg.ldd)->default_value(128),
+             "Leading dimension of matrix D, is only applicable to BLAS-EX ")
+
+            ("stride_a",
+             value<rocblas_int>(&arg.stride_a)->default_value(128*128),
+             "Specific stride of strided_batched matrix A, is only applicable to strided batched"
+             "BLAS-2 and BLAS-3: second dimension * leading dimension.")
+
+            ("stride_b",
+             value<rocblas_int>(&arg.stride_b)->default_value(128*128),
+             "Specific stride of strided_batched matrix B, is only applicable to strided batched"
+             "BLAS-2 and BLAS-3: second dimension * leading dimension.")
+
+            ("stride_c",
+             value<rocblas_int>(&arg.stride_c)->default_value(128*128),
+             "Specific stride of strided_batched matrix C, is only applicable to strided batched"
+             "BLAS-2 and BLAS-3: second dimension * leading dimension.")
+
+            ("stride_d",
+             value<rocblas_int>(&arg.stride_d)->default_value(128*128),
+             "Specific stride of strided_batched matrix D, is only applicable to strided batched"
+             "BLAS_EX: second dimension * leading dimension.")
+
+            ("stride_x",
+             value<rocblas_int>(&arg.stride_x)->default_value(128*128),
+             "Specific stride of strided_batched vector x, is only applicable to strided batched"
+             "BLAS_2: second dimension.")
+
+            ("stride_y",
+             value<rocblas_int>(&arg.stride_y)->default_value(128*128),
+             "Specific stride of strided_batched vector y, is only applicable to strided batched"
+             "BLAS_2: leading dimension.")
+
+            ("stride_z",
+             value<rocblas_int>(&arg.stride_d)->default_value(128*128),
+             "Specific stride of strided_batched vector z of axpy_dot. Same as --stride_d.")
+
+            ("incx",
+             value<rocblas_int>(&arg.incx)->default_value(1),
+             "increment between values in x vector")
+
+            ("incy",
+             value<rocblas_int>(&arg.incy)->default_value(1),
+             "increment between values in y vector")
+
+            ("incz",
+             value<rocblas_int>(&arg.incd)->default_value(1),
+             "increment between values in z vector of axpy_dot")
+
+            ("incb",
+             value<rocblas_int>(&arg.incb)->default_value(1),
+             "increment between values in b vector")
+
+            ("alpha",
+              value<double>(&arg.alpha)->default_value(1.0), "specifies the scalar alpha")
+
+            ("alphai",
+             value<double>(&arg.alphai)->default_value(0.0), "specifies the imaginary part of the scalar alpha")
+
+            ("beta",
+             value<double>(&arg.beta)->default_value(0.0), "specifies the scalar beta")
+
+            ("betai",
+             value<double>(&arg.betai)->default_value(0.0), "specifies the imaginary part of the scalar beta")
+
+            ("function,f",
+             value<std::string>(&function),
+             "BLAS function to test.")
+
+            ("precision,r",
+             value<std::string>(&precision)->default_value("f32_r"), "Precision. "
+             "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
+
+            ("a_type",
+             value<std::string>(&a_type), "Precision of matrix A. "
+             "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
+
+            ("b_type",
+             value<std::string>(&b_type), "Precision of matrix B. "
+             "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
+
+            ("c_type",
+             value<std::string>(&c_type), "Precision of matrix C. "
+             "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
+
+            ("d_type",
+             value<std::string>(&d_type), "Precision of matrix D. "
+             "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
+
+            ("compute_type",
+             value<std::string>(&compute_type), "Precision of computation. "
+             "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
+
+            ("initialization",
+             value<std::string>(&initialization)->default_value("rand_int"),
+             "Intialize with random integers, trig functions sin and cos, or hpl-like input. "
+             "Options: rand_int, trig_float, hpl")
+
+            ("transposeA",
+             value<char>(&arg.transA)->default_value('N'),
+             "N = no transpose, T = transpose, C = conjugate transpose")
+
+            ("transposeB",
+             value<char>(&arg.transB)->default_value('N'),
+             "N = no transpose, T = transpose, C = conjugate transpose")
+
+            ("side",
+             value<char>(&arg.side)->default_value('L'),
+             "L = left, R = right. Only applicable to certain routines")
+
+            ("uplo",
+             value<char>(&arg.uplo)->default_value('U'),
+             "U = upper, L = lower. Only applicable to certain routines") // xsymv xsyrk xsyr2k xtrsm xtrsm_ex
+                                                                         // xtrmm xtrsv
+            ("diag",
+             value<char>(&arg.diag)->default_value('N'),
+             "U = unit diagonal, N = non unit diagonal. Only applicable to certain routines") // xtrsm xtrsm_ex xtrsv xtrmm
+
+            ("batch_count",
+             value<rocblas_int>(&arg.batch_count)->default_value(1),
+             "Number of matrices. Only applicable to batched and strided_batched routines")
+
+            ("HMM",
+             value<bool>(&arg.HMM)->default_value(false),
+             "Parameter requesting the use of HipManagedMemory")
+
+            ("verify,v",
+             value<rocblas_int>(&arg.norm_check)->default_value(0),
+             "Validate GPU results with CPU? 0 = No, 1 = Yes (default: No)")
+
+            ("iters,i",
+             value<rocblas_int>(&arg.iters)->default_value(10),
+             "Iterations to run inside timing loop")
+
+            ("cold_iters,j",
+             value<rocblas_int>(&arg.cold_iters)->default_value(2),
+             "Cold Iterations to run before entering the timing loop")
+
+            ("timing_samples",
+             bool_switch(&timing_samples)->default_value(false),
+             "Time each iteration with HIP events, and report the distribution of the times. "
+             "Recording the events adds to the time of short iterations")
+
+            ("converge",
+             value<double>(&converge)->default_value(0),
+             "Run more batches of --iters iterations until the 95% confidence interval of the "
+             "mean time per iteration is within this fraction of the mean, e.g. 0.01 for 1%. "
+             "Implies --timing_samples. 0 runs a single batch")
+
+            ("converge_max_iters",
+             value<rocblas_int>(&converge_max_iters)->default_value(1000),
+             "Maximum number of iterations run by --converge")
+
+            ("algo",
+             value<uint32_t>(&arg.algo)->default_value(0),
+             "extended precision gemm algorithm")
+
+            ("solution_index",
+             value<int32_t>(&arg.solution_index)->default_value(0),
+             "extended precision gemm solution index")
+
+            ("flags",
+             value<uint32_t>(&arg.flags)->default_value(rocblas_gemm_flags_none),
+             "gemm_ex flags, 1: Use packed-i8, 0: (default) uses unpacked-i8, available on matrix-inst-supported device")
+
+            ("atomics_not_allowed",
+             bool_switch(&atomics_not_allowed)->default_value(false),
+             "Atomic operations with non-determinism in results are not allowed")
+
+            ("device",
+             value<rocblas_int>(&device_id)->default_value(0),
+             "Set default device to be used for subsequent program runs")
+
+            ("c_noalias_d",
+             bool_switch(&arg.c_noalias_d)->default_value(false),
+             "C and D are stored in separate memory")
+
+            ("fortran",
+             bool_switch(&arg.fortran)->default_value(false),
+             "Run using Fortran interface")
+
+            ("workspace",
+             value<size_t>(&arg.user_allocated_workspace)->default_value(0),
+             "Set fixed workspace memory size instead of using rocblas managed memory")
+
+            ("log_function_name",
+             bool_switch(&log_function_name)->default_value(false),
+             "Function name precedes other itmes.")
+
+            ("batch_file",
+             value<std::string>(&batch_file),
+             "Run the rocblas-bench command lines of a file, or - for standard input, in one "
+             "process which reuses its handle and buffers. Other options given with --batch_file "
+             "are defaults for every line.")
+
+            ("batch_format",
+             value<std::string>(&batch_format)->default_value("csv"),
+             "Format of --batch_file results. Options: csv, json (an object per line), yaml (a "
+             "list of flow mappings)")
+
+            ("tune",
+             value<std::string>(&tune),
+             "Time the launch configurations of a kernel, gemvn, gemvt or scal, at --tune_sizes "
+             "with the precision of -r and, for gemvt, --transposeA, and write the fastest as a "
+             "launch tuning table for ROCBLAS_LAUNCH_TUNING_FILE")
+
+            ("tune_sizes",
+             value<std::string>(&tune_sizes)->default_value("256,1024,4096,16384"),
+             "Comma separated sizes of --tune: m = n = lda for gemvn and gemvt, n for scal. "
+             "Sizes up to each one use the configuration fastest at it.")
+
+            ("help,h", "produces this help message")
+
+            ("version", "Prints the version number");
+        // clang-format on
+    }
 
-        ("d_type",
-         value<std::string>(&d_type), "Precision of matrix D. "
-         "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
+    void parse(int argc, char* argv[])
+    {
+        store(parse_command_line(argc, argv, desc), vm);
+        notify(vm);
+    }
 
-        ("compute_type",
-         value<std::string>(&compute_type), "Precision of computation. "
-         "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
+    // Check the options and convert them into arg
+    void finish()
+    {
+        arg.atomics_mode
+            = atomics_not_allowed ? rocblas_atomics_not_allowed : rocblas_atomics_allowed;
+
+        std::transform(precision.begin(), precision.end(), precision.begin(), ::tolower);
+        auto prec = string2rocblas_datatype(precision);
+        if(prec == static_cast<rocblas_datatype>(-1))
+            throw std::invalid_argument("Invalid value for --precision " + precision);
+
+        arg.a_type = a_type == "" ? prec : string2rocblas_datatype(a_type);
+        if(arg.a_type == static_cast<rocblas_datatype>(-1))
+            throw std::invalid_argument("Invalid value for --a_type " + a_type);
+
+        arg.b_type = b_type == "" ? prec : string2rocblas_datatype(b_type);
+        if(arg.b_type == static_cast<rocblas_datatype>(-1))
+            throw std::invalid_argument("Invalid value for --b_type " + b_type);
+
+        arg.c_type = c_type == "" ? prec : string2rocblas_datatype(c_type);
+        if(arg.c_type == static_cast<rocblas_datatype>(-1))
+            throw std::invalid_argument("Invalid value for --c_type " + c_type);
+
+        arg.d_type = d_type == "" ? prec : string2rocblas_datatype(d_type);
+        if(arg.d_type == static_cast<rocblas_datatype>(-1))
+            throw std::invalid_argument("Invalid value for --d_type " + d_type);
+
+        arg.compute_type = compute_type == "" ? prec : string2rocblas_datatype(compute_type);
+        if(arg.compute_type == static_cast<rocblas_datatype>(-1))
+            throw std::invalid_argument("Invalid value for --compute_type " + compute_type);
+
+        arg.initialization = string2rocblas_initialization(initialization);
+        if(arg.initialization == static_cast<rocblas_initialization>(-1))
+            throw std::invalid_argument("Invalid value for --initialization " + initialization);
+
+        if(arg.M < 0)
+            throw std::invalid_argument("Invalid value for -m " + std::to_string(arg.M));
+        if(arg.N < 0)
+            throw std::invalid_argument("Invalid value for -n " + std::to_string(arg.N));
+        if(arg.K < 0)
+            throw std::invalid_argument("Invalid value for -k " + std::to_string(arg.K));
+
+        int copied = snprintf(arg.function, sizeof(arg.function), "%s", function.c_str());
+        if(copied <= 0 || copied >= sizeof(arg.function))
+            throw std::invalid_argument("Invalid value for --function");
+    }
+};
 
-        ("initialization",
-         value<std::string>(&initialization)->default_value("rand_int"),
-         "Intialize with random integers, trig functions sin and cos, or hpl-like input. "
-         "Options: rand_int, trig_float, hpl")
+/*******************************************************************************
+ * Batch mode: run the command lines of a file in one process, as one CSV,
+ * JSON or YAML stream of results
+ ******************************************************************************/
 
-        ("transposeA",
-         value<char>(&arg.transA)->default_value('N'),
-         "N = no transpose, T = transpose, C = conjugate transpose")
+// The command being run, for the rows which its results are logged as
+struct batch_state
+{
+    std::string format = "csv";
+    size_t      line   = 0;
+    std::string command;
+    std::string header; // Last CSV header written
+};
 
-        ("transposeB",
-         value<char>(&arg.transB)->default_value('N'),
-         "N = no transpose, T = transpose, C = conjugate transpose")
+static batch_state batch;
 
-        ("side",
-         value<char>(&arg.side)->default_value('L'),
-         "L = left, R = right. Only applicable to certain routines")
+static std::string json_string(const std::string& s)
+{
+    std::string out = "\"";
+    for(unsigned char c : s)
+    {
+        if(c == '"' || c == '\\')
+            out += '\\';
+        if(c < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        }
+        else
+            out += c;
+    }
+    return out + '"';
+}
 
-        ("uplo",
-         value<char>(&arg.uplo)->default_value('U'),
-         "U = upper, L = lower. Only applicable to certain routines") // xsymv xsyrk xsyr2k xtrsm xtrsm_ex
-                                                                     // xtrmm xtrsv
-        ("diag",
-         value<char>(&arg.diag)->default_value('N'),
-         "U = unit diagonal, N = non unit diagonal. Only applicable to certain routines") // xtrsm xtrsm_ex xtrsv xtrmm
+// Numbers are written to JSON as they are, and other values as strings
+static std::string json_value(const std::string& s)
+{
+    char* end;
+    if(!s.empty() && (strtod(s.c_str(), &end), !*end) && s.find_first_of("xXnN") == s.npos)
+        return s;
+    return json_string(s);
+}
 
-        ("batch_count",
-         value<rocblas_int>(&arg.batch_count)->default_value(1),
-         "Number of matrices. Only applicable to batched and strided_batched routines")
+static std::vector<std::string> split_csv(const std::string& s)
+{
+    std::vector<std::string> fields;
+    std::istringstream       is(s);
+    for(std::string f; std::getline(is, f, ',');)
+    {
+        auto begin = f.find_first_not_of(' ');
+        fields.push_back(begin == f.npos ? "" : f.substr(begin));
+    }
+    return fields;
+}
 
-        ("HMM",
-         value<bool>(&arg.HMM)->default_value(false),
-         "Parameter requesting the use of HipManagedMemory")
+// A JSON object is also a YAML flow mapping, which is written as an item of a YAML list
+static const char* batch_item()
+{
+    return batch.format == "yaml" ? "- {" : "{";
+}
 
-        ("verify,v",
-         value<rocblas_int>(&arg.norm_check)->default_value(0),
-         "Validate GPU results with CPU? 0 = No, 1 = Yes (default: No)")
+// ArgumentModel_log_sink which writes a result of the current command
+static void batch_log(const std::string& names, const std::string& values)
+{
+    if(batch.format != "csv")
+    {
+        auto        n = split_csv(names), v = split_csv(values);
+        std::string obj = batch_item() + ("\"line\": " + std::to_string(batch.line))
+                          + ", \"command\": " + json_string(batch.command);
+        for(size_t i = 0; i < n.size() && i < v.size(); ++i)
+            obj += ", " + json_string(n[i]) + ": " + json_value(v[i]);
+        rocblas_cout << obj << "}" << std::endl;
+    }
+    else
+    {
+        // Write the header only when the columns change, e.g. between functions
+        if(names != batch.header)
+        {
+            rocblas_cout << "line," << names << "\n";
+            batch.header = names;
+        }
+        rocblas_cout << batch.line << "," << values << std::endl;
+    }
+}
 
-        ("iters,i",
-         value<rocblas_int>(&arg.iters)->default_value(10),
-         "Iterations to run inside timing loop")
+// Split a command line into arguments, dropping any rocblas-bench path and what precedes
+// it, such as environment variables, and anything from a shell redirection or pipe on
+static std::vector<std::string> batch_tokens(const std::string& line)
+{
+    std::vector<std::string> tokens;
+    std::string              token;
+    bool                     in_token = false;
+    char                     quote    = 0;
+    for(char c : line)
+    {
+        if(quote)
+        {
+            if(c == quote)
+                quote = 0;
+            else
+                token += c;
+        }
+        else if(c == '\'' || c == '"')
+        {
+            quote    = c;
+            in_token = true;
+        }
+        else if(isspace(static_cast<unsigned char>(c)))
+        {
+            if(in_token)
+                tokens.push_back(std::move(token));
+            token.clear();
+            in_token = false;
+        }
+        else
+        {
+            token += c;
+            in_token = true;
+        }
+    }
+    if(quote)
+        throw std::invalid_argument("Unterminated quote");
+    if(in_token)
+        tokens.push_back(std::move(token));
 
-        ("cold_iters,j",
-         value<rocblas_int>(&arg.cold_iters)->default_value(2),
-         "Cold Iterations to run before entering the timing loop")
+    for(size_t i = tokens.size(); i--;)
+    {
+        const auto& t = tokens[i];
+        if(t.size() >= 13 && !t.compare(t.size() - 13, 13, "rocblas-bench"))
+        {
+            tokens.erase(tokens.begin(), tokens.begin() + i + 1);
+            break;
+        }
+    }
 
-        ("algo",
-         value<uint32_t>(&arg.algo)->default_value(0),
-         "extended precision gemm algorithm")
+    auto shell = std::find_if(tokens.begin(), tokens.end(), [](const std::string& t) {
+        return (!t.empty() && strchr("|;&<>", t[0])) || t.find('>') != t.npos;
+    });
+    tokens.erase(shell, tokens.end());
+    return tokens;
+}
 
-        ("solution_index",
-         value<int32_t>(&arg.solution_index)->default_value(0),
-         "extended precision gemm solution index")
+int rocblas_bench_batch(const bench_options& defaults, const std::vector<char*>& default_args)
+{
+    if(defaults.batch_format != "csv" && defaults.batch_format != "json"
+       && defaults.batch_format != "yaml")
+        throw std::invalid_argument("Invalid value for --batch_format " + defaults.batch_format);
 
-        ("flags",
-         value<uint32_t>(&arg.flags)->default_value(rocblas_gemm_flags_none),
-         "gemm_ex flags, 1: Use packed-i8, 0: (default) uses unpacked-i8, available on matrix-inst-supported device")
+    std::ifstream file;
+    if(defaults.batch_file != "-")
+    {
+        file.open(defaults.batch_file);
+        if(!file)
+            throw std::invalid_argument("Cannot open --batch_file " + defaults.batch_file);
+    }
+    std::istream& is = defaults.batch_file == "-" ? std::cin : file;
 
-        ("atomics_not_allowed",
-         bool_switch(&atomics_not_allowed)->default_value(false),
-         "Atomic operations with non-determinism in results are not allowed")
+    batch.format = defaults.batch_format;
+    ArgumentModel_set_log_sink(batch_log);
+    rocblas_client_cache_enable(true);
 
-        ("device",
-         value<rocblas_int>(&device_id)->default_value(0),
-         "Set default device to be used for subsequent program runs")
+    size_t failed = 0;
+    for(std::string line; std::getline(is, line);)
+    {
+        ++batch.line;
+        auto begin = line.find_first_not_of(" \t\r");
+        if(begin == line.npos || line[begin] == '#')
+            continue;
+        batch.command = line.substr(begin, line.find_last_not_of(" \t\r") - begin + 1);
 
-        ("c_noalias_d",
-         bool_switch(&arg.c_noalias_d)->default_value(false),
-         "C and D are stored in separate memory")
+        try
+        {
+            auto tokens = batch_tokens(line);
+            if(tokens.empty())
+                continue;
+
+            // The options of the line follow, and so override, those given with --batch_file
+            std::vector<char*> args(default_args);
+            for(auto& t : tokens)
+                args.push_back(&t[0]);
+            args.push_back(nullptr);
+            fix_batch(int(args.size() - 1), args.data());
+
+            bench_options cmd;
+            cmd.parse(int(args.size() - 1), args.data());
+            if(cmd.vm.count("help") || cmd.vm.count("version") || !cmd.batch_file.empty()
+               || !cmd.tune.empty())
+                throw std::invalid_argument("--help, --version, --batch_file and --tune cannot be "
+                                            "used in a batch");
+            if(cmd.device_id != defaults.device_id)
+                throw std::invalid_argument("--device cannot change within a batch");
+            cmd.finish();
+            ArgumentModel_set_log_function_name(cmd.log_function_name);
+            rocblas_timing_set_samples(cmd.timing_samples);
+            rocblas_timing_set_convergence(cmd.converge, cmd.converge_max_iters);
+
+            run_bench_test(cmd.arg);
+        }
+        catch(const std::exception& e)
+        {
+            ++failed;
+            rocblas_cerr << "rocblas-bench: line " << batch.line << ": " << e.what() << std::endl;
+            if(batch.format != "csv")
+                rocblas_cout << batch_item() << "\"line\": " << batch.line
+                             << ", \"command\": " << json_string(batch.command)
+                             << ", \"error\": " << json_string(e.what()) << "}" << std::endl;
+        }
+    }
 
-        ("fortran",
-         bool_switch(&arg.fortran)->default_value(false),
-         "Run using Fortran interface")
+    rocblas_client_cache_enable(false);
+    ArgumentModel_set_log_sink(nullptr);
+    return failed ? -1 : 0;
+}
 
-        ("workspace",
-         value<size_t>(&arg.user_allocated_workspace)->default_value(0),
-         "Set fixed workspace memory size instead of using rocblas managed memory")
+/*******************************************************************************
+ * Tuning mode: time each launch configuration of a kernel at a list of sizes,
+ * and write the fastest as a launch tuning table
+ ******************************************************************************/
+
+// Microseconds per call at size n with each of the configurations of kernel
+template <typename T>
+std::vector<double> tune_times(const Arguments&     arg,
+                               rocblas_tuned_kernel kernel,
+                               rocblas_operation    trans,
+                               rocblas_int          n)
+{
+    bool           gemv = kernel != rocblas_tuned_kernel::scal;
+    size_t         rows = gemv ? n : 1;
+    host_vector<T> hA(rows * n), hx(n);
+    rocblas_seedrand();
+    rocblas_init(hA, rows, n, rows);
+    rocblas_init(hx, 1, n, 1);
+
+    device_vector<T> dA(rows * n), dx(n), dy(n);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_HIP_ERROR(dA.transfer_from(hA));
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+
+    rocblas_local_handle handle{arg};
+    hipStream_t          stream;
+    CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+
+    T    alpha = 1, beta = 0;
+    auto call  = [&] {
+        if(gemv)
+            CHECK_ROCBLAS_ERROR(
+                rocblas_gemv<T>(handle, trans, n, n, &alpha, dA, n, dx, 1, &beta, dy, 1));
+        else
+            CHECK_ROCBLAS_ERROR(rocblas_scal<T>(handle, n, &alpha, dx, 1));
+    };
 
-        ("log_function_name",
-         bool_switch(&log_function_name)->default_value(false),
-         "Function name precedes other itmes.")
+    std::vector<double> times;
+    for(auto& dims : rocblas_launch_tuning_configs(kernel))
+    {
+        // One entry for all sizes selects the configuration
+        rocblas_launch_tuning_table table;
+        table.add({kernel, 0, rocblas_type2datatype<T>(), 0, 0, INT64_MAX, 0, INT64_MAX, dims});
+        std::ostringstream text;
+        table.write(text);
+        CHECK_ROCBLAS_ERROR(rocblas_set_launch_tuning_table(handle, text.str().c_str()));
+
+        for(int iter = 0; iter < arg.cold_iters; iter++)
+            call();
+        double gpu_time_used = get_time_us_sync(stream);
+        for(int iter = 0; iter < arg.iters; iter++)
+            call();
+        times.push_back((get_time_us_sync(stream) - gpu_time_used) / arg.iters);
+    }
+    return times;
+}
 
-        ("help,h", "produces this help message")
+template <typename T>
+void rocblas_bench_tune(const Arguments&                arg,
+                        rocblas_tuned_kernel            kernel,
+                        rocblas_operation               trans,
+                        int                             arch,
+                        const std::vector<rocblas_int>& sizes)
+{
+    const auto& configs = rocblas_launch_tuning_configs(kernel);
+    rocblas_cout << "# size";
+    for(auto& dims : configs)
+        rocblas_cout << ' ' << dims.dim_x << 'x' << dims.dim_y << "_us";
+    rocblas_cout << '\n';
+
+    // Sizes up to each of sizes, and the last one without a bound, use the configuration
+    // which is fastest at it. Buckets with the same configuration are merged.
+    std::vector<rocblas_launch_tuning_entry> entries;
+    for(size_t i = 0; i < sizes.size(); ++i)
+    {
+        auto times = tune_times<T>(arg, kernel, trans, sizes[i]);
+        auto best  = std::min_element(times.begin(), times.end()) - times.begin();
+        rocblas_cout << "# " << sizes[i];
+        for(double t : times)
+            rocblas_cout << ' ' << t;
+        rocblas_cout << std::endl;
+
+        int64_t bound = i + 1 == sizes.size() ? INT64_MAX : sizes[i];
+        if(!entries.empty() && entries.back().dims == configs[best])
+            entries.back().m_max = bound;
+        else
+            entries.push_back({kernel,
+                               arch,
+                               rocblas_type2datatype<T>(),
+                               kernel == rocblas_tuned_kernel::gemvt
+                                   ? rocblas_launch_tuning_table::trans_char(trans)
+                                   : char(0),
+                               0,
+                               bound,
+                               0,
+                               INT64_MAX,
+                               configs[best]});
+
+        // Both of gemv's dimensions are bounded, so that the first entry matches max(m, n)
+        if(kernel != rocblas_tuned_kernel::scal)
+            entries.back().n_max = entries.back().m_max;
+    }
 
-        ("version", "Prints the version number");
-    // clang-format on
+    rocblas_launch_tuning_table table;
+    for(auto& entry : entries)
+        table.add(entry);
+    table.write(rocblas_cout);
+    rocblas_cout.flush();
+}
 
-    arg.atomics_mode = atomics_not_allowed ? rocblas_atomics_not_allowed : rocblas_atomics_allowed;
+int rocblas_bench_tune(const bench_options& options)
+{
+    const Arguments& arg = options.arg;
 
-    variables_map vm;
-    store(parse_command_line(argc, argv, desc), vm);
-    notify(vm);
+    rocblas_tuned_kernel kernel;
+    rocblas_operation    trans = rocblas_operation_none;
+    if(options.tune == "gemvn")
+        kernel = rocblas_tuned_kernel::gemvn;
+    else if(options.tune == "gemvt")
+    {
+        kernel = rocblas_tuned_kernel::gemvt;
+        trans  = arg.transA == 'C' ? rocblas_operation_conjugate_transpose
+                                   : rocblas_operation_transpose;
+    }
+    else if(options.tune == "scal")
+        kernel = rocblas_tuned_kernel::scal;
+    else
+        throw std::invalid_argument("Invalid value for --tune " + options.tune);
 
-    if((argc <= 1 && !datafile) || vm.count("help"))
+    std::vector<rocblas_int> sizes;
+    std::istringstream       list(options.tune_sizes);
+    for(std::string s; std::getline(list, s, ',');)
     {
-        rocblas_cout << desc << std::endl;
+        char* end;
+        long  size = strtol(s.c_str(), &end, 10);
+        if(s.empty() || *end || size <= 0 || size > std::numeric_limits<rocblas_int>::max())
+            throw std::invalid_argument("Invalid value for --tune_sizes " + options.tune_sizes);
+        sizes.push_back(rocblas_int(size));
+    }
+    if(sizes.empty() || arg.iters <= 0)
+        throw std::invalid_argument("--tune needs --tune_sizes and --iters");
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+
+    hipDeviceProp_t props;
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&props, options.device_id));
+
+    rocblas_cout << "# rocblas-bench --tune " << options.tune << " -r "
+                 << rocblas_datatype2string(arg.a_type) << " on " << props.gcnArchName
+                 << "\n# Load with ROCBLAS_LAUNCH_TUNING_FILE or rocblas_set_launch_tuning_table\n";
+
+    switch(arg.a_type)
+    {
+    case rocblas_datatype_f32_r:
+        rocblas_bench_tune<float>(arg, kernel, trans, props.gcnArch, sizes);
+        break;
+    case rocblas_datatype_f64_r:
+        rocblas_bench_tune<double>(arg, kernel, trans, props.gcnArch, sizes);
+        break;
+    case rocblas_datatype_f32_c:
+        rocblas_bench_tune<rocblas_float_complex>(arg, kernel, trans, props.gcnArch, sizes);
+        break;
+    case rocblas_datatype_f64_c:
+        rocblas_bench_tune<rocblas_double_complex>(arg, kernel, trans, props.gcnArch, sizes);
+        break;
+    default:
+        throw std::invalid_argument("--tune supports precisions s, d, c and z");
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+try
+{
+    fix_batch(argc, argv);
+    bool          datafile = rocblas_parse_data(argc, argv);
+    bench_options options;
+    options.parse(argc, argv);
+    Arguments& arg = options.arg;
+
+    if((argc <= 1 && !datafile) || options.vm.count("help"))
+    {
+        rocblas_cout << options.desc << std::endl;
         return 0;
     }
 
-    if(vm.find("version") != vm.end())
+    if(options.vm.find("version") != options.vm.end())
     {
         char blas_version[100];
         rocblas_get_version_string(blas_version, sizeof(blas_version));
@@ -1366,59 +1919,46 @@ try
         return 0;
     }
 
-    ArgumentModel_set_log_function_name(log_function_name);
+    ArgumentModel_set_log_function_name(options.log_function_name);
+    rocblas_timing_set_samples(options.timing_samples);
+    rocblas_timing_set_convergence(options.converge, options.converge_max_iters);
 
-    // Device Query
-    rocblas_int device_count = query_device_property();
+    // Device Query; in batch and tuning modes only results go to standard output
+    bool        batch_mode   = !options.batch_file.empty();
+    bool        tune_mode    = !options.tune.empty();
+    auto&       info         = batch_mode || tune_mode ? rocblas_cerr : rocblas_cout;
+    rocblas_int device_count = query_device_property(info);
 
-    rocblas_cout << std::endl;
-    if(device_count <= device_id)
+    info << std::endl;
+    if(device_count <= options.device_id)
         throw std::invalid_argument("Invalid Device ID");
-    set_device(device_id);
+    set_device(options.device_id);
 
     if(datafile)
         return rocblas_bench_datafile();
 
-    std::transform(precision.begin(), precision.end(), precision.begin(), ::tolower);
-    auto prec = string2rocblas_datatype(precision);
-    if(prec == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --precision " + precision);
-
-    arg.a_type = a_type == "" ? prec : string2rocblas_datatype(a_type);
-    if(arg.a_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --a_type " + a_type);
-
-    arg.b_type = b_type == "" ? prec : string2rocblas_datatype(b_type);
-    if(arg.b_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --b_type " + b_type);
-
-    arg.c_type = c_type == "" ? prec : string2rocblas_datatype(c_type);
-    if(arg.c_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --c_type " + c_type);
-
-    arg.d_type = d_type == "" ? prec : string2rocblas_datatype(d_type);
-    if(arg.d_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --d_type " + d_type);
-
-    arg.compute_type = compute_type == "" ? prec : string2rocblas_datatype(compute_type);
-    if(arg.compute_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --compute_type " + compute_type);
-
-    arg.initialization = string2rocblas_initialization(initialization);
-    if(arg.initialization == static_cast<rocblas_initialization>(-1))
-        throw std::invalid_argument("Invalid value for --initialization " + initialization);
-
-    if(arg.M < 0)
-        throw std::invalid_argument("Invalid value for -m " + std::to_string(arg.M));
-    if(arg.N < 0)
-        throw std::invalid_argument("Invalid value for -n " + std::to_string(arg.N));
-    if(arg.K < 0)
-        throw std::invalid_argument("Invalid value for -k " + std::to_string(arg.K));
+    if(batch_mode)
+    {
+        // Every line starts from the other options on the command line
+        std::vector<char*> default_args{argv[0]};
+        for(int i = 1; i < argc; ++i)
+        {
+            if(!strcmp(argv[i], "--batch_file") || !strcmp(argv[i], "--batch_format"))
+                ++i;
+            else if(strncmp(argv[i], "--batch_file=", 13)
+                    && strncmp(argv[i], "--batch_format=", 15))
+                default_args.push_back(argv[i]);
+        }
+        return rocblas_bench_batch(options, default_args);
+    }
 
-    int copied = snprintf(arg.function, sizeof(arg.function), "%s", function.c_str());
-    if(copied <= 0 || copied >= sizeof(arg.function))
-        throw std::invalid_argument("Invalid value for --function");
+    if(tune_mode)
+    {
+        options.finish();
+        return rocblas_bench_tune(options);
+    }
 
+    options.finish();
     return run_bench_test(arg);
 }
 catch(const std::invalid_argument& exp)
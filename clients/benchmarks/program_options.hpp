@@ -342,6 +342,23 @@ namespace roc
 
                         return; // Return successfully
                     }
+
+                    // A long option with a value may also be given as --option=value
+                    std::string with_value = prefix + tok->str() + "=";
+                    if(tok->length() > 1 && opt.get_val().get()
+                       && !with_value.compare(0, with_value.size(), *argv, with_value.size()))
+                    {
+                        char*  val      = *argv + with_value.size();
+                        char** val_argv = &val;
+                        int    val_argc = 1;
+                        opt.set_val(val_argc, val_argv, prefix + tok->str());
+                        ++argv;
+                        --argc;
+
+                        vm[canonical_name] = variable_value(opt.get_val());
+
+                        return;
+                    }
                 }
             }
 
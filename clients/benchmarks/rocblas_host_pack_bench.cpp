@@ -0,0 +1,228 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+// rocblas-host-pack-bench measures the host side of strided rocblas_set_vector
+// and rocblas_get_vector: gathering a strided host vector into a contiguous
+// buffer and scattering it back. It compares a scalar memcpy loop with the
+// packing engine run on one thread and on the host thread pool, and needs no
+// GPU. The pool size is set with ROCBLAS_HOST_PACK_THREADS.
+//
+// With --set_get, it also times rocblas_set_vector and rocblas_get_vector end
+// to end between the strided host vector and a contiguous device vector, as
+// the "rocblas" row, so the packing can be compared with the whole call. Its
+// bandwidth counts the same bytes as the other rows.
+
+#include "../../library/src/include/rocblas_host_pack.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <hip/hip_runtime_api.h>
+#include <iostream>
+#include <limits>
+#include <rocblas.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    void check(hipError_t err, const char* what)
+    {
+        if(err != hipSuccess)
+            throw std::runtime_error(std::string(what) + ": " + hipGetErrorString(err));
+    }
+
+    void check(rocblas_status status, const char* what)
+    {
+        if(status != rocblas_status_success)
+            throw std::runtime_error(std::string(what) + ": " + rocblas_status_to_string(status));
+    }
+
+    // Best time in seconds of reps runs of fn
+    template <typename F>
+    double best_seconds(int reps, F&& fn)
+    {
+        double best = 1e30;
+        for(int r = 0; r < reps; ++r)
+        {
+            auto start = clock_type::now();
+            fn();
+            best = std::min(
+                best, std::chrono::duration<double>(clock_type::now() - start).count());
+        }
+        return best;
+    }
+
+    void scalar_copy(char*       dst,
+                     ptrdiff_t   dinc,
+                     const char* src,
+                     ptrdiff_t   sinc,
+                     size_t      n,
+                     size_t      elem_size)
+    {
+        for(size_t i = 0; i < n; ++i)
+            memcpy(dst + i * dinc * elem_size, src + i * sinc * elem_size, elem_size);
+    }
+
+    // Best times of strided host <-> contiguous device rocblas_set_vector and
+    // rocblas_get_vector, after one untimed call of each which sets up the
+    // staging buffers
+    std::pair<double, double> set_get_seconds(
+        std::vector<char>& strided, size_t n, size_t elem_size, ptrdiff_t inc, int reps)
+    {
+        constexpr size_t max_int = std::numeric_limits<rocblas_int>::max();
+        if(n > max_int || elem_size > max_int || size_t(inc) > max_int)
+            throw std::invalid_argument("N, elem_size and inc must fit in rocblas_int");
+
+        void* d = nullptr;
+        check(hipMalloc(&d, n * elem_size), "hipMalloc");
+        auto set = [&] {
+            check(rocblas_set_vector(n, elem_size, strided.data(), inc, d, 1),
+                  "rocblas_set_vector");
+        };
+        auto get = [&] {
+            check(rocblas_get_vector(n, elem_size, d, 1, strided.data(), inc),
+                  "rocblas_get_vector");
+        };
+        set();
+        get();
+        std::pair<double, double> seconds{best_seconds(reps, set), best_seconds(reps, get)};
+        check(hipFree(d), "hipFree");
+        return seconds;
+    }
+
+    void run(size_t n, size_t elem_size, ptrdiff_t inc, int reps, bool set_get, bool header)
+    {
+        std::vector<char> strided((n - 1) * inc * elem_size + elem_size, 1);
+        std::vector<char> packed(n * elem_size, 2);
+        double            gbytes = 2e-9 * n * elem_size; // read and written
+
+        rocblas_host_pack_config serial, parallel;
+        serial.pool = nullptr;
+
+        struct
+        {
+            const char* name;
+            double      gather, scatter;
+        } results[] = {
+            {"scalar",
+             best_seconds(
+                 reps,
+                 [&] { scalar_copy(packed.data(), 1, strided.data(), inc, n, elem_size); }),
+             best_seconds(
+                 reps,
+                 [&] { scalar_copy(strided.data(), inc, packed.data(), 1, n, elem_size); })},
+            {"serial",
+             best_seconds(reps,
+                          [&] {
+                              rocblas_host_strided_copy(
+                                  packed.data(), 1, strided.data(), inc, n, elem_size, serial);
+                          }),
+             best_seconds(reps,
+                          [&] {
+                              rocblas_host_strided_copy(
+                                  strided.data(), inc, packed.data(), 1, n, elem_size, serial);
+                          })},
+            {"parallel",
+             best_seconds(reps,
+                          [&] {
+                              rocblas_host_strided_copy(
+                                  packed.data(), 1, strided.data(), inc, n, elem_size, parallel);
+                          }),
+             best_seconds(reps,
+                          [&] {
+                              rocblas_host_strided_copy(
+                                  strided.data(), inc, packed.data(), 1, n, elem_size, parallel);
+                          })},
+        };
+
+        if(header)
+            std::cout << "method,threads,N,elem_size,inc,gather_GBps,scatter_GBps\n";
+        for(const auto& r : results)
+            std::cout << r.name << ','
+                      << (r.name[0] == 'p' ? parallel.pool->concurrency() : size_t(1)) << ','
+                      << n << ',' << elem_size << ',' << inc << ',' << gbytes / r.gather << ','
+                      << gbytes / r.scatter << '\n';
+
+        // The library packs with its own pool, sized by the same variable
+        if(set_get)
+        {
+            auto seconds = set_get_seconds(strided, n, elem_size, inc, reps);
+            std::cout << "rocblas," << parallel.pool->concurrency() << ',' << n << ','
+                      << elem_size << ',' << inc << ',' << gbytes / seconds.first << ','
+                      << gbytes / seconds.second << '\n';
+        }
+        std::cout.flush();
+    }
+
+    void usage(const char* prog)
+    {
+        std::cerr << "Usage: " << prog
+                  << " [-n N] [--elem_size S] [--inc I] [--iters R] [--set_get]"
+                  << " [--no-header]\n\n"
+                  << "Measures host gather/scatter bandwidth of strided vectors, as CSV.\n"
+                  << "  -n           number of elements (default 4194304)\n"
+                  << "  --elem_size  element size in bytes (default 4)\n"
+                  << "  --inc        stride of the strided vector in elements (default 2)\n"
+                  << "  --iters      runs per method, of which the best is reported (default 10)\n"
+                  << "  --set_get    also time rocblas_set/get_vector with a device vector,\n"
+                  << "               which needs a GPU\n"
+                  << "  --no-header  omit the CSV header, for appending repeated runs\n"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+try
+{
+    size_t    n         = 4194304;
+    size_t    elem_size = 4;
+    ptrdiff_t inc       = 2;
+    int       reps      = 10;
+    bool      set_get   = false;
+    bool      header    = true;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        auto value = [&] {
+            if(++i >= argc)
+                throw std::invalid_argument(std::string("missing value for ") + argv[i - 1]);
+            return argv[i];
+        };
+        if(!strcmp(argv[i], "-n"))
+            n = strtoull(value(), nullptr, 0);
+        else if(!strcmp(argv[i], "--elem_size"))
+            elem_size = strtoull(value(), nullptr, 0);
+        else if(!strcmp(argv[i], "--inc"))
+            inc = atol(value());
+        else if(!strcmp(argv[i], "--iters"))
+            reps = atoi(value());
+        else if(!strcmp(argv[i], "--set_get"))
+            set_get = true;
+        else if(!strcmp(argv[i], "--no-header"))
+            header = false;
+        else
+        {
+            usage(argv[0]);
+            return strcmp(argv[i], "-h") && strcmp(argv[i], "--help") ? EXIT_FAILURE
+                                                                      : EXIT_SUCCESS;
+        }
+    }
+
+    if(!n || !elem_size || inc <= 0 || reps <= 0)
+        throw std::invalid_argument("N, elem_size, inc and iters must be positive");
+
+    run(n, elem_size, inc, reps, set_get, header);
+    return EXIT_SUCCESS;
+}
+catch(const std::exception& e)
+{
+    std::cerr << "rocblas-host-pack-bench: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
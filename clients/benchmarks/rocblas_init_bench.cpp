@@ -0,0 +1,188 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+// rocblas-init-bench measures the throughput of the clients' random matrix
+// initialization. For each size it reports the time of the previous
+// initialization (row-major loops drawing from one std::mt19937) and of
+// rocblas_init, which fills columns with a counter-based generator on the
+// OpenMP threads, and checks that rocblas_init gives the same values on one
+// thread as on all of them. It needs no GPU; the number of threads is set with
+// OMP_NUM_THREADS.
+
+#include "rocblas_init.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <omp.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // Best time in milliseconds of reps runs of fn
+    template <typename F>
+    double best_ms(int reps, F&& fn)
+    {
+        double best = 1e30;
+        for(int r = 0; r < reps; ++r)
+        {
+            auto start = clock_type::now();
+            fn();
+            best = std::min(
+                best, std::chrono::duration<double, std::milli>(clock_type::now() - start).count());
+        }
+        return best;
+    }
+
+    // The initialization before it was counter-based: rows outer, one generator
+    template <typename T>
+    void serial_init(T* A, size_t M, size_t N, size_t lda, size_t stride, size_t batch_count)
+    {
+        for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
+            for(size_t i = 0; i < M; ++i)
+                for(size_t j = 0; j < N; ++j)
+                    A[i + j * lda + i_batch * stride] = random_generator<T>();
+    }
+
+    template <typename T>
+    void run(const char* precision, size_t n, size_t batch_count, int reps, bool header)
+    {
+        size_t         lda    = n;
+        size_t         stride = n * lda;
+        std::vector<T> A(stride * batch_count);
+
+        double serial_ms
+            = best_ms(reps, [&] { serial_init<T>(A.data(), n, n, lda, stride, batch_count); });
+        double counter_ms
+            = best_ms(reps, [&] { rocblas_init<T>(A.data(), n, n, lda, stride, batch_count); });
+
+        // The values only depend on the seed, not on the number of threads
+        std::vector<T> B(A.size());
+        int            threads = omp_get_max_threads();
+        rocblas_seedrand();
+        rocblas_init<T>(A.data(), n, n, lda, stride, batch_count);
+        omp_set_num_threads(1);
+        rocblas_seedrand();
+        rocblas_init<T>(B.data(), n, n, lda, stride, batch_count);
+        omp_set_num_threads(threads);
+        bool same = !memcmp(A.data(), B.data(), sizeof(T) * A.size());
+
+        double gbytes = 1e-9 * sizeof(T) * A.size();
+        if(header)
+            std::cout << "precision,threads,M,N,batch_count,GB,serial_ms,counter_ms,counter_GB/s,"
+                         "speedup,thread_invariant\n";
+        std::cout << precision << ',' << threads << ',' << n << ',' << n << ',' << batch_count
+                  << ',' << gbytes << ',' << serial_ms << ',' << counter_ms << ','
+                  << gbytes / counter_ms * 1e3 << ',' << serial_ms / counter_ms << ','
+                  << (same ? "yes" : "no") << std::endl;
+        if(!same)
+            throw std::runtime_error("rocblas_init depends on the number of threads");
+    }
+
+    void usage(const char* prog)
+    {
+        std::cerr << "Usage: " << prog
+                  << " [--sizes N,...] [--batch_count B] [--precision s|d|h|c|z|all]"
+                     " [--iters R] [--no-header]\n\n"
+                  << "Measures the initialization of square random matrices, as CSV.\n"
+                  << "  --sizes        comma separated M = N = lda (default 4096,16384)\n"
+                  << "  --batch_count  number of matrices, with stride M * lda (default 1)\n"
+                  << "  --precision    s, d, h, c or z, or all (default all)\n"
+                  << "  --iters        runs per measurement, of which the best is reported"
+                     " (default 1)\n"
+                  << "  --no-header    omit the CSV header, for appending repeated runs\n"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+try
+{
+    std::vector<size_t> sizes{4096, 16384};
+    std::string         precision   = "all";
+    size_t              batch_count = 1;
+    int                 reps        = 1;
+    bool                header      = true;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        auto value = [&] {
+            if(++i >= argc)
+                throw std::invalid_argument(std::string("missing value for ") + argv[i - 1]);
+            return argv[i];
+        };
+        if(!strcmp(argv[i], "--sizes"))
+        {
+            sizes.clear();
+            std::istringstream list(value());
+            for(std::string s; std::getline(list, s, ',');)
+                sizes.push_back(strtoull(s.c_str(), nullptr, 0));
+        }
+        else if(!strcmp(argv[i], "--batch_count"))
+            batch_count = strtoull(value(), nullptr, 0);
+        else if(!strcmp(argv[i], "--precision"))
+            precision = value();
+        else if(!strcmp(argv[i], "--iters"))
+            reps = atoi(value());
+        else if(!strcmp(argv[i], "--no-header"))
+            header = false;
+        else
+        {
+            usage(argv[0]);
+            return strcmp(argv[i], "-h") && strcmp(argv[i], "--help") ? EXIT_FAILURE
+                                                                      : EXIT_SUCCESS;
+        }
+    }
+
+    if(reps <= 0 || !batch_count || sizes.empty()
+       || std::any_of(sizes.begin(), sizes.end(), [](size_t n) { return !n || n > INT32_MAX; }))
+        throw std::invalid_argument("sizes, batch_count and iters must be positive");
+    if(precision != "s" && precision != "d" && precision != "h" && precision != "c"
+       && precision != "z" && precision != "all")
+        throw std::invalid_argument("precision must be s, d, h, c, z or all");
+
+    auto selected = [&](const char* p) { return precision == "all" || precision == p; };
+    for(size_t n : sizes)
+    {
+        if(selected("s"))
+        {
+            run<float>("s", n, batch_count, reps, header);
+            header = false;
+        }
+        if(selected("d"))
+        {
+            run<double>("d", n, batch_count, reps, header);
+            header = false;
+        }
+        if(selected("h"))
+        {
+            run<rocblas_half>("h", n, batch_count, reps, header);
+            header = false;
+        }
+        if(selected("c"))
+        {
+            run<rocblas_float_complex>("c", n, batch_count, reps, header);
+            header = false;
+        }
+        if(selected("z"))
+        {
+            run<rocblas_double_complex>("z", n, batch_count, reps, header);
+            header = false;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+catch(const std::exception& e)
+{
+    std::cerr << "rocblas-init-bench: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
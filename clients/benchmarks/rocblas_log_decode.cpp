@@ -0,0 +1,95 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+// rocblas-log-decode converts the binary trace and bench logs written with
+// ROCBLAS_LOG_BINARY=1 back into the text that rocBLAS writes by default:
+// comma-separated trace lines and rocblas-bench command lines.
+
+#include "../include/rocblas_log_decoder.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace
+{
+    using rocblas_binary_log::decoder;
+
+    void usage(const char* prog)
+    {
+        std::cerr << "Usage: " << prog << " [--trace | --bench] [--timestamps] file...\n\n"
+                  << "Converts binary logs written with ROCBLAS_LOG_BINARY=1 to text.\n"
+                  << "  --trace       output only log_trace lines\n"
+                  << "  --bench       output only rocblas-bench command lines\n"
+                  << "  --timestamps  prefix each line with the time it was logged\n"
+                  << "A file name of - reads standard input." << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+try
+{
+    bool                     want_trace = true;
+    bool                     want_bench = true;
+    bool                     timestamps = false;
+    std::vector<std::string> files;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(!strcmp(argv[i], "--trace"))
+            want_bench = false;
+        else if(!strcmp(argv[i], "--bench"))
+            want_trace = false;
+        else if(!strcmp(argv[i], "--timestamps"))
+            timestamps = true;
+        else if(!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help"))
+        {
+            usage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        else
+            files.push_back(argv[i]);
+    }
+
+    if(files.empty() || (!want_trace && !want_bench))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    decoder dec(want_trace, want_bench, timestamps);
+    for(const auto& file : files)
+    {
+        if(file == "-")
+        {
+#ifdef WIN32
+            // Standard input is opened in text mode, which would translate bytes of the records
+            _setmode(_fileno(stdin), _O_BINARY);
+#endif
+            dec.decode(std::cin, std::cout);
+        }
+        else
+        {
+            std::ifstream in(file, std::ios::binary);
+            if(!in)
+                throw std::runtime_error("cannot open " + file);
+            dec.decode(in, std::cout);
+        }
+    }
+    std::cout.flush();
+    return EXIT_SUCCESS;
+}
+catch(const std::exception& e)
+{
+    std::cerr << "rocblas-log-decode: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
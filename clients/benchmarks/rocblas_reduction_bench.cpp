@@ -0,0 +1,297 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+// rocblas-reduction-bench measures the latency of BLAS1 reductions, from the
+// call to the result being available on the host, over a range of n and
+// batch_count. Each size is timed with atomics allowed, where asum, nrm2, iamax
+// and iamin take a single launch, and not allowed, where they take two, so the
+// rows can be compared directly. dot is included for reference.
+//
+//   rocblas-reduction-bench -r s --n 1000,100000,1000000 --batch_count 1,64
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <hip/hip_runtime_api.h>
+#include <iostream>
+#include <rocblas.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    void check(hipError_t err, const char* what)
+    {
+        if(err != hipSuccess)
+            throw std::runtime_error(std::string(what) + ": " + hipGetErrorString(err));
+    }
+
+    void check(rocblas_status status, const char* what)
+    {
+        if(status != rocblas_status_success)
+            throw std::runtime_error(std::string(what) + ": " + rocblas_status_to_string(status));
+    }
+
+    template <typename T>
+    struct reductions;
+
+    template <>
+    struct reductions<float>
+    {
+        static constexpr auto asum  = rocblas_sasum_strided_batched;
+        static constexpr auto nrm2  = rocblas_snrm2_strided_batched;
+        static constexpr auto dot   = rocblas_sdot_strided_batched;
+        static constexpr auto iamax = rocblas_isamax_strided_batched;
+        static constexpr auto iamin = rocblas_isamin_strided_batched;
+    };
+
+    template <>
+    struct reductions<double>
+    {
+        static constexpr auto asum  = rocblas_dasum_strided_batched;
+        static constexpr auto nrm2  = rocblas_dnrm2_strided_batched;
+        static constexpr auto dot   = rocblas_ddot_strided_batched;
+        static constexpr auto iamax = rocblas_idamax_strided_batched;
+        static constexpr auto iamin = rocblas_idamin_strided_batched;
+    };
+
+    struct options
+    {
+        char                     precision = 's';
+        std::vector<rocblas_int> sizes{1, 100, 1000, 10000, 100000, 1000000, 4000000};
+        std::vector<rocblas_int> batch_counts{1, 16};
+        std::vector<std::string> functions{"asum", "nrm2", "dot", "iamax", "iamin"};
+        rocblas_pointer_mode     pointer_mode = rocblas_pointer_mode_host;
+        int                      iters        = 200;
+        int                      device       = 0;
+        bool                     header       = true;
+    };
+
+    // Run one reduction of batch_count vectors of n elements, returning results in
+    // result (on the host or device according to the pointer mode of the handle)
+    template <typename T>
+    void call(const std::string& function,
+              rocblas_handle     handle,
+              rocblas_int        n,
+              rocblas_int        batch_count,
+              const T*           x,
+              void*              result)
+    {
+        using R = reductions<T>;
+        auto r  = static_cast<T*>(result);
+        auto i  = static_cast<rocblas_int*>(result);
+        if(function == "asum")
+            check(R::asum(handle, n, x, 1, n, batch_count, r), "asum");
+        else if(function == "nrm2")
+            check(R::nrm2(handle, n, x, 1, n, batch_count, r), "nrm2");
+        else if(function == "dot")
+            check(R::dot(handle, n, x, 1, n, x, 1, n, batch_count, r), "dot");
+        else if(function == "iamax")
+            check(R::iamax(handle, n, x, 1, n, batch_count, i), "iamax");
+        else if(function == "iamin")
+            check(R::iamin(handle, n, x, 1, n, batch_count, i), "iamin");
+        else
+            throw std::invalid_argument("unknown function " + function);
+    }
+
+    // Time opt.iters calls, each until its result is ready on the host, returning the
+    // times in microseconds in increasing order
+    template <typename T>
+    std::vector<double> time_calls(const options&     opt,
+                                   const std::string& function,
+                                   rocblas_handle     handle,
+                                   hipStream_t        stream,
+                                   rocblas_int        n,
+                                   rocblas_int        batch_count,
+                                   const T*           x,
+                                   void*              result)
+    {
+        // Warm up, including the allocation of workspace
+        for(int i = 0; i < 3; ++i)
+            call(function, handle, n, batch_count, x, result);
+        check(hipStreamSynchronize(stream), "hipStreamSynchronize");
+
+        std::vector<double> times(opt.iters);
+        for(auto& t : times)
+        {
+            auto start = clock_type::now();
+            call(function, handle, n, batch_count, x, result);
+            check(hipStreamSynchronize(stream), "hipStreamSynchronize");
+            t = std::chrono::duration<double, std::micro>(clock_type::now() - start).count();
+        }
+        std::sort(times.begin(), times.end());
+        return times;
+    }
+
+    template <typename T>
+    void run(const options& opt)
+    {
+        check(hipSetDevice(opt.device), "hipSetDevice");
+
+        auto   max_n = *std::max_element(opt.sizes.begin(), opt.sizes.end());
+        auto   max_b = *std::max_element(opt.batch_counts.begin(), opt.batch_counts.end());
+        size_t size  = size_t(max_n) * max_b;
+
+        // Small integers in varying order, so that every function has work to do
+        std::vector<T> hx(size);
+        for(size_t i = 0; i < size; ++i)
+            hx[i] = T(int(i * 7919 % 17) - 8);
+
+        T*    x;
+        void* d_result;
+        check(hipMalloc(&x, size * sizeof(T)), "hipMalloc");
+        check(hipMalloc(&d_result, max_b * sizeof(double)), "hipMalloc");
+        check(hipMemcpy(x, hx.data(), size * sizeof(T), hipMemcpyHostToDevice), "hipMemcpy");
+        std::vector<double> h_result(max_b);
+
+        bool  host   = opt.pointer_mode == rocblas_pointer_mode_host;
+        void* result = host ? h_result.data() : d_result;
+
+        rocblas_handle handle;
+        hipStream_t    stream;
+        check(rocblas_create_handle(&handle), "rocblas_create_handle");
+        check(rocblas_get_stream(handle, &stream), "rocblas_get_stream");
+        check(rocblas_set_pointer_mode(handle, opt.pointer_mode), "rocblas_set_pointer_mode");
+
+        if(opt.header)
+            std::cout << "function,precision,n,batch_count,pointer_mode,atomics,median_us,"
+                         "mean_us,min_us\n";
+
+        for(const auto& function : opt.functions)
+            for(rocblas_int batch_count : opt.batch_counts)
+                for(rocblas_int n : opt.sizes)
+                    for(bool atomics : {true, false})
+                    {
+                        check(rocblas_set_atomics_mode(handle,
+                                                       atomics ? rocblas_atomics_allowed
+                                                               : rocblas_atomics_not_allowed),
+                              "rocblas_set_atomics_mode");
+
+                        auto times = time_calls(
+                            opt, function, handle, stream, n, batch_count, x, result);
+                        double mean = 0;
+                        for(double t : times)
+                            mean += t / times.size();
+
+                        std::cout << function << ',' << opt.precision << ',' << n << ','
+                                  << batch_count << ',' << (host ? "host" : "device") << ','
+                                  << (atomics ? "allowed" : "not_allowed") << ','
+                                  << times[times.size() / 2] << ',' << mean << ',' << times[0]
+                                  << std::endl;
+                    }
+
+        check(rocblas_destroy_handle(handle), "rocblas_destroy_handle");
+        check(hipFree(x), "hipFree");
+        check(hipFree(d_result), "hipFree");
+    }
+
+    template <typename T>
+    std::vector<T> split(const std::string& list)
+    {
+        std::vector<T>     values;
+        std::istringstream is(list);
+        for(std::string item; std::getline(is, item, ',');)
+        {
+            if(item.empty())
+                continue;
+            if constexpr(std::is_same<T, std::string>{})
+                values.push_back(item);
+            else
+            {
+                int value = atoi(item.c_str());
+                if(value <= 0)
+                    throw std::invalid_argument("sizes must be positive: " + item);
+                values.push_back(value);
+            }
+        }
+        if(values.empty())
+            throw std::invalid_argument("empty list: " + list);
+        return values;
+    }
+
+    void usage(const char* prog)
+    {
+        std::cerr << "Usage: " << prog
+                  << " [-r s|d] [-f list] [--n list] [--batch_count list] [--pointer_mode host|"
+                     "device] [--iters N] [--device D] [--no-header]\n\n"
+                  << "Measures the latency of BLAS1 reductions, with and without atomics, as "
+                     "CSV.\n"
+                  << "  -r              precision, s (default) or d\n"
+                  << "  -f              functions, from asum,nrm2,dot,iamax,iamin (default all)\n"
+                  << "  --n             vector sizes (default 1,100,1000,10000,100000,1000000,"
+                     "4000000)\n"
+                  << "  --batch_count   batch counts (default 1,16)\n"
+                  << "  --pointer_mode  where results are returned (default host)\n"
+                  << "  --iters         timed calls per row (default 200)\n"
+                  << "  --device        HIP device (default 0)\n"
+                  << "  --no-header     omit the CSV header, for appending repeated runs\n"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+try
+{
+    options opt;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        auto value = [&] {
+            if(++i >= argc)
+                throw std::invalid_argument(std::string("missing value for ") + argv[i - 1]);
+            return argv[i];
+        };
+        if(!strcmp(argv[i], "-r"))
+            opt.precision = *value();
+        else if(!strcmp(argv[i], "-f"))
+            opt.functions = split<std::string>(value());
+        else if(!strcmp(argv[i], "--n"))
+            opt.sizes = split<rocblas_int>(value());
+        else if(!strcmp(argv[i], "--batch_count"))
+            opt.batch_counts = split<rocblas_int>(value());
+        else if(!strcmp(argv[i], "--pointer_mode"))
+        {
+            std::string mode = value();
+            if(mode != "host" && mode != "device")
+                throw std::invalid_argument("pointer mode must be host or device");
+            opt.pointer_mode
+                = mode == "host" ? rocblas_pointer_mode_host : rocblas_pointer_mode_device;
+        }
+        else if(!strcmp(argv[i], "--iters"))
+            opt.iters = atoi(value());
+        else if(!strcmp(argv[i], "--device"))
+            opt.device = atoi(value());
+        else if(!strcmp(argv[i], "--no-header"))
+            opt.header = false;
+        else
+        {
+            usage(argv[0]);
+            return strcmp(argv[i], "-h") && strcmp(argv[i], "--help") ? EXIT_FAILURE
+                                                                      : EXIT_SUCCESS;
+        }
+    }
+
+    if(opt.iters <= 0)
+        throw std::invalid_argument("iters must be positive");
+
+    if(opt.precision == 's')
+        run<float>(opt);
+    else if(opt.precision == 'd')
+        run<double>(opt);
+    else
+        throw std::invalid_argument("precision must be s or d");
+
+    return EXIT_SUCCESS;
+}
+catch(const std::exception& e)
+{
+    std::cerr << "rocblas-reduction-bench: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,207 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+// rocblas-ref-gemm-bench measures the CPU reference GEMM used by the clients to
+// check half and bfloat16 results, which converts the operands to float around
+// cblas_sgemm. For each size it reports the time of the previous conversion
+// (serial loops into newly allocated vectors), the time of the panelled,
+// multithreaded conversion into reused scratch buffers, and the time of the
+// whole reference call. It needs no GPU; the number of threads is set with
+// OMP_NUM_THREADS.
+
+#include "cblas_convert.hpp"
+#include "cblas_interface.hpp"
+#include "host_vector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <omp.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // Best time in milliseconds of reps runs of fn
+    template <typename F>
+    double best_ms(int reps, F&& fn)
+    {
+        double best = 1e30;
+        for(int r = 0; r < reps; ++r)
+        {
+            auto start = clock_type::now();
+            fn();
+            best = std::min(
+                best, std::chrono::duration<double, std::milli>(clock_type::now() - start).count());
+        }
+        return best;
+    }
+
+    // The conversion done by the reference before it was panelled: every element of
+    // the allocated matrices, on one thread, into vectors allocated on each call
+    template <typename T>
+    void serial_convert(const T* A, const T* B, T* C, size_t sizeA, size_t sizeB, size_t sizeC)
+    {
+        host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
+        for(size_t i = 0; i < sizeA; i++)
+            A_float[i] = static_cast<float>(A[i]);
+        for(size_t i = 0; i < sizeB; i++)
+            B_float[i] = static_cast<float>(B[i]);
+        for(size_t i = 0; i < sizeC; i++)
+            C_float[i] = static_cast<float>(C[i]);
+        for(size_t i = 0; i < sizeC; i++)
+            C[i] = static_cast<T>(C_float[i]);
+    }
+
+    // The conversion done by the reference now
+    template <typename T>
+    void panel_convert(const T* A, const T* B, T* C, size_t n, size_t ld)
+    {
+        float* A_float = cblas_convert_scratch<float, 0>(n * ld);
+        float* B_float = cblas_convert_scratch<float, 1>(n * ld);
+        float* C_float = cblas_convert_scratch<float, 2>(n * ld);
+        cblas_convert_matrix(A_float, A, n, n, ld);
+        cblas_convert_matrix(B_float, B, n, n, ld);
+        cblas_convert_matrix(C_float, C, n, n, ld);
+        cblas_convert_matrix(C, C_float, n, n, ld);
+    }
+
+    template <typename T>
+    void run(const char* precision, size_t n, int reps, bool gemm, bool header)
+    {
+        size_t         ld   = n;
+        size_t         size = n * ld;
+        host_vector<T> A(size), B(size), C(size);
+        for(size_t i = 0; i < size; ++i)
+        {
+            A[i] = static_cast<T>(float(i % 7) - 3);
+            B[i] = static_cast<T>(float(i % 5) - 2);
+            C[i] = static_cast<T>(float(i % 3));
+        }
+
+        double serial_ms = best_ms(
+            reps, [&] { serial_convert<T>(A.data(), B.data(), C.data(), size, size, size); });
+        double panel_ms
+            = best_ms(reps, [&] { panel_convert<T>(A.data(), B.data(), C.data(), n, ld); });
+
+        double gemm_ms = 0;
+        if(gemm)
+            gemm_ms = best_ms(reps, [&] {
+                cblas_gemm<T, T, float>(rocblas_operation_none,
+                                        rocblas_operation_transpose,
+                                        n,
+                                        n,
+                                        n,
+                                        1.0f,
+                                        A.data(),
+                                        ld,
+                                        B.data(),
+                                        ld,
+                                        0.0f,
+                                        C.data(),
+                                        ld);
+            });
+
+        if(header)
+            std::cout << "precision,threads,M,N,K,serial_convert_ms,panel_convert_ms,reference_ms,"
+                         "reference_gflops\n";
+        std::cout << precision << ',' << omp_get_max_threads() << ',' << n << ',' << n << ','
+                  << n << ',' << serial_ms << ',' << panel_ms << ',';
+        if(gemm)
+            std::cout << gemm_ms << ',' << 2e-6 * n * n * n / gemm_ms;
+        else
+            std::cout << ',';
+        std::cout << std::endl;
+    }
+
+    void usage(const char* prog)
+    {
+        std::cerr << "Usage: " << prog
+                  << " [--sizes N,...] [--precision h|bf16|all] [--iters R] [--convert_only]"
+                     " [--no-header]\n\n"
+                  << "Measures the CPU reference GEMM of square half and bfloat16 matrices,"
+                     " as CSV.\n"
+                  << "  --sizes         comma separated M = N = K (default 8192,16384)\n"
+                  << "  --precision     h for rocblas_half, bf16 for rocblas_bfloat16, or all\n"
+                  << "                  (default all); C and the compute type are float\n"
+                  << "  --iters         runs per measurement, of which the best is reported"
+                     " (default 1)\n"
+                  << "  --convert_only  only measure the conversions, not the whole reference\n"
+                  << "  --no-header     omit the CSV header, for appending repeated runs\n"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+try
+{
+    std::vector<size_t> sizes{8192, 16384};
+    std::string         precision = "all";
+    int                 reps      = 1;
+    bool                gemm      = true;
+    bool                header    = true;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        auto value = [&] {
+            if(++i >= argc)
+                throw std::invalid_argument(std::string("missing value for ") + argv[i - 1]);
+            return argv[i];
+        };
+        if(!strcmp(argv[i], "--sizes"))
+        {
+            sizes.clear();
+            std::istringstream list(value());
+            for(std::string s; std::getline(list, s, ',');)
+                sizes.push_back(strtoull(s.c_str(), nullptr, 0));
+        }
+        else if(!strcmp(argv[i], "--precision"))
+            precision = value();
+        else if(!strcmp(argv[i], "--iters"))
+            reps = atoi(value());
+        else if(!strcmp(argv[i], "--convert_only"))
+            gemm = false;
+        else if(!strcmp(argv[i], "--no-header"))
+            header = false;
+        else
+        {
+            usage(argv[0]);
+            return strcmp(argv[i], "-h") && strcmp(argv[i], "--help") ? EXIT_FAILURE
+                                                                      : EXIT_SUCCESS;
+        }
+    }
+
+    if(reps <= 0 || sizes.empty()
+       || std::any_of(sizes.begin(), sizes.end(), [](size_t n) { return !n || n > INT32_MAX; }))
+        throw std::invalid_argument("sizes and iters must be positive");
+    if(precision != "h" && precision != "bf16" && precision != "all")
+        throw std::invalid_argument("precision must be h, bf16 or all");
+
+    for(size_t n : sizes)
+    {
+        if(precision != "bf16")
+        {
+            run<rocblas_half>("h", n, reps, gemm, header);
+            header = false;
+        }
+        if(precision != "h")
+        {
+            run<rocblas_bfloat16>("bf16", n, reps, gemm, header);
+            header = false;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+catch(const std::exception& e)
+{
+    std::cerr << "rocblas-ref-gemm-bench: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
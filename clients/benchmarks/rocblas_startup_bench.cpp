@@ -0,0 +1,189 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+// rocblas-startup-bench measures the start-up latency of rocBLAS in a fresh
+// process: the time to create a handle, the time to the first GEMM (which
+// includes loading the Tensile library and code objects), and the time of a
+// second GEMM for comparison. Run it once per configuration, e.g. with and
+// without ROCBLAS_TENSILE_LAZY_LOAD=1, since the first GEMM only happens once
+// per process.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <hip/hip_runtime_api.h>
+#include <iostream>
+#include <rocblas.h>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    double elapsed_us(clock_type::time_point start)
+    {
+        return std::chrono::duration<double, std::micro>(clock_type::now() - start).count();
+    }
+
+    void check(hipError_t err, const char* what)
+    {
+        if(err != hipSuccess)
+            throw std::runtime_error(std::string(what) + ": " + hipGetErrorString(err));
+    }
+
+    void check(rocblas_status status, const char* what)
+    {
+        if(status != rocblas_status_success)
+            throw std::runtime_error(std::string(what) + ": " + rocblas_status_to_string(status));
+    }
+
+    rocblas_status gemm(rocblas_handle handle, rocblas_int m, rocblas_int n, rocblas_int k, float* a)
+    {
+        float alpha = 1, beta = 0;
+        return rocblas_sgemm(handle,
+                             rocblas_operation_none,
+                             rocblas_operation_none,
+                             m,
+                             n,
+                             k,
+                             &alpha,
+                             a,
+                             m,
+                             a,
+                             k,
+                             &beta,
+                             a,
+                             m);
+    }
+
+    rocblas_status gemm(rocblas_handle handle, rocblas_int m, rocblas_int n, rocblas_int k, double* a)
+    {
+        double alpha = 1, beta = 0;
+        return rocblas_dgemm(handle,
+                             rocblas_operation_none,
+                             rocblas_operation_none,
+                             m,
+                             n,
+                             k,
+                             &alpha,
+                             a,
+                             m,
+                             a,
+                             k,
+                             &beta,
+                             a,
+                             m);
+    }
+
+    template <typename T>
+    void run(int device, rocblas_int m, rocblas_int n, rocblas_int k, bool header)
+    {
+        // Initialize the HIP runtime separately so that it is not counted
+        auto start = clock_type::now();
+        check(hipSetDevice(device), "hipSetDevice");
+        check(hipFree(nullptr), "hipFree");
+        double hip_init_us = elapsed_us(start);
+
+        // A and B are not initialized; only the timing matters
+        size_t size = std::max({size_t(m) * k, size_t(k) * n, size_t(m) * n});
+        T*     a;
+        check(hipMalloc(&a, size * sizeof(T)), "hipMalloc");
+
+        start = clock_type::now();
+        rocblas_handle handle;
+        check(rocblas_create_handle(&handle), "rocblas_create_handle");
+        double handle_us = elapsed_us(start);
+
+        start = clock_type::now();
+        check(gemm(handle, m, n, k, a), "first gemm");
+        check(hipDeviceSynchronize(), "hipDeviceSynchronize");
+        double first_gemm_us = elapsed_us(start);
+
+        start = clock_type::now();
+        check(gemm(handle, m, n, k, a), "second gemm");
+        check(hipDeviceSynchronize(), "hipDeviceSynchronize");
+        double second_gemm_us = elapsed_us(start);
+
+        check(rocblas_destroy_handle(handle), "rocblas_destroy_handle");
+        check(hipFree(a), "hipFree");
+
+        const char* lazy = getenv("ROCBLAS_TENSILE_LAZY_LOAD");
+        const char* pre  = getenv("ROCBLAS_TENSILE_PRELOAD");
+        if(header)
+            std::cout << "precision,M,N,K,lazy_load,preload,hip_init_us,create_handle_us,"
+                         "first_gemm_us,second_gemm_us\n";
+        std::cout << (sizeof(T) == sizeof(float) ? 's' : 'd') << ',' << m << ',' << n << ',' << k
+                  << ',' << (lazy ? lazy : "") << ",\"" << (pre ? pre : "") << "\","
+                  << hip_init_us << ',' << handle_us << ',' << first_gemm_us << ','
+                  << second_gemm_us << std::endl;
+    }
+
+    void usage(const char* prog)
+    {
+        std::cerr << "Usage: " << prog
+                  << " [-r s|d] [-m M] [-n N] [-k K] [--device D] [--no-header]\n\n"
+                  << "Measures the time to the first GEMM in a fresh process, as CSV.\n"
+                  << "  -r           precision, s (default) or d\n"
+                  << "  -m, -n, -k   GEMM size (default 128)\n"
+                  << "  --device     HIP device (default 0)\n"
+                  << "  --no-header  omit the CSV header, for appending repeated runs\n"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+try
+{
+    char        precision = 's';
+    rocblas_int m = 128, n = 128, k = 128;
+    int         device = 0;
+    bool        header = true;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        auto value = [&] {
+            if(++i >= argc)
+                throw std::invalid_argument(std::string("missing value for ") + argv[i - 1]);
+            return argv[i];
+        };
+        if(!strcmp(argv[i], "-r"))
+            precision = *value();
+        else if(!strcmp(argv[i], "-m"))
+            m = atoi(value());
+        else if(!strcmp(argv[i], "-n"))
+            n = atoi(value());
+        else if(!strcmp(argv[i], "-k"))
+            k = atoi(value());
+        else if(!strcmp(argv[i], "--device"))
+            device = atoi(value());
+        else if(!strcmp(argv[i], "--no-header"))
+            header = false;
+        else
+        {
+            usage(argv[0]);
+            return strcmp(argv[i], "-h") && strcmp(argv[i], "--help") ? EXIT_FAILURE
+                                                                      : EXIT_SUCCESS;
+        }
+    }
+
+    if(m <= 0 || n <= 0 || k <= 0)
+        throw std::invalid_argument("M, N and K must be positive");
+
+    if(precision == 's')
+        run<float>(device, m, n, k, header);
+    else if(precision == 'd')
+        run<double>(device, m, n, k, header);
+    else
+        throw std::invalid_argument("precision must be s or d");
+
+    return EXIT_SUCCESS;
+}
+catch(const std::exception& e)
+{
+    std::cerr << "rocblas-startup-bench: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
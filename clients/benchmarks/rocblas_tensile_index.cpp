@@ -0,0 +1,284 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+// rocblas-tensile-index finds which GEMM problems in rocblas-bench logs, such
+// as those written with ROCBLAS_LAYER=2, were tuned for in Tensile library
+// logic, and the GFLOPS expected from the tuning. It replaces
+// scripts/utilities/check-for-pretuned-sizes.py for large logs: the logic
+// files are indexed once, and the index is memory-mapped by each check.
+//
+//   rocblas-tensile-index build -o logic.idx library/src/blas3/Tensile/Logic/asm_full
+//   rocblas-tensile-index check -i logic.idx -a gfx90a bench.log > sizes.csv
+//
+// It needs no GPU, and neither rocBLAS nor Python.
+
+#include "tensile_logic_index.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    void usage(const char* prog)
+    {
+        std::cerr
+            << "Usage:\n"
+            << "  " << prog << " build -o <index> <logic directory or file>...\n"
+            << "  " << prog << " check -i <index> -a <arch> [--per-call] [--no-header] <log>...\n"
+            << "  " << prog << " list -i <index>\n\n"
+            << "build  indexes the exact logic of Tensile library logic files; directories\n"
+            << "       are searched for *.yaml files, not recursively.\n"
+            << "check  reads rocblas-bench lines from logs, or - for standard input, and\n"
+            << "       writes one CSV row for each distinct GEMM problem, or for each call\n"
+            << "       with --per-call. status is exact when the size was tuned for,\n"
+            << "       fallback when it was not, with the nearest tuned size, or no_logic\n"
+            << "       when there is no logic for the problem type on the architecture,\n"
+            << "       which is either an arch name such as aldebaran or a gfx name.\n"
+            << "list   lists the tables of an index.\n"
+            << std::endl;
+    }
+
+    void build(const std::string& output, const std::vector<std::string>& inputs)
+    {
+        std::vector<std::string> files;
+        for(const auto& input : inputs)
+        {
+            if(std::filesystem::is_directory(input))
+            {
+                std::vector<std::string> found;
+                for(const auto& e : std::filesystem::directory_iterator(input))
+                    if(e.path().extension() == ".yaml" && !e.is_directory())
+                        found.push_back(e.path().string());
+                std::sort(found.begin(), found.end());
+                files.insert(files.end(), found.begin(), found.end());
+            }
+            else
+                files.push_back(input);
+        }
+
+        std::vector<tensile_logic_table> tables;
+        size_t                           entries = 0;
+        for(const auto& file : files)
+        {
+            std::ifstream ifs(file);
+            if(!ifs)
+                throw std::runtime_error("cannot open " + file);
+            try
+            {
+                tables.push_back(tensile_logic_parse(ifs, file));
+                entries += tables.back().entries.size();
+            }
+            catch(const std::runtime_error& e)
+            {
+                std::cerr << "rocblas-tensile-index: skipping " << e.what() << std::endl;
+            }
+        }
+
+        std::ofstream ofs(output, std::ofstream::binary | std::ofstream::trunc);
+        if(!ofs)
+            throw std::runtime_error("cannot create " + output);
+        tensile_logic_index_write(std::move(tables), ofs);
+        ofs.close();
+        if(!ofs)
+            throw std::runtime_error("cannot write " + output);
+        std::cerr << "Indexed " << entries << " sizes from " << files.size() << " files"
+                  << std::endl;
+    }
+
+    void list(const std::string& index_file)
+    {
+        tensile_logic_index index(index_file);
+        std::cout << "arch,gfx,problem,sizes\n";
+        for(const auto& t : index.tables())
+            std::cout << t.arch << ',' << t.gfx << ',' << t.problem << ',' << t.count << '\n';
+    }
+
+    struct query_hash
+    {
+        size_t operator()(const tensile_logic_query& q) const
+        {
+            size_t h = std::hash<std::string>{}(q.problem);
+            for(uint32_t v : {q.m, q.n, q.batch, q.k})
+                h = h * 1000003 ^ v;
+            return h;
+        }
+    };
+
+    struct query_equal
+    {
+        bool operator()(const tensile_logic_query& a, const tensile_logic_query& b) const
+        {
+            return std::tie(a.problem, a.m, a.n, a.batch, a.k)
+                   == std::tie(b.problem, b.m, b.n, b.batch, b.k);
+        }
+    };
+
+    struct result
+    {
+        size_t                     order; // Order of first appearance
+        size_t                     calls;
+        tensile_logic_index::match match;
+    };
+
+    void write_row(const tensile_logic_query& q, const result& r)
+    {
+        static const char* status[] = {"no_logic", "exact", "fallback"};
+        std::cout << status[int(r.match.kind)] << ',' << q.problem << ',' << q.m << ',' << q.n
+                  << ',' << q.batch << ',' << q.k << ',' << r.calls << ',';
+        if(const auto* e = r.match.entry)
+            std::cout << e->solution << ',' << e->gflops << ',' << e->m << ',' << e->n << ','
+                      << e->batch << ',' << e->k << '\n';
+        else
+            std::cout << ",,,,,\n";
+    }
+
+    void check(const std::string&              index_file,
+               const std::string&              arch,
+               const std::vector<std::string>& logs,
+               bool                            per_call,
+               bool                            header)
+    {
+        tensile_logic_index index(index_file);
+        if(std::none_of(index.tables().begin(), index.tables().end(), [&](const auto& t) {
+               return arch == t.arch || arch == t.gfx;
+           }))
+            throw std::invalid_argument("no logic for architecture " + arch);
+
+        std::unordered_map<tensile_logic_query, result, query_hash, query_equal> results;
+        std::unordered_map<std::string, const tensile_logic_index::table*>        tables;
+        size_t calls = 0, counts[3] = {};
+
+        if(header)
+            std::cout << "status,problem,M,N,batch,K,calls,solution,expected_gflops,tuned_M,"
+                         "tuned_N,tuned_batch,tuned_K\n";
+
+        tensile_logic_query query;
+        for(const auto& log : logs)
+        {
+            std::ifstream file;
+            if(log != "-")
+            {
+                file.open(log);
+                if(!file)
+                    throw std::runtime_error("cannot open " + log);
+            }
+            std::istream& is = log == "-" ? std::cin : file;
+
+            for(std::string line; std::getline(is, line);)
+            {
+                if(!tensile_logic_parse_bench(line, query))
+                    continue;
+
+                auto it = results.find(query);
+                if(it == results.end())
+                {
+                    auto t = tables.find(query.problem);
+                    if(t == tables.end())
+                        t = tables.emplace(query.problem, index.find(arch, query.problem)).first;
+
+                    tensile_logic_index::match match{tensile_logic_index::match_kind::none,
+                                                     nullptr};
+                    if(t->second)
+                        match = tensile_logic_index::lookup(
+                            *t->second, query.m, query.n, query.batch, query.k);
+                    it = results.emplace(query, result{results.size(), 0, match}).first;
+                }
+
+                ++it->second.calls;
+                ++calls;
+                ++counts[int(it->second.match.kind)];
+                if(per_call)
+                    write_row(query, {0, 1, it->second.match});
+            }
+        }
+
+        if(!per_call)
+        {
+            std::vector<decltype(results)::const_pointer> sorted;
+            for(const auto& r : results)
+                sorted.push_back(&r);
+            std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) {
+                return a->second.order < b->second.order;
+            });
+            for(auto r : sorted)
+                write_row(r->first, r->second);
+        }
+        std::cout.flush();
+
+        auto percent = [&](size_t n) { return calls ? 100.0 * n / calls : 0.0; };
+        std::cerr << std::fixed << std::setprecision(1) << calls << " GEMM calls, "
+                  << results.size() << " distinct problems: " << counts[1] << " exact ("
+                  << percent(counts[1]) << "%), " << counts[2] << " fallback ("
+                  << percent(counts[2]) << "%), " << counts[0] << " no_logic ("
+                  << percent(counts[0]) << "%)" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+try
+{
+    if(argc < 2)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::string              command = argv[1], index, output, arch;
+    std::vector<std::string> files;
+    bool                     per_call = false, header = true;
+
+    for(int i = 2; i < argc; ++i)
+    {
+        auto value = [&] {
+            if(++i >= argc)
+                throw std::invalid_argument(std::string("missing value for ") + argv[i - 1]);
+            return argv[i];
+        };
+        if(!strcmp(argv[i], "-o"))
+            output = value();
+        else if(!strcmp(argv[i], "-i"))
+            index = value();
+        else if(!strcmp(argv[i], "-a"))
+            arch = value();
+        else if(!strcmp(argv[i], "--per-call"))
+            per_call = true;
+        else if(!strcmp(argv[i], "--no-header"))
+            header = false;
+        else if(argv[i][0] == '-' && argv[i][1])
+        {
+            usage(argv[0]);
+            return strcmp(argv[i], "-h") && strcmp(argv[i], "--help") ? EXIT_FAILURE
+                                                                      : EXIT_SUCCESS;
+        }
+        else
+            files.push_back(argv[i]);
+    }
+
+    if(command == "build" && !output.empty() && !files.empty())
+        build(output, files);
+    else if(command == "check" && !index.empty() && !arch.empty() && !files.empty())
+        check(index, arch, files, per_call, header);
+    else if(command == "list" && !index.empty())
+        list(index);
+    else
+    {
+        usage(argv[0]);
+        return command == "-h" || command == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+catch(const std::exception& e)
+{
+    std::cerr << "rocblas-tensile-index: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
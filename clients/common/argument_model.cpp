@@ -17,3 +17,15 @@ bool ArgumentModel_get_log_function_name()
 {
     return log_function_name;
 }
+
+static ArgumentModel_log_sink log_sink = nullptr;
+
+void ArgumentModel_set_log_sink(ArgumentModel_log_sink sink)
+{
+    log_sink = sink;
+}
+
+ArgumentModel_log_sink ArgumentModel_get_log_sink()
+{
+    return log_sink;
+}
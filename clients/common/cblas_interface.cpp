@@ -2,6 +2,7 @@
  * Copyright 2018-2021 Advanced Micro Devices, Inc.
  * ************************************************************************/
 #include "cblas_interface.hpp"
+#include "cblas_convert.hpp"
 #include "rocblas_vector.hpp"
 #include "utility.hpp"
 #include <omp.h>
@@ -439,6 +440,51 @@ void cblas_geam(rocblas_operation       transa,
 }
 
 // gemm
+
+// cblas does not support the precision Ti of A and B, or To of C, so convert them to the higher
+// precision Tc, which gives a more precise result which is acceptable for testing.
+// The converted copies are scratch buffers reused across calls, see cblas_convert.hpp.
+template <typename Tc, typename Ti, typename To>
+void cblas_gemm_converted(rocblas_operation transA,
+                          rocblas_operation transB,
+                          rocblas_int       m,
+                          rocblas_int       n,
+                          rocblas_int       k,
+                          Tc                alpha,
+                          const Ti*         A,
+                          rocblas_int       lda,
+                          const Ti*         B,
+                          rocblas_int       ldb,
+                          Tc                beta,
+                          To*               C,
+                          rocblas_int       ldc)
+{
+    size_t rowsA = transA == rocblas_operation_none ? m : k;
+    size_t colsA = transA == rocblas_operation_none ? k : m;
+    size_t rowsB = transB == rocblas_operation_none ? k : n;
+    size_t colsB = transB == rocblas_operation_none ? n : k;
+
+    Tc* A_c = cblas_convert_scratch<Tc, 0>(colsA * size_t(lda));
+    Tc* B_c = cblas_convert_scratch<Tc, 1>(colsB * size_t(ldb));
+    cblas_convert_matrix(A_c, A, rowsA, colsA, lda);
+    cblas_convert_matrix(B_c, B, rowsB, colsB, ldb);
+
+    // C is used in place when it already has precision Tc
+    Tc* C_c;
+    if constexpr(std::is_same<To, Tc>{})
+        C_c = C;
+    else
+    {
+        C_c = cblas_convert_scratch<Tc, 2>(n * size_t(ldc));
+        cblas_convert_matrix(C_c, C, m, n, ldc);
+    }
+
+    cblas_gemm<Tc, Tc, Tc>(transA, transB, m, n, k, alpha, A_c, lda, B_c, ldb, beta, C_c, ldc);
+
+    if constexpr(!std::is_same<To, Tc>{})
+        cblas_convert_matrix(C, C_c, m, n, ldc);
+}
+
 template <>
 void cblas_gemm<rocblas_bfloat16, float, float>(rocblas_operation transA,
                                                 rocblas_operation transB,
@@ -454,35 +500,7 @@ void cblas_gemm<rocblas_bfloat16, float, float>(rocblas_operation transA,
                                                 float*            C,
                                                 rocblas_int       ldc)
 {
-    // cblas does not support rocblas_bfloat16, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C,
-                ldc);
+    cblas_gemm_converted<float>(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
 
 template <>
@@ -500,41 +518,7 @@ void cblas_gemm<rocblas_bfloat16, rocblas_bfloat16, float>(rocblas_operation tra
                                                            rocblas_bfloat16* C,
                                                            rocblas_int       ldc)
 {
-    // cblas does not support rocblas_bfloat16, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = static_cast<rocblas_bfloat16>(C_float[i]);
+    cblas_gemm_converted<float>(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
 
 template <>
@@ -552,36 +536,7 @@ void cblas_gemm<rocblas_half, float, float>(rocblas_operation transA,
                                             float*            C,
                                             rocblas_int       ldc)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = A[i];
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = B[i];
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C,
-                ldc);
+    cblas_gemm_converted<float>(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
 
 template <>
@@ -599,41 +554,7 @@ void cblas_gemm<rocblas_half, rocblas_half, float>(rocblas_operation transA,
                                                    rocblas_half*     C,
                                                    rocblas_int       ldc)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = A[i];
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = B[i];
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = C[i];
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = rocblas_half(C_float[i]);
+    cblas_gemm_converted<float>(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
 
 template <>
@@ -651,43 +572,8 @@ void cblas_gemm<rocblas_half, rocblas_half, rocblas_half>(rocblas_operation tran
                                                           rocblas_half*     C,
                                                           rocblas_int       ldc)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-    float alpha_float = alpha;
-    float beta_float  = beta;
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = A[i];
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = B[i];
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = C[i];
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha_float,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta_float,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = rocblas_half(C_float[i]);
+    cblas_gemm_converted<float>(
+        transA, transB, m, n, k, float(alpha), A, lda, B, ldb, float(beta), C, ldc);
 }
 
 template <>
@@ -705,45 +591,11 @@ void cblas_gemm<int8_t, int32_t, int32_t>(rocblas_operation transA,
                                           int32_t*          C,
                                           rocblas_int       ldc)
 {
-    // cblas does not support int8_t input / int32_t output, however non-overflowing
-    // 32-bit integer operations can be represented accurately with double-precision
-    // floats, so convert to doubles and downcast result down to int32_t.
+    // non-overflowing 32-bit integer operations can be represented accurately with doubles.
     // NOTE: This will not properly account for 32-bit integer overflow, however
     //       the result should be acceptable for testing.
-
-    size_t const sizeA = ((transA == rocblas_operation_none) ? k : m) * size_t(lda);
-    size_t const sizeB = ((transB == rocblas_operation_none) ? n : k) * size_t(ldb);
-    size_t const sizeC = n * size_t(ldc);
-
-    host_vector<double> A_double(sizeA);
-    host_vector<double> B_double(sizeB);
-    host_vector<double> C_double(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_double[i] = static_cast<double>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_double[i] = static_cast<double>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_double[i] = static_cast<double>(C[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    cblas_dgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_double,
-                lda,
-                B_double,
-                ldb,
-                beta,
-                C_double,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = static_cast<int32_t>(C_double[i]);
+    cblas_gemm_converted<double>(
+        transA, transB, m, n, k, double(alpha), A, lda, B, ldb, double(beta), C, ldc);
 }
 
 template <typename T, typename U>
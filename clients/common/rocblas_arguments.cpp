@@ -10,6 +10,7 @@
 #include <istream>
 #include <ostream>
 #include <utility>
+#include <vector>
 
 #ifdef WIN32
 // Clang specific code
@@ -102,14 +103,17 @@ static void validation_error [[noreturn]] (const char* name)
 
 // rocblas_gentest.py is expected to conform to this format.
 // rocblas_gentest.py uses rocblas_common.yaml to generate this format.
-void Arguments::validate(std::istream& ifs)
+void Arguments::validate(const char* data, size_t size)
 {
     char      header[8]{}, trailer[8]{};
     Arguments arg{};
 
-    ifs.read(header, sizeof(header));
-    ifs >> arg;
-    ifs.read(trailer, sizeof(trailer));
+    if(size < rocblas_arguments_signature_size)
+        validation_error("header");
+
+    memcpy(header, data, sizeof(header));
+    memcpy(&arg, data + sizeof(header), sizeof(arg));
+    memcpy(trailer, data + sizeof(header) + sizeof(arg), sizeof(trailer));
 
     if(strcmp(header, "rocBLAS"))
         validation_error("header");
@@ -132,3 +136,10 @@ void Arguments::validate(std::istream& ifs)
 #define CHECK_FUNC(NAME) check_func(#NAME, arg.NAME)
     FOR_EACH_ARGUMENT(CHECK_FUNC, ;);
 }
+
+void Arguments::validate(std::istream& ifs)
+{
+    std::vector<char> data(rocblas_arguments_signature_size);
+    ifs.read(data.data(), data.size());
+    validate(data.data(), ifs.gcount());
+}
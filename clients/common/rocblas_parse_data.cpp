@@ -5,13 +5,20 @@
 #include "rocblas_parse_data.hpp"
 #include "rocblas_data.hpp"
 #include "utility.hpp"
+#include <cctype>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <sys/types.h>
+#ifndef WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #ifdef WIN32
 //
 // https://en.cppreference.com/w/User:D41D8CD98F/feature_testing_macros
@@ -28,8 +35,114 @@ namespace std
 #endif
 #endif // WIN32
 
-// Parse YAML data
-static std::string rocblas_parse_yaml(const std::string& yaml)
+#ifndef WIN32
+// FNV-1a hash with 128 bits, enough to make collisions between inputs negligible
+class rocblas_gentest_hash
+{
+    unsigned __int128 m_hash = (unsigned __int128)0x6c62272e07bb0142 << 64 | 0x62b821756295c58d;
+
+public:
+    void add(const void* data, size_t size)
+    {
+        constexpr auto prime = (unsigned __int128)1 << 88 | 0x13b;
+        for(size_t i = 0; i < size; ++i)
+            m_hash = (m_hash ^ static_cast<const unsigned char*>(data)[i]) * prime;
+    }
+
+    std::string hex() const
+    {
+        char buf[33];
+        snprintf(buf,
+                 sizeof(buf),
+                 "%016llx%016llx",
+                 (unsigned long long)(m_hash >> 64),
+                 (unsigned long long)m_hash);
+        return buf;
+    }
+};
+
+// Add a YAML file to the hash with the files it includes, which are found
+// relative to the including file as rocblas_gentest.py finds them
+static bool
+    rocblas_gentest_hash_yaml(rocblas_gentest_hash& hash, const std::string& path, int depth)
+{
+    std::ifstream ifs(path);
+    if(!ifs || depth > 64)
+        return false;
+
+    auto        slash = path.rfind('/');
+    std::string dir   = slash == std::string::npos ? "." : path.substr(0, slash);
+    for(std::string line; std::getline(ifs, line);)
+    {
+        hash.add(line.data(), line.size() + 1); // The terminator separates lines
+
+        // Lines matching rocblas_gentest.py's regex ^include\s*:\s*([-.\w]+)
+        if(line.compare(0, 7, "include"))
+            continue;
+        size_t pos = line.find_first_not_of(" \t", 7);
+        if(pos == std::string::npos || line[pos] != ':')
+            continue;
+        pos        = line.find_first_not_of(" \t", pos + 1);
+        size_t end = pos;
+        while(end < line.size() && (isalnum((unsigned char)line[end]) || strchr("-._", line[end])))
+            ++end;
+        if(pos != std::string::npos && end > pos
+           && !rocblas_gentest_hash_yaml(hash, dir + "/" + line.substr(pos, end - pos), depth + 1))
+            return false;
+    }
+    return ifs.eof();
+}
+
+std::string rocblas_gentest_cache_key(const std::string& yaml,
+                                      const std::string& template_yaml,
+                                      const std::string& script)
+{
+    // Only regular files can be read both here and by rocblas_gentest.py
+    struct stat st;
+    if(stat(yaml.c_str(), &st) || !S_ISREG(st.st_mode))
+        return "";
+
+    rocblas_gentest_hash hash;
+    size_t               arguments_size = sizeof(Arguments);
+    hash.add(&arguments_size, sizeof(arguments_size));
+
+    std::ifstream ifs(script, std::ifstream::binary);
+    if(!ifs)
+        return "";
+    std::string code{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+    hash.add(code.data(), code.size());
+
+    // The template is read before the YAML file
+    if(!rocblas_gentest_hash_yaml(hash, template_yaml, 0)
+       || !rocblas_gentest_hash_yaml(hash, yaml, 0))
+        return "";
+    return hash.hex();
+}
+
+// Directory of the cache, created if necessary, or "" if caching is disabled
+static std::string rocblas_gentest_cache_dir()
+{
+    const char* env = getenv("ROCBLAS_GENTEST_CACHE");
+    std::string dir;
+    if(env)
+        dir = env;
+    else if((env = getenv("XDG_CACHE_HOME")) && *env)
+        dir = std::string(env) + "/rocblas/gentest";
+    else if((env = getenv("HOME")) && *env)
+        dir = std::string(env) + "/.cache/rocblas/gentest";
+
+    std::error_code ec;
+    if(!dir.empty() && !std::filesystem::create_directories(dir, ec) && ec)
+    {
+        rocblas_cerr << "Cannot create " << dir << ": " << ec.message() << std::endl;
+        dir.clear();
+    }
+    return dir;
+}
+#endif // WIN32
+
+// Parse YAML data, and set the binary test data generated from it
+static void rocblas_parse_yaml(const std::string& yaml)
 {
 #ifdef WIN32
     // Generate "/tmp/rocblas-XXXXXX" like file name
@@ -48,24 +161,53 @@ static std::string rocblas_parse_yaml(const std::string& yaml)
     rocblas_cerr << cmd << std::endl;
     int status = std::system(cmd.c_str());
 
-    return tmpname.string(); // results to be read and removed later
+    RocBLAS_TestData::set_filename(tmpname.string(), true); // read and removed at exit
 #else
-    char tmp[] = "/tmp/rocblas-XXXXXX";
-    int  fd    = mkostemp(tmp, O_CLOEXEC);
+    auto exepath  = rocblas_exepath();
+    auto script   = exepath + "rocblas_gentest.py";
+    auto templ    = exepath + "rocblas_template.yaml";
+    auto cachedir = rocblas_gentest_cache_dir();
+    auto key      = cachedir.empty() ? "" : rocblas_gentest_cache_key(yaml, templ, script);
+
+    // Binary data already generated from the same inputs is used directly
+    std::string cached = key.empty() ? "" : cachedir + "/" + key + ".bin";
+    if(!cached.empty() && !access(cached.c_str(), R_OK))
+    {
+        rocblas_cerr << "Using " << cached << " generated from " << yaml << std::endl;
+        RocBLAS_TestData::set_filename(cached);
+        return;
+    }
+
+    // Otherwise it is generated into a temporary file, which is moved into
+    // the cache when complete, so that concurrent runs never see partial data
+    std::string tmp = (cached.empty() ? std::string("/tmp") : cachedir) + "/rocblas-XXXXXX";
+    int         fd  = mkostemp(&tmp[0], O_CLOEXEC);
+    if(fd == -1 && !cached.empty())
+    {
+        cached.clear();
+        tmp = "/tmp/rocblas-XXXXXX";
+        fd  = mkostemp(&tmp[0], O_CLOEXEC);
+    }
     if(fd == -1)
     {
         dprintf(STDERR_FILENO, "Cannot open temporary file: %m\n");
         exit(EXIT_FAILURE);
     }
+    close(fd);
 
-    auto exepath = rocblas_exepath();
-    auto cmd = exepath + "rocblas_gentest.py --template " + exepath + "rocblas_template.yaml -o "
-               + tmp + " " + yaml;
+    auto cmd = script + " --template " + templ + " -o " + tmp + " " + yaml;
     rocblas_cerr << cmd << std::endl;
     int status = system(cmd.c_str());
     if(status == -1 || !WIFEXITED(status) || WEXITSTATUS(status))
+    {
+        unlink(tmp.c_str());
         exit(EXIT_FAILURE);
-    return tmp;
+    }
+
+    if(!cached.empty() && !rename(tmp.c_str(), cached.c_str()))
+        RocBLAS_TestData::set_filename(cached);
+    else
+        RocBLAS_TestData::set_filename(tmp, true); // removed at exit
 #endif
 }
 
@@ -123,11 +265,14 @@ bool rocblas_parse_data(int& argc, char** argv, const std::string& default_file)
         filename = default_file;
 
     if(yaml)
-        filename = rocblas_parse_yaml(filename);
+    {
+        rocblas_parse_yaml(filename);
+        return true;
+    }
 
     if(filename != "")
     {
-        RocBLAS_TestData::set_filename(filename, yaml);
+        RocBLAS_TestData::set_filename(filename);
         return true;
     }
 
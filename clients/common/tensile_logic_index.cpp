@@ -0,0 +1,462 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "tensile_logic_index.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Index file layout: header, tables, entries, then NUL-terminated strings
+    constexpr char     INDEX_MAGIC[8] = "rbTLIDX";
+    constexpr uint32_t INDEX_VERSION  = 1;
+
+    struct index_header
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t table_count;
+        uint64_t entry_count;
+        uint64_t strings_size;
+    };
+
+    struct index_table
+    {
+        uint32_t arch, gfx, problem; // Offsets into the strings
+        uint32_t reserved;
+        uint64_t first, count; // Range of entries
+    };
+
+    static_assert(sizeof(index_header) == 32 && sizeof(index_table) == 32
+                      && sizeof(tensile_logic_entry) == 24,
+                  "Tensile logic index layout has changed");
+
+    auto size_key(const tensile_logic_entry& e)
+    {
+        return std::make_tuple(e.m, e.n, e.batch, e.k);
+    }
+
+    std::string trim(const std::string& s)
+    {
+        auto begin = s.find_first_not_of(" \t\r");
+        auto end   = s.find_last_not_of(" \t\r");
+        return begin == std::string::npos ? "" : s.substr(begin, end - begin + 1);
+    }
+
+    // Numbers of the first [...] list on a line
+    std::vector<double> parse_list(const std::string& line)
+    {
+        std::vector<double> values;
+        auto                begin = line.find('['), end = line.find(']');
+        if(begin == std::string::npos || end == std::string::npos || end < begin)
+            return values;
+        std::string list = line.substr(begin + 1, end - begin - 1);
+        for(const char* p = list.c_str(); *p;)
+        {
+            char*  next;
+            double value = strtod(p, &next);
+            if(next == p)
+                throw std::runtime_error("invalid number in " + line);
+            values.push_back(value);
+            p = next + strspn(next, " ,");
+        }
+        return values;
+    }
+
+    uint32_t to_size(double value, const std::string& line)
+    {
+        if(!(value >= 0 && value <= UINT32_MAX) || value != std::floor(value))
+            throw std::runtime_error("invalid size in " + line);
+        return uint32_t(value);
+    }
+
+    // rocblas-bench type names and their short aliases
+    std::string canonical_type(std::string t)
+    {
+        std::transform(t.begin(), t.end(), t.begin(), ::tolower);
+        static const std::map<std::string, std::string> aliases
+            = {{"h", "f16_r"}, {"s", "f32_r"}, {"d", "f64_r"}, {"c", "f32_c"}, {"z", "f64_c"}};
+        auto it = aliases.find(t);
+        return it == aliases.end() ? t : it->second;
+    }
+
+    // Tensile data type suffix of a problem type, or "" if Tensile does not run it
+    std::string tensile_types(const std::string& a,
+                              const std::string& b,
+                              const std::string& c,
+                              const std::string& d,
+                              const std::string& compute,
+                              bool               pack_int8x4)
+    {
+        if(a != b || c != d)
+            return "";
+
+        static const std::map<std::tuple<std::string, std::string, std::string>, std::string>
+            types = {
+                {{"f16_r", "f16_r", "f16_r"}, "HB"},
+                {{"f16_r", "f16_r", "f32_r"}, "HBH"},
+                {{"f16_r", "f32_r", "f32_r"}, "HSS_BH"},
+                {{"bf16_r", "bf16_r", "f32_r"}, "BBH"},
+                {{"bf16_r", "f32_r", "f32_r"}, "BSS_BH"},
+                {{"f32_r", "f32_r", "f32_r"}, "SB"},
+                {{"f64_r", "f64_r", "f64_r"}, "DB"},
+                {{"f32_c", "f32_c", "f32_c"}, "CB"},
+                {{"f64_c", "f64_c", "f64_c"}, "ZB"},
+                {{"i8_r", "i32_r", "i32_r"}, "I8II_BH"},
+            };
+
+        auto it = types.find(std::make_tuple(a, c, compute));
+        if(it == types.end())
+            return "";
+        return it->second == "I8II_BH" && pack_int8x4 ? "4xi8BH" : it->second;
+    }
+}
+
+tensile_logic_table tensile_logic_parse(std::istream& is, const std::string& filename)
+{
+    tensile_logic_table table;
+
+    auto begin = filename.rfind("Cijk_");
+    if(begin == std::string::npos)
+        throw std::runtime_error(filename + ": not named after a Tensile problem type");
+    auto end      = filename.rfind(".yaml");
+    table.problem = filename.substr(begin, end > begin ? end - begin : std::string::npos);
+
+    // Count the items of the top-level list, which start in the first column
+    int                 item = -1;
+    bool                have_size = false;
+    tensile_logic_entry entry{};
+    for(std::string line; std::getline(is, line);)
+    {
+        if(item < 0 && !line.compare(0, 3, "---"))
+            continue;
+        bool new_item = !line.empty() && line[0] == '-';
+        item += new_item;
+
+        if(item == 1 && new_item)
+            table.arch = trim(line.substr(1));
+        else if(item == 2 && new_item)
+            table.gfx = trim(line.substr(1));
+        else if(item == 7)
+        {
+            // [[M, N, batch, K, ...], [solution, GFLOPS]] over two lines
+            auto values = parse_list(line);
+            if(values.empty())
+                continue;
+            if(line.find("- - [") != std::string::npos)
+            {
+                if(values.size() < 4)
+                    throw std::runtime_error(filename + ": invalid size " + line);
+                entry.m     = to_size(values[0], line);
+                entry.n     = to_size(values[1], line);
+                entry.batch = to_size(values[2], line);
+                entry.k     = to_size(values[3], line);
+                have_size   = true;
+            }
+            else
+            {
+                if(!have_size || values.size() < 2)
+                    throw std::runtime_error(filename + ": invalid solution " + line);
+                entry.solution = int32_t(values[0]);
+                entry.gflops   = float(values[1]);
+                table.entries.push_back(entry);
+                have_size = false;
+            }
+        }
+        else if(item > 7)
+            break;
+    }
+
+    if(item < 7 || is.bad())
+        throw std::runtime_error(filename + ": not a Tensile library logic file");
+    return table;
+}
+
+void tensile_logic_index_write(std::vector<tensile_logic_table> tables, std::ostream& os)
+{
+    std::sort(tables.begin(), tables.end(), [](const auto& a, const auto& b) {
+        return std::tie(a.arch, a.gfx, a.problem) < std::tie(b.arch, b.gfx, b.problem);
+    });
+
+    std::vector<index_table> records;
+    std::string              strings;
+    uint64_t                 entry_count = 0;
+    auto                     add_string  = [&](const std::string& s) {
+        uint32_t offset = uint32_t(strings.size());
+        strings.append(s.c_str(), s.size() + 1);
+        return offset;
+    };
+
+    for(auto& t : tables)
+    {
+        // Sort by size, with the most GFLOPS first among equal sizes, and keep the first
+        std::sort(t.entries.begin(), t.entries.end(), [](const auto& a, const auto& b) {
+            return size_key(a) < size_key(b) || (size_key(a) == size_key(b) && a.gflops > b.gflops);
+        });
+        t.entries.erase(std::unique(t.entries.begin(),
+                                    t.entries.end(),
+                                    [](const auto& a, const auto& b) {
+                                        return size_key(a) == size_key(b);
+                                    }),
+                        t.entries.end());
+
+        index_table record{};
+        record.arch    = add_string(t.arch);
+        record.gfx     = add_string(t.gfx);
+        record.problem = add_string(t.problem);
+        record.first   = entry_count;
+        record.count   = t.entries.size();
+        entry_count += t.entries.size();
+        records.push_back(record);
+    }
+
+    index_header header{};
+    memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version      = INDEX_VERSION;
+    header.table_count  = uint32_t(records.size());
+    header.entry_count  = entry_count;
+    header.strings_size = strings.size();
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(index_table));
+    for(const auto& t : tables)
+        os.write(reinterpret_cast<const char*>(t.entries.data()),
+                 t.entries.size() * sizeof(tensile_logic_entry));
+    os.write(strings.data(), strings.size());
+    if(!os)
+        throw std::runtime_error("cannot write the index");
+}
+
+bool tensile_logic_parse_bench(const std::string& line, tensile_logic_query& query)
+{
+    std::istringstream       is(line);
+    std::vector<std::string> tokens{std::istream_iterator<std::string>(is),
+                                    std::istream_iterator<std::string>()};
+    if(tokens.empty() || tokens[0].find("rocblas-bench") == std::string::npos)
+        return false;
+
+    // rocblas-bench defaults
+    std::map<std::string, std::string> opts
+        = {{"function", "gemm"}, {"precision", "f32_r"}, {"transposeA", "N"}, {"transposeB", "N"},
+           {"sizem", "128"}, {"sizen", "128"}, {"sizek", "128"}, {"batch_count", "1"},
+           {"flags", "0"}};
+    static const std::map<std::string, std::string> short_opts = {
+        {"-f", "function"}, {"-r", "precision"}, {"-m", "sizem"}, {"-n", "sizen"}, {"-k", "sizek"}};
+
+    for(size_t i = 1; i + 1 < tokens.size(); ++i)
+    {
+        const auto& t = tokens[i];
+        auto        s = short_opts.find(t);
+        if(s != short_opts.end())
+            opts[s->second] = tokens[++i];
+        else if(!t.compare(0, 2, "--") && tokens[i + 1].compare(0, 1, "-"))
+            opts[t.substr(2)] = tokens[++i];
+    }
+
+    const auto& function = opts["function"];
+    bool        ex       = function.size() > 3 && !function.compare(function.size() - 3, 3, "_ex");
+    std::string base     = ex ? function.substr(0, function.size() - 3) : function;
+    if(base != "gemm" && base != "gemm_batched" && base != "gemm_strided_batched")
+        return false;
+
+    auto type = [&](const char* name) {
+        return canonical_type(ex && opts.count(name) ? opts[name] : opts["precision"]);
+    };
+    std::string a = type("a_type"), c = type("c_type");
+    std::string types = tensile_types(a,
+                                      type("b_type"),
+                                      c,
+                                      type("d_type"),
+                                      type("compute_type"),
+                                      strtoul(opts["flags"].c_str(), nullptr, 0) & 1);
+    if(types.empty())
+        return false;
+
+    // Conjugate transposes are distinct problem types only for complex types
+    bool complex = a.back() == 'c';
+    auto trans   = [&](const char* name, const char* none, const char* trans) {
+        char op = toupper(opts[name][0]);
+        return std::string(op == 'N' ? none : trans) + (op == 'C' && complex ? "C" : "");
+    };
+
+    query.problem = "Cijk_" + trans("transposeA", "Ailk", "Alik") + "_"
+                    + trans("transposeB", "Bljk", "Bjlk") + "_" + types
+                    + (base == "gemm_batched" ? "_GB" : "");
+
+    char* end;
+    auto  size = [&](const char* name) {
+        long long v = strtoll(opts[name].c_str(), &end, 10);
+        return *end || v < 0 || v > UINT32_MAX ? -1 : v;
+    };
+    long long m = size("sizem"), n = size("sizen"), k = size("sizek");
+    long long batch = base == "gemm" ? 1 : size("batch_count");
+    if(m < 0 || n < 0 || k < 0 || batch < 0)
+        return false;
+
+    query.m     = uint32_t(m);
+    query.n     = uint32_t(n);
+    query.k     = uint32_t(k);
+    query.batch = uint32_t(batch);
+    return true;
+}
+
+tensile_logic_index::tensile_logic_index(const std::string& path)
+{
+#ifndef WIN32
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+        throw std::runtime_error("cannot open " + path + ": " + strerror(errno));
+    struct stat st;
+    if(!fstat(fd, &st) && st.st_size > 0)
+    {
+        void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED)
+        {
+            m_map      = map;
+            m_map_size = st.st_size;
+        }
+    }
+    close(fd);
+    if(m_map)
+    {
+        try
+        {
+            parse(static_cast<const char*>(m_map), m_map_size);
+        }
+        catch(...)
+        {
+            munmap(m_map, m_map_size);
+            throw;
+        }
+        return;
+    }
+#endif
+    std::ifstream ifs(path, std::ifstream::binary);
+    if(!ifs)
+        throw std::runtime_error("cannot open " + path);
+    m_buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    parse(m_buffer.data(), m_buffer.size());
+}
+
+tensile_logic_index::tensile_logic_index(const void* data, size_t size)
+{
+    // Entries are read in place, so copy data which is not aligned for them
+    if(reinterpret_cast<uintptr_t>(data) % alignof(index_header))
+    {
+        m_buffer.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+        data = m_buffer.data();
+    }
+    parse(static_cast<const char*>(data), size);
+}
+
+tensile_logic_index::~tensile_logic_index()
+{
+#ifndef WIN32
+    if(m_map)
+        munmap(m_map, m_map_size);
+#endif
+}
+
+void tensile_logic_index::parse(const char* data, size_t size)
+{
+    auto invalid = [] { return std::runtime_error("invalid Tensile logic index"); };
+
+    index_header header;
+    if(size < sizeof(header))
+        throw invalid();
+    memcpy(&header, data, sizeof(header));
+    if(memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) || header.version != INDEX_VERSION)
+        throw invalid();
+
+    uint64_t tables_end  = sizeof(header) + uint64_t(header.table_count) * sizeof(index_table);
+    uint64_t entries_end = tables_end + header.entry_count * sizeof(tensile_logic_entry);
+    if(header.entry_count > size / sizeof(tensile_logic_entry) || entries_end > size
+       || size - entries_end != header.strings_size || !header.strings_size
+       || data[size - 1])
+        throw invalid();
+
+    auto records = reinterpret_cast<const index_table*>(data + sizeof(header));
+    auto entries = reinterpret_cast<const tensile_logic_entry*>(data + tables_end);
+    auto strings = data + entries_end;
+
+    m_tables.clear();
+    for(uint32_t i = 0; i < header.table_count; ++i)
+    {
+        const auto& r = records[i];
+        if(r.arch >= header.strings_size || r.gfx >= header.strings_size
+           || r.problem >= header.strings_size || r.first > header.entry_count
+           || r.count > header.entry_count - r.first)
+            throw invalid();
+        m_tables.push_back(
+            {strings + r.arch, strings + r.gfx, strings + r.problem, entries + r.first, r.count});
+    }
+}
+
+const tensile_logic_index::table* tensile_logic_index::find(const std::string& arch,
+                                                             const std::string& problem) const
+{
+    for(const auto& t : m_tables)
+        if((arch == t.arch || arch == t.gfx) && problem == t.problem)
+            return &t;
+    return nullptr;
+}
+
+tensile_logic_index::match tensile_logic_index::lookup(
+    const table& t, uint32_t m, uint32_t n, uint32_t batch, uint32_t k)
+{
+    if(!t.count)
+        return {match_kind::none, nullptr};
+
+    tensile_logic_entry key{m, n, batch, k, 0, 0};
+    auto                begin = t.entries, end = t.entries + t.count;
+    auto                it    = std::lower_bound(
+        begin, end, key, [](const auto& a, const auto& b) { return size_key(a) < size_key(b); });
+    if(it != end && size_key(*it) == size_key(key))
+        return {match_kind::exact, it};
+
+    // Entries are sorted by M, so the search for the nearest entry moves away
+    // from M in both directions until the distance in M alone is too large
+    auto dist2 = [&](const tensile_logic_entry& e) {
+        double dm = double(e.m) - m, dn = double(e.n) - n, db = double(e.batch) - batch,
+               dk = double(e.k) - k;
+        return dm * dm + dn * dn + db * db + dk * dk;
+    };
+    const tensile_logic_entry* best      = nullptr;
+    double                     best_dist = std::numeric_limits<double>::infinity();
+    auto                       visit     = [&](const tensile_logic_entry& e) {
+        double dm = double(e.m) - m;
+        if(dm * dm > best_dist)
+            return false;
+        double d = dist2(e);
+        if(d < best_dist)
+        {
+            best_dist = d;
+            best      = &e;
+        }
+        return true;
+    };
+    for(auto up = it; up != end && visit(*up); ++up)
+        ;
+    for(auto down = it; down != begin && visit(*(down - 1)); --down)
+        ;
+    return {match_kind::fallback, best};
+}
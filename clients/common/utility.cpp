@@ -6,13 +6,18 @@
 #include <windows.h>
 #endif
 #include "../../library/src/include/handle.hpp"
+#include "client_cache.hpp"
 #include "rocblas_random.hpp"
 #include "utility.hpp"
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <mutex>
 #include <new>
 #include <stdexcept>
+#include <unordered_map>
 
 #ifdef WIN32
 #define strcasecmp(A, B) _stricmp(A, B)
@@ -134,9 +139,109 @@ double get_time_us_no_sync(void)
     return (static_cast<double>(duration));
 };
 
+rocblas_hot_samples::rocblas_hot_samples(int batch)
+    : m_events(batch + 1)
+{
+    for(size_t i = 0; i < m_events.size(); ++i)
+        if(hipEventCreate(&m_events[i]) != hipSuccess)
+        {
+            m_events.resize(i);
+            for(auto event : m_events)
+                hipEventDestroy(event);
+            m_events.clear();
+            break;
+        }
+}
+
+rocblas_hot_samples::~rocblas_hot_samples()
+{
+    for(auto event : m_events)
+        hipEventDestroy(event);
+}
+
+void rocblas_hot_samples::start(hipStream_t stream)
+{
+    m_recorded = 0;
+    if(timed())
+        hipEventRecord(m_events[0], stream);
+}
+
+void rocblas_hot_samples::record(hipStream_t stream)
+{
+    if(timed() && m_recorded + 1 < m_events.size())
+        hipEventRecord(m_events[++m_recorded], stream);
+}
+
+const std::vector<double>& rocblas_hot_samples::collect()
+{
+    if(m_recorded && hipEventSynchronize(m_events[m_recorded]) == hipSuccess)
+    {
+        for(size_t i = 0; i < m_recorded; ++i)
+        {
+            float ms;
+            if(hipEventElapsedTime(&ms, m_events[i], m_events[i + 1]) == hipSuccess)
+                m_samples.push_back(ms * 1000.0);
+        }
+    }
+    m_recorded = 0;
+    return m_samples;
+}
+
+static bool        timing_samples   = false;
+static double      timing_rel_ci    = 0;
+static rocblas_int timing_max_calls = 0;
+
+void rocblas_timing_set_samples(bool samples)
+{
+    timing_samples = samples;
+}
+
+bool rocblas_timing_get_samples()
+{
+    return timing_samples;
+}
+
+void rocblas_timing_set_convergence(double rel_ci, rocblas_int max_calls)
+{
+    timing_rel_ci    = rel_ci;
+    timing_max_calls = max_calls;
+}
+
+double rocblas_timing_get_convergence()
+{
+    return timing_rel_ci;
+}
+
+rocblas_int rocblas_timing_get_max_calls()
+{
+    return timing_max_calls;
+}
+
+// Each thread runs its own drivers, so the samples of its last hot loop are its own
+static thread_local std::unique_ptr<rocblas_hot_samples> timing_last;
+
+void rocblas_timing_set_last(std::unique_ptr<rocblas_hot_samples> samples)
+{
+    timing_last = std::move(samples);
+}
+
+bool rocblas_timing_take_last(rocblas_timing_stats& stats)
+{
+    if(!timing_last)
+        return false;
+    stats = rocblas_timing_summarize(timing_last->collect());
+    timing_last.reset();
+    return stats.samples > 0;
+}
+
+void rocblas_timing_clear_last()
+{
+    timing_last.reset();
+}
+
 /* ============================================================================================ */
 /*  device query and print out their ID and name; return number of compute-capable devices. */
-rocblas_int query_device_property()
+rocblas_int query_device_property(rocblas_internal_ostream& os)
 {
     int            device_count;
     rocblas_status status = (rocblas_status)hipGetDeviceCount(&device_count);
@@ -147,15 +252,13 @@ rocblas_int query_device_property()
     }
     else
     {
-        rocblas_cout << "Query device success: there are " << device_count << " devices"
-                     << std::endl;
+        os << "Query device success: there are " << device_count << " devices" << std::endl;
     }
 
     for(rocblas_int i = 0;; i++)
     {
-        rocblas_cout
-            << "-------------------------------------------------------------------------------"
-            << std::endl;
+        os << "-------------------------------------------------------------------------------"
+           << std::endl;
 
         if(i >= device_count)
             break;
@@ -189,7 +292,7 @@ rocblas_int query_device_property()
                 props.sharedMemPerBlock / 1e3,
                 props.maxThreadsPerBlock,
                 props.warpSize);
-            rocblas_cout << buf;
+            os << buf;
         }
     }
 
@@ -207,15 +310,221 @@ void set_device(rocblas_int device_id)
     }
 }
 
+/****************
+ * client cache *
+ ****************/
+
+namespace
+{
+    class client_cache
+    {
+        std::mutex m_mutex;
+        bool       m_enabled = false;
+
+        // Free blocks by size, and the sizes of blocks allocated while enabled
+        std::multimap<size_t, void*>      m_free[2];
+        std::unordered_map<void*, size_t> m_size[2];
+        std::vector<rocblas_handle>       m_handles;
+
+        static void* allocate(size_t bytes, bool host)
+        {
+            void* ptr = nullptr;
+            if((host ? hipHostMalloc(&ptr, bytes, hipHostMallocDefault) : (hipMalloc)(&ptr, bytes))
+               != hipSuccess)
+                ptr = nullptr;
+            return ptr;
+        }
+
+        static hipError_t deallocate(void* ptr, bool host)
+        {
+            return host ? hipHostFree(ptr) : (hipFree)(ptr);
+        }
+
+        void release(std::multimap<size_t, void*>::iterator it, bool host)
+        {
+            m_size[host].erase(it->second);
+            deallocate(it->second, host);
+            m_free[host].erase(it);
+        }
+
+        void clear_locked()
+        {
+            for(bool host : {false, true})
+                while(!m_free[host].empty())
+                    release(m_free[host].begin(), host);
+            for(auto handle : m_handles)
+                rocblas_destroy_handle(handle);
+            m_handles.clear();
+        }
+
+    public:
+        void enable(bool enable)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_enabled = enable;
+            if(!enable)
+                clear_locked();
+        }
+
+        bool enabled()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_enabled;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            clear_locked();
+        }
+
+        void* malloc(size_t bytes, bool host)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_enabled)
+                return allocate(bytes, host);
+
+            // Reuse the smallest free block which is large enough, unless it is
+            // so much larger that a later, larger request would be better served
+            auto& blocks = m_free[host];
+            auto  it     = blocks.lower_bound(bytes);
+            if(it != blocks.end() && it->first <= std::max(2 * bytes, size_t(1) << 20))
+            {
+                void* ptr = it->second;
+                blocks.erase(it);
+                return ptr;
+            }
+
+            // Replace the largest free block which is too small with a new one
+            if(it != blocks.begin())
+                release(std::prev(it), host);
+
+            void* ptr = allocate(bytes, host);
+            if(!ptr && !blocks.empty())
+            {
+                while(!blocks.empty())
+                    release(blocks.begin(), host);
+                ptr = allocate(bytes, host);
+            }
+            if(ptr)
+                m_size[host][ptr] = bytes;
+            return ptr;
+        }
+
+        hipError_t free(void* ptr, bool host)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto                        it = m_size[host].find(ptr);
+            if(!m_enabled || it == m_size[host].end())
+                return deallocate(ptr, host);
+
+            // Like hipFree, wait for work which may still use the memory
+            hipError_t status = hipDeviceSynchronize();
+            m_free[host].emplace(it->second, ptr);
+            return status;
+        }
+
+        rocblas_handle take_handle()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_enabled || m_handles.empty())
+                return nullptr;
+            auto handle = m_handles.back();
+            m_handles.pop_back();
+            return handle;
+        }
+
+        bool return_handle(rocblas_handle handle)
+        {
+            if(!enabled())
+                return false;
+
+            // Return the handle to the state of a new one, apart from its workspace
+            if(rocblas_set_stream(handle, nullptr) != rocblas_status_success
+               || rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host)
+                      != rocblas_status_success
+               || rocblas_set_atomics_mode(handle, rocblas_atomics_allowed)
+                      != rocblas_status_success
+               || rocblas_set_host_result_mode(handle, rocblas_host_result_blocking)
+                      != rocblas_status_success
+               || rocblas_set_capture_mode(handle, rocblas_capture_default)
+                      != rocblas_status_success
+               || rocblas_reset_sync_point_counts(handle) != rocblas_status_success
+               || rocblas_reset_perf_counters(handle) != rocblas_status_success
+               || rocblas_set_trsm_inverse_cache_size(handle, 0) != rocblas_status_success
+               || rocblas_set_trsm_inverse_cache_generation(handle, 0) != rocblas_status_success
+               || rocblas_set_trsm_inverse_cache_batched(
+                      handle, rocblas_trsm_inverse_cache_batched_excluded)
+                      != rocblas_status_success
+               || rocblas_reset_trsm_inverse_cache_stats(handle) != rocblas_status_success
+               || rocblas_set_performance_metric(handle, rocblas_default_performance_metric)
+                      != rocblas_status_success
+               || rocblas_set_start_stop_events(handle, nullptr, nullptr)
+                      != rocblas_status_success
+               || rocblas_set_solution_fitness_query(handle, nullptr) != rocblas_status_success)
+                return false;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_handles.push_back(handle);
+            return true;
+        }
+    };
+
+    client_cache& get_client_cache()
+    {
+        static client_cache cache;
+        return cache;
+    }
+}
+
+void rocblas_client_cache_enable(bool enable)
+{
+    get_client_cache().enable(enable);
+}
+
+bool rocblas_client_cache_enabled()
+{
+    return get_client_cache().enabled();
+}
+
+void rocblas_client_cache_clear()
+{
+    get_client_cache().clear();
+}
+
+void* rocblas_client_malloc(size_t bytes, bool host)
+{
+    return get_client_cache().malloc(bytes, host);
+}
+
+hipError_t rocblas_client_free(void* ptr, bool host)
+{
+    return get_client_cache().free(ptr, host);
+}
+
+rocblas_handle rocblas_client_cache_take_handle()
+{
+    return get_client_cache().take_handle();
+}
+
+bool rocblas_client_cache_return_handle(rocblas_handle handle)
+{
+    return get_client_cache().return_handle(handle);
+}
+
 /*****************
  * local handles *
  *****************/
 
 rocblas_local_handle::rocblas_local_handle()
 {
-    auto status = rocblas_create_handle(&m_handle);
-    if(status != rocblas_status_success)
-        throw std::runtime_error(rocblas_status_to_string(status));
+    m_handle = rocblas_client_cache_take_handle();
+    if(!m_handle)
+    {
+        auto status = rocblas_create_handle(&m_handle);
+        if(status != rocblas_status_success)
+            throw std::runtime_error(rocblas_status_to_string(status));
+    }
 
 #ifdef GOOGLE_TEST
     if(t_set_stream_callback)
@@ -249,7 +558,12 @@ rocblas_local_handle::rocblas_local_handle(const Arguments& arg)
 
 rocblas_local_handle::~rocblas_local_handle()
 {
+    // A cached handle goes back to rocBLAS-managed workspace before the user's is freed
+    bool cached
+        = (!m_memory || rocblas_set_workspace(m_handle, nullptr, 0) == rocblas_status_success)
+          && rocblas_client_cache_return_handle(m_handle);
     if(m_memory)
         (hipFree)(m_memory);
-    rocblas_destroy_handle(m_handle);
+    if(!cached)
+        rocblas_destroy_handle(m_handle);
 }
@@ -0,0 +1,201 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_binary_log.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_log_decoder.hpp"
+#include "rocblas_test.hpp"
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // Logs each call as text, and encodes it with trace and bench writers
+    // which share one binary stream, as when both logs go to the same file
+    struct binary_log_pair
+    {
+        rocblas_internal_ostream  trace_text, bench_text, text, binary;
+        rocblas_binary_log_writer trace{binary, rocblas_binary_log::stream_t::trace, this};
+        rocblas_binary_log_writer bench{binary, rocblas_binary_log::stream_t::bench, this};
+
+        // As log_trace, which appends the atomics mode
+        template <typename... Ts>
+        void log_trace(const Ts&... xs)
+        {
+            log_arguments(trace_text, nullptr, ",", xs..., rocblas_atomics_allowed);
+            log_arguments(text, nullptr, ",", xs..., rocblas_atomics_allowed);
+            log_arguments(binary, &trace, ",", xs..., rocblas_atomics_allowed);
+        }
+
+        template <typename... Ts>
+        void log_bench(const Ts&... xs)
+        {
+            log_arguments(bench_text, nullptr, " ", xs...);
+            log_arguments(text, nullptr, " ", xs...);
+            log_arguments(binary, &bench, " ", xs...);
+        }
+
+        std::string decode(bool want_trace, bool want_bench)
+        {
+            std::istringstream in(binary.str());
+            std::ostringstream out;
+            rocblas_binary_log::decoder(want_trace, want_bench, false).decode(in, out);
+            return out.str();
+        }
+    };
+
+    // Every argument tag decodes to the text which log_trace and log_bench write
+    void testing_binary_log_decode()
+    {
+        binary_log_pair log;
+
+        const float  nan    = std::numeric_limits<float>::quiet_NaN();
+        const float  inf    = std::numeric_limits<float>::infinity();
+        const void*  handle = &log;
+        const float* A      = reinterpret_cast<const float*>(uintptr_t(0x7f0012345670));
+        const float* null   = nullptr;
+        std::string  name   = "rocblas_gemm_ex";
+
+        // Integers, enumerations, pointers and interned strings
+        log.log_trace("rocblas_sgemm",
+                      handle,
+                      rocblas_operation_none,
+                      rocblas_operation_conjugate_transpose,
+                      rocblas_int(128),
+                      rocblas_int(-7),
+                      int64_t(1) << 40,
+                      std::numeric_limits<int64_t>::min(),
+                      uint32_t(4000000000u),
+                      size_t(3) << 33,
+                      A,
+                      null,
+                      rocblas_fill_lower,
+                      rocblas_diagonal_unit,
+                      rocblas_side_right,
+                      rocblas_pointer_mode_device);
+
+        // Floating-point values, with half and bfloat16 stored as f32
+        log.log_trace("rocblas_hgemm",
+                      1.5f,
+                      nan,
+                      -inf,
+                      0.1,
+                      1e-300,
+                      rocblas_half(2.5),
+                      rocblas_bfloat16(-3.0f),
+                      rocblas_float_complex(1.0f, -2.5f),
+                      rocblas_double_complex(-0.25, 1e20),
+                      rocblas_log_trace_scalar<float>{0.75f},
+                      rocblas_log_trace_scalar<double>{nan},
+                      rocblas_log_trace_scalar<rocblas_bfloat16>{rocblas_bfloat16(0.5f)},
+                      rocblas_log_trace_scalar<rocblas_float_complex>{{nan, nan}});
+
+        // Text, characters, booleans and the remaining enumerations. The
+        // same contents at a different address reuse the interned string.
+        log.log_trace(name.c_str(),
+                      std::string("a, b"),
+                      std::string(),
+                      'N',
+                      true,
+                      false,
+                      rocblas_datatype_f16_r,
+                      rocblas_datatype_bf16_c,
+                      rocblas_status_invalid_size,
+                      rocblas_atomics_not_allowed,
+                      rocblas_gemm_flags_pack_int8x4,
+                      int8_t(-3),
+                      uint16_t(65535));
+        log.log_trace(std::string(name).c_str(), "rocblas_sgemm", "", 'T');
+
+        // Bench options, including complex scalars with and without an
+        // imaginary part
+        log.log_bench("./rocblas-bench",
+                      "-f",
+                      "gemm",
+                      "-r",
+                      rocblas_datatype_f32_c,
+                      "--transposeA",
+                      'N',
+                      "-m",
+                      rocblas_int(128),
+                      "--lda",
+                      int64_t(1) << 33,
+                      rocblas_log_bench_scalar<float>{"alpha", 2.0f},
+                      rocblas_log_bench_scalar<double>{"beta", nan},
+                      rocblas_log_bench_scalar<rocblas_bfloat16>{"alpha", rocblas_bfloat16(1.25f)},
+                      rocblas_log_bench_scalar<rocblas_float_complex>{"alpha", {1.0f, 0.0f}},
+                      rocblas_log_bench_scalar<rocblas_double_complex>{"beta", {0.5, -1.5}},
+                      "--atomics_not_allowed");
+        log.log_trace("rocblas_sgemm", handle);
+        log.log_bench("./rocblas-bench", "-f", "gemm", "-m", rocblas_int(1));
+
+        EXPECT_EQ(log.decode(true, true), log.text.str());
+        EXPECT_EQ(log.decode(true, false), log.trace_text.str());
+        EXPECT_EQ(log.decode(false, true), log.bench_text.str());
+    }
+
+    // Corrupt or truncated captures are reported instead of decoded
+    void testing_binary_log_errors()
+    {
+        binary_log_pair log;
+        log.log_trace("rocblas_sgemm", rocblas_int(1), 2.0f);
+
+        auto decode = [](const std::string& capture) {
+            std::istringstream in(capture);
+            std::ostringstream out;
+            rocblas_binary_log::decoder(true, true, false).decode(in, out);
+        };
+
+        std::string capture = log.binary.str();
+        EXPECT_NO_THROW(decode(capture));
+        EXPECT_THROW(decode(capture.substr(0, capture.size() - 1)), std::runtime_error);
+        EXPECT_THROW(decode(std::string(1, char(0x0f)) + capture), std::runtime_error);
+
+        std::string bad_magic = capture;
+        bad_magic[bad_magic.find('R')] = 'X';
+        EXPECT_THROW(decode(bad_magic), std::runtime_error);
+    }
+
+    template <typename...>
+    struct testing_binary_log : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            testing_binary_log_decode();
+            testing_binary_log_errors();
+        }
+    };
+
+    struct binary_log : RocBLAS_Test<binary_log, testing_binary_log>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "binary_log");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<binary_log>(arg.name);
+        }
+    };
+
+    TEST_P(binary_log, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_binary_log<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(binary_log)
+
+} // namespace
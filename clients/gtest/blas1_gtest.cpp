@@ -6,8 +6,10 @@
 #include "testing_asum.hpp"
 #include "testing_asum_batched.hpp"
 #include "testing_asum_strided_batched.hpp"
+#include "testing_axpby.hpp"
 #include "testing_axpy.hpp"
 #include "testing_axpy_batched.hpp"
+#include "testing_axpy_dot.hpp"
 #include "testing_axpy_strided_batched.hpp"
 #include "testing_copy.hpp"
 #include "testing_copy_batched.hpp"
@@ -18,6 +20,7 @@
 #include "testing_iamax_iamin.hpp"
 #include "testing_iamax_iamin_batched.hpp"
 #include "testing_iamax_iamin_strided_batched.hpp"
+#include "testing_multi_dot.hpp"
 #include "testing_nrm2.hpp"
 #include "testing_nrm2_batched.hpp"
 #include "testing_nrm2_strided_batched.hpp"
@@ -35,6 +38,7 @@
 #include "testing_rotmg_strided_batched.hpp"
 #include "testing_scal.hpp"
 #include "testing_scal_batched.hpp"
+#include "testing_scal_nrm2.hpp"
 #include "testing_scal_strided_batched.hpp"
 #include "testing_swap.hpp"
 #include "testing_swap_batched.hpp"
@@ -88,6 +92,18 @@ namespace
         rotmg,
         rotmg_batched,
         rotmg_strided_batched,
+        axpby,
+        axpby_batched,
+        axpby_strided_batched,
+        axpy_dot,
+        axpy_dot_batched,
+        axpy_dot_strided_batched,
+        multi_dot,
+        multi_dot_batched,
+        multi_dot_strided_batched,
+        scal_nrm2,
+        scal_nrm2_batched,
+        scal_nrm2_strided_batched,
     };
 
     // ----------------------------------------------------------------------------
@@ -122,7 +138,11 @@ namespace
                        || BLAS1 == blas1::dot_strided_batched || BLAS1 == blas1::dotc
                        || BLAS1 == blas1::dotc_batched || BLAS1 == blas1::dotc_strided_batched);
                 bool is_axpy  = (BLAS1 == blas1::axpy || BLAS1 == blas1::axpy_batched
-                                || BLAS1 == blas1::axpy_strided_batched);
+                                || BLAS1 == blas1::axpy_strided_batched
+                       || BLAS1 == blas1::axpby_strided_batched
+                       || BLAS1 == blas1::axpy_dot_strided_batched
+                       || BLAS1 == blas1::multi_dot_strided_batched
+                       || BLAS1 == blas1::scal_nrm2_strided_batched);
                 bool is_scal  = (BLAS1 == blas1::scal || BLAS1 == blas1::scal_batched
                                 || BLAS1 == blas1::scal_strided_batched);
                 bool is_rot   = (BLAS1 == blas1::rot || BLAS1 == blas1::rot_batched
@@ -131,6 +151,14 @@ namespace
                                 || BLAS1 == blas1::rotg_strided_batched);
                 bool is_rotmg = (BLAS1 == blas1::rotmg || BLAS1 == blas1::rotmg_batched
                                  || BLAS1 == blas1::rotmg_strided_batched);
+                bool is_axpby = (BLAS1 == blas1::axpby || BLAS1 == blas1::axpby_batched
+                                 || BLAS1 == blas1::axpby_strided_batched);
+                bool is_axpy_dot = (BLAS1 == blas1::axpy_dot || BLAS1 == blas1::axpy_dot_batched
+                                    || BLAS1 == blas1::axpy_dot_strided_batched);
+                bool is_multi_dot = (BLAS1 == blas1::multi_dot || BLAS1 == blas1::multi_dot_batched
+                                     || BLAS1 == blas1::multi_dot_strided_batched);
+                bool is_scal_nrm2 = (BLAS1 == blas1::scal_nrm2 || BLAS1 == blas1::scal_nrm2_batched
+                                     || BLAS1 == blas1::scal_nrm2_strided_batched);
                 bool is_batched
                     = (BLAS1 == blas1::nrm2_batched || BLAS1 == blas1::asum_batched
                        || BLAS1 == blas1::scal_batched || BLAS1 == blas1::swap_batched
@@ -138,7 +166,9 @@ namespace
                        || BLAS1 == blas1::dotc_batched || BLAS1 == blas1::rot_batched
                        || BLAS1 == blas1::rotm_batched || BLAS1 == blas1::rotg_batched
                        || BLAS1 == blas1::iamax_batched || BLAS1 == blas1::iamin_batched
-                       || BLAS1 == blas1::rotmg_batched || BLAS1 == blas1::axpy_batched);
+                       || BLAS1 == blas1::rotmg_batched || BLAS1 == blas1::axpy_batched
+                       || BLAS1 == blas1::axpby_batched || BLAS1 == blas1::axpy_dot_batched
+                       || BLAS1 == blas1::multi_dot_batched || BLAS1 == blas1::scal_nrm2_batched);
                 bool is_strided
                     = (BLAS1 == blas1::nrm2_strided_batched || BLAS1 == blas1::asum_strided_batched
                        || BLAS1 == blas1::scal_strided_batched
@@ -162,9 +192,15 @@ namespace
                 if(!is_rotg && !is_rotmg)
                     name << '_' << arg.N;
 
-                if(is_axpy || is_scal)
+                if(is_multi_dot)
+                    name << '_' << arg.K;
+
+                if(is_axpy || is_scal || is_axpby || is_axpy_dot || is_scal_nrm2)
                     name << '_' << arg.alpha << "_" << arg.alphai;
 
+                if(is_axpby)
+                    name << '_' << arg.beta << "_" << arg.betai;
+
                 if(!is_rotg && !is_rotmg)
                     name << '_' << arg.incx;
 
@@ -177,15 +213,22 @@ namespace
                    || BLAS1 == blas1::copy_batched || is_dot || BLAS1 == blas1::swap
                    || BLAS1 == blas1::swap_batched || BLAS1 == blas1::swap_strided_batched || is_rot
                    || BLAS1 == blas1::rotm || BLAS1 == blas1::rotm_batched
-                   || BLAS1 == blas1::rotm_strided_batched)
+                   || BLAS1 == blas1::rotm_strided_batched || is_axpby || is_axpy_dot
+                   || is_multi_dot)
                 {
                     name << '_' << arg.incy;
                 }
 
+                if(is_multi_dot)
+                    name << '_' << arg.lda;
+
                 if(BLAS1 == blas1::swap_strided_batched || BLAS1 == blas1::copy_strided_batched
                    || BLAS1 == blas1::dot_strided_batched || BLAS1 == blas1::dotc_strided_batched
                    || BLAS1 == blas1::rot_strided_batched || BLAS1 == blas1::rotm_strided_batched
-                   || BLAS1 == blas1::axpy_strided_batched)
+                   || BLAS1 == blas1::axpy_strided_batched
+                   || BLAS1 == blas1::axpby_strided_batched
+                   || BLAS1 == blas1::axpy_dot_strided_batched
+                   || BLAS1 == blas1::multi_dot_strided_batched)
                 {
                     name << '_' << arg.stride_y;
                 }
@@ -206,7 +249,7 @@ namespace
                     name << "_" << arg.batch_count;
                 }
 
-                if(is_dot)
+                if(is_dot || is_axpy_dot)
                 {
                     name << "_" << arg.algo;
                 }
@@ -329,7 +372,19 @@ namespace
             || ((BLAS1 == blas1::rotmg || BLAS1 == blas1::rotmg_batched
                  || BLAS1 == blas1::rotmg_strided_batched)
                 && std::is_same<To, Ti>{} && std::is_same<To, Tc>{}
-                && (std::is_same<Ti, float>{} || std::is_same<Ti, double>{}))>;
+                && (std::is_same<Ti, float>{} || std::is_same<Ti, double>{}))
+
+            || ((BLAS1 == blas1::axpby || BLAS1 == blas1::axpby_batched
+                 || BLAS1 == blas1::axpby_strided_batched || BLAS1 == blas1::axpy_dot
+                 || BLAS1 == blas1::axpy_dot_batched || BLAS1 == blas1::axpy_dot_strided_batched
+                 || BLAS1 == blas1::multi_dot || BLAS1 == blas1::multi_dot_batched
+                 || BLAS1 == blas1::multi_dot_strided_batched || BLAS1 == blas1::scal_nrm2
+                 || BLAS1 == blas1::scal_nrm2_batched
+                 || BLAS1 == blas1::scal_nrm2_strided_batched)
+                && std::is_same<To, Ti>{} && std::is_same<To, Tc>{}
+                && (std::is_same<Ti, float>{} || std::is_same<Ti, double>{}
+                    || std::is_same<Ti, rocblas_float_complex>{}
+                    || std::is_same<Ti, rocblas_double_complex>{}))>;
 
 // Creates tests for one of the BLAS 1 functions
 // ARG passes 1-3 template arguments to the testing_* function
@@ -420,5 +475,17 @@ namespace
     BLAS1_TESTING(rotmg, ARG1)
     BLAS1_TESTING(rotmg_batched, ARG1)
     BLAS1_TESTING(rotmg_strided_batched, ARG1)
+    BLAS1_TESTING(axpby, ARG1)
+    BLAS1_TESTING(axpby_batched, ARG1)
+    BLAS1_TESTING(axpby_strided_batched, ARG1)
+    BLAS1_TESTING(axpy_dot, ARG1)
+    BLAS1_TESTING(axpy_dot_batched, ARG1)
+    BLAS1_TESTING(axpy_dot_strided_batched, ARG1)
+    BLAS1_TESTING(multi_dot, ARG1)
+    BLAS1_TESTING(multi_dot_batched, ARG1)
+    BLAS1_TESTING(multi_dot_strided_batched, ARG1)
+    BLAS1_TESTING(scal_nrm2, ARG1)
+    BLAS1_TESTING(scal_nrm2_batched, ARG1)
+    BLAS1_TESTING(scal_nrm2_strided_batched, ARG1)
 
 } // namespace
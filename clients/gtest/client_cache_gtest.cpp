@@ -0,0 +1,96 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "client_cache.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <cstring>
+#include <string>
+
+namespace
+{
+    template <typename...>
+    struct testing_client_cache : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            size_t N = arg.N;
+
+            rocblas_client_cache_enable(true);
+            EXPECT_TRUE(rocblas_client_cache_enabled());
+
+            // Freed buffers and handles are reused by later requests
+            float*         device;
+            float*         host;
+            rocblas_handle handle;
+            {
+                device_vector<float>      d(N);
+                host_pinned_vector<float> h(N);
+                rocblas_local_handle      l;
+                ASSERT_NE((float*)d, nullptr);
+                device = d;
+                host   = h;
+                handle = l;
+                CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(l, rocblas_pointer_mode_device));
+            }
+            {
+                device_vector<float>      d(N / 2 + 1);
+                host_pinned_vector<float> h(N);
+                rocblas_local_handle      l;
+                EXPECT_EQ((float*)d, device);
+                EXPECT_EQ((float*)h, host);
+                EXPECT_EQ((rocblas_handle)l, handle);
+
+                // A reused handle has the state of a new one
+                rocblas_pointer_mode mode;
+                CHECK_ROCBLAS_ERROR(rocblas_get_pointer_mode(l, &mode));
+                EXPECT_EQ(mode, rocblas_pointer_mode_host);
+
+                // A buffer in use is not handed out again
+                device_vector<float> d2(N);
+                ASSERT_NE((float*)d2, nullptr);
+                EXPECT_NE((float*)d2, device);
+            }
+
+            rocblas_client_cache_enable(false);
+            EXPECT_FALSE(rocblas_client_cache_enabled());
+
+            // Without the cache, memory is allocated and freed directly
+            {
+                device_vector<float> d(N);
+                ASSERT_NE((float*)d, nullptr);
+                rocblas_local_handle l;
+            }
+        }
+    };
+
+    struct client_cache : RocBLAS_Test<client_cache, testing_client_cache>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "client_cache");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<client_cache>(arg.name) << arg.N;
+        }
+    };
+
+    TEST_P(client_cache, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_client_cache<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(client_cache)
+
+} // namespace
@@ -0,0 +1,297 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_device_memory_pool.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Host memory backend, where streams and fences are integers which record
+    // the stream a block was last released on, and the context counts the
+    // allocations and frees made for a user. Copies share their state.
+    struct host_memory_backend
+    {
+        using stream_t  = int;
+        using fence_t   = int;
+        using context_t = size_t*;
+
+        struct state_t
+        {
+            std::mutex               mutex;
+            std::map<void*, size_t>  live;
+            size_t                   allocated = 0;
+            size_t                   limit     = SIZE_MAX;
+            std::atomic<size_t>      waits{0};
+        };
+        std::shared_ptr<state_t> state = std::make_shared<state_t>();
+
+        void* allocate(size_t size, size_t* calls)
+        {
+            if(calls)
+                ++*calls;
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if(state->allocated + size > state->limit)
+                return nullptr;
+            void* ptr = malloc(size);
+            if(ptr)
+            {
+                state->allocated += size;
+                state->live[ptr] = size;
+            }
+            return ptr;
+        }
+
+        void deallocate(void* ptr, size_t* calls)
+        {
+            if(calls)
+                ++*calls;
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->allocated -= state->live.at(ptr);
+            state->live.erase(ptr);
+            free(ptr);
+        }
+
+        void record(int& fence, int stream)
+        {
+            fence = stream;
+        }
+
+        void wait(int& fence, int stream)
+        {
+            if(fence && fence != stream)
+                ++state->waits;
+        }
+
+        void destroy(int& fence)
+        {
+            fence = 0;
+        }
+    };
+
+    using host_pool = rocblas_size_class_pool<host_memory_backend>;
+
+    void testing_size_classes()
+    {
+        size_t prev = 0;
+        for(size_t size = 1; size < (size_t(1) << 34); size += size / 7 + 1)
+        {
+            size_t c     = host_pool::size_class(size);
+            size_t block = host_pool::class_size(c);
+            EXPECT_GE(block, size);
+            EXPECT_GE(c, prev);
+            EXPECT_EQ(host_pool::size_class(block), c);
+            if(size > host_pool::MIN_BLOCK_SIZE)
+            {
+                EXPECT_LE(block, size + size / 4);
+            }
+            prev = c;
+        }
+    }
+
+    void testing_reuse_and_stats()
+    {
+        host_memory_backend backend;
+        host_pool           pool(backend);
+
+        auto a = pool.acquire(1000000, 1);
+        ASSERT_NE(a.ptr, nullptr);
+        EXPECT_GE(a.size, size_t(1000000));
+        auto b = pool.acquire(3000, 1);
+        ASSERT_NE(b.ptr, nullptr);
+        EXPECT_EQ(b.size, host_pool::MIN_BLOCK_SIZE);
+
+        auto stats = pool.get_stats();
+        EXPECT_EQ(stats.allocations, size_t(2));
+        EXPECT_EQ(stats.device_allocations, size_t(2));
+        EXPECT_EQ(stats.reuses, size_t(0));
+        EXPECT_EQ(stats.bytes_in_use, a.size + b.size);
+        EXPECT_EQ(stats.bytes_requested, size_t(1003000));
+        EXPECT_EQ(stats.high_water_in_use, a.size + b.size);
+        EXPECT_GT(stats.fragmentation, 0.0);
+
+        void* a_ptr = a.ptr;
+        pool.release(a, 1);
+        pool.release(b, 1);
+        stats = pool.get_stats();
+        EXPECT_EQ(stats.bytes_in_use, size_t(0));
+        EXPECT_EQ(stats.bytes_requested, size_t(0));
+        EXPECT_EQ(stats.bytes_cached, a.size + b.size);
+        EXPECT_EQ(stats.blocks_cached, size_t(2));
+        EXPECT_EQ(stats.fragmentation, 1.0);
+
+        // A slightly smaller request in a nearby class reuses the cached block,
+        // on another stream which must wait for the release on the first stream
+        auto c = pool.acquire(900000, 2);
+        EXPECT_EQ(c.ptr, a_ptr);
+        EXPECT_EQ(backend.state->waits, size_t(1));
+        stats = pool.get_stats();
+        EXPECT_EQ(stats.reuses, size_t(1));
+        EXPECT_EQ(stats.device_allocations, size_t(2));
+        EXPECT_EQ(stats.high_water_reserved, a.size + b.size);
+
+        // A much smaller request does not take the large block
+        auto d = pool.acquire(100000, 2);
+        EXPECT_NE(d.ptr, a_ptr);
+        pool.release(c, 2);
+        pool.release(d, 2);
+
+        pool.reset_stats();
+        stats = pool.get_stats();
+        EXPECT_EQ(stats.allocations, size_t(0));
+        EXPECT_EQ(stats.high_water_in_use, size_t(0));
+        EXPECT_EQ(stats.high_water_reserved, stats.bytes_cached);
+
+        // The blocks are freed for the user who trims the pool
+        size_t calls = 0;
+        pool.trim(&calls);
+        stats = pool.get_stats();
+        EXPECT_EQ(stats.bytes_cached, size_t(0));
+        EXPECT_EQ(stats.device_frees, size_t(3));
+        EXPECT_EQ(calls, size_t(3));
+    }
+
+    void testing_allocation_failure()
+    {
+        host_memory_backend backend;
+        backend.state->limit = 900000;
+        host_pool pool(backend);
+
+        auto a = pool.acquire(600000, 1);
+        ASSERT_NE(a.ptr, nullptr);
+        pool.release(a, 1);
+
+        // Too small to reuse the cached block
+        auto b = pool.acquire(100000, 1);
+        ASSERT_NE(b.ptr, nullptr);
+        EXPECT_EQ(pool.get_stats().reuses, size_t(0));
+
+        // Does not fit until the cached block is freed, which is done for the user, with a
+        // failed and a successful allocation
+        size_t calls = 0;
+        auto   c     = pool.acquire(200000, 1, &calls);
+        ASSERT_NE(c.ptr, nullptr);
+        EXPECT_EQ(calls, size_t(3));
+        auto stats = pool.get_stats();
+        EXPECT_EQ(stats.device_frees, size_t(1));
+        EXPECT_EQ(stats.bytes_cached, size_t(0));
+
+        // Does not fit at all
+        auto d = pool.acquire(size_t(1) << 30, 1);
+        EXPECT_EQ(d.ptr, nullptr);
+        stats = pool.get_stats();
+        EXPECT_EQ(stats.failures, size_t(1));
+        EXPECT_EQ(stats.bytes_in_use, b.size + c.size);
+
+        pool.release(b, 1);
+        pool.release(c, 1);
+        pool.trim();
+        EXPECT_EQ(backend.state->allocated, size_t(0));
+    }
+
+    void testing_threads()
+    {
+        host_pool         pool;
+        std::atomic<bool> overlap{false};
+        auto              worker = [&](int id) {
+            for(int i = 0; i < 2000; ++i)
+            {
+                size_t size  = 4096 + (id * 7919 + i * 104729) % 300000;
+                auto   block = pool.acquire(size, id + 1);
+                if(!block.ptr)
+                    continue;
+                memset(block.ptr, id, size);
+                for(size_t j = 0; j < size; j += 509)
+                    if(static_cast<unsigned char*>(block.ptr)[j] != id)
+                        overlap = true;
+                pool.release(block, id + 1);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for(int id = 0; id < 8; ++id)
+            threads.emplace_back(worker, id);
+        for(auto& t : threads)
+            t.join();
+
+        EXPECT_FALSE(overlap);
+        auto stats = pool.get_stats();
+        EXPECT_EQ(stats.allocations, size_t(8 * 2000));
+        EXPECT_EQ(stats.bytes_in_use, size_t(0));
+        EXPECT_EQ(stats.bytes_requested, size_t(0));
+        EXPECT_EQ(stats.reuses + stats.device_allocations, stats.allocations);
+        EXPECT_LE(stats.high_water_in_use, stats.high_water_reserved);
+    }
+
+    void testing_device_memory_pool_api()
+    {
+        rocblas_local_handle             handle;
+        rocblas_device_memory_pool_stats stats;
+
+        CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_pool_stats(handle, &stats));
+        EXPECT_LE(stats.high_water_in_use, stats.high_water_reserved);
+        CHECK_ROCBLAS_ERROR(rocblas_reset_device_memory_pool_stats(handle));
+        CHECK_ROCBLAS_ERROR(rocblas_trim_device_memory_pool(handle));
+
+        EXPECT_ROCBLAS_STATUS(rocblas_get_device_memory_pool_stats(nullptr, &stats),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_device_memory_pool_stats(handle, nullptr),
+                              rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(rocblas_reset_device_memory_pool_stats(nullptr),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_trim_device_memory_pool(nullptr),
+                              rocblas_status_invalid_handle);
+    }
+
+    template <typename...>
+    struct testing_device_memory_pool : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            testing_size_classes();
+            testing_reuse_and_stats();
+            testing_allocation_failure();
+            testing_threads();
+            testing_device_memory_pool_api();
+        }
+    };
+
+    struct device_memory_pool : RocBLAS_Test<device_memory_pool, testing_device_memory_pool>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "device_memory_pool");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<device_memory_pool>(arg.name);
+        }
+    };
+
+    TEST_P(device_memory_pool, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_device_memory_pool<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(device_memory_pool)
+
+} // namespace
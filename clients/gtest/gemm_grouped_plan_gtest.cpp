@@ -0,0 +1,239 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_gemm_grouped_plan.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    rocblas_gemm_group make_group(rocblas_int m,
+                                  rocblas_int n,
+                                  rocblas_int k,
+                                  rocblas_int group_size,
+                                  float       alpha = 1,
+                                  float       beta  = 0)
+    {
+        rocblas_gemm_group group = {};
+        group.trans_a            = rocblas_operation_none;
+        group.trans_b            = rocblas_operation_transpose;
+        group.m                  = m;
+        group.n                  = n;
+        group.k                  = k;
+        group.lda                = m;
+        group.ldb                = n;
+        group.ldc                = m;
+        group.ldd                = m;
+        group.group_size         = group_size;
+        group.alpha.s            = alpha;
+        group.beta.s             = beta;
+        return group;
+    }
+
+    // Run the plan on the host: gather problem indices like the pointer arrays, and
+    // record the group whose shape each problem is solved with, or -1 if it is not.
+    std::vector<int> execute(const std::vector<rocblas_gemm_group>& groups,
+                             const rocblas_gemm_grouped_plan&       plan)
+    {
+        std::vector<size_t> gathered(plan.gathered(), SIZE_MAX);
+        for(const auto& copy : plan.copies())
+            for(size_t i = 0; i < copy.count; ++i)
+            {
+                EXPECT_EQ(gathered[copy.dst + i], SIZE_MAX);
+                gathered[copy.dst + i] = copy.src + i;
+            }
+
+        std::vector<int> solved(plan.problems(), -1);
+        for(const auto& launch : plan.launches())
+            for(rocblas_int i = 0; i < launch.batch_count; ++i)
+            {
+                size_t p = launch.gathered ? gathered.at(launch.offset + i) : launch.offset + i;
+                EXPECT_EQ(solved.at(p), -1);
+                solved.at(p) = int(launch.group);
+            }
+        return solved;
+    }
+
+    // Every problem of a non-empty group is solved once, with an identical group
+    void check_plan(const std::vector<rocblas_gemm_group>& groups,
+                    const rocblas_gemm_grouped_plan&       plan)
+    {
+        auto solved = execute(groups, plan);
+        for(size_t g = 0, p = 0; g < groups.size(); ++g)
+        {
+            bool empty = !groups[g].m || !groups[g].n;
+            for(rocblas_int i = 0; i < groups[g].group_size; ++i, ++p)
+            {
+                if(empty)
+                {
+                    EXPECT_EQ(solved[p], -1);
+                    continue;
+                }
+                ASSERT_NE(solved[p], -1);
+                const auto& s = groups[solved[p]];
+                EXPECT_EQ(s.m, groups[g].m);
+                EXPECT_EQ(s.n, groups[g].n);
+                EXPECT_EQ(s.k, groups[g].k);
+                EXPECT_EQ(s.lda, groups[g].lda);
+                EXPECT_EQ(s.beta.s, groups[g].beta.s);
+                if(groups[g].k)
+                {
+                    EXPECT_EQ(s.alpha.s, groups[g].alpha.s);
+                }
+            }
+        }
+    }
+
+    void testing_adjacent_groups()
+    {
+        // Adjacent groups of one shape are one launch on the user's arrays
+        std::vector<rocblas_gemm_group> groups
+            = {make_group(8, 8, 8, 3), make_group(8, 8, 8, 2), make_group(16, 8, 8, 1)};
+        rocblas_gemm_grouped_plan plan(groups.data(), groups.size(), sizeof(float));
+        ASSERT_EQ(plan.launches().size(), size_t(2));
+        EXPECT_EQ(plan.launches()[0].batch_count, 5);
+        EXPECT_EQ(plan.launches()[1].offset, size_t(5));
+        EXPECT_FALSE(plan.launches()[1].gathered);
+        EXPECT_TRUE(plan.copies().empty());
+        EXPECT_EQ(plan.problems(), size_t(6));
+        check_plan(groups, plan);
+    }
+
+    void testing_scattered_groups()
+    {
+        // Shapes alternating over many groups are gathered into one launch per shape
+        std::vector<rocblas_gemm_group> groups;
+        for(int g = 0; g < 12; ++g)
+            groups.push_back(make_group(8 + g % 3, 8, 4, g % 2 + 1));
+        rocblas_gemm_grouped_plan plan(groups.data(), groups.size(), sizeof(float));
+        EXPECT_EQ(plan.launches().size(), size_t(3));
+        EXPECT_EQ(plan.copies().size(), size_t(12));
+        EXPECT_EQ(plan.gather_launches(), size_t(1));
+        EXPECT_EQ(plan.gathered(), plan.problems());
+        for(const auto& launch : plan.launches())
+            EXPECT_TRUE(launch.gathered);
+        check_plan(groups, plan);
+
+        // Gathering 2 buckets of 2 segments saves 2 launches for 1
+        groups = {make_group(8, 8, 8, 1),
+                  make_group(9, 8, 8, 1),
+                  make_group(8, 8, 8, 1),
+                  make_group(9, 8, 8, 1)};
+        rocblas_gemm_grouped_plan plan2(groups.data(), groups.size(), sizeof(float));
+        EXPECT_EQ(plan2.launches().size(), size_t(2));
+        EXPECT_EQ(plan2.gather_launches(), size_t(1));
+        check_plan(groups, plan2);
+
+        // Gathering 1 bucket of 2 segments saves no launches, so it is not done
+        groups.pop_back();
+        rocblas_gemm_grouped_plan plan3(groups.data(), groups.size(), sizeof(float));
+        EXPECT_EQ(plan3.launches().size(), size_t(3));
+        EXPECT_TRUE(plan3.copies().empty());
+        check_plan(groups, plan3);
+
+        // More segments than a gather launch copies
+        groups.clear();
+        for(int g = 0; g < 200; ++g)
+            groups.push_back(make_group(4 + g % 2, 4, 4, 1));
+        rocblas_gemm_grouped_plan plan4(groups.data(), groups.size(), sizeof(float));
+        EXPECT_EQ(plan4.launches().size(), size_t(2));
+        EXPECT_EQ(plan4.gather_launches(), size_t(4));
+        check_plan(groups, plan4);
+    }
+
+    void testing_keys()
+    {
+        // Leading dimensions, transposes and scalars separate groups
+        std::vector<rocblas_gemm_group> groups(6, make_group(8, 8, 8, 1));
+        groups[1].lda     = 9;
+        groups[2].trans_a = rocblas_operation_transpose;
+        groups[3].alpha.s = 2;
+        groups[4].beta.s  = 1;
+        rocblas_gemm_grouped_plan plan(groups.data(), groups.size(), sizeof(float));
+        EXPECT_EQ(plan.launches().size(), size_t(6));
+        check_plan(groups, plan);
+
+        // alpha does not separate groups with k == 0
+        groups = {make_group(8, 8, 0, 1, 1), make_group(8, 8, 0, 1, 2)};
+        rocblas_gemm_grouped_plan plan2(groups.data(), groups.size(), sizeof(float));
+        EXPECT_EQ(plan2.launches().size(), size_t(1));
+        check_plan(groups, plan2);
+
+        // Only the bytes of the compute type are compared
+        groups = {make_group(8, 8, 8, 1), make_group(8, 8, 8, 1)};
+        groups[1].alpha.d = 0;
+        groups[1].alpha.h = groups[0].alpha.h;
+        rocblas_gemm_grouped_plan plan3(groups.data(), groups.size(), sizeof(rocblas_half));
+        EXPECT_EQ(plan3.launches().size(), size_t(1));
+    }
+
+    void testing_empty_and_split()
+    {
+        // Empty groups are skipped, but their problems keep their places
+        std::vector<rocblas_gemm_group> groups = {make_group(0, 8, 8, 4),
+                                                  make_group(8, 8, 8, 2),
+                                                  make_group(8, 0, 8, 1),
+                                                  make_group(8, 8, 8, 0),
+                                                  make_group(8, 8, 8, 3)};
+        rocblas_gemm_grouped_plan       plan(groups.data(), groups.size(), sizeof(float));
+        EXPECT_EQ(plan.problems(), size_t(10));
+        EXPECT_EQ(plan.launches().size(), size_t(2));
+        check_plan(groups, plan);
+
+        rocblas_gemm_grouped_plan none(nullptr, 0, sizeof(float));
+        EXPECT_TRUE(none.launches().empty());
+        EXPECT_EQ(none.problems(), size_t(0));
+
+        // Launches have at most max_batch problems
+        groups = {make_group(8, 8, 8, 7), make_group(4, 4, 4, 1), make_group(8, 8, 8, 4)};
+        rocblas_gemm_grouped_plan split(groups.data(), groups.size(), sizeof(float), 3);
+        for(const auto& launch : split.launches())
+            EXPECT_LE(launch.batch_count, 3);
+        EXPECT_EQ(split.launches().size(), size_t(6));
+        check_plan(groups, split);
+    }
+
+    template <typename...>
+    struct testing_gemm_grouped_plan : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            testing_adjacent_groups();
+            testing_scattered_groups();
+            testing_keys();
+            testing_empty_and_split();
+        }
+    };
+
+    struct gemm_grouped_plan : RocBLAS_Test<gemm_grouped_plan, testing_gemm_grouped_plan>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "gemm_grouped_plan");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<gemm_grouped_plan>(arg.name);
+        }
+    };
+
+    TEST_P(gemm_grouped_plan, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_gemm_grouped_plan<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(gemm_grouped_plan)
+
+} // namespace
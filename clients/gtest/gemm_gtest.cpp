@@ -8,7 +8,9 @@
 #include "testing_gemm_batched.hpp"
 #include "testing_gemm_batched_ex.hpp"
 #include "testing_gemm_ex.hpp"
+#include "testing_gemm_ex_epilogue.hpp"
 #include "testing_gemm_ext2.hpp"
+#include "testing_gemm_grouped_batched_ex.hpp"
 #include "testing_gemm_strided_batched.hpp"
 #include "testing_gemm_strided_batched_ex.hpp"
 #include "type_dispatch.hpp"
@@ -28,6 +30,8 @@ namespace
         GEMM_STRIDED_BATCHED,
         GEMM_STRIDED_BATCHED_EX,
         GEMM_EXT2,
+        GEMM_GROUPED_BATCHED_EX,
+        GEMM_EX_EPILOGUE,
     };
 
     // ----------------------------------------------------------------------------
@@ -84,6 +88,15 @@ namespace
             case GEMM_EXT2:
                 return !strcmp(arg.function, "gemm_ext2")
                        || !strcmp(arg.function, "gemm_ext2_bad_arg");
+
+            case GEMM_GROUPED_BATCHED_EX:
+                return !strcmp(arg.function, "gemm_grouped_batched_ex")
+                       || !strcmp(arg.function, "gemm_grouped_batched_ex_bad_arg");
+
+            case GEMM_EX_EPILOGUE:
+                return !strcmp(arg.function, "gemm_ex_epilogue")
+                       || !strcmp(arg.function, "gemm_strided_batched_ex_epilogue")
+                       || !strcmp(arg.function, "gemm_ex_epilogue_bad_arg");
             }
 
             return false;
@@ -95,10 +108,13 @@ namespace
             RocBLAS_TestName<gemm_test_template> name(arg.name);
             name << rocblas_datatype2string(arg.a_type);
             constexpr bool isEx = GEMM_TYPE == GEMM_EX || GEMM_TYPE == GEMM_BATCHED_EX
-                                  || GEMM_TYPE == GEMM_STRIDED_BATCHED_EX || GEMM_TYPE == GEMM_EXT2;
+                                  || GEMM_TYPE == GEMM_STRIDED_BATCHED_EX || GEMM_TYPE == GEMM_EXT2
+                                  || GEMM_TYPE == GEMM_GROUPED_BATCHED_EX
+                                  || GEMM_TYPE == GEMM_EX_EPILOGUE;
             constexpr bool isBatched
                 = (GEMM_TYPE == GEMM_STRIDED_BATCHED || GEMM_TYPE == GEMM_STRIDED_BATCHED_EX
-                   || GEMM_TYPE == GEMM_BATCHED || GEMM_TYPE == GEMM_BATCHED_EX);
+                   || GEMM_TYPE == GEMM_BATCHED || GEMM_TYPE == GEMM_BATCHED_EX
+                   || GEMM_TYPE == GEMM_GROUPED_BATCHED_EX || GEMM_TYPE == GEMM_EX_EPILOGUE);
 
             if(isEx)
                 name << rocblas_datatype2string(arg.b_type) << rocblas_datatype2string(arg.c_type)
@@ -232,6 +248,15 @@ namespace
                 testing_gemm_ext2<Ti, To, Tc>(arg);
             else if(!strcmp(arg.function, "gemm_ext2_bad_arg"))
                 testing_gemm_ext2<Ti, To, Tc>(arg);
+            else if(!strcmp(arg.function, "gemm_grouped_batched_ex"))
+                testing_gemm_grouped_batched_ex<Ti, To, Tc>(arg);
+            else if(!strcmp(arg.function, "gemm_grouped_batched_ex_bad_arg"))
+                testing_gemm_grouped_batched_ex_bad_arg<Ti, To, Tc>(arg);
+            else if(!strcmp(arg.function, "gemm_ex_epilogue")
+                    || !strcmp(arg.function, "gemm_strided_batched_ex_epilogue"))
+                testing_gemm_ex_epilogue<Ti, To, Tc>(arg);
+            else if(!strcmp(arg.function, "gemm_ex_epilogue_bad_arg"))
+                testing_gemm_ex_epilogue_bad_arg<Ti, To, Tc>(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -268,4 +293,20 @@ namespace
     }
     INSTANTIATE_TEST_CATEGORIES(gemm_ext2);
 
+    using gemm_grouped_batched_ex = gemm_test_template<gemm_ex_testing, GEMM_GROUPED_BATCHED_EX>;
+    TEST_P(gemm_grouped_batched_ex, blas3_tensile)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(
+            rocblas_gemm_dispatch<gemm_ex_testing>(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(gemm_grouped_batched_ex);
+
+    using gemm_ex_epilogue = gemm_test_template<gemm_ex_testing, GEMM_EX_EPILOGUE>;
+    TEST_P(gemm_ex_epilogue, blas3_tensile)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(
+            rocblas_gemm_dispatch<gemm_ex_testing>(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(gemm_ex_epilogue);
+
 } // namespace
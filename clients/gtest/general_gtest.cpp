@@ -762,4 +762,211 @@ namespace
     }
     INSTANTIATE_TEST_CATEGORIES(check_numerics_matrix);
 
+    //Testing the sampling and reporting of deferred checks on the host
+    void testing_check_numerics_deferred_state()
+    {
+        static const char f[] = "f", g[] = "g";
+
+        rocblas_check_numerics_deferred state;
+        state.set_interval(3);
+
+        // Calls of f with an input and an output, then calls of g with an output only
+        std::vector<uint32_t> seqs;
+        for(int i = 0; i < 4; i++)
+        {
+            seqs.push_back(state.begin(f, true));
+            seqs.push_back(state.begin(f, false));
+            seqs.push_back(state.begin(g, false));
+        }
+
+        // Of the 8 calls, calls 0 and 6 (f) and call 3 (g) are checked
+        EXPECT_EQ(seqs, (std::vector<uint32_t>{1, 2, 0, 0, 0, 3, 0, 0, 0, 4, 5, 0}));
+
+        // The device found an Inf in check 2, and the host a NaN in check 3
+        state.record_host(3, true, false, false);
+        rocblas_check_numerics_report report;
+        state.report(false, true, true, UINT32_MAX - 2, report);
+        EXPECT_EQ(report.checked_calls, 3u);
+        EXPECT_EQ(report.skipped_calls, 5u);
+        EXPECT_EQ(report.checked_operands, 5u);
+        EXPECT_TRUE(report.has_NaN);
+        EXPECT_TRUE(report.has_zero);
+        EXPECT_TRUE(report.has_Inf);
+        EXPECT_EQ(report.first_abnormal_function, f);
+        EXPECT_FALSE(report.first_abnormal_is_input);
+
+        // Names older than HISTORY checks are forgotten
+        state.reset();
+        state.set_interval(1);
+        for(uint32_t i = 0; i < rocblas_check_numerics_deferred::HISTORY + 1; i++)
+            state.begin(i % 2 ? f : g, true);
+        state.report(true, false, false, UINT32_MAX - 1, report);
+        EXPECT_TRUE(report.has_NaN);
+        EXPECT_EQ(report.first_abnormal_function, nullptr);
+        state.report(true, false, false, UINT32_MAX - 2, report);
+        EXPECT_EQ(report.first_abnormal_function, f);
+    }
+
+    //Testing deferred checks of a vector through a handle
+    template <typename T>
+    void testing_check_numerics_deferred(const Arguments& arg)
+    {
+        rocblas_int N     = arg.N;
+        rocblas_int inc_x = arg.incx;
+
+        testing_check_numerics_deferred_state();
+
+        //Argument sanity check before allocating invalid memory
+        if(N <= 0 || inc_x <= 0)
+        {
+            return;
+        }
+
+        const int check_numerics
+            = rocblas_check_numerics_mode_deferred | rocblas_check_numerics_mode_fail;
+
+        //The handle reads its check_numerics mode, which the report uses, when it is created
+        const char* saved_env = getenv("ROCBLAS_CHECK_NUMERICS");
+        std::string saved     = saved_env ? saved_env : "";
+        std::string mode      = std::to_string(check_numerics);
+        ASSERT_EQ(setenv("ROCBLAS_CHECK_NUMERICS", mode.c_str(), true), 0);
+        rocblas_local_handle handle;
+        if(saved_env)
+            setenv("ROCBLAS_CHECK_NUMERICS", saved.c_str(), true);
+        else
+            unsetenv("ROCBLAS_CHECK_NUMERICS");
+        static const char clean[] = "clean", abnormal[] = "abnormal";
+
+        size_t         size_x = N * size_t(inc_x);
+        host_vector<T> h_x(size_x);
+        rocblas_seedrand();
+        rocblas_init<T>(h_x, 1, N, inc_x);
+        device_vector<T> d_x(size_x);
+        CHECK_HIP_ERROR(hipMemcpy(d_x, h_x, sizeof(T) * size_x, hipMemcpyHostToDevice));
+
+        auto check = [&](const char* function_name, bool is_input) {
+            return rocblas_internal_check_numerics_vector_template(
+                function_name, handle, N, (const T*)d_x, 0, inc_x, 0, 1, check_numerics, is_input);
+        };
+
+        //Checks of a vector without NaN/Inf
+        for(int i = 0; i < 3; i++)
+        {
+            EXPECT_ROCBLAS_STATUS(check(clean, true), rocblas_status_success);
+            EXPECT_ROCBLAS_STATUS(check(clean, false), rocblas_status_success);
+        }
+        //Reading the report waits for the stream and copies the results, as sync points
+        rocblas_check_numerics_report report;
+        rocblas_sync_point_counts     counts;
+        CHECK_ROCBLAS_ERROR(rocblas_reset_sync_point_counts(handle));
+        EXPECT_ROCBLAS_STATUS(rocblas_get_check_numerics_report(handle, &report),
+                              rocblas_status_success);
+        CHECK_ROCBLAS_ERROR(rocblas_get_sync_point_counts(handle, &counts));
+        EXPECT_EQ(counts.stream_syncs, size_t(1));
+        EXPECT_EQ(counts.copies, size_t(1));
+        EXPECT_EQ(report.checked_calls, 3u);
+        EXPECT_EQ(report.skipped_calls, 0u);
+        EXPECT_EQ(report.checked_operands, 6u);
+        EXPECT_FALSE(report.has_NaN);
+        EXPECT_FALSE(report.has_Inf);
+        EXPECT_EQ(report.first_abnormal_function, nullptr);
+
+        //A NaN does not fail the call, but fails the report which names the first function
+        rocblas_init_nan<T>((T*)h_x, 0, 1);
+        CHECK_HIP_ERROR(hipMemcpy(d_x, h_x, sizeof(T) * size_x, hipMemcpyHostToDevice));
+        EXPECT_ROCBLAS_STATUS(check(abnormal, false), rocblas_status_success);
+        EXPECT_ROCBLAS_STATUS(check(clean, true), rocblas_status_success);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_check_numerics_report(handle, &report),
+                              rocblas_status_check_numerics_fail);
+        EXPECT_TRUE(report.has_NaN);
+        EXPECT_EQ(report.checked_operands, 8u);
+        EXPECT_EQ(report.first_abnormal_function, abnormal);
+        EXPECT_FALSE(report.first_abnormal_is_input);
+
+        //Resetting clears the results
+        CHECK_ROCBLAS_ERROR(rocblas_reset_check_numerics_report(handle));
+        EXPECT_ROCBLAS_STATUS(rocblas_get_check_numerics_report(handle, &report),
+                              rocblas_status_success);
+        EXPECT_FALSE(report.has_NaN);
+        EXPECT_EQ(report.checked_operands, 0u);
+
+        //Sampling one call in four checks both operands of calls 0 and 4
+        CHECK_ROCBLAS_ERROR(rocblas_set_check_numerics_sampling(handle, 4));
+        for(int i = 0; i < 8; i++)
+        {
+            EXPECT_ROCBLAS_STATUS(check(abnormal, true), rocblas_status_success);
+            EXPECT_ROCBLAS_STATUS(check(abnormal, false), rocblas_status_success);
+        }
+        EXPECT_ROCBLAS_STATUS(rocblas_get_check_numerics_report(handle, &report),
+                              rocblas_status_check_numerics_fail);
+        EXPECT_EQ(report.checked_calls, 2u);
+        EXPECT_EQ(report.skipped_calls, 6u);
+        EXPECT_EQ(report.checked_operands, 4u);
+        EXPECT_TRUE(report.first_abnormal_is_input);
+
+        EXPECT_ROCBLAS_STATUS(rocblas_set_check_numerics_sampling(handle, 0),
+                              rocblas_status_invalid_size);
+        EXPECT_ROCBLAS_STATUS(rocblas_set_check_numerics_sampling(nullptr, 1),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_check_numerics_report(handle, nullptr),
+                              rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_check_numerics_report(nullptr, &report),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_reset_check_numerics_report(nullptr),
+                              rocblas_status_invalid_handle);
+    }
+
+    // By default, arbitrary type combinations are invalid.
+    // The unnamed second parameter is used for enable_if_t below.
+    template <typename, typename = void>
+    struct check_numerics_deferred_testing : rocblas_test_invalid
+    {
+    };
+
+    template <typename T>
+    struct check_numerics_deferred_testing<
+        T,
+        std::enable_if_t<std::is_same<T, float>{} || std::is_same<T, double>{}>>
+        : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            if(!strcmp(arg.function, "check_numerics_deferred"))
+                testing_check_numerics_deferred<T>(arg);
+            else
+                FAIL() << "Internal error: Test called with unknown function: " << arg.function;
+        }
+    };
+
+    struct check_numerics_deferred
+        : RocBLAS_Test<check_numerics_deferred, check_numerics_deferred_testing>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments& arg)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "check_numerics_deferred");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            RocBLAS_TestName<check_numerics_deferred> name(arg.name);
+            name << rocblas_datatype2string(arg.a_type) << '_' << arg.N << '_' << arg.incx;
+            return std::move(name);
+        }
+    };
+
+    TEST_P(check_numerics_deferred, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(
+            rocblas_simple_dispatch<check_numerics_deferred_testing>(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(check_numerics_deferred);
+
 } // namespace
@@ -0,0 +1,133 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "rocblas_data.hpp"
+#include "rocblas_parse_data.hpp"
+#include "rocblas_test.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifndef WIN32
+    void write_file(const std::string& path, const std::string& contents)
+    {
+        std::ofstream(path, std::ofstream::trunc) << contents;
+    }
+
+    void testing_gentest_cache_key()
+    {
+        char tmp[] = "/tmp/rocblas-gentest-XXXXXX";
+        ASSERT_NE(mkdtemp(tmp), nullptr);
+        std::string dir      = tmp;
+        std::string yaml     = dir + "/tests.yaml";
+        std::string included = dir + "/included.yaml";
+        std::string templ    = dir + "/template.yaml";
+        std::string common   = dir + "/common.yaml";
+        std::string script   = dir + "/gentest.py";
+
+        write_file(yaml, "---\ninclude: included.yaml\nTests:\n- name: a\n...\n");
+        write_file(included, "Definitions:\n  - &sizes [1, 2]\n");
+        write_file(templ, "include : common.yaml\n");
+        write_file(common, "Datatypes:\n");
+        write_file(script, "print('gentest')\n");
+
+        auto key = rocblas_gentest_cache_key(yaml, templ, script);
+        EXPECT_EQ(key.size(), size_t(32));
+        EXPECT_EQ(rocblas_gentest_cache_key(yaml, templ, script), key);
+
+        // A change to any input, including an included file, changes the key
+        write_file(included, "Definitions:\n  - &sizes [1, 3]\n");
+        auto changed = rocblas_gentest_cache_key(yaml, templ, script);
+        EXPECT_NE(changed, key);
+        write_file(included, "Definitions:\n  - &sizes [1, 2]\n");
+        EXPECT_EQ(rocblas_gentest_cache_key(yaml, templ, script), key);
+
+        write_file(common, "Datatypes:\n  - foo\n");
+        EXPECT_NE(rocblas_gentest_cache_key(yaml, templ, script), key);
+        write_file(common, "Datatypes:\n");
+
+        write_file(script, "print('gentest 2')\n");
+        EXPECT_NE(rocblas_gentest_cache_key(yaml, templ, script), key);
+        write_file(script, "print('gentest')\n");
+        EXPECT_EQ(rocblas_gentest_cache_key(yaml, templ, script), key);
+
+        // Inputs which cannot be read are not cached
+        EXPECT_EQ(rocblas_gentest_cache_key(dir + "/missing.yaml", templ, script), "");
+        EXPECT_EQ(rocblas_gentest_cache_key(yaml, templ, dir + "/missing.py"), "");
+        EXPECT_EQ(rocblas_gentest_cache_key(dir, templ, script), "");
+        write_file(yaml, "---\ninclude: missing.yaml\n...\n");
+        EXPECT_EQ(rocblas_gentest_cache_key(yaml, templ, script), "");
+
+        for(auto& file : {yaml, included, templ, common, script})
+            remove(file.c_str());
+        rmdir(tmp);
+    }
+#endif
+
+    // The records read in place match the filters used to instantiate the tests
+    void testing_test_data(const Arguments& arg)
+    {
+        size_t count = 0, named = 0;
+        for(auto it = RocBLAS_TestData::begin(); it != RocBLAS_TestData::end(); ++it, ++count)
+            named += !strcmp(it->function, arg.function);
+        EXPECT_GT(count, size_t(0));
+        EXPECT_GT(named, size_t(0));
+
+        size_t filtered = 0;
+        auto   filter   = [](const Arguments& a) { return !strcmp(a.function, "gentest_cache"); };
+        for(auto it = RocBLAS_TestData::begin(filter); it != RocBLAS_TestData::end(); ++it)
+        {
+            EXPECT_STREQ(it->function, "gentest_cache");
+            ++filtered;
+        }
+        EXPECT_EQ(filtered, named);
+    }
+
+    template <typename...>
+    struct testing_gentest_cache : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+#ifndef WIN32
+            testing_gentest_cache_key();
+#endif
+            testing_test_data(arg);
+        }
+    };
+
+    struct gentest_cache : RocBLAS_Test<gentest_cache, testing_gentest_cache>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "gentest_cache");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<gentest_cache>(arg.name);
+        }
+    };
+
+    TEST_P(gentest_cache, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_gentest_cache<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(gentest_cache)
+
+} // namespace
@@ -0,0 +1,158 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_host_pack.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_test.hpp"
+#include <atomic>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Fill a buffer with a byte pattern which differs between elements
+    std::vector<unsigned char> pattern(size_t bytes, unsigned char seed)
+    {
+        std::vector<unsigned char> v(bytes);
+        for(size_t i = 0; i < bytes; ++i)
+            v[i] = (unsigned char)(i * 131 + seed);
+        return v;
+    }
+
+    void testing_strided_copy(const rocblas_host_pack_config& config)
+    {
+        for(size_t elem_size : {1, 2, 3, 4, 8, 12, 16})
+            for(ptrdiff_t inc : {1, 2, 3, 7})
+                for(size_t n : {0, 1, 3, 4, 5, 17, 1000, 70001})
+                {
+                    size_t strided_bytes = (n ? (n - 1) * inc + 1 : 0) * elem_size;
+                    size_t packed_bytes  = n * elem_size;
+                    auto   strided       = pattern(strided_bytes, 1);
+                    auto   packed        = pattern(packed_bytes, 2);
+
+                    // Gather into the packed buffer
+                    auto expected = packed;
+                    for(size_t i = 0; i < n; ++i)
+                        memcpy(&expected[i * elem_size], &strided[i * inc * elem_size], elem_size);
+                    rocblas_host_strided_copy(
+                        packed.data(), 1, strided.data(), inc, n, elem_size, config);
+                    EXPECT_EQ(packed, expected) << "gather elem_size " << elem_size << " inc "
+                                                << inc << " n " << n;
+
+                    // Scatter a different packed buffer back, leaving the gaps alone
+                    packed   = pattern(packed_bytes, 3);
+                    expected = strided;
+                    for(size_t i = 0; i < n; ++i)
+                        memcpy(&expected[i * inc * elem_size], &packed[i * elem_size], elem_size);
+                    rocblas_host_strided_copy(
+                        strided.data(), inc, packed.data(), 1, n, elem_size, config);
+                    EXPECT_EQ(strided, expected) << "scatter elem_size " << elem_size << " inc "
+                                                 << inc << " n " << n;
+                }
+    }
+
+    void testing_copy_columns(const rocblas_host_pack_config& config)
+    {
+        for(size_t col_bytes : {1, 24, 4096})
+            for(size_t ld_pad : {0, 5})
+                for(size_t cols : {0, 1, 9, 300})
+                {
+                    size_t ld       = col_bytes + ld_pad;
+                    auto   matrix   = pattern(ld * cols, 4);
+                    auto   packed   = pattern(col_bytes * cols, 5);
+                    auto   expected = packed;
+                    for(size_t j = 0; j < cols; ++j)
+                        memcpy(&expected[j * col_bytes], &matrix[j * ld], col_bytes);
+                    rocblas_host_copy_columns(
+                        packed.data(), col_bytes, matrix.data(), ld, col_bytes, cols, config);
+                    EXPECT_EQ(packed, expected);
+
+                    packed   = pattern(col_bytes * cols, 6);
+                    expected = matrix;
+                    for(size_t j = 0; j < cols; ++j)
+                        memcpy(&expected[j * ld], &packed[j * col_bytes], col_bytes);
+                    rocblas_host_copy_columns(
+                        matrix.data(), ld, packed.data(), col_bytes, col_bytes, cols, config);
+                    EXPECT_EQ(matrix, expected);
+                }
+    }
+
+    void testing_thread_pool()
+    {
+        rocblas_host_thread_pool pool(3);
+        EXPECT_EQ(pool.concurrency(), size_t(4));
+
+        // Every iteration runs exactly once, across repeated loops
+        for(size_t count : {0, 1, 2, 5, 1000})
+            for(int rep = 0; rep < 3; ++rep)
+            {
+                std::vector<std::atomic<int>> hits(count);
+                pool.parallel_for(count, [&](size_t i) { ++hits[i]; });
+                for(size_t i = 0; i < count; ++i)
+                    EXPECT_EQ(hits[i], 1);
+            }
+
+        // Loops from several threads at once share the pool or run serially
+        std::vector<std::thread> threads;
+        std::atomic<size_t>      total{0};
+        for(int t = 0; t < 4; ++t)
+            threads.emplace_back([&] {
+                for(int rep = 0; rep < 100; ++rep)
+                    pool.parallel_for(64, [&](size_t i) { total += i; });
+            });
+        for(auto& t : threads)
+            t.join();
+        EXPECT_EQ(total, size_t(4 * 100 * (63 * 64 / 2)));
+    }
+
+    template <typename...>
+    struct testing_host_pack : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            rocblas_host_thread_pool pool(3);
+            rocblas_host_pack_config serial, parallel;
+            serial.pool             = nullptr;
+            parallel.pool           = &pool;
+            parallel.parallel_bytes = 1024; // Small, so that the test copies are split
+
+            testing_strided_copy(serial);
+            testing_strided_copy(parallel);
+            testing_copy_columns(serial);
+            testing_copy_columns(parallel);
+            testing_thread_pool();
+        }
+    };
+
+    struct host_pack : RocBLAS_Test<host_pack, testing_host_pack>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "host_pack");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<host_pack>(arg.name);
+        }
+    };
+
+    TEST_P(host_pack, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_host_pack<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(host_pack)
+
+} // namespace
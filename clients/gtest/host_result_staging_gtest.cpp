@@ -0,0 +1,330 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_host_result_staging.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Host memory backend, where streams are integers and the work queued on a
+    // stream runs when it is synchronized. Copies share their state.
+    struct host_result_backend
+    {
+        using stream_t = int;
+
+        struct state_t
+        {
+            std::map<int, std::deque<std::function<void()>>> queues;
+            size_t                                           allocated    = 0;
+            size_t                                           allocations  = 0;
+            size_t                                           syncs        = 0;
+            size_t                                           limit        = SIZE_MAX;
+            bool                                             fail_enqueue = false;
+        };
+        std::shared_ptr<state_t> state = std::make_shared<state_t>();
+
+        void* allocate(size_t size)
+        {
+            if(state->allocated + size > state->limit)
+                return nullptr;
+            void* ptr = malloc(size + sizeof(size_t));
+            if(!ptr)
+                return nullptr;
+            *static_cast<size_t*>(ptr) = size;
+            state->allocated += size;
+            ++state->allocations;
+            return static_cast<size_t*>(ptr) + 1;
+        }
+
+        void deallocate(void* ptr)
+        {
+            size_t* p = static_cast<size_t*>(ptr) - 1;
+            state->allocated -= *p;
+            free(p);
+        }
+
+        rocblas_status copy_async(void* dst, const void* src, size_t size, int stream)
+        {
+            state->queues[stream].push_back([=] { memcpy(dst, src, size); });
+            return rocblas_status_success;
+        }
+
+        rocblas_status synchronize(int stream)
+        {
+            ++state->syncs;
+            auto& queue = state->queues[stream];
+            while(!queue.empty())
+            {
+                auto work = std::move(queue.front());
+                queue.pop_front();
+                work();
+            }
+            return rocblas_status_success;
+        }
+
+        rocblas_status enqueue(int stream, rocblas_host_result_slot* slot)
+        {
+            if(state->fail_enqueue)
+                return rocblas_status_internal_error;
+            state->queues[stream].push_back([=] { rocblas_host_result_slot::complete(slot); });
+            return rocblas_status_success;
+        }
+    };
+
+    using host_staging = rocblas_host_result_staging<host_result_backend>;
+
+    void testing_blocking_copy()
+    {
+        host_result_backend backend;
+        host_staging        staging(backend);
+
+        float src[3] = {1, 2, 3}, dst[3] = {};
+        EXPECT_EQ(staging.copy(dst, src, sizeof(src), 1, false), rocblas_status_success);
+        EXPECT_EQ(dst[2], 3.0f);
+        EXPECT_EQ(staging.pending(), size_t(0));
+        EXPECT_EQ(staging.slots(), size_t(1));
+        EXPECT_EQ(staging.bytes(), host_staging::MIN_SLOT_SIZE);
+
+        // The slot is reused, and replaced when it is too small
+        EXPECT_EQ(staging.copy(dst, src, sizeof(float), 1, false), rocblas_status_success);
+        EXPECT_EQ(backend.state->allocations, size_t(1));
+        std::vector<double> big_src(1000, 2.5), big_dst(1000);
+        EXPECT_EQ(staging.copy(big_dst.data(), big_src.data(), 8000, 1, false),
+                  rocblas_status_success);
+        EXPECT_EQ(big_dst[999], 2.5);
+        EXPECT_EQ(staging.slots(), size_t(1));
+        EXPECT_EQ(staging.bytes(), size_t(8192));
+        EXPECT_EQ(backend.state->allocated, size_t(8192));
+
+        // An empty copy does nothing
+        EXPECT_EQ(staging.copy(dst, src, 0, 1, false), rocblas_status_success);
+        EXPECT_EQ(backend.state->allocations, size_t(2));
+    }
+
+    void testing_deferred_copy()
+    {
+        host_result_backend backend;
+        {
+            host_staging staging(backend);
+
+            int src1 = 7, src2 = 11, dst1 = 0, dst2 = 0;
+            EXPECT_EQ(staging.copy(&dst1, &src1, sizeof(int), 1, true), rocblas_status_success);
+            EXPECT_EQ(staging.copy(&dst2, &src2, sizeof(int), 2, true), rocblas_status_success);
+
+            // Nothing is written until the streams are synchronized
+            EXPECT_EQ(dst1, 0);
+            EXPECT_EQ(dst2, 0);
+            EXPECT_EQ(staging.pending(), size_t(2));
+            EXPECT_EQ(staging.slots(), size_t(2));
+
+            backend.synchronize(1);
+            EXPECT_EQ(dst1, 7);
+            EXPECT_EQ(dst2, 0);
+            EXPECT_EQ(staging.pending(), size_t(1));
+
+            // A later copy reuses the idle slot, and the copy reads src when it runs
+            int dst3 = 0;
+            EXPECT_EQ(staging.copy(&dst3, &src1, sizeof(int), 1, true), rocblas_status_success);
+            src1 = 8;
+            EXPECT_EQ(staging.slots(), size_t(2));
+            EXPECT_EQ(staging.synchronize(), rocblas_status_success);
+            EXPECT_EQ(dst2, 11);
+            EXPECT_EQ(dst3, 8);
+            EXPECT_EQ(staging.pending(), size_t(0));
+
+            // A blocking copy on a stream completes the deferred copies queued before it
+            int dst4 = 0, dst5 = 0;
+            EXPECT_EQ(staging.copy(&dst4, &src2, sizeof(int), 1, true), rocblas_status_success);
+            EXPECT_EQ(staging.copy(&dst5, &src1, sizeof(int), 1, false), rocblas_status_success);
+            EXPECT_EQ(dst4, 11);
+            EXPECT_EQ(dst5, 8);
+
+            // The destructor waits for pending copies
+            EXPECT_EQ(staging.copy(&dst1, &src2, sizeof(int), 3, true), rocblas_status_success);
+        }
+        EXPECT_EQ(backend.state->allocated, size_t(0));
+        EXPECT_TRUE(backend.state->queues[3].empty());
+    }
+
+    void testing_slot_limit()
+    {
+        host_result_backend backend;
+        host_staging        staging(backend);
+
+        std::vector<int> src(host_staging::MAX_SLOTS + 1), dst(host_staging::MAX_SLOTS + 1);
+        for(size_t i = 0; i < src.size(); ++i)
+            src[i] = int(i) + 1;
+
+        // Each stream is only synchronized when all slots are busy, and then only
+        // the stream of the oldest deferred copy
+        for(size_t i = 0; i < src.size(); ++i)
+            EXPECT_EQ(staging.copy(&dst[i], &src[i], sizeof(int), int(i) + 1, true),
+                      rocblas_status_success);
+        EXPECT_EQ(staging.slots(), host_staging::MAX_SLOTS);
+        EXPECT_EQ(backend.state->syncs, size_t(1));
+        EXPECT_EQ(dst[0], 1);
+        EXPECT_EQ(dst[1], 0);
+        EXPECT_EQ(staging.pending(), host_staging::MAX_SLOTS);
+
+        staging.synchronize();
+        for(size_t i = 0; i < src.size(); ++i)
+            EXPECT_EQ(dst[i], src[i]);
+    }
+
+    void testing_failures()
+    {
+        host_result_backend backend;
+        host_staging        staging(backend);
+
+        // The copy is waited for if its completion cannot be queued
+        backend.state->fail_enqueue = true;
+        int src = 5, dst = 0;
+        EXPECT_EQ(staging.copy(&dst, &src, sizeof(int), 1, true), rocblas_status_success);
+        EXPECT_EQ(dst, 5);
+        EXPECT_EQ(staging.pending(), size_t(0));
+        backend.state->fail_enqueue = false;
+
+        backend.state->limit = 1024;
+        std::vector<char> big(4096);
+        EXPECT_EQ(staging.copy(big.data(), big.data(), big.size(), 1, false),
+                  rocblas_status_memory_error);
+        src = 6;
+        EXPECT_EQ(staging.copy(&dst, &src, sizeof(int), 1, false), rocblas_status_success);
+        EXPECT_EQ(dst, 6);
+    }
+
+    void testing_host_result_mode_api()
+    {
+        rocblas_local_handle     handle;
+        rocblas_host_result_mode mode;
+
+        CHECK_ROCBLAS_ERROR(rocblas_get_host_result_mode(handle, &mode));
+        EXPECT_EQ(mode, rocblas_host_result_blocking);
+        CHECK_ROCBLAS_ERROR(rocblas_set_host_result_mode(handle, rocblas_host_result_deferred));
+        CHECK_ROCBLAS_ERROR(rocblas_get_host_result_mode(handle, &mode));
+        EXPECT_EQ(mode, rocblas_host_result_deferred);
+        CHECK_ROCBLAS_ERROR(rocblas_set_host_result_mode(handle, rocblas_host_result_blocking));
+
+        EXPECT_ROCBLAS_STATUS(rocblas_set_host_result_mode(nullptr, rocblas_host_result_blocking),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_set_host_result_mode(handle, rocblas_host_result_mode(2)),
+                              rocblas_status_invalid_value);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_host_result_mode(nullptr, &mode),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_host_result_mode(handle, nullptr),
+                              rocblas_status_invalid_pointer);
+    }
+
+    // Reductions in deferred mode give the results of blocking mode once the stream is
+    // synchronized, including those finalized on the device from a single block
+    void testing_deferred_reductions(const Arguments& arg)
+    {
+        const rocblas_int N           = arg.N;
+        const rocblas_int batch_count = 3;
+
+        rocblas_local_handle handle;
+        hipStream_t          stream;
+        CHECK_HIP_ERROR(hipStreamCreate(&stream));
+        CHECK_ROCBLAS_ERROR(rocblas_set_stream(handle, stream));
+
+        host_vector<float> hx(size_t(N) * batch_count);
+        for(size_t i = 0; i < hx.size(); ++i)
+            hx[i] = float(int(i * 7919 % 13) - 6);
+        device_vector<float> dx(size_t(N) * batch_count);
+        CHECK_DEVICE_ALLOCATION(dx.memcheck());
+        CHECK_HIP_ERROR(dx.transfer_from(hx));
+
+        float       nrm2[2][batch_count], asum[2][batch_count], nrm2_1[2];
+        rocblas_int iamax[2][batch_count], iamin[2];
+        for(int deferred = 0; deferred < 2; ++deferred)
+        {
+            CHECK_ROCBLAS_ERROR(rocblas_set_host_result_mode(
+                handle, deferred ? rocblas_host_result_deferred : rocblas_host_result_blocking));
+            for(int i = 0; i < batch_count; ++i)
+            {
+                nrm2[deferred][i] = asum[deferred][i] = -1;
+                iamax[deferred][i]                    = -1;
+            }
+            nrm2_1[deferred] = -1;
+            iamin[deferred]  = -1;
+
+            CHECK_ROCBLAS_ERROR(
+                rocblas_snrm2_strided_batched(handle, N, dx, 1, N, batch_count, nrm2[deferred]));
+            CHECK_ROCBLAS_ERROR(
+                rocblas_sasum_strided_batched(handle, N, dx, 1, N, batch_count, asum[deferred]));
+            CHECK_ROCBLAS_ERROR(rocblas_isamax_strided_batched(
+                handle, N, dx, 1, N, batch_count, iamax[deferred]));
+            CHECK_ROCBLAS_ERROR(rocblas_snrm2(handle, 1, dx, 1, &nrm2_1[deferred]));
+            CHECK_ROCBLAS_ERROR(rocblas_isamin(handle, N, dx, 1, &iamin[deferred]));
+            CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        }
+
+        for(int i = 0; i < batch_count; ++i)
+        {
+            EXPECT_EQ(nrm2[1][i], nrm2[0][i]);
+            EXPECT_EQ(asum[1][i], asum[0][i]);
+            EXPECT_EQ(iamax[1][i], iamax[0][i]);
+        }
+        EXPECT_EQ(nrm2_1[0], std::abs(hx[0]));
+        EXPECT_EQ(nrm2_1[1], nrm2_1[0]);
+        EXPECT_EQ(iamin[1], iamin[0]);
+
+        CHECK_ROCBLAS_ERROR(rocblas_set_host_result_mode(handle, rocblas_host_result_blocking));
+        CHECK_ROCBLAS_ERROR(rocblas_set_stream(handle, 0));
+        CHECK_HIP_ERROR(hipStreamDestroy(stream));
+    }
+
+    template <typename...>
+    struct testing_host_result_staging : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            testing_blocking_copy();
+            testing_deferred_copy();
+            testing_slot_limit();
+            testing_failures();
+            testing_host_result_mode_api();
+            testing_deferred_reductions(arg);
+        }
+    };
+
+    struct host_result_staging : RocBLAS_Test<host_result_staging, testing_host_result_staging>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "host_result_staging");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<host_result_staging>(arg.name) << arg.N;
+        }
+    };
+
+    TEST_P(host_result_staging, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_host_result_staging<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(host_result_staging)
+
+} // namespace
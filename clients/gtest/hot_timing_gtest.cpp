@@ -0,0 +1,156 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void testing_summarize()
+    {
+        auto stats = rocblas_timing_summarize({5, 1, 4, 2, 3});
+        EXPECT_EQ(stats.samples, size_t(5));
+        EXPECT_DOUBLE_EQ(stats.mean_us, 3);
+        EXPECT_DOUBLE_EQ(stats.min_us, 1);
+        EXPECT_DOUBLE_EQ(stats.median_us, 3);
+        EXPECT_DOUBLE_EQ(stats.p90_us, 4.6);
+        EXPECT_DOUBLE_EQ(stats.p99_us, 4.96);
+        EXPECT_DOUBLE_EQ(stats.stddev_us, std::sqrt(2.5));
+        EXPECT_DOUBLE_EQ(stats.ci95_us, 2.776 * std::sqrt(2.5) / std::sqrt(5.0));
+
+        std::vector<double> hundred;
+        for(int i = 100; i > 0; --i)
+            hundred.push_back(i);
+        stats = rocblas_timing_summarize(hundred);
+        EXPECT_DOUBLE_EQ(stats.median_us, 50.5);
+        EXPECT_DOUBLE_EQ(stats.p90_us, 90.1);
+        EXPECT_DOUBLE_EQ(stats.p99_us, 99.01);
+
+        // Past 31 samples, the normal distribution is used
+        EXPECT_DOUBLE_EQ(rocblas_timing_ci95(100, 10), 1.96);
+        EXPECT_DOUBLE_EQ(rocblas_timing_ci95(31, std::sqrt(31.0)), 2.042);
+
+        // A single sample has no confidence interval, and never converges
+        stats = rocblas_timing_summarize({7});
+        EXPECT_DOUBLE_EQ(stats.median_us, 7);
+        EXPECT_DOUBLE_EQ(stats.p99_us, 7);
+        EXPECT_EQ(stats.stddev_us, 0.0);
+        EXPECT_FALSE(rocblas_timing_converged(stats, 1e9));
+
+        EXPECT_EQ(rocblas_timing_summarize({}).samples, size_t(0));
+
+        stats = rocblas_timing_summarize({10, 10.1, 9.9, 10, 10});
+        EXPECT_TRUE(rocblas_timing_converged(stats, 0.02));
+        EXPECT_FALSE(rocblas_timing_converged(stats, 0.001));
+    }
+
+    // Runs a hot loop of batch calls of scal, returning the number of calls
+    int hot_loop(rocblas_handle handle, float* dx, int batch)
+    {
+        hipStream_t stream;
+        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+        const float alpha = 1;
+        int         calls = 0;
+        for(rocblas_hot_iterations hot(batch, stream); hot.next();)
+        {
+            rocblas_sscal(handle, 1 << 16, &alpha, dx, 1);
+            ++calls;
+        }
+        return calls;
+    }
+
+    // Samples are only taken when enabled. They are taken once, and more batches run until
+    // they converge.
+    void testing_hot_iterations()
+    {
+        rocblas_local_handle handle;
+        device_vector<float> dx(1 << 16);
+        CHECK_DEVICE_ALLOCATION(dx.memcheck());
+        CHECK_HIP_ERROR(hipMemset(dx, 0, sizeof(float) << 16));
+
+        rocblas_timing_stats stats;
+        rocblas_timing_set_samples(false);
+        rocblas_timing_set_convergence(0, 0);
+        EXPECT_EQ(hot_loop(handle, dx, 5), 5);
+        EXPECT_FALSE(rocblas_timing_take_last(stats));
+
+        rocblas_timing_set_samples(true);
+        EXPECT_EQ(hot_loop(handle, dx, 5), 5);
+        ASSERT_TRUE(rocblas_timing_take_last(stats));
+        EXPECT_EQ(stats.samples, size_t(5));
+        EXPECT_GE(stats.min_us, 0.0);
+        EXPECT_LE(stats.min_us, stats.median_us);
+        EXPECT_LE(stats.median_us, stats.p99_us);
+        EXPECT_FALSE(rocblas_timing_take_last(stats));
+
+        EXPECT_EQ(hot_loop(handle, dx, 0), 0);
+        EXPECT_FALSE(rocblas_timing_take_last(stats));
+
+        // Samples not taken by log_perf are cleared
+        EXPECT_EQ(hot_loop(handle, dx, 5), 5);
+        rocblas_timing_clear_last();
+        EXPECT_FALSE(rocblas_timing_take_last(stats));
+
+        // Convergence takes samples whether or not they are enabled
+        rocblas_timing_set_samples(false);
+
+        // Any spread of the first batch is within this interval
+        rocblas_timing_set_convergence(1e9, 100);
+        EXPECT_EQ(hot_loop(handle, dx, 5), 5);
+        ASSERT_TRUE(rocblas_timing_take_last(stats));
+        EXPECT_EQ(stats.samples, size_t(5));
+
+        // Batches run until another would exceed the maximum, unless the times are all equal
+        rocblas_timing_set_convergence(1e-12, 17);
+        int calls = hot_loop(handle, dx, 5);
+        ASSERT_TRUE(rocblas_timing_take_last(stats));
+        EXPECT_EQ(stats.samples, size_t(calls));
+        if(stats.stddev_us > 0)
+            EXPECT_EQ(calls, 15);
+        rocblas_timing_set_convergence(0, 0);
+    }
+
+    template <typename...>
+    struct testing_hot_timing : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            testing_summarize();
+            testing_hot_iterations();
+        }
+    };
+
+    struct hot_timing : RocBLAS_Test<hot_timing, testing_hot_timing>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "hot_timing");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<hot_timing>(arg.name);
+        }
+    };
+
+    TEST_P(hot_timing, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_hot_timing<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(hot_timing)
+
+} // namespace
@@ -0,0 +1,279 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_launch_tuning.hpp"
+#include "cblas_interface.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    constexpr rocblas_datatype precisions[] = {rocblas_datatype_f32_r,
+                                               rocblas_datatype_f64_r,
+                                               rocblas_datatype_f32_c,
+                                               rocblas_datatype_f64_c};
+
+    rocblas_launch_tuning_table default_table(int arch = 0)
+    {
+        rocblas_launch_tuning_table all, table;
+        std::string                 error;
+        EXPECT_TRUE(all.parse(rocblas_launch_tuning_default_table, error)) << error;
+        table.append(all, arch);
+        return table;
+    }
+
+    // Whether gemvn used 512 threads per block before the launch tuning table
+    bool gemvn_512_threads(int arch, rocblas_datatype precision, rocblas_int m, rocblas_int n)
+    {
+        bool s = precision == rocblas_datatype_f32_r, d = precision == rocblas_datatype_f64_r;
+        bool c = precision == rocblas_datatype_f32_c, z = precision == rocblas_datatype_f64_c;
+        if(arch == 908)
+            return ((s || d || c) && m <= 15000 && n <= 15000) || (z && m <= 18000 && n <= 18000);
+        if(arch == 906)
+            return c || ((s || d) && m <= 6000 && n <= 6000)
+                   || (d && ((m >= 15000 && n >= 15000) || (m <= 24000 && n <= 24000)));
+        return false;
+    }
+
+    // The compiled table selects what gemv and scal selected before it
+    void testing_default_table()
+    {
+        const rocblas_int sizes[]
+            = {1, 5999, 6000, 6001, 14999, 15000, 15001, 18000, 18001, 24000, 24001, 40000};
+        for(int arch : {803, 900, 906, 908, 910})
+        {
+            auto table = default_table(arch);
+            for(rocblas_datatype precision : precisions)
+                for(rocblas_int m : sizes)
+                    for(rocblas_int n : sizes)
+                    {
+                        auto gemvn = table.lookup(rocblas_tuned_kernel::gemvn,
+                                                  arch,
+                                                  precision,
+                                                  rocblas_operation_none,
+                                                  m,
+                                                  n);
+                        ASSERT_NE(gemvn, nullptr);
+                        EXPECT_EQ(gemvn->dim_x,
+                                  gemvn_512_threads(arch, precision, m, n) ? 32 : 64);
+                        EXPECT_EQ(gemvn->dim_y, 16);
+
+                        for(rocblas_operation trans :
+                            {rocblas_operation_transpose, rocblas_operation_conjugate_transpose})
+                        {
+                            auto gemvt = table.lookup(
+                                rocblas_tuned_kernel::gemvt, arch, precision, trans, m, n);
+                            ASSERT_NE(gemvt, nullptr);
+                            EXPECT_EQ(gemvt->dim_x,
+                                      precision == rocblas_datatype_f32_r ? 256 : 1024);
+                        }
+                    }
+
+            auto scal = table.lookup(rocblas_tuned_kernel::scal,
+                                     arch,
+                                     rocblas_datatype_f64_c,
+                                     rocblas_operation_none,
+                                     7,
+                                     1);
+            ASSERT_NE(scal, nullptr);
+            EXPECT_EQ(scal->dim_x, 256);
+        }
+    }
+
+    // Entries which come first take precedence, and only those of the arch are appended
+    void testing_precedence()
+    {
+        rocblas_launch_tuning_table table, tuned;
+        std::string                 error;
+        EXPECT_TRUE(tuned.parse("gemvn 908 f64_r N 0 100 0 * 64 16 # small m\n"
+                                "\n"
+                                "scal * * * 1000 * 0 * 1024 1\n"
+                                "scal 906 * * 0 * 0 * 512 1\n",
+                                error))
+            << error;
+        table.append(tuned, 908);
+        table.append(default_table(), 908);
+        EXPECT_EQ(table.entries().size(), size_t(2 + 8));
+
+        auto dims = [&](rocblas_tuned_kernel kernel, rocblas_datatype precision, int64_t m) {
+            return *table.lookup(kernel, 908, precision, rocblas_operation_none, m, 1);
+        };
+        EXPECT_EQ(dims(rocblas_tuned_kernel::gemvn, rocblas_datatype_f64_r, 100),
+                  (rocblas_launch_dims{64, 16}));
+        EXPECT_EQ(dims(rocblas_tuned_kernel::gemvn, rocblas_datatype_f64_r, 101),
+                  (rocblas_launch_dims{32, 16}));
+        EXPECT_EQ(dims(rocblas_tuned_kernel::gemvn, rocblas_datatype_f32_r, 100),
+                  (rocblas_launch_dims{32, 16}));
+        EXPECT_EQ(dims(rocblas_tuned_kernel::scal, rocblas_datatype_f32_r, 999),
+                  (rocblas_launch_dims{256, 1}));
+        EXPECT_EQ(dims(rocblas_tuned_kernel::scal, rocblas_datatype_f32_r, 1000),
+                  (rocblas_launch_dims{1024, 1}));
+
+        // Without a matching entry, the caller uses its compiled default
+        rocblas_launch_tuning_table empty;
+        auto                        none = empty.lookup(
+            rocblas_tuned_kernel::scal, 908, rocblas_datatype_f32_r, rocblas_operation_none, 1, 1);
+        EXPECT_EQ(none, nullptr);
+    }
+
+    // Invalid tables are rejected as a whole, with the line of the error
+    void testing_parse_errors()
+    {
+        const char* invalid[] = {"gemvn 908 f32_r N 0 10 0 10 32",
+                                 "gemv 908 f32_r N 0 10 0 10 32 16",
+                                 "gemvn gfx908 f32_r N 0 10 0 10 32 16",
+                                 "gemvn 0 f32_r N 0 10 0 10 32 16",
+                                 "gemvn 908 f16_c N 0 10 0 10 32 16",
+                                 "gemvn 908 f32_r X 0 10 0 10 32 16",
+                                 "gemvn 908 f32_r N 11 10 0 10 32 16",
+                                 "gemvn 908 f32_r N * 10 0 10 32 16",
+                                 "gemvn 908 f32_r N 0 10 -1 10 32 16",
+                                 "gemvn 908 f32_r N 0 10 0 1e3 32 16",
+                                 "gemvn 908 f32_r N 0 10 0 10 16 32",
+                                 "gemvt * * T 0 * 0 * 512 1",
+                                 "scal * * * 0 * 0 * 256 2"};
+        for(const char* entry : invalid)
+        {
+            rocblas_launch_tuning_table table;
+            std::string                 error;
+            std::string text = std::string("# comment\nscal * * * 0 * 0 * 512 1\n") + entry;
+            EXPECT_FALSE(table.parse(text.c_str(), error)) << entry;
+            EXPECT_EQ(error.compare(0, 8, "line 3: "), 0) << error;
+            EXPECT_TRUE(table.entries().empty());
+        }
+    }
+
+    // write gives text which parse reads back to the same table
+    void testing_round_trip()
+    {
+        auto               table = default_table();
+        std::ostringstream text;
+        table.write(text);
+
+        rocblas_launch_tuning_table copy;
+        std::string                 error;
+        EXPECT_TRUE(copy.parse(text.str().c_str(), error)) << error;
+        ASSERT_EQ(copy.entries().size(), table.entries().size());
+        for(size_t i = 0; i < table.entries().size(); ++i)
+        {
+            auto &a = table.entries()[i], &b = copy.entries()[i];
+            EXPECT_TRUE(a.kernel == b.kernel && a.arch == b.arch && a.precision == b.precision
+                        && a.trans == b.trans && a.m_min == b.m_min && a.m_max == b.m_max
+                        && a.n_min == b.n_min && a.n_max == b.n_max && a.dims == b.dims)
+                << i;
+        }
+    }
+
+    // Every configuration of gemvn, gemvt and scal, selected with rocblas_set_launch_tuning_table,
+    // gives the exact result of the reference on integer values
+    void testing_handle_tables()
+    {
+        rocblas_local_handle handle;
+        EXPECT_ROCBLAS_STATUS(rocblas_set_launch_tuning_table(nullptr, nullptr),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_set_launch_tuning_table(handle, "gemvn * * N 0 * 0 * 16 16"),
+                              rocblas_status_invalid_value);
+        CHECK_ROCBLAS_ERROR(rocblas_set_launch_tuning_table(handle, nullptr));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+
+        const rocblas_int   M = 300, N = 200;
+        const double        alpha = 2, beta = 0;
+        host_vector<double> hA(M * N), hx(M), hy(M), hy_gold(M);
+        rocblas_seedrand();
+        rocblas_init(hA, M, N, M);
+        rocblas_init(hx, 1, M, 1);
+
+        device_vector<double> dA(M * N), dx(M), dy(M);
+        CHECK_DEVICE_ALLOCATION(dA.memcheck());
+        CHECK_DEVICE_ALLOCATION(dx.memcheck());
+        CHECK_DEVICE_ALLOCATION(dy.memcheck());
+        CHECK_HIP_ERROR(dA.transfer_from(hA));
+
+        auto select = [&](rocblas_tuned_kernel kernel, const rocblas_launch_dims& dims) {
+            rocblas_launch_tuning_table table;
+            table.add({kernel, 0, rocblas_datatype_f64_r, 0, 0, INT64_MAX, 0, INT64_MAX, dims});
+            std::ostringstream text;
+            table.write(text);
+            CHECK_ROCBLAS_ERROR(rocblas_set_launch_tuning_table(handle, text.str().c_str()));
+        };
+
+        for(rocblas_operation trans : {rocblas_operation_none, rocblas_operation_transpose})
+        {
+            bool        none   = trans == rocblas_operation_none;
+            rocblas_int leny   = none ? M : N;
+            auto        kernel = none ? rocblas_tuned_kernel::gemvn : rocblas_tuned_kernel::gemvt;
+
+            cblas_gemv<double>(trans, M, N, alpha, hA, M, hx, 1, beta, hy_gold, 1);
+
+            for(auto& dims : rocblas_launch_tuning_configs(kernel))
+            {
+                select(kernel, dims);
+                CHECK_HIP_ERROR(dx.transfer_from(hx));
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_dgemv(handle, trans, M, N, &alpha, dA, M, dx, 1, &beta, dy, 1));
+                CHECK_HIP_ERROR(hy.transfer_from(dy));
+                EXPECT_EQ(memcmp(hy.data(), hy_gold.data(), sizeof(double) * leny), 0)
+                    << rocblas_tuned_kernel_name(kernel) << ' ' << dims.dim_x << 'x'
+                    << dims.dim_y;
+            }
+        }
+
+        hy_gold = hx;
+        cblas_scal(M, alpha, (double*)hy_gold, 1);
+        for(auto& dims : rocblas_launch_tuning_configs(rocblas_tuned_kernel::scal))
+        {
+            select(rocblas_tuned_kernel::scal, dims);
+            CHECK_HIP_ERROR(dx.transfer_from(hx));
+            CHECK_ROCBLAS_ERROR(rocblas_dscal(handle, M, &alpha, dx, 1));
+            CHECK_HIP_ERROR(hy.transfer_from(dx));
+            EXPECT_EQ(memcmp(hy.data(), hy_gold.data(), sizeof(double) * M), 0) << dims.dim_x;
+        }
+    }
+
+    template <typename...>
+    struct testing_launch_tuning : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            testing_default_table();
+            testing_precedence();
+            testing_parse_errors();
+            testing_round_trip();
+            testing_handle_tables();
+        }
+    };
+
+    struct launch_tuning : RocBLAS_Test<launch_tuning, testing_launch_tuning>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "launch_tuning");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<launch_tuning>(arg.name);
+        }
+    };
+
+    TEST_P(launch_tuning, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_launch_tuning<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(launch_tuning)
+
+} // namespace
@@ -0,0 +1,277 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_lazy_code_objects.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_test.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Whether each code object file should be preloaded for the processor
+    void testing_preload()
+    {
+        using lazy = rocblas_lazy_code_objects;
+        const std::string path = "/opt/rocm/lib/library/Kernels.so-000-gfx908-xnack-.hsaco";
+
+        EXPECT_FALSE(lazy::preload(path, "gfx908", nullptr));
+        EXPECT_FALSE(lazy::preload(path, "gfx908", ""));
+        EXPECT_TRUE(lazy::preload(path, "gfx908", "Kernels"));
+        EXPECT_TRUE(lazy::preload(path, "gfx908", "Other,gfx908-xnack-"));
+        EXPECT_FALSE(lazy::preload(path, "gfx908", "Other,gfx90a"));
+
+        // Only the file name is matched, not the directory
+        EXPECT_FALSE(lazy::preload(path, "gfx908", "library"));
+
+        // arch:substring only preloads for arch
+        EXPECT_TRUE(lazy::preload(path, "gfx908", "gfx908:Kernels"));
+        EXPECT_FALSE(lazy::preload(path, "gfx90a", "gfx908:Kernels"));
+        EXPECT_TRUE(lazy::preload(path, "gfx90a", "gfx908:Kernels,gfx90a:000"));
+    }
+
+#ifndef WIN32
+    struct kernel_t
+    {
+        std::string kernelName;
+    };
+
+    // Host adapter which knows the kernels in each code object file, and
+    // records the files loaded and the lookups made
+    struct host_adapter
+    {
+        std::map<std::string, std::vector<std::string>> files;
+        std::vector<std::string>                        loaded;
+        std::set<std::string>                           kernels;
+        std::atomic<size_t>                             lookups{0};
+        std::mutex                                      mutex;
+
+        bool has_kernel(const std::string& name)
+        {
+            ++lookups;
+            std::lock_guard<std::mutex> lock(mutex);
+            return kernels.count(name) != 0;
+        }
+
+        void load_file(const std::string& path)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            loaded.push_back(path);
+            for(auto& kernel : files[path])
+                kernels.insert(kernel);
+        }
+    };
+
+    // A directory of code object files, whose symbol names are NUL-terminated
+    struct code_object_dir
+    {
+        std::string              dir;
+        std::vector<std::string> paths;
+
+        code_object_dir()
+        {
+            char tmp[] = "/tmp/rocblas-lazy-XXXXXX";
+            if(mkdtemp(tmp))
+                dir = tmp;
+        }
+
+        std::string add(host_adapter& adapter, const char* name, std::vector<std::string> kernels)
+        {
+            std::string path = dir + "/" + name;
+            std::string contents("\x7f"
+                                 "ELF",
+                                 4);
+            for(auto& kernel : kernels)
+                (contents += '\0') += kernel;
+            contents += std::string(1, '\0') + "padding";
+            std::ofstream(path, std::ofstream::binary | std::ofstream::trunc) << contents;
+            adapter.files[path] = std::move(kernels);
+            paths.push_back(path);
+            return path;
+        }
+
+        ~code_object_dir()
+        {
+            for(auto& path : paths)
+                remove(path.c_str());
+            rmdir(dir.c_str());
+        }
+    };
+
+    // Files are loaded in the order their kernels are first launched, once each
+    void testing_load_order()
+    {
+        code_object_dir           dir;
+        host_adapter              adapter;
+        rocblas_lazy_code_objects code_objects;
+        ASSERT_FALSE(dir.dir.empty());
+
+        // An eagerly loaded file
+        auto eager = dir.add(adapter, "eager.co", {"Cijk_eager"});
+        adapter.load_file(eager);
+        adapter.loaded.clear();
+
+        auto a = dir.add(adapter, "a.co", {"Cijk_a1", "Cijk_a2"});
+        auto b = dir.add(adapter, "b.co", {"Cijk_b1"});
+        auto c = dir.add(adapter, "c.co", {"Cijk_c10"});
+        auto d = dir.add(adapter, "d.co", {"Cijk_d1"});
+        for(auto& path : {a, b, c, d})
+            code_objects.add(path);
+        EXPECT_EQ(code_objects.pending(), size_t(4));
+
+        code_objects.load(adapter, std::vector<kernel_t>{{"Cijk_b1"}});
+        EXPECT_EQ(adapter.loaded, std::vector<std::string>({b}));
+        code_objects.load(adapter, std::vector<kernel_t>{{"Cijk_a2"}, {"Cijk_a1"}});
+        EXPECT_EQ(adapter.loaded, std::vector<std::string>({b, a}));
+        EXPECT_EQ(code_objects.pending(), size_t(2));
+
+        // Resolved kernels are not looked up again
+        size_t lookups = adapter.lookups;
+        for(int i = 0; i < 10; ++i)
+            code_objects.load(adapter, std::vector<kernel_t>{{"Cijk_a1"}, {"Cijk_b1"}});
+        EXPECT_EQ(adapter.lookups, lookups);
+
+        // A kernel in a loaded file is resolved without searching the pending
+        // files, which would load d.co now that it cannot be opened
+        remove(d.c_str());
+        code_objects.load(adapter, std::vector<kernel_t>{{"Cijk_eager"}});
+        EXPECT_EQ(adapter.loaded, std::vector<std::string>({b, a}));
+
+        // Names only match whole symbols, so Cijk_c1 is not found in c.co, and
+        // d.co is loaded for the adapter to report the error
+        code_objects.load(adapter, std::vector<kernel_t>{{"Cijk_c1"}});
+        EXPECT_EQ(adapter.loaded, std::vector<std::string>({b, a, d}));
+        code_objects.load(adapter, std::vector<kernel_t>{{"Cijk_c10"}, {"Cijk_x"}});
+        EXPECT_EQ(adapter.loaded, std::vector<std::string>({b, a, d, c}));
+        EXPECT_EQ(code_objects.pending(), size_t(0));
+
+        // Once every file is loaded, nothing is looked up
+        lookups = adapter.lookups;
+        code_objects.load(adapter, std::vector<kernel_t>{{"Cijk_y"}});
+        EXPECT_EQ(adapter.lookups, lookups);
+    }
+
+    // Kernels resolved after the lock-free table is full are still found
+    void testing_many_kernels()
+    {
+        code_object_dir           dir;
+        host_adapter              adapter;
+        rocblas_lazy_code_objects code_objects;
+        ASSERT_FALSE(dir.dir.empty());
+
+        code_objects.add(dir.add(adapter, "last.co", {"Cijk_last"}));
+
+        std::vector<kernel_t> kernels;
+        for(int i = 0; i < 5000; ++i)
+            kernels.push_back({"Cijk_" + std::to_string(i)});
+        code_objects.load(adapter, kernels);
+        EXPECT_EQ(adapter.lookups, kernels.size());
+        EXPECT_TRUE(adapter.loaded.empty());
+
+        code_objects.load(adapter, kernels);
+        for(auto& kernel : kernels)
+            code_objects.load(adapter, std::vector<kernel_t>{kernel});
+        EXPECT_EQ(adapter.lookups, kernels.size());
+
+        code_objects.load(adapter, std::vector<kernel_t>{{"Cijk_last"}});
+        EXPECT_EQ(adapter.loaded.size(), size_t(1));
+    }
+
+    // Threads launching the same kernels load each file once, and do not
+    // launch a kernel before its file is loaded
+    void testing_threads()
+    {
+        code_object_dir           dir;
+        host_adapter              adapter;
+        rocblas_lazy_code_objects code_objects;
+        ASSERT_FALSE(dir.dir.empty());
+
+        constexpr int files = 16;
+        for(int f = 0; f < files; ++f)
+        {
+            std::string name = "k" + std::to_string(f) + ".co";
+            code_objects.add(dir.add(adapter,
+                                     name.c_str(),
+                                     {"Cijk_" + std::to_string(f) + "_0",
+                                      "Cijk_" + std::to_string(f) + "_1"}));
+        }
+
+        std::atomic<size_t>      missing{0};
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 8; ++t)
+            threads.emplace_back([&, t] {
+                for(int i = 0; i < 200; ++i)
+                {
+                    std::string name = "Cijk_" + std::to_string((i + t) % files) + "_"
+                                       + std::to_string(i % 2);
+                    code_objects.load(adapter, std::vector<kernel_t>{{name}});
+                    std::lock_guard<std::mutex> lock(adapter.mutex);
+                    missing += !adapter.kernels.count(name);
+                }
+            });
+        for(auto& thread : threads)
+            thread.join();
+
+        EXPECT_EQ(missing, size_t(0));
+        EXPECT_EQ(adapter.loaded.size(), size_t(files));
+        EXPECT_EQ(std::set<std::string>(adapter.loaded.begin(), adapter.loaded.end()).size(),
+                  size_t(files));
+        EXPECT_EQ(code_objects.pending(), size_t(0));
+    }
+#endif
+
+    template <typename...>
+    struct testing_lazy_code_objects : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            testing_preload();
+#ifndef WIN32
+            testing_load_order();
+            testing_many_kernels();
+            testing_threads();
+#endif
+        }
+    };
+
+    struct lazy_code_objects : RocBLAS_Test<lazy_code_objects, testing_lazy_code_objects>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "lazy_code_objects");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<lazy_code_objects>(arg.name);
+        }
+    };
+
+    TEST_P(lazy_code_objects, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_lazy_code_objects<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(lazy_code_objects)
+
+} // namespace
@@ -15,7 +15,10 @@ namespace
         void operator()(const Arguments& arg)
         {
             if(!strcmp(arg.function, "ostream_threadsafety"))
+            {
                 testing_ostream_threadsafety(arg);
+                testing_ostream_write_failure();
+            }
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
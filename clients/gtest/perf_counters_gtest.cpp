@@ -0,0 +1,194 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_perf_counters.hpp"
+#include "bytes.hpp"
+#include "flops.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // The same name at two addresses, as when it is defined in two translation units
+    char sgemm_a[] = "rocblas_sgemm";
+    char sgemm_b[] = "rocblas_sgemm";
+
+    void testing_latency_buckets()
+    {
+        EXPECT_EQ(rocblas_perf_latency_bucket(0), size_t(0));
+        EXPECT_EQ(rocblas_perf_latency_bucket(999), size_t(0));
+        for(size_t b = 1; b < ROCBLAS_PERF_LATENCY_BUCKETS - 1; ++b)
+        {
+            EXPECT_EQ(rocblas_perf_latency_bucket(1000ull << (b - 1)), b);
+            EXPECT_EQ(rocblas_perf_latency_bucket((1000ull << b) - 1), b);
+        }
+        size_t last = ROCBLAS_PERF_LATENCY_BUCKETS - 1;
+        EXPECT_EQ(rocblas_perf_latency_bucket(1000ull << (last - 1)), last);
+        EXPECT_EQ(rocblas_perf_latency_bucket(UINT64_MAX), last);
+    }
+
+    // Calls recorded by more threads than there are shards are all counted, and merged by
+    // name whatever the address of the name
+    void testing_record_threads()
+    {
+        rocblas_perf_counters counters;
+        const size_t          threads = rocblas_perf_counters::shards * 2 + 3, calls = 1000;
+
+        std::vector<std::thread> workers;
+        for(size_t t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] {
+                for(size_t i = 0; i < calls; ++i)
+                {
+                    counters.record(t % 2 ? sgemm_a : sgemm_b, 3, 4, 1500);
+                    if(i % 4 == 0)
+                        counters.record("rocblas_daxpy", 1, 2, t * 1000000 + i);
+                }
+            });
+        for(auto& w : workers)
+            w.join();
+
+        auto snapshot = counters.snapshot();
+        ASSERT_EQ(snapshot.size(), size_t(2));
+
+        // Sorted by name
+        EXPECT_STREQ(snapshot[0].function, "rocblas_daxpy");
+        EXPECT_STREQ(snapshot[1].function, "rocblas_sgemm");
+
+        auto& axpy = snapshot[0];
+        auto& gemm = snapshot[1];
+        EXPECT_EQ(gemm.calls, threads * calls);
+        EXPECT_EQ(gemm.bytes, 3.0 * threads * calls);
+        EXPECT_EQ(gemm.flops, 4.0 * threads * calls);
+        EXPECT_DOUBLE_EQ(gemm.latency_us_sum, 1.5 * threads * calls);
+        EXPECT_EQ(gemm.latency_us_max, 1.5);
+        EXPECT_EQ(gemm.latency_histogram[1], threads * calls);
+
+        size_t axpy_calls = threads * ((calls + 3) / 4);
+        EXPECT_EQ(axpy.calls, axpy_calls);
+        EXPECT_EQ(axpy.flops, 2.0 * axpy_calls);
+        EXPECT_EQ(axpy.latency_us_max, ((threads - 1) * 1000000 + calls - 4) / 1000.0);
+
+        size_t histogram_calls = 0;
+        for(size_t b = 0; b < ROCBLAS_PERF_LATENCY_BUCKETS; ++b)
+            histogram_calls += axpy.latency_histogram[b];
+        EXPECT_EQ(histogram_calls, axpy_calls);
+
+        counters.reset();
+        EXPECT_TRUE(counters.snapshot().empty());
+        counters.record("rocblas_daxpy", 1, 2, 0);
+        snapshot = counters.snapshot();
+        ASSERT_EQ(snapshot.size(), size_t(1));
+        EXPECT_EQ(snapshot[0].calls, size_t(1));
+        EXPECT_EQ(snapshot[0].latency_histogram[0], size_t(1));
+    }
+
+    // The flops are those of rocblas-bench, and the bytes those of rocblas-bench where it
+    // counts each operand once
+    template <typename T>
+    void testing_work()
+    {
+        const rocblas_int m = 300, n = 200, k = 50, batch_count = 3;
+
+        auto gemm = rocblas_perf_gemm_work(
+            m, n, k, batch_count, sizeof(T), sizeof(T), sizeof(T), is_complex<T>);
+        EXPECT_DOUBLE_EQ(gemm.flops, gemm_gflop_count<T>(m, n, k) * 1e9 * batch_count);
+        EXPECT_DOUBLE_EQ(gemm.bytes, sizeof(T) * (m * k + k * n + 2.0 * m * n) * batch_count);
+
+        for(auto trans : {rocblas_operation_none, rocblas_operation_transpose})
+        {
+            auto gemv = rocblas_perf_gemv_work(trans, m, n, 1, sizeof(T), is_complex<T>);
+            EXPECT_DOUBLE_EQ(gemv.flops, gemv_gflop_count<T>(trans, m, n) * 1e9);
+        }
+
+        auto axpy = rocblas_perf_axpy_work(n, 1, sizeof(T), is_complex<T>);
+        EXPECT_DOUBLE_EQ(axpy.flops, axpy_gflop_count<T>(n) * 1e9);
+        EXPECT_DOUBLE_EQ(axpy.bytes, axpy_gbyte_count<T>(n) * 1e9);
+
+        auto dot = rocblas_perf_dot_work(n, 1, sizeof(T), is_complex<T>, false);
+        EXPECT_DOUBLE_EQ(dot.flops, (dot_gflop_count<false, T>(n) * 1e9));
+        EXPECT_DOUBLE_EQ(dot.bytes, dot_gbyte_count<T>(n) * 1e9);
+        auto dotc = rocblas_perf_dot_work(n, 1, sizeof(T), is_complex<T>, true);
+        EXPECT_DOUBLE_EQ(dotc.flops, (dot_gflop_count<true, T>(n) * 1e9));
+
+        auto scal = rocblas_perf_scal_work(n, 1, sizeof(T), is_complex<T>, is_complex<T>);
+        EXPECT_DOUBLE_EQ(scal.flops, (scal_gflop_count<T, T>(n) * 1e9));
+        EXPECT_DOUBLE_EQ(scal.bytes, scal_gbyte_count<T>(n) * 1e9);
+        if constexpr(is_complex<T>)
+        {
+            auto scal_real = rocblas_perf_scal_work(n, 1, sizeof(T), true, false);
+            EXPECT_DOUBLE_EQ(scal_real.flops, (scal_gflop_count<T, real_t<T>>(n) * 1e9));
+        }
+
+        // Invalid sizes do no work
+        auto invalid = rocblas_perf_gemm_work(-1, n, k, 1, sizeof(T), sizeof(T), 0, false);
+        EXPECT_EQ(invalid.flops, 0.0);
+        EXPECT_EQ(invalid.bytes, sizeof(T) * double(k) * n);
+        EXPECT_EQ(rocblas_perf_axpy_work(n, -1, sizeof(T), false).bytes, 0.0);
+    }
+
+    void testing_api()
+    {
+        rocblas_local_handle handle;
+        size_t               count = 0;
+        EXPECT_ROCBLAS_STATUS(rocblas_get_perf_counters(handle, nullptr, nullptr),
+                              rocblas_status_invalid_pointer);
+        CHECK_ROCBLAS_ERROR(rocblas_reset_perf_counters(handle));
+        CHECK_ROCBLAS_ERROR(rocblas_get_perf_counters(handle, nullptr, &count));
+        EXPECT_EQ(count, size_t(0));
+
+        // The counters of all handles
+        CHECK_ROCBLAS_ERROR(rocblas_get_perf_counters(nullptr, nullptr, &count));
+        std::vector<rocblas_function_counters> counters(count);
+        size_t                                 stored = count;
+        CHECK_ROCBLAS_ERROR(rocblas_get_perf_counters(nullptr, counters.data(), &stored));
+        EXPECT_GE(stored, count);
+    }
+
+    template <typename...>
+    struct testing_perf_counters : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            testing_latency_buckets();
+            testing_record_threads();
+            testing_work<float>();
+            testing_work<double>();
+            testing_work<rocblas_float_complex>();
+            testing_work<rocblas_double_complex>();
+            testing_api();
+        }
+    };
+
+    struct perf_counters : RocBLAS_Test<perf_counters, testing_perf_counters>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "perf_counters");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<perf_counters>(arg.name);
+        }
+    };
+
+    TEST_P(perf_counters, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_perf_counters<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(perf_counters)
+
+} // namespace
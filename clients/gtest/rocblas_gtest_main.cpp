@@ -63,6 +63,9 @@ public:
 
     void OnTestStart(const TestInfo& test_info) override
     {
+        // Timing samples left by a previous test which failed before logging them
+        rocblas_timing_clear_last();
+
         if(showTestNames)
             eventListener->OnTestStart(test_info);
     }
@@ -0,0 +1,156 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "rocblas_data.hpp"
+#include "rocblas_datatype2string.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "type_dispatch.hpp"
+#include "utility.hpp"
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    // Runs init into serial on one thread and into parallel on at least four
+    template <typename T, typename F>
+    void init_threads(std::vector<T>& serial, std::vector<T>& parallel, F init)
+    {
+#ifdef _OPENMP
+        int threads = omp_get_max_threads();
+        omp_set_num_threads(1);
+#endif
+        rocblas_seedrand();
+        init(serial.data());
+#ifdef _OPENMP
+        omp_set_num_threads(threads < 4 ? 4 : threads);
+#endif
+        rocblas_seedrand();
+        init(parallel.data());
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#endif
+    }
+
+    template <typename T>
+    void testing_init_thread_invariance(const Arguments& arg)
+    {
+        const size_t M = arg.M, N = arg.N, lda = arg.lda, batch_count = arg.batch_count;
+        const size_t stride = lda * N;
+        std::vector<T> A(stride * batch_count), B(stride * batch_count);
+
+        // The values depend only on the seed and the element, not on the number of threads
+        init_threads(A, B, [&](T* X) { rocblas_init(X, M, N, lda, stride, batch_count); });
+        EXPECT_EQ(memcmp(A.data(), B.data(), sizeof(T) * A.size()), 0);
+
+        init_threads(A, B, [&](T* X) {
+            rocblas_init_alternating_sign(X, M, N, lda, stride, batch_count);
+        });
+        EXPECT_EQ(memcmp(A.data(), B.data(), sizeof(T) * A.size()), 0);
+
+        init_threads(A, B, [&](T* X) { rocblas_init_nan(X, M, N, lda, stride, batch_count); });
+        EXPECT_EQ(memcmp(A.data(), B.data(), sizeof(T) * A.size()), 0);
+
+        // Successive initializations differ, and repeat after rocblas_seedrand
+        rocblas_seedrand();
+        rocblas_init(A.data(), M, N, lda, stride, batch_count);
+        rocblas_init(B.data(), M, N, lda, stride, batch_count);
+        EXPECT_NE(memcmp(A.data(), B.data(), sizeof(T) * A.size()), 0);
+        rocblas_seedrand();
+        rocblas_init(B.data(), M, N, lda, stride, batch_count);
+        EXPECT_EQ(memcmp(A.data(), B.data(), sizeof(T) * A.size()), 0);
+
+        // Values lie in the range of random_generator, and rows past M are not written
+        std::vector<T> C(stride * batch_count, T(0));
+        rocblas_init(C.data(), M, N, lda, stride, batch_count);
+        for(size_t b = 0; b < batch_count; ++b)
+            for(size_t j = 0; j < N; ++j)
+                for(size_t i = 0; i < lda; ++i)
+                {
+                    double value = C[b * stride + j * lda + i];
+                    if(i < M)
+                        EXPECT_TRUE(value >= 1 && value <= 10 && value == int(value));
+                    else
+                        EXPECT_EQ(value, 0.0);
+                }
+    }
+
+    // Vectors are initialized like single rows of matrices
+    void testing_init_vectors()
+    {
+        const rocblas_int N = 1000, incx = 3;
+        host_vector<float> hx(N * incx), hy(N * incx);
+        rocblas_seedrand();
+        rocblas_init(hx, 1, N, incx);
+        rocblas_seedrand();
+        rocblas_init(hy, true);
+        EXPECT_EQ(hx[0], hy[0]);
+        EXPECT_EQ(hx[incx], hy[1]);
+
+        host_strided_batch_vector<float> sx(N, incx, N * incx, 2), sy(N, incx, N * incx, 2);
+        rocblas_init(sx, true);
+        rocblas_init(sy, true);
+        EXPECT_EQ(memcmp(sx.data(), sy.data(), sizeof(float) * N * incx * 2), 0);
+        rocblas_init_nan(sx, true);
+        for(rocblas_int i = 0; i < N; ++i)
+            EXPECT_TRUE(rocblas_isnan(sx[1][i * incx]));
+    }
+
+    // By default, this test does not apply to any types.
+    // The unnamed second parameter is used for enable_if_t below.
+    template <typename, typename = void>
+    struct testing_rocblas_init : rocblas_test_invalid
+    {
+    };
+
+    template <typename T>
+    struct testing_rocblas_init<
+        T,
+        std::enable_if_t<std::is_same<T, float>{} || std::is_same<T, double>{}>>
+        : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            testing_init_thread_invariance<T>(arg);
+            testing_init_vectors();
+        }
+    };
+
+    struct rocblas_init_test : RocBLAS_Test<rocblas_init_test, testing_rocblas_init>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments& arg)
+        {
+            return rocblas_simple_dispatch<type_filter_functor>(arg);
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "rocblas_init");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<rocblas_init_test>(arg.name)
+                   << rocblas_datatype2string(arg.a_type) << '_' << arg.M << '_' << arg.N << '_'
+                   << arg.lda << '_' << arg.batch_count;
+        }
+    };
+
+    TEST_P(rocblas_init_test, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(
+            rocblas_simple_dispatch<testing_rocblas_init>(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(rocblas_init_test)
+
+} // namespace
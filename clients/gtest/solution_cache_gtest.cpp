@@ -0,0 +1,104 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "rocblas.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_datatype2string.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <string>
+
+namespace
+{
+    // Check that repeated gemm problems are served from the solution cache,
+    // and that the statistics can be queried and reset through the handle
+    template <typename...>
+    struct testing_solution_cache : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            rocblas_local_handle handle;
+            rocblas_int          M = arg.M, N = arg.N, K = arg.K;
+            float                alpha = 1, beta = 0;
+
+            rocblas_solution_cache_stats stats;
+            CHECK_ROCBLAS_ERROR(rocblas_get_solution_cache_stats(handle, &stats));
+            if(!stats.capacity)
+                return; // Cache disabled with ROCBLAS_TENSILE_SOLUTION_CACHE_SIZE=0
+
+            device_vector<float> dA(size_t(M) * K), dB(size_t(K) * N), dC(size_t(M) * N);
+            CHECK_DEVICE_ALLOCATION(dA.memcheck());
+            CHECK_DEVICE_ALLOCATION(dB.memcheck());
+            CHECK_DEVICE_ALLOCATION(dC.memcheck());
+
+            CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+            CHECK_ROCBLAS_ERROR(rocblas_clear_solution_cache(handle));
+            CHECK_ROCBLAS_ERROR(rocblas_get_solution_cache_stats(handle, &stats));
+            EXPECT_EQ(stats.hits, size_t(0));
+            EXPECT_EQ(stats.misses, size_t(0));
+            EXPECT_EQ(stats.entries, size_t(0));
+
+            for(int i = 0; i < 3; ++i)
+                CHECK_ROCBLAS_ERROR(rocblas_sgemm(handle,
+                                                  rocblas_operation_none,
+                                                  rocblas_operation_none,
+                                                  M,
+                                                  N,
+                                                  K,
+                                                  &alpha,
+                                                  dA,
+                                                  M,
+                                                  dB,
+                                                  K,
+                                                  &beta,
+                                                  dC,
+                                                  M));
+
+            // Other tests may run gemm on the same device concurrently, so the
+            // counts are lower bounds
+            CHECK_ROCBLAS_ERROR(rocblas_get_solution_cache_stats(handle, &stats));
+            EXPECT_GE(stats.misses, size_t(1));
+            EXPECT_GE(stats.hits, size_t(2));
+            EXPECT_GE(stats.entries, size_t(1));
+            EXPECT_LE(stats.entries, stats.capacity);
+
+            EXPECT_ROCBLAS_STATUS(rocblas_get_solution_cache_stats(nullptr, &stats),
+                                  rocblas_status_invalid_handle);
+            EXPECT_ROCBLAS_STATUS(rocblas_get_solution_cache_stats(handle, nullptr),
+                                  rocblas_status_invalid_pointer);
+            EXPECT_ROCBLAS_STATUS(rocblas_clear_solution_cache(nullptr),
+                                  rocblas_status_invalid_handle);
+        }
+    };
+
+    struct solution_cache : RocBLAS_Test<solution_cache, testing_solution_cache>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "solution_cache");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<solution_cache>(arg.name);
+        }
+    };
+
+    TEST_P(solution_cache, auxiliary_tensile)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_solution_cache<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(solution_cache)
+
+} // namespace
@@ -0,0 +1,314 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_sym_block_plan.hpp"
+#include "cblas_interface.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr rocblas_fill fills[] = {rocblas_fill_lower, rocblas_fill_upper};
+
+    // The diagonal blocks and panels cover the stored triangle once, and nothing else
+    void testing_blocks()
+    {
+        for(rocblas_fill uplo : fills)
+            for(rocblas_int nb : {1, 16, 256})
+                for(rocblas_int n : {1, 5, 16, 17, 256, 257, 1000, 1025})
+                {
+                    std::vector<rocblas_sym_block> diagonal, panels;
+                    rocblas_sym_block_plan::blocks(uplo, n, nb, diagonal, panels);
+                    std::vector<int> covered(size_t(n) * n);
+
+                    rocblas_int next = 0;
+                    for(auto& d : diagonal)
+                    {
+                        EXPECT_EQ(d.row, next);
+                        EXPECT_EQ(d.col, d.row);
+                        EXPECT_EQ(d.rows, d.cols);
+                        EXPECT_TRUE(d.rows == nb || (d.rows < nb && d.row + d.rows == n));
+                        for(rocblas_int j = 0; j < d.rows; ++j)
+                            for(rocblas_int i = 0; i < d.rows; ++i)
+                                if(uplo == rocblas_fill_lower ? i >= j : i <= j)
+                                    ++covered[(d.col + j) * size_t(n) + d.row + i];
+                        next += d.rows;
+                    }
+                    EXPECT_EQ(next, n);
+                    EXPECT_EQ(panels.size(), diagonal.size() - 1);
+
+                    for(auto& p : panels)
+                        for(rocblas_int j = 0; j < p.cols; ++j)
+                            for(rocblas_int i = 0; i < p.rows; ++i)
+                                ++covered[(p.col + j) * size_t(n) + p.row + i];
+
+                    size_t wrong = 0;
+                    for(rocblas_int j = 0; j < n; ++j)
+                        for(rocblas_int i = 0; i < n; ++i)
+                        {
+                            bool stored = uplo == rocblas_fill_lower ? i >= j : i <= j;
+                            wrong += covered[j * size_t(n) + i] != (stored ? 1 : 0);
+                        }
+                    EXPECT_EQ(wrong, size_t(0));
+                }
+    }
+
+    void testing_arch_params()
+    {
+        for(int arch : {0, 906, 908, 910})
+        {
+            auto params = rocblas_sym_blocked_arch_params(arch);
+            EXPECT_GT(params.nb, 0);
+            EXPECT_GT(params.min_n, params.nb);
+            EXPECT_FALSE(rocblas_sym_blocked_use(params, params.min_n - 1));
+            EXPECT_TRUE(rocblas_sym_blocked_use(params, params.min_n));
+        }
+        EXPECT_FALSE(rocblas_sym_blocked_use({0, 0}, 1000));
+        EXPECT_FALSE(rocblas_sym_blocked_use({256, 0}, 256));
+    }
+
+    void testing_offsets_fit()
+    {
+        // The last diagonal element of C is at (n - 1) * (ldc + 1), which fits through n = 46340
+        EXPECT_TRUE(rocblas_sym_blocked_offsets_fit(46340, 0, 46340, 0, 46340, 0, 46340));
+        EXPECT_FALSE(rocblas_sym_blocked_offsets_fit(46341, 0, 46341, 0, 46341, 0, 46341));
+
+        // Each matrix is checked with its own offset and leading dimension
+        rocblas_int n = 1024, ld = 4096, last = (n - 1) * (ld + 1);
+        EXPECT_TRUE(rocblas_sym_blocked_offsets_fit(n, INT_MAX - last, ld, 0, ld, 0, ld));
+        EXPECT_FALSE(rocblas_sym_blocked_offsets_fit(n, INT_MAX - last + 1, ld, 0, ld, 0, ld));
+        EXPECT_FALSE(rocblas_sym_blocked_offsets_fit(n, 0, ld, INT_MAX - last + 1, ld, 0, ld));
+        EXPECT_FALSE(rocblas_sym_blocked_offsets_fit(n, 0, ld, 0, ld, INT_MAX - last + 1, ld));
+        EXPECT_FALSE(rocblas_sym_blocked_offsets_fit(n, 0, ld, 0, INT_MAX / (n - 1), 0, ld));
+    }
+
+    // Run the GEMMs of plan on the host, after diag on each diagonal block
+    template <typename T, typename F>
+    void execute(const rocblas_sym_block_plan& plan,
+                 T                             alpha,
+                 T                             alpha_conj,
+                 T*                            A,
+                 rocblas_int                   lda,
+                 T*                            B,
+                 rocblas_int                   ldb,
+                 T                             beta,
+                 T*                            C,
+                 rocblas_int                   ldc,
+                 F                             diag)
+    {
+        for(auto& d : plan.diagonal())
+            diag(d);
+        for(auto& g : plan.gemms())
+        {
+            bool first_a  = g.first == rocblas_sym_operand::A;
+            bool second_a = g.second == rocblas_sym_operand::A;
+            cblas_gemm<T>(g.trans_a,
+                          g.trans_b,
+                          g.m,
+                          g.n,
+                          g.k,
+                          g.conj_alpha ? alpha_conj : alpha,
+                          (first_a ? A : B) + g.offset_first,
+                          first_a ? lda : ldb,
+                          (second_a ? A : B) + g.offset_second,
+                          second_a ? lda : ldb,
+                          g.accumulate ? T(1) : beta,
+                          C + g.offset_c,
+                          ldc);
+        }
+    }
+
+    // Number of elements of the uplo triangle of the n x n C, or of all of C if uplo is
+    // rocblas_fill_full, which differ from gold
+    template <typename T>
+    size_t mismatches(rocblas_fill          uplo,
+                      rocblas_int           m,
+                      rocblas_int           n,
+                      const std::vector<T>& C,
+                      const std::vector<T>& gold,
+                      rocblas_int           ldc)
+    {
+        size_t wrong = 0;
+        for(rocblas_int j = 0; j < n; ++j)
+            for(rocblas_int i = 0; i < m; ++i)
+                if(uplo == rocblas_fill_full || (uplo == rocblas_fill_lower ? i >= j : i <= j))
+                    wrong += !(C[j * size_t(ldc) + i] == gold[j * size_t(ldc) + i]);
+        return wrong;
+    }
+
+    template <typename T>
+    T scalar(double re, double im)
+    {
+        if constexpr(is_complex<T>)
+            return T(re, im);
+        else
+            return T(re);
+    }
+
+    // The values are small integers, so the blocked results equal the reference exactly
+    template <typename T, bool HERM>
+    void testing_rank_k(bool twok)
+    {
+        using S = std::conditional_t<HERM, real_t<T>, T>;
+
+        const rocblas_int n = 75, k = 9, nb = 16, ldc = n + 1;
+        const S           beta = -1;
+
+        // HERK takes a real alpha
+        const T alpha      = HERM && !twok ? T(2) : scalar<T>(2, 1);
+        const T alpha_conj = HERM && !twok ? T(2) : scalar<T>(2, HERM ? -1 : 1);
+
+        for(rocblas_fill uplo : fills)
+            for(rocblas_operation trans :
+                {rocblas_operation_none,
+                 HERM ? rocblas_operation_conjugate_transpose : rocblas_operation_transpose})
+            {
+                bool           none = trans == rocblas_operation_none;
+                rocblas_int    lda = none ? n + 3 : k + 2, ldb = none ? n + 2 : k + 1;
+                std::vector<T> A(size_t(lda) * (none ? k : n)), B(size_t(ldb) * (none ? k : n));
+                std::vector<T> C(size_t(ldc) * n), gold;
+                rocblas_seedrand();
+                rocblas_init(A.data(), none ? n : k, none ? k : n, lda);
+                rocblas_init(B.data(), none ? n : k, none ? k : n, ldb);
+                rocblas_init(C.data(), n, n, ldc);
+                gold = C;
+
+                // SYRK and HERK multiply A by itself
+                T*          BP    = twok ? B.data() : A.data();
+                rocblas_int ldb_p = twok ? ldb : lda;
+
+                auto reference = [&](rocblas_int nn, T* a, T* b, T* c) {
+                    if constexpr(HERM)
+                    {
+                        if(twok)
+                            cblas_her2k(uplo, trans, nn, k, &alpha, a, lda, b, ldb, &beta, c, ldc);
+                        else
+                            cblas_herk(uplo, trans, nn, k, real_t<T>(2), a, lda, beta, c, ldc);
+                    }
+                    else
+                    {
+                        if(twok)
+                            cblas_syr2k(uplo, trans, nn, k, alpha, a, lda, b, ldb, beta, c, ldc);
+                        else
+                            cblas_syrk(uplo, trans, nn, k, alpha, a, lda, beta, c, ldc);
+                    }
+                };
+
+                reference(n, A.data(), BP, gold.data());
+
+                auto plan = rocblas_sym_block_plan::rank_k(
+                    uplo, trans, n, k, lda, ldb_p, ldc, nb, HERM, twok);
+                execute(plan,
+                        alpha,
+                        alpha_conj,
+                        A.data(),
+                        lda,
+                        BP,
+                        ldb_p,
+                        T(beta),
+                        C.data(),
+                        ldc,
+                        [&](const rocblas_sym_diag_call& d) {
+                            EXPECT_EQ(d.m, d.n);
+                            reference(d.n, &A[d.offset_a], BP + d.offset_b, &C[d.offset_c]);
+                        });
+                EXPECT_EQ(mismatches(uplo, n, n, C, gold, ldc), size_t(0));
+            }
+    }
+
+    template <typename T, bool HERM>
+    void testing_symm()
+    {
+        const rocblas_int m = 70, n = 45, nb = 16, ldb = m + 1, ldc = m + 2;
+        const T           alpha = scalar<T>(2, 1), beta = scalar<T>(-1, 2);
+
+        for(rocblas_side side : {rocblas_side_left, rocblas_side_right})
+            for(rocblas_fill uplo : fills)
+            {
+                rocblas_int    ka  = side == rocblas_side_left ? m : n;
+                rocblas_int    lda = ka + 3;
+                std::vector<T> A(size_t(lda) * ka), B(size_t(ldb) * n), C(size_t(ldc) * n), gold;
+                rocblas_seedrand();
+                rocblas_init(A.data(), ka, ka, lda);
+                rocblas_init(B.data(), m, n, ldb);
+                rocblas_init(C.data(), m, n, ldc);
+                gold = C;
+
+                auto reference = [&](rocblas_int mm, rocblas_int nn, T* a, T* b, T* c) {
+                    if constexpr(HERM)
+                        cblas_hemm(side, uplo, mm, nn, &alpha, a, lda, b, ldb, &beta, c, ldc);
+                    else
+                        cblas_symm(side, uplo, mm, nn, alpha, a, lda, b, ldb, beta, c, ldc);
+                };
+
+                reference(m, n, A.data(), B.data(), gold.data());
+
+                auto plan
+                    = rocblas_sym_block_plan::symm(side, uplo, m, n, lda, ldb, ldc, nb, HERM);
+                execute(plan,
+                        alpha,
+                        alpha,
+                        A.data(),
+                        lda,
+                        B.data(),
+                        ldb,
+                        beta,
+                        C.data(),
+                        ldc,
+                        [&](const rocblas_sym_diag_call& d) {
+                            reference(d.m, d.n, &A[d.offset_a], &B[d.offset_b], &C[d.offset_c]);
+                        });
+                EXPECT_EQ(mismatches(rocblas_fill_full, m, n, C, gold, ldc), size_t(0));
+            }
+    }
+
+    template <typename...>
+    struct testing_sym_block_plan : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            testing_blocks();
+            testing_arch_params();
+            testing_offsets_fit();
+            testing_rank_k<double, false>(false);
+            testing_rank_k<double, false>(true);
+            testing_rank_k<rocblas_double_complex, true>(false);
+            testing_rank_k<rocblas_double_complex, true>(true);
+            testing_symm<double, false>();
+            testing_symm<rocblas_double_complex, true>();
+        }
+    };
+
+    struct sym_block_plan : RocBLAS_Test<sym_block_plan, testing_sym_block_plan>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "sym_block_plan");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<sym_block_plan>(arg.name);
+        }
+    };
+
+    TEST_P(sym_block_plan, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_sym_block_plan<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(sym_block_plan)
+
+} // namespace
@@ -0,0 +1,371 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_host_result_staging.hpp"
+#include "../../library/src/include/rocblas_sync_points.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Host backend which records the calls made through the interceptor. Streams and
+    // events are integers, and copies are plain memcpys.
+    struct host_sync_backend
+    {
+        using stream_t    = int;
+        using event_t     = int;
+        using copy_kind_t = int;
+
+        struct state_t
+        {
+            std::vector<std::string> calls;
+            rocblas_status           status = rocblas_status_success;
+        };
+        std::shared_ptr<state_t> state = std::make_shared<state_t>();
+
+        rocblas_status copy(void* dst, const void* src, size_t size, int)
+        {
+            state->calls.push_back("copy");
+            memcpy(dst, src, size);
+            return state->status;
+        }
+
+        rocblas_status stream_synchronize(int)
+        {
+            state->calls.push_back("stream_synchronize");
+            return state->status;
+        }
+
+        rocblas_status event_synchronize(int)
+        {
+            state->calls.push_back("event_synchronize");
+            return state->status;
+        }
+
+        rocblas_status device_allocate(void** ptr, size_t size)
+        {
+            state->calls.push_back("device_allocate");
+            *ptr = malloc(size);
+            return state->status;
+        }
+
+        rocblas_status device_free(void* ptr)
+        {
+            state->calls.push_back("device_free");
+            free(ptr);
+            return state->status;
+        }
+
+        rocblas_status host_allocate(void** ptr, size_t size)
+        {
+            state->calls.push_back("host_allocate");
+            *ptr = malloc(size);
+            return state->status;
+        }
+
+        rocblas_status host_free(void* ptr)
+        {
+            state->calls.push_back("host_free");
+            free(ptr);
+            return state->status;
+        }
+    };
+
+    using host_sync = rocblas_sync_interceptor<host_sync_backend>;
+
+    // Host result backend which, like the library's, allocates and synchronizes through
+    // an interceptor. Copies run at once, and completions when the stream is synchronized.
+    struct host_result_sync_backend
+    {
+        using stream_t = int;
+
+        host_sync*                             sync;
+        std::vector<rocblas_host_result_slot*> queued;
+
+        void* allocate(size_t size)
+        {
+            void* ptr = nullptr;
+            return sync->host_allocate(&ptr, size) == rocblas_status_success ? ptr : nullptr;
+        }
+
+        void deallocate(void* ptr)
+        {
+            free(ptr);
+        }
+
+        rocblas_status copy_async(void* dst, const void* src, size_t size, int)
+        {
+            memcpy(dst, src, size);
+            return rocblas_status_success;
+        }
+
+        rocblas_status synchronize(int stream)
+        {
+            rocblas_status status = sync->stream_synchronize(stream);
+            if(status == rocblas_status_success)
+            {
+                for(auto* slot : queued)
+                    rocblas_host_result_slot::complete(slot);
+                queued.clear();
+            }
+            return status;
+        }
+
+        rocblas_status enqueue(int, rocblas_host_result_slot* slot)
+        {
+            queued.push_back(slot);
+            return rocblas_status_success;
+        }
+    };
+
+    void testing_sync_point_counting()
+    {
+        host_sync_backend backend;
+        host_sync         sync(backend);
+
+        int   src = 3, dst = 0;
+        void* ptr = nullptr;
+        EXPECT_EQ(sync.copy(&dst, &src, sizeof(int), 0), rocblas_status_success);
+        EXPECT_EQ(dst, 3);
+        EXPECT_EQ(sync.stream_synchronize(1), rocblas_status_success);
+        EXPECT_EQ(sync.stream_synchronize(2), rocblas_status_success);
+        EXPECT_EQ(sync.event_synchronize(1), rocblas_status_success);
+        EXPECT_EQ(sync.device_allocate(&ptr, 64), rocblas_status_success);
+        EXPECT_EQ(sync.device_free(ptr), rocblas_status_success);
+        EXPECT_EQ(sync.host_allocate(&ptr, 64), rocblas_status_success);
+        EXPECT_EQ(sync.host_free(ptr), rocblas_status_success);
+        EXPECT_EQ(sync.check(), rocblas_status_success);
+
+        auto& counts = sync.counts();
+        EXPECT_EQ(counts.copies, size_t(1));
+        EXPECT_EQ(counts.stream_syncs, size_t(2));
+        EXPECT_EQ(counts.event_syncs, size_t(1));
+        EXPECT_EQ(counts.allocations, size_t(2));
+        EXPECT_EQ(counts.frees, size_t(2));
+        EXPECT_EQ(counts.refused, size_t(0));
+        EXPECT_EQ(backend.state->calls.size(), size_t(8));
+
+        // Failed calls are still counted, and their status returned
+        backend.state->status = rocblas_status_memory_error;
+        EXPECT_EQ(sync.stream_synchronize(1), rocblas_status_memory_error);
+        EXPECT_EQ(counts.stream_syncs, size_t(3));
+
+        sync.reset_counts();
+        EXPECT_EQ(counts.copies + counts.stream_syncs + counts.event_syncs + counts.allocations
+                      + counts.frees + counts.refused,
+                  size_t(0));
+    }
+
+    void testing_capture_safe_refusal()
+    {
+        host_sync_backend backend;
+        host_sync         sync(backend);
+        EXPECT_FALSE(sync.capture_safe());
+
+        // In capture-safe mode nothing reaches the backend
+        sync.set_capture_safe(true);
+        EXPECT_TRUE(sync.capture_safe());
+        int   src = 3, dst = 0;
+        void* ptr = &dst;
+        EXPECT_EQ(sync.copy(&dst, &src, sizeof(int), 0), rocblas_status_capture_unsafe);
+        EXPECT_EQ(dst, 0);
+        EXPECT_EQ(sync.stream_synchronize(1), rocblas_status_capture_unsafe);
+        EXPECT_EQ(sync.event_synchronize(1), rocblas_status_capture_unsafe);
+        EXPECT_EQ(sync.device_allocate(&ptr, 64), rocblas_status_capture_unsafe);
+        EXPECT_EQ(ptr, (void*)&dst);
+        EXPECT_EQ(sync.device_free(ptr), rocblas_status_capture_unsafe);
+        EXPECT_EQ(sync.host_allocate(&ptr, 64), rocblas_status_capture_unsafe);
+        EXPECT_EQ(sync.host_free(ptr), rocblas_status_capture_unsafe);
+        EXPECT_EQ(sync.check(), rocblas_status_capture_unsafe);
+        EXPECT_TRUE(backend.state->calls.empty());
+
+        auto& counts = sync.counts();
+        EXPECT_EQ(counts.refused, size_t(8));
+        EXPECT_EQ(counts.copies + counts.stream_syncs + counts.event_syncs + counts.allocations
+                      + counts.frees,
+                  size_t(0));
+
+        sync.set_capture_safe(false);
+        EXPECT_EQ(sync.copy(&dst, &src, sizeof(int), 0), rocblas_status_success);
+        EXPECT_EQ(dst, 3);
+        EXPECT_EQ(counts.copies, size_t(1));
+    }
+
+    // Host results need no sync points in capture-safe mode once deferred, and once
+    // the slots they use exist
+    void testing_capture_safe_host_results()
+    {
+        host_sync_backend                                     backend;
+        host_sync                                             sync(backend);
+        rocblas_host_result_staging<host_result_sync_backend> staging(
+            host_result_sync_backend{&sync, {}});
+
+        float src = 2, dst = 0;
+        sync.set_capture_safe(true);
+        EXPECT_EQ(staging.copy(&dst, &src, sizeof(float), 1, true), rocblas_status_memory_error);
+        EXPECT_EQ(sync.counts().refused, size_t(1));
+        EXPECT_EQ(staging.slots(), size_t(0));
+
+        // A blocking copy allocates the slot and waits
+        sync.set_capture_safe(false);
+        EXPECT_EQ(staging.copy(&dst, &src, sizeof(float), 1, false), rocblas_status_success);
+        EXPECT_EQ(dst, 2.0f);
+        EXPECT_EQ(sync.counts().allocations, size_t(1));
+        EXPECT_EQ(sync.counts().stream_syncs, size_t(1));
+
+        sync.set_capture_safe(true);
+        sync.reset_counts();
+        src = 4;
+        EXPECT_EQ(staging.copy(&dst, &src, sizeof(float), 1, true), rocblas_status_success);
+        EXPECT_EQ(dst, 2.0f);
+        EXPECT_EQ(sync.counts().allocations + sync.counts().stream_syncs + sync.counts().refused,
+                  size_t(0));
+
+        // The slot is busy until the stream is synchronized, outside of capture
+        sync.set_capture_safe(false);
+        EXPECT_EQ(staging.synchronize(), rocblas_status_success);
+        EXPECT_EQ(dst, 4.0f);
+        EXPECT_EQ(staging.pending(), size_t(0));
+    }
+
+    void testing_capture_mode_api()
+    {
+        rocblas_local_handle handle;
+        rocblas_capture_mode mode;
+
+        CHECK_ROCBLAS_ERROR(rocblas_get_capture_mode(handle, &mode));
+        EXPECT_EQ(mode, rocblas_capture_default);
+        CHECK_ROCBLAS_ERROR(rocblas_set_capture_mode(handle, rocblas_capture_safe));
+        CHECK_ROCBLAS_ERROR(rocblas_get_capture_mode(handle, &mode));
+        EXPECT_EQ(mode, rocblas_capture_safe);
+        CHECK_ROCBLAS_ERROR(rocblas_set_capture_mode(handle, rocblas_capture_default));
+
+        EXPECT_ROCBLAS_STATUS(rocblas_set_capture_mode(nullptr, rocblas_capture_safe),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_set_capture_mode(handle, rocblas_capture_mode(2)),
+                              rocblas_status_invalid_value);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_capture_mode(nullptr, &mode),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_capture_mode(handle, nullptr),
+                              rocblas_status_invalid_pointer);
+
+        rocblas_sync_point_counts counts;
+        EXPECT_ROCBLAS_STATUS(rocblas_get_sync_point_counts(nullptr, &counts),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_sync_point_counts(handle, nullptr),
+                              rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(rocblas_reset_sync_point_counts(nullptr),
+                              rocblas_status_invalid_handle);
+    }
+
+    // The sync points of single calls, and their refusal in capture-safe mode
+    void testing_capture_safe_calls(const Arguments& arg)
+    {
+        const rocblas_int N = arg.N;
+
+        rocblas_local_handle handle;
+        hipStream_t          stream;
+        CHECK_HIP_ERROR(hipStreamCreate(&stream));
+        CHECK_ROCBLAS_ERROR(rocblas_set_stream(handle, stream));
+
+        host_vector<float> hx(N), hy(N);
+        for(rocblas_int i = 0; i < N; ++i)
+        {
+            hx[i] = float(i % 7 - 3);
+            hy[i] = float(i % 5 - 2);
+        }
+        device_vector<float> dx(N), dy(N);
+        CHECK_DEVICE_ALLOCATION(dx.memcheck());
+        CHECK_DEVICE_ALLOCATION(dy.memcheck());
+        CHECK_HIP_ERROR(dx.transfer_from(hx));
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+
+        // A blocking dot in host pointer mode waits for the stream once
+        rocblas_sync_point_counts counts;
+        float                     blocking = 0, deferred = 0;
+        CHECK_ROCBLAS_ERROR(rocblas_reset_sync_point_counts(handle));
+        CHECK_ROCBLAS_ERROR(rocblas_sdot(handle, N, dx, 1, dy, 1, &blocking));
+        CHECK_ROCBLAS_ERROR(rocblas_get_sync_point_counts(handle, &counts));
+        EXPECT_EQ(counts.stream_syncs, size_t(1));
+        EXPECT_EQ(counts.copies, size_t(0));
+        EXPECT_EQ(counts.refused, size_t(0));
+
+        // In capture-safe mode it is refused, and a deferred one makes no sync points
+        CHECK_ROCBLAS_ERROR(rocblas_set_capture_mode(handle, rocblas_capture_safe));
+        CHECK_ROCBLAS_ERROR(rocblas_reset_sync_point_counts(handle));
+        EXPECT_ROCBLAS_STATUS(rocblas_sdot(handle, N, dx, 1, dy, 1, &deferred),
+                              rocblas_status_capture_unsafe);
+        CHECK_ROCBLAS_ERROR(rocblas_get_sync_point_counts(handle, &counts));
+        EXPECT_EQ(counts.refused, size_t(1));
+
+        CHECK_ROCBLAS_ERROR(rocblas_set_host_result_mode(handle, rocblas_host_result_deferred));
+        CHECK_ROCBLAS_ERROR(rocblas_reset_sync_point_counts(handle));
+        CHECK_ROCBLAS_ERROR(rocblas_sdot(handle, N, dx, 1, dy, 1, &deferred));
+        CHECK_ROCBLAS_ERROR(rocblas_get_sync_point_counts(handle, &counts));
+        EXPECT_EQ(counts.copies + counts.stream_syncs + counts.event_syncs + counts.allocations
+                      + counts.frees,
+                  size_t(0));
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        EXPECT_EQ(deferred, blocking);
+
+        // rotg in host pointer mode computes on the host after waiting for the stream
+        float  a = 1, b = 2, c = 0, s = 0;
+        float *pa[1] = {&a}, *pb[1] = {&b}, *pc[1] = {&c}, *ps[1] = {&s};
+        EXPECT_ROCBLAS_STATUS(rocblas_srotg_batched(handle, pa, pb, pc, ps, 1),
+                              rocblas_status_capture_unsafe);
+        EXPECT_EQ(a, 1.0f);
+
+        CHECK_ROCBLAS_ERROR(rocblas_set_capture_mode(handle, rocblas_capture_default));
+        CHECK_ROCBLAS_ERROR(rocblas_set_host_result_mode(handle, rocblas_host_result_blocking));
+        CHECK_ROCBLAS_ERROR(rocblas_set_stream(handle, 0));
+        CHECK_HIP_ERROR(hipStreamDestroy(stream));
+    }
+
+    template <typename...>
+    struct testing_sync_points : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            testing_sync_point_counting();
+            testing_capture_safe_refusal();
+            testing_capture_safe_host_results();
+            testing_capture_mode_api();
+            testing_capture_safe_calls(arg);
+        }
+    };
+
+    struct sync_points : RocBLAS_Test<sync_points, testing_sync_points>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "sync_points");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<sync_points>(arg.name) << arg.N;
+        }
+    };
+
+    TEST_P(sync_points, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_sync_points<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(sync_points)
+
+} // namespace
@@ -0,0 +1,210 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "rocblas_test.hpp"
+#include "tensile_logic_index.hpp"
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // The start of a logic file, with the items which are not read elided
+    const char* logic_file = R"(---
+- {MinimumRequiredVersion: 4.2.0}
+- aldebaran
+- gfx90a
+- [Device 0050, Device 0051]
+- {Batched: true, DataType: 4}
+- - {KernelName: Cijk_Ailk_Bjlk_HBH_MT64x64x16}
+  - {KernelName: Cijk_Ailk_Bjlk_HBH_MT128x128x16}
+- [2, 3, 0, 1]
+- - - [1024, 1024, 1, 1024]
+    - [1, 90000.5]
+  - - [64, 64, 1, 64, 64, 64, 64, 64]
+    - [0, 1000.0]
+  - - [64, 64, 1, 64]
+    - [1, 1500.0]
+  - - [4096, 128, 4, 256]
+    - [0, 30000.0]
+- null
+)";
+
+    const char* empty_logic_file = R"(- {MinimumRequiredVersion: 4.2.0}
+- arcturus
+- gfx908
+- [Device 738c]
+- {Batched: true, DataType: 0}
+- []
+- [2, 3, 0, 1]
+- []
+- null
+)";
+
+    void testing_logic_parse()
+    {
+        std::istringstream is(logic_file);
+        auto table = tensile_logic_parse(is, "Logic/asm_full/aldebaran_Cijk_Ailk_Bjlk_HBH.yaml");
+        EXPECT_EQ(table.arch, "aldebaran");
+        EXPECT_EQ(table.gfx, "gfx90a");
+        EXPECT_EQ(table.problem, "Cijk_Ailk_Bjlk_HBH");
+        ASSERT_EQ(table.entries.size(), size_t(4));
+        EXPECT_EQ(table.entries[0].m, 1024u);
+        EXPECT_EQ(table.entries[0].solution, 1);
+        EXPECT_FLOAT_EQ(table.entries[0].gflops, 90000.5f);
+        EXPECT_EQ(table.entries[3].n, 128u);
+        EXPECT_EQ(table.entries[3].batch, 4u);
+        EXPECT_EQ(table.entries[3].k, 256u);
+
+        std::istringstream empty(empty_logic_file);
+        EXPECT_TRUE(tensile_logic_parse(empty, "arcturus_Cijk_Ailk_Bljk_SB.yaml").entries.empty());
+
+        std::istringstream truncated("- {MinimumRequiredVersion: 4.2.0}\n- aldebaran\n");
+        EXPECT_THROW(tensile_logic_parse(truncated, "aldebaran_Cijk_Ailk_Bljk_SB.yaml"),
+                     std::runtime_error);
+        std::istringstream unnamed(logic_file);
+        EXPECT_THROW(tensile_logic_parse(unnamed, "logic.yaml"), std::runtime_error);
+    }
+
+    void testing_logic_index()
+    {
+        std::istringstream is(logic_file), empty(empty_logic_file);
+        std::vector<tensile_logic_table> tables;
+        tables.push_back(tensile_logic_parse(is, "aldebaran_Cijk_Ailk_Bjlk_HBH.yaml"));
+        tables.push_back(tensile_logic_parse(empty, "arcturus_Cijk_Ailk_Bljk_SB.yaml"));
+
+        std::ostringstream os;
+        tensile_logic_index_write(tables, os);
+        std::string         data = os.str();
+        tensile_logic_index index(data.data(), data.size());
+        ASSERT_EQ(index.tables().size(), size_t(2));
+
+        EXPECT_EQ(index.find("gfx908", "Cijk_Ailk_Bjlk_HBH"), nullptr);
+        EXPECT_EQ(index.find("gfx90a", "Cijk_Ailk_Bjlk_HBH_GB"), nullptr);
+        auto table = index.find("gfx90a", "Cijk_Ailk_Bjlk_HBH");
+        ASSERT_NE(table, nullptr);
+        EXPECT_EQ(index.find("aldebaran", "Cijk_Ailk_Bjlk_HBH"), table);
+
+        // The two 64^3 sizes, which differ only in leading dimensions, are one
+        // entry with the most GFLOPS
+        EXPECT_EQ(table->count, size_t(3));
+
+        using kind = tensile_logic_index::match_kind;
+        auto match = tensile_logic_index::lookup(*table, 64, 64, 1, 64);
+        EXPECT_EQ(match.kind, kind::exact);
+        ASSERT_NE(match.entry, nullptr);
+        EXPECT_EQ(match.entry->solution, 1);
+        EXPECT_FLOAT_EQ(match.entry->gflops, 1500.0f);
+
+        match = tensile_logic_index::lookup(*table, 4096, 128, 4, 256);
+        EXPECT_EQ(match.kind, kind::exact);
+
+        match = tensile_logic_index::lookup(*table, 1000, 1000, 1, 1000);
+        EXPECT_EQ(match.kind, kind::fallback);
+        ASSERT_NE(match.entry, nullptr);
+        EXPECT_EQ(match.entry->m, 1024u);
+
+        match = tensile_logic_index::lookup(*table, 3000, 128, 4, 256);
+        EXPECT_EQ(match.kind, kind::fallback);
+        ASSERT_NE(match.entry, nullptr);
+        EXPECT_EQ(match.entry->m, 4096u);
+
+        auto empty_table = index.find("gfx908", "Cijk_Ailk_Bljk_SB");
+        ASSERT_NE(empty_table, nullptr);
+        EXPECT_EQ(tensile_logic_index::lookup(*empty_table, 64, 64, 1, 64).kind, kind::none);
+
+        // Truncated or corrupt indices are rejected
+        EXPECT_THROW(tensile_logic_index(data.data(), data.size() - 1), std::runtime_error);
+        std::string corrupt = data;
+        corrupt[0]          = 'x';
+        EXPECT_THROW(tensile_logic_index(corrupt.data(), corrupt.size()), std::runtime_error);
+    }
+
+    void testing_logic_parse_bench()
+    {
+        tensile_logic_query q;
+
+        ASSERT_TRUE(tensile_logic_parse_bench(
+            "./rocblas-bench -f gemm_ex --transposeA N --transposeB T -m 1024 -n 512 -k 256 "
+            "--alpha 1 --a_type f16_r --lda 1024 --b_type f16_r --ldb 512 --beta 0 --c_type "
+            "f16_r --ldc 1024 --d_type f16_r --ldd 1024 --compute_type f32_r --algo 0",
+            q));
+        EXPECT_EQ(q.problem, "Cijk_Ailk_Bjlk_HBH");
+        EXPECT_EQ(q.m, 1024u);
+        EXPECT_EQ(q.n, 512u);
+        EXPECT_EQ(q.k, 256u);
+        EXPECT_EQ(q.batch, 1u);
+
+        ASSERT_TRUE(tensile_logic_parse_bench(
+            "./rocblas-bench -f gemm_batched_ex --transposeA T --transposeB N -m 64 -n 64 -k 32 "
+            "--a_type bf16_r --b_type bf16_r --c_type bf16_r --d_type bf16_r --compute_type "
+            "f32_r --batch_count 10",
+            q));
+        EXPECT_EQ(q.problem, "Cijk_Alik_Bljk_BBH_GB");
+        EXPECT_EQ(q.batch, 10u);
+
+        ASSERT_TRUE(tensile_logic_parse_bench(
+            "./rocblas-bench -f gemm_strided_batched_ex --transposeA N --transposeB N -m 16 -n 16 "
+            "-k 64 --a_type i8_r --b_type i8_r --c_type i32_r --d_type i32_r --compute_type "
+            "i32_r --batch_count 2 --flags 1",
+            q));
+        EXPECT_EQ(q.problem, "Cijk_Ailk_Bljk_4xi8BH");
+
+        ASSERT_TRUE(tensile_logic_parse_bench(
+            "./rocblas-bench -f gemm -r f32_c --transposeA C --transposeB T -m 8 -n 8 -k 8", q));
+        EXPECT_EQ(q.problem, "Cijk_AlikC_Bjlk_CB");
+
+        ASSERT_TRUE(tensile_logic_parse_bench(
+            "./rocblas-bench -f gemm -r s --transposeA C --transposeB N -m 8 -n 8 -k 8 "
+            "--batch_count 5",
+            q));
+        EXPECT_EQ(q.problem, "Cijk_Alik_Bljk_SB");
+        EXPECT_EQ(q.batch, 1u);
+
+        EXPECT_FALSE(tensile_logic_parse_bench("./rocblas-bench -f gemv -r s -m 8 -n 8", q));
+        EXPECT_FALSE(tensile_logic_parse_bench("rocblas_sgemm,N,N,8,8,8", q));
+        EXPECT_FALSE(tensile_logic_parse_bench("./rocblas-bench -f gemm -r s -m -1", q));
+    }
+
+    template <typename...>
+    struct testing_tensile_logic_index : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            testing_logic_parse();
+            testing_logic_index();
+            testing_logic_parse_bench();
+        }
+    };
+
+    struct tensile_logic_index_test
+        : RocBLAS_Test<tensile_logic_index_test, testing_tensile_logic_index>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "tensile_logic_index");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<tensile_logic_index_test>(arg.name);
+        }
+    };
+
+    TEST_P(tensile_logic_index_test, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_tensile_logic_index<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(tensile_logic_index_test)
+
+} // namespace
@@ -0,0 +1,303 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_timeline.hpp"
+#include "rocblas_test.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Events of a host-only GPU, which completes them when told to, or when synchronized
+    struct fake_gpu
+    {
+        enum state_t
+        {
+            created,
+            recorded,
+            complete,
+            destroyed,
+        };
+
+        std::vector<state_t> events;
+        std::vector<double>  recorded_us;
+        double               now_us       = 0;
+        uint64_t             clock_ns     = 0;
+        bool                 fail_records = false;
+        size_t               syncs        = 0;
+
+        void complete_all()
+        {
+            for(auto& e : events)
+                if(e == recorded)
+                    e = complete;
+        }
+
+        size_t count(state_t state) const
+        {
+            return std::count(events.begin(), events.end(), state);
+        }
+    };
+
+    struct fake_backend
+    {
+        using event_t  = size_t;
+        using stream_t = const void*;
+
+        fake_gpu* gpu;
+
+        bool create(size_t& event)
+        {
+            event = gpu->events.size();
+            gpu->events.push_back(fake_gpu::created);
+            gpu->recorded_us.push_back(0);
+            return true;
+        }
+
+        void destroy(size_t event)
+        {
+            gpu->events[event] = fake_gpu::destroyed;
+        }
+
+        bool record(size_t event, const void*)
+        {
+            if(gpu->fail_records)
+                return false;
+            gpu->events[event]      = fake_gpu::recorded;
+            gpu->recorded_us[event] = gpu->now_us;
+            return true;
+        }
+
+        int query(size_t event)
+        {
+            return gpu->events[event] == fake_gpu::complete   ? 1
+                   : gpu->events[event] == fake_gpu::recorded ? 0
+                                                              : -1;
+        }
+
+        bool elapsed_us(size_t start, size_t stop, double& us)
+        {
+            us = gpu->recorded_us[stop] - gpu->recorded_us[start];
+            return true;
+        }
+
+        void synchronize(size_t event)
+        {
+            gpu->syncs += 1;
+            if(gpu->events[event] == fake_gpu::recorded)
+                gpu->events[event] = fake_gpu::complete;
+        }
+
+        uint64_t now_ns()
+        {
+            return gpu->clock_ns;
+        }
+    };
+
+    using fake_recorder = rocblas_timeline_recorder<fake_backend>;
+
+    const void* const stream_a = reinterpret_cast<const void*>(0x10);
+    const void* const stream_b = reinterpret_cast<const void*>(0x20);
+
+    // Makes a call of function on stream taking gpu_us on the GPU
+    void call(fake_gpu&      gpu,
+              fake_recorder& recorder,
+              const char*    function,
+              const void*    stream,
+              double         gpu_us)
+    {
+        auto t = recorder.begin(function, stream);
+        gpu.clock_ns += 1000;
+        gpu.now_us += gpu_us;
+        recorder.end(t);
+    }
+
+    // Pairs are taken from the pool until max_pairs are in flight, and returned to it as
+    // calls complete, in order
+    void testing_pool()
+    {
+        fake_gpu                           gpu;
+        std::vector<rocblas_timeline_call> written;
+        {
+            fake_recorder recorder(
+                fake_backend{&gpu},
+                [&](const rocblas_timeline_call& c) { written.push_back(c); },
+                true,
+                2);
+
+            call(gpu, recorder, "a", stream_a, 5);
+            call(gpu, recorder, "b", stream_b, 7);
+            EXPECT_EQ(recorder.pairs(), size_t(2));
+            EXPECT_EQ(recorder.free_pairs(), size_t(0));
+
+            // No pair is free, so c is not timed on the GPU, and waits behind a and b
+            call(gpu, recorder, "c", stream_a, 3);
+            EXPECT_TRUE(written.empty());
+
+            // a and b complete, so they are written, with c, when d takes one of their pairs
+            gpu.complete_all();
+            call(gpu, recorder, "d", stream_a, 2);
+            EXPECT_EQ(recorder.pairs(), size_t(2));
+            EXPECT_EQ(recorder.free_pairs(), size_t(1));
+            ASSERT_EQ(written.size(), size_t(3));
+            EXPECT_STREQ(written[0].function, "a");
+            EXPECT_EQ(written[0].gpu_us, 5.0);
+            EXPECT_EQ(written[0].stream, stream_a);
+            EXPECT_EQ(written[0].end_ns - written[0].begin_ns, uint64_t(1000));
+            EXPECT_STREQ(written[1].function, "b");
+            EXPECT_EQ(written[1].gpu_us, 7.0);
+            EXPECT_EQ(written[1].stream, stream_b);
+            EXPECT_STREQ(written[2].function, "c");
+            EXPECT_LT(written[2].gpu_us, 0);
+
+            // Flushing waits for d
+            recorder.flush();
+            ASSERT_EQ(written.size(), size_t(4));
+            EXPECT_STREQ(written[3].function, "d");
+            EXPECT_EQ(written[3].gpu_us, 2.0);
+            EXPECT_EQ(gpu.syncs, size_t(1));
+            EXPECT_EQ(recorder.free_pairs(), size_t(2));
+
+            // Pairs are reused rather than created
+            for(int i = 0; i < 10; ++i)
+            {
+                call(gpu, recorder, "e", stream_a, 1);
+                gpu.complete_all();
+            }
+            EXPECT_EQ(recorder.pairs(), size_t(2));
+            EXPECT_EQ(gpu.events.size(), size_t(4));
+            EXPECT_EQ(written.size(), size_t(13));
+        }
+
+        // Destruction writes the last call, and destroys the events
+        EXPECT_EQ(written.size(), size_t(14));
+        EXPECT_EQ(gpu.count(fake_gpu::destroyed), size_t(4));
+    }
+
+    // Calls are written without a GPU time when GPU timing is off for the recorder or the
+    // call, or an event cannot be recorded, without waiting
+    void testing_untimed()
+    {
+        fake_gpu                           gpu;
+        std::vector<rocblas_timeline_call> written;
+        auto sink = [&](const rocblas_timeline_call& c) { written.push_back(c); };
+
+        fake_recorder off(fake_backend{&gpu}, sink, false);
+        call(gpu, off, "a", stream_a, 1);
+        EXPECT_EQ(off.pairs(), size_t(0));
+
+        fake_recorder on(fake_backend{&gpu}, sink, true);
+        auto          t = on.begin("b", stream_a, false);
+        on.end(t);
+        EXPECT_EQ(on.pairs(), size_t(0));
+
+        gpu.fail_records = true;
+        call(gpu, on, "c", stream_a, 1);
+        EXPECT_EQ(on.pairs(), size_t(1));
+        EXPECT_EQ(on.free_pairs(), size_t(1));
+
+        ASSERT_EQ(written.size(), size_t(3));
+        for(auto& c : written)
+            EXPECT_LT(c.gpu_us, 0);
+        EXPECT_EQ(gpu.syncs, size_t(0));
+    }
+
+    // Threads are numbered from 1, differently
+    void testing_threads()
+    {
+        uint64_t main_thread = rocblas_timeline_thread(), other_thread = 0;
+        std::thread([&] { other_thread = rocblas_timeline_thread(); }).join();
+        EXPECT_GE(main_thread, uint64_t(1));
+        EXPECT_GE(other_thread, uint64_t(1));
+        EXPECT_NE(main_thread, other_thread);
+        EXPECT_EQ(rocblas_timeline_thread(), main_thread);
+    }
+
+    // The writer names each track before its first event, and starts a GPU event at the end
+    // of the previous one on its stream if it entered earlier
+    void testing_writer()
+    {
+        std::string             out;
+        rocblas_timeline_writer writer([&](const std::string& events) { out += events; }, 7);
+
+        writer.write({"rocblas_sgemm", 1, stream_a, 2000, 5000, 10.5});
+        writer.write({"rocblas_saxpy", 1, stream_a, 4000, 6000, 1});
+        writer.write({"rocblas_sscal", 2, stream_a, 7000, 7500, -1});
+
+        const std::string gpu_track = std::to_string(rocblas_timeline_writer::stream_tracks);
+        EXPECT_EQ(
+            out,
+            "[\n"
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":7,\"tid\":1,"
+            "\"args\":{\"name\":\"rocBLAS thread 1\"}},\n"
+            "{\"name\":\"rocblas_sgemm\",\"cat\":\"host\",\"ph\":\"X\",\"pid\":7,\"tid\":1,"
+            "\"ts\":2.000,\"dur\":3.000,\"args\":{\"gpu_us\":10.500}},\n"
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":7,\"tid\":"
+                + gpu_track
+                + ",\"args\":{\"name\":\"GPU stream 0x10\"}},\n"
+                  "{\"name\":\"rocblas_sgemm\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":7,\"tid\":"
+                + gpu_track
+                + ",\"ts\":2.000,\"dur\":10.500},\n"
+                  "{\"name\":\"rocblas_saxpy\",\"cat\":\"host\",\"ph\":\"X\",\"pid\":7,\"tid\":1,"
+                  "\"ts\":4.000,\"dur\":2.000,\"args\":{\"gpu_us\":1.000}},\n"
+                  "{\"name\":\"rocblas_saxpy\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":7,\"tid\":"
+                + gpu_track
+                + ",\"ts\":12.500,\"dur\":1.000},\n"
+                  "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":7,\"tid\":2,"
+                  "\"args\":{\"name\":\"rocBLAS thread 2\"}},\n"
+                  "{\"name\":\"rocblas_sscal\",\"cat\":\"host\",\"ph\":\"X\",\"pid\":7,\"tid\":2,"
+                  "\"ts\":7.000,\"dur\":0.500},\n");
+
+        // Another stream has its own track
+        out.clear();
+        writer.write({"rocblas_sgemm", 1, stream_b, 8000, 9000, 2});
+        EXPECT_NE(out.find("\"tid\":" + std::to_string(rocblas_timeline_writer::stream_tracks + 1)
+                           + ",\"args\":{\"name\":\"GPU stream 0x20\"}"),
+                  std::string::npos);
+        EXPECT_NE(out.find("\"ts\":8.000,\"dur\":2.000}"), std::string::npos);
+    }
+
+    template <typename...>
+    struct testing_timeline : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            testing_pool();
+            testing_untimed();
+            testing_threads();
+            testing_writer();
+        }
+    };
+
+    struct timeline : RocBLAS_Test<timeline, testing_timeline>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "timeline");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<timeline>(arg.name);
+        }
+    };
+
+    TEST_P(timeline, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_timeline<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(timeline)
+
+} // namespace
@@ -0,0 +1,323 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_trsm_inverse_cache.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Host backend which counts live allocations
+    struct host_inverse_backend
+    {
+        std::shared_ptr<size_t> live = std::make_shared<size_t>(0);
+
+        void* allocate(size_t size)
+        {
+            ++*live;
+            return malloc(size);
+        }
+
+        void deallocate(void* ptr)
+        {
+            --*live;
+            free(ptr);
+        }
+    };
+
+    using host_inverse_cache = rocblas_trsm_inverse_cache<host_inverse_backend>;
+
+    rocblas_trsm_inverse_key inverse_key(const void* A, rocblas_int k, rocblas_int block = 128)
+    {
+        return {A,
+                0,
+                k,
+                0,
+                k,
+                block,
+                1,
+                rocblas_fill_lower,
+                rocblas_diagonal_non_unit,
+                rocblas_datatype_f32_r,
+                false,
+                0};
+    }
+
+    void testing_trsm_inverse_cache_policy()
+    {
+        host_inverse_backend backend;
+        {
+            host_inverse_cache cache(backend);
+            int                a[3];
+
+            // Disabled by default
+            EXPECT_FALSE(cache.enabled());
+            EXPECT_EQ(cache.find(inverse_key(&a[0], 8)), nullptr);
+            EXPECT_EQ(cache.insert(inverse_key(&a[0], 8), 100), nullptr);
+            EXPECT_EQ(cache.get_stats().misses, size_t(0));
+
+            cache.set_budget(250);
+            EXPECT_TRUE(cache.enabled(false));
+
+            // Batched calls, keyed by their array of pointers, are excluded unless opted in
+            EXPECT_FALSE(cache.enabled(true));
+            cache.set_batched(true);
+            EXPECT_TRUE(cache.enabled(true));
+            cache.set_batched(false);
+
+            EXPECT_EQ(cache.find(inverse_key(&a[0], 8)), nullptr);
+            void* e0 = cache.insert(inverse_key(&a[0], 8), 100);
+            void* e1 = cache.insert(inverse_key(&a[1], 8), 100);
+            ASSERT_NE(e0, nullptr);
+            ASSERT_NE(e1, nullptr);
+            EXPECT_EQ(cache.insert(inverse_key(&a[2], 8), 300), nullptr);
+            EXPECT_EQ(cache.find(inverse_key(&a[0], 8)), e0);
+            EXPECT_EQ(cache.find(inverse_key(&a[0], 16)), nullptr);
+
+            // The inverse of a different BLOCK has a different layout
+            EXPECT_EQ(cache.find(inverse_key(&a[0], 8, 64)), nullptr);
+
+            auto stats = cache.get_stats();
+            EXPECT_EQ(stats.hits, size_t(1));
+            EXPECT_EQ(stats.misses, size_t(3));
+            EXPECT_EQ(stats.entries, size_t(2));
+            EXPECT_EQ(stats.bytes, size_t(200));
+
+            // The least recently used entry, of a[1], is evicted to make room
+            void* e2 = cache.insert(inverse_key(&a[2], 8), 100);
+            ASSERT_NE(e2, nullptr);
+            EXPECT_EQ(cache.find(inverse_key(&a[1], 8)), nullptr);
+            EXPECT_EQ(cache.find(inverse_key(&a[0], 8)), e0);
+            EXPECT_EQ(cache.find(inverse_key(&a[2], 8)), e2);
+            EXPECT_EQ(cache.get_stats().evictions, size_t(1));
+            EXPECT_EQ(*backend.live, size_t(2));
+
+            // A new generation misses entries of the previous one, which hits again
+            cache.set_generation(1);
+            EXPECT_EQ(cache.find(inverse_key(&a[0], 8)), nullptr);
+            cache.set_generation(0);
+            EXPECT_EQ(cache.find(inverse_key(&a[0], 8)), e0);
+
+            // An entry which could not be computed is freed
+            cache.erase(e2);
+            EXPECT_EQ(cache.get_stats().entries, size_t(1));
+            EXPECT_EQ(cache.get_stats().bytes, size_t(100));
+
+            cache.reset_stats();
+            stats = cache.get_stats();
+            EXPECT_EQ(stats.hits + stats.misses + stats.evictions, size_t(0));
+            EXPECT_EQ(stats.entries, size_t(1));
+
+            // A smaller budget evicts entries, and 0 disables the cache
+            cache.set_budget(0);
+            EXPECT_EQ(cache.get_stats().entries, size_t(0));
+            EXPECT_EQ(*backend.live, size_t(0));
+
+            cache.set_budget(1000);
+            EXPECT_NE(cache.insert(inverse_key(&a[0], 8), 100), nullptr);
+        }
+        EXPECT_EQ(*backend.live, size_t(0));
+    }
+
+    void testing_trsm_inverse_cache_api()
+    {
+        rocblas_local_handle             handle;
+        size_t                           size = 1;
+        rocblas_trsm_inverse_cache_stats stats;
+
+        CHECK_ROCBLAS_ERROR(rocblas_get_trsm_inverse_cache_size(handle, &size));
+        EXPECT_EQ(size, size_t(0));
+
+        rocblas_trsm_inverse_cache_batched batched = rocblas_trsm_inverse_cache_batched_included;
+        CHECK_ROCBLAS_ERROR(rocblas_get_trsm_inverse_cache_batched(handle, &batched));
+        EXPECT_EQ(batched, rocblas_trsm_inverse_cache_batched_excluded);
+        CHECK_ROCBLAS_ERROR(rocblas_set_trsm_inverse_cache_batched(
+            handle, rocblas_trsm_inverse_cache_batched_included));
+        CHECK_ROCBLAS_ERROR(rocblas_get_trsm_inverse_cache_batched(handle, &batched));
+        EXPECT_EQ(batched, rocblas_trsm_inverse_cache_batched_included);
+        EXPECT_ROCBLAS_STATUS(
+            rocblas_set_trsm_inverse_cache_batched(handle, rocblas_trsm_inverse_cache_batched(2)),
+            rocblas_status_invalid_value);
+
+        EXPECT_ROCBLAS_STATUS(rocblas_set_trsm_inverse_cache_size(nullptr, 0),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_trsm_inverse_cache_size(nullptr, &size),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_trsm_inverse_cache_size(handle, nullptr),
+                              rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(rocblas_set_trsm_inverse_cache_generation(nullptr, 1),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_trsm_inverse_cache_stats(nullptr, &stats),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_trsm_inverse_cache_stats(handle, nullptr),
+                              rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(rocblas_reset_trsm_inverse_cache_stats(nullptr),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_clear_trsm_inverse_cache(nullptr),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_set_trsm_inverse_cache_batched(
+                                  nullptr, rocblas_trsm_inverse_cache_batched_excluded),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_trsm_inverse_cache_batched(nullptr, &batched),
+                              rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(rocblas_get_trsm_inverse_cache_batched(handle, nullptr),
+                              rocblas_status_invalid_pointer);
+    }
+
+    // Solves with cached inverses match solves without the cache
+    void testing_trsm_inverse_cache_solves(const Arguments& arg)
+    {
+        const rocblas_int    M           = arg.M;
+        const rocblas_int    N           = arg.N;
+        const rocblas_int    batch_count = 2;
+        const rocblas_stride stride_A    = rocblas_stride(M) * M;
+        const rocblas_stride stride_B    = rocblas_stride(M) * N;
+        const float          alpha       = 1;
+
+        // Diagonally dominant lower triangular A
+        host_vector<float> hA(stride_A * batch_count), hB(stride_B * batch_count);
+        for(rocblas_int b = 0; b < batch_count; ++b)
+            for(rocblas_int j = 0; j < M; ++j)
+                for(rocblas_int i = 0; i < M; ++i)
+                    hA[b * stride_A + j * M + i]
+                        = i == j ? float(M + b) : i > j ? float((i + j + b) % 5 - 2) / M : 9.0f;
+        for(size_t i = 0; i < hB.size(); ++i)
+            hB[i] = float(int(i % 11) - 5);
+
+        device_vector<float> dA(stride_A * batch_count), dB(stride_B * batch_count);
+        CHECK_DEVICE_ALLOCATION(dA.memcheck());
+        CHECK_DEVICE_ALLOCATION(dB.memcheck());
+        CHECK_HIP_ERROR(dA.transfer_from(hA));
+
+        auto solve = [&](rocblas_handle handle, host_vector<float>& hX) {
+            CHECK_HIP_ERROR(dB.transfer_from(hB));
+            CHECK_ROCBLAS_ERROR(rocblas_strsm_strided_batched(handle,
+                                                              rocblas_side_left,
+                                                              rocblas_fill_lower,
+                                                              rocblas_operation_none,
+                                                              rocblas_diagonal_non_unit,
+                                                              M,
+                                                              N,
+                                                              &alpha,
+                                                              dA,
+                                                              M,
+                                                              stride_A,
+                                                              dB,
+                                                              M,
+                                                              stride_B,
+                                                              batch_count));
+            CHECK_HIP_ERROR(hX.transfer_from(dB));
+        };
+
+        rocblas_local_handle             handle;
+        rocblas_trsm_inverse_cache_stats stats;
+        host_vector<float>               hX_uncached(hB.size()), hX(hB.size());
+
+        solve(handle, hX_uncached);
+        CHECK_ROCBLAS_ERROR(rocblas_get_trsm_inverse_cache_stats(handle, &stats));
+        EXPECT_EQ(stats.hits + stats.misses + stats.entries, size_t(0));
+
+        // The first solve inverts the blocks into the cache, and the second reuses them
+        CHECK_ROCBLAS_ERROR(rocblas_set_trsm_inverse_cache_size(handle, size_t(64) << 20));
+        for(int i = 0; i < 2; ++i)
+        {
+            solve(handle, hX);
+            EXPECT_EQ(memcmp(hX.data(), hX_uncached.data(), sizeof(float) * hX.size()), 0);
+        }
+        CHECK_ROCBLAS_ERROR(rocblas_get_trsm_inverse_cache_stats(handle, &stats));
+        EXPECT_EQ(stats.misses, size_t(1));
+        EXPECT_EQ(stats.hits, size_t(1));
+        EXPECT_EQ(stats.entries, size_t(1));
+        EXPECT_GT(stats.bytes, size_t(0));
+
+        // After A changes, a new generation inverts it again
+        for(rocblas_int i = 0; i < M; ++i)
+            hA[i * M + i] *= 2;
+        CHECK_HIP_ERROR(dA.transfer_from(hA));
+        {
+            rocblas_local_handle uncached;
+            solve(uncached, hX_uncached);
+        }
+        CHECK_ROCBLAS_ERROR(rocblas_set_trsm_inverse_cache_generation(handle, 1));
+        solve(handle, hX);
+        EXPECT_EQ(memcmp(hX.data(), hX_uncached.data(), sizeof(float) * hX.size()), 0);
+        CHECK_ROCBLAS_ERROR(rocblas_get_trsm_inverse_cache_stats(handle, &stats));
+        EXPECT_EQ(stats.misses, size_t(2));
+        EXPECT_EQ(stats.entries, size_t(2));
+
+        // A budget smaller than an entry evicts them all and caches nothing
+        CHECK_ROCBLAS_ERROR(rocblas_set_trsm_inverse_cache_size(handle, 1));
+        solve(handle, hX);
+        EXPECT_EQ(memcmp(hX.data(), hX_uncached.data(), sizeof(float) * hX.size()), 0);
+        CHECK_ROCBLAS_ERROR(rocblas_get_trsm_inverse_cache_stats(handle, &stats));
+        EXPECT_EQ(stats.evictions, size_t(2));
+        EXPECT_EQ(stats.entries, size_t(0));
+        EXPECT_EQ(stats.bytes, size_t(0));
+
+        CHECK_ROCBLAS_ERROR(rocblas_reset_trsm_inverse_cache_stats(handle));
+        CHECK_ROCBLAS_ERROR(rocblas_clear_trsm_inverse_cache(handle));
+
+        // Entries are freed through the handle, so freeing is counted, and refused in
+        // capture-safe mode
+        CHECK_ROCBLAS_ERROR(rocblas_set_trsm_inverse_cache_size(handle, size_t(64) << 20));
+        solve(handle, hX);
+        CHECK_ROCBLAS_ERROR(rocblas_set_capture_mode(handle, rocblas_capture_safe));
+        EXPECT_ROCBLAS_STATUS(rocblas_clear_trsm_inverse_cache(handle),
+                              rocblas_status_capture_unsafe);
+        EXPECT_ROCBLAS_STATUS(rocblas_set_trsm_inverse_cache_size(handle, 0),
+                              rocblas_status_capture_unsafe);
+        CHECK_ROCBLAS_ERROR(rocblas_set_capture_mode(handle, rocblas_capture_default));
+
+        rocblas_sync_point_counts counts;
+        CHECK_ROCBLAS_ERROR(rocblas_reset_sync_point_counts(handle));
+        CHECK_ROCBLAS_ERROR(rocblas_clear_trsm_inverse_cache(handle));
+        CHECK_ROCBLAS_ERROR(rocblas_get_sync_point_counts(handle, &counts));
+        EXPECT_EQ(counts.frees, size_t(1));
+    }
+
+    template <typename...>
+    struct testing_trsm_inverse_cache : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            testing_trsm_inverse_cache_policy();
+            testing_trsm_inverse_cache_api();
+            testing_trsm_inverse_cache_solves(arg);
+        }
+    };
+
+    struct trsm_inverse_cache : RocBLAS_Test<trsm_inverse_cache, testing_trsm_inverse_cache>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "trsm_inverse_cache");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<trsm_inverse_cache>(arg.name) << arg.M << '_' << arg.N;
+        }
+    };
+
+    TEST_P(trsm_inverse_cache, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_trsm_inverse_cache<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(trsm_inverse_cache)
+
+} // namespace
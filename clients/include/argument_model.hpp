@@ -5,6 +5,7 @@
 #pragma once
 
 #include "rocblas_arguments.hpp"
+#include "rocblas_timing.hpp"
 
 namespace ArgumentLogging
 {
@@ -14,6 +15,13 @@ namespace ArgumentLogging
 void ArgumentModel_set_log_function_name(bool f);
 bool ArgumentModel_get_log_function_name();
 
+// Receiver of the comma-separated names and values of logged arguments, instead of the
+// output stream passed to log_args; rocblas-bench batch mode uses it to format results
+using ArgumentModel_log_sink = void (*)(const std::string& names, const std::string& values);
+
+void                   ArgumentModel_set_log_sink(ArgumentModel_log_sink sink);
+ArgumentModel_log_sink ArgumentModel_get_log_sink();
+
 // ArgumentModel template has a variadic list of argument enums
 template <rocblas_argument... Args>
 class ArgumentModel
@@ -45,8 +53,15 @@ public:
         rocblas_int    batch_count     = has_batch_count ? arg.batch_count : 1;
         rocblas_int    hot_calls       = arg.iters < 1 ? 1 : arg.iters;
 
-        // gpu time is total cumulative over hot calls, cpu is not
-        if(hot_calls > 1)
+        // Per-call times of the hot loop, if the driver timed it with rocblas_hot_iterations
+        rocblas_timing_stats timing;
+        bool                 has_timing = rocblas_timing_take_last(timing);
+
+        // gpu time is total cumulative over hot calls, cpu is not. If the loop ran more
+        // batches to converge, it synchronized between them, so the mean per-call time is used.
+        if(has_timing && timing.samples > size_t(hot_calls))
+            gpu_us = timing.mean_us;
+        else if(hot_calls > 1)
             gpu_us /= hot_calls;
 
         // per/us to per/sec *10^6
@@ -70,6 +85,14 @@ public:
         name_line << ",us";
         val_line << ", " << gpu_us;
 
+        if(has_timing)
+        {
+            name_line << ",us_min,us_median,us_p90,us_p99,us_stddev,samples";
+            val_line << ", " << timing.min_us << ", " << timing.median_us << ", "
+                     << timing.p90_us << ", " << timing.p99_us << ", " << timing.stddev_us
+                     << ", " << timing.samples;
+        }
+
         if(arg.unit_check || arg.norm_check)
         {
             if(cpu_us != ArgumentLogging::NA_value)
@@ -185,6 +208,9 @@ public:
                      norm3,
                      norm4);
 
-        str << name_list << "\n" << value_list << std::endl;
+        if(auto sink = ArgumentModel_get_log_sink())
+            sink(name_list.str(), value_list.str());
+        else
+            str << name_list << "\n" << value_list << std::endl;
     }
 };
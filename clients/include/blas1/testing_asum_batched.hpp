@@ -163,7 +163,7 @@ void testing_asum_batched(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_hot_calls; iter++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             rocblas_asum_batched_fn(handle, N, dx.ptr_on_device(), incx, batch_count, dr);
         }
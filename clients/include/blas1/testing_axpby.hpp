@@ -0,0 +1,562 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "bytes.hpp"
+#include "cblas_interface.hpp"
+#include "flops.hpp"
+#include "norm.hpp"
+#include "rocblas.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "testing_fused_blas1.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+// Reference y := alpha * x + beta * y, which reads neither x when alpha is zero nor y when
+// beta is zero, so that NaNs there do not propagate
+template <typename T>
+void ref_axpby(rocblas_int n, T alpha, const T* x, rocblas_int incx, T beta, T* y, rocblas_int incy)
+{
+    if(incx < 0)
+        x -= ptrdiff_t(n - 1) * incx;
+    if(incy < 0)
+        y -= ptrdiff_t(n - 1) * incy;
+
+    for(rocblas_int i = 0; i < n; ++i)
+    {
+        T value = 0;
+        if(alpha != T(0))
+            value = alpha * x[ptrdiff_t(i) * incx];
+        if(beta != T(0))
+            value += beta * y[ptrdiff_t(i) * incy];
+        y[ptrdiff_t(i) * incy] = value;
+    }
+}
+
+template <typename T>
+void testing_axpby_bad_arg(const Arguments& arg)
+{
+    auto rocblas_axpby_fn = arg.fortran ? rocblas_axpby<T, true> : rocblas_axpby<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, incx = 1, incy = 1;
+
+    T alpha = 0.6, beta = 0.3, zero = 0.0, one = 1.0;
+
+    device_vector<T> dx(N * incx), dy(N * incy);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+
+    EXPECT_ROCBLAS_STATUS(rocblas_axpby_fn(handle, N, nullptr, dx, incx, &beta, dy, incy),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpby_fn(handle, N, &alpha, dx, incx, nullptr, dy, incy),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpby_fn(handle, N, &alpha, nullptr, incx, &beta, dy, incy),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpby_fn(handle, N, &alpha, dx, incx, &beta, nullptr, incy),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpby_fn(nullptr, N, &alpha, dx, incx, &beta, dy, incy),
+                          rocblas_status_invalid_handle);
+
+    // When N==0, all pointers can be nullptr without error
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_fn(handle, 0, nullptr, nullptr, incx, nullptr, nullptr, incy),
+        rocblas_status_success);
+
+    // When alpha==0 and beta==1, x and y can be nullptr without error
+    EXPECT_ROCBLAS_STATUS(rocblas_axpby_fn(handle, N, &zero, nullptr, incx, &one, nullptr, incy),
+                          rocblas_status_success);
+}
+
+template <typename T>
+void testing_axpby(const Arguments& arg)
+{
+    auto rocblas_axpby_fn = arg.fortran ? rocblas_axpby<T, true> : rocblas_axpby<T, false>;
+
+    rocblas_int          N = arg.N, incx = arg.incx, incy = arg.incy;
+    T                    h_alpha = arg.get_alpha<T>(), h_beta = arg.get_beta<T>();
+    rocblas_local_handle handle{arg};
+
+    // argument sanity check before allocating invalid memory
+    if(N <= 0)
+    {
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        EXPECT_ROCBLAS_STATUS(
+            rocblas_axpby_fn(handle, N, nullptr, nullptr, incx, nullptr, nullptr, incy),
+            rocblas_status_success);
+        return;
+    }
+
+    rocblas_int abs_incx = incx ? std::abs(incx) : 1;
+    rocblas_int abs_incy = incy ? std::abs(incy) : 1;
+    size_t      size_x   = N * size_t(abs_incx);
+    size_t      size_y   = N * size_t(abs_incy);
+
+    // Naming: dK is in GPU (device) memory. hK is in CPU (host) memory
+    host_vector<T> hx(size_x), hy(size_y), hy_1(size_y), hy_2(size_y), hy_gold(size_y);
+    host_vector<T> halpha(1), hbeta(1);
+    halpha[0] = h_alpha;
+    hbeta[0]  = h_beta;
+
+    device_vector<T> dx(size_x), dy(size_y), dalpha(1), dbeta(1);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(dalpha.memcheck());
+    CHECK_DEVICE_ALLOCATION(dbeta.memcheck());
+
+    // Initial Data on CPU
+    if(rocblas_isnan(arg.alpha))
+    {
+        rocblas_init_nan<T>(hx, 1, N, abs_incx);
+        rocblas_init_nan<T>(hy, 1, N, abs_incy);
+    }
+    else
+    {
+        rocblas_init<T>(hx, 1, N, abs_incx);
+        rocblas_init<T>(hy, 1, N, abs_incy);
+    }
+    hy_gold = hy;
+
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_axpby_fn(handle, N, &h_alpha, dx, incx, &h_beta, dy, incy));
+        CHECK_HIP_ERROR(hy_1.transfer_from(dy));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_HIP_ERROR(dalpha.transfer_from(halpha));
+        CHECK_HIP_ERROR(dbeta.transfer_from(hbeta));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_axpby_fn(handle, N, dalpha, dx, incx, dbeta, dy, incy));
+        CHECK_HIP_ERROR(hy_2.transfer_from(dy));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        ref_axpby<T>(N, h_alpha, hx, incx, h_beta, hy_gold, incy);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(1, N, abs_incy, hy_gold, hy_1);
+            unit_check_general<T>(1, N, abs_incy, hy_gold, hy_2);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1 = norm_check_general<T>('I', 1, N, abs_incy, hy_gold, hy_1);
+            rocblas_error_2 = norm_check_general<T>('I', 1, N, abs_incy, hy_gold, hy_2);
+        }
+    }
+
+    if(arg.timing)
+    {
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_host, [&] {
+            rocblas_axpby_fn(handle, N, &h_alpha, dx, incx, &h_beta, dy, incy);
+        });
+
+        ArgumentModel<e_N, e_alpha, e_incx, e_beta, e_incy>{}.log_args<T>(
+            rocblas_cout,
+            arg,
+            gpu_time_used,
+            axpby_gflop_count<T>(N),
+            axpy_gbyte_count<T>(N),
+            cpu_time_used,
+            rocblas_error_1,
+            rocblas_error_2);
+    }
+}
+
+template <typename T>
+void testing_axpby_batched_bad_arg(const Arguments& arg)
+{
+    auto rocblas_axpby_batched_fn
+        = arg.fortran ? rocblas_axpby_batched<T, true> : rocblas_axpby_batched<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, incx = 1, incy = 1, batch_count = 2;
+
+    T alpha = 0.6, beta = 0.3;
+
+    device_batch_vector<T> dx(N, incx, batch_count), dy(N, incy, batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+
+    EXPECT_ROCBLAS_STATUS(rocblas_axpby_batched_fn(handle,
+                                                   N,
+                                                   nullptr,
+                                                   dx.ptr_on_device(),
+                                                   incx,
+                                                   &beta,
+                                                   dy.ptr_on_device(),
+                                                   incy,
+                                                   batch_count),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpby_batched_fn(handle,
+                                                   N,
+                                                   &alpha,
+                                                   dx.ptr_on_device(),
+                                                   incx,
+                                                   nullptr,
+                                                   dy.ptr_on_device(),
+                                                   incy,
+                                                   batch_count),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_batched_fn(
+            handle, N, &alpha, nullptr, incx, &beta, dy.ptr_on_device(), incy, batch_count),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_batched_fn(
+            handle, N, &alpha, dx.ptr_on_device(), incx, &beta, nullptr, incy, batch_count),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpby_batched_fn(nullptr,
+                                                   N,
+                                                   &alpha,
+                                                   dx.ptr_on_device(),
+                                                   incx,
+                                                   &beta,
+                                                   dy.ptr_on_device(),
+                                                   incy,
+                                                   batch_count),
+                          rocblas_status_invalid_handle);
+
+    // When batch_count==0, all pointers can be nullptr without error
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_batched_fn(handle, N, nullptr, nullptr, incx, nullptr, nullptr, incy, 0),
+        rocblas_status_success);
+}
+
+template <typename T>
+void testing_axpby_batched(const Arguments& arg)
+{
+    auto rocblas_axpby_batched_fn
+        = arg.fortran ? rocblas_axpby_batched<T, true> : rocblas_axpby_batched<T, false>;
+
+    rocblas_int N = arg.N, incx = arg.incx, incy = arg.incy, batch_count = arg.batch_count;
+    T           h_alpha = arg.get_alpha<T>(), h_beta = arg.get_beta<T>();
+    rocblas_local_handle handle{arg};
+
+    // argument sanity check before allocating invalid memory
+    if(N <= 0 || batch_count <= 0)
+    {
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        EXPECT_ROCBLAS_STATUS(
+            rocblas_axpby_batched_fn(
+                handle, N, nullptr, nullptr, incx, nullptr, nullptr, incy, batch_count),
+            rocblas_status_success);
+        return;
+    }
+
+    rocblas_int abs_incy = incy ? std::abs(incy) : 1;
+
+    host_batch_vector<T> hx(N, incx ? incx : 1, batch_count), hy(N, incy ? incy : 1, batch_count),
+        hy_1(N, incy ? incy : 1, batch_count), hy_2(N, incy ? incy : 1, batch_count);
+    host_vector<T> halpha(1), hbeta(1);
+    CHECK_HIP_ERROR(hx.memcheck());
+    CHECK_HIP_ERROR(hy.memcheck());
+    CHECK_HIP_ERROR(hy_1.memcheck());
+    CHECK_HIP_ERROR(hy_2.memcheck());
+    halpha[0] = h_alpha;
+    hbeta[0]  = h_beta;
+
+    device_batch_vector<T> dx(N, incx ? incx : 1, batch_count), dy(N, incy ? incy : 1, batch_count);
+    device_vector<T>       dalpha(1), dbeta(1);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(dalpha.memcheck());
+    CHECK_DEVICE_ALLOCATION(dbeta.memcheck());
+
+    if(rocblas_isnan(arg.alpha))
+    {
+        rocblas_init_nan(hx, true);
+        rocblas_init_nan(hy, false);
+    }
+    else
+    {
+        rocblas_init(hx, true);
+        rocblas_init(hy, false);
+    }
+
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_axpby_batched_fn(handle,
+                                                     N,
+                                                     &h_alpha,
+                                                     dx.ptr_on_device(),
+                                                     incx,
+                                                     &h_beta,
+                                                     dy.ptr_on_device(),
+                                                     incy,
+                                                     batch_count));
+        CHECK_HIP_ERROR(hy_1.transfer_from(dy));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_HIP_ERROR(dalpha.transfer_from(halpha));
+        CHECK_HIP_ERROR(dbeta.transfer_from(hbeta));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_axpby_batched_fn(handle,
+                                                     N,
+                                                     dalpha,
+                                                     dx.ptr_on_device(),
+                                                     incx,
+                                                     dbeta,
+                                                     dy.ptr_on_device(),
+                                                     incy,
+                                                     batch_count));
+        CHECK_HIP_ERROR(hy_2.transfer_from(dy));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; ++b)
+            ref_axpby<T>(N, h_alpha, hx[b], incx, h_beta, hy[b], incy);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(1, N, abs_incy, hy, hy_1, batch_count);
+            unit_check_general<T>(1, N, abs_incy, hy, hy_2, batch_count);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1 = norm_check_general<T>('I', 1, N, abs_incy, hy, hy_1, batch_count);
+            rocblas_error_2 = norm_check_general<T>('I', 1, N, abs_incy, hy, hy_2, batch_count);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_host, [&] {
+            rocblas_axpby_batched_fn(handle,
+                                     N,
+                                     &h_alpha,
+                                     dx.ptr_on_device(),
+                                     incx,
+                                     &h_beta,
+                                     dy.ptr_on_device(),
+                                     incy,
+                                     batch_count);
+        });
+
+        ArgumentModel<e_N, e_alpha, e_incx, e_beta, e_incy, e_batch_count>{}.log_args<T>(
+            rocblas_cout,
+            arg,
+            gpu_time_used,
+            axpby_gflop_count<T>(N),
+            axpy_gbyte_count<T>(N),
+            cpu_time_used,
+            rocblas_error_1,
+            rocblas_error_2);
+    }
+}
+
+template <typename T>
+void testing_axpby_strided_batched_bad_arg(const Arguments& arg)
+{
+    auto rocblas_axpby_strided_batched_fn = arg.fortran ? rocblas_axpby_strided_batched<T, true>
+                                                        : rocblas_axpby_strided_batched<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, incx = 1, incy = 1, batch_count = 2;
+    rocblas_stride       stridex = N, stridey = N;
+
+    T alpha = 0.6, beta = 0.3;
+
+    device_strided_batch_vector<T> dx(N, incx, stridex, batch_count),
+        dy(N, incy, stridey, batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_strided_batched_fn(
+            handle, N, nullptr, dx, incx, stridex, &beta, dy, incy, stridey, batch_count),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_strided_batched_fn(
+            handle, N, &alpha, dx, incx, stridex, nullptr, dy, incy, stridey, batch_count),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_strided_batched_fn(
+            handle, N, &alpha, nullptr, incx, stridex, &beta, dy, incy, stridey, batch_count),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_strided_batched_fn(
+            handle, N, &alpha, dx, incx, stridex, &beta, nullptr, incy, stridey, batch_count),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_strided_batched_fn(
+            nullptr, N, &alpha, dx, incx, stridex, &beta, dy, incy, stridey, batch_count),
+        rocblas_status_invalid_handle);
+
+    // When batch_count==0, all pointers can be nullptr without error
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpby_strided_batched_fn(
+            handle, N, nullptr, nullptr, incx, stridex, nullptr, nullptr, incy, stridey, 0),
+        rocblas_status_success);
+}
+
+template <typename T>
+void testing_axpby_strided_batched(const Arguments& arg)
+{
+    auto rocblas_axpby_strided_batched_fn = arg.fortran ? rocblas_axpby_strided_batched<T, true>
+                                                        : rocblas_axpby_strided_batched<T, false>;
+
+    rocblas_int N = arg.N, incx = arg.incx, incy = arg.incy, batch_count = arg.batch_count;
+    T           h_alpha = arg.get_alpha<T>(), h_beta = arg.get_beta<T>();
+    rocblas_local_handle handle{arg};
+
+    rocblas_stride stridex = arg.stride_x, stridey = arg.stride_y;
+    if(!stridex)
+        stridex = N;
+    if(!stridey)
+        stridey = N;
+
+    // argument sanity check before allocating invalid memory
+    if(N <= 0 || batch_count <= 0)
+    {
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        EXPECT_ROCBLAS_STATUS(rocblas_axpby_strided_batched_fn(handle,
+                                                               N,
+                                                               nullptr,
+                                                               nullptr,
+                                                               incx,
+                                                               stridex,
+                                                               nullptr,
+                                                               nullptr,
+                                                               incy,
+                                                               stridey,
+                                                               batch_count),
+                              rocblas_status_success);
+        return;
+    }
+
+    rocblas_int abs_incy = incy ? std::abs(incy) : 1;
+
+    host_strided_batch_vector<T> hx(N, incx ? incx : 1, stridex, batch_count),
+        hy(N, incy ? incy : 1, stridey, batch_count),
+        hy_1(N, incy ? incy : 1, stridey, batch_count),
+        hy_2(N, incy ? incy : 1, stridey, batch_count);
+    host_vector<T> halpha(1), hbeta(1);
+    CHECK_HIP_ERROR(hx.memcheck());
+    CHECK_HIP_ERROR(hy.memcheck());
+    CHECK_HIP_ERROR(hy_1.memcheck());
+    CHECK_HIP_ERROR(hy_2.memcheck());
+    halpha[0] = h_alpha;
+    hbeta[0]  = h_beta;
+
+    device_strided_batch_vector<T> dx(N, incx ? incx : 1, stridex, batch_count),
+        dy(N, incy ? incy : 1, stridey, batch_count);
+    device_vector<T> dalpha(1), dbeta(1);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(dalpha.memcheck());
+    CHECK_DEVICE_ALLOCATION(dbeta.memcheck());
+
+    if(rocblas_isnan(arg.alpha))
+    {
+        rocblas_init_nan(hx, true);
+        rocblas_init_nan(hy, false);
+    }
+    else
+    {
+        rocblas_init(hx, true);
+        rocblas_init(hy, false);
+    }
+
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_axpby_strided_batched_fn(
+            handle, N, &h_alpha, dx, incx, stridex, &h_beta, dy, incy, stridey, batch_count));
+        CHECK_HIP_ERROR(hy_1.transfer_from(dy));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_HIP_ERROR(dalpha.transfer_from(halpha));
+        CHECK_HIP_ERROR(dbeta.transfer_from(hbeta));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_axpby_strided_batched_fn(
+            handle, N, dalpha, dx, incx, stridex, dbeta, dy, incy, stridey, batch_count));
+        CHECK_HIP_ERROR(hy_2.transfer_from(dy));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; ++b)
+            ref_axpby<T>(N, h_alpha, hx[b], incx, h_beta, hy[b], incy);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(1, N, abs_incy, stridey, hy, hy_1, batch_count);
+            unit_check_general<T>(1, N, abs_incy, stridey, hy, hy_2, batch_count);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1
+                = norm_check_general<T>('I', 1, N, abs_incy, stridey, hy, hy_1, batch_count);
+            rocblas_error_2
+                = norm_check_general<T>('I', 1, N, abs_incy, stridey, hy, hy_2, batch_count);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_host, [&] {
+            rocblas_axpby_strided_batched_fn(
+                handle, N, &h_alpha, dx, incx, stridex, &h_beta, dy, incy, stridey, batch_count);
+        });
+
+        ArgumentModel<e_N,
+                      e_alpha,
+                      e_incx,
+                      e_stride_x,
+                      e_beta,
+                      e_incy,
+                      e_stride_y,
+                      e_batch_count>{}
+            .log_args<T>(rocblas_cout,
+                         arg,
+                         gpu_time_used,
+                         axpby_gflop_count<T>(N),
+                         axpy_gbyte_count<T>(N),
+                         cpu_time_used,
+                         rocblas_error_1,
+                         rocblas_error_2);
+    }
+}
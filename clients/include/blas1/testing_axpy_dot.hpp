@@ -0,0 +1,725 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "bytes.hpp"
+#include "cblas_interface.hpp"
+#include "flops.hpp"
+#include "norm.hpp"
+#include "rocblas.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "testing_fused_blas1.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+// Reference y := alpha * x + y; result := y^H * z, from cblas axpy and dot (dotc for complex)
+template <typename T>
+void ref_axpy_dot(rocblas_int n,
+                  T           alpha,
+                  const T*    x,
+                  rocblas_int incx,
+                  T*          y,
+                  rocblas_int incy,
+                  const T*    z,
+                  rocblas_int incz,
+                  T*          result)
+{
+    cblas_axpy<T>(n, alpha, x, incx, y, incy);
+    if constexpr(is_complex<T>)
+        cblas_dotc<T>(n, y, incy, z, incz, result);
+    else
+        cblas_dot<T>(n, y, incy, z, incz, result);
+}
+
+// In the tests below, arg.algo makes z the same vector as y, so that the result is ||y||^2;
+// otherwise z has the increment arg.incd (--incz) and the stride arg.stride_d (--stride_z).
+
+template <typename T>
+void testing_axpy_dot_bad_arg(const Arguments& arg)
+{
+    auto rocblas_axpy_dot_fn
+        = arg.fortran ? rocblas_axpy_dot<T, true> : rocblas_axpy_dot<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, incx = 1, incy = 1, incz = 1;
+
+    T alpha = 0.6, result;
+
+    device_vector<T> dx(N * incx), dy(N * incy), dz(N * incz);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(dz.memcheck());
+
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpy_dot_fn(handle, N, nullptr, dx, incx, dy, incy, dz, incz, &result),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpy_dot_fn(handle, N, &alpha, nullptr, incx, dy, incy, dz, incz, &result),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpy_dot_fn(handle, N, &alpha, dx, incx, nullptr, incy, dz, incz, &result),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpy_dot_fn(handle, N, &alpha, dx, incx, dy, incy, nullptr, incz, &result),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpy_dot_fn(handle, N, &alpha, dx, incx, dy, incy, dz, incz, nullptr),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_axpy_dot_fn(nullptr, N, &alpha, dx, incx, dy, incy, dz, incz, &result),
+        rocblas_status_invalid_handle);
+}
+
+template <typename T>
+void testing_axpy_dot(const Arguments& arg)
+{
+    auto rocblas_axpy_dot_fn
+        = arg.fortran ? rocblas_axpy_dot<T, true> : rocblas_axpy_dot<T, false>;
+
+    rocblas_int          N = arg.N, incx = arg.incx, incy = arg.incy;
+    rocblas_int          incz    = arg.algo ? incy : arg.incd;
+    T                    h_alpha = arg.get_alpha<T>();
+    rocblas_local_handle handle{arg};
+
+    // check to prevent undefined memory allocation error; the result is 0
+    if(N <= 0)
+    {
+        testing_fused_blas1_zero_results<T>(handle, 1, rocblas_status_success, [&](auto d_result) {
+            return rocblas_axpy_dot_fn(
+                handle, N, nullptr, nullptr, incx, nullptr, incy, nullptr, incz, d_result);
+        });
+        return;
+    }
+
+    rocblas_int abs_incx = incx ? std::abs(incx) : 1;
+    rocblas_int abs_incy = incy ? std::abs(incy) : 1;
+    rocblas_int abs_incz = incz ? std::abs(incz) : 1;
+    size_t      size_x   = N * size_t(abs_incx);
+    size_t      size_y   = N * size_t(abs_incy);
+    size_t      size_z   = N * size_t(abs_incz);
+
+    host_vector<T> hx(size_x), hy(size_y), hz(size_z), hy_1(size_y), hy_2(size_y);
+    host_vector<T> halpha(1), cpu_result(1), rocblas_result_1(1), rocblas_result_2(1);
+    halpha[0] = h_alpha;
+
+    device_vector<T> dx(size_x), dy(size_y), dz(size_z), dalpha(1), d_result(1);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(dz.memcheck());
+    CHECK_DEVICE_ALLOCATION(dalpha.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    rocblas_init<T>(hx, 1, N, abs_incx);
+    rocblas_init<T>(hy, 1, N, abs_incy);
+    rocblas_init<T>(hz, 1, N, abs_incz);
+
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+    CHECK_HIP_ERROR(dz.transfer_from(hz));
+    CHECK_HIP_ERROR(dalpha.transfer_from(halpha));
+
+    T* dz_ptr = arg.algo ? (T*)dy : (T*)dz;
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_axpy_dot_fn(
+            handle, N, &h_alpha, dx, incx, dy, incy, dz_ptr, incz, rocblas_result_1));
+        CHECK_HIP_ERROR(hy_1.transfer_from(dy));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(
+            rocblas_axpy_dot_fn(handle, N, dalpha, dx, incx, dy, incy, dz_ptr, incz, d_result));
+        CHECK_HIP_ERROR(hy_2.transfer_from(dy));
+        CHECK_HIP_ERROR(rocblas_result_2.transfer_from(d_result));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        ref_axpy_dot<T>(
+            N, h_alpha, hx, incx, hy, incy, arg.algo ? (T*)hy : (T*)hz, incz, cpu_result);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(1, N, abs_incy, hy, hy_1);
+            unit_check_general<T>(1, N, abs_incy, hy, hy_2);
+            unit_check_general<T>(1, 1, 1, cpu_result, rocblas_result_1);
+            unit_check_general<T>(1, 1, 1, cpu_result, rocblas_result_2);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1 = testing_fused_blas1_result_error(1, cpu_result, rocblas_result_1);
+            rocblas_error_2 = testing_fused_blas1_result_error(1, cpu_result, rocblas_result_2);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_device, [&] {
+            rocblas_axpy_dot_fn(handle, N, dalpha, dx, incx, dy, incy, dz_ptr, incz, d_result);
+        });
+
+        ArgumentModel<e_N, e_alpha, e_incx, e_incy, e_incd, e_algo>{}.log_args<T>(
+            rocblas_cout,
+            arg,
+            gpu_time_used,
+            axpy_gflop_count<T>(N) + dot_gflop_count<is_complex<T>, T>(N),
+            axpy_dot_gbyte_count<T>(N, arg.algo),
+            cpu_time_used,
+            rocblas_error_1,
+            rocblas_error_2);
+    }
+}
+
+template <typename T>
+void testing_axpy_dot_batched_bad_arg(const Arguments& arg)
+{
+    auto rocblas_axpy_dot_batched_fn
+        = arg.fortran ? rocblas_axpy_dot_batched<T, true> : rocblas_axpy_dot_batched<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, incx = 1, incy = 1, incz = 1, batch_count = 2;
+
+    T alpha = 0.6;
+
+    device_batch_vector<T> dx(N, incx, batch_count), dy(N, incy, batch_count),
+        dz(N, incz, batch_count);
+    device_vector<T> d_result(batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(dz.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_batched_fn(handle,
+                                                      N,
+                                                      &alpha,
+                                                      nullptr,
+                                                      incx,
+                                                      dy.ptr_on_device(),
+                                                      incy,
+                                                      dz.ptr_on_device(),
+                                                      incz,
+                                                      batch_count,
+                                                      d_result),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_batched_fn(handle,
+                                                      N,
+                                                      &alpha,
+                                                      dx.ptr_on_device(),
+                                                      incx,
+                                                      nullptr,
+                                                      incy,
+                                                      dz.ptr_on_device(),
+                                                      incz,
+                                                      batch_count,
+                                                      d_result),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_batched_fn(handle,
+                                                      N,
+                                                      &alpha,
+                                                      dx.ptr_on_device(),
+                                                      incx,
+                                                      dy.ptr_on_device(),
+                                                      incy,
+                                                      nullptr,
+                                                      incz,
+                                                      batch_count,
+                                                      d_result),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_batched_fn(handle,
+                                                      N,
+                                                      &alpha,
+                                                      dx.ptr_on_device(),
+                                                      incx,
+                                                      dy.ptr_on_device(),
+                                                      incy,
+                                                      dz.ptr_on_device(),
+                                                      incz,
+                                                      batch_count,
+                                                      nullptr),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_batched_fn(nullptr,
+                                                      N,
+                                                      &alpha,
+                                                      dx.ptr_on_device(),
+                                                      incx,
+                                                      dy.ptr_on_device(),
+                                                      incy,
+                                                      dz.ptr_on_device(),
+                                                      incz,
+                                                      batch_count,
+                                                      d_result),
+                          rocblas_status_invalid_handle);
+}
+
+template <typename T>
+void testing_axpy_dot_batched(const Arguments& arg)
+{
+    auto rocblas_axpy_dot_batched_fn
+        = arg.fortran ? rocblas_axpy_dot_batched<T, true> : rocblas_axpy_dot_batched<T, false>;
+
+    rocblas_int N = arg.N, incx = arg.incx, incy = arg.incy, batch_count = arg.batch_count;
+    rocblas_int incz    = arg.algo ? incy : arg.incd;
+    T           h_alpha = arg.get_alpha<T>();
+    rocblas_local_handle handle{arg};
+
+    // check to prevent undefined memory allocation error; the results are 0
+    if(N <= 0 || batch_count <= 0)
+    {
+        testing_fused_blas1_zero_results<T>(
+            handle, batch_count, rocblas_status_success, [&](auto d_result) {
+                return rocblas_axpy_dot_batched_fn(handle,
+                                                   N,
+                                                   nullptr,
+                                                   nullptr,
+                                                   incx,
+                                                   nullptr,
+                                                   incy,
+                                                   nullptr,
+                                                   incz,
+                                                   batch_count,
+                                                   d_result);
+            });
+        return;
+    }
+
+    rocblas_int abs_incy = incy ? std::abs(incy) : 1;
+
+    host_batch_vector<T> hx(N, incx ? incx : 1, batch_count), hy(N, incy ? incy : 1, batch_count),
+        hz(N, incz ? incz : 1, batch_count), hy_1(N, incy ? incy : 1, batch_count),
+        hy_2(N, incy ? incy : 1, batch_count);
+    host_vector<T> halpha(1), cpu_result(batch_count), rocblas_result_1(batch_count),
+        rocblas_result_2(batch_count);
+    CHECK_HIP_ERROR(hx.memcheck());
+    CHECK_HIP_ERROR(hy.memcheck());
+    CHECK_HIP_ERROR(hz.memcheck());
+    CHECK_HIP_ERROR(hy_1.memcheck());
+    CHECK_HIP_ERROR(hy_2.memcheck());
+    halpha[0] = h_alpha;
+
+    device_batch_vector<T> dx(N, incx ? incx : 1, batch_count), dy(N, incy ? incy : 1, batch_count),
+        dz(N, incz ? incz : 1, batch_count);
+    device_vector<T> dalpha(1), d_result(batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(dz.memcheck());
+    CHECK_DEVICE_ALLOCATION(dalpha.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    rocblas_init(hx, true);
+    rocblas_init(hy, false);
+    rocblas_init(hz, false);
+
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+    CHECK_HIP_ERROR(dz.transfer_from(hz));
+    CHECK_HIP_ERROR(dalpha.transfer_from(halpha));
+
+    auto dz_ptr = arg.algo ? dy.ptr_on_device() : dz.ptr_on_device();
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_axpy_dot_batched_fn(handle,
+                                                        N,
+                                                        &h_alpha,
+                                                        dx.ptr_on_device(),
+                                                        incx,
+                                                        dy.ptr_on_device(),
+                                                        incy,
+                                                        dz_ptr,
+                                                        incz,
+                                                        batch_count,
+                                                        rocblas_result_1));
+        CHECK_HIP_ERROR(hy_1.transfer_from(dy));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_axpy_dot_batched_fn(handle,
+                                                        N,
+                                                        dalpha,
+                                                        dx.ptr_on_device(),
+                                                        incx,
+                                                        dy.ptr_on_device(),
+                                                        incy,
+                                                        dz_ptr,
+                                                        incz,
+                                                        batch_count,
+                                                        d_result));
+        CHECK_HIP_ERROR(hy_2.transfer_from(dy));
+        CHECK_HIP_ERROR(rocblas_result_2.transfer_from(d_result));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; ++b)
+            ref_axpy_dot<T>(N,
+                            h_alpha,
+                            hx[b],
+                            incx,
+                            hy[b],
+                            incy,
+                            arg.algo ? hy[b] : hz[b],
+                            incz,
+                            cpu_result + b);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(1, N, abs_incy, hy, hy_1, batch_count);
+            unit_check_general<T>(1, N, abs_incy, hy, hy_2, batch_count);
+            unit_check_general<T>(1, 1, 1, 1, cpu_result, rocblas_result_1, batch_count);
+            unit_check_general<T>(1, 1, 1, 1, cpu_result, rocblas_result_2, batch_count);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1
+                = testing_fused_blas1_result_error(batch_count, cpu_result, rocblas_result_1);
+            rocblas_error_2
+                = testing_fused_blas1_result_error(batch_count, cpu_result, rocblas_result_2);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_device, [&] {
+            rocblas_axpy_dot_batched_fn(handle,
+                                        N,
+                                        dalpha,
+                                        dx.ptr_on_device(),
+                                        incx,
+                                        dy.ptr_on_device(),
+                                        incy,
+                                        dz_ptr,
+                                        incz,
+                                        batch_count,
+                                        d_result);
+        });
+
+        ArgumentModel<e_N, e_alpha, e_incx, e_incy, e_incd, e_batch_count, e_algo>{}.log_args<T>(
+            rocblas_cout,
+            arg,
+            gpu_time_used,
+            axpy_gflop_count<T>(N) + dot_gflop_count<is_complex<T>, T>(N),
+            axpy_dot_gbyte_count<T>(N, arg.algo),
+            cpu_time_used,
+            rocblas_error_1,
+            rocblas_error_2);
+    }
+}
+
+template <typename T>
+void testing_axpy_dot_strided_batched_bad_arg(const Arguments& arg)
+{
+    auto rocblas_axpy_dot_strided_batched_fn = arg.fortran
+                                                   ? rocblas_axpy_dot_strided_batched<T, true>
+                                                   : rocblas_axpy_dot_strided_batched<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, incx = 1, incy = 1, incz = 1, batch_count = 2;
+    rocblas_stride       stridex = N, stridey = N, stridez = N;
+
+    T alpha = 0.6;
+
+    device_strided_batch_vector<T> dx(N, incx, stridex, batch_count),
+        dy(N, incy, stridey, batch_count), dz(N, incz, stridez, batch_count);
+    device_vector<T> d_result(batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(dz.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_strided_batched_fn(handle,
+                                                              N,
+                                                              &alpha,
+                                                              nullptr,
+                                                              incx,
+                                                              stridex,
+                                                              dy,
+                                                              incy,
+                                                              stridey,
+                                                              dz,
+                                                              incz,
+                                                              stridez,
+                                                              batch_count,
+                                                              d_result),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_strided_batched_fn(handle,
+                                                              N,
+                                                              &alpha,
+                                                              dx,
+                                                              incx,
+                                                              stridex,
+                                                              nullptr,
+                                                              incy,
+                                                              stridey,
+                                                              dz,
+                                                              incz,
+                                                              stridez,
+                                                              batch_count,
+                                                              d_result),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_strided_batched_fn(handle,
+                                                              N,
+                                                              &alpha,
+                                                              dx,
+                                                              incx,
+                                                              stridex,
+                                                              dy,
+                                                              incy,
+                                                              stridey,
+                                                              nullptr,
+                                                              incz,
+                                                              stridez,
+                                                              batch_count,
+                                                              d_result),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_strided_batched_fn(handle,
+                                                              N,
+                                                              &alpha,
+                                                              dx,
+                                                              incx,
+                                                              stridex,
+                                                              dy,
+                                                              incy,
+                                                              stridey,
+                                                              dz,
+                                                              incz,
+                                                              stridez,
+                                                              batch_count,
+                                                              nullptr),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_axpy_dot_strided_batched_fn(nullptr,
+                                                              N,
+                                                              &alpha,
+                                                              dx,
+                                                              incx,
+                                                              stridex,
+                                                              dy,
+                                                              incy,
+                                                              stridey,
+                                                              dz,
+                                                              incz,
+                                                              stridez,
+                                                              batch_count,
+                                                              d_result),
+                          rocblas_status_invalid_handle);
+}
+
+template <typename T>
+void testing_axpy_dot_strided_batched(const Arguments& arg)
+{
+    auto rocblas_axpy_dot_strided_batched_fn = arg.fortran
+                                                   ? rocblas_axpy_dot_strided_batched<T, true>
+                                                   : rocblas_axpy_dot_strided_batched<T, false>;
+
+    rocblas_int N = arg.N, incx = arg.incx, incy = arg.incy, batch_count = arg.batch_count;
+    rocblas_int incz    = arg.algo ? incy : arg.incd;
+    T           h_alpha = arg.get_alpha<T>();
+    rocblas_local_handle handle{arg};
+
+    rocblas_stride stridex = arg.stride_x, stridey = arg.stride_y;
+    if(!stridex)
+        stridex = N;
+    if(!stridey)
+        stridey = N;
+    rocblas_stride stridez = arg.algo ? stridey : arg.stride_d;
+    if(!stridez)
+        stridez = N * rocblas_stride(incz ? std::abs(incz) : 1);
+
+    // check to prevent undefined memory allocation error; the results are 0
+    if(N <= 0 || batch_count <= 0)
+    {
+        testing_fused_blas1_zero_results<T>(
+            handle, batch_count, rocblas_status_success, [&](auto d_result) {
+                return rocblas_axpy_dot_strided_batched_fn(handle,
+                                                           N,
+                                                           nullptr,
+                                                           nullptr,
+                                                           incx,
+                                                           stridex,
+                                                           nullptr,
+                                                           incy,
+                                                           stridey,
+                                                           nullptr,
+                                                           incz,
+                                                           stridez,
+                                                           batch_count,
+                                                           d_result);
+            });
+        return;
+    }
+
+    rocblas_int abs_incy = incy ? std::abs(incy) : 1;
+
+    host_strided_batch_vector<T> hx(N, incx ? incx : 1, stridex, batch_count),
+        hy(N, incy ? incy : 1, stridey, batch_count), hz(N, incz ? incz : 1, stridez, batch_count),
+        hy_1(N, incy ? incy : 1, stridey, batch_count),
+        hy_2(N, incy ? incy : 1, stridey, batch_count);
+    host_vector<T> halpha(1), cpu_result(batch_count), rocblas_result_1(batch_count),
+        rocblas_result_2(batch_count);
+    CHECK_HIP_ERROR(hx.memcheck());
+    CHECK_HIP_ERROR(hy.memcheck());
+    CHECK_HIP_ERROR(hz.memcheck());
+    CHECK_HIP_ERROR(hy_1.memcheck());
+    CHECK_HIP_ERROR(hy_2.memcheck());
+    halpha[0] = h_alpha;
+
+    device_strided_batch_vector<T> dx(N, incx ? incx : 1, stridex, batch_count),
+        dy(N, incy ? incy : 1, stridey, batch_count), dz(N, incz ? incz : 1, stridez, batch_count);
+    device_vector<T> dalpha(1), d_result(batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(dz.memcheck());
+    CHECK_DEVICE_ALLOCATION(dalpha.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    rocblas_init(hx, true);
+    rocblas_init(hy, false);
+    rocblas_init(hz, false);
+
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+    CHECK_HIP_ERROR(dz.transfer_from(hz));
+    CHECK_HIP_ERROR(dalpha.transfer_from(halpha));
+
+    T* dz_ptr = arg.algo ? (T*)dy : (T*)dz;
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_axpy_dot_strided_batched_fn(handle,
+                                                                N,
+                                                                &h_alpha,
+                                                                dx,
+                                                                incx,
+                                                                stridex,
+                                                                dy,
+                                                                incy,
+                                                                stridey,
+                                                                dz_ptr,
+                                                                incz,
+                                                                stridez,
+                                                                batch_count,
+                                                                rocblas_result_1));
+        CHECK_HIP_ERROR(hy_1.transfer_from(dy));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_HIP_ERROR(dy.transfer_from(hy));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_axpy_dot_strided_batched_fn(handle,
+                                                                N,
+                                                                dalpha,
+                                                                dx,
+                                                                incx,
+                                                                stridex,
+                                                                dy,
+                                                                incy,
+                                                                stridey,
+                                                                dz_ptr,
+                                                                incz,
+                                                                stridez,
+                                                                batch_count,
+                                                                d_result));
+        CHECK_HIP_ERROR(hy_2.transfer_from(dy));
+        CHECK_HIP_ERROR(rocblas_result_2.transfer_from(d_result));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; ++b)
+            ref_axpy_dot<T>(N,
+                            h_alpha,
+                            hx[b],
+                            incx,
+                            hy[b],
+                            incy,
+                            arg.algo ? hy[b] : hz[b],
+                            incz,
+                            cpu_result + b);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(1, N, abs_incy, stridey, hy, hy_1, batch_count);
+            unit_check_general<T>(1, N, abs_incy, stridey, hy, hy_2, batch_count);
+            unit_check_general<T>(1, 1, 1, 1, cpu_result, rocblas_result_1, batch_count);
+            unit_check_general<T>(1, 1, 1, 1, cpu_result, rocblas_result_2, batch_count);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1
+                = testing_fused_blas1_result_error(batch_count, cpu_result, rocblas_result_1);
+            rocblas_error_2
+                = testing_fused_blas1_result_error(batch_count, cpu_result, rocblas_result_2);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_device, [&] {
+            rocblas_axpy_dot_strided_batched_fn(handle,
+                                                N,
+                                                dalpha,
+                                                dx,
+                                                incx,
+                                                stridex,
+                                                dy,
+                                                incy,
+                                                stridey,
+                                                dz_ptr,
+                                                incz,
+                                                stridez,
+                                                batch_count,
+                                                d_result);
+        });
+
+        ArgumentModel<e_N,
+                      e_alpha,
+                      e_incx,
+                      e_stride_x,
+                      e_incy,
+                      e_stride_y,
+                      e_incd,
+                      e_stride_d,
+                      e_batch_count,
+                      e_algo>{}
+            .log_args<T>(rocblas_cout,
+                         arg,
+                         gpu_time_used,
+                         axpy_gflop_count<T>(N) + dot_gflop_count<is_complex<T>, T>(N),
+                         axpy_dot_gbyte_count<T>(N, arg.algo),
+                         cpu_time_used,
+                         rocblas_error_1,
+                         rocblas_error_2);
+    }
+}
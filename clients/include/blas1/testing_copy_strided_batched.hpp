@@ -161,7 +161,7 @@ void testing_copy_strided_batched(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_hot_calls; iter++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             rocblas_copy_strided_batched_fn(
                 handle, N, dx, incx, stride_x, dy, incy, stride_y, batch_count);
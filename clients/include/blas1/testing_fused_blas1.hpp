@@ -0,0 +1,71 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+// Steps shared by the tests of the fused BLAS1 functions axpby, axpy_dot, multi_dot and
+// scal_nrm2, in their non-batched, batched and strided batched forms. The function under
+// test is passed as a lambda which makes the call.
+
+// Check that a call without work returns status, and in device pointer mode sets its count
+// results to 0. call takes the device array of results.
+template <typename R, typename F>
+void testing_fused_blas1_zero_results(rocblas_handle handle,
+                                      rocblas_int    count,
+                                      rocblas_status status,
+                                      F              call)
+{
+    device_vector<R> d_results(std::max(count, 1));
+    CHECK_DEVICE_ALLOCATION(d_results.memcheck());
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+    EXPECT_ROCBLAS_STATUS(call((R*)d_results), status);
+
+    if(count > 0)
+    {
+        host_vector<R> cpu_0(count), gpu_0(count);
+        CHECK_HIP_ERROR(gpu_0.transfer_from(d_results));
+        unit_check_general<R>(1, count, 1, cpu_0, gpu_0);
+    }
+}
+
+// Sum of the relative errors of count results
+template <typename R>
+double testing_fused_blas1_result_error(rocblas_int           count,
+                                        const host_vector<R>& cpu_results,
+                                        const host_vector<R>& results)
+{
+    double error = 0.0;
+    for(rocblas_int i = 0; i < count; ++i)
+        error += rocblas_abs((cpu_results[i] - results[i]) / cpu_results[i]);
+    return error;
+}
+
+// Time arg.iters calls in pointer mode mode, after arg.cold_iters calls, in microseconds
+template <typename F>
+double testing_fused_blas1_timing(const Arguments&     arg,
+                                  rocblas_handle       handle,
+                                  rocblas_pointer_mode mode,
+                                  F                    call)
+{
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, mode));
+
+    for(int iter = 0; iter < arg.cold_iters; iter++)
+        call();
+
+    hipStream_t stream;
+    CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+    double gpu_time_used = get_time_us_sync(stream); // in microseconds
+
+    for(rocblas_hot_iterations hot(arg.iters, stream); hot.next();)
+        call();
+
+    return get_time_us_sync(stream) - gpu_time_used;
+}
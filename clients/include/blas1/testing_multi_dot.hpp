@@ -0,0 +1,546 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "bytes.hpp"
+#include "cblas_interface.hpp"
+#include "flops.hpp"
+#include "norm.hpp"
+#include "rocblas.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "testing_fused_blas1.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+// Reference results[j] := x^H * y_j, with y_j = y + j * ldy, from cblas dot (dotc for complex)
+template <typename T>
+void ref_multi_dot(rocblas_int n,
+                   rocblas_int k,
+                   const T*    x,
+                   rocblas_int incx,
+                   const T*    y,
+                   rocblas_int incy,
+                   rocblas_int ldy,
+                   T*          results)
+{
+    for(rocblas_int j = 0; j < k; ++j)
+    {
+        if constexpr(is_complex<T>)
+            cblas_dotc<T>(n, x, incx, y + size_t(j) * ldy, incy, results + j);
+        else
+            cblas_dot<T>(n, x, incx, y + size_t(j) * ldy, incy, results + j);
+    }
+}
+
+// In the tests below, k is arg.K and ldy is arg.lda, raised to n * |incy| if it is smaller
+
+template <typename T>
+void testing_multi_dot_bad_arg(const Arguments& arg)
+{
+    auto rocblas_multi_dot_fn
+        = arg.fortran ? rocblas_multi_dot<T, true> : rocblas_multi_dot<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, K = 4, incx = 1, incy = 1, ldy = N;
+
+    device_vector<T> dx(N), dy(size_t(ldy) * K), d_results(K);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_results.memcheck());
+
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_fn(handle, N, K, nullptr, incx, dy, incy, ldy, d_results),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_fn(handle, N, K, dx, incx, nullptr, incy, ldy, d_results),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_multi_dot_fn(handle, N, K, dx, incx, dy, incy, ldy, nullptr),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_fn(nullptr, N, K, dx, incx, dy, incy, ldy, d_results),
+        rocblas_status_invalid_handle);
+
+    // k must not be negative, and the vectors y_j must not overlap
+    EXPECT_ROCBLAS_STATUS(rocblas_multi_dot_fn(handle, N, -1, dx, incx, dy, incy, ldy, d_results),
+                          rocblas_status_invalid_size);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_fn(handle, N, K, dx, incx, dy, incy, ldy - 1, d_results),
+        rocblas_status_invalid_size);
+
+    // When K==0, all pointers can be nullptr without error
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_fn(handle, N, 0, nullptr, incx, nullptr, incy, ldy, nullptr),
+        rocblas_status_success);
+}
+
+template <typename T>
+void testing_multi_dot(const Arguments& arg)
+{
+    auto rocblas_multi_dot_fn
+        = arg.fortran ? rocblas_multi_dot<T, true> : rocblas_multi_dot<T, false>;
+
+    rocblas_int N = arg.N, K = arg.K, incx = arg.incx, incy = arg.incy;
+    rocblas_int ldy = std::max(arg.lda, N * (incy ? std::abs(incy) : 1));
+    rocblas_local_handle handle{arg};
+
+    // check to prevent undefined memory allocation error; the results are 0
+    if(N <= 0 || K <= 0)
+    {
+        rocblas_status status = K < 0 ? rocblas_status_invalid_size : rocblas_status_success;
+        testing_fused_blas1_zero_results<T>(handle, K, status, [&](auto d_results) {
+            return rocblas_multi_dot_fn(handle, N, K, nullptr, incx, nullptr, incy, ldy, d_results);
+        });
+        return;
+    }
+
+    rocblas_int abs_incx = incx ? std::abs(incx) : 1;
+    size_t      size_x   = N * size_t(abs_incx);
+    size_t      size_y   = size_t(ldy) * K;
+
+    host_vector<T> hx(size_x), hy(size_y);
+    host_vector<T> cpu_results(K), rocblas_results_1(K), rocblas_results_2(K);
+
+    device_vector<T> dx(size_x), dy(size_y), d_results(K);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_results.memcheck());
+
+    rocblas_init<T>(hx, 1, N, abs_incx);
+    rocblas_init<T>(hy, 1, size_y, 1);
+
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+    CHECK_HIP_ERROR(dy.transfer_from(hy));
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(
+            rocblas_multi_dot_fn(handle, N, K, dx, incx, dy, incy, ldy, rocblas_results_1));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(
+            rocblas_multi_dot_fn(handle, N, K, dx, incx, dy, incy, ldy, d_results));
+        CHECK_HIP_ERROR(rocblas_results_2.transfer_from(d_results));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        ref_multi_dot<T>(N, K, hx, incx, hy, incy, ldy, cpu_results);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(1, K, 1, cpu_results, rocblas_results_1);
+            unit_check_general<T>(1, K, 1, cpu_results, rocblas_results_2);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1 = norm_check_general<T>('F', 1, K, 1, cpu_results, rocblas_results_1);
+            rocblas_error_2 = norm_check_general<T>('F', 1, K, 1, cpu_results, rocblas_results_2);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_device, [&] {
+            rocblas_multi_dot_fn(handle, N, K, dx, incx, dy, incy, ldy, d_results);
+        });
+
+        ArgumentModel<e_N, e_K, e_incx, e_incy, e_lda>{}.log_args<T>(
+            rocblas_cout,
+            arg,
+            gpu_time_used,
+            K * dot_gflop_count<is_complex<T>, T>(N),
+            multi_dot_gbyte_count<T>(N, K),
+            cpu_time_used,
+            rocblas_error_1,
+            rocblas_error_2);
+    }
+}
+
+template <typename T>
+void testing_multi_dot_batched_bad_arg(const Arguments& arg)
+{
+    auto rocblas_multi_dot_batched_fn
+        = arg.fortran ? rocblas_multi_dot_batched<T, true> : rocblas_multi_dot_batched<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, K = 4, incx = 1, incy = 1, ldy = N, batch_count = 2;
+
+    device_batch_vector<T> dx(N, incx, batch_count), dy(ldy * K, 1, batch_count);
+    device_vector<T>       d_results(K * batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_results.memcheck());
+
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_batched_fn(
+            handle, N, K, nullptr, incx, dy.ptr_on_device(), incy, ldy, batch_count, d_results),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_batched_fn(
+            handle, N, K, dx.ptr_on_device(), incx, nullptr, incy, ldy, batch_count, d_results),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_multi_dot_batched_fn(handle,
+                                                       N,
+                                                       K,
+                                                       dx.ptr_on_device(),
+                                                       incx,
+                                                       dy.ptr_on_device(),
+                                                       incy,
+                                                       ldy,
+                                                       batch_count,
+                                                       nullptr),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_multi_dot_batched_fn(nullptr,
+                                                       N,
+                                                       K,
+                                                       dx.ptr_on_device(),
+                                                       incx,
+                                                       dy.ptr_on_device(),
+                                                       incy,
+                                                       ldy,
+                                                       batch_count,
+                                                       d_results),
+                          rocblas_status_invalid_handle);
+    EXPECT_ROCBLAS_STATUS(rocblas_multi_dot_batched_fn(handle,
+                                                       N,
+                                                       K,
+                                                       dx.ptr_on_device(),
+                                                       incx,
+                                                       dy.ptr_on_device(),
+                                                       incy,
+                                                       ldy - 1,
+                                                       batch_count,
+                                                       d_results),
+                          rocblas_status_invalid_size);
+}
+
+template <typename T>
+void testing_multi_dot_batched(const Arguments& arg)
+{
+    auto rocblas_multi_dot_batched_fn
+        = arg.fortran ? rocblas_multi_dot_batched<T, true> : rocblas_multi_dot_batched<T, false>;
+
+    rocblas_int N = arg.N, K = arg.K, incx = arg.incx, incy = arg.incy;
+    rocblas_int ldy         = std::max(arg.lda, N * (incy ? std::abs(incy) : 1));
+    rocblas_int batch_count = arg.batch_count;
+    rocblas_local_handle handle{arg};
+
+    // check to prevent undefined memory allocation error; the results are 0
+    if(N <= 0 || K <= 0 || batch_count <= 0)
+    {
+        rocblas_int    count  = std::max(K, 0) * batch_count;
+        rocblas_status status = K < 0 ? rocblas_status_invalid_size : rocblas_status_success;
+        testing_fused_blas1_zero_results<T>(handle, count, status, [&](auto d_results) {
+            return rocblas_multi_dot_batched_fn(
+                handle, N, K, nullptr, incx, nullptr, incy, ldy, batch_count, d_results);
+        });
+        return;
+    }
+
+    size_t size_results = size_t(K) * batch_count;
+
+    host_batch_vector<T> hx(N, incx ? incx : 1, batch_count), hy(ldy * K, 1, batch_count);
+    host_vector<T>       cpu_results(size_results), rocblas_results_1(size_results),
+        rocblas_results_2(size_results);
+    CHECK_HIP_ERROR(hx.memcheck());
+    CHECK_HIP_ERROR(hy.memcheck());
+
+    device_batch_vector<T> dx(N, incx ? incx : 1, batch_count), dy(ldy * K, 1, batch_count);
+    device_vector<T>       d_results(size_results);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_results.memcheck());
+
+    rocblas_init(hx, true);
+    rocblas_init(hy, false);
+
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+    CHECK_HIP_ERROR(dy.transfer_from(hy));
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_multi_dot_batched_fn(handle,
+                                                         N,
+                                                         K,
+                                                         dx.ptr_on_device(),
+                                                         incx,
+                                                         dy.ptr_on_device(),
+                                                         incy,
+                                                         ldy,
+                                                         batch_count,
+                                                         rocblas_results_1));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_multi_dot_batched_fn(handle,
+                                                         N,
+                                                         K,
+                                                         dx.ptr_on_device(),
+                                                         incx,
+                                                         dy.ptr_on_device(),
+                                                         incy,
+                                                         ldy,
+                                                         batch_count,
+                                                         d_results));
+        CHECK_HIP_ERROR(rocblas_results_2.transfer_from(d_results));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; ++b)
+            ref_multi_dot<T>(N, K, hx[b], incx, hy[b], incy, ldy, cpu_results + size_t(b) * K);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(1, K, 1, K, cpu_results, rocblas_results_1, batch_count);
+            unit_check_general<T>(1, K, 1, K, cpu_results, rocblas_results_2, batch_count);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1 = norm_check_general<T>(
+                'F', 1, K, 1, K, cpu_results, rocblas_results_1, batch_count);
+            rocblas_error_2 = norm_check_general<T>(
+                'F', 1, K, 1, K, cpu_results, rocblas_results_2, batch_count);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_device, [&] {
+            rocblas_multi_dot_batched_fn(handle,
+                                         N,
+                                         K,
+                                         dx.ptr_on_device(),
+                                         incx,
+                                         dy.ptr_on_device(),
+                                         incy,
+                                         ldy,
+                                         batch_count,
+                                         d_results);
+        });
+
+        ArgumentModel<e_N, e_K, e_incx, e_incy, e_lda, e_batch_count>{}.log_args<T>(
+            rocblas_cout,
+            arg,
+            gpu_time_used,
+            K * dot_gflop_count<is_complex<T>, T>(N),
+            multi_dot_gbyte_count<T>(N, K),
+            cpu_time_used,
+            rocblas_error_1,
+            rocblas_error_2);
+    }
+}
+
+template <typename T>
+void testing_multi_dot_strided_batched_bad_arg(const Arguments& arg)
+{
+    auto rocblas_multi_dot_strided_batched_fn = arg.fortran
+                                                    ? rocblas_multi_dot_strided_batched<T, true>
+                                                    : rocblas_multi_dot_strided_batched<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, K = 4, incx = 1, incy = 1, ldy = N, batch_count = 2;
+    rocblas_stride       stridex = N, stridey = ldy * K;
+
+    device_strided_batch_vector<T> dx(N, incx, stridex, batch_count),
+        dy(ldy * K, 1, stridey, batch_count);
+    device_vector<T> d_results(K * batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_results.memcheck());
+
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_strided_batched_fn(
+            handle, N, K, nullptr, incx, stridex, dy, incy, ldy, stridey, batch_count, d_results),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_strided_batched_fn(
+            handle, N, K, dx, incx, stridex, nullptr, incy, ldy, stridey, batch_count, d_results),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_strided_batched_fn(
+            handle, N, K, dx, incx, stridex, dy, incy, ldy, stridey, batch_count, nullptr),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_strided_batched_fn(
+            nullptr, N, K, dx, incx, stridex, dy, incy, ldy, stridey, batch_count, d_results),
+        rocblas_status_invalid_handle);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_multi_dot_strided_batched_fn(
+            handle, N, K, dx, incx, stridex, dy, incy, ldy - 1, stridey, batch_count, d_results),
+        rocblas_status_invalid_size);
+}
+
+template <typename T>
+void testing_multi_dot_strided_batched(const Arguments& arg)
+{
+    auto rocblas_multi_dot_strided_batched_fn = arg.fortran
+                                                    ? rocblas_multi_dot_strided_batched<T, true>
+                                                    : rocblas_multi_dot_strided_batched<T, false>;
+
+    rocblas_int N = arg.N, K = arg.K, incx = arg.incx, incy = arg.incy;
+    rocblas_int ldy         = std::max(arg.lda, N * (incy ? std::abs(incy) : 1));
+    rocblas_int batch_count = arg.batch_count;
+    rocblas_local_handle handle{arg};
+
+    rocblas_stride stridex = std::max(rocblas_stride(arg.stride_x), rocblas_stride(N));
+    rocblas_stride stridey
+        = std::max(rocblas_stride(arg.stride_y), rocblas_stride(ldy) * std::max(K, 1));
+
+    // check to prevent undefined memory allocation error; the results are 0
+    if(N <= 0 || K <= 0 || batch_count <= 0)
+    {
+        rocblas_int    count  = std::max(K, 0) * batch_count;
+        rocblas_status status = K < 0 ? rocblas_status_invalid_size : rocblas_status_success;
+        testing_fused_blas1_zero_results<T>(handle, count, status, [&](auto d_results) {
+            return rocblas_multi_dot_strided_batched_fn(handle,
+                                                        N,
+                                                        K,
+                                                        nullptr,
+                                                        incx,
+                                                        stridex,
+                                                        nullptr,
+                                                        incy,
+                                                        ldy,
+                                                        stridey,
+                                                        batch_count,
+                                                        d_results);
+        });
+        return;
+    }
+
+    size_t size_results = size_t(K) * batch_count;
+
+    host_strided_batch_vector<T> hx(N, incx ? incx : 1, stridex, batch_count),
+        hy(ldy * K, 1, stridey, batch_count);
+    host_vector<T> cpu_results(size_results), rocblas_results_1(size_results),
+        rocblas_results_2(size_results);
+    CHECK_HIP_ERROR(hx.memcheck());
+    CHECK_HIP_ERROR(hy.memcheck());
+
+    device_strided_batch_vector<T> dx(N, incx ? incx : 1, stridex, batch_count),
+        dy(ldy * K, 1, stridey, batch_count);
+    device_vector<T> d_results(size_results);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_results.memcheck());
+
+    rocblas_init(hx, true);
+    rocblas_init(hy, false);
+
+    CHECK_HIP_ERROR(dx.transfer_from(hx));
+    CHECK_HIP_ERROR(dy.transfer_from(hy));
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_multi_dot_strided_batched_fn(handle,
+                                                                 N,
+                                                                 K,
+                                                                 dx,
+                                                                 incx,
+                                                                 stridex,
+                                                                 dy,
+                                                                 incy,
+                                                                 ldy,
+                                                                 stridey,
+                                                                 batch_count,
+                                                                 rocblas_results_1));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_multi_dot_strided_batched_fn(handle,
+                                                                 N,
+                                                                 K,
+                                                                 dx,
+                                                                 incx,
+                                                                 stridex,
+                                                                 dy,
+                                                                 incy,
+                                                                 ldy,
+                                                                 stridey,
+                                                                 batch_count,
+                                                                 d_results));
+        CHECK_HIP_ERROR(rocblas_results_2.transfer_from(d_results));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; ++b)
+            ref_multi_dot<T>(N, K, hx[b], incx, hy[b], incy, ldy, cpu_results + size_t(b) * K);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(1, K, 1, K, cpu_results, rocblas_results_1, batch_count);
+            unit_check_general<T>(1, K, 1, K, cpu_results, rocblas_results_2, batch_count);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1 = norm_check_general<T>(
+                'F', 1, K, 1, K, cpu_results, rocblas_results_1, batch_count);
+            rocblas_error_2 = norm_check_general<T>(
+                'F', 1, K, 1, K, cpu_results, rocblas_results_2, batch_count);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_device, [&] {
+            rocblas_multi_dot_strided_batched_fn(handle,
+                                                 N,
+                                                 K,
+                                                 dx,
+                                                 incx,
+                                                 stridex,
+                                                 dy,
+                                                 incy,
+                                                 ldy,
+                                                 stridey,
+                                                 batch_count,
+                                                 d_results);
+        });
+
+        ArgumentModel<e_N, e_K, e_incx, e_stride_x, e_incy, e_lda, e_stride_y, e_batch_count>{}
+            .log_args<T>(rocblas_cout,
+                         arg,
+                         gpu_time_used,
+                         K * dot_gflop_count<is_complex<T>, T>(N),
+                         multi_dot_gbyte_count<T>(N, K),
+                         cpu_time_used,
+                         rocblas_error_1,
+                         rocblas_error_2);
+    }
+}
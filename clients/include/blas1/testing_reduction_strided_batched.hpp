@@ -179,7 +179,7 @@ void template_testing_reduction_strided_batched(
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_hot_calls; iter++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             func(handle, N, dx, incx, stridex, batch_count, hr2);
         }
@@ -129,7 +129,7 @@ void testing_rotmg(const Arguments& arg)
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int iter = 0; iter < number_hot_calls; ++iter)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             hparams = params;
             rocblas_rotgm_fn(
@@ -0,0 +1,448 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "bytes.hpp"
+#include "cblas_interface.hpp"
+#include "flops.hpp"
+#include "near.hpp"
+#include "norm.hpp"
+#include "rocblas.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "testing_fused_blas1.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+// Reference x := alpha * x; result := ||x||_2, from cblas scal and nrm2
+template <typename T>
+void ref_scal_nrm2(rocblas_int n, T alpha, T* x, rocblas_int incx, real_t<T>* result)
+{
+    cblas_scal(n, alpha, x, incx);
+    cblas_nrm2<T>(n, x, incx, result);
+}
+
+// As in the nrm2 tests, the error allowed for rounding in the reduction sum grows with n
+template <typename T>
+real_t<T> scal_nrm2_abs_error(rocblas_int n, real_t<T> cpu_result)
+{
+    real_t<T> abs_result = cpu_result > 0 ? cpu_result : -cpu_result;
+    real_t<T> tolerance  = 2.0;
+    return std::numeric_limits<real_t<T>>::epsilon() * n * (abs_result > 0 ? abs_result : 1)
+           * tolerance;
+}
+
+template <typename T>
+void testing_scal_nrm2_bad_arg(const Arguments& arg)
+{
+    auto rocblas_scal_nrm2_fn
+        = arg.fortran ? rocblas_scal_nrm2<T, true> : rocblas_scal_nrm2<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, incx = 1;
+
+    T         alpha = 0.6;
+    real_t<T> result;
+
+    device_vector<T> dx(N * incx);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+
+    EXPECT_ROCBLAS_STATUS(rocblas_scal_nrm2_fn(handle, N, nullptr, dx, incx, &result),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_scal_nrm2_fn(handle, N, &alpha, nullptr, incx, &result),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_scal_nrm2_fn(handle, N, &alpha, dx, incx, nullptr),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_scal_nrm2_fn(nullptr, N, &alpha, dx, incx, &result),
+                          rocblas_status_invalid_handle);
+}
+
+template <typename T>
+void testing_scal_nrm2(const Arguments& arg)
+{
+    auto rocblas_scal_nrm2_fn
+        = arg.fortran ? rocblas_scal_nrm2<T, true> : rocblas_scal_nrm2<T, false>;
+
+    rocblas_int          N = arg.N, incx = arg.incx;
+    T                    h_alpha = arg.get_alpha<T>();
+    rocblas_local_handle handle{arg};
+
+    // check to prevent undefined memory allocation error; the result is 0
+    if(N <= 0 || incx <= 0)
+    {
+        testing_fused_blas1_zero_results<real_t<T>>(
+            handle, 1, rocblas_status_success, [&](auto d_result) {
+                return rocblas_scal_nrm2_fn(handle, N, nullptr, nullptr, incx, d_result);
+            });
+        return;
+    }
+
+    size_t size_x = N * size_t(incx);
+
+    host_vector<T>         hx(size_x), hx_1(size_x), hx_2(size_x), halpha(1);
+    host_vector<real_t<T>> cpu_result(1), rocblas_result_1(1), rocblas_result_2(1);
+    halpha[0] = h_alpha;
+
+    device_vector<T>         dx(size_x), dalpha(1);
+    device_vector<real_t<T>> d_result(1);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dalpha.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    rocblas_init<T>(hx, 1, N, incx);
+    CHECK_HIP_ERROR(dalpha.transfer_from(halpha));
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_HIP_ERROR(dx.transfer_from(hx));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_scal_nrm2_fn(handle, N, &h_alpha, dx, incx, rocblas_result_1));
+        CHECK_HIP_ERROR(hx_1.transfer_from(dx));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_HIP_ERROR(dx.transfer_from(hx));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_scal_nrm2_fn(handle, N, dalpha, dx, incx, d_result));
+        CHECK_HIP_ERROR(hx_2.transfer_from(dx));
+        CHECK_HIP_ERROR(rocblas_result_2.transfer_from(d_result));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        ref_scal_nrm2<T>(N, h_alpha, hx, incx, cpu_result);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            real_t<T> abs_error = scal_nrm2_abs_error<T>(N, cpu_result[0]);
+            unit_check_general<T>(1, N, incx, hx, hx_1);
+            unit_check_general<T>(1, N, incx, hx, hx_2);
+            near_check_general<real_t<T>, real_t<T>>(
+                1, 1, 1, cpu_result, rocblas_result_1, abs_error);
+            near_check_general<real_t<T>, real_t<T>>(
+                1, 1, 1, cpu_result, rocblas_result_2, abs_error);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1 = testing_fused_blas1_result_error(1, cpu_result, rocblas_result_1);
+            rocblas_error_2 = testing_fused_blas1_result_error(1, cpu_result, rocblas_result_2);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_device, [&] {
+            rocblas_scal_nrm2_fn(handle, N, dalpha, dx, incx, d_result);
+        });
+
+        ArgumentModel<e_N, e_alpha, e_incx>{}.log_args<T>(rocblas_cout,
+                                                          arg,
+                                                          gpu_time_used,
+                                                          scal_gflop_count<T, T>(N)
+                                                              + nrm2_gflop_count<T>(N),
+                                                          scal_gbyte_count<T>(N),
+                                                          cpu_time_used,
+                                                          rocblas_error_1,
+                                                          rocblas_error_2);
+    }
+}
+
+template <typename T>
+void testing_scal_nrm2_batched_bad_arg(const Arguments& arg)
+{
+    auto rocblas_scal_nrm2_batched_fn
+        = arg.fortran ? rocblas_scal_nrm2_batched<T, true> : rocblas_scal_nrm2_batched<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, incx = 1, batch_count = 2;
+
+    T alpha = 0.6;
+
+    device_batch_vector<T>   dx(N, incx, batch_count);
+    device_vector<real_t<T>> d_result(batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_scal_nrm2_batched_fn(
+            handle, N, nullptr, dx.ptr_on_device(), incx, batch_count, d_result),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_scal_nrm2_batched_fn(handle, N, &alpha, nullptr, incx, batch_count, d_result),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_scal_nrm2_batched_fn(
+            handle, N, &alpha, dx.ptr_on_device(), incx, batch_count, nullptr),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_scal_nrm2_batched_fn(
+            nullptr, N, &alpha, dx.ptr_on_device(), incx, batch_count, d_result),
+        rocblas_status_invalid_handle);
+}
+
+template <typename T>
+void testing_scal_nrm2_batched(const Arguments& arg)
+{
+    auto rocblas_scal_nrm2_batched_fn
+        = arg.fortran ? rocblas_scal_nrm2_batched<T, true> : rocblas_scal_nrm2_batched<T, false>;
+
+    rocblas_int          N = arg.N, incx = arg.incx, batch_count = arg.batch_count;
+    T                    h_alpha = arg.get_alpha<T>();
+    rocblas_local_handle handle{arg};
+
+    // check to prevent undefined memory allocation error; the results are 0
+    if(N <= 0 || incx <= 0 || batch_count <= 0)
+    {
+        testing_fused_blas1_zero_results<real_t<T>>(
+            handle, batch_count, rocblas_status_success, [&](auto d_result) {
+                return rocblas_scal_nrm2_batched_fn(
+                    handle, N, nullptr, nullptr, incx, batch_count, d_result);
+            });
+        return;
+    }
+
+    host_batch_vector<T> hx(N, incx, batch_count), hx_1(N, incx, batch_count),
+        hx_2(N, incx, batch_count);
+    host_vector<T>         halpha(1);
+    host_vector<real_t<T>> cpu_result(batch_count), rocblas_result_1(batch_count),
+        rocblas_result_2(batch_count);
+    CHECK_HIP_ERROR(hx.memcheck());
+    CHECK_HIP_ERROR(hx_1.memcheck());
+    CHECK_HIP_ERROR(hx_2.memcheck());
+    halpha[0] = h_alpha;
+
+    device_batch_vector<T>   dx(N, incx, batch_count);
+    device_vector<T>         dalpha(1);
+    device_vector<real_t<T>> d_result(batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dalpha.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    rocblas_init(hx, true);
+    CHECK_HIP_ERROR(dalpha.transfer_from(halpha));
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_HIP_ERROR(dx.transfer_from(hx));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_scal_nrm2_batched_fn(
+            handle, N, &h_alpha, dx.ptr_on_device(), incx, batch_count, rocblas_result_1));
+        CHECK_HIP_ERROR(hx_1.transfer_from(dx));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_HIP_ERROR(dx.transfer_from(hx));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_scal_nrm2_batched_fn(
+            handle, N, dalpha, dx.ptr_on_device(), incx, batch_count, d_result));
+        CHECK_HIP_ERROR(hx_2.transfer_from(dx));
+        CHECK_HIP_ERROR(rocblas_result_2.transfer_from(d_result));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; ++b)
+            ref_scal_nrm2<T>(N, h_alpha, hx[b], incx, cpu_result + b);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            real_t<T> abs_error = scal_nrm2_abs_error<T>(N, cpu_result[0]);
+            unit_check_general<T>(1, N, incx, hx, hx_1, batch_count);
+            unit_check_general<T>(1, N, incx, hx, hx_2, batch_count);
+            near_check_general<real_t<T>, real_t<T>>(
+                batch_count, 1, 1, cpu_result, rocblas_result_1, abs_error);
+            near_check_general<real_t<T>, real_t<T>>(
+                batch_count, 1, 1, cpu_result, rocblas_result_2, abs_error);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1
+                = testing_fused_blas1_result_error(batch_count, cpu_result, rocblas_result_1);
+            rocblas_error_2
+                = testing_fused_blas1_result_error(batch_count, cpu_result, rocblas_result_2);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_device, [&] {
+            rocblas_scal_nrm2_batched_fn(
+                handle, N, dalpha, dx.ptr_on_device(), incx, batch_count, d_result);
+        });
+
+        ArgumentModel<e_N, e_alpha, e_incx, e_batch_count>{}.log_args<T>(
+            rocblas_cout,
+            arg,
+            gpu_time_used,
+            scal_gflop_count<T, T>(N) + nrm2_gflop_count<T>(N),
+            scal_gbyte_count<T>(N),
+            cpu_time_used,
+            rocblas_error_1,
+            rocblas_error_2);
+    }
+}
+
+template <typename T>
+void testing_scal_nrm2_strided_batched_bad_arg(const Arguments& arg)
+{
+    auto rocblas_scal_nrm2_strided_batched_fn = arg.fortran
+                                                    ? rocblas_scal_nrm2_strided_batched<T, true>
+                                                    : rocblas_scal_nrm2_strided_batched<T, false>;
+
+    rocblas_local_handle handle{arg};
+    rocblas_int          N = 100, incx = 1, batch_count = 2;
+    rocblas_stride       stridex = N;
+
+    T alpha = 0.6;
+
+    device_strided_batch_vector<T> dx(N, incx, stridex, batch_count);
+    device_vector<real_t<T>>       d_result(batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_scal_nrm2_strided_batched_fn(
+            handle, N, nullptr, dx, incx, stridex, batch_count, d_result),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(
+        rocblas_scal_nrm2_strided_batched_fn(
+            handle, N, &alpha, nullptr, incx, stridex, batch_count, d_result),
+        rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_scal_nrm2_strided_batched_fn(
+                              handle, N, &alpha, dx, incx, stridex, batch_count, nullptr),
+                          rocblas_status_invalid_pointer);
+    EXPECT_ROCBLAS_STATUS(rocblas_scal_nrm2_strided_batched_fn(
+                              nullptr, N, &alpha, dx, incx, stridex, batch_count, d_result),
+                          rocblas_status_invalid_handle);
+}
+
+template <typename T>
+void testing_scal_nrm2_strided_batched(const Arguments& arg)
+{
+    auto rocblas_scal_nrm2_strided_batched_fn = arg.fortran
+                                                    ? rocblas_scal_nrm2_strided_batched<T, true>
+                                                    : rocblas_scal_nrm2_strided_batched<T, false>;
+
+    rocblas_int          N = arg.N, incx = arg.incx, batch_count = arg.batch_count;
+    T                    h_alpha = arg.get_alpha<T>();
+    rocblas_local_handle handle{arg};
+
+    rocblas_stride stridex = arg.stride_x;
+    if(!stridex)
+        stridex = N;
+
+    // check to prevent undefined memory allocation error; the results are 0
+    if(N <= 0 || incx <= 0 || batch_count <= 0)
+    {
+        testing_fused_blas1_zero_results<real_t<T>>(
+            handle, batch_count, rocblas_status_success, [&](auto d_result) {
+                return rocblas_scal_nrm2_strided_batched_fn(
+                    handle, N, nullptr, nullptr, incx, stridex, batch_count, d_result);
+            });
+        return;
+    }
+
+    host_strided_batch_vector<T> hx(N, incx, stridex, batch_count),
+        hx_1(N, incx, stridex, batch_count), hx_2(N, incx, stridex, batch_count);
+    host_vector<T>         halpha(1);
+    host_vector<real_t<T>> cpu_result(batch_count), rocblas_result_1(batch_count),
+        rocblas_result_2(batch_count);
+    CHECK_HIP_ERROR(hx.memcheck());
+    CHECK_HIP_ERROR(hx_1.memcheck());
+    CHECK_HIP_ERROR(hx_2.memcheck());
+    halpha[0] = h_alpha;
+
+    device_strided_batch_vector<T> dx(N, incx, stridex, batch_count);
+    device_vector<T>               dalpha(1);
+    device_vector<real_t<T>>       d_result(batch_count);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dalpha.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_result.memcheck());
+
+    rocblas_init(hx, true);
+    CHECK_HIP_ERROR(dalpha.transfer_from(halpha));
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error_1 = 0.0;
+    double rocblas_error_2 = 0.0;
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // GPU BLAS, rocblas_pointer_mode_host
+        CHECK_HIP_ERROR(dx.transfer_from(hx));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_ROCBLAS_ERROR(rocblas_scal_nrm2_strided_batched_fn(
+            handle, N, &h_alpha, dx, incx, stridex, batch_count, rocblas_result_1));
+        CHECK_HIP_ERROR(hx_1.transfer_from(dx));
+
+        // GPU BLAS, rocblas_pointer_mode_device
+        CHECK_HIP_ERROR(dx.transfer_from(hx));
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_ROCBLAS_ERROR(rocblas_scal_nrm2_strided_batched_fn(
+            handle, N, dalpha, dx, incx, stridex, batch_count, d_result));
+        CHECK_HIP_ERROR(hx_2.transfer_from(dx));
+        CHECK_HIP_ERROR(rocblas_result_2.transfer_from(d_result));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; ++b)
+            ref_scal_nrm2<T>(N, h_alpha, hx[b], incx, cpu_result + b);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            real_t<T> abs_error = scal_nrm2_abs_error<T>(N, cpu_result[0]);
+            unit_check_general<T>(1, N, incx, stridex, hx, hx_1, batch_count);
+            unit_check_general<T>(1, N, incx, stridex, hx, hx_2, batch_count);
+            near_check_general<real_t<T>, real_t<T>>(
+                batch_count, 1, 1, cpu_result, rocblas_result_1, abs_error);
+            near_check_general<real_t<T>, real_t<T>>(
+                batch_count, 1, 1, cpu_result, rocblas_result_2, abs_error);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error_1
+                = testing_fused_blas1_result_error(batch_count, cpu_result, rocblas_result_1);
+            rocblas_error_2
+                = testing_fused_blas1_result_error(batch_count, cpu_result, rocblas_result_2);
+        }
+    }
+
+    if(arg.timing)
+    {
+        gpu_time_used = testing_fused_blas1_timing(arg, handle, rocblas_pointer_mode_device, [&] {
+            rocblas_scal_nrm2_strided_batched_fn(
+                handle, N, dalpha, dx, incx, stridex, batch_count, d_result);
+        });
+
+        ArgumentModel<e_N, e_alpha, e_incx, e_stride_x, e_batch_count>{}.log_args<T>(
+            rocblas_cout,
+            arg,
+            gpu_time_used,
+            scal_gflop_count<T, T>(N) + nrm2_gflop_count<T>(N),
+            scal_gbyte_count<T>(N),
+            cpu_time_used,
+            rocblas_error_1,
+            rocblas_error_2);
+    }
+}
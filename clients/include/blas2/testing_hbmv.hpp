@@ -237,7 +237,7 @@ void testing_hbmv(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_hot_calls; iter++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             rocblas_hbmv_fn(handle, uplo, N, K, &h_alpha, dA, lda, dx, incx, &h_beta, dy_1, incy);
         }
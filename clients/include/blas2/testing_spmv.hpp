@@ -220,7 +220,7 @@ void testing_spmv(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_hot_calls; iter++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             CHECK_ROCBLAS_ERROR(
                 rocblas_spmv_fn(handle, uplo, N, alpha, dA, dx, incx, beta, dy, incy));
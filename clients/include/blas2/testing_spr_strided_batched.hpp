@@ -196,7 +196,7 @@ void testing_spr_strided_batched(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_hot_calls; iter++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             rocblas_spr_strided_batched_fn(
                 handle, uplo, N, &h_alpha, dx, incx, stride_x, dA_1, stride_A, batch_count);
@@ -198,7 +198,7 @@ void testing_tbsv(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int i = 0; i < number_hot_calls; i++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
             rocblas_tbsv_fn(handle, uplo, transA, diag, N, K, dAB, lda, dx_or_b, incx);
 
         gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
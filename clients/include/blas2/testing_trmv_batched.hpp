@@ -211,7 +211,7 @@ void testing_trmv_batched(const Arguments& arg)
             CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
             gpu_time_used        = get_time_us_sync(stream); // in microseconds
             int number_hot_calls = arg.iters;
-            for(int iter = 0; iter < number_hot_calls; iter++)
+            for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
             {
                 rocblas_trmv_batched_fn(handle,
                                         uplo,
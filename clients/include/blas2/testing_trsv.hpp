@@ -206,7 +206,7 @@ void testing_trsv(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int i = 0; i < number_hot_calls; i++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
             rocblas_trsv_fn(handle, uplo, transA, diag, M, dA, lda, dx_or_b, incx);
 
         gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
@@ -253,7 +253,7 @@ void testing_trsm(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int i = 0; i < number_hot_calls; i++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             CHECK_ROCBLAS_ERROR(rocblas_trsm_fn(
                 handle, side, uplo, transA, diag, M, N, &alpha_h, dA, lda, dXorB, ldb));
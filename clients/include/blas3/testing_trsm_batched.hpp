@@ -331,7 +331,7 @@ void testing_trsm_batched(const Arguments& arg)
 
         gpu_time_used = get_time_us_sync(stream);
 
-        for(int i = 0; i < number_hot_calls; i++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             CHECK_ROCBLAS_ERROR(rocblas_trsm_batched_fn(handle,
                                                         side,
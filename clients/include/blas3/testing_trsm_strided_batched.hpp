@@ -341,30 +341,55 @@ void testing_trsm_strided_batched(const Arguments& arg)
 
     if(arg.timing)
     {
+        int number_cold_calls = arg.cold_iters;
+        int number_hot_calls  = arg.iters;
+
         // GPU rocBLAS
         CHECK_HIP_ERROR(hipMemcpy(dXorB, hXorB_1, sizeof(T) * size_B, hipMemcpyHostToDevice));
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
+        for(int i = 0; i < number_cold_calls; i++)
+        {
+            CHECK_ROCBLAS_ERROR(rocblas_trsm_strided_batched_fn(handle,
+                                                                side,
+                                                                uplo,
+                                                                transA,
+                                                                diag,
+                                                                M,
+                                                                N,
+                                                                &alpha_h,
+                                                                dA,
+                                                                lda,
+                                                                stride_a,
+                                                                dXorB,
+                                                                ldb,
+                                                                stride_b,
+                                                                batch_count));
+        }
+
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        CHECK_ROCBLAS_ERROR(rocblas_trsm_strided_batched_fn(handle,
-                                                            side,
-                                                            uplo,
-                                                            transA,
-                                                            diag,
-                                                            M,
-                                                            N,
-                                                            &alpha_h,
-                                                            dA,
-                                                            lda,
-                                                            stride_a,
-                                                            dXorB,
-                                                            ldb,
-                                                            stride_b,
-                                                            batch_count));
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
+        {
+            CHECK_ROCBLAS_ERROR(rocblas_trsm_strided_batched_fn(handle,
+                                                                side,
+                                                                uplo,
+                                                                transA,
+                                                                diag,
+                                                                M,
+                                                                N,
+                                                                &alpha_h,
+                                                                dA,
+                                                                lda,
+                                                                stride_a,
+                                                                dXorB,
+                                                                ldb,
+                                                                stride_b,
+                                                                batch_count));
+        }
 
         gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
 
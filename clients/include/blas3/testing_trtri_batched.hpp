@@ -126,13 +126,6 @@ void testing_trtri_batched(const Arguments& arg)
     /* =====================================================================
            ROCBLAS
     =================================================================== */
-    hipStream_t stream;
-    if(arg.timing)
-    {
-        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-    }
-
     CHECK_ROCBLAS_ERROR(rocblas_trtri_batched_fn(
         handle, uplo, diag, N, dA.ptr_on_device(), lda, dinvA.ptr_on_device(), lda, batch_count));
 
@@ -140,15 +133,48 @@ void testing_trtri_batched(const Arguments& arg)
     CHECK_ROCBLAS_ERROR(rocblas_trtri_batched_fn(
         handle, uplo, diag, N, dA.ptr_on_device(), lda, dA.ptr_on_device(), lda, batch_count));
 
+    // copy output from device to CPU
+    CHECK_HIP_ERROR(hA.transfer_from(dinvA));
+    CHECK_HIP_ERROR(hA_2.transfer_from(dA));
+
     if(arg.timing)
     {
+        int number_cold_calls = arg.cold_iters;
+        int number_hot_calls  = arg.iters;
+
+        for(int i = 0; i < number_cold_calls; i++)
+        {
+            CHECK_ROCBLAS_ERROR(rocblas_trtri_batched_fn(handle,
+                                                         uplo,
+                                                         diag,
+                                                         N,
+                                                         dA.ptr_on_device(),
+                                                         lda,
+                                                         dinvA.ptr_on_device(),
+                                                         lda,
+                                                         batch_count));
+        }
+
+        hipStream_t stream;
+        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+        gpu_time_used = get_time_us_sync(stream); // in microseconds
+
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
+        {
+            CHECK_ROCBLAS_ERROR(rocblas_trtri_batched_fn(handle,
+                                                         uplo,
+                                                         diag,
+                                                         N,
+                                                         dA.ptr_on_device(),
+                                                         lda,
+                                                         dinvA.ptr_on_device(),
+                                                         lda,
+                                                         batch_count));
+        }
+
         gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
     }
 
-    // copy output from device to CPU
-    CHECK_HIP_ERROR(hA.transfer_from(dinvA));
-    CHECK_HIP_ERROR(hA_2.transfer_from(dA));
-
     if(arg.unit_check || arg.norm_check)
     {
         /* =====================================================================
@@ -126,13 +126,6 @@ void testing_trtri_strided_batched(const Arguments& arg)
     /* =====================================================================
            ROCBLAS
     =================================================================== */
-    hipStream_t stream;
-    if(arg.timing)
-    {
-        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-    }
-
     CHECK_ROCBLAS_ERROR(rocblas_trtri_strided_batched_fn(
         handle, uplo, diag, N, dA, lda, stride_a, dinvA, lda, stride_a, batch_count));
 
@@ -140,15 +133,34 @@ void testing_trtri_strided_batched(const Arguments& arg)
     CHECK_ROCBLAS_ERROR(rocblas_trtri_strided_batched_fn(
         handle, uplo, diag, N, dA, lda, stride_a, dA, lda, stride_a, batch_count));
 
+    // copy output from device to CPU
+    CHECK_HIP_ERROR(hipMemcpy(hA, dinvA, sizeof(T) * size_A, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(hA_2, dA, sizeof(T) * size_A, hipMemcpyDeviceToHost));
+
     if(arg.timing)
     {
+        int number_cold_calls = arg.cold_iters;
+        int number_hot_calls  = arg.iters;
+
+        for(int i = 0; i < number_cold_calls; i++)
+        {
+            CHECK_ROCBLAS_ERROR(rocblas_trtri_strided_batched_fn(
+                handle, uplo, diag, N, dA, lda, stride_a, dinvA, lda, stride_a, batch_count));
+        }
+
+        hipStream_t stream;
+        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+        gpu_time_used = get_time_us_sync(stream); // in microseconds
+
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
+        {
+            CHECK_ROCBLAS_ERROR(rocblas_trtri_strided_batched_fn(
+                handle, uplo, diag, N, dA, lda, stride_a, dinvA, lda, stride_a, batch_count));
+        }
+
         gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
     }
 
-    // copy output from device to CPU
-    CHECK_HIP_ERROR(hipMemcpy(hA, dinvA, sizeof(T) * size_A, hipMemcpyDeviceToHost));
-    CHECK_HIP_ERROR(hipMemcpy(hA_2, dA, sizeof(T) * size_A, hipMemcpyDeviceToHost));
-
     if(arg.unit_check || arg.norm_check)
     {
         /* =====================================================================
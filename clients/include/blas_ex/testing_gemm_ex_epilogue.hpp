@@ -0,0 +1,588 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "cblas_interface.hpp"
+#include "flops.hpp"
+#include "near.hpp"
+#include "norm.hpp"
+#include "rocblas.hpp"
+#include "rocblas_datatype2string.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "type_dispatch.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+// Type of the converting output tested for results of type To
+template <typename To>
+using gemm_ex_epilogue_conversion_t = std::conditional_t<
+    std::is_same<To, double>{},
+    float,
+    std::conditional_t<std::is_same<To, float>{}, rocblas_half, int8_t>>;
+
+/* ============================================================================================ */
+template <typename Ti, typename To, typename Tc>
+void testing_gemm_ex_epilogue_bad_arg(const Arguments& arg)
+{
+    const rocblas_int M   = 100;
+    const rocblas_int N   = 100;
+    const rocblas_int K   = 100;
+    const rocblas_int ld  = 100;
+    const size_t      len = size_t(ld) * N;
+
+    const rocblas_datatype type = rocblas_datatype_f32_r;
+    const float            alpha(1), beta(1);
+
+    rocblas_local_handle handle{arg};
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+
+    device_vector<float>  dA(len), dB(len), dC(len), dD(len), dscale(M), dbias(N);
+    device_vector<int8_t> dout(len);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+    CHECK_DEVICE_ALLOCATION(dscale.memcheck());
+    CHECK_DEVICE_ALLOCATION(dbias.memcheck());
+    CHECK_DEVICE_ALLOCATION(dout.memcheck());
+
+    rocblas_gemm_epilogue good = {};
+    good.scale_mode            = rocblas_gemm_epilogue_vector_row;
+    good.scale                 = dscale;
+    good.bias_mode             = rocblas_gemm_epilogue_vector_column;
+    good.bias                  = dbias;
+    good.activation            = rocblas_gemm_epilogue_activation_relu;
+    good.clamp                 = true;
+    good.clamp_min             = -128;
+    good.clamp_max             = 127;
+    good.out                   = dout;
+    good.out_type              = rocblas_datatype_i8_r;
+    good.ldo                   = ld;
+
+    auto gemm = [&](rocblas_handle h, rocblas_int m, const rocblas_gemm_epilogue* epilogue) {
+        return rocblas_gemm_ex_epilogue(h,
+                                        rocblas_operation_none,
+                                        rocblas_operation_none,
+                                        m,
+                                        N,
+                                        K,
+                                        &alpha,
+                                        dA,
+                                        type,
+                                        ld,
+                                        dB,
+                                        type,
+                                        ld,
+                                        &beta,
+                                        dC,
+                                        type,
+                                        ld,
+                                        dD,
+                                        type,
+                                        ld,
+                                        type,
+                                        rocblas_gemm_algo_standard,
+                                        0,
+                                        0,
+                                        epilogue);
+    };
+
+    EXPECT_ROCBLAS_STATUS(gemm(nullptr, M, &good), rocblas_status_invalid_handle);
+
+    rocblas_gemm_epilogue bad = good;
+    bad.scale_mode            = rocblas_gemm_epilogue_vector(7);
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, &bad), rocblas_status_invalid_value);
+
+    bad            = good;
+    bad.activation = rocblas_gemm_epilogue_activation(7);
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, &bad), rocblas_status_invalid_value);
+
+    bad           = good;
+    bad.clamp_min = 1;
+    bad.clamp_max = 0;
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, &bad), rocblas_status_invalid_value);
+
+    bad     = good;
+    bad.ldo = M - 1;
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, &bad), rocblas_status_invalid_size);
+
+    // Only float output can be converted from double
+    bad          = good;
+    bad.out_type = rocblas_datatype_f64_r;
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, &bad), rocblas_status_not_implemented);
+
+    // In place, the output has the type of D, whatever out_type is
+    rocblas_gemm_epilogue in_place = good;
+    in_place.out                   = nullptr;
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, &in_place), rocblas_status_success);
+
+    bad       = good;
+    bad.scale = nullptr;
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, &bad), rocblas_status_invalid_pointer);
+
+    bad      = good;
+    bad.bias = nullptr;
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, &bad), rocblas_status_invalid_pointer);
+
+    // Vectors which are not used can be nullptr, and so can the pointers of a quick return
+    bad            = good;
+    bad.scale_mode = rocblas_gemm_epilogue_vector_none;
+    bad.scale      = nullptr;
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, &bad), rocblas_status_success);
+
+    bad      = good;
+    bad.bias = nullptr;
+    EXPECT_ROCBLAS_STATUS(gemm(handle, 0, &bad), rocblas_status_success);
+
+    // Without an epilogue, it is gemm_ex
+    EXPECT_ROCBLAS_STATUS(gemm(handle, M, nullptr), rocblas_status_success);
+}
+
+// Results of complex types have no epilogue
+template <typename Ti, typename To, typename Tc, std::enable_if_t<is_complex<To>, int> = 0>
+void testing_gemm_ex_epilogue(const Arguments& arg)
+{
+    rocblas_local_handle  handle{arg};
+    device_vector<Ti>     dA(1), dB(1);
+    device_vector<To>     dC(1), dD(1);
+    Tc                    alpha(1), beta(1);
+    rocblas_gemm_epilogue epilogue = {};
+    epilogue.out_type              = arg.d_type;
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+
+    EXPECT_ROCBLAS_STATUS(rocblas_gemm_ex_epilogue(handle,
+                                                   rocblas_operation_none,
+                                                   rocblas_operation_none,
+                                                   1,
+                                                   1,
+                                                   1,
+                                                   &alpha,
+                                                   dA,
+                                                   arg.a_type,
+                                                   1,
+                                                   dB,
+                                                   arg.b_type,
+                                                   1,
+                                                   &beta,
+                                                   dC,
+                                                   arg.c_type,
+                                                   1,
+                                                   dD,
+                                                   arg.d_type,
+                                                   1,
+                                                   arg.compute_type,
+                                                   rocblas_gemm_algo_standard,
+                                                   0,
+                                                   0,
+                                                   &epilogue),
+                          rocblas_status_not_implemented);
+}
+
+template <typename Ti, typename To, typename Tc, std::enable_if_t<!is_complex<To>, int> = 0>
+void testing_gemm_ex_epilogue(const Arguments& arg)
+{
+    // The epilogue computes in Te, with vectors of type Tv
+    using Te = std::conditional_t<std::is_same<To, double>{} || std::is_same<To, int32_t>{},
+                                  double,
+                                  float>;
+    using Tv     = std::conditional_t<std::is_same<To, double>{}, double, float>;
+    using To_hpa = std::conditional_t<std::is_same<To, rocblas_bfloat16>{}, float, To>;
+
+    const bool strided = !strcmp(arg.function, "gemm_strided_batched_ex_epilogue");
+
+    rocblas_gemm_algo algo = rocblas_gemm_algo(arg.algo);
+    int32_t           solution_index(arg.solution_index);
+    uint32_t          flags(arg.flags);
+
+    Tc h_alpha_Tc = arg.get_alpha<Tc>();
+    Tc h_beta_Tc  = arg.get_beta<Tc>();
+
+    double gpu_time_used, cpu_time_used;
+    gpu_time_used = cpu_time_used      = 0.0;
+    double               rocblas_error = 0.0;
+    rocblas_local_handle handle{arg};
+    auto                 transA = char2rocblas_operation(arg.transA);
+    auto                 transB = char2rocblas_operation(arg.transB);
+    auto                 M = arg.M, N = arg.N, K = arg.K;
+    auto                 lda = arg.lda, ldb = arg.ldb, ldc = arg.ldc, ldd = arg.ldd;
+    auto                 A_row       = transA == rocblas_operation_none ? M : K;
+    auto                 A_col       = transA == rocblas_operation_none ? K : M;
+    auto                 B_row       = transB == rocblas_operation_none ? K : N;
+    auto                 B_col       = transB == rocblas_operation_none ? N : K;
+    auto                 batch_count = strided ? arg.batch_count : 1;
+
+    // The matrices and vectors of the batches are packed
+    rocblas_stride stride_a = rocblas_stride(lda) * std::max(A_col, 0);
+    rocblas_stride stride_b = rocblas_stride(ldb) * std::max(B_col, 0);
+    rocblas_stride stride_c = rocblas_stride(ldc) * std::max(N, 0);
+    rocblas_stride stride_d = rocblas_stride(ldd) * std::max(N, 0);
+    rocblas_stride stride_v = std::max({M, N, 1});
+
+    auto gemm = [&](const void*                  alpha,
+                    const void*                  a,
+                    const void*                  b,
+                    const void*                  beta,
+                    const void*                  c,
+                    void*                        d,
+                    const rocblas_gemm_epilogue* epilogue) {
+        return strided ? rocblas_gemm_strided_batched_ex_epilogue(handle,
+                                                                  transA,
+                                                                  transB,
+                                                                  M,
+                                                                  N,
+                                                                  K,
+                                                                  alpha,
+                                                                  a,
+                                                                  arg.a_type,
+                                                                  lda,
+                                                                  stride_a,
+                                                                  b,
+                                                                  arg.b_type,
+                                                                  ldb,
+                                                                  stride_b,
+                                                                  beta,
+                                                                  c,
+                                                                  arg.c_type,
+                                                                  ldc,
+                                                                  stride_c,
+                                                                  d,
+                                                                  arg.d_type,
+                                                                  ldd,
+                                                                  stride_d,
+                                                                  batch_count,
+                                                                  arg.compute_type,
+                                                                  algo,
+                                                                  solution_index,
+                                                                  flags,
+                                                                  epilogue)
+                       : rocblas_gemm_ex_epilogue(handle,
+                                                  transA,
+                                                  transB,
+                                                  M,
+                                                  N,
+                                                  K,
+                                                  alpha,
+                                                  a,
+                                                  arg.a_type,
+                                                  lda,
+                                                  b,
+                                                  arg.b_type,
+                                                  ldb,
+                                                  beta,
+                                                  c,
+                                                  arg.c_type,
+                                                  ldc,
+                                                  d,
+                                                  arg.d_type,
+                                                  ldd,
+                                                  arg.compute_type,
+                                                  algo,
+                                                  solution_index,
+                                                  flags,
+                                                  epilogue);
+    };
+
+    // check for invalid sizes
+    bool invalid_size = M < 0 || N < 0 || K < 0 || lda < A_row || ldb < B_row || ldc < M || ldd < M
+                        || batch_count < 0;
+    if(invalid_size || !M || !N || !batch_count)
+    {
+        rocblas_gemm_epilogue epilogue = {};
+        epilogue.out_type              = arg.d_type;
+        EXPECT_ROCBLAS_STATUS(gemm(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &epilogue),
+                              invalid_size ? rocblas_status_invalid_size : rocblas_status_success);
+        return;
+    }
+
+    size_t size_a = size_t(stride_a) * batch_count;
+    size_t size_b = size_t(stride_b) * batch_count;
+    size_t size_c = size_t(stride_c) * batch_count;
+    size_t size_d = size_t(stride_d) * batch_count;
+    size_t size_v = size_t(stride_v) * batch_count;
+
+    // allocate memory on device
+    device_vector<Ti> dA(size_a);
+    device_vector<Ti> dB(size_b);
+    device_vector<To> dC(size_c);
+    device_vector<To> dD(size_d);
+    device_vector<To> dout(size_d);
+    device_vector<Tv> dscale(size_v);
+    device_vector<Tv> dbias(size_v);
+    device_vector<Tc> d_alpha_Tc(1);
+    device_vector<Tc> d_beta_Tc(1);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+    CHECK_DEVICE_ALLOCATION(dout.memcheck());
+    CHECK_DEVICE_ALLOCATION(dscale.memcheck());
+    CHECK_DEVICE_ALLOCATION(dbias.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_alpha_Tc.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_beta_Tc.memcheck());
+
+    // Naming: dX is in GPU (device) memory. hK is in CPU (host) memory, plz follow this practice
+    host_vector<Ti>     hA(size_a);
+    host_vector<Ti>     hB(size_b);
+    host_vector<To>     hC(size_c);
+    host_vector<To>     hD_init(size_d);
+    host_vector<To>     hD(size_d);
+    host_vector<To_hpa> hD_gold(size_d);
+    host_vector<Tv>     hscale(size_v);
+    host_vector<Tv>     hbias(size_v);
+
+    // Initial Data on CPU
+    rocblas_seedrand();
+    rocblas_init<Ti>(hA, A_row, A_col, lda, stride_a, batch_count);
+    rocblas_init_alternating_sign<Ti>(hB, B_row, B_col, ldb, stride_b, batch_count);
+    rocblas_init<To>(hC, M, N, ldc, stride_c, batch_count);
+    rocblas_init_nan<To>(hD_init, M, N, ldd, stride_d, batch_count);
+
+    // Scales and biases are exact in every type, so that only the activation rounds
+    for(rocblas_int b = 0; b < batch_count; b++)
+        for(rocblas_stride i = 0; i < stride_v; i++)
+        {
+            hscale[b * stride_v + i] = Tv(((i + b) % 4 + 1) * 0.25);
+            hbias[b * stride_v + i]  = Tv((i + b) % 5) - 2;
+        }
+
+    // copy data from CPU to device
+    CHECK_HIP_ERROR(dA.transfer_from(hA));
+    CHECK_HIP_ERROR(dB.transfer_from(hB));
+    CHECK_HIP_ERROR(dC.transfer_from(hC));
+    CHECK_HIP_ERROR(dscale.transfer_from(hscale));
+    CHECK_HIP_ERROR(dbias.transfer_from(hbias));
+    CHECK_HIP_ERROR(hipMemcpy(d_alpha_Tc, &h_alpha_Tc, sizeof(Tc), hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_beta_Tc, &h_beta_Tc, sizeof(Tc), hipMemcpyHostToDevice));
+
+    // An epilogue of the vectors above. out is set by the caller.
+    auto make_epilogue = [&](rocblas_gemm_epilogue_vector     scale_mode,
+                             rocblas_gemm_epilogue_vector     bias_mode,
+                             rocblas_gemm_epilogue_activation activation,
+                             bool                             clamp) {
+        rocblas_gemm_epilogue epilogue = {};
+        epilogue.scale_mode            = scale_mode;
+        epilogue.scale                 = dscale;
+        epilogue.stride_scale          = stride_v;
+        epilogue.bias_mode             = bias_mode;
+        epilogue.bias                  = dbias;
+        epilogue.stride_bias           = stride_v;
+        epilogue.activation            = activation;
+        epilogue.clamp                 = clamp;
+        epilogue.clamp_min             = -8;
+        epilogue.clamp_max             = 64;
+        epilogue.out_type              = arg.d_type;
+        return epilogue;
+    };
+
+    // Reference epilogue of the batches of hD, which hold the D computed by the GPU
+    auto cpu_epilogue = [&](const rocblas_gemm_epilogue& epilogue, auto* out, rocblas_int ldo) {
+        for(rocblas_int b = 0; b < batch_count; b++)
+            cblas_gemm_epilogue<Te>(M,
+                                    N,
+                                    hD + b * stride_d,
+                                    ldd,
+                                    epilogue.scale_mode,
+                                    hscale + b * stride_v,
+                                    epilogue.bias_mode,
+                                    hbias + b * stride_v,
+                                    epilogue.activation,
+                                    epilogue.clamp,
+                                    Te(epilogue.clamp_min),
+                                    Te(epilogue.clamp_max),
+                                    out + b * stride_d,
+                                    ldo);
+    };
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // To an output of type To, with GELU. D keeps the result of the gemm.
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_HIP_ERROR(dD.transfer_from(hD_init));
+        auto gelu = make_epilogue(rocblas_gemm_epilogue_vector_column,
+                                  rocblas_gemm_epilogue_vector_row,
+                                  rocblas_gemm_epilogue_activation_gelu,
+                                  true);
+        gelu.out        = dout;
+        gelu.ldo        = ldd;
+        gelu.stride_out = stride_d;
+        CHECK_ROCBLAS_ERROR(gemm(&h_alpha_Tc, dA, dB, &h_beta_Tc, dC, dD, &gelu));
+
+        host_vector<To> hout(size_d), hout_gold(size_d);
+        CHECK_HIP_ERROR(hD.transfer_from(dD));
+        CHECK_HIP_ERROR(hout.transfer_from(dout));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; b++)
+        {
+            // copy C matrix into D matrix
+            for(rocblas_int i2 = 0; i2 < N; i2++)
+                for(rocblas_int i1 = 0; i1 < M; i1++)
+                    hD_gold[b * stride_d + i1 + i2 * ldd] = hC[b * stride_c + i1 + i2 * ldc];
+
+            cblas_gemm<Ti, To_hpa>(transA,
+                                   transB,
+                                   M,
+                                   N,
+                                   K,
+                                   h_alpha_Tc,
+                                   hA + b * stride_a,
+                                   lda,
+                                   hB + b * stride_b,
+                                   ldb,
+                                   h_beta_Tc,
+                                   hD_gold + b * stride_d,
+                                   ldd);
+        }
+        cpu_epilogue(gelu, (To*)hout_gold, ldd);
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            // GELU rounds differently on the GPU, which can change the last digit of the output
+            double tol = 1 / 1000.0;
+            if(std::is_integral<To>{})
+                tol = 1;
+            else if(std::is_same<To, rocblas_bfloat16>{})
+                tol = 0.5;
+            else if(std::is_same<To, rocblas_half>{})
+                tol = 1 / 16.0;
+            unit_check_general<To, To_hpa>(M, N, ldd, stride_d, hD_gold, hD, batch_count);
+            near_check_general<To>(M, N, ldd, stride_d, hout_gold, hout, batch_count, tol);
+        }
+
+        if(arg.norm_check)
+        {
+            auto err1 = std::abs(
+                norm_check_general<To>('F', M, N, ldd, stride_d, hD_gold, hD, batch_count));
+            auto err2 = std::abs(
+                norm_check_general<To>('F', M, N, ldd, stride_d, hout_gold, hout, batch_count));
+            rocblas_error = std::max(err1, err2);
+        }
+
+        // Converting to a narrower type
+        using T2 = gemm_ex_epilogue_conversion_t<To>;
+        device_vector<T2> dout2(size_d);
+        host_vector<T2>   hout2(size_d), hout2_gold(size_d);
+        CHECK_DEVICE_ALLOCATION(dout2.memcheck());
+
+        auto convert = make_epilogue(rocblas_gemm_epilogue_vector_row,
+                                     rocblas_gemm_epilogue_vector_row,
+                                     rocblas_gemm_epilogue_activation_none,
+                                     std::is_same<T2, int8_t>{});
+        convert.clamp_min  = -100;
+        convert.clamp_max  = 100;
+        convert.out        = dout2;
+        convert.out_type   = rocblas_type2datatype<T2>();
+        convert.ldo        = ldd;
+        convert.stride_out = stride_d;
+        CHECK_ROCBLAS_ERROR(gemm(&h_alpha_Tc, dA, dB, &h_beta_Tc, dC, dD, &convert));
+        CHECK_HIP_ERROR(hout2.transfer_from(dout2));
+        cpu_epilogue(convert, (T2*)hout2_gold, ldd);
+        if(arg.unit_check)
+            unit_check_general<T2>(M, N, ldd, stride_d, hout2_gold, hout2, batch_count);
+
+        // In place, with ReLU, and alpha and beta on the device
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_HIP_ERROR(dD.transfer_from(hD_init));
+        auto relu = make_epilogue(rocblas_gemm_epilogue_vector_row,
+                                  rocblas_gemm_epilogue_vector_column,
+                                  rocblas_gemm_epilogue_activation_relu,
+                                  false);
+        CHECK_ROCBLAS_ERROR(gemm(d_alpha_Tc, dA, dB, d_beta_Tc, dC, dD, &relu));
+        CHECK_HIP_ERROR(hout.transfer_from(dD));
+        cpu_epilogue(relu, (To*)hout_gold, ldd);
+        if(arg.unit_check)
+            unit_check_general<To>(M, N, ldd, stride_d, hout_gold, hout, batch_count);
+
+        // int32 results above 2^24, which float cannot hold, are exact. D is C.
+        if constexpr(std::is_same<To, int32_t>{})
+        {
+            host_vector<To> hC_big(size_c), hbig(size_d), hbig_gold(size_d);
+            for(size_t i = 0; i < size_c; i++)
+                hC_big[i] = To((i & 1 ? -1 : 1) * ((1 << 24) + 2 * int32_t(i % 4096) + 1));
+            CHECK_HIP_ERROR(dC.transfer_from(hC_big));
+            CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+            Tc zero(0), one(1);
+
+            // In place with no operation
+            rocblas_gemm_epilogue none = {};
+            CHECK_ROCBLAS_ERROR(gemm(&zero, dA, dB, &one, dC, dD, &none));
+            CHECK_HIP_ERROR(hD.transfer_from(dD));
+            for(rocblas_int b = 0; b < batch_count; b++)
+                for(rocblas_int i2 = 0; i2 < N; i2++)
+                    for(rocblas_int i1 = 0; i1 < M; i1++)
+                        hbig_gold[b * stride_d + i1 + i2 * ldd]
+                            = hC_big[b * stride_c + i1 + i2 * ldc];
+            if(arg.unit_check)
+                unit_check_general<To>(M, N, ldd, stride_d, hbig_gold, hD, batch_count);
+
+            // In place with a bias and a clamp beyond the results
+            auto bias      = make_epilogue(rocblas_gemm_epilogue_vector_none,
+                                           rocblas_gemm_epilogue_vector_row,
+                                           rocblas_gemm_epilogue_activation_none,
+                                           true);
+            bias.clamp_min = -(1 << 30);
+            bias.clamp_max = 1 << 30;
+            CHECK_ROCBLAS_ERROR(gemm(&zero, dA, dB, &one, dC, dD, &bias));
+            CHECK_HIP_ERROR(hbig.transfer_from(dD));
+            cpu_epilogue(bias, (To*)hbig_gold, ldd);
+            if(arg.unit_check)
+                unit_check_general<To>(M, N, ldd, stride_d, hbig_gold, hbig, batch_count);
+
+            CHECK_HIP_ERROR(dC.transfer_from(hC));
+        }
+    }
+
+    if(arg.timing)
+    {
+        int number_cold_calls = arg.cold_iters;
+        int number_hot_calls  = arg.iters;
+
+        // A bias and activation epilogue in place, as in inference
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        auto epilogue = make_epilogue(rocblas_gemm_epilogue_vector_none,
+                                      rocblas_gemm_epilogue_vector_row,
+                                      rocblas_gemm_epilogue_activation_relu,
+                                      false);
+
+        for(int i = 0; i < number_cold_calls; i++)
+            CHECK_ROCBLAS_ERROR(gemm(&h_alpha_Tc, dA, dB, &h_beta_Tc, dC, dD, &epilogue));
+
+        hipStream_t stream;
+        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+        gpu_time_used = get_time_us_sync(stream); // in microseconds
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
+            gemm(&h_alpha_Tc, dA, dB, &h_beta_Tc, dC, dD, &epilogue);
+        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+
+        ArgumentModel<e_transA,
+                      e_transB,
+                      e_M,
+                      e_N,
+                      e_K,
+                      e_alpha,
+                      e_lda,
+                      e_beta,
+                      e_ldb,
+                      e_ldc,
+                      e_ldd,
+                      e_batch_count>{}
+            .log_args<To>(rocblas_cout,
+                          arg,
+                          gpu_time_used,
+                          gemm_gflop_count<Tc>(M, N, K) * batch_count,
+                          ArgumentLogging::NA_value,
+                          cpu_time_used,
+                          rocblas_error);
+    }
+}
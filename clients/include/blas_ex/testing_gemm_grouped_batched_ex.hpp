@@ -0,0 +1,487 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "cblas_interface.hpp"
+#include "flops.hpp"
+#include "near.hpp"
+#include "norm.hpp"
+#include "rocblas.hpp"
+#include "rocblas_datatype2string.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+// The groups of a grouped GEMM test. Group g has the sizes of the Arguments grown by
+// g % 3, so groups with the same shape are not adjacent, and g % 2 + 1 problems.
+struct gemm_grouped_test_groups
+{
+    std::vector<rocblas_operation> transA, transB;
+    std::vector<rocblas_int>       M, N, K, lda, ldb, ldc, ldd, group_size;
+    rocblas_int                    problems = 0;
+
+    gemm_grouped_test_groups(const Arguments& arg, rocblas_int group_count)
+    {
+        for(rocblas_int g = 0; g < group_count; ++g)
+        {
+            rocblas_int grow = g % 3;
+            transA.push_back(char2rocblas_operation(arg.transA));
+            transB.push_back(char2rocblas_operation(arg.transB));
+            M.push_back(arg.M > 0 ? arg.M + grow : arg.M);
+            N.push_back(arg.N > 0 ? arg.N + grow : arg.N);
+            K.push_back(arg.K > 0 ? arg.K + grow : arg.K);
+            auto A_row = transA[g] == rocblas_operation_none ? M[g] : K[g];
+            auto B_row = transB[g] == rocblas_operation_none ? K[g] : N[g];
+            lda.push_back(arg.lda < 0 ? arg.lda : std::max(arg.lda, A_row));
+            ldb.push_back(arg.ldb < 0 ? arg.ldb : std::max(arg.ldb, B_row));
+            ldc.push_back(arg.ldc < 0 ? arg.ldc : std::max(arg.ldc, M[g]));
+            ldd.push_back(arg.ldd < 0 ? arg.ldd : std::max(arg.ldd, M[g]));
+            group_size.push_back(g % 2 + 1);
+            problems += group_size[g];
+        }
+    }
+
+    size_t size_a(rocblas_int g) const
+    {
+        return size_t(lda[g]) * (transA[g] == rocblas_operation_none ? K[g] : M[g]);
+    }
+
+    size_t size_b(rocblas_int g) const
+    {
+        return size_t(ldb[g]) * (transB[g] == rocblas_operation_none ? N[g] : K[g]);
+    }
+};
+
+/* ============================================================================================ */
+template <typename Ti, typename To, typename Tc>
+void testing_gemm_grouped_batched_ex_bad_arg(const Arguments& arg)
+{
+    for(auto pointer_mode : {rocblas_pointer_mode_host, rocblas_pointer_mode_device})
+    {
+        const rocblas_int       group_count  = 2;
+        const rocblas_operation trans[]      = {rocblas_operation_none, rocblas_operation_none};
+        const rocblas_int       M[]          = {100, 50};
+        const rocblas_int       N[]          = {100, 50};
+        const rocblas_int       K[]          = {100, 50};
+        const rocblas_int       ld[]         = {100, 100};
+        const rocblas_int       group_size[] = {1, 1};
+
+        rocblas_datatype a_type       = rocblas_datatype_f32_r;
+        rocblas_datatype b_type       = rocblas_datatype_f32_r;
+        rocblas_datatype c_type       = rocblas_datatype_f32_r;
+        rocblas_datatype d_type       = rocblas_datatype_f32_r;
+        rocblas_datatype compute_type = rocblas_datatype_f32_r;
+
+        device_vector<float> alpha_d(group_count), beta_d(group_count);
+        const float          alpha_h[] = {0.5, 1.5}, beta_h[] = {1.5, 0.5};
+
+        const float* alpha = alpha_h;
+        const float* beta  = beta_h;
+
+        if(pointer_mode == rocblas_pointer_mode_device)
+        {
+            CHECK_HIP_ERROR(hipMemcpy(alpha_d, alpha, sizeof(alpha_h), hipMemcpyHostToDevice));
+            alpha = alpha_d;
+            CHECK_HIP_ERROR(hipMemcpy(beta_d, beta, sizeof(beta_h), hipMemcpyHostToDevice));
+            beta = beta_d;
+        }
+
+        rocblas_gemm_algo algo           = rocblas_gemm_algo_standard;
+        int32_t           solution_index = 0;
+        rocblas_int       flags          = 0;
+
+        const size_t safe_size = 100 * 100;
+
+        rocblas_local_handle handle{arg};
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, pointer_mode));
+
+        // allocate memory on device
+        device_batch_vector<float> dA(safe_size, 1, group_count);
+        device_batch_vector<float> dB(safe_size, 1, group_count);
+        device_batch_vector<float> dC(safe_size, 1, group_count);
+        device_batch_vector<float> dD(safe_size, 1, group_count);
+        CHECK_DEVICE_ALLOCATION(dA.memcheck());
+        CHECK_DEVICE_ALLOCATION(dB.memcheck());
+        CHECK_DEVICE_ALLOCATION(dC.memcheck());
+        CHECK_DEVICE_ALLOCATION(dD.memcheck());
+
+        auto grouped = [&](rocblas_handle     h,
+                           rocblas_int        group_count,
+                           const rocblas_int* M,
+                           const void*        alpha,
+                           const void*        a,
+                           const void*        beta,
+                           const void*        c,
+                           void*              d) {
+            return rocblas_gemm_grouped_batched_ex(h,
+                                                   group_count,
+                                                   trans,
+                                                   trans,
+                                                   M,
+                                                   N,
+                                                   K,
+                                                   alpha,
+                                                   a,
+                                                   a_type,
+                                                   ld,
+                                                   dB.ptr_on_device(),
+                                                   b_type,
+                                                   ld,
+                                                   beta,
+                                                   c,
+                                                   c_type,
+                                                   ld,
+                                                   d,
+                                                   d_type,
+                                                   ld,
+                                                   group_size,
+                                                   compute_type,
+                                                   algo,
+                                                   solution_index,
+                                                   flags);
+        };
+
+        auto dA_ptrs = dA.ptr_on_device();
+        auto dC_ptrs = dC.ptr_on_device();
+        auto dD_ptrs = dD.ptr_on_device();
+
+        EXPECT_ROCBLAS_STATUS(
+            grouped(nullptr, group_count, M, alpha, dA_ptrs, beta, dC_ptrs, dD_ptrs),
+            rocblas_status_invalid_handle);
+        EXPECT_ROCBLAS_STATUS(grouped(handle, -1, M, alpha, dA_ptrs, beta, dC_ptrs, dD_ptrs),
+                              rocblas_status_invalid_size);
+        EXPECT_ROCBLAS_STATUS(
+            grouped(handle, group_count, nullptr, alpha, dA_ptrs, beta, dC_ptrs, dD_ptrs),
+            rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(
+            grouped(handle, group_count, M, nullptr, dA_ptrs, beta, dC_ptrs, dD_ptrs),
+            rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(
+            grouped(handle, group_count, M, alpha, nullptr, beta, dC_ptrs, dD_ptrs),
+            rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(
+            grouped(handle, group_count, M, alpha, dA_ptrs, nullptr, dC_ptrs, dD_ptrs),
+            rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(
+            grouped(handle, group_count, M, alpha, dA_ptrs, beta, nullptr, dD_ptrs),
+            rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(
+            grouped(handle, group_count, M, alpha, dA_ptrs, beta, dC_ptrs, nullptr),
+            rocblas_status_invalid_pointer);
+
+        // A leading dimension which is too small in any group is an invalid size
+        const rocblas_int M_large[] = {100, 101};
+        EXPECT_ROCBLAS_STATUS(
+            grouped(handle, group_count, M_large, alpha, dA_ptrs, beta, dC_ptrs, dD_ptrs),
+            rocblas_status_invalid_size);
+
+        // If group_count==0 or every group is empty, then all pointers can be nullptr
+        EXPECT_ROCBLAS_STATUS(
+            grouped(handle, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr),
+            rocblas_status_success);
+        const rocblas_int M_zero[] = {0, 0};
+        EXPECT_ROCBLAS_STATUS(
+            grouped(handle, group_count, M_zero, nullptr, nullptr, nullptr, nullptr, nullptr),
+            rocblas_status_success);
+    }
+}
+
+template <typename Ti, typename To, typename Tc>
+void testing_gemm_grouped_batched_ex(const Arguments& arg)
+{
+    rocblas_gemm_algo algo = rocblas_gemm_algo(arg.algo);
+    int32_t           solution_index(arg.solution_index);
+    uint32_t          flags(arg.flags);
+
+    Tc h_alpha_Tc = arg.get_alpha<Tc>();
+    Tc h_beta_Tc  = arg.get_beta<Tc>();
+
+    double gpu_time_used, cpu_time_used;
+    gpu_time_used = cpu_time_used      = 0.0;
+    double               rocblas_error = 0.0;
+    rocblas_local_handle handle{arg};
+
+    // The batch count of the Arguments is the number of groups
+    rocblas_int              group_count = arg.batch_count;
+    gemm_grouped_test_groups groups(arg, std::max(group_count, 0));
+
+    bool invalid_size = group_count < 0;
+    bool quick_return = true;
+    for(rocblas_int g = 0; g < group_count; ++g)
+    {
+        auto A_row = groups.transA[g] == rocblas_operation_none ? groups.M[g] : groups.K[g];
+        auto B_row = groups.transB[g] == rocblas_operation_none ? groups.K[g] : groups.N[g];
+        if(groups.M[g] < 0 || groups.N[g] < 0 || groups.K[g] < 0 || groups.lda[g] < A_row
+           || groups.ldb[g] < B_row || groups.ldc[g] < groups.M[g] || groups.ldd[g] < groups.M[g])
+            invalid_size = true;
+        if(groups.M[g] && groups.N[g])
+            quick_return = false;
+    }
+
+    std::vector<Tc> h_alpha(std::max(group_count, 1), h_alpha_Tc);
+    std::vector<Tc> h_beta(std::max(group_count, 1), h_beta_Tc);
+
+    auto grouped = [&](const void* alpha,
+                       const void* a,
+                       const void* b,
+                       const void* beta,
+                       const void* c,
+                       void*       d,
+                       bool        c_is_d) {
+        return rocblas_gemm_grouped_batched_ex(handle,
+                                               group_count,
+                                               groups.transA.data(),
+                                               groups.transB.data(),
+                                               groups.M.data(),
+                                               groups.N.data(),
+                                               groups.K.data(),
+                                               alpha,
+                                               a,
+                                               arg.a_type,
+                                               groups.lda.data(),
+                                               b,
+                                               arg.b_type,
+                                               groups.ldb.data(),
+                                               beta,
+                                               c,
+                                               arg.c_type,
+                                               groups.ldc.data(),
+                                               d,
+                                               c_is_d ? arg.c_type : arg.d_type,
+                                               c_is_d ? groups.ldc.data() : groups.ldd.data(),
+                                               groups.group_size.data(),
+                                               arg.compute_type,
+                                               algo,
+                                               solution_index,
+                                               flags);
+    };
+
+    if(invalid_size || quick_return)
+    {
+        EXPECT_ROCBLAS_STATUS(
+            grouped(h_alpha.data(), nullptr, nullptr, nullptr, nullptr, nullptr, false),
+            invalid_size ? rocblas_status_invalid_size : rocblas_status_success);
+        return;
+    }
+
+    // Every problem is allocated with the largest sizes of any group
+    size_t size_a = 0, size_b = 0, size_c = 0, size_d = 0;
+    for(rocblas_int g = 0; g < group_count; ++g)
+    {
+        size_a = std::max(size_a, groups.size_a(g));
+        size_b = std::max(size_b, groups.size_b(g));
+        size_c = std::max(size_c, size_t(groups.ldc[g]) * groups.N[g]);
+        size_d = std::max(size_d, size_t(groups.ldd[g]) * groups.N[g]);
+    }
+    rocblas_int problems = groups.problems;
+
+    // allocate memory on device
+    device_batch_vector<Ti> dA(size_a, 1, problems);
+    device_batch_vector<Ti> dB(size_b, 1, problems);
+    device_batch_vector<To> dC(size_c, 1, problems);
+    device_batch_vector<To> dD(size_d, 1, problems);
+    device_vector<Tc>       d_alpha_Tc(group_count);
+    device_vector<Tc>       d_beta_Tc(group_count);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_alpha_Tc.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_beta_Tc.memcheck());
+
+    // Naming: dX is in GPU (device) memory. hK is in CPU (host) memory, plz follow this practice
+    using To_hpa = std::conditional_t<std::is_same<To, rocblas_bfloat16>{}, float, To>;
+    host_batch_vector<Ti>     hA(size_a, 1, problems);
+    host_batch_vector<Ti>     hB(size_b, 1, problems);
+    host_batch_vector<To>     hC(size_c, 1, problems);
+    host_batch_vector<To>     hD_1(size_d, 1, problems);
+    host_batch_vector<To>     hD_2(size_d, 1, problems);
+    host_batch_vector<To_hpa> hD_gold(size_d, 1, problems);
+
+    // Initial Data on CPU
+    rocblas_seedrand();
+    for(rocblas_int g = 0, p = 0; g < group_count; ++g)
+    {
+        auto A_row = groups.transA[g] == rocblas_operation_none ? groups.M[g] : groups.K[g];
+        auto A_col = groups.transA[g] == rocblas_operation_none ? groups.K[g] : groups.M[g];
+        auto B_row = groups.transB[g] == rocblas_operation_none ? groups.K[g] : groups.N[g];
+        auto B_col = groups.transB[g] == rocblas_operation_none ? groups.N[g] : groups.K[g];
+        for(rocblas_int i = 0; i < groups.group_size[g]; ++i, ++p)
+        {
+            if(arg.alpha_isnan<Tc>())
+            {
+                rocblas_init_nan<Ti>(hA[p], A_row, A_col, groups.lda[g]);
+                rocblas_init_nan<Ti>(hB[p], B_row, B_col, groups.ldb[g]);
+            }
+            else
+            {
+                rocblas_init<Ti>(hA[p], A_row, A_col, groups.lda[g]);
+                rocblas_init_alternating_sign<Ti>(hB[p], B_row, B_col, groups.ldb[g]);
+            }
+
+            if(arg.beta_isnan<Tc>())
+                rocblas_init_nan<To>(hC[p], groups.M[g], groups.N[g], groups.ldc[g]);
+            else
+                rocblas_init<To>(hC[p], groups.M[g], groups.N[g], groups.ldc[g]);
+
+            rocblas_init_nan<To>(hD_1[p], groups.M[g], groups.N[g], groups.ldd[g]);
+        }
+    }
+
+    hD_2.copy_from(hD_1);
+    for(rocblas_int p = 0; p < problems; p++)
+        for(size_t i = 0; i < size_d; i++)
+            hD_gold[p][i] = hD_1[p][i];
+
+    // copy data from CPU to device
+    CHECK_HIP_ERROR(dA.transfer_from(hA));
+    CHECK_HIP_ERROR(dB.transfer_from(hB));
+    CHECK_HIP_ERROR(dC.transfer_from(hC));
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // ROCBLAS rocblas_pointer_mode_host
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_HIP_ERROR(dD.transfer_from(hD_1));
+
+        CHECK_ROCBLAS_ERROR(grouped(h_alpha.data(),
+                                    dA.ptr_on_device(),
+                                    dB.ptr_on_device(),
+                                    h_beta.data(),
+                                    dC.ptr_on_device(),
+                                    dD.ptr_on_device(),
+                                    false));
+
+        // copy output from device to CPU
+        CHECK_HIP_ERROR(hD_1.transfer_from(dD));
+
+        // ROCBLAS rocblas_pointer_mode_device
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+        CHECK_HIP_ERROR(dD.transfer_from(hD_2));
+        CHECK_HIP_ERROR(hipMemcpy(
+            d_alpha_Tc, h_alpha.data(), sizeof(Tc) * group_count, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(
+            hipMemcpy(d_beta_Tc, h_beta.data(), sizeof(Tc) * group_count, hipMemcpyHostToDevice));
+
+        CHECK_ROCBLAS_ERROR(grouped(d_alpha_Tc,
+                                    dA.ptr_on_device(),
+                                    dB.ptr_on_device(),
+                                    d_beta_Tc,
+                                    dC.ptr_on_device(),
+                                    dD.ptr_on_device(),
+                                    false));
+
+        // copy output from device to CPU
+        CHECK_HIP_ERROR(hD_2.transfer_from(dD));
+
+        // CPU BLAS
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int g = 0, p = 0; g < group_count; ++g)
+        {
+            for(rocblas_int i = 0; i < groups.group_size[g]; ++i, ++p)
+            {
+                // copy C matrix into D matrix
+                for(rocblas_int i2 = 0; i2 < groups.N[g]; i2++)
+                    for(rocblas_int i1 = 0; i1 < groups.M[g]; i1++)
+                        hD_gold[p][i1 + i2 * groups.ldd[g]] = hC[p][i1 + i2 * groups.ldc[g]];
+
+                cblas_gemm<Ti, To_hpa>(groups.transA[g],
+                                       groups.transB[g],
+                                       groups.M[g],
+                                       groups.N[g],
+                                       groups.K[g],
+                                       h_alpha[g],
+                                       hA[p],
+                                       groups.lda[g],
+                                       hB[p],
+                                       groups.ldb[g],
+                                       h_beta[g],
+                                       hD_gold[p],
+                                       groups.ldd[g]);
+            }
+        }
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        for(rocblas_int g = 0, p = 0; g < group_count; ++g)
+        {
+            for(rocblas_int i = 0; i < groups.group_size[g]; ++i, ++p)
+            {
+                auto M = groups.M[g], N = groups.N[g], ldd = groups.ldd[g];
+                if(arg.unit_check)
+                {
+                    unit_check_general<To, To_hpa>(M, N, ldd, hD_gold[p], hD_1[p]);
+                    unit_check_general<To, To_hpa>(M, N, ldd, hD_gold[p], hD_2[p]);
+                }
+
+                if(arg.norm_check)
+                {
+                    auto err1
+                        = std::abs(norm_check_general<To>('F', M, N, ldd, hD_gold[p], hD_1[p]));
+                    auto err2
+                        = std::abs(norm_check_general<To>('F', M, N, ldd, hD_gold[p], hD_2[p]));
+                    rocblas_error = std::max({rocblas_error, err1, err2});
+                }
+            }
+        }
+    }
+
+    if(arg.timing)
+    {
+        int number_cold_calls = arg.cold_iters;
+
+        CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+        CHECK_HIP_ERROR(dD.transfer_from(hD_1));
+
+        auto timed_call = [&] {
+            return grouped(h_alpha.data(),
+                           dA.ptr_on_device(),
+                           dB.ptr_on_device(),
+                           h_beta.data(),
+                           dC.ptr_on_device(),
+                           arg.c_noalias_d ? dD.ptr_on_device() : dC.ptr_on_device(),
+                           !arg.c_noalias_d);
+        };
+
+        for(int i = 0; i < number_cold_calls; i++)
+            CHECK_ROCBLAS_ERROR(timed_call());
+
+        int         number_hot_calls = arg.iters;
+        hipStream_t stream;
+        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+        gpu_time_used = get_time_us_sync(stream); // in microseconds
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
+            timed_call();
+        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+
+        double gflops = 0;
+        for(rocblas_int g = 0; g < group_count; ++g)
+            gflops += groups.group_size[g]
+                      * gemm_gflop_count<Tc>(groups.M[g], groups.N[g], groups.K[g]);
+
+        ArgumentModel<e_transA,
+                      e_transB,
+                      e_M,
+                      e_N,
+                      e_K,
+                      e_alpha,
+                      e_lda,
+                      e_beta,
+                      e_ldb,
+                      e_ldc,
+                      e_ldd,
+                      e_batch_count>{}
+            .log_args<To>(rocblas_cout,
+                          arg,
+                          gpu_time_used,
+                          gflops,
+                          ArgumentLogging::NA_value,
+                          cpu_time_used,
+                          rocblas_error);
+    }
+}
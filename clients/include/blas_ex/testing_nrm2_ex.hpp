@@ -176,7 +176,7 @@ void testing_nrm2_ex(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_hot_calls; iter++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             rocblas_nrm2_ex_fn(
                 handle, N, dx, x_type, incx, d_rocblas_result_2, result_type, execution_type);
@@ -55,6 +55,20 @@ constexpr double axpy_gbyte_count(rocblas_int n)
     return (sizeof(T) * 3.0 * n) / 1e9;
 }
 
+/* \brief byte counts of AXPY_DOT, which reads z unless it is y */
+template <typename T>
+constexpr double axpy_dot_gbyte_count(rocblas_int n, bool z_is_y)
+{
+    return (sizeof(T) * (z_is_y ? 3.0 : 4.0) * n) / 1e9;
+}
+
+/* \brief byte counts of MULTI_DOT, which reads x once for the k vectors y */
+template <typename T>
+constexpr double multi_dot_gbyte_count(rocblas_int n, rocblas_int k)
+{
+    return (sizeof(T) * (1.0 + k) * n) / 1e9;
+}
+
 /* \brief byte counts of COPY */
 template <typename T>
 constexpr double copy_gbyte_count(rocblas_int n)
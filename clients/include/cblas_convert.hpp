@@ -0,0 +1,66 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+/******************************************************************************
+ * Precision conversion for the CPU reference of precisions which cblas does  *
+ * not support, such as rocblas_half, rocblas_bfloat16 and int8_t, which are   *
+ * converted to float or double before calling cblas and converted back after. *
+ *                                                                             *
+ * Matrices are converted in panels of whole columns, which are distributed   *
+ * over the OpenMP threads, and only the rows in use are converted. The       *
+ * converted copies are kept in scratch buffers which are reused by the next  *
+ * reference call on the same thread, so that large reference GEMMs do not    *
+ * allocate and page in new buffers on every call.                             *
+ ******************************************************************************/
+
+// Number of elements converted by each OpenMP iteration
+constexpr size_t CBLAS_CONVERT_PANEL_ELEMENTS = 64 * 1024;
+
+/*! \brief Convert the rows x cols column-major matrix src to dst, which both
+    have leading dimension ld. Elements between rows and ld are not written. */
+template <typename Td, typename Ts>
+void cblas_convert_matrix(Td* dst, const Ts* src, size_t rows, size_t cols, size_t ld)
+{
+    if(!rows || !cols)
+        return;
+
+    size_t    panel_cols = std::max<size_t>(1, CBLAS_CONVERT_PANEL_ELEMENTS / rows);
+    ptrdiff_t panels     = (cols + panel_cols - 1) / panel_cols;
+
+#pragma omp parallel for schedule(static)
+    for(ptrdiff_t p = 0; p < panels; ++p)
+    {
+        size_t end = std::min(cols, (p + 1) * panel_cols);
+        for(size_t j = p * panel_cols; j < end; ++j)
+        {
+            const Ts* s = src + j * ld;
+            Td*       d = dst + j * ld;
+            for(size_t i = 0; i < rows; ++i)
+                d[i] = static_cast<Td>(s[i]);
+        }
+    }
+}
+
+/*! \brief Uninitialized scratch buffer of at least size elements of T. Each
+    slot is a separate buffer per thread, which only grows, and is kept until
+    the thread exits; its contents are not preserved when it grows. */
+template <typename T, int slot>
+T* cblas_convert_scratch(size_t size)
+{
+    thread_local std::unique_ptr<T[]> buffer;
+    thread_local size_t               capacity = 0;
+    if(size > capacity)
+    {
+        buffer.reset(); // Free before allocating, to not hold both
+        buffer.reset(new T[size]);
+        capacity = size;
+    }
+    return buffer.get();
+}
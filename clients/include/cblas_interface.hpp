@@ -8,6 +8,8 @@
 #include "cblas.h"
 #include "rocblas.h"
 #include "rocblas.hpp"
+#include <cmath>
+#include <limits>
 #include <type_traits>
 
 /*!\file
@@ -2352,6 +2354,66 @@ inline void cblas_gemm(rocblas_operation       transA,
                 ldc);
 }
 
+// gemm epilogue
+// out = convert(clamp(activation(scale * D + bias))), computed in Te like the epilogue of
+// rocblas_gemm_ex_epilogue. scale and bias are host vectors of Tv, used according to their
+// modes.
+template <typename Te, typename Tv, typename Td, typename To>
+void cblas_gemm_epilogue(rocblas_int                      m,
+                         rocblas_int                      n,
+                         const Td*                        D,
+                         rocblas_int                      ldd,
+                         rocblas_gemm_epilogue_vector     scale_mode,
+                         const Tv*                        scale,
+                         rocblas_gemm_epilogue_vector     bias_mode,
+                         const Tv*                        bias,
+                         rocblas_gemm_epilogue_activation activation,
+                         bool                             clamp,
+                         Te                               clamp_min,
+                         Te                               clamp_max,
+                         To*                              out,
+                         rocblas_int                      ldo)
+{
+    for(rocblas_int j = 0; j < n; j++)
+    {
+        for(rocblas_int i = 0; i < m; i++)
+        {
+            Te x = Te(D[i + size_t(j) * ldd]);
+            if(scale_mode != rocblas_gemm_epilogue_vector_none)
+                x *= Te(scale[scale_mode == rocblas_gemm_epilogue_vector_row ? i : j]);
+            if(bias_mode != rocblas_gemm_epilogue_vector_none)
+                x += Te(bias[bias_mode == rocblas_gemm_epilogue_vector_row ? i : j]);
+
+            if(activation == rocblas_gemm_epilogue_activation_relu)
+                x = x < 0 ? Te(0) : x;
+            else if(activation == rocblas_gemm_epilogue_activation_gelu)
+                x = Te(0.5) * x
+                    * (1 + std::tanh(Te(0.7978845608028654) * (x + Te(0.044715) * x * x * x)));
+
+            if(clamp)
+                x = x < clamp_min ? clamp_min : x > clamp_max ? clamp_max : x;
+
+            To& y = out[i + size_t(j) * ldo];
+            if constexpr(std::is_integral<To>{})
+            {
+                // round to nearest even and saturate, with NaN as 0
+                if(x != x)
+                    y = 0;
+                else if(x >= Te(std::numeric_limits<To>::max()))
+                    y = std::numeric_limits<To>::max();
+                else if(x <= Te(std::numeric_limits<To>::lowest()))
+                    y = std::numeric_limits<To>::lowest();
+                else
+                    y = To(std::nearbyint(x));
+            }
+            else
+            {
+                y = To(x);
+            }
+        }
+    }
+}
+
 // symm
 template <typename T>
 void cblas_symm(rocblas_side side,
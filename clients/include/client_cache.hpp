@@ -0,0 +1,46 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <cstddef>
+
+/*!\file
+ * \brief Reuse of handles and memory across the tests run by one process.
+ *
+ * rocblas-bench runs many command lines in one process in batch mode. Without
+ * this cache each of them would create its own handle, and allocate and free
+ * its own device and pinned host buffers. When the cache is enabled, handles
+ * of rocblas_local_handle and freed buffers of device_vector and
+ * host_pinned_vector are kept, and reused by later tests: a buffer is reused
+ * for requests of the same or a smaller size, and is replaced by a larger one
+ * when none is large enough, so the cache grows to the largest sizes used.
+ *
+ * When the cache is disabled, which is the default, these functions allocate
+ * and free directly.
+ */
+
+/*! \brief Enable or disable the cache. Disabling it frees what it holds. */
+void rocblas_client_cache_enable(bool enable);
+
+/*! \brief Whether the cache is enabled */
+bool rocblas_client_cache_enabled();
+
+/*! \brief Free the memory and handles held by the cache */
+void rocblas_client_cache_clear();
+
+/*! \brief Allocate device memory, or pinned host memory if host is true.
+    Returns nullptr on failure. */
+void* rocblas_client_malloc(size_t bytes, bool host);
+
+/*! \brief Free memory from rocblas_client_malloc */
+hipError_t rocblas_client_free(void* ptr, bool host);
+
+/*! \brief Take a handle from the cache, or nullptr if there is none */
+rocblas_handle rocblas_client_cache_take_handle();
+
+/*! \brief Return a handle to the cache, resetting its stream and its pointer,
+    atomics and host result modes. Returns false if the cache is disabled. */
+bool rocblas_client_cache_return_handle(rocblas_handle handle);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "client_cache.hpp"
 #include "rocblas.h"
 #include "rocblas_init.hpp"
 #include "rocblas_test.hpp"
@@ -50,8 +51,9 @@ protected:
 
     T* device_vector_setup()
     {
-        T* d;
-        if(use_HMM ? hipMallocManaged(&d, bytes) : (hipMalloc)(&d, bytes) != hipSuccess)
+        T* d = nullptr;
+        if(use_HMM ? hipMallocManaged(&d, bytes) != hipSuccess
+                   : !(d = static_cast<T*>(rocblas_client_malloc(bytes, false))))
         {
             rocblas_cerr << "Error allocating " << bytes << " bytes (" << (bytes >> 30) << " GB)"
                          << std::endl;
@@ -128,7 +130,7 @@ protected:
             }
 #endif
             // Free device memory
-            CHECK_HIP_ERROR((hipFree)(d));
+            CHECK_HIP_ERROR(use_HMM ? (hipFree)(d) : rocblas_client_free(d, false));
         }
     }
 };
@@ -58,6 +58,23 @@ constexpr double axpy_gflop_count<rocblas_double_complex>(rocblas_int n)
     return (8.0 * n) / 1e9;
 }
 
+// axpby
+template <typename T>
+constexpr double axpby_gflop_count(rocblas_int n)
+{
+    return (3.0 * n) / 1e9;
+}
+template <>
+constexpr double axpby_gflop_count<rocblas_float_complex>(rocblas_int n)
+{
+    return (14.0 * n) / 1e9; // 6 for each c-c multiply, 2 for c-c add
+}
+template <>
+constexpr double axpby_gflop_count<rocblas_double_complex>(rocblas_int n)
+{
+    return (14.0 * n) / 1e9;
+}
+
 // dot
 template <bool CONJ, typename T>
 constexpr double dot_gflop_count(rocblas_int n)
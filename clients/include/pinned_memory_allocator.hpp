@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "client_cache.hpp"
 #include <hip/hip_runtime.h>
 
 //!
@@ -24,20 +25,16 @@ struct pinned_memory_allocator
 
     T* allocate(std::size_t n)
     {
-        T*         ptr;
-        hipError_t status = hipHostMalloc(&ptr, sizeof(T) * n, hipHostMallocDefault);
-        if(status != hipSuccess)
-        {
-            ptr = nullptr;
-            rocblas_cerr << "rocBLAS pinned_memory_allocator failed to allocate memory: "
-                         << hipGetErrorString(status) << std::endl;
-        }
+        T* ptr = static_cast<T*>(rocblas_client_malloc(sizeof(T) * n, true));
+        if(!ptr)
+            rocblas_cerr << "rocBLAS pinned_memory_allocator failed to allocate memory"
+                         << std::endl;
         return ptr;
     }
 
     void deallocate(T* ptr, std::size_t n)
     {
-        hipError_t status = hipHostFree(ptr);
+        hipError_t status = rocblas_client_free(ptr, true);
         if(status != hipSuccess)
         {
             rocblas_cerr << "rocBLAS pinned_memory_allocator failed to free memory: "
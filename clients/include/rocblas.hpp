@@ -60,6 +60,13 @@
     static auto FN<A, B, C, true> = PFN
 #endif
 
+// mapping C-only functions, which have no Fortran bindings, to C API
+#define MAP2C(FN, A, PFN)           \
+    template <>                     \
+    static auto FN<A, false> = PFN; \
+    template <>                     \
+    static auto FN<A, true> = PFN
+
 /*!\file
  *  This file exposes C++ templated BLAS interface with only the precision templated.
  */
@@ -738,6 +745,225 @@ static rocblas_status (*rocblas_rotmg_strided_batched)(rocblas_handle handle,
 MAP2CF(rocblas_rotmg_strided_batched, float, rocblas_srotmg_strided_batched);
 MAP2CF(rocblas_rotmg_strided_batched, double, rocblas_drotmg_strided_batched);
 
+/*
+ * ===========================================================================
+ *    fused level 1 BLAS
+ * ===========================================================================
+ */
+
+// axpby
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_axpby)(rocblas_handle handle,
+                                       rocblas_int    n,
+                                       const T*       alpha,
+                                       const T*       x,
+                                       rocblas_int    incx,
+                                       const T*       beta,
+                                       T*             y,
+                                       rocblas_int    incy);
+
+MAP2C(rocblas_axpby, float, rocblas_saxpby);
+MAP2C(rocblas_axpby, double, rocblas_daxpby);
+MAP2C(rocblas_axpby, rocblas_float_complex, rocblas_caxpby);
+MAP2C(rocblas_axpby, rocblas_double_complex, rocblas_zaxpby);
+
+// axpby batched
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_axpby_batched)(rocblas_handle handle,
+                                               rocblas_int    n,
+                                               const T*       alpha,
+                                               const T* const x[],
+                                               rocblas_int    incx,
+                                               const T*       beta,
+                                               T* const       y[],
+                                               rocblas_int    incy,
+                                               rocblas_int    batch_count);
+
+MAP2C(rocblas_axpby_batched, float, rocblas_saxpby_batched);
+MAP2C(rocblas_axpby_batched, double, rocblas_daxpby_batched);
+MAP2C(rocblas_axpby_batched, rocblas_float_complex, rocblas_caxpby_batched);
+MAP2C(rocblas_axpby_batched, rocblas_double_complex, rocblas_zaxpby_batched);
+
+// axpby strided batched
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_axpby_strided_batched)(rocblas_handle handle,
+                                                       rocblas_int    n,
+                                                       const T*       alpha,
+                                                       const T*       x,
+                                                       rocblas_int    incx,
+                                                       rocblas_stride stridex,
+                                                       const T*       beta,
+                                                       T*             y,
+                                                       rocblas_int    incy,
+                                                       rocblas_stride stridey,
+                                                       rocblas_int    batch_count);
+
+MAP2C(rocblas_axpby_strided_batched, float, rocblas_saxpby_strided_batched);
+MAP2C(rocblas_axpby_strided_batched, double, rocblas_daxpby_strided_batched);
+MAP2C(rocblas_axpby_strided_batched, rocblas_float_complex, rocblas_caxpby_strided_batched);
+MAP2C(rocblas_axpby_strided_batched, rocblas_double_complex, rocblas_zaxpby_strided_batched);
+
+// axpy_dot
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_axpy_dot)(rocblas_handle handle,
+                                          rocblas_int    n,
+                                          const T*       alpha,
+                                          const T*       x,
+                                          rocblas_int    incx,
+                                          T*             y,
+                                          rocblas_int    incy,
+                                          const T*       z,
+                                          rocblas_int    incz,
+                                          T*             result);
+
+MAP2C(rocblas_axpy_dot, float, rocblas_saxpy_dot);
+MAP2C(rocblas_axpy_dot, double, rocblas_daxpy_dot);
+MAP2C(rocblas_axpy_dot, rocblas_float_complex, rocblas_caxpy_dot);
+MAP2C(rocblas_axpy_dot, rocblas_double_complex, rocblas_zaxpy_dot);
+
+// axpy_dot batched
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_axpy_dot_batched)(rocblas_handle handle,
+                                                  rocblas_int    n,
+                                                  const T*       alpha,
+                                                  const T* const x[],
+                                                  rocblas_int    incx,
+                                                  T* const       y[],
+                                                  rocblas_int    incy,
+                                                  const T* const z[],
+                                                  rocblas_int    incz,
+                                                  rocblas_int    batch_count,
+                                                  T*             result);
+
+MAP2C(rocblas_axpy_dot_batched, float, rocblas_saxpy_dot_batched);
+MAP2C(rocblas_axpy_dot_batched, double, rocblas_daxpy_dot_batched);
+MAP2C(rocblas_axpy_dot_batched, rocblas_float_complex, rocblas_caxpy_dot_batched);
+MAP2C(rocblas_axpy_dot_batched, rocblas_double_complex, rocblas_zaxpy_dot_batched);
+
+// axpy_dot strided batched
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_axpy_dot_strided_batched)(rocblas_handle handle,
+                                                          rocblas_int    n,
+                                                          const T*       alpha,
+                                                          const T*       x,
+                                                          rocblas_int    incx,
+                                                          rocblas_stride stridex,
+                                                          T*             y,
+                                                          rocblas_int    incy,
+                                                          rocblas_stride stridey,
+                                                          const T*       z,
+                                                          rocblas_int    incz,
+                                                          rocblas_stride stridez,
+                                                          rocblas_int    batch_count,
+                                                          T*             result);
+
+MAP2C(rocblas_axpy_dot_strided_batched, float, rocblas_saxpy_dot_strided_batched);
+MAP2C(rocblas_axpy_dot_strided_batched, double, rocblas_daxpy_dot_strided_batched);
+MAP2C(rocblas_axpy_dot_strided_batched, rocblas_float_complex, rocblas_caxpy_dot_strided_batched);
+MAP2C(rocblas_axpy_dot_strided_batched, rocblas_double_complex, rocblas_zaxpy_dot_strided_batched);
+
+// multi_dot
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_multi_dot)(rocblas_handle handle,
+                                           rocblas_int    n,
+                                           rocblas_int    k,
+                                           const T*       x,
+                                           rocblas_int    incx,
+                                           const T*       y,
+                                           rocblas_int    incy,
+                                           rocblas_int    ldy,
+                                           T*             results);
+
+MAP2C(rocblas_multi_dot, float, rocblas_smulti_dot);
+MAP2C(rocblas_multi_dot, double, rocblas_dmulti_dot);
+MAP2C(rocblas_multi_dot, rocblas_float_complex, rocblas_cmulti_dot);
+MAP2C(rocblas_multi_dot, rocblas_double_complex, rocblas_zmulti_dot);
+
+// multi_dot batched
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_multi_dot_batched)(rocblas_handle handle,
+                                                   rocblas_int    n,
+                                                   rocblas_int    k,
+                                                   const T* const x[],
+                                                   rocblas_int    incx,
+                                                   const T* const y[],
+                                                   rocblas_int    incy,
+                                                   rocblas_int    ldy,
+                                                   rocblas_int    batch_count,
+                                                   T*             results);
+
+MAP2C(rocblas_multi_dot_batched, float, rocblas_smulti_dot_batched);
+MAP2C(rocblas_multi_dot_batched, double, rocblas_dmulti_dot_batched);
+MAP2C(rocblas_multi_dot_batched, rocblas_float_complex, rocblas_cmulti_dot_batched);
+MAP2C(rocblas_multi_dot_batched, rocblas_double_complex, rocblas_zmulti_dot_batched);
+
+// multi_dot strided batched
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_multi_dot_strided_batched)(rocblas_handle handle,
+                                                           rocblas_int    n,
+                                                           rocblas_int    k,
+                                                           const T*       x,
+                                                           rocblas_int    incx,
+                                                           rocblas_stride stridex,
+                                                           const T*       y,
+                                                           rocblas_int    incy,
+                                                           rocblas_int    ldy,
+                                                           rocblas_stride stridey,
+                                                           rocblas_int    batch_count,
+                                                           T*             results);
+
+MAP2C(rocblas_multi_dot_strided_batched, float, rocblas_smulti_dot_strided_batched);
+MAP2C(rocblas_multi_dot_strided_batched, double, rocblas_dmulti_dot_strided_batched);
+MAP2C(rocblas_multi_dot_strided_batched, rocblas_float_complex, rocblas_cmulti_dot_strided_batched);
+MAP2C(
+    rocblas_multi_dot_strided_batched, rocblas_double_complex, rocblas_zmulti_dot_strided_batched);
+
+// scal_nrm2
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_scal_nrm2)(rocblas_handle handle,
+                                           rocblas_int    n,
+                                           const T*       alpha,
+                                           T*             x,
+                                           rocblas_int    incx,
+                                           real_t<T>*     result);
+
+MAP2C(rocblas_scal_nrm2, float, rocblas_sscal_nrm2);
+MAP2C(rocblas_scal_nrm2, double, rocblas_dscal_nrm2);
+MAP2C(rocblas_scal_nrm2, rocblas_float_complex, rocblas_cscal_nrm2);
+MAP2C(rocblas_scal_nrm2, rocblas_double_complex, rocblas_zscal_nrm2);
+
+// scal_nrm2 batched
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_scal_nrm2_batched)(rocblas_handle handle,
+                                                   rocblas_int    n,
+                                                   const T*       alpha,
+                                                   T* const       x[],
+                                                   rocblas_int    incx,
+                                                   rocblas_int    batch_count,
+                                                   real_t<T>*     result);
+
+MAP2C(rocblas_scal_nrm2_batched, float, rocblas_sscal_nrm2_batched);
+MAP2C(rocblas_scal_nrm2_batched, double, rocblas_dscal_nrm2_batched);
+MAP2C(rocblas_scal_nrm2_batched, rocblas_float_complex, rocblas_cscal_nrm2_batched);
+MAP2C(rocblas_scal_nrm2_batched, rocblas_double_complex, rocblas_zscal_nrm2_batched);
+
+// scal_nrm2 strided batched
+template <typename T, bool FORTRAN = false>
+static rocblas_status (*rocblas_scal_nrm2_strided_batched)(rocblas_handle handle,
+                                                           rocblas_int    n,
+                                                           const T*       alpha,
+                                                           T*             x,
+                                                           rocblas_int    incx,
+                                                           rocblas_stride stridex,
+                                                           rocblas_int    batch_count,
+                                                           real_t<T>*     result);
+
+MAP2C(rocblas_scal_nrm2_strided_batched, float, rocblas_sscal_nrm2_strided_batched);
+MAP2C(rocblas_scal_nrm2_strided_batched, double, rocblas_dscal_nrm2_strided_batched);
+MAP2C(rocblas_scal_nrm2_strided_batched, rocblas_float_complex, rocblas_cscal_nrm2_strided_batched);
+MAP2C(
+    rocblas_scal_nrm2_strided_batched, rocblas_double_complex, rocblas_zscal_nrm2_strided_batched);
+
 /*
  * ===========================================================================
  *    level 2 BLAS
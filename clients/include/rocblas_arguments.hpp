@@ -162,8 +162,9 @@ struct Arguments
 
     // clang-format on
 
-    // Validate input format.
+    // Validate input format, from a stream or from the start of data in memory.
     static void validate(std::istream& ifs);
+    static void validate(const char* data, size_t size);
 
     // Function to print Arguments out to stream in YAML format
     friend rocblas_internal_ostream& operator<<(rocblas_internal_ostream& str,
@@ -241,6 +242,10 @@ static_assert(std::is_trivial<Arguments>{},
               "Arguments is not a trivial type, and thus is "
               "incompatible with C.");
 
+// Size of the signature which starts binary test data: an 8 byte header, an
+// Arguments whose bytes identify the layout of each field, and an 8 byte trailer
+constexpr size_t rocblas_arguments_signature_size = 8 + sizeof(Arguments) + 8;
+
 // Arguments enumerators
 // Create
 //     enum rocblas_argument : int {e_M, e_N, e_K, e_KL, ... };
@@ -7,6 +7,7 @@
 #include "rocblas_arguments.hpp"
 #include "test_cleanup.hpp"
 #include <cerrno>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -16,6 +17,14 @@
 #include <iterator>
 #include <string>
 #include <utility>
+#include <vector>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 // https://en.cppreference.com/w/User:D41D8CD98F/feature_testing_macros
 //
@@ -41,23 +50,103 @@ class RocBLAS_TestData
         return filename;
     }
 
+    // Contents of the data file, mapped into memory, or read into a buffer
+    // when the file cannot be mapped, such as when it is a pipe
+    class data_file
+    {
+        const char*       m_data = nullptr;
+        size_t            m_size = 0;
+        void*             m_map  = nullptr;
+        std::vector<char> m_buffer;
+
+    public:
+        explicit data_file(const std::string& name)
+        {
+#ifndef WIN32
+            int fd = open(name.c_str(), O_RDONLY | O_CLOEXEC);
+            if(fd != -1)
+            {
+                struct stat st;
+                if(!fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0)
+                {
+                    void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if(map != MAP_FAILED)
+                    {
+                        m_map  = map;
+                        m_data = static_cast<const char*>(map);
+                        m_size = st.st_size;
+                    }
+                }
+                close(fd);
+                if(m_map)
+                    return;
+            }
+#endif
+            std::ifstream ifs(name, std::ifstream::in | std::ifstream::binary);
+            if(ifs.fail())
+            {
+                rocblas_cerr << "Cannot open " << name << ": " << strerror(errno) << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            m_buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+            m_data = m_buffer.data();
+            m_size = m_buffer.size();
+        }
+
+        ~data_file()
+        {
+#ifndef WIN32
+            if(m_map)
+                munmap(m_map, m_size);
+#endif
+        }
+
+        data_file(const data_file&) = delete;
+        data_file& operator=(const data_file&) = delete;
+
+        const char* data() const
+        {
+            return m_data;
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+    };
+
+    // Arguments records are read in place, after the signature, which keeps
+    // them aligned in a mapping or a buffer
+    static_assert(rocblas_arguments_signature_size % alignof(Arguments) == 0
+                      && alignof(Arguments) <= alignof(std::max_align_t),
+                  "Arguments records in the data file are not aligned");
+
     // filter iterator
-    class iterator : public std::istream_iterator<Arguments>
+    class iterator
     {
-        bool (*const filter)(const Arguments&) = nullptr;
+        const Arguments* pos = nullptr;
+        const Arguments* last = nullptr;
+        bool (*filter)(const Arguments&) = nullptr;
 
         // Skip entries for which filter is false
         void skip_filter()
         {
             if(filter)
-                while(*this != std::istream_iterator<Arguments>{} && !filter(**this))
-                    ++*static_cast<std::istream_iterator<Arguments>*>(this);
+                while(pos != last && !filter(*pos))
+                    ++pos;
         }
 
     public:
-        // Constructor takes a filter and iterator
-        iterator(bool filter(const Arguments&), std::istream_iterator<Arguments> iter)
-            : std::istream_iterator<Arguments>(iter)
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Arguments;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Arguments*;
+        using reference         = const Arguments&;
+
+        // Constructor takes a filter and the range of records
+        iterator(bool filter(const Arguments&), const Arguments* pos, const Arguments* last)
+            : pos(pos)
+            , last(last)
             , filter(filter)
         {
             skip_filter();
@@ -66,18 +155,41 @@ class RocBLAS_TestData
         // Default end iterator and nullptr filter
         iterator() = default;
 
+        reference operator*() const
+        {
+            return *pos;
+        }
+
+        pointer operator->() const
+        {
+            return pos;
+        }
+
         // Preincrement iterator operator with filtering
         iterator& operator++()
         {
-            ++*static_cast<std::istream_iterator<Arguments>*>(this);
+            ++pos;
             skip_filter();
             return *this;
         }
 
-        // We do not need a postincrement iterator operator
-        // We delete it here so that the base class's isn't silently called
-        // To implement it, use "auto old = *this; ++*this; return old;"
-        iterator operator++(int) = delete;
+        iterator operator++(int)
+        {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+        // All iterators at the end of the records compare equal to end()
+        bool operator==(const iterator& rhs) const
+        {
+            return pos == last ? rhs.pos == rhs.last : pos == rhs.pos;
+        }
+
+        bool operator!=(const iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
     };
 
 public:
@@ -96,33 +208,26 @@ public:
     // begin() iterator which accepts an optional filter.
     static iterator begin(bool filter(const Arguments&) = nullptr)
     {
-        static std::ifstream* ifs = nullptr;
+        static data_file* file = nullptr;
 
         // If this is the first time, or after test_cleanup::cleanup() has been called
-        if(!ifs)
+        if(!file)
         {
-            std::string fileToOpen = filename();
-            // Allocate a std::ifstream and register it to be deleted during cleanup
-            ifs = test_cleanup::allocate(
-                &ifs, fileToOpen, std::ifstream::in | std::ifstream::binary);
-            if(!ifs || ifs->fail())
-            {
-                rocblas_cerr << "Cannot open " << fileToOpen << ": " << strerror(errno)
-                             << std::endl;
-                exit(EXIT_FAILURE);
-            }
+            // Allocate a data_file and register it to be deleted during cleanup
+            file = test_cleanup::allocate(&file, filename());
         }
 
-        // We re-seek the file back to position 0
-        ifs->clear();
-        ifs->seekg(0);
-
         // Validate the data file format
-        Arguments::validate(*ifs);
+        Arguments::validate(file->data(), file->size());
+
+        // The records follow the signature, and are used without copying the file
+        size_t count = (file->size() - rocblas_arguments_signature_size) / sizeof(Arguments);
+        auto   first = reinterpret_cast<const Arguments*>(file->data()
+                                                        + rocblas_arguments_signature_size);
 
         // We create a filter iterator which will choose only the test cases we want right now.
         // This is to preserve Gtest structure while not creating no-op tests which "always pass".
-        return iterator(filter, std::istream_iterator<Arguments>(*ifs));
+        return iterator(filter, first, first + count);
     }
 
     // end() iterator
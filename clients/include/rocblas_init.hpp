@@ -8,7 +8,9 @@
 #include "rocblas.h"
 #include "rocblas_math.hpp"
 #include "rocblas_random.hpp"
+#include <algorithm>
 #include <cinttypes>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -17,15 +19,45 @@
 // for vector x (M=1, N=lengthX, lda=incx);
 // for complex number, the real/imag part would be initialized with the same value
 
-// Initialize vector with random values
-template <typename T>
-void rocblas_init(
-    std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+// Rows initialized by each OpenMP iteration
+constexpr size_t ROCBLAS_INIT_ROW_BLOCK = 4096;
+
+// Minimum number of elements for which initialization is split across the OpenMP threads
+constexpr size_t ROCBLAS_INIT_PARALLEL_ELEMENTS = 64 * 1024;
+
+/*! \brief Calls f(b, j, i_begin, i_end) for blocks of rows [i_begin, i_end) covering rows [0, M)
+    of each column j < N of each batch b < batch_count, in parallel over the OpenMP threads when
+    there are enough elements. f must only write the elements of its block. */
+template <typename F>
+void rocblas_init_blocks(size_t M, size_t N, size_t batch_count, F f)
+{
+    size_t    row_blocks = (M + ROCBLAS_INIT_ROW_BLOCK - 1) / ROCBLAS_INIT_ROW_BLOCK;
+    size_t    columns    = N * batch_count;
+    ptrdiff_t blocks     = row_blocks * columns;
+
+#pragma omp parallel for schedule(static) if(M * columns >= ROCBLAS_INIT_PARALLEL_ELEMENTS)
+    for(ptrdiff_t k = 0; k < blocks; ++k)
+    {
+        size_t c       = k / row_blocks;
+        size_t i_begin = (k % row_blocks) * ROCBLAS_INIT_ROW_BLOCK;
+        f(c / N, c % N, i_begin, std::min(M, i_begin + ROCBLAS_INIT_ROW_BLOCK));
+    }
+}
+
+/*! \brief Sets rows [0, M) of the columns of batch_count matrices to gen(bits, i, j), where bits
+    are counter-based random bits of the element. The values do not depend on the number of
+    threads. The generator is seeded from t_rocblas_rng, so that successive calls differ. */
+template <typename T, typename G>
+void rocblas_init_random(
+    T* A, size_t M, size_t N, size_t lda, size_t stride, size_t batch_count, G gen)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = random_generator<T>();
+    auto rng = rocblas_counter_rng::from_thread_rng();
+    rocblas_init_blocks(M, N, batch_count, [&](size_t b, size_t j, size_t i_begin, size_t i_end) {
+        uint64_t column = rng.column(b, j);
+        T*       col    = A + b * stride + j * lda;
+        for(size_t i = i_begin; i < i_end; ++i)
+            col[i] = gen(rocblas_counter_rng::bits(column, i), i, j);
+    });
 }
 
 // Initialize vector with random values
@@ -33,20 +65,27 @@ template <typename T>
 inline void
     rocblas_init(T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = random_generator<T>();
+    rocblas_init_random(A, M, N, lda, stride, batch_count, [](uint64_t bits, size_t, size_t) {
+        return random_counter_generator<T>(bits);
+    });
+}
+
+// Initialize vector with random values
+template <typename T>
+void rocblas_init(
+    std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+{
+    rocblas_init(A.data(), M, N, lda, stride, batch_count);
 }
 
 template <typename T>
 void rocblas_init_sin(
     std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = sin(i + j * lda + i_batch * stride);
+    rocblas_init_blocks(M, N, batch_count, [&](size_t b, size_t j, size_t i_begin, size_t i_end) {
+        for(size_t i = i_begin; i < i_end; ++i)
+            A[i + j * lda + b * stride] = sin(i + j * lda + b * stride);
+    });
 }
 
 // Initialize matrix so adjacent entries have alternating sign.
@@ -58,38 +97,29 @@ void rocblas_init_sin(
 // mantissa 10 bits.
 template <typename T>
 void rocblas_init_alternating_sign(
-    std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+    T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-            {
-                auto value                        = random_generator<T>();
-                A[i + j * lda + i_batch * stride] = (i ^ j) & 1 ? value : negate(value);
-            }
+    rocblas_init_random(A, M, N, lda, stride, batch_count, [](uint64_t bits, size_t i, size_t j) {
+        auto value = random_counter_generator<T>(bits);
+        return (i ^ j) & 1 ? value : negate(value);
+    });
 }
 
 template <typename T>
 void rocblas_init_alternating_sign(
-    T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+    std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-            {
-                auto value                        = random_generator<T>();
-                A[i + j * lda + i_batch * stride] = (i ^ j) & 1 ? value : negate(value);
-            }
+    rocblas_init_alternating_sign(A.data(), M, N, lda, stride, batch_count);
 }
 
 template <typename T>
 void rocblas_init_cos(
     std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = cos(i + j * lda + i_batch * stride);
+    rocblas_init_blocks(M, N, batch_count, [&](size_t b, size_t j, size_t i_begin, size_t i_end) {
+        for(size_t i = i_begin; i < i_end; ++i)
+            A[i + j * lda + b * stride] = cos(i + j * lda + b * stride);
+    });
 }
 
 /*! \brief  symmetric matrix initialization: */
@@ -165,51 +195,53 @@ template <typename T>
 void rocblas_init_hpl(
     std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = random_hpl_generator<T>();
+    rocblas_init_random(
+        A.data(), M, N, lda, stride, batch_count, [](uint64_t bits, size_t, size_t) {
+            return random_counter_hpl_generator<T>(bits);
+        });
 }
 
 /* ============================================================================================ */
 /*! \brief  Initialize an array with random data, with NaN where appropriate */
 
 template <typename T>
-void rocblas_init_nan(T* A, size_t N)
+void rocblas_init_nan(T* A, size_t start_offset, size_t end_offset)
 {
-    for(size_t i = 0; i < N; ++i)
-        A[i] = T(rocblas_nan_rng());
+    if(end_offset > start_offset)
+        rocblas_init_random(A + start_offset,
+                            end_offset - start_offset,
+                            1,
+                            0,
+                            0,
+                            1,
+                            [](uint64_t bits, size_t, size_t) {
+                                return random_counter_nan_generator<T>(bits);
+                            });
 }
 
 template <typename T>
-void rocblas_init_nan(T* A, size_t start_offset, size_t end_offset)
+void rocblas_init_nan(T* A, size_t N)
 {
-    for(size_t i = start_offset; i < end_offset; ++i)
-        A[i] = T(rocblas_nan_rng());
+    rocblas_init_nan(A, 0, N);
 }
 
 template <typename T>
 void rocblas_init_nan_tri(
     bool upper, T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-            {
-                T val                             = upper ? (j >= i ? T(rocblas_nan_rng()) : 0)
-                                                          : (j <= i ? T(rocblas_nan_rng()) : 0);
-                A[i + j * lda + i_batch * stride] = val;
-            }
+    rocblas_init_random(
+        A, M, N, lda, stride, batch_count, [upper](uint64_t bits, size_t i, size_t j) {
+            return (upper ? j >= i : j <= i) ? random_counter_nan_generator<T>(bits) : T(0);
+        });
 }
 
 template <typename T>
 void rocblas_init_nan(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = T(rocblas_nan_rng());
+    rocblas_init_random(A, M, N, lda, stride, batch_count, [](uint64_t bits, size_t, size_t) {
+        return random_counter_nan_generator<T>(bits);
+    });
 }
 
 template <typename T>
@@ -223,27 +255,33 @@ void rocblas_init_nan(
 /*! \brief  Initialize an array with random data, with Inf where appropriate */
 
 template <typename T>
-void rocblas_init_inf(T* A, size_t N)
+void rocblas_init_inf(T* A, size_t start_offset, size_t end_offset)
 {
-    for(size_t i = 0; i < N; ++i)
-        A[i] = T(rocblas_inf_rng());
+    if(end_offset > start_offset)
+        rocblas_init_random(A + start_offset,
+                            end_offset - start_offset,
+                            1,
+                            0,
+                            0,
+                            1,
+                            [](uint64_t bits, size_t, size_t) {
+                                return random_counter_inf_generator<T>(bits);
+                            });
 }
 
 template <typename T>
-void rocblas_init_inf(T* A, size_t start_offset, size_t end_offset)
+void rocblas_init_inf(T* A, size_t N)
 {
-    for(size_t i = start_offset; i < end_offset; ++i)
-        A[i] = T(rocblas_inf_rng());
+    rocblas_init_inf(A, 0, N);
 }
 
 template <typename T>
 void rocblas_init_inf(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = T(rocblas_inf_rng());
+    rocblas_init_random(A, M, N, lda, stride, batch_count, [](uint64_t bits, size_t, size_t) {
+        return random_counter_inf_generator<T>(bits);
+    });
 }
 
 template <typename T>
@@ -260,17 +298,24 @@ template <typename T>
 void rocblas_init_zero(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = T(rocblas_zero_rng());
+    rocblas_init_random(A, M, N, lda, stride, batch_count, [](uint64_t bits, size_t, size_t) {
+        return random_counter_zero_generator<T>(bits);
+    });
 }
 
 template <typename T>
 void rocblas_init_zero(T* A, size_t start_offset, size_t end_offset)
 {
-    for(size_t i = start_offset; i < end_offset; ++i)
-        A[i] = T(rocblas_zero_rng());
+    if(end_offset > start_offset)
+        rocblas_init_random(A + start_offset,
+                            end_offset - start_offset,
+                            1,
+                            0,
+                            0,
+                            1,
+                            [](uint64_t bits, size_t, size_t) {
+                                return random_counter_zero_generator<T>(bits);
+                            });
 }
 
 /* ============================================================================================ */
@@ -342,8 +387,8 @@ void rocblas_copy_matrix(const T* A,
                          size_t   strideb     = 0,
                          size_t   batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                B[i + j * ldb + i_batch * strideb] = A[i + j * lda + i_batch * stridea];
+    rocblas_init_blocks(M, N, batch_count, [&](size_t b, size_t j, size_t i_begin, size_t i_end) {
+        for(size_t i = i_begin; i < i_end; ++i)
+            B[i + j * ldb + b * strideb] = A[i + j * lda + b * stridea];
+    });
 }
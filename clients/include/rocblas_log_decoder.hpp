@@ -0,0 +1,271 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "../../library/src/include/rocblas_binary_log.hpp"
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*****************************************************************************
+ * rocblas_binary_log::decoder converts the binary trace and bench logs      *
+ * written with ROCBLAS_LOG_BINARY=1 back into the text that rocBLAS writes  *
+ * by default: comma-separated trace lines and rocblas-bench command lines.  *
+ * It is used by rocblas-log-decode, and by binary_log_gtest to check that   *
+ * the decoded text matches the text log.                                    *
+ *****************************************************************************/
+namespace rocblas_binary_log
+{
+    // Reads the payload of one record
+    class payload_reader
+    {
+        const std::string& buf;
+        size_t             pos = 0;
+
+    public:
+        explicit payload_reader(const std::string& buf)
+            : buf(buf)
+        {
+        }
+
+        template <typename T>
+        T get()
+        {
+            T x;
+            if(pos + sizeof(x) > buf.size())
+                throw std::runtime_error("truncated record");
+            memcpy(&x, buf.data() + pos, sizeof(x));
+            pos += sizeof(x);
+            return x;
+        }
+
+        uint64_t get_varint()
+        {
+            uint64_t x = 0;
+            for(int shift = 0;; shift += 7)
+            {
+                uint8_t b = get<uint8_t>();
+                x |= uint64_t(b & 0x7f) << shift;
+                if(!(b & 0x80))
+                    return x;
+            }
+        }
+
+        std::string get_string(size_t len)
+        {
+            if(pos + len > buf.size())
+                throw std::runtime_error("truncated record");
+            std::string s(buf.data() + pos, len);
+            pos += len;
+            return s;
+        }
+    };
+
+    // Reads a varint from a stream, returning false at end of file
+    inline bool read_varint(std::istream& in, uint64_t& x)
+    {
+        x = 0;
+        for(int shift = 0;; shift += 7)
+        {
+            int c = in.get();
+            if(c == EOF)
+                return false;
+            x |= uint64_t(c & 0x7f) << shift;
+            if(!(c & 0x80))
+                return true;
+        }
+    }
+
+    class decoder
+    {
+        // State of each writer: its string table and clock
+        struct writer_t
+        {
+            std::vector<std::string> table;
+            int64_t                  ns = 0;
+        };
+        std::map<uint64_t, writer_t> writers;
+
+        bool want_trace;
+        bool want_bench;
+        bool timestamps;
+
+        // Output a value, or a bench option if name is not null
+        template <typename T>
+        static void emit(rocblas_internal_ostream& os, const std::string* name, const T& x)
+        {
+            if(name)
+                os << rocblas_log_bench_scalar<T>{name->c_str(), x};
+            else
+                os << x;
+        }
+
+        static void decode_arg(payload_reader&                 in,
+                               rocblas_internal_ostream&       os,
+                               const std::vector<std::string>& table,
+                               const std::string*              name = nullptr)
+        {
+            auto lookup = [&](uint64_t id) -> const std::string& {
+                if(id >= table.size())
+                    throw std::runtime_error("undefined string id " + std::to_string(id));
+                return table[id];
+            };
+
+            switch(tag_t(in.get<uint8_t>()))
+            {
+            case tag_t::sint:
+                emit(os, name, unzigzag(in.get_varint()));
+                break;
+            case tag_t::uint:
+                emit(os, name, in.get_varint());
+                break;
+            case tag_t::f32:
+                emit(os, name, in.get<float>());
+                break;
+            case tag_t::f64:
+                emit(os, name, in.get<double>());
+                break;
+            case tag_t::c32:
+                emit(os, name, in.get<rocblas_float_complex>());
+                break;
+            case tag_t::c64:
+                emit(os, name, in.get<rocblas_double_complex>());
+                break;
+            case tag_t::ptr:
+                os << reinterpret_cast<const void*>(uintptr_t(in.get_varint()));
+                break;
+            case tag_t::boolean:
+                os << bool(in.get<uint8_t>());
+                break;
+            case tag_t::chr:
+                os << in.get<char>();
+                break;
+            case tag_t::str_ref:
+                os << lookup(in.get_varint());
+                break;
+            case tag_t::text:
+                os << in.get_string(in.get_varint());
+                break;
+            case tag_t::operation:
+                os << rocblas_operation(in.get_varint());
+                break;
+            case tag_t::fill:
+                os << rocblas_fill(in.get_varint());
+                break;
+            case tag_t::diagonal:
+                os << rocblas_diagonal(in.get_varint());
+                break;
+            case tag_t::side:
+                os << rocblas_side(in.get_varint());
+                break;
+            case tag_t::datatype:
+                os << rocblas_datatype(in.get_varint());
+                break;
+            case tag_t::status:
+                os << rocblas_status(in.get_varint());
+                break;
+            case tag_t::atomics_mode:
+                os << rocblas_atomics_mode(in.get_varint());
+                break;
+            case tag_t::gemm_flags:
+                os << rocblas_gemm_flags(in.get_varint());
+                break;
+            case tag_t::bench_scalar:
+                decode_arg(in, os, table, &lookup(in.get_varint()));
+                break;
+            default:
+                throw std::runtime_error("unknown argument tag");
+            }
+        }
+
+    public:
+        decoder(bool want_trace, bool want_bench, bool timestamps)
+            : want_trace(want_trace)
+            , want_bench(want_bench)
+            , timestamps(timestamps)
+        {
+        }
+
+        // Decode one capture file, writing text lines to out
+        void decode(std::istream& in, std::ostream& out)
+        {
+            std::string buf;
+            for(int kind_stream; (kind_stream = in.get()) != EOF;)
+            {
+                uint64_t id, size;
+                if(!read_varint(in, id) || !read_varint(in, size))
+                    throw std::runtime_error("truncated record");
+                buf.resize(size);
+                if(!in.read(&buf[0], size))
+                    throw std::runtime_error("truncated record");
+
+                payload_reader payload(buf);
+                auto&          writer = writers[id];
+                auto           stream = stream_t(kind_stream >> 4);
+
+                switch(record_t(kind_stream & 0xf))
+                {
+                case record_t::header:
+                    if(payload.get_string(sizeof(magic)) != std::string(magic, sizeof(magic)))
+                        throw std::runtime_error("not a rocBLAS binary log");
+                    if(payload.get_varint() != version)
+                        throw std::runtime_error("unsupported rocBLAS binary log version");
+                    payload.get<uint64_t>(); // handle
+                    writer.table.clear();
+                    writer.ns = payload.get<int64_t>();
+                    break;
+
+                case record_t::string_def:
+                {
+                    uint64_t str_id = payload.get_varint();
+                    if(str_id >= writer.table.size())
+                        writer.table.resize(str_id + 1);
+                    writer.table[str_id] = payload.get_string(payload.get_varint());
+                    break;
+                }
+
+                case record_t::call:
+                {
+                    writer.ns += unzigzag(payload.get_varint());
+                    uint64_t nargs = payload.get_varint();
+
+                    bool is_trace = stream == stream_t::trace;
+                    if(is_trace ? !want_trace : !want_bench)
+                        break;
+
+                    const char*              sep = is_trace ? "," : " ";
+                    rocblas_internal_ostream os;
+                    if(timestamps)
+                    {
+                        char ts[32];
+                        snprintf(ts,
+                                 sizeof(ts),
+                                 "%lld.%09lld ",
+                                 (long long)(writer.ns / 1000000000),
+                                 (long long)(writer.ns % 1000000000));
+                        os << ts;
+                    }
+                    for(uint64_t i = 0; i < nargs; ++i)
+                    {
+                        if(i)
+                            os << sep;
+                        decode_arg(payload, os, writer.table);
+                    }
+                    out << os.str() << '\n';
+                    break;
+                }
+
+                default:
+                    throw std::runtime_error("unknown record kind");
+                }
+            }
+        }
+    };
+}
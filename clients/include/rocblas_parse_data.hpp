@@ -1,10 +1,24 @@
 /* ************************************************************************
- * Copyright 2019-2020 Advanced Micro Devices, Inc.
+ * Copyright 2019-2021 Advanced Micro Devices, Inc.
  * ************************************************************************ */
 
 #pragma once
 
 #include <string>
 
-// Parse --data and --yaml command-line arguments
+// Parse --data and --yaml command-line arguments.
+// The binary test data generated by rocblas_gentest.py from a YAML file is kept
+// in a cache, by default in $XDG_CACHE_HOME/rocblas/gentest or
+// ~/.cache/rocblas/gentest, or in $ROCBLAS_GENTEST_CACHE, which disables the
+// cache when empty. Cached data is used while the YAML files, the template and
+// rocblas_gentest.py are unchanged; the directory may be removed at any time.
 bool rocblas_parse_data(int& argc, char** argv, const std::string& default_file = "");
+
+#ifndef WIN32
+// Key of the cached binary test data generated from a YAML file with a template
+// by a rocblas_gentest.py script: a hash of their contents and of the files the
+// YAML files include, or "" if one cannot be read
+std::string rocblas_gentest_cache_key(const std::string& yaml,
+                                      const std::string& template_yaml,
+                                      const std::string& script);
+#endif
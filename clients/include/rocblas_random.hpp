@@ -7,6 +7,8 @@
 #include "rocblas.h"
 #include "rocblas_math.hpp"
 #include <cinttypes>
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <type_traits>
 
@@ -229,6 +231,250 @@ inline T random_hpl_generator()
     return std::uniform_real_distribution<double>(-0.5, 0.5)(t_rocblas_rng);
 }
 
+/* ============================================================================================ */
+/*! \brief  Counter-based random number generator. The bits of an element depend only on the
+    seed and on its batch, column and row, so that matrices can be initialized in any order, by
+    any number of threads, with the same values. Each column is a SplitMix64 sequence starting
+    at a key hashed from the seed, batch and column. */
+class rocblas_counter_rng
+{
+    static constexpr uint64_t GOLDEN = 0x9E3779B97F4A7C15;
+
+    uint64_t m_seed;
+
+public:
+    // SplitMix64 finalizer
+    static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        return z ^ (z >> 31);
+    }
+
+    explicit rocblas_counter_rng(uint64_t seed)
+        : m_seed(seed)
+    {
+    }
+
+    // A generator seeded from t_rocblas_rng, so that successive initializations differ, and
+    // repeat after rocblas_seedrand
+    static rocblas_counter_rng from_thread_rng()
+    {
+        uint64_t hi = t_rocblas_rng();
+        uint64_t lo = t_rocblas_rng();
+        return rocblas_counter_rng(hi << 32 | lo);
+    }
+
+    // Key of column j of batch b
+    uint64_t column(size_t b, size_t j) const
+    {
+        return mix(mix(m_seed + b * GOLDEN) + j * GOLDEN);
+    }
+
+    // Random bits of row i of the column with key column
+    static uint64_t bits(uint64_t column, size_t i)
+    {
+        return mix(column + (i + 1) * GOLDEN);
+    }
+
+    // Uniform integer in [lo, hi] from 32 random bits
+    static int uniform_int(uint32_t bits, int lo, int hi)
+    {
+        return lo + int((uint64_t(bits) * uint64_t(hi - lo + 1)) >> 32);
+    }
+
+    // Uniform double in [0, 1) from 64 random bits
+    static double uniform_real(uint64_t bits)
+    {
+        return double(bits >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+/*! \brief  counter-based random_generator: a number in the same range from 64 random bits */
+template <typename T>
+inline T random_counter_generator(uint64_t bits)
+{
+    return T(rocblas_counter_rng::uniform_int(uint32_t(bits), 1, 10));
+}
+
+template <>
+inline rocblas_float_complex random_counter_generator<rocblas_float_complex>(uint64_t bits)
+{
+    return {float(rocblas_counter_rng::uniform_int(uint32_t(bits), 1, 10)),
+            float(rocblas_counter_rng::uniform_int(uint32_t(bits >> 32), 1, 10))};
+}
+
+template <>
+inline rocblas_double_complex random_counter_generator<rocblas_double_complex>(uint64_t bits)
+{
+    return {double(rocblas_counter_rng::uniform_int(uint32_t(bits), 1, 10)),
+            double(rocblas_counter_rng::uniform_int(uint32_t(bits >> 32), 1, 10))};
+}
+
+template <>
+inline rocblas_half random_counter_generator<rocblas_half>(uint64_t bits)
+{
+    return rocblas_half(rocblas_counter_rng::uniform_int(uint32_t(bits), -2, 2));
+}
+
+template <>
+inline rocblas_bfloat16 random_counter_generator<rocblas_bfloat16>(uint64_t bits)
+{
+    return rocblas_bfloat16(rocblas_counter_rng::uniform_int(uint32_t(bits), -2, 2));
+}
+
+template <>
+inline int8_t random_counter_generator<int8_t>(uint64_t bits)
+{
+    return int8_t(rocblas_counter_rng::uniform_int(uint32_t(bits), 1, 3));
+}
+
+/*! \brief  counter-based random_hpl_generator: HPL-like [-0.5,0.5) doubles */
+template <typename T>
+inline T random_counter_hpl_generator(uint64_t bits)
+{
+    return rocblas_counter_rng::uniform_real(bits) - 0.5;
+}
+
+/*! \brief  Counter-based random number generator which generates NaN values from random bits */
+class rocblas_counter_nan_rng
+{
+    uint64_t m_bits;
+
+    // NaN with random bits
+    template <typename T, typename UINT_T, int SIG, int EXP>
+    T random_nan_data() const
+    {
+        static_assert(sizeof(UINT_T) == sizeof(T), "Type sizes do not match");
+        union
+        {
+            UINT_T u;
+            T      fp;
+        } x;
+        x.u = UINT_T(m_bits);
+        if(!(x.u & (((UINT_T)1 << SIG) - 1)))
+            x.u |= 1; // Not Inf (mantissa == 0)
+        x.u |= (((UINT_T)1 << EXP) - 1) << SIG; // Exponent = all 1's
+        return x.fp;
+    }
+
+public:
+    explicit rocblas_counter_nan_rng(uint64_t bits)
+        : m_bits(bits)
+    {
+    }
+
+    // Random integer
+    template <typename T, std::enable_if_t<std::is_integral<T>{}, int> = 0>
+    explicit operator T() const
+    {
+        return T(m_bits);
+    }
+
+    explicit operator double() const
+    {
+        return random_nan_data<double, uint64_t, 52, 11>();
+    }
+
+    explicit operator float() const
+    {
+        return random_nan_data<float, uint32_t, 23, 8>();
+    }
+
+    explicit operator rocblas_half() const
+    {
+        return random_nan_data<rocblas_half, uint16_t, 10, 5>();
+    }
+
+    explicit operator rocblas_bfloat16() const
+    {
+        return random_nan_data<rocblas_bfloat16, uint16_t, 7, 8>();
+    }
+
+    explicit operator rocblas_float_complex() const
+    {
+        return {float(*this), float(rocblas_counter_nan_rng(m_bits >> 32))};
+    }
+
+    explicit operator rocblas_double_complex() const
+    {
+        return {double(*this), double(rocblas_counter_nan_rng(rocblas_counter_rng::mix(m_bits)))};
+    }
+};
+
+/*! \brief  Counter-based random number generator which generates Inf values from random bits */
+class rocblas_counter_inf_rng
+{
+    uint64_t m_bits;
+
+public:
+    explicit rocblas_counter_inf_rng(uint64_t bits)
+        : m_bits(bits)
+    {
+    }
+
+    // Random minimum or maximum integer
+    template <typename T, std::enable_if_t<std::is_integral<T>{}, int> = 0>
+    explicit operator T() const
+    {
+        return m_bits & 1 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+    }
+
+    // Random signed Inf
+    template <typename T, std::enable_if_t<!std::is_integral<T>{}, int> = 0>
+    explicit operator T() const
+    {
+        return T(m_bits & 1 ? -std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::infinity());
+    }
+};
+
+/*! \brief  Counter-based random number generator which generates zero values from random bits */
+class rocblas_counter_zero_rng
+{
+    uint64_t m_bits;
+
+public:
+    explicit rocblas_counter_zero_rng(uint64_t bits)
+        : m_bits(bits)
+    {
+    }
+
+    template <typename T, std::enable_if_t<std::is_integral<T>{}, int> = 0>
+    explicit operator T() const
+    {
+        return 0;
+    }
+
+    // Random signed zero
+    template <typename T, std::enable_if_t<!std::is_integral<T>{}, int> = 0>
+    explicit operator T() const
+    {
+        return T(m_bits & 1 ? -0.0 : 0.0);
+    }
+};
+
+/*! \brief  counter-based random_nan_generator: a random NaN from 64 random bits */
+template <typename T>
+inline T random_counter_nan_generator(uint64_t bits)
+{
+    return T(rocblas_counter_nan_rng(bits));
+}
+
+/*! \brief  counter-based random_inf_generator: a random Inf from 64 random bits */
+template <typename T>
+inline T random_counter_inf_generator(uint64_t bits)
+{
+    return T(rocblas_counter_inf_rng(bits));
+}
+
+/*! \brief  counter-based random_zero_generator: a random zero from 64 random bits */
+template <typename T>
+inline T random_counter_zero_generator(uint64_t bits)
+{
+    return T(rocblas_counter_zero_rng(bits));
+}
+
 /*! \brief  generate a random ASCII string of up to length n */
 inline std::string random_string(size_t n)
 {
@@ -0,0 +1,224 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <algorithm>
+#include <cmath>
+#include <hip/hip_runtime.h>
+#include <memory>
+#include <vector>
+
+/*!\file
+ * \brief per-call timing of the hot loops of the testing_* drivers
+ *
+ * A driver times its hot calls with
+ *
+ *     gpu_time_used = get_time_us_sync(stream);
+ *     for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
+ *         ...
+ *     gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+ *
+ * By default this is a plain loop of number_hot_calls calls, and the driver's timer is
+ * the only measurement. If per-call samples are enabled with rocblas_timing_set_samples,
+ * as rocblas-bench --timing_samples does, rocblas_hot_iterations records a HIP event on
+ * the stream before the first call and after each call, without synchronizing, so that
+ * the calls still run back to back and the time of each call is the time between its
+ * events. Recording the events adds their host time to the driver's timer. The events are
+ * read when ArgumentModel::log_perf takes the samples of the last hot loop, after the
+ * driver has stopped its timer, and log_perf reports their minimum, median, 90th and 99th
+ * percentiles and standard deviation next to the mean.
+ *
+ * If a relative confidence interval is set with rocblas_timing_set_convergence, as
+ * rocblas-bench --converge does, samples are taken, and the loop runs more batches of
+ * number_hot_calls calls, synchronizing after each, until the 95% confidence interval of
+ * the mean time is within that fraction of the mean, or the maximum number of calls have
+ * run.
+ */
+
+/* ============================================================================================ */
+/*! \brief Distribution of the per-call times of a hot loop, in microseconds */
+struct rocblas_timing_stats
+{
+    size_t samples   = 0;
+    double mean_us   = 0;
+    double min_us    = 0;
+    double median_us = 0;
+    double p90_us    = 0;
+    double p99_us    = 0;
+    double stddev_us = 0; // sample standard deviation
+    double ci95_us   = 0; // half-width of the 95% confidence interval of the mean
+};
+
+/*! \brief Percentile p, from 0 to 100, of sorted samples, interpolated linearly between the
+    two closest ranks */
+inline double rocblas_timing_percentile(const std::vector<double>& sorted, double p)
+{
+    if(sorted.empty())
+        return 0;
+    double rank  = p / 100 * (sorted.size() - 1);
+    size_t lower = size_t(rank);
+    if(lower + 1 >= sorted.size())
+        return sorted.back();
+    return sorted[lower] + (rank - lower) * (sorted[lower + 1] - sorted[lower]);
+}
+
+/*! \brief Half-width of the 95% confidence interval of the mean of n samples with standard
+    deviation stddev, with Student's t distribution for fewer than 32 samples */
+inline double rocblas_timing_ci95(size_t n, double stddev)
+{
+    // Two-sided 97.5% quantiles of Student's t with 1 to 30 degrees of freedom
+    static constexpr double t[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                   2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                   2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                   2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+    if(n < 2)
+        return INFINITY;
+    double quantile = n - 1 <= std::size(t) ? t[n - 2] : 1.960;
+    return quantile * stddev / std::sqrt(double(n));
+}
+
+inline rocblas_timing_stats rocblas_timing_summarize(std::vector<double> samples)
+{
+    rocblas_timing_stats stats;
+    stats.samples = samples.size();
+    if(samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for(double s : samples)
+        sum += s;
+    stats.mean_us = sum / samples.size();
+
+    double squares = 0;
+    for(double s : samples)
+        squares += (s - stats.mean_us) * (s - stats.mean_us);
+    stats.stddev_us = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0;
+    stats.ci95_us   = rocblas_timing_ci95(samples.size(), stats.stddev_us);
+
+    stats.min_us    = samples.front();
+    stats.median_us = rocblas_timing_percentile(samples, 50);
+    stats.p90_us    = rocblas_timing_percentile(samples, 90);
+    stats.p99_us    = rocblas_timing_percentile(samples, 99);
+    return stats;
+}
+
+/*! \brief Whether the 95% confidence interval of the mean is within rel_ci of the mean */
+inline bool rocblas_timing_converged(const rocblas_timing_stats& stats, double rel_ci)
+{
+    return stats.samples > 1 && stats.ci95_us <= rel_ci * stats.mean_us;
+}
+
+/* ============================================================================================ */
+/*! \brief Per-call times of a hot loop, from events recorded on its stream between the calls
+    of each batch */
+class rocblas_hot_samples
+{
+public:
+    // Events for batches of up to batch calls. If they cannot be created, nothing is timed.
+    explicit rocblas_hot_samples(int batch);
+    ~rocblas_hot_samples();
+
+    rocblas_hot_samples(const rocblas_hot_samples&) = delete;
+    rocblas_hot_samples& operator=(const rocblas_hot_samples&) = delete;
+
+    // Starts a batch, before its first call
+    void start(hipStream_t stream);
+
+    // Ends a call of the batch
+    void record(hipStream_t stream);
+
+    // Waits for the calls of the batch, and appends their times to the samples
+    const std::vector<double>& collect();
+
+    bool timed() const
+    {
+        return !m_events.empty();
+    }
+
+private:
+    std::vector<hipEvent_t> m_events;
+    size_t                  m_recorded = 0;
+    std::vector<double>     m_samples;
+};
+
+// Sets whether hot loops take per-call samples
+void rocblas_timing_set_samples(bool samples);
+bool rocblas_timing_get_samples();
+
+// Sets the relative confidence interval, 0 to run a single batch, and the maximum number of
+// calls of a hot loop
+void rocblas_timing_set_convergence(double rel_ci, rocblas_int max_calls);
+
+double      rocblas_timing_get_convergence();
+rocblas_int rocblas_timing_get_max_calls();
+
+// The samples of the last hot loop, until log_perf takes them or they are cleared when the
+// next driver starts
+void rocblas_timing_set_last(std::unique_ptr<rocblas_hot_samples> samples);
+bool rocblas_timing_take_last(rocblas_timing_stats& stats);
+void rocblas_timing_clear_last();
+
+/*! \brief Loop over the hot calls of a testing_* driver, timing each of them if samples are
+    enabled */
+class rocblas_hot_iterations
+{
+public:
+    rocblas_hot_iterations(int hot_calls, hipStream_t stream)
+        : m_batch(std::max(hot_calls, 0))
+        , m_limit(m_batch)
+        , m_stream(stream)
+    {
+        if(m_batch && (rocblas_timing_get_samples() || rocblas_timing_get_convergence() > 0))
+            m_samples = std::make_unique<rocblas_hot_samples>(m_batch);
+    }
+
+    ~rocblas_hot_iterations()
+    {
+        rocblas_timing_set_last(std::move(m_samples));
+    }
+
+    rocblas_hot_iterations(const rocblas_hot_iterations&) = delete;
+    rocblas_hot_iterations& operator=(const rocblas_hot_iterations&) = delete;
+
+    // Called before each call, returns whether to make another. At the end of a batch,
+    // another batch is run unless the samples have converged.
+    bool next()
+    {
+        if(m_samples)
+        {
+            if(m_calls)
+                m_samples->record(m_stream);
+            else
+                m_samples->start(m_stream);
+            if(m_calls == m_limit && !converged())
+            {
+                m_limit += m_batch;
+                m_samples->start(m_stream);
+            }
+        }
+        if(m_calls == m_limit)
+            return false;
+        ++m_calls;
+        return true;
+    }
+
+private:
+    bool converged()
+    {
+        double rel_ci = rocblas_timing_get_convergence();
+        if(rel_ci <= 0 || !m_samples->timed()
+           || m_calls + m_batch > rocblas_timing_get_max_calls())
+            return true;
+        return rocblas_timing_converged(rocblas_timing_summarize(m_samples->collect()), rel_ci);
+    }
+
+    int                                  m_batch;
+    int                                  m_limit;
+    int                                  m_calls = 0;
+    hipStream_t                          m_stream;
+    std::unique_ptr<rocblas_hot_samples> m_samples;
+};
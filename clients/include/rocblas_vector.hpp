@@ -20,26 +20,26 @@
 //!
 //! @brief Template for initializing a host (non_batched|batched|strided_batched)vector.
 //! @param that That vector.
-//! @param rand_gen The random number generator
+//! @param rand_gen The counter-based random number generator, of the random bits of an element.
 //! @param seedReset Reset the seed if true, do not reset the seed otherwise.
 //!
 template <typename U, typename T>
-void rocblas_init_template(U& that, T rand_gen(), bool seedReset)
+void rocblas_init_template(U& that, T rand_gen(uint64_t), bool seedReset)
 {
     if(seedReset)
         rocblas_seedrand();
 
-    for(rocblas_int batch_index = 0; batch_index < that.batch_count(); ++batch_index)
-    {
-        auto*     batched_data = that[batch_index];
-        ptrdiff_t inc          = that.inc();
-        auto      n            = that.n();
+    // Element i of batch b is column i of batch b, like rocblas_init(that, 1, n, inc)
+    auto      rng     = rocblas_counter_rng::from_thread_rng();
+    ptrdiff_t inc     = that.inc();
+    ptrdiff_t n       = that.n();
+    size_t    columns = std::max<ptrdiff_t>(n, 0);
+    rocblas_init_blocks(1, columns, that.batch_count(), [&](size_t b, size_t i, size_t, size_t) {
+        auto* batched_data = that[b];
         if(inc < 0)
             batched_data -= (n - 1) * inc;
-
-        for(rocblas_int i = 0; i < n; ++i)
-            batched_data[i * inc] = rand_gen();
-    }
+        batched_data[ptrdiff_t(i) * inc] = rand_gen(rocblas_counter_rng::bits(rng.column(b, i), 0));
+    });
 }
 
 //!
@@ -50,7 +50,7 @@ void rocblas_init_template(U& that, T rand_gen(), bool seedReset)
 template <typename T>
 inline void rocblas_init(host_strided_batch_vector<T>& that, bool seedReset = false)
 {
-    rocblas_init_template(that, random_generator<T>, seedReset);
+    rocblas_init_template(that, random_counter_generator<T>, seedReset);
 }
 
 //!
@@ -61,7 +61,7 @@ inline void rocblas_init(host_strided_batch_vector<T>& that, bool seedReset = fa
 template <typename T>
 inline void rocblas_init(host_batch_vector<T>& that, bool seedReset = false)
 {
-    rocblas_init_template(that, random_generator<T>, seedReset);
+    rocblas_init_template(that, random_counter_generator<T>, seedReset);
 }
 
 //!
@@ -85,7 +85,7 @@ inline void rocblas_init(host_vector<T>& that, bool seedReset = false)
 template <typename T>
 inline void rocblas_init_nan(host_strided_batch_vector<T>& that, bool seedReset = false)
 {
-    rocblas_init_template(that, random_nan_generator<T>, seedReset);
+    rocblas_init_template(that, random_counter_nan_generator<T>, seedReset);
 }
 
 //!
@@ -96,7 +96,7 @@ inline void rocblas_init_nan(host_strided_batch_vector<T>& that, bool seedReset
 template <typename T>
 inline void rocblas_init_nan(host_batch_vector<T>& that, bool seedReset = false)
 {
-    rocblas_init_template(that, random_nan_generator<T>, seedReset);
+    rocblas_init_template(that, random_counter_nan_generator<T>, seedReset);
 }
 
 //!
@@ -107,5 +107,5 @@ inline void rocblas_init_nan(host_batch_vector<T>& that, bool seedReset = false)
 template <typename T>
 inline void rocblas_init_nan(host_vector<T>& that, bool seedReset = false)
 {
-    rocblas_init_template(that, random_nan_generator<T>, seedReset);
+    rocblas_init_template(that, random_counter_nan_generator<T>, seedReset);
 }
@@ -0,0 +1,124 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/******************************************************************************
+ * Index of the exact-size tuning of Tensile library logic files, for finding  *
+ * which GEMM problems in rocblas-bench logs were tuned for.                   *
+ *                                                                             *
+ * A logic file is a YAML list whose 8th item is the exact logic list, where   *
+ * each entry is [[M, N, batch, K, ...], [solution index, GFLOPS]]. Entries   *
+ * with 8 sizes were tuned for specific leading dimensions, which are not      *
+ * part of the index; they are matched by M, N, batch and K.                   *
+ *                                                                             *
+ * The index file holds a table of entries for each logic file, sorted by      *
+ * size, and is memory-mapped by the tools which query it, so that it is read  *
+ * once however many problems are looked up.                                   *
+ *                                                                             *
+ * Nothing here depends on HIP or on rocBLAS being installed.                  *
+ ******************************************************************************/
+
+/*! \brief One tuned size of a logic file */
+struct tensile_logic_entry
+{
+    uint32_t m, n, batch, k;
+    int32_t  solution;
+    float    gflops;
+};
+
+/*! \brief The exact logic of one logic file */
+struct tensile_logic_table
+{
+    std::string                      arch; // e.g. aldebaran
+    std::string                      gfx; // e.g. gfx90a, or fallback for hip
+    std::string                      problem; // e.g. Cijk_Ailk_Bjlk_HBH
+    std::vector<tensile_logic_entry> entries;
+};
+
+/*! \brief Parse a logic file. The problem type is taken from filename, which
+    is named as in library/src/blas3/Tensile/Logic. Throws std::runtime_error. */
+tensile_logic_table tensile_logic_parse(std::istream& is, const std::string& filename);
+
+/*! \brief Write an index of tables. Entries are sorted by size, and of
+    duplicate sizes in a table only the one with the most GFLOPS is kept. */
+void tensile_logic_index_write(std::vector<tensile_logic_table> tables, std::ostream& os);
+
+/*! \brief A GEMM problem, as Tensile sees it */
+struct tensile_logic_query
+{
+    std::string problem; // Tensile problem type, e.g. Cijk_Ailk_Bjlk_HBH_GB
+    uint32_t    m, n, batch, k;
+};
+
+/*! \brief Parse a rocblas-bench command line, such as those logged with
+    ROCBLAS_LAYER=2. Returns false if it is not a GEMM which Tensile can run. */
+bool tensile_logic_parse_bench(const std::string& line, tensile_logic_query& query);
+
+/*! \brief Index file, mapped into memory */
+class tensile_logic_index
+{
+public:
+    struct table
+    {
+        const char*                arch;
+        const char*                gfx;
+        const char*                problem;
+        const tensile_logic_entry* entries;
+        size_t                     count;
+    };
+
+    enum class match_kind
+    {
+        none, // No table for the problem, or an empty table
+        exact, // The size was tuned for
+        fallback, // Another size was tuned for; the nearest one is reported
+    };
+
+    struct match
+    {
+        match_kind                 kind;
+        const tensile_logic_entry* entry; // Exact or nearest entry, or nullptr
+    };
+
+    /*! \brief Map an index file. Throws std::runtime_error. */
+    explicit tensile_logic_index(const std::string& path);
+
+    /*! \brief Use an index in memory, which must outlive this object */
+    tensile_logic_index(const void* data, size_t size);
+
+    ~tensile_logic_index();
+
+    tensile_logic_index(const tensile_logic_index&) = delete;
+    tensile_logic_index& operator=(const tensile_logic_index&) = delete;
+
+    const std::vector<table>& tables() const
+    {
+        return m_tables;
+    }
+
+    /*! \brief Table of a problem type for an architecture, which is either the
+        arch or the gfx name of the logic file, or nullptr */
+    const table* find(const std::string& arch, const std::string& problem) const;
+
+    /*! \brief Look up a size in a table. A size which was not tuned for
+        falls back to the nearest tuned size, by Euclidean distance in
+        M, N, batch and K. */
+    static match lookup(const table& t, uint32_t m, uint32_t n, uint32_t batch, uint32_t k);
+
+private:
+    void parse(const char* data, size_t size);
+
+    void*              m_map      = nullptr;
+    size_t             m_map_size = 0;
+    std::vector<char>  m_buffer;
+    std::vector<table> m_tables;
+};
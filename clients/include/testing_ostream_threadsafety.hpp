@@ -43,6 +43,18 @@ namespace std
 }
 #endif
 
+// Restores the asynchronous logging settings when it goes out of scope
+struct rocblas_async_config_guard
+{
+    const rocblas_internal_ostream::async_config_t saved
+        = rocblas_internal_ostream::get_async_config();
+
+    ~rocblas_async_config_guard()
+    {
+        rocblas_internal_ostream::set_async_config(saved);
+    }
+};
+
 inline void testing_ostream_threadsafety(const Arguments& arg)
 {
     constexpr size_t NTIMES  = 10; // Number of times the tests are repeated across files
@@ -77,8 +89,19 @@ inline void testing_ostream_threadsafety(const Arguments& arg)
 
     rocblas_seedrand();
 
+    // Restore the asynchronous logging settings on exit
+    rocblas_async_config_guard guard;
+
     for(size_t n = 0; n < NTIMES; ++n)
     {
+        // Alternate between synchronous and asynchronous logging, using a small
+        // queue in asynchronous mode so that producers have to wait for room
+        auto config     = guard.saved;
+        config.enabled  = n % 2 != 0;
+        config.capacity = 64;
+        config.drop     = false;
+        rocblas_internal_ostream::set_async_config(config);
+
         // Open a file in /tmp
         //char path[] = "/tmp/rocblas-XXXXXX";
         std::filesystem::path path;
@@ -105,9 +128,14 @@ inline void testing_ostream_threadsafety(const Arguments& arg)
         for(auto& t : threads)
             t.join();
 
+        // Wait for any queued asynchronous output to be written
+        rocblas_internal_ostream::flush_workers();
+
         // Close the original file descriptor
         if(CLOSE(fd))
+        {
             FAIL() << "Could not close filehandle for " << path;
+        }
 
         // Reopen the file to check its integrity
         std::ifstream is(path);
@@ -119,7 +147,8 @@ inline void testing_ostream_threadsafety(const Arguments& arg)
 
         // For each line in the file, make sure its signature matches.
         // This detects interleaved IO which causes garbled output.
-        for(std::string line; std::getline(is, line);)
+        size_t nlines = 0;
+        for(std::string line; std::getline(is, line); ++nlines)
         {
             if(!check_sig(line))
             {
@@ -130,6 +159,14 @@ inline void testing_ostream_threadsafety(const Arguments& arg)
 
         is.close();
 
+        // Make sure no output was lost
+        if(nlines != NLINES * NTHREAD)
+        {
+            FAIL() << "expected " << NLINES * NTHREAD << " lines in " << path << " but found "
+                   << nlines;
+            return;
+        }
+
 #ifdef WIN32
         // need all file descriptors closed to allow file removal on windows before process exits
         rocblas_internal_ostream::clear_workers();
@@ -138,3 +175,40 @@ inline void testing_ostream_threadsafety(const Arguments& arg)
         std::filesystem::remove(path);
     }
 }
+
+// A worker which cannot write its file drops later messages instead of blocking its producers,
+// flushes and its destruction
+inline void testing_ostream_write_failure()
+{
+#ifndef WIN32
+    rocblas_async_config_guard guard;
+
+    // Writes to /dev/full fail when they are flushed, with ENOSPC
+    int fd = open("/dev/full", O_WRONLY | O_CLOEXEC);
+    if(fd == -1)
+        return;
+
+    // Synchronous and asynchronous logging, with a queue small enough for producers to wait
+    // for room in the queue under the block policy
+    for(bool async : {false, true})
+    {
+        auto config     = guard.saved;
+        config.enabled  = async;
+        config.capacity = 4;
+        config.drop     = false;
+        rocblas_internal_ostream::set_async_config(config);
+
+        {
+            rocblas_internal_ostream os(fd);
+            for(int i = 0; i < 1000; ++i)
+                os << "line " << i << std::endl;
+            os.flush();
+        }
+        rocblas_internal_ostream::flush_workers();
+        rocblas_internal_ostream::clear_workers();
+    }
+
+    close(fd);
+#endif
+}
+
@@ -0,0 +1,106 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#define FDOPEN(A, B) _fdopen(A, B)
+#define OPEN(A) _open(A, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_APPEND, _S_IREAD | _S_IWRITE);
+#define CLOSE(A) _close(A)
+#else
+#define FDOPEN(A, B) fdopen(A, B)
+#define OPEN(A) open(A, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+#define CLOSE(A) close(A)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+//
+// https://en.cppreference.com/w/User:D41D8CD98F/feature_testing_macros
+//
+#ifdef __cpp_lib_filesystem
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+
+namespace std
+{
+    namespace filesystem = experimental::filesystem;
+}
+#endif
+
+// Measures the throughput of many threads logging to one file, with synchronous
+// logging and with asynchronous logging using both full-queue policies.
+// arg.N is the number of lines written by each thread, and arg.batch_count is
+// the number of threads.
+inline void testing_ostream_throughput(const Arguments& arg)
+{
+    const size_t nlines   = arg.N > 0 ? arg.N : 1;
+    const size_t nthreads = arg.batch_count > 0 ? arg.batch_count : 1;
+
+    // A typical trace logging line
+    static constexpr char line[]
+        = "rocblas_sgemm,N,N,1024,1024,1024,1,0x7f0000000000,1024,0x7f0000100000,1024,0,"
+          "0x7f0000200000,1024,atomics_allowed";
+
+    auto saved_config = rocblas_internal_ostream::get_async_config();
+
+    rocblas_cout << "threads,lines_per_thread,mode,us,lines/s" << std::endl;
+
+    for(int mode = 0; mode < 3; ++mode)
+    {
+        auto config    = saved_config;
+        config.enabled = mode != 0;
+        config.drop    = mode == 2;
+        rocblas_internal_ostream::set_async_config(config);
+
+        auto path = std::filesystem::temp_directory_path()
+                    / ("rocblas-ostream-throughput-" + std::to_string(mode));
+        int fd = OPEN(path.generic_string().c_str());
+        if(fd == -1)
+        {
+            rocblas_internal_ostream::set_async_config(saved_config);
+            throw std::runtime_error("Cannot open temporary file " + path.generic_string());
+        }
+
+        double time = get_time_us_no_sync();
+
+        std::vector<std::thread> threads;
+        for(size_t t = 0; t < nthreads; ++t)
+            threads.emplace_back([=] {
+                rocblas_internal_ostream os(fd);
+                for(size_t i = 0; i < nlines; ++i)
+                    os << line << std::endl;
+            });
+
+        for(auto& t : threads)
+            t.join();
+
+        // Include the time to write everything which is still queued
+        rocblas_internal_ostream::flush_workers();
+        time = get_time_us_no_sync() - time;
+
+        CLOSE(fd);
+        rocblas_internal_ostream::clear_workers();
+        std::filesystem::remove(path);
+
+        static constexpr const char* mode_names[] = {"sync", "async_block", "async_drop"};
+        rocblas_cout << nthreads << "," << nlines << "," << mode_names[mode] << "," << time << ","
+                     << nthreads * nlines / time * 1e6 << std::endl;
+    }
+
+    rocblas_internal_ostream::set_async_config(saved_config);
+}
@@ -20,11 +20,12 @@
 template <typename T>
 void testing_set_get_matrix(const Arguments& arg)
 {
-    rocblas_int rows = arg.M;
-    rocblas_int cols = arg.N;
-    rocblas_int lda  = arg.lda;
-    rocblas_int ldb  = arg.ldb;
-    rocblas_int ldc  = arg.ldc;
+    rocblas_int          rows = arg.M;
+    rocblas_int          cols = arg.N;
+    rocblas_int          lda  = arg.lda;
+    rocblas_int          ldb  = arg.ldb;
+    rocblas_int          ldc  = arg.ldc;
+    rocblas_local_handle handle{arg};
 
     // argument sanity check, quick return if input parameters are invalid before allocating invalid
     // memory
@@ -104,9 +105,13 @@ void testing_set_get_matrix(const Arguments& arg)
             rocblas_get_matrix(rows, cols, sizeof(T), dc, ldc, hb, ldb);
         }
 
+        // The copies are synchronous, so events recorded on the handle's stream between
+        // them time each iteration
+        hipStream_t stream;
+        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync_device(); // in microseconds
 
-        for(int iter = 0; iter < number_hot_calls; iter++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             rocblas_set_matrix(rows, cols, sizeof(T), ha, lda, dc, ldc);
             rocblas_get_matrix(rows, cols, sizeof(T), dc, ldc, hb, ldb);
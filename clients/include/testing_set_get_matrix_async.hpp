@@ -117,7 +117,7 @@ void testing_set_get_matrix_async(const Arguments& arg)
 
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_hot_calls; iter++)
+        for(rocblas_hot_iterations hot(number_hot_calls, stream); hot.next();)
         {
             rocblas_set_matrix_async(rows, cols, sizeof(T), ha, lda, dc, ldc, stream);
             rocblas_get_matrix_async(rows, cols, sizeof(T), dc, ldc, hb, ldb, stream);
@@ -103,7 +103,7 @@ void testing_set_get_vector(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_timing_iterations; iter++)
+        for(rocblas_hot_iterations hot(number_timing_iterations, stream); hot.next();)
         {
             rocblas_set_vector(M, sizeof(T), hx, incx, db, incb);
             rocblas_get_vector(M, sizeof(T), db, incb, hy, incy);
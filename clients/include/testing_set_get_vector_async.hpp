@@ -108,7 +108,7 @@ void testing_set_get_vector_async(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
         gpu_time_used = get_time_us_sync(stream); // in microseconds
 
-        for(int iter = 0; iter < number_timing_iterations; iter++)
+        for(rocblas_hot_iterations hot(number_timing_iterations, stream); hot.next();)
         {
             rocblas_set_vector_async(M, sizeof(T), hp_x, incx, db, incb, stream);
             rocblas_get_vector_async(M, sizeof(T), db, incb, hp_y, incy, stream);
@@ -28,6 +28,10 @@ constexpr auto rocblas_type2datatype()
         return rocblas_datatype_i8_r;
     if(std::is_same<T, unsigned char>{})
         return rocblas_datatype_u8_r;
+    if(std::is_same<T, int8_t>{})
+        return rocblas_datatype_i8_r;
+    if(std::is_same<T, int32_t>{})
+        return rocblas_datatype_i32_r;
 
     return rocblas_datatype_f32_r; // testing purposes we default to f32 ex
 }
@@ -268,6 +268,18 @@ inline void unit_check_general(rocblas_int        M,
     UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_EQ);
 }
 
+template <>
+inline void unit_check_general(rocblas_int    M,
+                               rocblas_int    N,
+                               rocblas_int    lda,
+                               rocblas_stride strideA,
+                               const int8_t*  hCPU,
+                               const int8_t*  hGPU,
+                               rocblas_int    batch_count)
+{
+    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_EQ);
+}
+
 template <typename T, typename T_hpa = T>
 void unit_check_general(rocblas_int                                M,
                         rocblas_int                                N,
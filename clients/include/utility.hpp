@@ -7,6 +7,7 @@
 #include "../../library/src/include/logging.hpp"
 #include "../../library/src/include/utility.hpp"
 #include "rocblas.h"
+#include "rocblas_timing.hpp"
 #include "rocblas_vector.hpp"
 #include <cstdio>
 #include <iomanip>
@@ -103,7 +104,7 @@ public:
 
 /* ============================================================================================ */
 /*  device query and print out their ID and name */
-rocblas_int query_device_property();
+rocblas_int query_device_property(rocblas_internal_ostream& os = rocblas_cout);
 
 /*  set current device to device_id */
 void set_device(rocblas_int device_id);
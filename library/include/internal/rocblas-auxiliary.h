@@ -51,6 +51,94 @@ ROCBLAS_EXPORT rocblas_status rocblas_set_atomics_mode(rocblas_handle       hand
 ROCBLAS_EXPORT rocblas_status rocblas_get_atomics_mode(rocblas_handle        handle,
                                                        rocblas_atomics_mode* atomics_mode);
 
+/*! \brief set rocblas_host_result_mode
+     \details
+    In rocblas_host_result_deferred mode, functions returning results in host memory in
+    host pointer mode return without waiting for the results, which are written when the
+    handle's stream reaches them. The default is rocblas_host_result_blocking.
+ */
+ROCBLAS_EXPORT rocblas_status rocblas_set_host_result_mode(rocblas_handle           handle,
+                                                           rocblas_host_result_mode mode);
+
+/*! \brief get rocblas_host_result_mode
+ */
+ROCBLAS_EXPORT rocblas_status rocblas_get_host_result_mode(rocblas_handle            handle,
+                                                           rocblas_host_result_mode* mode);
+
+/*! \brief set rocblas_capture_mode
+     \details
+    In rocblas_capture_safe mode, functions called with the handle neither synchronize with the
+    host nor allocate memory, so that they may be captured in a HIP graph. A function which
+    would need to returns rocblas_status_capture_unsafe. The default is
+    rocblas_capture_default.
+ */
+ROCBLAS_EXPORT rocblas_status rocblas_set_capture_mode(rocblas_handle       handle,
+                                                       rocblas_capture_mode mode);
+
+/*! \brief get rocblas_capture_mode
+ */
+ROCBLAS_EXPORT rocblas_status rocblas_get_capture_mode(rocblas_handle        handle,
+                                                       rocblas_capture_mode* mode);
+
+/*! \brief returns the numbers of host synchronizations and allocations
+     \details
+    Counts the blocking copies, stream and event synchronizations, and allocations and frees of
+    device or pinned host memory made by functions called with the handle, and those refused in
+    rocblas_capture_safe mode, since the handle was created or the counts were last reset.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+    @param[out]
+    counts      [rocblas_sync_point_counts*]
+                pointer to where the counts will be stored
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_sync_point_counts(rocblas_handle             handle,
+                                                            rocblas_sync_point_counts* counts);
+
+/*! \brief resets the numbers of host synchronizations and allocations
+     \details
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_reset_sync_point_counts(rocblas_handle handle);
+
+/*! \brief returns the calls of each function counted with rocblas_layer_mode_perf_counters
+     \details
+    Returns the number of calls of each function made with the handle, or with any handle if
+    handle is NULL, since it was created or its counters were last reset, with the bytes and
+    floating point operations of their work and a histogram of their host-side latencies.
+    Calls are counted with handles created while ROCBLAS_LAYER includes
+    rocblas_layer_mode_perf_counters (8). Every BLAS and extension function is counted, but
+    bytes and floating point operations are only counted for the gemm, gemm_ex, gemv, axpy,
+    dot and scal functions and their batched and strided batched variants, and are zero for
+    other functions. Functions are returned in the order of their names.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device, or NULL for the counters of all handles
+    @param[out]
+    counters    [rocblas_function_counters*]
+                array of at least *count elements, where the counters will be stored, or NULL
+                to query their number only
+    @param[inout]
+    count       [size_t*]
+                on entry, the number of elements of counters; on exit, the number of functions
+                which have been called. If it is larger than on entry, only the first ones are
+                stored.
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_perf_counters(rocblas_handle             handle,
+                                                        rocblas_function_counters* counters,
+                                                        size_t*                    count);
+
+/*! \brief resets the counters of rocblas_get_perf_counters
+     \details
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device, or NULL for the counters of all handles. The counters of
+                each handle are separate from those of all handles.
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_reset_perf_counters(rocblas_handle handle);
+
 /*! \brief query the preferable supported int8 input layout for gemm
      \details
     Indicates the supported int8 input layout for gemm according to the device.
@@ -71,6 +159,10 @@ ROCBLAS_EXPORT rocblas_status rocblas_query_int8_layout_flag(rocblas_handle
 ROCBLAS_EXPORT rocblas_pointer_mode rocblas_pointer_to_mode(void* ptr);
 
 /*! \brief copy vector from host to device
+    \details
+    A strided host vector is gathered into a contiguous buffer before the transfer. Large
+    gathers are split across a pool of host threads whose size is set with the environment
+    variable ROCBLAS_HOST_PACK_THREADS (default: the number of hardware threads, up to 8).
  */
 ROCBLAS_EXPORT rocblas_status rocblas_set_vector(rocblas_int n,
                                                  rocblas_int elem_size,
@@ -80,6 +172,9 @@ ROCBLAS_EXPORT rocblas_status rocblas_set_vector(rocblas_int n,
                                                  rocblas_int incy);
 
 /*! \brief copy vector from device to host
+    \details
+    A strided host vector is scattered from a contiguous buffer after the transfer, using the
+    host threads described in rocblas_set_vector.
  */
 ROCBLAS_EXPORT rocblas_status rocblas_get_vector(rocblas_int n,
                                                  rocblas_int elem_size,
@@ -89,6 +184,11 @@ ROCBLAS_EXPORT rocblas_status rocblas_get_vector(rocblas_int n,
                                                  rocblas_int incy);
 
 /*! \brief copy matrix from host to device
+    \details
+    If either matrix is not contiguous, columns are copied in chunks through pinned staging
+    buffers, overlapping the packing of each chunk on the host with the transfer of the previous
+    chunk. The environment variables ROCBLAS_MATRIX_STAGING_BYTES (default 1048576) and
+    ROCBLAS_MATRIX_STAGING_BUFFERS (default 2) set the size and number of staging buffers.
  */
 ROCBLAS_EXPORT rocblas_status rocblas_set_matrix(rocblas_int rows,
                                                  rocblas_int cols,
@@ -99,6 +199,10 @@ ROCBLAS_EXPORT rocblas_status rocblas_set_matrix(rocblas_int rows,
                                                  rocblas_int ldb);
 
 /*! \brief copy matrix from device to host
+    \details
+    If either matrix is not contiguous, columns are copied in chunks through pinned staging
+    buffers, overlapping the unpacking of each chunk on the host with the transfer of the next
+    chunk, as in rocblas_set_matrix.
  */
 ROCBLAS_EXPORT rocblas_status rocblas_get_matrix(rocblas_int rows,
                                                  rocblas_int cols,
@@ -281,6 +385,76 @@ ROCBLAS_EXPORT rocblas_status rocblas_set_performance_metric(rocblas_handle
 ROCBLAS_EXPORT rocblas_status rocblas_get_performance_metric(rocblas_handle              handle,
                                                              rocblas_performance_metric* metric);
 
+/*! \brief returns statistics of the gemm solution cache
+     \details
+    Solutions selected by Tensile for gemm problems are cached per device, so that repeated
+    problems skip solution selection. The maximum number of cached solutions per device is set
+    with the environment variable ROCBLAS_TENSILE_SOLUTION_CACHE_SIZE (default 1024, 0 disables
+    the cache). Returns the statistics of the cache of the handle's device.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+    @param[out]
+    stats       [rocblas_solution_cache_stats*]
+                pointer to where the statistics will be stored
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_solution_cache_stats(rocblas_handle                handle,
+                                                               rocblas_solution_cache_stats* stats);
+
+/*! \brief clears the gemm solution cache
+     \details
+    Removes all cached solutions of the handle's device and resets its statistics.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_clear_solution_cache(rocblas_handle handle);
+
+/*! \brief sets the sampling interval of deferred numerical checking
+     \details
+    When the environment variable ROCBLAS_CHECK_NUMERICS includes
+    rocblas_check_numerics_mode_deferred, only one rocBLAS call in every interval calls made
+    with the handle is checked. The default interval is 1, or the value of the environment
+    variable ROCBLAS_CHECK_NUMERICS_SAMPLE.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+    @param[in]
+    interval    [rocblas_int]
+                check one call in every interval calls; must be at least 1
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_check_numerics_sampling(rocblas_handle handle,
+                                                                  rocblas_int    interval);
+
+/*! \brief returns the results of deferred numerical checking
+     \details
+    In rocblas_check_numerics_mode_deferred, the check kernels accumulate their results on the
+    device, and rocBLAS calls neither synchronize nor fail because of them. This function waits
+    for the handle's stream, then returns the results accumulated since the handle was created
+    or last reset. The results are also printed if the mode includes
+    rocblas_check_numerics_mode_info, or rocblas_check_numerics_mode_warn and a NaN or an Inf
+    was found.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+    @param[out]
+    report      [rocblas_check_numerics_report*]
+                pointer to where the results will be stored
+    @return rocblas_status_check_numerics_fail if the mode includes
+    rocblas_check_numerics_mode_fail and a NaN or an Inf was found
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_check_numerics_report(
+    rocblas_handle handle, rocblas_check_numerics_report* report);
+
+/*! \brief resets the results of deferred numerical checking
+     \details
+    Clears the results accumulated by the handle, in stream order, and restarts sampling.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_reset_check_numerics_report(rocblas_handle handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2640,6 +2640,955 @@ ROCBLAS_EXPORT rocblas_status rocblas_drotmg_strided_batched(rocblas_handle hand
                                                              rocblas_stride stride_param,
                                                              rocblas_int    batch_count);
 
+/*
+ * ===========================================================================
+ *    fused level 1 BLAS
+ * ===========================================================================
+ */
+
+ROCBLAS_EXPORT rocblas_status rocblas_saxpby(rocblas_handle handle,
+                                             rocblas_int    n,
+                                             const float*   alpha,
+                                             const float*   x,
+                                             rocblas_int    incx,
+                                             const float*   beta,
+                                             float*         y,
+                                             rocblas_int    incy);
+
+ROCBLAS_EXPORT rocblas_status rocblas_daxpby(rocblas_handle handle,
+                                             rocblas_int    n,
+                                             const double*  alpha,
+                                             const double*  x,
+                                             rocblas_int    incx,
+                                             const double*  beta,
+                                             double*        y,
+                                             rocblas_int    incy);
+
+ROCBLAS_EXPORT rocblas_status rocblas_caxpby(rocblas_handle               handle,
+                                             rocblas_int                  n,
+                                             const rocblas_float_complex* alpha,
+                                             const rocblas_float_complex* x,
+                                             rocblas_int                  incx,
+                                             const rocblas_float_complex* beta,
+                                             rocblas_float_complex*       y,
+                                             rocblas_int                  incy);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    axpby computes y := alpha * x + beta * y,
+    in a single pass. When alpha is zero x is not read, and when beta is zero y is not read.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    alpha     device pointer or host pointer to the scalar alpha.
+    @param[in]
+    x         device pointer storing vector x.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of x.
+    @param[in]
+    beta      device pointer or host pointer to the scalar beta.
+    @param[inout]
+    y         device pointer storing vector y.
+    @param[in]
+    incy      rocblas_int
+              specifies the increment for the elements of y.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zaxpby(rocblas_handle                handle,
+                                             rocblas_int                   n,
+                                             const rocblas_double_complex* alpha,
+                                             const rocblas_double_complex* x,
+                                             rocblas_int                   incx,
+                                             const rocblas_double_complex* beta,
+                                             rocblas_double_complex*       y,
+                                             rocblas_int                   incy);
+
+ROCBLAS_EXPORT rocblas_status rocblas_saxpby_batched(rocblas_handle     handle,
+                                                     rocblas_int        n,
+                                                     const float*       alpha,
+                                                     const float* const x[],
+                                                     rocblas_int        incx,
+                                                     const float*       beta,
+                                                     float* const       y[],
+                                                     rocblas_int        incy,
+                                                     rocblas_int        batch_count);
+
+ROCBLAS_EXPORT rocblas_status rocblas_daxpby_batched(rocblas_handle      handle,
+                                                     rocblas_int         n,
+                                                     const double*       alpha,
+                                                     const double* const x[],
+                                                     rocblas_int         incx,
+                                                     const double*       beta,
+                                                     double* const       y[],
+                                                     rocblas_int         incy,
+                                                     rocblas_int         batch_count);
+
+ROCBLAS_EXPORT rocblas_status rocblas_caxpby_batched(
+    rocblas_handle                     handle,
+    rocblas_int                        n,
+    const rocblas_float_complex*       alpha,
+    const rocblas_float_complex* const x[],
+    rocblas_int                        incx,
+    const rocblas_float_complex*       beta,
+    rocblas_float_complex* const       y[],
+    rocblas_int                        incy,
+    rocblas_int                        batch_count);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    axpby_batched computes y_i := alpha * x_i + beta * y_i,
+    in a single pass. When alpha is zero x is not read, and when beta is zero y is not read.
+    This is done for each instance i in the batch.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    alpha     device pointer or host pointer to the scalar alpha.
+    @param[in]
+    x         device array of device pointers storing each vector x_i.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of each x.
+    @param[in]
+    beta      device pointer or host pointer to the scalar beta.
+    @param[inout]
+    y         device array of device pointers storing each vector y_i.
+    @param[in]
+    incy      rocblas_int
+              specifies the increment for the elements of each y.
+    @param[in]
+    batch_count rocblas_int
+              number of instances in the batch.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zaxpby_batched(
+    rocblas_handle                      handle,
+    rocblas_int                         n,
+    const rocblas_double_complex*       alpha,
+    const rocblas_double_complex* const x[],
+    rocblas_int                         incx,
+    const rocblas_double_complex*       beta,
+    rocblas_double_complex* const       y[],
+    rocblas_int                         incy,
+    rocblas_int                         batch_count);
+
+ROCBLAS_EXPORT rocblas_status rocblas_saxpby_strided_batched(rocblas_handle handle,
+                                                             rocblas_int    n,
+                                                             const float*   alpha,
+                                                             const float*   x,
+                                                             rocblas_int    incx,
+                                                             rocblas_stride stridex,
+                                                             const float*   beta,
+                                                             float*         y,
+                                                             rocblas_int    incy,
+                                                             rocblas_stride stridey,
+                                                             rocblas_int    batch_count);
+
+ROCBLAS_EXPORT rocblas_status rocblas_daxpby_strided_batched(rocblas_handle handle,
+                                                             rocblas_int    n,
+                                                             const double*  alpha,
+                                                             const double*  x,
+                                                             rocblas_int    incx,
+                                                             rocblas_stride stridex,
+                                                             const double*  beta,
+                                                             double*        y,
+                                                             rocblas_int    incy,
+                                                             rocblas_stride stridey,
+                                                             rocblas_int    batch_count);
+
+ROCBLAS_EXPORT rocblas_status rocblas_caxpby_strided_batched(
+    rocblas_handle               handle,
+    rocblas_int                  n,
+    const rocblas_float_complex* alpha,
+    const rocblas_float_complex* x,
+    rocblas_int                  incx,
+    rocblas_stride               stridex,
+    const rocblas_float_complex* beta,
+    rocblas_float_complex*       y,
+    rocblas_int                  incy,
+    rocblas_stride               stridey,
+    rocblas_int                  batch_count);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    axpby_strided_batched computes y_i := alpha * x_i + beta * y_i,
+    in a single pass. When alpha is zero x is not read, and when beta is zero y is not read.
+    This is done for each instance i in the batch.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    alpha     device pointer or host pointer to the scalar alpha.
+    @param[in]
+    x         device pointer to the first vector x_1.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of each x.
+    @param[in]
+    stridex   rocblas_stride
+              stride from the start of one vector (x_i) to the next (x_i+1).
+    @param[in]
+    beta      device pointer or host pointer to the scalar beta.
+    @param[inout]
+    y         device pointer to the first vector y_1.
+    @param[in]
+    incy      rocblas_int
+              specifies the increment for the elements of each y.
+    @param[in]
+    stridey   rocblas_stride
+              stride from the start of one vector (y_i) to the next (y_i+1).
+    @param[in]
+    batch_count rocblas_int
+              number of instances in the batch.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zaxpby_strided_batched(
+    rocblas_handle                handle,
+    rocblas_int                   n,
+    const rocblas_double_complex* alpha,
+    const rocblas_double_complex* x,
+    rocblas_int                   incx,
+    rocblas_stride                stridex,
+    const rocblas_double_complex* beta,
+    rocblas_double_complex*       y,
+    rocblas_int                   incy,
+    rocblas_stride                stridey,
+    rocblas_int                   batch_count);
+
+ROCBLAS_EXPORT rocblas_status rocblas_saxpy_dot(rocblas_handle handle,
+                                                rocblas_int    n,
+                                                const float*   alpha,
+                                                const float*   x,
+                                                rocblas_int    incx,
+                                                float*         y,
+                                                rocblas_int    incy,
+                                                const float*   z,
+                                                rocblas_int    incz,
+                                                float*         result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_daxpy_dot(rocblas_handle handle,
+                                                rocblas_int    n,
+                                                const double*  alpha,
+                                                const double*  x,
+                                                rocblas_int    incx,
+                                                double*        y,
+                                                rocblas_int    incy,
+                                                const double*  z,
+                                                rocblas_int    incz,
+                                                double*        result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_caxpy_dot(rocblas_handle               handle,
+                                                rocblas_int                  n,
+                                                const rocblas_float_complex* alpha,
+                                                const rocblas_float_complex* x,
+                                                rocblas_int                  incx,
+                                                rocblas_float_complex*       y,
+                                                rocblas_int                  incy,
+                                                const rocblas_float_complex* z,
+                                                rocblas_int                  incz,
+                                                rocblas_float_complex*       result);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    axpy_dot computes y := alpha * x + y and then
+    result := y^H * z, reading x, y and z and writing y once.
+    For real types y^H * z is y^T * z. z may be y, to compute ||y||^2, but must not
+    otherwise overlap y.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    alpha     device pointer or host pointer to the scalar alpha.
+    @param[in]
+    x         device pointer storing vector x.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of x.
+    @param[inout]
+    y         device pointer storing vector y.
+    @param[in]
+    incy      rocblas_int
+              specifies the increment for the elements of y.
+    @param[in]
+    z         device pointer storing vector z.
+    @param[in]
+    incz      rocblas_int
+              specifies the increment for the elements of z.
+    @param[inout]
+    result    device pointer or host pointer to store the result.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zaxpy_dot(rocblas_handle                handle,
+                                                rocblas_int                   n,
+                                                const rocblas_double_complex* alpha,
+                                                const rocblas_double_complex* x,
+                                                rocblas_int                   incx,
+                                                rocblas_double_complex*       y,
+                                                rocblas_int                   incy,
+                                                const rocblas_double_complex* z,
+                                                rocblas_int                   incz,
+                                                rocblas_double_complex*       result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_saxpy_dot_batched(rocblas_handle     handle,
+                                                        rocblas_int        n,
+                                                        const float*       alpha,
+                                                        const float* const x[],
+                                                        rocblas_int        incx,
+                                                        float* const       y[],
+                                                        rocblas_int        incy,
+                                                        const float* const z[],
+                                                        rocblas_int        incz,
+                                                        rocblas_int        batch_count,
+                                                        float*             result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_daxpy_dot_batched(rocblas_handle      handle,
+                                                        rocblas_int         n,
+                                                        const double*       alpha,
+                                                        const double* const x[],
+                                                        rocblas_int         incx,
+                                                        double* const       y[],
+                                                        rocblas_int         incy,
+                                                        const double* const z[],
+                                                        rocblas_int         incz,
+                                                        rocblas_int         batch_count,
+                                                        double*             result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_caxpy_dot_batched(
+    rocblas_handle                     handle,
+    rocblas_int                        n,
+    const rocblas_float_complex*       alpha,
+    const rocblas_float_complex* const x[],
+    rocblas_int                        incx,
+    rocblas_float_complex* const       y[],
+    rocblas_int                        incy,
+    const rocblas_float_complex* const z[],
+    rocblas_int                        incz,
+    rocblas_int                        batch_count,
+    rocblas_float_complex*             result);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    axpy_dot_batched computes y_i := alpha * x_i + y_i and then
+    result[i] := y_i^H * z_i, reading x, y and z and writing y once.
+    For real types y^H * z is y^T * z. z may be y, to compute ||y||^2, but must not
+    otherwise overlap y.
+    This is done for each instance i in the batch.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    alpha     device pointer or host pointer to the scalar alpha.
+    @param[in]
+    x         device array of device pointers storing each vector x_i.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of each x.
+    @param[inout]
+    y         device array of device pointers storing each vector y_i.
+    @param[in]
+    incy      rocblas_int
+              specifies the increment for the elements of each y.
+    @param[in]
+    z         device array of device pointers storing each vector z_i.
+    @param[in]
+    incz      rocblas_int
+              specifies the increment for the elements of each z.
+    @param[in]
+    batch_count rocblas_int
+              number of instances in the batch.
+    @param[inout]
+    result    device pointer or host pointer to store the results, one per instance.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zaxpy_dot_batched(
+    rocblas_handle                      handle,
+    rocblas_int                         n,
+    const rocblas_double_complex*       alpha,
+    const rocblas_double_complex* const x[],
+    rocblas_int                         incx,
+    rocblas_double_complex* const       y[],
+    rocblas_int                         incy,
+    const rocblas_double_complex* const z[],
+    rocblas_int                         incz,
+    rocblas_int                         batch_count,
+    rocblas_double_complex*             result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_saxpy_dot_strided_batched(rocblas_handle handle,
+                                                                rocblas_int    n,
+                                                                const float*   alpha,
+                                                                const float*   x,
+                                                                rocblas_int    incx,
+                                                                rocblas_stride stridex,
+                                                                float*         y,
+                                                                rocblas_int    incy,
+                                                                rocblas_stride stridey,
+                                                                const float*   z,
+                                                                rocblas_int    incz,
+                                                                rocblas_stride stridez,
+                                                                rocblas_int    batch_count,
+                                                                float*         result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_daxpy_dot_strided_batched(rocblas_handle handle,
+                                                                rocblas_int    n,
+                                                                const double*  alpha,
+                                                                const double*  x,
+                                                                rocblas_int    incx,
+                                                                rocblas_stride stridex,
+                                                                double*        y,
+                                                                rocblas_int    incy,
+                                                                rocblas_stride stridey,
+                                                                const double*  z,
+                                                                rocblas_int    incz,
+                                                                rocblas_stride stridez,
+                                                                rocblas_int    batch_count,
+                                                                double*        result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_caxpy_dot_strided_batched(
+    rocblas_handle               handle,
+    rocblas_int                  n,
+    const rocblas_float_complex* alpha,
+    const rocblas_float_complex* x,
+    rocblas_int                  incx,
+    rocblas_stride               stridex,
+    rocblas_float_complex*       y,
+    rocblas_int                  incy,
+    rocblas_stride               stridey,
+    const rocblas_float_complex* z,
+    rocblas_int                  incz,
+    rocblas_stride               stridez,
+    rocblas_int                  batch_count,
+    rocblas_float_complex*       result);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    axpy_dot_strided_batched computes y_i := alpha * x_i + y_i and then
+    result[i] := y_i^H * z_i, reading x, y and z and writing y once.
+    For real types y^H * z is y^T * z. z may be y, to compute ||y||^2, but must not
+    otherwise overlap y.
+    This is done for each instance i in the batch.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    alpha     device pointer or host pointer to the scalar alpha.
+    @param[in]
+    x         device pointer to the first vector x_1.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of each x.
+    @param[in]
+    stridex   rocblas_stride
+              stride from the start of one vector (x_i) to the next (x_i+1).
+    @param[inout]
+    y         device pointer to the first vector y_1.
+    @param[in]
+    incy      rocblas_int
+              specifies the increment for the elements of each y.
+    @param[in]
+    stridey   rocblas_stride
+              stride from the start of one vector (y_i) to the next (y_i+1).
+    @param[in]
+    z         device pointer to the first vector z_1.
+    @param[in]
+    incz      rocblas_int
+              specifies the increment for the elements of each z.
+    @param[in]
+    stridez   rocblas_stride
+              stride from the start of one vector (z_i) to the next (z_i+1).
+    @param[in]
+    batch_count rocblas_int
+              number of instances in the batch.
+    @param[inout]
+    result    device pointer or host pointer to store the results, one per instance.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zaxpy_dot_strided_batched(
+    rocblas_handle                handle,
+    rocblas_int                   n,
+    const rocblas_double_complex* alpha,
+    const rocblas_double_complex* x,
+    rocblas_int                   incx,
+    rocblas_stride                stridex,
+    rocblas_double_complex*       y,
+    rocblas_int                   incy,
+    rocblas_stride                stridey,
+    const rocblas_double_complex* z,
+    rocblas_int                   incz,
+    rocblas_stride                stridez,
+    rocblas_int                   batch_count,
+    rocblas_double_complex*       result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_smulti_dot(rocblas_handle handle,
+                                                 rocblas_int    n,
+                                                 rocblas_int    k,
+                                                 const float*   x,
+                                                 rocblas_int    incx,
+                                                 const float*   y,
+                                                 rocblas_int    incy,
+                                                 rocblas_int    ldy,
+                                                 float*         results);
+
+ROCBLAS_EXPORT rocblas_status rocblas_dmulti_dot(rocblas_handle handle,
+                                                 rocblas_int    n,
+                                                 rocblas_int    k,
+                                                 const double*  x,
+                                                 rocblas_int    incx,
+                                                 const double*  y,
+                                                 rocblas_int    incy,
+                                                 rocblas_int    ldy,
+                                                 double*        results);
+
+ROCBLAS_EXPORT rocblas_status rocblas_cmulti_dot(rocblas_handle               handle,
+                                                 rocblas_int                  n,
+                                                 rocblas_int                  k,
+                                                 const rocblas_float_complex* x,
+                                                 rocblas_int                  incx,
+                                                 const rocblas_float_complex* y,
+                                                 rocblas_int                  incy,
+                                                 rocblas_int                  ldy,
+                                                 rocblas_float_complex*       results);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    multi_dot computes results[j] := x^H * y_j for j = 0, ..., k - 1,
+    where y_j starts at y + j * ldy, reading x once. For real types x^H is x^T.
+    This is the projection step of Gram-Schmidt orthogonalization.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    k         rocblas_int
+              the number of vectors y_j.
+    @param[in]
+    x         device pointer storing vector x.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of x.
+    @param[in]
+    y         device pointer storing vector y.
+              of the k vectors y_j.
+    @param[in]
+    incy      rocblas_int
+              specifies the increment for the elements of each y_j.
+    @param[in]
+    ldy       rocblas_int
+              specifies the distance between the first elements of y_j and y_j+1.
+              When k > 1, ldy >= n * |incy|.
+    @param[inout]
+    results   device pointer or host pointer to store the k results.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zmulti_dot(rocblas_handle                handle,
+                                                 rocblas_int                   n,
+                                                 rocblas_int                   k,
+                                                 const rocblas_double_complex* x,
+                                                 rocblas_int                   incx,
+                                                 const rocblas_double_complex* y,
+                                                 rocblas_int                   incy,
+                                                 rocblas_int                   ldy,
+                                                 rocblas_double_complex*       results);
+
+ROCBLAS_EXPORT rocblas_status rocblas_smulti_dot_batched(rocblas_handle     handle,
+                                                         rocblas_int        n,
+                                                         rocblas_int        k,
+                                                         const float* const x[],
+                                                         rocblas_int        incx,
+                                                         const float* const y[],
+                                                         rocblas_int        incy,
+                                                         rocblas_int        ldy,
+                                                         rocblas_int        batch_count,
+                                                         float*             results);
+
+ROCBLAS_EXPORT rocblas_status rocblas_dmulti_dot_batched(rocblas_handle      handle,
+                                                         rocblas_int         n,
+                                                         rocblas_int         k,
+                                                         const double* const x[],
+                                                         rocblas_int         incx,
+                                                         const double* const y[],
+                                                         rocblas_int         incy,
+                                                         rocblas_int         ldy,
+                                                         rocblas_int         batch_count,
+                                                         double*             results);
+
+ROCBLAS_EXPORT rocblas_status rocblas_cmulti_dot_batched(
+    rocblas_handle                     handle,
+    rocblas_int                        n,
+    rocblas_int                        k,
+    const rocblas_float_complex* const x[],
+    rocblas_int                        incx,
+    const rocblas_float_complex* const y[],
+    rocblas_int                        incy,
+    rocblas_int                        ldy,
+    rocblas_int                        batch_count,
+    rocblas_float_complex*             results);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    multi_dot_batched computes results[i * k + j] := x_i^H * y_i_j for j = 0, ..., k - 1,
+    where y_i_j starts at y_i + j * ldy, reading x once. For real types x^H is x^T.
+    This is the projection step of Gram-Schmidt orthogonalization.
+    This is done for each instance i in the batch.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    k         rocblas_int
+              the number of vectors y_j.
+    @param[in]
+    x         device array of device pointers storing each vector x_i.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of each x.
+    @param[in]
+    y         device array of device pointers storing each vector y_i.
+              of the k vectors y_i_j of each instance.
+    @param[in]
+    incy      rocblas_int
+              specifies the increment for the elements of each y_j.
+    @param[in]
+    ldy       rocblas_int
+              specifies the distance between the first elements of y_j and y_j+1.
+              When k > 1, ldy >= n * |incy|.
+    @param[in]
+    batch_count rocblas_int
+              number of instances in the batch.
+    @param[inout]
+    results   device pointer or host pointer to store the k results of each
+              instance, k * batch_count in all.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zmulti_dot_batched(
+    rocblas_handle                      handle,
+    rocblas_int                         n,
+    rocblas_int                         k,
+    const rocblas_double_complex* const x[],
+    rocblas_int                         incx,
+    const rocblas_double_complex* const y[],
+    rocblas_int                         incy,
+    rocblas_int                         ldy,
+    rocblas_int                         batch_count,
+    rocblas_double_complex*             results);
+
+ROCBLAS_EXPORT rocblas_status rocblas_smulti_dot_strided_batched(rocblas_handle handle,
+                                                                 rocblas_int    n,
+                                                                 rocblas_int    k,
+                                                                 const float*   x,
+                                                                 rocblas_int    incx,
+                                                                 rocblas_stride stridex,
+                                                                 const float*   y,
+                                                                 rocblas_int    incy,
+                                                                 rocblas_int    ldy,
+                                                                 rocblas_stride stridey,
+                                                                 rocblas_int    batch_count,
+                                                                 float*         results);
+
+ROCBLAS_EXPORT rocblas_status rocblas_dmulti_dot_strided_batched(rocblas_handle handle,
+                                                                 rocblas_int    n,
+                                                                 rocblas_int    k,
+                                                                 const double*  x,
+                                                                 rocblas_int    incx,
+                                                                 rocblas_stride stridex,
+                                                                 const double*  y,
+                                                                 rocblas_int    incy,
+                                                                 rocblas_int    ldy,
+                                                                 rocblas_stride stridey,
+                                                                 rocblas_int    batch_count,
+                                                                 double*        results);
+
+ROCBLAS_EXPORT rocblas_status rocblas_cmulti_dot_strided_batched(
+    rocblas_handle               handle,
+    rocblas_int                  n,
+    rocblas_int                  k,
+    const rocblas_float_complex* x,
+    rocblas_int                  incx,
+    rocblas_stride               stridex,
+    const rocblas_float_complex* y,
+    rocblas_int                  incy,
+    rocblas_int                  ldy,
+    rocblas_stride               stridey,
+    rocblas_int                  batch_count,
+    rocblas_float_complex*       results);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    multi_dot_strided_batched computes results[i * k + j] := x_i^H * y_i_j for j = 0, ..., k - 1,
+    where y_i_j starts at y_i + j * ldy, reading x once. For real types x^H is x^T.
+    This is the projection step of Gram-Schmidt orthogonalization.
+    This is done for each instance i in the batch.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    k         rocblas_int
+              the number of vectors y_j.
+    @param[in]
+    x         device pointer to the first vector x_1.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of each x.
+    @param[in]
+    stridex   rocblas_stride
+              stride from the start of one vector (x_i) to the next (x_i+1).
+    @param[in]
+    y         device pointer to the first vector y_1.
+              of the k vectors y_i_j of each instance.
+    @param[in]
+    incy      rocblas_int
+              specifies the increment for the elements of each y_j.
+    @param[in]
+    ldy       rocblas_int
+              specifies the distance between the first elements of y_j and y_j+1.
+              When k > 1, ldy >= n * |incy|.
+    @param[in]
+    stridey   rocblas_stride
+              stride from the start of the vectors of one instance (y_i) to the next.
+    @param[in]
+    batch_count rocblas_int
+              number of instances in the batch.
+    @param[inout]
+    results   device pointer or host pointer to store the k results of each
+              instance, k * batch_count in all.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zmulti_dot_strided_batched(
+    rocblas_handle                handle,
+    rocblas_int                   n,
+    rocblas_int                   k,
+    const rocblas_double_complex* x,
+    rocblas_int                   incx,
+    rocblas_stride                stridex,
+    const rocblas_double_complex* y,
+    rocblas_int                   incy,
+    rocblas_int                   ldy,
+    rocblas_stride                stridey,
+    rocblas_int                   batch_count,
+    rocblas_double_complex*       results);
+
+ROCBLAS_EXPORT rocblas_status rocblas_sscal_nrm2(rocblas_handle handle,
+                                                 rocblas_int    n,
+                                                 const float*   alpha,
+                                                 float*         x,
+                                                 rocblas_int    incx,
+                                                 float*         result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_dscal_nrm2(rocblas_handle handle,
+                                                 rocblas_int    n,
+                                                 const double*  alpha,
+                                                 double*        x,
+                                                 rocblas_int    incx,
+                                                 double*        result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_cscal_nrm2(rocblas_handle               handle,
+                                                 rocblas_int                  n,
+                                                 const rocblas_float_complex* alpha,
+                                                 rocblas_float_complex*       x,
+                                                 rocblas_int                  incx,
+                                                 float*                       result);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    scal_nrm2 computes x := alpha * x and then result := ||x||_2,
+    reading and writing x once.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    alpha     device pointer or host pointer to the scalar alpha.
+    @param[inout]
+    x         device pointer storing vector x.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of x.
+    @param[inout]
+    result    device pointer or host pointer to store the result.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zscal_nrm2(rocblas_handle                handle,
+                                                 rocblas_int                   n,
+                                                 const rocblas_double_complex* alpha,
+                                                 rocblas_double_complex*       x,
+                                                 rocblas_int                   incx,
+                                                 double*                       result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_sscal_nrm2_batched(rocblas_handle handle,
+                                                         rocblas_int    n,
+                                                         const float*   alpha,
+                                                         float* const   x[],
+                                                         rocblas_int    incx,
+                                                         rocblas_int    batch_count,
+                                                         float*         result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_dscal_nrm2_batched(rocblas_handle handle,
+                                                         rocblas_int    n,
+                                                         const double*  alpha,
+                                                         double* const  x[],
+                                                         rocblas_int    incx,
+                                                         rocblas_int    batch_count,
+                                                         double*        result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_cscal_nrm2_batched(rocblas_handle               handle,
+                                                         rocblas_int                  n,
+                                                         const rocblas_float_complex* alpha,
+                                                         rocblas_float_complex* const x[],
+                                                         rocblas_int                  incx,
+                                                         rocblas_int                  batch_count,
+                                                         float*                       result);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    scal_nrm2_batched computes x_i := alpha * x_i and then result[i] := ||x_i||_2,
+    reading and writing x once.
+    This is done for each instance i in the batch.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    alpha     device pointer or host pointer to the scalar alpha.
+    @param[inout]
+    x         device array of device pointers storing each vector x_i.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of each x.
+    @param[in]
+    batch_count rocblas_int
+              number of instances in the batch.
+    @param[inout]
+    result    device pointer or host pointer to store the results, one per instance.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zscal_nrm2_batched(rocblas_handle                handle,
+                                                         rocblas_int                   n,
+                                                         const rocblas_double_complex* alpha,
+                                                         rocblas_double_complex* const x[],
+                                                         rocblas_int                   incx,
+                                                         rocblas_int                   batch_count,
+                                                         double*                       result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_sscal_nrm2_strided_batched(rocblas_handle handle,
+                                                                 rocblas_int    n,
+                                                                 const float*   alpha,
+                                                                 float*         x,
+                                                                 rocblas_int    incx,
+                                                                 rocblas_stride stridex,
+                                                                 rocblas_int    batch_count,
+                                                                 float*         result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_dscal_nrm2_strided_batched(rocblas_handle handle,
+                                                                 rocblas_int    n,
+                                                                 const double*  alpha,
+                                                                 double*        x,
+                                                                 rocblas_int    incx,
+                                                                 rocblas_stride stridex,
+                                                                 rocblas_int    batch_count,
+                                                                 double*        result);
+
+ROCBLAS_EXPORT rocblas_status rocblas_cscal_nrm2_strided_batched(
+    rocblas_handle               handle,
+    rocblas_int                  n,
+    const rocblas_float_complex* alpha,
+    rocblas_float_complex*       x,
+    rocblas_int                  incx,
+    rocblas_stride               stridex,
+    rocblas_int                  batch_count,
+    float*                       result);
+
+/*! \brief BLAS Level 1 API
+
+    \details
+    scal_nrm2_strided_batched computes x_i := alpha * x_i and then result[i] := ||x_i||_2,
+    reading and writing x once.
+    This is done for each instance i in the batch.
+
+    @param[in]
+    handle    rocblas_handle
+              handle to the rocblas library context queue.
+    @param[in]
+    n         rocblas_int
+              the number of elements in each vector.
+    @param[in]
+    alpha     device pointer or host pointer to the scalar alpha.
+    @param[inout]
+    x         device pointer to the first vector x_1.
+    @param[in]
+    incx      rocblas_int
+              specifies the increment for the elements of each x.
+    @param[in]
+    stridex   rocblas_stride
+              stride from the start of one vector (x_i) to the next (x_i+1).
+    @param[in]
+    batch_count rocblas_int
+              number of instances in the batch.
+    @param[inout]
+    result    device pointer or host pointer to store the results, one per instance.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_zscal_nrm2_strided_batched(
+    rocblas_handle                handle,
+    rocblas_int                   n,
+    const rocblas_double_complex* alpha,
+    rocblas_double_complex*       x,
+    rocblas_int                   incx,
+    rocblas_stride                stridex,
+    rocblas_int                   batch_count,
+    double*                       result);
+
 /*
  * ===========================================================================
  *    level 2 BLAS
@@ -15342,6 +16291,239 @@ ROCBLAS_EXPORT rocblas_status rocblas_gemm_strided_batched_ex(rocblas_handle
 
 // clang-format on
 
+/*! \brief BLAS EX API
+
+    \details
+    GEMM_GROUPED_BATCHED_EX performs the matrix-matrix operations
+
+        D_i = alpha_g*op( A_i )*op( B_i ) + beta_g*C_i, for i in group g,
+
+    for groups g = 0, ..., group_count-1 of problems whose sizes, leading dimensions,
+    transposes, alpha and beta can differ from group to group. Group g holds group_size[g]
+    problems, which all have the sizes, leading dimensions, transposes and scalars of
+    index g of the per-group arrays. The problems of all groups are numbered in group
+    order, and a, b, c and d hold one pointer per problem in that order.
+
+    Groups describing the same problem are solved by the same batched launch, even when
+    they are not adjacent, so a few distinct shapes spread over many groups take a few
+    launches. Groups with m == 0, n == 0 or group_size == 0 are skipped. The problems
+    must not write to memory read or written by another problem.
+
+    @param[in]
+    handle    [rocblas_handle]
+              handle to the rocblas library context queue.
+    @param[in]
+    group_count
+              [rocblas_int]
+              number of groups.
+    @param[in]
+    transA    [const rocblas_operation *]
+              host array of group_count forms of op( A ).
+    @param[in]
+    transB    [const rocblas_operation *]
+              host array of group_count forms of op( B ).
+    @param[in]
+    m         [const rocblas_int *]
+              host array of group_count matrix dimensions m.
+    @param[in]
+    n         [const rocblas_int *]
+              host array of group_count matrix dimensions n.
+    @param[in]
+    k         [const rocblas_int *]
+              host array of group_count matrix dimensions k.
+    @param[in]
+    alpha     [const void *]
+              device array or host array of group_count scalars alpha,
+              as selected by the pointer mode. Same datatype as compute_type.
+    @param[in]
+    a         [void *]
+              device array of device pointers to each matrix A_i.
+    @param[in]
+    a_type    [rocblas_datatype]
+              specifies the datatype of each matrix A_i.
+    @param[in]
+    lda       [const rocblas_int *]
+              host array of group_count leading dimensions of the A_i.
+    @param[in]
+    b         [void *]
+              device array of device pointers to each matrix B_i.
+    @param[in]
+    b_type    [rocblas_datatype]
+              specifies the datatype of each matrix B_i.
+    @param[in]
+    ldb       [const rocblas_int *]
+              host array of group_count leading dimensions of the B_i.
+    @param[in]
+    beta      [const void *]
+              device array or host array of group_count scalars beta,
+              as selected by the pointer mode. Same datatype as compute_type.
+    @param[in]
+    c         [void *]
+              device array of device pointers to each matrix C_i.
+    @param[in]
+    c_type    [rocblas_datatype]
+              specifies the datatype of each matrix C_i.
+    @param[in]
+    ldc       [const rocblas_int *]
+              host array of group_count leading dimensions of the C_i.
+    @param[out]
+    d         [void *]
+              device array of device pointers to each matrix D_i.
+    @param[in]
+    d_type    [rocblas_datatype]
+              specifies the datatype of each matrix D_i.
+    @param[in]
+    ldd       [const rocblas_int *]
+              host array of group_count leading dimensions of the D_i.
+    @param[in]
+    group_size
+              [const rocblas_int *]
+              host array of group_count numbers of problems in each group.
+    @param[in]
+    compute_type
+              [rocblas_datatype]
+              specifies the datatype of computation.
+    @param[in]
+    algo      [rocblas_gemm_algo]
+              enumerant specifying the algorithm type.
+    @param[in]
+    solution_index
+              [int32_t]
+              reserved for future use.
+    @param[in]
+    flags     [uint32_t]
+              optional gemm flags.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_gemm_grouped_batched_ex(
+    rocblas_handle           handle,
+    rocblas_int              group_count,
+    const rocblas_operation* transA,
+    const rocblas_operation* transB,
+    const rocblas_int*       m,
+    const rocblas_int*       n,
+    const rocblas_int*       k,
+    const void*              alpha,
+    const void*              a,
+    rocblas_datatype         a_type,
+    const rocblas_int*       lda,
+    const void*              b,
+    rocblas_datatype         b_type,
+    const rocblas_int*       ldb,
+    const void*              beta,
+    const void*              c,
+    rocblas_datatype         c_type,
+    const rocblas_int*       ldc,
+    void*                    d,
+    rocblas_datatype         d_type,
+    const rocblas_int*       ldd,
+    const rocblas_int*       group_size,
+    rocblas_datatype         compute_type,
+    rocblas_gemm_algo        algo,
+    int32_t                  solution_index,
+    uint32_t                 flags);
+
+/*! \brief BLAS EX API
+
+    \details
+    GEMM_EX_EPILOGUE performs the matrix-matrix operation of GEMM_EX,
+
+        D = alpha*op( A )*op( B ) + beta*C,
+
+    followed by the operations of an epilogue on each element x of D,
+
+        out = convert(clamp(activation(scale*x + bias))),
+
+    where scale and bias are taken from per-row or per-column vectors. The epilogue is one
+    pass over D after the gemm, in place of separate launches for bias, activation,
+    scaling and type conversion, which would each read and write D.
+
+    Supported types of D are f16_r, bf16_r, f32_r and i32_r, with out_type f16_r, bf16_r,
+    f32_r, i8_r or i32_r, and f64_r, with out_type f64_r or f32_r. scale, bias, clamp_min
+    and clamp_max are float, or double when D is f64_r.
+
+    The arguments are those of rocblas_gemm_ex, followed by
+
+    @param[in]
+    epilogue  [const rocblas_gemm_epilogue *]
+              host pointer to the epilogue, or NULL for no epilogue. See
+              rocblas_gemm_epilogue.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_gemm_ex_epilogue(rocblas_handle               handle,
+                                                       rocblas_operation            transA,
+                                                       rocblas_operation            transB,
+                                                       rocblas_int                  m,
+                                                       rocblas_int                  n,
+                                                       rocblas_int                  k,
+                                                       const void*                  alpha,
+                                                       const void*                  a,
+                                                       rocblas_datatype             a_type,
+                                                       rocblas_int                  lda,
+                                                       const void*                  b,
+                                                       rocblas_datatype             b_type,
+                                                       rocblas_int                  ldb,
+                                                       const void*                  beta,
+                                                       const void*                  c,
+                                                       rocblas_datatype             c_type,
+                                                       rocblas_int                  ldc,
+                                                       void*                        d,
+                                                       rocblas_datatype             d_type,
+                                                       rocblas_int                  ldd,
+                                                       rocblas_datatype             compute_type,
+                                                       rocblas_gemm_algo            algo,
+                                                       int32_t                      solution_index,
+                                                       uint32_t                     flags,
+                                                       const rocblas_gemm_epilogue* epilogue);
+
+/*! \brief BLAS EX API
+
+    \details
+    GEMM_STRIDED_BATCHED_EX_EPILOGUE performs the matrix-matrix operations of
+    GEMM_STRIDED_BATCHED_EX, followed by the epilogue of GEMM_EX_EPILOGUE on each D_i.
+    The vectors and output of batch i start at stride_scale, stride_bias and stride_out
+    times i, as given in the epilogue.
+
+    The arguments are those of rocblas_gemm_strided_batched_ex, followed by
+
+    @param[in]
+    epilogue  [const rocblas_gemm_epilogue *]
+              host pointer to the epilogue, or NULL for no epilogue. See
+              rocblas_gemm_epilogue.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status
+    rocblas_gemm_strided_batched_ex_epilogue(rocblas_handle               handle,
+                                             rocblas_operation            transA,
+                                             rocblas_operation            transB,
+                                             rocblas_int                  m,
+                                             rocblas_int                  n,
+                                             rocblas_int                  k,
+                                             const void*                  alpha,
+                                             const void*                  a,
+                                             rocblas_datatype             a_type,
+                                             rocblas_int                  lda,
+                                             rocblas_stride               stride_a,
+                                             const void*                  b,
+                                             rocblas_datatype             b_type,
+                                             rocblas_int                  ldb,
+                                             rocblas_stride               stride_b,
+                                             const void*                  beta,
+                                             const void*                  c,
+                                             rocblas_datatype             c_type,
+                                             rocblas_int                  ldc,
+                                             rocblas_stride               stride_c,
+                                             void*                        d,
+                                             rocblas_datatype             d_type,
+                                             rocblas_int                  ldd,
+                                             rocblas_stride               stride_d,
+                                             rocblas_int                  batch_count,
+                                             rocblas_datatype             compute_type,
+                                             rocblas_gemm_algo            algo,
+                                             int32_t                      solution_index,
+                                             uint32_t                     flags,
+                                             const rocblas_gemm_epilogue* epilogue);
+
 /*! \brief BLAS EX API
 
     \details
@@ -17187,6 +18369,166 @@ ROCBLAS_EXPORT bool rocblas_is_managing_device_memory(rocblas_handle handle);
  ******************************************************************************/
 ROCBLAS_EXPORT bool rocblas_is_user_managing_device_memory(rocblas_handle handle);
 
+/*! \brief
+    \details
+    Gets the statistics of the device memory pool of the handle's device.
+    If the environment variable ROCBLAS_DEVICE_MEMORY_POOL is set, handles whose device memory
+    is managed by rocBLAS draw it from a pool shared by all handles on the device, holding it
+    only while it is in use.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if stats is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[out]
+    stats           statistics of the pool
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_device_memory_pool_stats(
+    rocblas_handle handle, rocblas_device_memory_pool_stats* stats);
+
+/*! \brief
+    \details
+    Resets the counters of the device memory pool of the handle's device, and sets its high-water marks to the current usage.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_reset_device_memory_pool_stats(rocblas_handle handle);
+
+/*! \brief
+    \details
+    Frees the idle memory cached by the device memory pool of the handle's device.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_trim_device_memory_pool(rocblas_handle handle);
+
+/*! \brief
+    \details
+    Sets the most device memory used by the handle's cache of inverted diagonal blocks of
+    triangular matrices. The cache is disabled by default, with a size of 0.
+    When it is enabled, trsm and trsm_strided_batched, without a supplied invA, keep the
+    inverted diagonal blocks of A which they compute, and reuse them in later calls with the
+    same A, offset, lda, stride, order of the blocks, batch_count, uplo, diag, type and
+    generation instead of computing them again. The least recently used entries are freed to
+    make room for new ones. trsm_batched uses the cache only after
+    rocblas_set_trsm_inverse_cache_batched with rocblas_trsm_inverse_cache_batched_included.
+    The cache cannot see the contents of A: after they change, or A is freed and its memory
+    reused, rocblas_set_trsm_inverse_cache_generation must be called with a new generation.
+    Setting a smaller size frees entries.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_capture_unsafe if entries would be freed in capture-safe mode; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    size            most bytes of device memory, or 0 to disable the cache and free its entries
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_trsm_inverse_cache_size(rocblas_handle handle,
+                                                                  size_t         size);
+
+/*! \brief
+    \details
+    Gets the most device memory used by the handle's cache of inverted diagonal blocks.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if size is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[out]
+    size            most bytes of device memory, or 0 if the cache is disabled
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_trsm_inverse_cache_size(rocblas_handle handle,
+                                                                  size_t*        size);
+
+/*! \brief
+    \details
+    Sets the generation of triangular matrices which, with A's pointer and dimensions, keys
+    the handle's cache of inverted diagonal blocks. Calls after it only reuse blocks inverted
+    at the same generation. The generation is 0 by default.
+    For trsm_batched, A's pointer is the address of the array of pointers to the matrices,
+    not the matrices: a new generation must be set when the array is reused with other
+    pointers, as well as when the contents of any of the matrices change.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    generation      generation of the contents of the triangular matrices
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_trsm_inverse_cache_generation(rocblas_handle handle,
+                                                                        size_t generation);
+
+/*! \brief
+    \details
+    Sets whether trsm_batched uses the handle's cache of inverted diagonal blocks. Its entries
+    are keyed by the address of the array of pointers to the matrices A, which the cache cannot
+    look through, so batched calls are excluded by default. Calls of trsm and
+    trsm_strided_batched are not affected.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_value if batched is not a rocblas_trsm_inverse_cache_batched value; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    batched         rocblas_trsm_inverse_cache_batched_included to cache the inverted blocks
+                    of trsm_batched, or rocblas_trsm_inverse_cache_batched_excluded
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_trsm_inverse_cache_batched(
+    rocblas_handle handle, rocblas_trsm_inverse_cache_batched batched);
+
+/*! \brief
+    \details
+    Gets whether trsm_batched uses the handle's cache of inverted diagonal blocks.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if batched is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[out]
+    batched         whether trsm_batched uses the cache
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_trsm_inverse_cache_batched(
+    rocblas_handle handle, rocblas_trsm_inverse_cache_batched* batched);
+
+/*! \brief
+    \details
+    Gets the statistics of the handle's cache of inverted diagonal blocks.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if stats is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[out]
+    stats           statistics of the cache
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_trsm_inverse_cache_stats(
+    rocblas_handle handle, rocblas_trsm_inverse_cache_stats* stats);
+
+/*! \brief
+    \details
+    Resets the hits, misses and evictions of the handle's cache of inverted diagonal blocks.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_reset_trsm_inverse_cache_stats(rocblas_handle handle);
+
+/*! \brief
+    \details
+    Frees the entries of the handle's cache of inverted diagonal blocks.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_capture_unsafe if there are entries in capture-safe mode; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_clear_trsm_inverse_cache(rocblas_handle handle);
+
+/*! \brief
+    \details
+    Sets launch tuning entries which select the block dimensions of gemv and scal kernels
+    in handle, ahead of those of the file named by ROCBLAS_LAUNCH_TUNING_FILE and of the
+    table compiled into rocBLAS. The table is text with one entry per line,
+    "kernel arch precision trans m_min m_max n_min n_max dim_x dim_y", where kernel is
+    gemvn, gemvt or scal, and * matches any arch, precision or trans or is an unbounded
+    m_max or n_max. The first entry which matches a call is used. rocblas-bench --tune
+    writes tables of this format.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_value if the table is invalid, in which case the handle is unchanged; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    table           entries as text, or nullptr to remove those set before
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_launch_tuning_table(rocblas_handle handle,
+                                                              const char*    table);
+
 /*! \brief
     \details
     Abort function which safely flushes all IO
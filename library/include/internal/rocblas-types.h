@@ -168,6 +168,8 @@ typedef enum rocblas_status_
     rocblas_status_continue            = 12, /**< nothing preventing function to proceed */
     rocblas_status_check_numerics_fail
     = 13, /**< will be set if the vector/matrix has a NaN or an Infinity */
+    rocblas_status_capture_unsafe
+    = 14, /**< needs a host synchronization or allocation, which rocblas_capture_safe forbids */
 } rocblas_status;
 
 /*! \brief Indicates the precision width of data stored in a blas type. */
@@ -211,6 +213,35 @@ typedef enum rocblas_atomics_mode_
     rocblas_atomics_allowed = 1,
 } rocblas_atomics_mode;
 
+/*! \brief Indicates when results which rocBLAS functions return in host memory, in host
+*    pointer mode, are written. Applies to the results of the dot, asum, nrm2, iamax and
+*    iamin functions and their batched and strided batched variants. */
+typedef enum rocblas_host_result_mode_
+{
+    /*! \brief Results are written before the function returns */
+    rocblas_host_result_blocking = 0,
+    /*! \brief Results are written when the work queued on the handle's stream before the
+     * function returns has completed. They may be read after synchronizing the stream, or
+     * an event recorded on it after the call. The result memory must remain valid until
+     * then. */
+    rocblas_host_result_deferred = 1,
+} rocblas_host_result_mode;
+
+/*! \brief Indicates whether rocBLAS functions may synchronize with the host or allocate
+*    memory. Functions which do either may not be captured in a HIP graph, and stall the
+*    host while the device catches up. */
+typedef enum rocblas_capture_mode_
+{
+    /*! \brief Functions synchronize and allocate memory where needed */
+    rocblas_capture_default = 0,
+    /*! \brief Functions neither synchronize with the host nor allocate memory. A function
+     * which would need to returns rocblas_status_capture_unsafe, generally before queueing
+     * any work. Device memory must be set with rocblas_set_device_memory_size, or be large
+     * enough from previous calls; results in host memory need rocblas_host_result_deferred;
+     * and numerical checking, except rocblas_check_numerics_mode_deferred, is unavailable. */
+    rocblas_capture_safe = 1,
+} rocblas_capture_mode;
+
 /*! \brief Indicates which performance metric Tensile uses when selecting the optimal
 *    solution for gemm problems.  */
 typedef enum rocblas_performance_metric_
@@ -224,6 +255,141 @@ typedef enum rocblas_performance_metric_
     rocblas_cu_efficiency_performance_metric = 2
 } rocblas_performance_metric;
 
+/*! \brief Statistics of the cache of gemm solutions selected by Tensile on a device */
+typedef struct rocblas_solution_cache_stats_
+{
+    /*! \brief Number of lookups which found a cached solution */
+    size_t hits;
+    /*! \brief Number of lookups which did not find a cached solution */
+    size_t misses;
+    /*! \brief Number of cached solutions replaced by newer ones */
+    size_t evictions;
+    /*! \brief Number of solutions currently cached */
+    size_t entries;
+    /*! \brief Maximum number of solutions cached. 0 if the cache is disabled */
+    size_t capacity;
+} rocblas_solution_cache_stats;
+
+/*! \brief Statistics of the pool of device memory shared by the handles on a device */
+typedef struct rocblas_device_memory_pool_stats_
+{
+    /*! \brief Number of blocks requested from the pool */
+    size_t allocations;
+    /*! \brief Number of requests served by a cached block */
+    size_t reuses;
+    /*! \brief Number of blocks allocated from the device */
+    size_t device_allocations;
+    /*! \brief Number of cached blocks freed back to the device */
+    size_t device_frees;
+    /*! \brief Number of requests which could not be allocated */
+    size_t failures;
+    /*! \brief Bytes in blocks held by handles */
+    size_t bytes_in_use;
+    /*! \brief Bytes requested by handles for the blocks they hold */
+    size_t bytes_requested;
+    /*! \brief Bytes in idle blocks cached for reuse */
+    size_t bytes_cached;
+    /*! \brief Number of idle blocks cached for reuse */
+    size_t blocks_cached;
+    /*! \brief Maximum of bytes_in_use */
+    size_t high_water_in_use;
+    /*! \brief Maximum of bytes_in_use + bytes_cached */
+    size_t high_water_reserved;
+    /*! \brief Fraction of bytes_in_use + bytes_cached which is not requested by handles */
+    double fragmentation;
+} rocblas_device_memory_pool_stats;
+
+/*! \brief Numbers of host synchronizations and allocations made by a handle's functions */
+typedef struct rocblas_sync_point_counts_
+{
+    /*! \brief Blocking copies between host and device memory */
+    size_t copies;
+    /*! \brief Waits for a stream */
+    size_t stream_syncs;
+    /*! \brief Waits for an event */
+    size_t event_syncs;
+    /*! \brief Allocations of device or pinned host memory */
+    size_t allocations;
+    /*! \brief Frees of device or pinned host memory */
+    size_t frees;
+    /*! \brief Synchronizations and allocations refused in rocblas_capture_safe mode */
+    size_t refused;
+} rocblas_sync_point_counts;
+
+/*! \brief Statistics of a handle's cache of TRSM inverted diagonal blocks */
+typedef struct rocblas_trsm_inverse_cache_stats_
+{
+    /*! \brief Number of solves which reused cached inverted blocks */
+    size_t hits;
+    /*! \brief Number of solves which inverted the diagonal blocks of A */
+    size_t misses;
+    /*! \brief Number of entries evicted to make room for others */
+    size_t evictions;
+    /*! \brief Number of cached entries */
+    size_t entries;
+    /*! \brief Bytes of device memory held by cached entries */
+    size_t bytes;
+} rocblas_trsm_inverse_cache_stats;
+
+/*! \brief Indicates whether a handle's cache of TRSM inverted diagonal blocks is used by
+*    trsm_batched, whose entries are keyed by the address of the array of pointers to the
+*    matrices A rather than by the matrices themselves */
+typedef enum rocblas_trsm_inverse_cache_batched_
+{
+    /*! \brief trsm_batched neither uses nor adds cached inverted blocks */
+    rocblas_trsm_inverse_cache_batched_excluded = 0,
+    /*! \brief trsm_batched reuses the blocks inverted by calls with the same array of
+     * pointers. The caller must set a new generation when the array or any matrix it points
+     * to changes. */
+    rocblas_trsm_inverse_cache_batched_included = 1,
+} rocblas_trsm_inverse_cache_batched;
+
+/*! \brief Results of rocblas_check_numerics_mode_deferred accumulated by a handle */
+typedef struct rocblas_check_numerics_report_
+{
+    /*! \brief Number of rocBLAS calls whose operands were checked */
+    uint64_t checked_calls;
+    /*! \brief Number of rocBLAS calls not checked because of sampling */
+    uint64_t skipped_calls;
+    /*! \brief Number of vectors and matrices checked */
+    uint64_t checked_operands;
+    /*! \brief Whether a checked operand had a NaN */
+    bool has_NaN;
+    /*! \brief Whether a checked operand had a zero */
+    bool has_zero;
+    /*! \brief Whether a checked operand had an Inf */
+    bool has_Inf;
+    /*! \brief Whether the first operand found with a NaN or an Inf was an input */
+    bool first_abnormal_is_input;
+    /*! \brief Name of the function of the first operand found with a NaN or an Inf,
+        or NULL if there is none or it is too old to be known */
+    const char* first_abnormal_function;
+} rocblas_check_numerics_report;
+
+/*! \brief Number of buckets of rocblas_function_counters::latency_histogram */
+#define ROCBLAS_PERF_LATENCY_BUCKETS 24
+
+/*! \brief Calls of a rocBLAS function counted with rocblas_layer_mode_perf_counters */
+typedef struct rocblas_function_counters_
+{
+    /*! \brief Name of the function, e.g. rocblas_sgemm */
+    const char* function;
+    /*! \brief Number of calls */
+    size_t calls;
+    /*! \brief Bytes of the operands which the calls read and write in device memory */
+    double bytes;
+    /*! \brief Floating point operations performed by the calls, as rocblas-bench counts them */
+    double flops;
+    /*! \brief Sum of the host-side latencies of the calls, in microseconds */
+    double latency_us_sum;
+    /*! \brief Maximum host-side latency of a call, in microseconds */
+    double latency_us_max;
+    /*! \brief Numbers of calls by host-side latency. Bucket 0 counts the latencies below 1 us,
+        bucket b < ROCBLAS_PERF_LATENCY_BUCKETS - 1 those in [2^(b-1), 2^b) us, and the last
+        bucket all longer ones. */
+    size_t latency_histogram[ROCBLAS_PERF_LATENCY_BUCKETS];
+} rocblas_function_counters;
+
 /*! \brief Indicates if layer is active with bitmask*/
 typedef enum rocblas_layer_mode_
 {
@@ -235,6 +401,10 @@ typedef enum rocblas_layer_mode_
     rocblas_layer_mode_log_bench = 0x2,
     /*! \brief Outputs a YAML description of each rocBLAS function called, along with its arguments and number of times it was called. */
     rocblas_layer_mode_log_profile = 0x4,
+    /*! \brief Counts the calls of each rocBLAS function, with the work they do and their host-side latencies, for rocblas_get_perf_counters. */
+    rocblas_layer_mode_perf_counters = 0x8,
+    /*! \brief Records each rocBLAS function call, and optionally its GPU time, on a timeline in the Chrome trace event format. */
+    rocblas_layer_mode_log_timeline = 0x10,
 } rocblas_layer_mode;
 
 /*! \brief Indicates if layer is active with bitmask*/
@@ -257,6 +427,65 @@ typedef enum rocblas_gemm_flags_
     rocblas_gemm_flags_use_cu_efficiency = 0x2
 } rocblas_gemm_flags;
 
+/*! \brief Activation function applied by a gemm epilogue */
+typedef enum rocblas_gemm_epilogue_activation_
+{
+    /*! \brief No activation */
+    rocblas_gemm_epilogue_activation_none = 0x0,
+    /*! \brief max(x, 0), keeping NaN */
+    rocblas_gemm_epilogue_activation_relu = 0x1,
+    /*! \brief GELU, with the approximation 0.5 x (1 + tanh(sqrt(2 / pi) (x + 0.044715 x^3))) */
+    rocblas_gemm_epilogue_activation_gelu = 0x2,
+} rocblas_gemm_epilogue_activation;
+
+/*! \brief Indicates how a vector of a gemm epilogue is applied to the m by n result */
+typedef enum rocblas_gemm_epilogue_vector_
+{
+    /*! \brief The vector is not used */
+    rocblas_gemm_epilogue_vector_none = 0x0,
+    /*! \brief The vector has m values, one for each row */
+    rocblas_gemm_epilogue_vector_row = 0x1,
+    /*! \brief The vector has n values, one for each column */
+    rocblas_gemm_epilogue_vector_column = 0x2,
+} rocblas_gemm_epilogue_vector;
+
+/*! \brief Operations applied to the result D of a gemm by the gemm_ex_epilogue functions.
+    Each element x of D becomes clamp(activation(scale * x + bias)), which is converted to
+    out_type. scale and bias are device vectors of float, or of double when D is
+    rocblas_datatype_f64_r. The epilogue computes in double when D is rocblas_datatype_f64_r
+    or rocblas_datatype_i32_r, and in float otherwise.
+    Zero-initialize the struct so that unused fields are off. */
+typedef struct rocblas_gemm_epilogue_
+{
+    /*! \brief How scale is applied, or rocblas_gemm_epilogue_vector_none for no scaling */
+    rocblas_gemm_epilogue_vector scale_mode;
+    /*! \brief Device pointer to the scale vector of the first batch */
+    const void* scale;
+    /*! \brief Stride between the scale vectors of consecutive batches. May be 0 */
+    rocblas_stride stride_scale;
+    /*! \brief How bias is applied, or rocblas_gemm_epilogue_vector_none for no bias */
+    rocblas_gemm_epilogue_vector bias_mode;
+    /*! \brief Device pointer to the bias vector of the first batch */
+    const void* bias;
+    /*! \brief Stride between the bias vectors of consecutive batches. May be 0 */
+    rocblas_stride stride_bias;
+    /*! \brief Activation applied after scale and bias */
+    rocblas_gemm_epilogue_activation activation;
+    /*! \brief Whether the result is clamped to [clamp_min, clamp_max] after the activation */
+    bool clamp;
+    double clamp_min;
+    double clamp_max;
+    /*! \brief Device pointer to the output matrix of the first batch. If NULL, the result
+        overwrites D, and out_type, ldo and stride_out are ignored.
+        Otherwise D holds the result of the gemm before the epilogue. */
+    void* out;
+    /*! \brief Type of the output if out is not NULL. Integer types are rounded to nearest
+        and saturated */
+    rocblas_datatype out_type;
+    rocblas_int      ldo;
+    rocblas_stride   stride_out;
+} rocblas_gemm_epilogue;
+
 /*! \brief Union for representing scalar values */
 typedef union rocblas_union_u
 {
@@ -285,6 +514,10 @@ typedef enum rocblas_check_numerics_mode_
     //Return 'rocblas_status_check_numeric_fail' status if there is NaN or Inf
     rocblas_check_numerics_mode_fail = 0x4,
 
+    //Accumulate the results on the device without synchronizing, and report them at
+    //rocblas_get_check_numerics_report, according to the info, warn and fail bits
+    rocblas_check_numerics_mode_deferred = 0x8,
+
 } rocblas_check_numerics_mode;
 
 #endif
@@ -271,7 +271,8 @@ rocblas_status rocblas_reduction_kernel(rocblas_handle __restrict__ handle,
         // it must be a standard layout type and its first member must be of type Tr.
         static_assert(std::is_standard_layout<To>{}, "To must be a standard layout type");
 
-        if(blocks > 1)
+        // Kernel part2 also finalizes the result, so it is called for a non-trivial FINALIZE
+        if(blocks > 1 || !std::is_same<FINALIZE, rocblas_finalize_identity>{})
         {
             hipLaunchKernelGGL((rocblas_reduction_kernel_part2<NB, REDUCE, FINALIZE>),
                                1,
@@ -283,20 +284,9 @@ rocblas_status rocblas_reduction_kernel(rocblas_handle __restrict__ handle,
                                (Tr*)workspace);
         }
 
-        if(std::is_same<FINALIZE, rocblas_finalize_identity>{} || blocks > 1)
-        {
-            // If FINALIZE is trivial or kernel part2 was called, result is in the
-            // beginning of workspace[0], and can be copied directly.
-            RETURN_IF_HIP_ERROR(hipMemcpy(result, workspace, sizeof(Tr), hipMemcpyDeviceToHost));
-        }
-        else
-        {
-            // If FINALIZE is not trivial and kernel part2 was not called, then
-            // workspace[0] needs to be finalized on host.
-            To res;
-            RETURN_IF_HIP_ERROR(hipMemcpy(&res, workspace, sizeof(To), hipMemcpyDeviceToHost));
-            *result = FINALIZE{}(res);
-        }
+        // The result is at the beginning of workspace[0], and is copied through the
+        // handle's pinned buffers, possibly completing after return.
+        return handle->copy_result_to_host(result, workspace, sizeof(Tr));
     }
 
     return rocblas_status_success;
@@ -50,9 +50,13 @@
 //
 // As you may see, if there is a mechanism to synchronize all the thread blocks
 // after local index is obtained in kernel 1 (without ending the kernel), then
-// Kernel 2's computation can be merged into Kernel 1. One such mechanism is called
-// atomic operation. However, atomic operation is new and is not used in rocBLAS
-// yet. rocBLAS still use the classic standard parallel reduction right now.
+// Kernel 2's computation can be merged into Kernel 1. One such mechanism is an
+// atomic counter of finished blocks: the block which finishes last sees that all
+// other partial results have been written, and reduces them as kernel 2 would.
+// This saves the latency of the second launch, which dominates for small and
+// medium vectors. It is used unless the handle's atomics mode forbids atomics,
+// and since the last block reduces the partial results in block order, the
+// result is the same either way.
 
 // Recursively compute reduction
 template <rocblas_int k, typename REDUCE, typename T>
@@ -220,6 +224,71 @@ size_t rocblas_reduction_kernel_workspace_size(rocblas_int      n,
     }
 }
 
+// Reduces the elements of block hipBlockIdx_x of x_i, with i = hipBlockIdx_y, into tmp[0]
+template <rocblas_int NB, typename FETCH, typename REDUCE, typename TPtrX, typename To>
+__forceinline__ __device__ void rocblas_reduction_strided_batched_block(rocblas_int    n,
+                                                                        TPtrX          xvec,
+                                                                        rocblas_int    shiftx,
+                                                                        rocblas_int    incx,
+                                                                        rocblas_stride stridex,
+                                                                        To*            tmp)
+{
+    ptrdiff_t tx  = hipThreadIdx_x;
+    ptrdiff_t tid = hipBlockIdx_x * hipBlockDim_x + tx;
+
+    const auto* x = load_ptr_batch(xvec, hipBlockIdx_y, shiftx, stridex);
+
+    // bound
+    if(tid < n)
+        tmp[tx] = FETCH{}(x[tid * incx], tid);
+    else
+        tmp[tx] = rocblas_default_value<To>{}(); // pad with default value
+
+    rocblas_reduction<NB, REDUCE>(tx, tmp);
+}
+
+// Reduces the nblocks partial results in work, in order, and stores the finalized result
+template <rocblas_int NB, typename REDUCE, typename FINALIZE, typename To, typename Tr>
+__forceinline__ __device__ void rocblas_reduction_strided_batched_finish(rocblas_int nblocks,
+                                                                         const To*   work,
+                                                                         Tr*         result,
+                                                                         To*         tmp)
+{
+    rocblas_int tx = hipThreadIdx_x;
+
+    if(tx < nblocks)
+    {
+        tmp[tx] = work[tx];
+
+        // bound, loop
+        for(rocblas_int i = tx + NB; i < nblocks; i += NB)
+            REDUCE{}(tmp[tx], work[i]);
+    }
+    else
+    { // pad with default value
+        tmp[tx] = rocblas_default_value<To>{}();
+    }
+
+    if(nblocks < 32)
+    {
+        // no need parallel reduction
+        __syncthreads();
+
+        if(tx == 0)
+            for(rocblas_int i = 1; i < nblocks; i++)
+                REDUCE{}(tmp[0], tmp[i]);
+    }
+    else
+    {
+        // parallel reduction
+        rocblas_reduction<NB, REDUCE>(tx, tmp);
+    }
+
+    // Store result on device or in workspace
+    if(tx == 0)
+        *result = Tr(FINALIZE{}(tmp[0]));
+}
+
 // kernel 1 writes partial results per thread block in workspace; number of partial results is
 // blocks
 template <rocblas_int NB,
@@ -237,21 +306,11 @@ ROCBLAS_KERNEL void
                                                    rocblas_stride stridex,
                                                    To*            workspace)
 {
-    ptrdiff_t     tx  = hipThreadIdx_x;
-    ptrdiff_t     tid = hipBlockIdx_x * hipBlockDim_x + tx;
     __shared__ To tmp[NB];
 
-    const auto* x = load_ptr_batch(xvec, hipBlockIdx_y, shiftx, stridex);
-
-    // bound
-    if(tid < n)
-        tmp[tx] = FETCH{}(x[tid * incx], tid);
-    else
-        tmp[tx] = rocblas_default_value<To>{}(); // pad with default value
-
-    rocblas_reduction<NB, REDUCE>(tx, tmp);
+    rocblas_reduction_strided_batched_block<NB, FETCH, REDUCE>(n, xvec, shiftx, incx, stridex, tmp);
 
-    if(tx == 0)
+    if(hipThreadIdx_x == 0)
         workspace[hipBlockIdx_y * nblocks + hipBlockIdx_x] = tmp[0];
 }
 
@@ -267,41 +326,72 @@ __attribute__((amdgpu_flat_work_group_size((NB < 128) ? NB : 128, (NB > 256) ? N
 ROCBLAS_KERNEL void
     rocblas_reduction_strided_batched_kernel_part2(rocblas_int nblocks, To* workspace, Tr* result)
 {
-    rocblas_int   tx = hipThreadIdx_x;
     __shared__ To tmp[NB];
 
-    if(tx < nblocks)
-    {
-        To* work = workspace + hipBlockIdx_y * nblocks;
-        tmp[tx]  = work[tx];
+    rocblas_reduction_strided_batched_finish<NB, REDUCE, FINALIZE>(
+        nblocks, workspace + hipBlockIdx_y * nblocks, result + hipBlockIdx_y, tmp);
+}
 
-        // bound, loop
-        for(rocblas_int i = tx + NB; i < nblocks; i += NB)
-            REDUCE{}(tmp[tx], work[i]);
-    }
-    else
-    { // pad with default value
-        tmp[tx] = rocblas_default_value<To>{}();
-    }
+// Single-launch reduction: kernel 1, after which the last block of each batch to finish,
+// found by counting finished blocks in counters[hipBlockIdx_y], does the work of kernel 2.
+// It reduces the partial results in block order, as kernel 2 does, so the result does not
+// depend on the order in which blocks finish. It leaves the counter zero for the next launch.
+// With one block, counters are not used.
+template <rocblas_int NB,
+          typename FETCH,
+          typename REDUCE   = rocblas_reduce_sum,
+          typename FINALIZE = rocblas_finalize_identity,
+          typename TPtrX,
+          typename To,
+          typename Tr>
+__attribute__((amdgpu_flat_work_group_size((NB < 128) ? NB : 128, (NB > 256) ? NB : 256)))
+ROCBLAS_KERNEL void
+    rocblas_reduction_strided_batched_kernel_single(rocblas_int    n,
+                                                    rocblas_int    nblocks,
+                                                    TPtrX          xvec,
+                                                    rocblas_int    shiftx,
+                                                    rocblas_int    incx,
+                                                    rocblas_stride stridex,
+                                                    To*            workspace,
+                                                    Tr*            result,
+                                                    rocblas_int*   counters)
+{
+    __shared__ To   tmp[NB];
+    __shared__ bool last;
 
-    if(nblocks < 32)
-    {
-        // no need parallel reduction
-        __syncthreads();
+    rocblas_int tx = hipThreadIdx_x;
 
+    rocblas_reduction_strided_batched_block<NB, FETCH, REDUCE>(n, xvec, shiftx, incx, stridex, tmp);
+
+    if(nblocks == 1)
+    {
         if(tx == 0)
-            for(rocblas_int i = 1; i < nblocks; i++)
-                REDUCE{}(tmp[0], tmp[i]);
+            result[hipBlockIdx_y] = Tr(FINALIZE{}(tmp[0]));
+        return;
     }
-    else
+
+    To* work = workspace + hipBlockIdx_y * nblocks;
+    if(tx == 0)
     {
-        // parallel reduction
-        rocblas_reduction<NB, REDUCE>(tx, tmp);
+        work[hipBlockIdx_x] = tmp[0];
+
+        // Make the partial result visible to the last block before counting this block
+        __threadfence();
+        last = atomicAdd(&counters[hipBlockIdx_y], 1) == nblocks - 1;
     }
+    __syncthreads();
+
+    if(!last)
+        return;
+
+    // Make the partial results of the other blocks visible to this block
+    __threadfence();
+
+    rocblas_reduction_strided_batched_finish<NB, REDUCE, FINALIZE>(
+        nblocks, work, result + hipBlockIdx_y, tmp);
 
-    // Store result on device or in workspace
     if(tx == 0)
-        result[hipBlockIdx_y] = Tr(FINALIZE{}(tmp[0]));
+        counters[hipBlockIdx_y] = 0;
 }
 
 /*! \brief
@@ -309,9 +399,10 @@ ROCBLAS_KERNEL void
     \details
     rocblas_reduction_strided_batched_kernel computes a reduction over multiple vectors x_i
               Template parameters allow threads per block, data, and specific phase kernel overrides
-              At least two kernels are needed to finish the reduction
               kernel 1 write partial result per thread block in workspace, blocks partial results
               kernel 2 gathers all the partial result in workspace and finishes the final reduction.
+              Unless handle->atomics_mode is rocblas_atomics_not_allowed, both are done in one
+              launch, in which the last block of each batch to finish does the work of kernel 2.
     @param[in]
     handle    rocblas_handle.
               handle to the rocblas library context queue.
@@ -361,21 +452,58 @@ rocblas_status rocblas_reduction_strided_batched_kernel(rocblas_handle __restric
 {
     rocblas_int blocks = rocblas_reduction_kernel_block_count(n, NB);
 
-    hipLaunchKernelGGL((rocblas_reduction_strided_batched_kernel_part1<NB, FETCH, REDUCE>),
-                       dim3(blocks, batch_count),
-                       NB,
-                       0,
-                       handle->get_stream(),
-                       n,
-                       blocks,
-                       x,
-                       shiftx,
-                       incx,
-                       stridex,
-                       workspace);
-
-    if(handle->pointer_mode == rocblas_pointer_mode_device)
+    // If in host pointer mode, workspace is converted to Tr* and the result is
+    // placed after the partial results, and then copied from device to host. If To
+    // is a class type, it must be a standard layout type and its first member must
+    // be of type Tr.
+    static_assert(std::is_standard_layout<To>{}, "To must be a standard layout type");
+    Tr* output = handle->pointer_mode == rocblas_pointer_mode_device
+                     ? result
+                     : (Tr*)(workspace + size_t(batch_count) * blocks);
+
+    // The reduction takes one launch if there is one block per batch, or if atomics
+    // are allowed for counting finished blocks. Otherwise kernel 2 finishes it in a
+    // second launch. Both reduce the partial results in the same order.
+    rocblas_int* counters = nullptr;
+    if(blocks > 1 && handle->atomics_mode == rocblas_atomics_allowed)
+        counters = handle->get_reduction_counters(batch_count);
+
+    if(blocks == 1 || counters)
+    {
+        hipLaunchKernelGGL(
+            (rocblas_reduction_strided_batched_kernel_single<NB, FETCH, REDUCE, FINALIZE>),
+            dim3(blocks, batch_count),
+            NB,
+            0,
+            handle->get_stream(),
+            n,
+            blocks,
+            x,
+            shiftx,
+            incx,
+            stridex,
+            workspace,
+            output,
+            counters);
+
+        if(counters)
+            handle->record_reduction_counters();
+    }
+    else
     {
+        hipLaunchKernelGGL((rocblas_reduction_strided_batched_kernel_part1<NB, FETCH, REDUCE>),
+                           dim3(blocks, batch_count),
+                           NB,
+                           0,
+                           handle->get_stream(),
+                           n,
+                           blocks,
+                           x,
+                           shiftx,
+                           incx,
+                           stridex,
+                           workspace);
+
         hipLaunchKernelGGL((rocblas_reduction_strided_batched_kernel_part2<NB, REDUCE, FINALIZE>),
                            dim3(1, batch_count),
                            NB,
@@ -383,48 +511,13 @@ rocblas_status rocblas_reduction_strided_batched_kernel(rocblas_handle __restric
                            handle->get_stream(),
                            blocks,
                            workspace,
-                           result);
-    }
-    else
-    {
-        // If in host pointer mode, workspace is converted to Tr* and the result is
-        // placed there, and then copied from device to host. If To is a class type,
-        // it must be a standard layout type and its first member must be of type Tr.
-        static_assert(std::is_standard_layout<To>{}, "To must be a standard layout type");
-
-        bool reduceKernel = blocks > 1 || batch_count > 1;
-        if(reduceKernel)
-        {
-            hipLaunchKernelGGL(
-                (rocblas_reduction_strided_batched_kernel_part2<NB, REDUCE, FINALIZE>),
-                dim3(1, batch_count),
-                NB,
-                0,
-                handle->get_stream(),
-                blocks,
-                workspace,
-                (Tr*)(workspace + size_t(batch_count) * blocks));
-        }
-
-        if(std::is_same<FINALIZE, rocblas_finalize_identity>{} || reduceKernel)
-        {
-            // If FINALIZE is trivial or kernel part2 was called, result is in the
-            // beginning of workspace[0]+offset, and can be copied directly.
-            size_t offset = reduceKernel ? size_t(batch_count) * blocks : 0;
-            RETURN_IF_HIP_ERROR(hipMemcpy(
-                result, workspace + offset, batch_count * sizeof(Tr), hipMemcpyDeviceToHost));
-        }
-        else
-        {
-            // If FINALIZE is not trivial and kernel part2 was not called, then
-            // workspace[0] needs to be finalized on host.
-            auto res = std::make_unique<To[]>(batch_count);
-            RETURN_IF_HIP_ERROR(
-                hipMemcpy(&res[0], workspace, batch_count * sizeof(To), hipMemcpyDeviceToHost));
-            for(rocblas_int i = 0; i < batch_count; i++)
-                result[i] = Tr(FINALIZE{}(res[i]));
-        }
+                           output);
     }
 
+    // The result is copied through the handle's pinned buffers, possibly completing
+    // after return.
+    if(handle->pointer_mode != rocblas_pointer_mode_device)
+        return handle->copy_result_to_host(result, output, batch_count * sizeof(Tr));
+
     return rocblas_status_success;
 }
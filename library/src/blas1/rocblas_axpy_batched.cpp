@@ -35,6 +35,9 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(
+            handle, name, rocblas_perf_axpy_work(n, batch_count, sizeof(T), is_complex<T>));
+
         RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
 
         auto layer_mode     = handle->layer_mode;
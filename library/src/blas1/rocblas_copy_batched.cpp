@@ -34,6 +34,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(handle, rocblas_copy_batched_name<T>);
+
         RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
 
         auto layer_mode     = handle->layer_mode;
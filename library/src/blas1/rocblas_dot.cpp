@@ -47,6 +47,10 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(handle,
+                                rocblas_dot_name<CONJ, T>,
+                                rocblas_perf_dot_work(n, 1, sizeof(T), is_complex<T>, CONJ));
+
         size_t dev_bytes = rocblas_reduction_kernel_workspace_size<NB * WIN, T2>(n);
         if(handle->is_device_memory_size_query())
         {
@@ -130,19 +130,30 @@ __inline__ __device__ T rocblas_dot_block_reduce(T val)
     return val;
 }
 
-template <bool ONE_BLOCK, typename V, typename T>
-__inline__ __device__ void
-    rocblas_dot_save_sum(V sum, V* __restrict__ workspace, T* __restrict__ out)
+// Saves the sum of a block to result row of out, finalized, if the block is the only one of
+// its row, and otherwise as a partial result in workspace
+template <bool ONE_BLOCK, typename FINALIZE = rocblas_finalize_identity, typename V, typename T>
+__inline__ __device__ void rocblas_dot_save_sum(V sum,
+                                                V* __restrict__ workspace,
+                                                T* __restrict__ out,
+                                                rocblas_int row)
 {
     if(hipThreadIdx_x == 0)
     {
         if(ONE_BLOCK || hipGridDim_x == 1) // small N avoid second kernel
-            out[hipBlockIdx_y] = T(sum);
+            out[row] = T(FINALIZE{}(sum));
         else
-            workspace[hipBlockIdx_x + hipBlockIdx_y * hipGridDim_x] = sum;
+            workspace[hipBlockIdx_x + size_t(row) * hipGridDim_x] = sum;
     }
 }
 
+template <bool ONE_BLOCK, typename V, typename T>
+__inline__ __device__ void
+    rocblas_dot_save_sum(V sum, V* __restrict__ workspace, T* __restrict__ out)
+{
+    rocblas_dot_save_sum<ONE_BLOCK>(sum, workspace, out, hipBlockIdx_y);
+}
+
 template <bool        ONE_BLOCK,
           rocblas_int NB,
           rocblas_int WIN,
@@ -530,11 +541,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
         if(handle->pointer_mode != rocblas_pointer_mode_device)
         {
-            RETURN_IF_HIP_ERROR(hipMemcpyAsync(&results[0],
-                                               output,
-                                               sizeof(T) * batch_count,
-                                               hipMemcpyDeviceToHost,
-                                               handle->get_stream()));
+            RETURN_IF_ROCBLAS_ERROR(
+                handle->copy_result_to_host(&results[0], output, sizeof(T) * batch_count));
         }
     }
     else
@@ -629,11 +637,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
                                    workspace,
                                    output);
 
-            RETURN_IF_HIP_ERROR(hipMemcpyAsync(&results[0],
-                                               output,
-                                               sizeof(T) * batch_count,
-                                               hipMemcpyDeviceToHost,
-                                               handle->get_stream()));
+            RETURN_IF_ROCBLAS_ERROR(
+                handle->copy_result_to_host(&results[0], output, sizeof(T) * batch_count));
         }
     }
     return rocblas_status_success;
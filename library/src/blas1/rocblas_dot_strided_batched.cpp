@@ -58,6 +58,11 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(
+            handle,
+            rocblas_dot_strided_batched_name<CONJ, T>,
+            rocblas_perf_dot_work(n, batch_count, sizeof(T), is_complex<T>, CONJ));
+
         size_t dev_bytes = rocblas_reduction_kernel_workspace_size<NB * WIN, T2>(n, batch_count);
         if(handle->is_device_memory_size_query())
         {
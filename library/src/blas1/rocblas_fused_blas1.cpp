@@ -0,0 +1,176 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "rocblas_fused_blas1_impl.hpp"
+
+namespace
+{
+    // HIP support up to 1024 threads/work itemes per thread block/work group
+    // setting to 512 for gfx803.
+    constexpr int NB = 512;
+}
+
+/*
+ * ===========================================================================
+ *    C wrapper
+ * ===========================================================================
+ */
+
+extern "C" {
+
+#ifdef IMPL
+#error IMPL IS ALREADY DEFINED
+#endif
+
+#define IMPL(routine_name_, T_)                              \
+    rocblas_status routine_name_(rocblas_handle handle,      \
+                                 rocblas_int    n,           \
+                                 const T_*      alpha,       \
+                                 const T_*      x,           \
+                                 rocblas_int    incx,        \
+                                 const T_*      beta,        \
+                                 T_*            y,           \
+                                 rocblas_int    incy)        \
+    try                                                      \
+    {                                                        \
+        return rocblas_axpby_impl<NB, false>(handle,         \
+                                             n,              \
+                                             alpha,          \
+                                             x,              \
+                                             incx,           \
+                                             0,              \
+                                             beta,           \
+                                             y,              \
+                                             incy,           \
+                                             0,              \
+                                             1,              \
+                                             #routine_name_, \
+                                             "axpby");       \
+    }                                                        \
+    catch(...)                                               \
+    {                                                        \
+        return exception_to_rocblas_status();                \
+    }
+
+IMPL(rocblas_saxpby, float);
+IMPL(rocblas_daxpby, double);
+IMPL(rocblas_caxpby, rocblas_float_complex);
+IMPL(rocblas_zaxpby, rocblas_double_complex);
+
+#undef IMPL
+
+#define IMPL(routine_name_, T_)                                 \
+    rocblas_status routine_name_(rocblas_handle handle,         \
+                                 rocblas_int    n,              \
+                                 const T_*      alpha,          \
+                                 const T_*      x,              \
+                                 rocblas_int    incx,           \
+                                 T_*            y,              \
+                                 rocblas_int    incy,           \
+                                 const T_*      z,              \
+                                 rocblas_int    incz,           \
+                                 T_*            result)         \
+    try                                                         \
+    {                                                           \
+        return rocblas_axpy_dot_impl<NB, false>(handle,         \
+                                                n,              \
+                                                alpha,          \
+                                                x,              \
+                                                incx,           \
+                                                0,              \
+                                                y,              \
+                                                incy,           \
+                                                0,              \
+                                                z,              \
+                                                incz,           \
+                                                0,              \
+                                                1,              \
+                                                result,         \
+                                                #routine_name_, \
+                                                "axpy_dot");    \
+    }                                                           \
+    catch(...)                                                  \
+    {                                                           \
+        return exception_to_rocblas_status();                   \
+    }
+
+IMPL(rocblas_saxpy_dot, float);
+IMPL(rocblas_daxpy_dot, double);
+IMPL(rocblas_caxpy_dot, rocblas_float_complex);
+IMPL(rocblas_zaxpy_dot, rocblas_double_complex);
+
+#undef IMPL
+
+#define IMPL(routine_name_, T_)                                  \
+    rocblas_status routine_name_(rocblas_handle handle,          \
+                                 rocblas_int    n,               \
+                                 rocblas_int    k,               \
+                                 const T_*      x,               \
+                                 rocblas_int    incx,            \
+                                 const T_*      y,               \
+                                 rocblas_int    incy,            \
+                                 rocblas_int    ldy,             \
+                                 T_*            results)         \
+    try                                                          \
+    {                                                            \
+        return rocblas_multi_dot_impl<NB, false>(handle,         \
+                                                 n,              \
+                                                 k,              \
+                                                 x,              \
+                                                 incx,           \
+                                                 0,              \
+                                                 y,              \
+                                                 incy,           \
+                                                 ldy,            \
+                                                 0,              \
+                                                 1,              \
+                                                 results,        \
+                                                 #routine_name_, \
+                                                 "multi_dot");   \
+    }                                                            \
+    catch(...)                                                   \
+    {                                                            \
+        return exception_to_rocblas_status();                    \
+    }
+
+IMPL(rocblas_smulti_dot, float);
+IMPL(rocblas_dmulti_dot, double);
+IMPL(rocblas_cmulti_dot, rocblas_float_complex);
+IMPL(rocblas_zmulti_dot, rocblas_double_complex);
+
+#undef IMPL
+
+#define IMPL(routine_name_, T_, Tr_)                             \
+    rocblas_status routine_name_(rocblas_handle handle,          \
+                                 rocblas_int    n,               \
+                                 const T_*      alpha,           \
+                                 T_*            x,               \
+                                 rocblas_int    incx,            \
+                                 Tr_*           result)          \
+    try                                                          \
+    {                                                            \
+        return rocblas_scal_nrm2_impl<NB, false>(handle,         \
+                                                 n,              \
+                                                 alpha,          \
+                                                 x,              \
+                                                 incx,           \
+                                                 0,              \
+                                                 1,              \
+                                                 result,         \
+                                                 #routine_name_, \
+                                                 "scal_nrm2");   \
+    }                                                            \
+    catch(...)                                                   \
+    {                                                            \
+        return exception_to_rocblas_status();                    \
+    }
+
+IMPL(rocblas_sscal_nrm2, float, float);
+IMPL(rocblas_dscal_nrm2, double, double);
+IMPL(rocblas_cscal_nrm2, rocblas_float_complex, float);
+IMPL(rocblas_zscal_nrm2, rocblas_double_complex, double);
+
+#undef IMPL
+
+} // extern "C"
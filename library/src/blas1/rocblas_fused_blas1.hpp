@@ -0,0 +1,504 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "check_numerics_matrix.hpp"
+#include "check_numerics_vector.hpp"
+#include "handle.hpp"
+#include "rocblas_axpy.hpp"
+#include "rocblas_dot.hpp"
+#include "rocblas_nrm2.hpp"
+
+// Fused BLAS1 operations, for the inner loops of iterative solvers, which would
+// otherwise call axpy, scal, dot and nrm2 back to back on the same vectors:
+//
+//   axpby:     y := alpha * x + beta * y
+//   axpy_dot:  y := alpha * x + y, then result := y^H * z
+//   multi_dot: result[j] := x^H * y_j for j = 0, ..., k - 1, where y_j = y + j * ldy
+//   scal_nrm2: x := alpha * x, then result := ||x||_2
+//
+// Each reads and writes its vectors once, in a single pass, with the block reduction,
+// partial result saving and window size of dot. A second kernel reduces the partial results
+// with the reduction finish of nrm2 and the other reductions, unless one block covers the
+// whole vector. axpby with beta == 1 on host is axpy, and calls its template. The kernels
+// are shared by the non-batched, batched and strided batched functions, as U may be a
+// pointer or an array of pointers.
+
+// Reduce the n_sums partial results of row hipBlockIdx_x in order, and finalize. Rows are
+// in grid x, as there may be more than 65535 of them (batch_count * k for multi_dot).
+template <rocblas_int NB, typename FINALIZE, typename V, typename T>
+ROCBLAS_KERNEL __launch_bounds__(NB) void
+    rocblas_fused_blas1_reduce_kernel(rocblas_int n_sums, const V* __restrict__ in, T* out)
+{
+    __shared__ V tmp[NB];
+    rocblas_reduction_strided_batched_finish<NB, rocblas_reduce_sum, FINALIZE>(
+        n_sums, in + size_t(hipBlockIdx_x) * n_sums, out + hipBlockIdx_x, tmp);
+}
+
+template <rocblas_int NB, typename Ta, typename Tx, typename Ty>
+ROCBLAS_KERNEL __launch_bounds__(NB) void rocblas_axpby_kernel(rocblas_int    n,
+                                                               Ta             alpha_device_host,
+                                                               Tx             x,
+                                                               ptrdiff_t      shiftx,
+                                                               rocblas_int    incx,
+                                                               rocblas_stride stridex,
+                                                               Ta             beta_device_host,
+                                                               Ty             y,
+                                                               ptrdiff_t      shifty,
+                                                               rocblas_int    incy,
+                                                               rocblas_stride stridey)
+{
+    auto alpha = load_scalar(alpha_device_host);
+    auto beta  = load_scalar(beta_device_host);
+
+    ptrdiff_t tid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+    if(tid < n)
+    {
+        auto* ty = load_ptr_batch(y, hipBlockIdx_y, shifty + tid * incy, stridey);
+
+        // As in BLAS, x is not read when alpha is zero, nor y when beta is zero
+        decltype(alpha) value = 0;
+        if(alpha)
+            value = alpha * *load_ptr_batch(x, hipBlockIdx_y, shiftx + tid * incx, stridex);
+        if(beta)
+            value += beta * *ty;
+        *ty = value;
+    }
+}
+
+// When self, z is y and the dot product is y^H * y
+template <rocblas_int NB,
+          rocblas_int WIN,
+          typename Ta,
+          typename Tx,
+          typename Ty,
+          typename Tz,
+          typename T>
+ROCBLAS_KERNEL __launch_bounds__(NB) void rocblas_axpy_dot_kernel(rocblas_int    n,
+                                                                  Ta             alpha_device_host,
+                                                                  Tx             x,
+                                                                  ptrdiff_t      shiftx,
+                                                                  rocblas_int    incx,
+                                                                  rocblas_stride stridex,
+                                                                  Ty             y,
+                                                                  ptrdiff_t      shifty,
+                                                                  rocblas_int    incy,
+                                                                  rocblas_stride stridey,
+                                                                  Tz             z,
+                                                                  ptrdiff_t      shiftz,
+                                                                  rocblas_int    incz,
+                                                                  rocblas_stride stridez,
+                                                                  bool           self,
+                                                                  T* __restrict__ workspace,
+                                                                  T* results)
+{
+    auto        alpha = load_scalar(alpha_device_host);
+    const auto* xb    = load_ptr_batch(x, hipBlockIdx_y, shiftx, stridex);
+    auto*       yb    = load_ptr_batch(y, hipBlockIdx_y, shifty, stridey);
+    const auto* zb    = load_ptr_batch(z, hipBlockIdx_y, shiftz, stridez);
+
+    T sum = 0;
+
+    // sum WIN elements per thread
+    ptrdiff_t i   = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+    ptrdiff_t inc = hipBlockDim_x * hipGridDim_x;
+    for(rocblas_int j = 0; j < WIN && i < n; j++, i += inc)
+    {
+        T yi = yb[i * incy];
+        if(alpha)
+        {
+            yi += alpha * xb[i * incx];
+            yb[i * incy] = yi;
+        }
+        sum += conj(yi) * (self ? yi : T(zb[i * incz]));
+    }
+
+    sum = rocblas_dot_block_reduce<NB>(sum);
+    rocblas_dot_save_sum<false>(sum, workspace, results);
+}
+
+// x is read once for all k vectors y_j: each thread keeps its WIN elements of x in
+// registers. The partial results of batch b and vector j are in row b * k + j.
+template <rocblas_int NB, rocblas_int WIN, typename Tx, typename Ty, typename T>
+ROCBLAS_KERNEL __launch_bounds__(NB) void rocblas_multi_dot_kernel(rocblas_int    n,
+                                                                   rocblas_int    k,
+                                                                   Tx             x,
+                                                                   ptrdiff_t      shiftx,
+                                                                   rocblas_int    incx,
+                                                                   rocblas_stride stridex,
+                                                                   Ty             y,
+                                                                   ptrdiff_t      shifty,
+                                                                   rocblas_int    incy,
+                                                                   rocblas_stride ldy,
+                                                                   rocblas_stride stridey,
+                                                                   T* __restrict__ workspace,
+                                                                   T* results)
+{
+    const auto* xb = load_ptr_batch(x, hipBlockIdx_y, shiftx, stridex);
+    const auto* yb = load_ptr_batch(y, hipBlockIdx_y, shifty, stridey);
+
+    ptrdiff_t i0  = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+    ptrdiff_t inc = hipBlockDim_x * hipGridDim_x;
+
+    T xv[WIN];
+#pragma unroll
+    for(rocblas_int w = 0; w < WIN; w++)
+    {
+        ptrdiff_t i = i0 + w * inc;
+        xv[w]       = i < n ? conj(T(xb[i * incx])) : T(0);
+    }
+
+    for(rocblas_int j = 0; j < k; j++)
+    {
+        const auto* yj  = yb + j * ldy;
+        T           sum = 0;
+#pragma unroll
+        for(rocblas_int w = 0; w < WIN; w++)
+        {
+            ptrdiff_t i = i0 + w * inc;
+            if(i < n)
+                sum += xv[w] * T(yj[i * incy]);
+        }
+
+        sum = rocblas_dot_block_reduce<NB>(sum);
+        rocblas_dot_save_sum<false>(sum, workspace, results, hipBlockIdx_y * k + j);
+    }
+}
+
+template <rocblas_int NB, rocblas_int WIN, typename Ta, typename Tx, typename Tr>
+ROCBLAS_KERNEL __launch_bounds__(NB) void rocblas_scal_nrm2_kernel(rocblas_int    n,
+                                                                   Ta             alpha_device_host,
+                                                                   Tx             x,
+                                                                   ptrdiff_t      shiftx,
+                                                                   rocblas_int    incx,
+                                                                   rocblas_stride stridex,
+                                                                   Tr* __restrict__ workspace,
+                                                                   Tr* results)
+{
+    auto  alpha = load_scalar(alpha_device_host);
+    auto* xb    = load_ptr_batch(x, hipBlockIdx_y, shiftx, stridex);
+
+    Tr sum = 0;
+
+    // sum WIN elements per thread
+    ptrdiff_t i   = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+    ptrdiff_t inc = hipBlockDim_x * hipGridDim_x;
+    for(rocblas_int j = 0; j < WIN && i < n; j++, i += inc)
+    {
+        auto xi      = alpha * xb[i * incx];
+        xb[i * incx] = xi;
+        sum += fetch_abs2(xi);
+    }
+
+    sum = rocblas_dot_block_reduce<NB>(sum);
+    rocblas_dot_save_sum<false, rocblas_finalize_nrm2>(sum, workspace, results, hipBlockIdx_y);
+}
+
+/*! \brief Size of the workspace of axpy_dot, multi_dot and scal_nrm2, for rows results
+    (batch_count, or batch_count * k for multi_dot) of type T */
+template <rocblas_int NB, typename T, typename Tw = T>
+size_t rocblas_fused_blas1_workspace_size(rocblas_int n, rocblas_int rows)
+{
+    return rocblas_reduction_kernel_workspace_size<NB * rocblas_dot_WIN<T>(), Tw>(n, rows);
+}
+
+// Finish a reduction of rows results whose kernel ran with blocks blocks per row: reduce the
+// partial results if there are several, and in host pointer mode copy the results to host.
+template <rocblas_int NB, typename FINALIZE, typename T>
+rocblas_status rocblas_fused_blas1_finish(rocblas_handle handle,
+                                          rocblas_int    blocks,
+                                          rocblas_int    rows,
+                                          T*             workspace,
+                                          T*             output,
+                                          T*             results)
+{
+    if(blocks > 1)
+        hipLaunchKernelGGL((rocblas_fused_blas1_reduce_kernel<NB, FINALIZE>),
+                           dim3(rows),
+                           NB,
+                           0,
+                           handle->get_stream(),
+                           blocks,
+                           workspace,
+                           output);
+
+    if(handle->pointer_mode == rocblas_pointer_mode_host)
+        return handle->copy_result_to_host(results, output, sizeof(T) * rows);
+
+    return rocblas_status_success;
+}
+
+// Where a reduction writes its results: results in device pointer mode, or after the partial
+// results in the workspace in host pointer mode
+template <typename T>
+T* rocblas_fused_output(
+    rocblas_handle handle, rocblas_int blocks, rocblas_int rows, T* workspace, T* results)
+{
+    return handle->pointer_mode == rocblas_pointer_mode_device
+               ? results
+               : workspace + size_t(rows) * blocks;
+}
+
+template <rocblas_int NB, typename Ta, typename Tx, typename Ty>
+rocblas_status rocblas_internal_axpby_template(rocblas_handle handle,
+                                               rocblas_int    n,
+                                               const Ta*      alpha,
+                                               Tx             x,
+                                               ptrdiff_t      offsetx,
+                                               rocblas_int    incx,
+                                               rocblas_stride stridex,
+                                               const Ta*      beta,
+                                               Ty             y,
+                                               ptrdiff_t      offsety,
+                                               rocblas_int    incy,
+                                               rocblas_stride stridey,
+                                               rocblas_int    batch_count)
+{
+    if(n <= 0 || batch_count <= 0)
+        return rocblas_status_success;
+
+    // y := alpha * x + y, with the kernels of axpy
+    if(handle->pointer_mode == rocblas_pointer_mode_host && *beta == Ta(1))
+        return rocblas_internal_axpy_template<NB, Ta>(handle,
+                                                      n,
+                                                      alpha,
+                                                      0,
+                                                      x,
+                                                      offsetx,
+                                                      incx,
+                                                      stridex,
+                                                      y,
+                                                      offsety,
+                                                      incy,
+                                                      stridey,
+                                                      batch_count);
+
+    // in case of negative inc shift pointer to end of data for negative indexing tid*inc
+    ptrdiff_t shiftx = incx < 0 ? offsetx - ptrdiff_t(incx) * (n - 1) : offsetx;
+    ptrdiff_t shifty = incy < 0 ? offsety - ptrdiff_t(incy) * (n - 1) : offsety;
+
+    dim3 grid((n - 1) / NB + 1, batch_count);
+    dim3 threads(NB);
+
+    if(handle->pointer_mode == rocblas_pointer_mode_device)
+        hipLaunchKernelGGL((rocblas_axpby_kernel<NB>),
+                           grid,
+                           threads,
+                           0,
+                           handle->get_stream(),
+                           n,
+                           alpha,
+                           x,
+                           shiftx,
+                           incx,
+                           stridex,
+                           beta,
+                           y,
+                           shifty,
+                           incy,
+                           stridey);
+    else
+        hipLaunchKernelGGL((rocblas_axpby_kernel<NB>),
+                           grid,
+                           threads,
+                           0,
+                           handle->get_stream(),
+                           n,
+                           *alpha,
+                           x,
+                           shiftx,
+                           incx,
+                           stridex,
+                           *beta,
+                           y,
+                           shifty,
+                           incy,
+                           stridey);
+
+    return rocblas_status_success;
+}
+
+template <rocblas_int NB, typename T, typename Tx, typename Ty, typename Tz>
+rocblas_status rocblas_internal_axpy_dot_template(rocblas_handle handle,
+                                                  rocblas_int    n,
+                                                  const T*       alpha,
+                                                  Tx             x,
+                                                  ptrdiff_t      offsetx,
+                                                  rocblas_int    incx,
+                                                  rocblas_stride stridex,
+                                                  Ty             y,
+                                                  ptrdiff_t      offsety,
+                                                  rocblas_int    incy,
+                                                  rocblas_stride stridey,
+                                                  Tz             z,
+                                                  ptrdiff_t      offsetz,
+                                                  rocblas_int    incz,
+                                                  rocblas_stride stridez,
+                                                  rocblas_int    batch_count,
+                                                  T*             results,
+                                                  T*             workspace)
+{
+    static constexpr rocblas_int WIN = rocblas_dot_WIN<T>();
+
+    ptrdiff_t shiftx = incx < 0 ? offsetx - ptrdiff_t(incx) * (n - 1) : offsetx;
+    ptrdiff_t shifty = incy < 0 ? offsety - ptrdiff_t(incy) * (n - 1) : offsety;
+    ptrdiff_t shiftz = incz < 0 ? offsetz - ptrdiff_t(incz) * (n - 1) : offsetz;
+
+    rocblas_int blocks = rocblas_reduction_kernel_block_count(n, NB * WIN);
+    T*          output = rocblas_fused_output(handle, blocks, batch_count, workspace, results);
+    bool        self   = (void*)z == (void*)y && offsetz == offsety && incz == incy
+                  && stridez == stridey;
+
+    if(handle->pointer_mode == rocblas_pointer_mode_device)
+        hipLaunchKernelGGL((rocblas_axpy_dot_kernel<NB, WIN>),
+                           dim3(blocks, batch_count),
+                           NB,
+                           0,
+                           handle->get_stream(),
+                           n,
+                           alpha,
+                           x,
+                           shiftx,
+                           incx,
+                           stridex,
+                           y,
+                           shifty,
+                           incy,
+                           stridey,
+                           z,
+                           shiftz,
+                           incz,
+                           stridez,
+                           self,
+                           workspace,
+                           output);
+    else
+        hipLaunchKernelGGL((rocblas_axpy_dot_kernel<NB, WIN>),
+                           dim3(blocks, batch_count),
+                           NB,
+                           0,
+                           handle->get_stream(),
+                           n,
+                           *alpha,
+                           x,
+                           shiftx,
+                           incx,
+                           stridex,
+                           y,
+                           shifty,
+                           incy,
+                           stridey,
+                           z,
+                           shiftz,
+                           incz,
+                           stridez,
+                           self,
+                           workspace,
+                           output);
+
+    return rocblas_fused_blas1_finish<NB, rocblas_finalize_identity>(
+        handle, blocks, batch_count, workspace, output, results);
+}
+
+template <rocblas_int NB, typename T, typename Tx, typename Ty>
+rocblas_status rocblas_internal_multi_dot_template(rocblas_handle handle,
+                                                   rocblas_int    n,
+                                                   rocblas_int    k,
+                                                   Tx             x,
+                                                   ptrdiff_t      offsetx,
+                                                   rocblas_int    incx,
+                                                   rocblas_stride stridex,
+                                                   Ty             y,
+                                                   ptrdiff_t      offsety,
+                                                   rocblas_int    incy,
+                                                   rocblas_stride ldy,
+                                                   rocblas_stride stridey,
+                                                   rocblas_int    batch_count,
+                                                   T*             results,
+                                                   T*             workspace)
+{
+    static constexpr rocblas_int WIN = rocblas_dot_WIN<T>();
+
+    ptrdiff_t shiftx = incx < 0 ? offsetx - ptrdiff_t(incx) * (n - 1) : offsetx;
+    ptrdiff_t shifty = incy < 0 ? offsety - ptrdiff_t(incy) * (n - 1) : offsety;
+
+    rocblas_int blocks = rocblas_reduction_kernel_block_count(n, NB * WIN);
+    rocblas_int rows   = batch_count * k;
+    T*          output = rocblas_fused_output(handle, blocks, rows, workspace, results);
+
+    hipLaunchKernelGGL((rocblas_multi_dot_kernel<NB, WIN>),
+                       dim3(blocks, batch_count),
+                       NB,
+                       0,
+                       handle->get_stream(),
+                       n,
+                       k,
+                       x,
+                       shiftx,
+                       incx,
+                       stridex,
+                       y,
+                       shifty,
+                       incy,
+                       ldy,
+                       stridey,
+                       workspace,
+                       output);
+
+    return rocblas_fused_blas1_finish<NB, rocblas_finalize_identity>(
+        handle, blocks, rows, workspace, output, results);
+}
+
+template <rocblas_int NB, typename T, typename Tx, typename Tr>
+rocblas_status rocblas_internal_scal_nrm2_template(rocblas_handle handle,
+                                                   rocblas_int    n,
+                                                   const T*       alpha,
+                                                   Tx             x,
+                                                   ptrdiff_t      offsetx,
+                                                   rocblas_int    incx,
+                                                   rocblas_stride stridex,
+                                                   rocblas_int    batch_count,
+                                                   Tr*            results,
+                                                   Tr*            workspace)
+{
+    static constexpr rocblas_int WIN = rocblas_dot_WIN<T>();
+
+    ptrdiff_t shiftx = incx < 0 ? offsetx - ptrdiff_t(incx) * (n - 1) : offsetx;
+
+    rocblas_int blocks = rocblas_reduction_kernel_block_count(n, NB * WIN);
+    Tr*         output = rocblas_fused_output(handle, blocks, batch_count, workspace, results);
+
+    if(handle->pointer_mode == rocblas_pointer_mode_device)
+        hipLaunchKernelGGL((rocblas_scal_nrm2_kernel<NB, WIN>),
+                           dim3(blocks, batch_count),
+                           NB,
+                           0,
+                           handle->get_stream(),
+                           n,
+                           alpha,
+                           x,
+                           shiftx,
+                           incx,
+                           stridex,
+                           workspace,
+                           output);
+    else
+        hipLaunchKernelGGL((rocblas_scal_nrm2_kernel<NB, WIN>),
+                           dim3(blocks, batch_count),
+                           NB,
+                           0,
+                           handle->get_stream(),
+                           n,
+                           *alpha,
+                           x,
+                           shiftx,
+                           incx,
+                           stridex,
+                           workspace,
+                           output);
+
+    return rocblas_fused_blas1_finish<NB, rocblas_finalize_nrm2>(
+        handle, blocks, batch_count, workspace, output, results);
+}
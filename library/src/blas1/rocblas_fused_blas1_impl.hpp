@@ -0,0 +1,659 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "logging.hpp"
+#include "rocblas_fused_blas1.hpp"
+
+// Implementations of the fused BLAS1 functions, shared by the non-batched, batched and
+// strided batched C wrappers. ISBATCHED is false for the non-batched functions, which
+// pass a batch_count of 1 and strides of 0; the batched functions are told apart from
+// the strided batched ones by their arrays of pointers.
+
+template <typename U>
+constexpr bool rocblas_fused_is_strided = !std::is_pointer<std::remove_pointer_t<U>>{};
+
+template <rocblas_int NB, bool ISBATCHED, typename T, typename Tx, typename Ty>
+rocblas_status rocblas_axpby_impl(rocblas_handle handle,
+                                  rocblas_int    n,
+                                  const T*       alpha,
+                                  Tx             x,
+                                  rocblas_int    incx,
+                                  rocblas_stride stridex,
+                                  const T*       beta,
+                                  Ty             y,
+                                  rocblas_int    incy,
+                                  rocblas_stride stridey,
+                                  rocblas_int    batch_count,
+                                  const char*    name,
+                                  const char*    bench_name)
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    rocblas_perf_scope perf(handle, name);
+
+    RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
+
+    constexpr bool STRIDED        = ISBATCHED && rocblas_fused_is_strided<Tx>;
+    auto           layer_mode     = handle->layer_mode;
+    auto           check_numerics = handle->check_numerics;
+
+    if(layer_mode & rocblas_layer_mode_log_trace)
+    {
+        if(STRIDED)
+            log_trace(handle,
+                      name,
+                      n,
+                      LOG_TRACE_SCALAR_VALUE(handle, alpha),
+                      x,
+                      incx,
+                      stridex,
+                      LOG_TRACE_SCALAR_VALUE(handle, beta),
+                      y,
+                      incy,
+                      stridey,
+                      batch_count);
+        else if(ISBATCHED)
+            log_trace(handle,
+                      name,
+                      n,
+                      LOG_TRACE_SCALAR_VALUE(handle, alpha),
+                      x,
+                      incx,
+                      LOG_TRACE_SCALAR_VALUE(handle, beta),
+                      y,
+                      incy,
+                      batch_count);
+        else
+            log_trace(handle,
+                      name,
+                      n,
+                      LOG_TRACE_SCALAR_VALUE(handle, alpha),
+                      x,
+                      incx,
+                      LOG_TRACE_SCALAR_VALUE(handle, beta),
+                      y,
+                      incy);
+    }
+
+    if(layer_mode & rocblas_layer_mode_log_bench)
+        log_bench(handle,
+                  "./rocblas-bench -f",
+                  bench_name,
+                  "-r",
+                  rocblas_precision_string<T>,
+                  "-n",
+                  n,
+                  LOG_BENCH_SCALAR_VALUE(handle, alpha),
+                  LOG_BENCH_SCALAR_VALUE(handle, beta),
+                  "--incx",
+                  incx,
+                  "--incy",
+                  incy,
+                  "--stride_x",
+                  stridex,
+                  "--stride_y",
+                  stridey,
+                  "--batch_count",
+                  batch_count);
+
+    if(layer_mode & rocblas_layer_mode_log_profile)
+        log_profile(handle,
+                    name,
+                    "N",
+                    n,
+                    "incx",
+                    incx,
+                    "stride_x",
+                    stridex,
+                    "incy",
+                    incy,
+                    "stride_y",
+                    stridey,
+                    "batch_count",
+                    batch_count);
+
+    if(n <= 0 || batch_count <= 0) // Quick return if possible. Not Argument error
+        return rocblas_status_success;
+
+    if(!alpha || !beta)
+        return rocblas_status_invalid_pointer;
+
+    if(handle->pointer_mode == rocblas_pointer_mode_host && *alpha == T(0) && *beta == T(1))
+        return rocblas_status_success;
+
+    if(!x || !y)
+        return rocblas_status_invalid_pointer;
+
+    if(check_numerics)
+    {
+        rocblas_status status = rocblas_axpy_check_numerics(name,
+                                                            handle,
+                                                            n,
+                                                            x,
+                                                            0,
+                                                            incx,
+                                                            stridex,
+                                                            y,
+                                                            0,
+                                                            incy,
+                                                            stridey,
+                                                            batch_count,
+                                                            check_numerics,
+                                                            true);
+        if(status != rocblas_status_success)
+            return status;
+    }
+
+    rocblas_status status = rocblas_internal_axpby_template<NB>(
+        handle, n, alpha, x, 0, incx, stridex, beta, y, 0, incy, stridey, batch_count);
+    if(status != rocblas_status_success)
+        return status;
+
+    if(check_numerics)
+        status = rocblas_axpy_check_numerics(name,
+                                             handle,
+                                             n,
+                                             x,
+                                             0,
+                                             incx,
+                                             stridex,
+                                             y,
+                                             0,
+                                             incy,
+                                             stridey,
+                                             batch_count,
+                                             check_numerics,
+                                             false);
+    return status;
+}
+
+template <rocblas_int NB, bool ISBATCHED, typename T, typename Tx, typename Ty, typename Tz>
+rocblas_status rocblas_axpy_dot_impl(rocblas_handle handle,
+                                     rocblas_int    n,
+                                     const T*       alpha,
+                                     Tx             x,
+                                     rocblas_int    incx,
+                                     rocblas_stride stridex,
+                                     Ty             y,
+                                     rocblas_int    incy,
+                                     rocblas_stride stridey,
+                                     Tz             z,
+                                     rocblas_int    incz,
+                                     rocblas_stride stridez,
+                                     rocblas_int    batch_count,
+                                     T*             results,
+                                     const char*    name,
+                                     const char*    bench_name)
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    rocblas_perf_scope perf(handle, name);
+
+    size_t dev_bytes = rocblas_fused_blas1_workspace_size<NB, T>(n, batch_count);
+    if(handle->is_device_memory_size_query())
+    {
+        if(n <= 0 || batch_count <= 0)
+            return rocblas_status_size_unchanged;
+        else
+            return handle->set_optimal_device_memory_size(dev_bytes);
+    }
+
+    constexpr bool STRIDED        = ISBATCHED && rocblas_fused_is_strided<Tx>;
+    auto           layer_mode     = handle->layer_mode;
+    auto           check_numerics = handle->check_numerics;
+
+    if(layer_mode & rocblas_layer_mode_log_trace)
+    {
+        if(STRIDED)
+            log_trace(handle,
+                      name,
+                      n,
+                      LOG_TRACE_SCALAR_VALUE(handle, alpha),
+                      x,
+                      incx,
+                      stridex,
+                      y,
+                      incy,
+                      stridey,
+                      z,
+                      incz,
+                      stridez,
+                      batch_count);
+        else if(ISBATCHED)
+            log_trace(handle,
+                      name,
+                      n,
+                      LOG_TRACE_SCALAR_VALUE(handle, alpha),
+                      x,
+                      incx,
+                      y,
+                      incy,
+                      z,
+                      incz,
+                      batch_count);
+        else
+            log_trace(
+                handle, name, n, LOG_TRACE_SCALAR_VALUE(handle, alpha), x, incx, y, incy, z, incz);
+    }
+
+    if(layer_mode & rocblas_layer_mode_log_bench)
+        log_bench(handle,
+                  "./rocblas-bench -f",
+                  bench_name,
+                  "-r",
+                  rocblas_precision_string<T>,
+                  "-n",
+                  n,
+                  LOG_BENCH_SCALAR_VALUE(handle, alpha),
+                  "--incx",
+                  incx,
+                  "--incy",
+                  incy,
+                  "--incz",
+                  incz,
+                  "--stride_x",
+                  stridex,
+                  "--stride_y",
+                  stridey,
+                  "--stride_z",
+                  stridez,
+                  "--batch_count",
+                  batch_count);
+
+    if(layer_mode & rocblas_layer_mode_log_profile)
+        log_profile(handle,
+                    name,
+                    "N",
+                    n,
+                    "incx",
+                    incx,
+                    "stride_x",
+                    stridex,
+                    "incy",
+                    incy,
+                    "stride_y",
+                    stridey,
+                    "incz",
+                    incz,
+                    "stride_z",
+                    stridez,
+                    "batch_count",
+                    batch_count);
+
+    // Quick return if possible.
+    if(batch_count <= 0)
+        return rocblas_status_success;
+
+    if(!results)
+        return rocblas_status_invalid_pointer;
+
+    if(n <= 0)
+    {
+        if(handle->pointer_mode == rocblas_pointer_mode_device)
+            RETURN_IF_HIP_ERROR(
+                hipMemsetAsync(results, 0, sizeof(T) * batch_count, handle->get_stream()));
+        else
+            memset(results, 0, sizeof(T) * batch_count);
+        return rocblas_status_success;
+    }
+
+    if(!alpha || !x || !y || !z)
+        return rocblas_status_invalid_pointer;
+
+    auto w_mem = handle->device_malloc(dev_bytes);
+    if(!w_mem)
+        return rocblas_status_memory_error;
+
+    if(check_numerics)
+    {
+        rocblas_status status = rocblas_axpy_check_numerics(name,
+                                                            handle,
+                                                            n,
+                                                            x,
+                                                            0,
+                                                            incx,
+                                                            stridex,
+                                                            y,
+                                                            0,
+                                                            incy,
+                                                            stridey,
+                                                            batch_count,
+                                                            check_numerics,
+                                                            true);
+        if(status == rocblas_status_success)
+            status = rocblas_internal_check_numerics_vector_template(
+                name, handle, n, z, 0, incz, stridez, batch_count, check_numerics, true);
+        if(status != rocblas_status_success)
+            return status;
+    }
+
+    rocblas_status status = rocblas_internal_axpy_dot_template<NB>(handle,
+                                                                   n,
+                                                                   alpha,
+                                                                   x,
+                                                                   0,
+                                                                   incx,
+                                                                   stridex,
+                                                                   y,
+                                                                   0,
+                                                                   incy,
+                                                                   stridey,
+                                                                   z,
+                                                                   0,
+                                                                   incz,
+                                                                   stridez,
+                                                                   batch_count,
+                                                                   results,
+                                                                   (T*)w_mem);
+    if(status != rocblas_status_success)
+        return status;
+
+    if(check_numerics)
+        status = rocblas_axpy_check_numerics(name,
+                                             handle,
+                                             n,
+                                             x,
+                                             0,
+                                             incx,
+                                             stridex,
+                                             y,
+                                             0,
+                                             incy,
+                                             stridey,
+                                             batch_count,
+                                             check_numerics,
+                                             false);
+    return status;
+}
+
+template <rocblas_int NB, bool ISBATCHED, typename T, typename Tx, typename Ty>
+rocblas_status rocblas_multi_dot_impl(rocblas_handle handle,
+                                      rocblas_int    n,
+                                      rocblas_int    k,
+                                      Tx             x,
+                                      rocblas_int    incx,
+                                      rocblas_stride stridex,
+                                      Ty             y,
+                                      rocblas_int    incy,
+                                      rocblas_int    ldy,
+                                      rocblas_stride stridey,
+                                      rocblas_int    batch_count,
+                                      T*             results,
+                                      const char*    name,
+                                      const char*    bench_name)
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    rocblas_perf_scope perf(handle, name);
+
+    size_t dev_bytes = rocblas_fused_blas1_workspace_size<NB, T>(n, batch_count * k);
+    if(handle->is_device_memory_size_query())
+    {
+        if(n <= 0 || k <= 0 || batch_count <= 0)
+            return rocblas_status_size_unchanged;
+        else
+            return handle->set_optimal_device_memory_size(dev_bytes);
+    }
+
+    constexpr bool STRIDED        = ISBATCHED && rocblas_fused_is_strided<Tx>;
+    auto           layer_mode     = handle->layer_mode;
+    auto           check_numerics = handle->check_numerics;
+
+    if(layer_mode & rocblas_layer_mode_log_trace)
+    {
+        if(STRIDED)
+            log_trace(handle, name, n, k, x, incx, stridex, y, incy, ldy, stridey, batch_count);
+        else if(ISBATCHED)
+            log_trace(handle, name, n, k, x, incx, y, incy, ldy, batch_count);
+        else
+            log_trace(handle, name, n, k, x, incx, y, incy, ldy);
+    }
+
+    if(layer_mode & rocblas_layer_mode_log_bench)
+        log_bench(handle,
+                  "./rocblas-bench -f",
+                  bench_name,
+                  "-r",
+                  rocblas_precision_string<T>,
+                  "-n",
+                  n,
+                  "-k",
+                  k,
+                  "--incx",
+                  incx,
+                  "--incy",
+                  incy,
+                  "--lda",
+                  ldy,
+                  "--stride_x",
+                  stridex,
+                  "--stride_y",
+                  stridey,
+                  "--batch_count",
+                  batch_count);
+
+    if(layer_mode & rocblas_layer_mode_log_profile)
+        log_profile(handle,
+                    name,
+                    "N",
+                    n,
+                    "K",
+                    k,
+                    "incx",
+                    incx,
+                    "stride_x",
+                    stridex,
+                    "incy",
+                    incy,
+                    "ldy",
+                    ldy,
+                    "stride_y",
+                    stridey,
+                    "batch_count",
+                    batch_count);
+
+    if(k < 0)
+        return rocblas_status_invalid_size;
+
+    // Quick return if possible.
+    if(k == 0 || batch_count <= 0)
+        return rocblas_status_success;
+
+    if(!results)
+        return rocblas_status_invalid_pointer;
+
+    size_t result_bytes = sizeof(T) * k * batch_count;
+    if(n <= 0)
+    {
+        if(handle->pointer_mode == rocblas_pointer_mode_device)
+            RETURN_IF_HIP_ERROR(hipMemsetAsync(results, 0, result_bytes, handle->get_stream()));
+        else
+            memset(results, 0, result_bytes);
+        return rocblas_status_success;
+    }
+
+    if(k > 1 && ldy < n * int64_t(std::abs(incy)))
+        return rocblas_status_invalid_size;
+
+    if(!x || !y)
+        return rocblas_status_invalid_pointer;
+
+    auto w_mem = handle->device_malloc(dev_bytes);
+    if(!w_mem)
+        return rocblas_status_memory_error;
+
+    if(check_numerics)
+    {
+        rocblas_status status = rocblas_internal_check_numerics_vector_template(
+            name, handle, n, x, 0, incx, stridex, batch_count, check_numerics, true);
+        if(status != rocblas_status_success)
+            return status;
+
+        // The offsets of the columns of y may not fit in rocblas_int, so y is checked as an
+        // n x k matrix, or else by columns only if their offsets fit, and otherwise by rows
+        if(incy == 1)
+            status = rocblas_internal_check_numerics_ge_matrix_template(name,
+                                                                        handle,
+                                                                        rocblas_operation_none,
+                                                                        n,
+                                                                        k,
+                                                                        y,
+                                                                        0,
+                                                                        ldy,
+                                                                        stridey,
+                                                                        batch_count,
+                                                                        check_numerics,
+                                                                        true);
+        else if((k - 1) * int64_t(ldy) <= std::numeric_limits<rocblas_int>::max())
+            for(rocblas_int j = 0; j < k && status == rocblas_status_success; j++)
+                status = rocblas_internal_check_numerics_vector_template(
+                    name, handle, n, y, j * ldy, incy, stridey, batch_count, check_numerics, true);
+        else
+            for(rocblas_int i = 0; i < n && status == rocblas_status_success; i++)
+                status = rocblas_internal_check_numerics_vector_template(name,
+                                                                         handle,
+                                                                         k,
+                                                                         y,
+                                                                         i * std::abs(incy),
+                                                                         ldy,
+                                                                         stridey,
+                                                                         batch_count,
+                                                                         check_numerics,
+                                                                         true);
+        if(status != rocblas_status_success)
+            return status;
+    }
+
+    return rocblas_internal_multi_dot_template<NB>(handle,
+                                                   n,
+                                                   k,
+                                                   x,
+                                                   0,
+                                                   incx,
+                                                   stridex,
+                                                   y,
+                                                   0,
+                                                   incy,
+                                                   ldy,
+                                                   stridey,
+                                                   batch_count,
+                                                   results,
+                                                   (T*)w_mem);
+}
+
+template <rocblas_int NB, bool ISBATCHED, typename T, typename Tx, typename Tr>
+rocblas_status rocblas_scal_nrm2_impl(rocblas_handle handle,
+                                      rocblas_int    n,
+                                      const T*       alpha,
+                                      Tx             x,
+                                      rocblas_int    incx,
+                                      rocblas_stride stridex,
+                                      rocblas_int    batch_count,
+                                      Tr*            results,
+                                      const char*    name,
+                                      const char*    bench_name)
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    rocblas_perf_scope perf(handle, name);
+
+    size_t dev_bytes = rocblas_fused_blas1_workspace_size<NB, T, Tr>(n, batch_count);
+    if(handle->is_device_memory_size_query())
+    {
+        if(n <= 0 || incx <= 0 || batch_count <= 0)
+            return rocblas_status_size_unchanged;
+        else
+            return handle->set_optimal_device_memory_size(dev_bytes);
+    }
+
+    constexpr bool STRIDED        = ISBATCHED && rocblas_fused_is_strided<Tx>;
+    auto           layer_mode     = handle->layer_mode;
+    auto           check_numerics = handle->check_numerics;
+
+    if(layer_mode & rocblas_layer_mode_log_trace)
+    {
+        if(STRIDED)
+            log_trace(handle,
+                      name,
+                      n,
+                      LOG_TRACE_SCALAR_VALUE(handle, alpha),
+                      x,
+                      incx,
+                      stridex,
+                      batch_count);
+        else if(ISBATCHED)
+            log_trace(handle, name, n, LOG_TRACE_SCALAR_VALUE(handle, alpha), x, incx, batch_count);
+        else
+            log_trace(handle, name, n, LOG_TRACE_SCALAR_VALUE(handle, alpha), x, incx);
+    }
+
+    if(layer_mode & rocblas_layer_mode_log_bench)
+        log_bench(handle,
+                  "./rocblas-bench -f",
+                  bench_name,
+                  "-r",
+                  rocblas_precision_string<T>,
+                  "-n",
+                  n,
+                  LOG_BENCH_SCALAR_VALUE(handle, alpha),
+                  "--incx",
+                  incx,
+                  "--stride_x",
+                  stridex,
+                  "--batch_count",
+                  batch_count);
+
+    if(layer_mode & rocblas_layer_mode_log_profile)
+        log_profile(
+            handle, name, "N", n, "incx", incx, "stride_x", stridex, "batch_count", batch_count);
+
+    // Quick return if possible. As for scal and nrm2, x is not scaled, and the norm is 0,
+    // when incx <= 0.
+    if(batch_count <= 0)
+        return rocblas_status_success;
+
+    if(!results)
+        return rocblas_status_invalid_pointer;
+
+    if(n <= 0 || incx <= 0)
+    {
+        if(handle->pointer_mode == rocblas_pointer_mode_device)
+            RETURN_IF_HIP_ERROR(
+                hipMemsetAsync(results, 0, sizeof(Tr) * batch_count, handle->get_stream()));
+        else
+            memset(results, 0, sizeof(Tr) * batch_count);
+        return rocblas_status_success;
+    }
+
+    if(!alpha || !x)
+        return rocblas_status_invalid_pointer;
+
+    auto w_mem = handle->device_malloc(dev_bytes);
+    if(!w_mem)
+        return rocblas_status_memory_error;
+
+    if(check_numerics)
+    {
+        rocblas_status status = rocblas_internal_check_numerics_vector_template(
+            name, handle, n, x, 0, incx, stridex, batch_count, check_numerics, true);
+        if(status != rocblas_status_success)
+            return status;
+    }
+
+    rocblas_status status = rocblas_internal_scal_nrm2_template<NB>(
+        handle, n, alpha, x, 0, incx, stridex, batch_count, results, (Tr*)w_mem);
+    if(status != rocblas_status_success)
+        return status;
+
+    if(check_numerics)
+        status = rocblas_internal_check_numerics_vector_template(
+            name, handle, n, x, 0, incx, stridex, batch_count, check_numerics, false);
+    return status;
+}
@@ -0,0 +1,188 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "rocblas_fused_blas1_impl.hpp"
+
+namespace
+{
+    // HIP support up to 1024 threads/work itemes per thread block/work group
+    // setting to 512 for gfx803.
+    constexpr int NB = 512;
+}
+
+/*
+ * ===========================================================================
+ *    C wrapper
+ * ===========================================================================
+ */
+
+extern "C" {
+
+#ifdef IMPL
+#error IMPL IS ALREADY DEFINED
+#endif
+
+#define IMPL(routine_name_, T_)                                       \
+    rocblas_status routine_name_(rocblas_handle handle,               \
+                                 rocblas_int    n,                    \
+                                 const T_*      alpha,                \
+                                 const T_*      x,                    \
+                                 rocblas_int    incx,                 \
+                                 rocblas_stride stridex,              \
+                                 const T_*      beta,                 \
+                                 T_*            y,                    \
+                                 rocblas_int    incy,                 \
+                                 rocblas_stride stridey,              \
+                                 rocblas_int    batch_count)          \
+    try                                                               \
+    {                                                                 \
+        return rocblas_axpby_impl<NB, true>(handle,                   \
+                                            n,                        \
+                                            alpha,                    \
+                                            x,                        \
+                                            incx,                     \
+                                            stridex,                  \
+                                            beta,                     \
+                                            y,                        \
+                                            incy,                     \
+                                            stridey,                  \
+                                            batch_count,              \
+                                            #routine_name_,           \
+                                            "axpby_strided_batched"); \
+    }                                                                 \
+    catch(...)                                                        \
+    {                                                                 \
+        return exception_to_rocblas_status();                         \
+    }
+
+IMPL(rocblas_saxpby_strided_batched, float);
+IMPL(rocblas_daxpby_strided_batched, double);
+IMPL(rocblas_caxpby_strided_batched, rocblas_float_complex);
+IMPL(rocblas_zaxpby_strided_batched, rocblas_double_complex);
+
+#undef IMPL
+
+#define IMPL(routine_name_, T_)                                             \
+    rocblas_status routine_name_(rocblas_handle handle,                     \
+                                 rocblas_int    n,                          \
+                                 const T_*      alpha,                      \
+                                 const T_*      x,                          \
+                                 rocblas_int    incx,                       \
+                                 rocblas_stride stridex,                    \
+                                 T_*            y,                          \
+                                 rocblas_int    incy,                       \
+                                 rocblas_stride stridey,                    \
+                                 const T_*      z,                          \
+                                 rocblas_int    incz,                       \
+                                 rocblas_stride stridez,                    \
+                                 rocblas_int    batch_count,                \
+                                 T_*            result)                     \
+    try                                                                     \
+    {                                                                       \
+        return rocblas_axpy_dot_impl<NB, true>(handle,                      \
+                                               n,                           \
+                                               alpha,                       \
+                                               x,                           \
+                                               incx,                        \
+                                               stridex,                     \
+                                               y,                           \
+                                               incy,                        \
+                                               stridey,                     \
+                                               z,                           \
+                                               incz,                        \
+                                               stridez,                     \
+                                               batch_count,                 \
+                                               result,                      \
+                                               #routine_name_,              \
+                                               "axpy_dot_strided_batched"); \
+    }                                                                       \
+    catch(...)                                                              \
+    {                                                                       \
+        return exception_to_rocblas_status();                               \
+    }
+
+IMPL(rocblas_saxpy_dot_strided_batched, float);
+IMPL(rocblas_daxpy_dot_strided_batched, double);
+IMPL(rocblas_caxpy_dot_strided_batched, rocblas_float_complex);
+IMPL(rocblas_zaxpy_dot_strided_batched, rocblas_double_complex);
+
+#undef IMPL
+
+#define IMPL(routine_name_, T_)                                               \
+    rocblas_status routine_name_(rocblas_handle handle,                       \
+                                 rocblas_int    n,                            \
+                                 rocblas_int    k,                            \
+                                 const T_*      x,                            \
+                                 rocblas_int    incx,                         \
+                                 rocblas_stride stridex,                      \
+                                 const T_*      y,                            \
+                                 rocblas_int    incy,                         \
+                                 rocblas_int    ldy,                          \
+                                 rocblas_stride stridey,                      \
+                                 rocblas_int    batch_count,                  \
+                                 T_*            results)                      \
+    try                                                                       \
+    {                                                                         \
+        return rocblas_multi_dot_impl<NB, true>(handle,                       \
+                                                n,                            \
+                                                k,                            \
+                                                x,                            \
+                                                incx,                         \
+                                                stridex,                      \
+                                                y,                            \
+                                                incy,                         \
+                                                ldy,                          \
+                                                stridey,                      \
+                                                batch_count,                  \
+                                                results,                      \
+                                                #routine_name_,               \
+                                                "multi_dot_strided_batched"); \
+    }                                                                         \
+    catch(...)                                                                \
+    {                                                                         \
+        return exception_to_rocblas_status();                                 \
+    }
+
+IMPL(rocblas_smulti_dot_strided_batched, float);
+IMPL(rocblas_dmulti_dot_strided_batched, double);
+IMPL(rocblas_cmulti_dot_strided_batched, rocblas_float_complex);
+IMPL(rocblas_zmulti_dot_strided_batched, rocblas_double_complex);
+
+#undef IMPL
+
+#define IMPL(routine_name_, T_, Tr_)                                          \
+    rocblas_status routine_name_(rocblas_handle handle,                       \
+                                 rocblas_int    n,                            \
+                                 const T_*      alpha,                        \
+                                 T_*            x,                            \
+                                 rocblas_int    incx,                         \
+                                 rocblas_stride stridex,                      \
+                                 rocblas_int    batch_count,                  \
+                                 Tr_*           result)                       \
+    try                                                                       \
+    {                                                                         \
+        return rocblas_scal_nrm2_impl<NB, true>(handle,                       \
+                                                n,                            \
+                                                alpha,                        \
+                                                x,                            \
+                                                incx,                         \
+                                                stridex,                      \
+                                                batch_count,                  \
+                                                result,                       \
+                                                #routine_name_,               \
+                                                "scal_nrm2_strided_batched"); \
+    }                                                                         \
+    catch(...)                                                                \
+    {                                                                         \
+        return exception_to_rocblas_status();                                 \
+    }
+
+IMPL(rocblas_sscal_nrm2_strided_batched, float, float);
+IMPL(rocblas_dscal_nrm2_strided_batched, double, double);
+IMPL(rocblas_cscal_nrm2_strided_batched, rocblas_float_complex, float);
+IMPL(rocblas_zscal_nrm2_strided_batched, rocblas_double_complex, double);
+
+#undef IMPL
+
+} // extern "C"
@@ -30,6 +30,8 @@ namespace
         static constexpr rocblas_int    batch_count_1 = 1;
         static constexpr int            NB            = 1024;
 
+        rocblas_perf_scope perf(handle, rocblas_iamax_name<T>);
+
         size_t         dev_bytes = 0;
         rocblas_status checks_status
             = rocblas_reduction_setup<NB, isbatched, rocblas_index_value_t<S>>(
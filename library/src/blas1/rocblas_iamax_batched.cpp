@@ -33,6 +33,8 @@ namespace
         static constexpr rocblas_stride stridex_0 = 0;
         static constexpr rocblas_int    shiftx_0  = 0;
 
+        rocblas_perf_scope perf(handle, rocblas_iamax_batched_name<T>);
+
         size_t         dev_bytes = 0;
         rocblas_status checks_status
             = rocblas_reduction_setup<NB, isbatched, rocblas_index_value_t<S>>(
@@ -32,6 +32,8 @@ namespace
         static constexpr rocblas_int    batch_count_1 = 1;
         static constexpr rocblas_int    shiftx_0      = 0;
 
+        rocblas_perf_scope perf(handle, rocblas_nrm2_name<Ti>);
+
         size_t         dev_bytes = 0;
         rocblas_status checks_status
             = rocblas_reduction_setup<NB, isbatched, To>(handle,
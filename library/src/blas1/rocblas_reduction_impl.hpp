@@ -238,6 +238,8 @@ rocblas_status rocblas_reduction_impl(rocblas_handle handle,
                                       const char*    name,
                                       const char*    name_bench)
 {
+    rocblas_perf_scope perf(handle, name);
+
     size_t         dev_bytes     = 0;
     rocblas_status checks_status = rocblas_reduction_setup<NB, ISBATCHED, Tw>(
         handle, n, x, incx, stridex, batch_count, results, name, name_bench, dev_bytes);
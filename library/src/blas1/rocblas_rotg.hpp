@@ -124,7 +124,7 @@ rocblas_status rocblas_rotg_template(rocblas_handle handle,
     }
     else
     {
-        RETURN_IF_HIP_ERROR(hipStreamSynchronize(rocblas_stream));
+        RETURN_IF_ROCBLAS_ERROR(handle->sync.stream_synchronize(rocblas_stream));
         // TODO: make this faster for a large number of batches.
         for(int i = 0; i < batch_count; i++)
         {
@@ -153,7 +153,8 @@ ROCBLAS_KERNEL void rocblas_rotg_check_numerics_vector_kernel(T
                                                               T                         s_in,
                                                               rocblas_int               offset_s,
                                                               rocblas_stride            stride_s,
-                                                              rocblas_check_numerics_t* abnormal)
+                                                              rocblas_check_numerics_t* abnormal,
+                                                              uint32_t                  seq)
 {
     auto a = load_ptr_batch(a_in, hipBlockIdx_x, offset_a, stride_a);
     auto b = load_ptr_batch(b_in, hipBlockIdx_x, offset_b, stride_b);
@@ -163,10 +164,14 @@ ROCBLAS_KERNEL void rocblas_rotg_check_numerics_vector_kernel(T
     //Check every element of the vectors a, b, c, s for a zero/NaN/Inf
     if(rocblas_iszero(*a) || rocblas_iszero(*b) || rocblas_iszero(*c) || rocblas_iszero(*s))
         abnormal->has_zero = true;
-    if(rocblas_isnan(*a) || rocblas_isnan(*b) || rocblas_isnan(*c) || rocblas_isnan(*s))
+    bool is_NaN = rocblas_isnan(*a) || rocblas_isnan(*b) || rocblas_isnan(*c) || rocblas_isnan(*s);
+    bool is_Inf = rocblas_isinf(*a) || rocblas_isinf(*b) || rocblas_isinf(*c) || rocblas_isinf(*s);
+    if(is_NaN)
         abnormal->has_NaN = true;
-    if(rocblas_isinf(*a) || rocblas_isinf(*b) || rocblas_isinf(*c) || rocblas_isinf(*s))
+    if(is_Inf)
         abnormal->has_Inf = true;
+    if(is_NaN || is_Inf)
+        rocblas_check_numerics_record_abnormal(abnormal, seq);
 }
 
 template <typename T, typename U>
@@ -199,38 +204,55 @@ rocblas_status rocblas_rotg_check_numerics_template(const char*    function_name
     {
         hipStream_t rocblas_stream = handle->get_stream();
 
+        auto launch = [&](rocblas_check_numerics_t* d_abnormal, uint32_t seq) {
+            hipLaunchKernelGGL(rocblas_rotg_check_numerics_vector_kernel,
+                               batch_count,
+                               1,
+                               0,
+                               rocblas_stream,
+                               a_in,
+                               offset_a,
+                               stride_a,
+                               b_in,
+                               offset_b,
+                               stride_b,
+                               c_in,
+                               offset_c,
+                               stride_c,
+                               s_in,
+                               offset_s,
+                               stride_s,
+                               d_abnormal,
+                               seq);
+        };
+
+        //In deferred mode, accumulating the results on the device without synchronizing
+        if(check_numerics & rocblas_check_numerics_mode_deferred)
+        {
+            rocblas_check_numerics_t* d_abnormal;
+            uint32_t                  seq;
+            RETURN_IF_ROCBLAS_ERROR(rocblas_check_numerics_deferred_begin(
+                handle, function_name, is_input, d_abnormal, seq));
+            if(d_abnormal)
+                launch(d_abnormal, seq);
+            return rocblas_status_success;
+        }
+
         auto d_abnormal = handle->device_malloc(sizeof(rocblas_check_numerics_t));
 
         //Transferring the rocblas_check_numerics_t structure from host to the device
-        RETURN_IF_HIP_ERROR(hipMemcpy((rocblas_check_numerics_t*)d_abnormal,
-                                      &h_abnormal,
-                                      sizeof(rocblas_check_numerics_t),
-                                      hipMemcpyHostToDevice));
+        RETURN_IF_ROCBLAS_ERROR(handle->sync.copy((rocblas_check_numerics_t*)d_abnormal,
+                                                  &h_abnormal,
+                                                  sizeof(rocblas_check_numerics_t),
+                                                  hipMemcpyHostToDevice));
 
-        hipLaunchKernelGGL(rocblas_rotg_check_numerics_vector_kernel,
-                           batch_count,
-                           1,
-                           0,
-                           rocblas_stream,
-                           a_in,
-                           offset_a,
-                           stride_a,
-                           b_in,
-                           offset_b,
-                           stride_b,
-                           c_in,
-                           offset_c,
-                           stride_c,
-                           s_in,
-                           offset_s,
-                           stride_s,
-                           (rocblas_check_numerics_t*)d_abnormal);
+        launch((rocblas_check_numerics_t*)d_abnormal, 0);
 
         //Transferring the rocblas_check_numerics_t structure from device to the host
-        RETURN_IF_HIP_ERROR(hipMemcpy(&h_abnormal,
-                                      (rocblas_check_numerics_t*)d_abnormal,
-                                      sizeof(rocblas_check_numerics_t),
-                                      hipMemcpyDeviceToHost));
+        RETURN_IF_ROCBLAS_ERROR(handle->sync.copy(&h_abnormal,
+                                                  (rocblas_check_numerics_t*)d_abnormal,
+                                                  sizeof(rocblas_check_numerics_t),
+                                                  hipMemcpyDeviceToHost));
     }
     else
     {
@@ -249,6 +271,13 @@ rocblas_status rocblas_rotg_check_numerics_template(const char*    function_name
             if(rocblas_isinf(*a) || rocblas_isinf(*b) || rocblas_isinf(*c) || rocblas_isinf(*s))
                 h_abnormal.has_Inf = true;
         }
+
+        //In deferred mode, accumulating the results on the host
+        if(check_numerics & rocblas_check_numerics_mode_deferred)
+        {
+            rocblas_check_numerics_deferred_host(handle, function_name, is_input, h_abnormal);
+            return rocblas_status_success;
+        }
     }
     return rocblas_check_numerics_abnormal_struct(
         function_name, check_numerics, is_input, &h_abnormal);
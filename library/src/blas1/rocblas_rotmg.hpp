@@ -224,7 +224,7 @@ rocblas_status rocblas_rotmg_template(rocblas_handle handle,
     }
     else
     {
-        RETURN_IF_HIP_ERROR(hipStreamSynchronize(rocblas_stream));
+        RETURN_IF_ROCBLAS_ERROR(handle->sync.stream_synchronize(rocblas_stream));
         // TODO: make this faster for a large number of batches.
         for(int i = 0; i < batch_count; i++)
         {
@@ -253,7 +253,8 @@ ROCBLAS_KERNEL void rocblas_rotmg_check_numerics_vector_kernel(T
                                                                U                         y1_in,
                                                                rocblas_int               offset_y1,
                                                                rocblas_stride            stride_y1,
-                                                               rocblas_check_numerics_t* abnormal)
+                                                               rocblas_check_numerics_t* abnormal,
+                                                               uint32_t                  seq)
 {
     auto d1 = load_ptr_batch(d1_in, hipBlockIdx_x, offset_d1, stride_d1);
     auto d2 = load_ptr_batch(d2_in, hipBlockIdx_x, offset_d2, stride_d2);
@@ -263,10 +264,16 @@ ROCBLAS_KERNEL void rocblas_rotmg_check_numerics_vector_kernel(T
     //Check every element of the x vector for a NaN/zero/Inf
     if(rocblas_iszero(*d1) || rocblas_iszero(*d2) || rocblas_iszero(*x1) || rocblas_iszero(*y1))
         abnormal->has_zero = true;
-    if(rocblas_isnan(*d1) || rocblas_isnan(*d2) || rocblas_isnan(*x1) || rocblas_isnan(*y1))
+    bool is_NaN
+        = rocblas_isnan(*d1) || rocblas_isnan(*d2) || rocblas_isnan(*x1) || rocblas_isnan(*y1);
+    bool is_Inf
+        = rocblas_isinf(*d1) || rocblas_isinf(*d2) || rocblas_isinf(*x1) || rocblas_isinf(*y1);
+    if(is_NaN)
         abnormal->has_NaN = true;
-    if(rocblas_isinf(*d1) || rocblas_isinf(*d2) || rocblas_isinf(*x1) || rocblas_isinf(*y1))
+    if(is_Inf)
         abnormal->has_Inf = true;
+    if(is_NaN || is_Inf)
+        rocblas_check_numerics_record_abnormal(abnormal, seq);
 }
 
 template <typename T, typename U>
@@ -299,37 +306,55 @@ rocblas_status rocblas_rotmg_check_numerics_template(const char*    function_nam
     {
         hipStream_t rocblas_stream = handle->get_stream();
 
+        auto launch = [&](rocblas_check_numerics_t* d_abnormal, uint32_t seq) {
+            hipLaunchKernelGGL(rocblas_rotmg_check_numerics_vector_kernel,
+                               batch_count,
+                               1,
+                               0,
+                               rocblas_stream,
+                               d1_in,
+                               offset_d1,
+                               stride_d1,
+                               d2_in,
+                               offset_d2,
+                               stride_d2,
+                               x1_in,
+                               offset_x1,
+                               stride_x1,
+                               y1_in,
+                               offset_y1,
+                               stride_y1,
+                               d_abnormal,
+                               seq);
+        };
+
+        //In deferred mode, accumulating the results on the device without synchronizing
+        if(check_numerics & rocblas_check_numerics_mode_deferred)
+        {
+            rocblas_check_numerics_t* d_abnormal;
+            uint32_t                  seq;
+            RETURN_IF_ROCBLAS_ERROR(rocblas_check_numerics_deferred_begin(
+                handle, function_name, is_input, d_abnormal, seq));
+            if(d_abnormal)
+                launch(d_abnormal, seq);
+            return rocblas_status_success;
+        }
+
         auto d_abnormal = handle->device_malloc(sizeof(rocblas_check_numerics_t));
 
         //Transferring the rocblas_check_numerics_t structure from host to the device
-        RETURN_IF_HIP_ERROR(hipMemcpy((rocblas_check_numerics_t*)d_abnormal,
-                                      &h_abnormal,
-                                      sizeof(rocblas_check_numerics_t),
-                                      hipMemcpyHostToDevice));
-        hipLaunchKernelGGL(rocblas_rotmg_check_numerics_vector_kernel,
-                           batch_count,
-                           1,
-                           0,
-                           rocblas_stream,
-                           d1_in,
-                           offset_d1,
-                           stride_d1,
-                           d2_in,
-                           offset_d2,
-                           stride_d2,
-                           x1_in,
-                           offset_x1,
-                           stride_x1,
-                           y1_in,
-                           offset_y1,
-                           stride_y1,
-                           (rocblas_check_numerics_t*)d_abnormal);
+        RETURN_IF_ROCBLAS_ERROR(handle->sync.copy((rocblas_check_numerics_t*)d_abnormal,
+                                                  &h_abnormal,
+                                                  sizeof(rocblas_check_numerics_t),
+                                                  hipMemcpyHostToDevice));
+
+        launch((rocblas_check_numerics_t*)d_abnormal, 0);
 
         //Transferring the rocblas_check_numerics_t structure from device to the host
-        RETURN_IF_HIP_ERROR(hipMemcpy(&h_abnormal,
-                                      (rocblas_check_numerics_t*)d_abnormal,
-                                      sizeof(rocblas_check_numerics_t),
-                                      hipMemcpyDeviceToHost));
+        RETURN_IF_ROCBLAS_ERROR(handle->sync.copy(&h_abnormal,
+                                                  (rocblas_check_numerics_t*)d_abnormal,
+                                                  sizeof(rocblas_check_numerics_t),
+                                                  hipMemcpyDeviceToHost));
     }
     else
     {
@@ -349,6 +374,13 @@ rocblas_status rocblas_rotmg_check_numerics_template(const char*    function_nam
             if(rocblas_isinf(*d1) || rocblas_isinf(*d2) || rocblas_isinf(*x1) || rocblas_isinf(*y1))
                 h_abnormal.has_Inf = true;
         }
+
+        //In deferred mode, accumulating the results on the host
+        if(check_numerics & rocblas_check_numerics_mode_deferred)
+        {
+            rocblas_check_numerics_deferred_host(handle, function_name, is_input, h_abnormal);
+            return rocblas_status_success;
+        }
     }
     return rocblas_check_numerics_abnormal_struct(
         function_name, check_numerics, is_input, &h_abnormal);
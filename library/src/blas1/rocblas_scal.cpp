@@ -32,6 +32,11 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(
+            handle,
+            rocblas_scal_name<T, U>,
+            rocblas_perf_scal_work(n, 1, sizeof(T), is_complex<T>, is_complex<U>));
+
         auto layer_mode     = handle->layer_mode;
         auto check_numerics = handle->check_numerics;
 
@@ -76,8 +81,23 @@ namespace
                 return check_numerics_status;
         }
 
-        rocblas_status status
-            = rocblas_internal_scal_template<NB, T>(handle, n, alpha, 0, x, 0, incx, 0, 1);
+        // Threads per block from the launch tuning table, or NB
+        const rocblas_launch_dims* tuned
+            = handle->launch_tuning.lookup(rocblas_tuned_kernel::scal,
+                                           handle->getArch(),
+                                           rocblas_datatype_from_type<T>,
+                                           rocblas_operation_none,
+                                           n,
+                                           1);
+        rocblas_int nb = tuned ? tuned->dim_x : NB;
+
+        rocblas_status status;
+        if(nb == 1024)
+            status = rocblas_internal_scal_template<1024, T>(handle, n, alpha, 0, x, 0, incx, 0, 1);
+        else if(nb == 512)
+            status = rocblas_internal_scal_template<512, T>(handle, n, alpha, 0, x, 0, incx, 0, 1);
+        else
+            status = rocblas_internal_scal_template<NB, T>(handle, n, alpha, 0, x, 0, incx, 0, 1);
         if(status != rocblas_status_success)
             return status;
 
@@ -40,6 +40,11 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(
+            handle,
+            rocblas_scal_name<T, U>,
+            rocblas_perf_scal_work(n, batch_count, sizeof(T), is_complex<T>, is_complex<U>));
+
         auto layer_mode     = handle->layer_mode;
         auto check_numerics = handle->check_numerics;
 
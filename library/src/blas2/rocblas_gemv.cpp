@@ -34,6 +34,11 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(
+            handle,
+            rocblas_gemv_name<T>,
+            rocblas_perf_gemv_work(transA, m, n, 1, sizeof(T), is_complex<T>));
+
         size_t dev_bytes = rocblas_internal_gemv_kernel_workspace_size<T>(transA, m, n);
         if(handle->is_device_memory_size_query())
             return handle->set_optimal_device_memory_size(dev_bytes);
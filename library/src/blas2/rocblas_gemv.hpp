@@ -8,7 +8,6 @@
 #include "check_numerics_vector.hpp"
 #include "gemv_device.hpp"
 #include "handle.hpp"
-#include "rocblas_gemv_threshold.hpp"
 
 // gemvt_sn is skinny n matrix optimizations
 constexpr int rocblas_gemvt_sn_WIN()
@@ -131,15 +130,16 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
                    : offsety;
     bool i64_indices = n * size_t(lda) > std::numeric_limits<rocblas_int>::max();
 
-    //Identifying the precision to have an appropriate optimization
-    bool is_float          = std::is_same<T, float>{};
-    bool is_double         = std::is_same<T, double>{};
-    bool is_complex_float  = std::is_same<T, rocblas_float_complex>{};
-    bool is_complex_double = std::is_same<T, rocblas_double_complex>{};
-
-    //Identifying the architecture to have an appropriate optimization
-    bool is_gfx908 = handle->getArch() == 908 ? true : false;
-    bool is_gfx906 = handle->getArch() == 906 ? true : false;
+    // Block dimensions of the gemvn and gemvt kernels for the architecture, precision and size
+    const rocblas_launch_dims* tuned
+        = handle->launch_tuning.lookup(transA == rocblas_operation_none
+                                           ? rocblas_tuned_kernel::gemvn
+                                           : rocblas_tuned_kernel::gemvt,
+                                       handle->getArch(),
+                                       rocblas_datatype_from_type<T>,
+                                       transA,
+                                       m,
+                                       n);
 
     if(transA == rocblas_operation_none)
     {
@@ -181,22 +181,9 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
                                        gemvn_KARGS(*alpha, *beta));
             }
         }
-        //optimized gemvn kernel for gfx906 and gfx908.
-        else if((is_gfx908
-                 && (((is_float || is_double || is_complex_float) && m <= gemvn_gfx908_threshold
-                      && n <= gemvn_gfx908_threshold)
-                     || (is_complex_double && m <= zgemvn_gfx908_threshold
-                         && n <= zgemvn_gfx908_threshold)))
-
-                || (is_gfx906
-                    && (is_complex_float
-                        || ((is_float || is_double) && m <= gemvn_gfx906_threshold
-                            && n <= gemvn_gfx906_threshold)
-                        || (is_double
-                            && ((m >= dgemvn_gfx906_lower_threshold
-                                 && n >= dgemvn_gfx906_lower_threshold)
-                                || (m <= dgemvn_gfx906_upper_threshold
-                                    && n <= dgemvn_gfx906_upper_threshold))))))
+        // 512 threads per block, where the launch tuning table selects them, e.g. for sizes
+        // up to about 15000 on gfx906 and gfx908
+        else if(tuned && *tuned == rocblas_launch_dims{32, 16})
         {
             static constexpr int GEMVN_DIM_X = 32;
             static constexpr int GEMVN_DIM_Y = 16;
@@ -393,8 +380,9 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
 #undef gemvt_sn_KARGS
         }
-        //Having 256 threads per block for single precision GEMV (transpose) for better performance
-        else if(is_float)
+        // 256 threads per block, where the launch tuning table selects them, e.g. for single
+        // precision
+        else if(tuned && tuned->dim_x == 256)
         {
             // number of columns on the y-dim of the grid
             static constexpr int NB = 256;
@@ -457,7 +445,7 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
                                    stridey);
             }
         }
-        //Having 1024 threads per block for double, complex-float and complex-double precision GEMV (transpose) for better performance
+        // 1024 threads per block otherwise
         else
         {
             // number of columns on the y-dim of the grid
@@ -653,8 +641,9 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
 #undef gemvt_sn_KARGS
         }
-        //Having 256 threads per block for single precision GEMV (transpose) for better performance
-        else if(is_float)
+        // 256 threads per block, where the launch tuning table selects them, e.g. for single
+        // precision
+        else if(tuned && tuned->dim_x == 256)
         {
             static constexpr int NB = 256;
             dim3                 gemvt_grid(n, batch_count);
@@ -715,7 +704,7 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
                                    stridey);
             }
         }
-        //Having 1024 threads per block for double, complex-float and complex-double precision GEMV (transpose) for better performance
+        // 1024 threads per block otherwise
         else
         {
             static constexpr int NB = 1024;
@@ -29,6 +29,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(handle, rocblas_hemv_name<T>);
+
         auto check_numerics = handle->check_numerics;
 
         if(!handle->is_device_memory_size_query())
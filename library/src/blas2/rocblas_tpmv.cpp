@@ -33,6 +33,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(handle, rocblas_tpmv_name<T>);
+
         if(!handle->is_device_memory_size_query())
         {
             auto layer_mode = handle->layer_mode;
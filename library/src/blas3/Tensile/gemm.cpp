@@ -41,6 +41,11 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(
+            handle,
+            rocblas_gemm_name<T>,
+            rocblas_perf_gemm_work(m, n, k, 1, sizeof(T), sizeof(T), sizeof(T), is_complex<T>));
+
         RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
 
         // Copy alpha and beta to host if on device
@@ -380,12 +380,14 @@ rocblas_status copy_alpha_beta_to_host_if_on_device(
             if(k == 0)
                 alpha_h = 0;
             else
-                RETURN_IF_HIP_ERROR(hipMemcpy(&alpha_h, alpha, sizeof(Tc), hipMemcpyDeviceToHost));
+                RETURN_IF_ROCBLAS_ERROR(
+                    handle->sync.copy(&alpha_h, alpha, sizeof(Tc), hipMemcpyDeviceToHost));
             alpha = &alpha_h;
         }
         if(beta)
         {
-            RETURN_IF_HIP_ERROR(hipMemcpy(&beta_h, beta, sizeof(Tc), hipMemcpyDeviceToHost));
+            RETURN_IF_ROCBLAS_ERROR(
+                handle->sync.copy(&beta_h, beta, sizeof(Tc), hipMemcpyDeviceToHost));
             beta = &beta_h;
         }
     }
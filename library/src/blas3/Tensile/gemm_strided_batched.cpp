@@ -53,6 +53,18 @@ namespace
     {
         if(!handle)
             return rocblas_status_invalid_handle;
+
+        rocblas_perf_scope perf(handle,
+                                rocblas_gemm_strided_batched_name<T>,
+                                rocblas_perf_gemm_work(m,
+                                                       n,
+                                                       k,
+                                                       batch_count,
+                                                       sizeof(T),
+                                                       sizeof(T),
+                                                       sizeof(T),
+                                                       is_complex<T>));
+
         RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
 
         // Copy alpha and beta to host if on device
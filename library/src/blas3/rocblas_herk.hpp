@@ -94,6 +94,57 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     if(!n || !batch_count)
         return rocblas_status_success;
 
+#if BUILD_WITH_TENSILE
+    // For large n, the kernels below compute the diagonal blocks and Tensile GEMMs the panels
+    if(rocblas_sym_blocked_enabled(handle, n, offsetA, lda, offsetA, lda, offsetC, ldc))
+    {
+        using T = rocblas_sym_blocked_elem_t<TPtr>;
+        real_t<T> alpha_h, beta_h;
+        RETURN_IF_ROCBLAS_ERROR(
+            rocblas_sym_blocked_load_scalars(handle, k, alpha, beta, alpha_h, beta_h));
+        TScal alpha_p = &alpha_h, beta_p = &beta_h;
+
+        auto plan = rocblas_sym_block_plan::rank_k(
+            uplo, transA, n, k, lda, lda, ldc, handle->sym_blocked.nb, true, false);
+        auto diag = [&](const rocblas_sym_diag_call& d) {
+            return rocblas_internal_herk_template(handle,
+                                                  uplo,
+                                                  transA,
+                                                  d.n,
+                                                  k,
+                                                  alpha_p,
+                                                  AP,
+                                                  offsetA + d.offset_a,
+                                                  lda,
+                                                  strideA,
+                                                  beta_p,
+                                                  CP,
+                                                  offsetC + d.offset_c,
+                                                  ldc,
+                                                  strideC,
+                                                  batch_count);
+        };
+        return rocblas_sym_blocked_execute(handle,
+                                           plan,
+                                           T(alpha_h),
+                                           AP,
+                                           offsetA,
+                                           lda,
+                                           strideA,
+                                           AP,
+                                           offsetA,
+                                           lda,
+                                           strideA,
+                                           T(beta_h),
+                                           CP,
+                                           offsetC,
+                                           ldc,
+                                           strideC,
+                                           batch_count,
+                                           diag);
+    }
+#endif
+
     static constexpr int HERK_SCALE_DIM_X = 128;
     static constexpr int HERK_SCALE_DIM_Y = 8;
     rocblas_int          gx               = (n - 1) / (HERK_SCALE_DIM_X) + 1;
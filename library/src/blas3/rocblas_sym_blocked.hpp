@@ -0,0 +1,125 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "handle.hpp"
+#include "rocblas_sym_block_plan.hpp"
+#include <type_traits>
+
+#if BUILD_WITH_TENSILE
+
+#include "Tensile/gemm.hpp"
+
+/*******************************************************************************
+ * Blocked path of SYRK, HERK, SYR2K, HER2K, SYMM and HEMM for n of at least   *
+ * handle->sym_blocked.min_n: the routine's kernels compute the diagonal blocks*
+ * of rocblas_sym_block_plan, and Tensile GEMMs the off-diagonal panels.       *
+ *                                                                             *
+ * Like the GEMMs it calls, it reads alpha and beta on the host. It is not     *
+ * used in device pointer mode when the handle is capture-safe, since reading  *
+ * them would synchronize.                                                     *
+ ******************************************************************************/
+
+// Element type of TPtr, which is T* or T* const*
+template <typename TPtr>
+using rocblas_sym_blocked_elem_t = std::remove_cv_t<
+    std::remove_pointer_t<std::remove_cv_t<std::remove_pointer_t<TPtr>>>>;
+
+inline bool rocblas_sym_blocked_enabled(rocblas_handle handle,
+                                        rocblas_int    n,
+                                        rocblas_int    offsetA,
+                                        rocblas_int    lda,
+                                        rocblas_int    offsetB,
+                                        rocblas_int    ldb,
+                                        rocblas_int    offsetC,
+                                        rocblas_int    ldc)
+{
+    return rocblas_sym_blocked_use(handle->sym_blocked, n)
+           && rocblas_sym_blocked_offsets_fit(n, offsetA, lda, offsetB, ldb, offsetC, ldc)
+           && !(handle->pointer_mode == rocblas_pointer_mode_device
+                && handle->sync.capture_safe());
+}
+
+/*! \brief Reads alpha and beta on the host, alpha being 0 without reading it if k == 0 */
+template <typename TAlpha, typename TBeta>
+rocblas_status rocblas_sym_blocked_load_scalars(rocblas_handle handle,
+                                                rocblas_int    k,
+                                                const TAlpha*  alpha,
+                                                const TBeta*   beta,
+                                                TAlpha&        alpha_h,
+                                                TBeta&         beta_h)
+{
+    if(handle->pointer_mode == rocblas_pointer_mode_host)
+    {
+        alpha_h = k ? *alpha : TAlpha(0);
+        beta_h  = *beta;
+        return rocblas_status_success;
+    }
+    alpha_h = 0;
+    if(k)
+        RETURN_IF_ROCBLAS_ERROR(
+            handle->sync.copy(&alpha_h, alpha, sizeof(TAlpha), hipMemcpyDeviceToHost));
+    return handle->sync.copy(&beta_h, beta, sizeof(TBeta), hipMemcpyDeviceToHost);
+}
+
+/*! \brief Runs plan, calling diag(call) on each diagonal block, in host pointer mode, and
+    then the GEMMs with the host values alpha and beta. If alpha is 0, only beta is applied. */
+template <typename T, typename TConstPtr, typename TPtr, typename Diag>
+rocblas_status rocblas_sym_blocked_execute(rocblas_handle                handle,
+                                           const rocblas_sym_block_plan& plan,
+                                           T                             alpha,
+                                           TConstPtr                     AP,
+                                           rocblas_int                   offsetA,
+                                           rocblas_int                   lda,
+                                           rocblas_stride                strideA,
+                                           TConstPtr                     BP,
+                                           rocblas_int                   offsetB,
+                                           rocblas_int                   ldb,
+                                           rocblas_stride                strideB,
+                                           T                             beta,
+                                           TPtr                          CP,
+                                           rocblas_int                   offsetC,
+                                           rocblas_int                   ldc,
+                                           rocblas_stride                strideC,
+                                           rocblas_int                   batch_count,
+                                           Diag&&                        diag)
+{
+    static constexpr bool BATCHED
+        = !std::is_same<std::remove_cv_t<std::remove_pointer_t<TConstPtr>>, T>{};
+
+    auto saved_pointer_mode = handle->push_pointer_mode(rocblas_pointer_mode_host);
+
+    for(auto& call : plan.diagonal())
+        RETURN_IF_ROCBLAS_ERROR(diag(call));
+
+    const T one = 1, zero = 0, alpha_conj = conj(alpha);
+    for(auto& call : plan.gemms())
+    {
+        // With alpha == 0, the first GEMM on each panel of a rank-k update applies beta
+        // without reading A or B
+        if(alpha == zero && call.accumulate)
+            continue;
+
+        bool      first_a  = call.first == rocblas_sym_operand::A;
+        bool      second_a = call.second == rocblas_sym_operand::A;
+        TConstPtr first    = first_a ? AP : BP;
+        TConstPtr second   = second_a ? AP : BP;
+
+        // clang-format off
+        RETURN_IF_ROCBLAS_ERROR((rocblas_internal_gemm_template<BATCHED, T>(
+            handle, call.trans_a, call.trans_b, call.m, call.n, alpha == zero ? 0 : call.k,
+            call.conj_alpha ? &alpha_conj : &alpha,
+            first,  (first_a ? offsetA : offsetB) + call.offset_first,
+                    first_a ? lda : ldb,         first_a ? strideA : strideB,
+            second, (second_a ? offsetA : offsetB) + call.offset_second,
+                    second_a ? lda : ldb,        second_a ? strideA : strideB,
+            call.accumulate ? &one : &beta,
+            CP,     offsetC + call.offset_c,     ldc, strideC, batch_count)));
+        // clang-format on
+    }
+    return rocblas_status_success;
+}
+
+#endif // BUILD_WITH_TENSILE
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "handle.hpp"
+#include "rocblas_sym_blocked.hpp"
 
 template <typename T, typename U>
 ROCBLAS_KERNEL_ILF void syr2k_scale_device(bool upper, rocblas_int n, T beta, U* C, rocblas_int ldc)
@@ -303,6 +304,61 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     if(!n || !batch_count)
         return rocblas_status_success;
 
+#if BUILD_WITH_TENSILE
+    // For large n, the kernels below compute the diagonal blocks and Tensile GEMMs the panels
+    if(rocblas_sym_blocked_enabled(handle, n, offsetA, lda, offsetB, ldb, offsetC, ldc))
+    {
+        using T = rocblas_sym_blocked_elem_t<TPtr>;
+        T alpha_h, beta_h;
+        RETURN_IF_ROCBLAS_ERROR(
+            rocblas_sym_blocked_load_scalars(handle, k, alpha, beta, alpha_h, beta_h));
+        TScal alpha_p = &alpha_h, beta_p = &beta_h;
+
+        auto plan = rocblas_sym_block_plan::rank_k(
+            uplo, trans, n, k, lda, ldb, ldc, handle->sym_blocked.nb, false, TWOK);
+        auto diag = [&](const rocblas_sym_diag_call& d) {
+            return rocblas_internal_syr2k_template<TWOK>(handle,
+                                                         uplo,
+                                                         trans,
+                                                         d.n,
+                                                         k,
+                                                         alpha_p,
+                                                         AP,
+                                                         offsetA + d.offset_a,
+                                                         lda,
+                                                         strideA,
+                                                         BP,
+                                                         offsetB + d.offset_b,
+                                                         ldb,
+                                                         strideB,
+                                                         beta_p,
+                                                         CP,
+                                                         offsetC + d.offset_c,
+                                                         ldc,
+                                                         strideC,
+                                                         batch_count);
+        };
+        return rocblas_sym_blocked_execute(handle,
+                                           plan,
+                                           alpha_h,
+                                           AP,
+                                           offsetA,
+                                           lda,
+                                           strideA,
+                                           BP,
+                                           offsetB,
+                                           ldb,
+                                           strideB,
+                                           T(beta_h),
+                                           CP,
+                                           offsetC,
+                                           ldc,
+                                           strideC,
+                                           batch_count,
+                                           diag);
+    }
+#endif
+
     static constexpr int syr2k_SCALE_DIM_X = 128;
     static constexpr int syr2k_SCALE_DIM_Y = 8;
     rocblas_int          gx                = (n - 1) / (syr2k_SCALE_DIM_X) + 1;
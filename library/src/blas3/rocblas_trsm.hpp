@@ -2167,7 +2167,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     if(saved_pointer_mode == rocblas_pointer_mode_host)
         alpha_h = *alpha;
     else
-        RETURN_IF_HIP_ERROR(hipMemcpy(&alpha_h, alpha, sizeof(T), hipMemcpyDeviceToHost));
+        RETURN_IF_ROCBLAS_ERROR(
+            handle->sync.copy(&alpha_h, alpha, sizeof(T), hipMemcpyDeviceToHost));
 
     if(alpha_h == T(0.0))
     {
@@ -2319,33 +2320,75 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
             // w_c_temp and w_x_temp can reuse the same device memory
             T* w_c_temp = (T*)w_x_temp;
             stride_invA = BLOCK * k;
+
+            // If the handle caches inverted diagonal blocks, reuse those of A, or invert them
+            // into a new cache entry instead of the workspace. Entries are not allocated or
+            // evicted in capture-safe mode. Batched calls, keyed by their array of pointers,
+            // use the cache only if the caller opted in.
+            auto& cache  = handle->trsm_inverse_cache;
+            void* entry  = nullptr;
+            bool  invert = true;
+            if(cache.enabled(BATCHED))
+            {
+                rocblas_trsm_inverse_key key{A,
+                                             offset_A,
+                                             lda,
+                                             stride_A,
+                                             k,
+                                             BLOCK,
+                                             batch_count,
+                                             uplo,
+                                             diag,
+                                             rocblas_datatype_from_type<T>,
+                                             BATCHED,
+                                             0};
+
+                entry  = cache.find(key);
+                invert = !entry;
+                if(invert && !handle->sync.capture_safe())
+                    entry = cache.insert(key, sizeof(T) * size_t(stride_invA) * batch_count);
+                if(entry)
+                {
+                    invA        = entry;
+                    offset_invA = 0;
+                }
+            }
+
             if(BATCHED)
             {
                 // for w_c_temp, we currently can use the same memory from each batch since
                 // trtri_batched is naive (since gemm_batched is naive)
-                setup_batched_array<BLOCK>(
-                    handle->get_stream(), (T*)w_c_temp, 0, (T**)w_x_temparr, batch_count);
+                if(invert)
+                    setup_batched_array<BLOCK>(
+                        handle->get_stream(), (T*)w_c_temp, 0, (T**)w_x_temparr, batch_count);
                 setup_batched_array<BLOCK>(
                     handle->get_stream(), (T*)invA, stride_invA, (T**)invAarr, batch_count);
             }
 
-            status = rocblas_trtri_trsm_template<BLOCK, BATCHED, T>(
-                handle,
-                V(BATCHED ? w_x_temparr : w_c_temp),
-                uplo,
-                diag,
-                k,
-                A,
-                offset_A,
-                lda,
-                stride_A,
-                V(BATCHED ? invAarr : invA),
-                offset_invA,
-                stride_invA,
-                batch_count);
-
-            if(status != rocblas_status_success)
-                return status;
+            if(invert)
+            {
+                status = rocblas_trtri_trsm_template<BLOCK, BATCHED, T>(
+                    handle,
+                    V(BATCHED ? w_x_temparr : w_c_temp),
+                    uplo,
+                    diag,
+                    k,
+                    A,
+                    offset_A,
+                    lda,
+                    stride_A,
+                    V(BATCHED ? invAarr : invA),
+                    offset_invA,
+                    stride_invA,
+                    batch_count);
+
+                if(status != rocblas_status_success)
+                {
+                    if(entry)
+                        cache.erase(entry);
+                    return status;
+                }
+            }
         }
 
         size_t B_chunk_size = optimal_mem ? size_t(m) + size_t(n) - size_t(k) : 1;
@@ -53,6 +53,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(handle, rocblas_trsm_name<T>);
+
         /////////////
         // LOGGING //
         /////////////
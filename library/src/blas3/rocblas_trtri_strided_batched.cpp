@@ -36,6 +36,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(handle, rocblas_trtri_name<T>);
+
         // Compute the optimal size for temporary device memory
         size_t size = rocblas_internal_trtri_temp_size<NB>(n, batch_count) * sizeof(T);
         if(handle->is_device_memory_size_query())
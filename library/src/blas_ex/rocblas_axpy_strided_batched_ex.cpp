@@ -29,6 +29,8 @@ namespace
             return rocblas_status_invalid_handle;
         }
 
+        rocblas_perf_scope perf(handle, name);
+
         RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
 
         auto layer_mode = handle->layer_mode;
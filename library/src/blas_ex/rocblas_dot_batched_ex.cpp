@@ -31,6 +31,8 @@ namespace
             return rocblas_status_invalid_handle;
         }
 
+        rocblas_perf_scope perf(handle, name);
+
         size_t dev_bytes
             = rocblas_reduction_kernel_workspace_size<NB>(n, batch_count, execution_type);
         if(handle->is_device_memory_size_query())
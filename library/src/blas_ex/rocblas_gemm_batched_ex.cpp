@@ -38,6 +38,17 @@ try
     if(!handle)
         return rocblas_status_invalid_handle;
 
+    rocblas_perf_scope perf(handle,
+                            "rocblas_gemm_batched_ex",
+                            rocblas_perf_gemm_work(m,
+                                                   n,
+                                                   k,
+                                                   batch_count,
+                                                   rocblas_sizeof_datatype(a_type),
+                                                   rocblas_sizeof_datatype(c_type),
+                                                   rocblas_sizeof_datatype(d_type),
+                                                   rocblas_perf_is_complex(compute_type)));
+
     const bool HPA = compute_type == rocblas_datatype_f32_r
                      && (a_type == rocblas_datatype_f16_r || a_type == rocblas_datatype_bf16_r);
 
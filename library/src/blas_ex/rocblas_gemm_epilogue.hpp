@@ -0,0 +1,300 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "handle.hpp"
+#include "rocblas.h"
+#include "utility.hpp"
+#include <limits>
+#include <type_traits>
+
+/*******************************************************************************
+ * The epilogue of the gemm_ex_epilogue functions is one pass over D after the  *
+ * gemm, which reads each element once and writes it once, in place or to the   *
+ * output matrix. Scaling, bias, activation, clamping and conversion are done   *
+ * in Te, which is double when D is double or int32, so that every int32 value  *
+ * is exact, and float otherwise. The scale and bias vectors are of type Tv,    *
+ * which is double when D is double and float otherwise.                        *
+ *******************************************************************************/
+
+template <typename Te>
+__device__ __host__ inline Te rocblas_gemm_epilogue_activate(rocblas_gemm_epilogue_activation act,
+                                                             Te                               x)
+{
+    switch(act)
+    {
+    case rocblas_gemm_epilogue_activation_relu:
+        return x < 0 ? Te(0) : x;
+    case rocblas_gemm_epilogue_activation_gelu:
+        return Te(0.5) * x
+               * (1 + tanh(Te(0.7978845608028654) * (x + Te(0.044715) * x * x * x)));
+    default:
+        return x;
+    }
+}
+
+// Conversion to floating point output rounds to nearest
+template <typename To, typename Te, std::enable_if_t<!std::is_integral<To>{}, int> = 0>
+__device__ __host__ inline To rocblas_gemm_epilogue_convert(Te x)
+{
+    return To(x);
+}
+
+// Conversion to integer output rounds to nearest even and saturates. NaN becomes 0.
+template <typename To, typename Te, std::enable_if_t<std::is_integral<To>{}, int> = 0>
+__device__ __host__ inline To rocblas_gemm_epilogue_convert(Te x)
+{
+    if(x != x)
+        return 0;
+    if(x >= Te(std::numeric_limits<To>::max()))
+        return std::numeric_limits<To>::max();
+    if(x <= Te(std::numeric_limits<To>::lowest()))
+        return std::numeric_limits<To>::lowest();
+    return To(rint(x));
+}
+
+template <int DIM_X, int DIM_Y, typename Te, typename Tv, typename Td, typename To>
+ROCBLAS_KERNEL __launch_bounds__(DIM_X* DIM_Y) void rocblas_gemm_epilogue_kernel(
+    rocblas_int                      m,
+    rocblas_int                      n,
+    const Td*                        d,
+    rocblas_int                      ldd,
+    rocblas_stride                   stride_d,
+    rocblas_gemm_epilogue_vector     scale_mode,
+    const Tv*                        scale,
+    rocblas_stride                   stride_scale,
+    rocblas_gemm_epilogue_vector     bias_mode,
+    const Tv*                        bias,
+    rocblas_stride                   stride_bias,
+    rocblas_gemm_epilogue_activation activation,
+    bool                             clamp,
+    Te                               clamp_min,
+    Te                               clamp_max,
+    To*                              out,
+    rocblas_int                      ldo,
+    rocblas_stride                   stride_out)
+{
+    rocblas_int row = blockIdx.x * DIM_X + threadIdx.x;
+    rocblas_int col = blockIdx.y * DIM_Y + threadIdx.y;
+    if(row >= m || col >= n)
+        return;
+
+    // out may be d, so each element is read before it is written by the same thread
+    Te x = Te(d[blockIdx.z * stride_d + row + size_t(col) * ldd]);
+    if(scale_mode != rocblas_gemm_epilogue_vector_none)
+        x *= Te(scale[blockIdx.z * stride_scale
+                      + (scale_mode == rocblas_gemm_epilogue_vector_row ? row : col)]);
+    if(bias_mode != rocblas_gemm_epilogue_vector_none)
+        x += Te(bias[blockIdx.z * stride_bias
+                     + (bias_mode == rocblas_gemm_epilogue_vector_row ? row : col)]);
+    x = rocblas_gemm_epilogue_activate(activation, x);
+    if(clamp)
+        x = x < clamp_min ? clamp_min : x > clamp_max ? clamp_max : x;
+
+    out[blockIdx.z * stride_out + row + size_t(col) * ldo]
+        = rocblas_gemm_epilogue_convert<To>(x);
+}
+
+template <typename Te, typename Tv, typename Td, typename To>
+rocblas_status rocblas_gemm_epilogue_launch(rocblas_handle               handle,
+                                            rocblas_int                  m,
+                                            rocblas_int                  n,
+                                            const void*                  d,
+                                            rocblas_int                  ldd,
+                                            rocblas_stride               stride_d,
+                                            rocblas_int                  batch_count,
+                                            const rocblas_gemm_epilogue& epilogue)
+{
+    static constexpr int DIM_X = 64;
+    static constexpr int DIM_Y = 4;
+
+    // In place, the output is D
+    void*          out        = epilogue.out ? epilogue.out : (void*)d;
+    rocblas_int    ldo        = epilogue.out ? epilogue.ldo : ldd;
+    rocblas_stride stride_out = epilogue.out ? epilogue.stride_out : stride_d;
+
+    dim3 grid((m - 1) / DIM_X + 1, (n - 1) / DIM_Y + 1, batch_count);
+    dim3 threads(DIM_X, DIM_Y);
+    hipLaunchKernelGGL((rocblas_gemm_epilogue_kernel<DIM_X, DIM_Y, Te, Tv, Td, To>),
+                       grid,
+                       threads,
+                       0,
+                       handle->get_stream(),
+                       m,
+                       n,
+                       (const Td*)d,
+                       ldd,
+                       stride_d,
+                       epilogue.scale_mode,
+                       (const Tv*)epilogue.scale,
+                       epilogue.stride_scale,
+                       epilogue.bias_mode,
+                       (const Tv*)epilogue.bias,
+                       epilogue.stride_bias,
+                       epilogue.activation,
+                       epilogue.clamp,
+                       Te(epilogue.clamp_min),
+                       Te(epilogue.clamp_max),
+                       (To*)out,
+                       ldo,
+                       stride_out);
+    return rocblas_status_success;
+}
+
+// Output types supported for D of type Td
+template <typename Te, typename Tv, typename Td>
+rocblas_status rocblas_gemm_epilogue_dispatch(rocblas_handle               handle,
+                                              rocblas_int                  m,
+                                              rocblas_int                  n,
+                                              const void*                  d,
+                                              rocblas_int                  ldd,
+                                              rocblas_stride               stride_d,
+                                              rocblas_int                  batch_count,
+                                              const rocblas_gemm_epilogue& epilogue,
+                                              rocblas_datatype             out_type)
+{
+#define ROCBLAS_GEMM_EPILOGUE_LAUNCH(To_) \
+    rocblas_gemm_epilogue_launch<Te, Tv, Td, To_>(  \
+        handle, m, n, d, ldd, stride_d, batch_count, epilogue)
+
+    if constexpr(std::is_same<Td, double>{})
+    {
+        switch(out_type)
+        {
+        case rocblas_datatype_f64_r:
+            return ROCBLAS_GEMM_EPILOGUE_LAUNCH(double);
+        case rocblas_datatype_f32_r:
+            return ROCBLAS_GEMM_EPILOGUE_LAUNCH(float);
+        default:
+            return rocblas_status_not_implemented;
+        }
+    }
+    else
+    {
+        switch(out_type)
+        {
+        case rocblas_datatype_f16_r:
+            return ROCBLAS_GEMM_EPILOGUE_LAUNCH(rocblas_half);
+        case rocblas_datatype_bf16_r:
+            return ROCBLAS_GEMM_EPILOGUE_LAUNCH(rocblas_bfloat16);
+        case rocblas_datatype_f32_r:
+            return ROCBLAS_GEMM_EPILOGUE_LAUNCH(float);
+        case rocblas_datatype_i8_r:
+            return ROCBLAS_GEMM_EPILOGUE_LAUNCH(int8_t);
+        case rocblas_datatype_i32_r:
+            return ROCBLAS_GEMM_EPILOGUE_LAUNCH(int32_t);
+        default:
+            return rocblas_status_not_implemented;
+        }
+    }
+
+#undef ROCBLAS_GEMM_EPILOGUE_LAUNCH
+}
+
+// Whether the epilogue supports D of type d_type with output of type out_type
+inline bool rocblas_gemm_epilogue_supported(rocblas_datatype d_type, rocblas_datatype out_type)
+{
+    switch(d_type)
+    {
+    case rocblas_datatype_f64_r:
+        return out_type == rocblas_datatype_f64_r || out_type == rocblas_datatype_f32_r;
+    case rocblas_datatype_f16_r:
+    case rocblas_datatype_bf16_r:
+    case rocblas_datatype_f32_r:
+    case rocblas_datatype_i32_r:
+        return out_type == rocblas_datatype_f16_r || out_type == rocblas_datatype_bf16_r
+               || out_type == rocblas_datatype_f32_r || out_type == rocblas_datatype_i8_r
+               || out_type == rocblas_datatype_i32_r;
+    default:
+        return false;
+    }
+}
+
+/*! \brief Checks the epilogue of a gemm with d_type results. Returns rocblas_status_continue
+    if it can be applied. The pointers are not checked when the gemm is a quick return. */
+inline rocblas_status rocblas_gemm_epilogue_arg_check(const rocblas_gemm_epilogue* epilogue,
+                                                      rocblas_int                  m,
+                                                      rocblas_int                  n,
+                                                      rocblas_int                  batch_count,
+                                                      rocblas_datatype             d_type)
+{
+    if(!epilogue)
+        return rocblas_status_continue;
+
+    auto valid_vector = [](rocblas_gemm_epilogue_vector mode) {
+        return mode == rocblas_gemm_epilogue_vector_none
+               || mode == rocblas_gemm_epilogue_vector_row
+               || mode == rocblas_gemm_epilogue_vector_column;
+    };
+    if(!valid_vector(epilogue->scale_mode) || !valid_vector(epilogue->bias_mode))
+        return rocblas_status_invalid_value;
+    if(epilogue->activation != rocblas_gemm_epilogue_activation_none
+       && epilogue->activation != rocblas_gemm_epilogue_activation_relu
+       && epilogue->activation != rocblas_gemm_epilogue_activation_gelu)
+        return rocblas_status_invalid_value;
+    if(epilogue->clamp && !(epilogue->clamp_min <= epilogue->clamp_max))
+        return rocblas_status_invalid_value;
+
+    if(epilogue->out && epilogue->ldo < m)
+        return rocblas_status_invalid_size;
+
+    // In place, the output has the type of D and out_type is ignored
+    rocblas_datatype out_type = epilogue->out ? epilogue->out_type : d_type;
+    if(!rocblas_gemm_epilogue_supported(d_type, out_type))
+        return rocblas_status_not_implemented;
+
+    if(!m || !n || !batch_count)
+        return rocblas_status_success;
+
+    if((epilogue->scale_mode != rocblas_gemm_epilogue_vector_none && !epilogue->scale)
+       || (epilogue->bias_mode != rocblas_gemm_epilogue_vector_none && !epilogue->bias))
+        return rocblas_status_invalid_pointer;
+
+    return rocblas_status_continue;
+}
+
+/*! \brief Applies a checked epilogue to the batch_count m by n matrices of D */
+inline rocblas_status rocblas_gemm_epilogue_template(rocblas_handle               handle,
+                                                     rocblas_int                  m,
+                                                     rocblas_int                  n,
+                                                     const void*                  d,
+                                                     rocblas_datatype             d_type,
+                                                     rocblas_int                  ldd,
+                                                     rocblas_stride               stride_d,
+                                                     rocblas_int                  batch_count,
+                                                     const rocblas_gemm_epilogue& epilogue)
+{
+    if(!m || !n || !batch_count)
+        return rocblas_status_success;
+
+    // In place with no operation, D is already the result
+    if(!epilogue.out && epilogue.scale_mode == rocblas_gemm_epilogue_vector_none
+       && epilogue.bias_mode == rocblas_gemm_epilogue_vector_none
+       && epilogue.activation == rocblas_gemm_epilogue_activation_none && !epilogue.clamp)
+        return rocblas_status_success;
+
+    rocblas_datatype out_type = epilogue.out ? epilogue.out_type : d_type;
+    switch(d_type)
+    {
+    case rocblas_datatype_f16_r:
+        return rocblas_gemm_epilogue_dispatch<float, float, rocblas_half>(
+            handle, m, n, d, ldd, stride_d, batch_count, epilogue, out_type);
+    case rocblas_datatype_bf16_r:
+        return rocblas_gemm_epilogue_dispatch<float, float, rocblas_bfloat16>(
+            handle, m, n, d, ldd, stride_d, batch_count, epilogue, out_type);
+    case rocblas_datatype_f32_r:
+        return rocblas_gemm_epilogue_dispatch<float, float, float>(
+            handle, m, n, d, ldd, stride_d, batch_count, epilogue, out_type);
+    case rocblas_datatype_f64_r:
+        return rocblas_gemm_epilogue_dispatch<double, double, double>(
+            handle, m, n, d, ldd, stride_d, batch_count, epilogue, out_type);
+    case rocblas_datatype_i32_r:
+        // float would round int32 values above 2^24
+        return rocblas_gemm_epilogue_dispatch<double, float, int32_t>(
+            handle, m, n, d, ldd, stride_d, batch_count, epilogue, out_type);
+    default:
+        return rocblas_status_not_implemented;
+    }
+}
@@ -0,0 +1,386 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "handle.hpp"
+#include "logging.hpp"
+#include "rocblas.h"
+#include "rocblas_gemm_epilogue.hpp"
+#include "rocblas_gemm_ex.hpp"
+#include "utility.hpp"
+
+namespace
+{
+    rocblas_status rocblas_gemm_ex_epilogue_impl(const char*                  name,
+                                                 rocblas_handle               handle,
+                                                 rocblas_operation            trans_a,
+                                                 rocblas_operation            trans_b,
+                                                 rocblas_int                  m,
+                                                 rocblas_int                  n,
+                                                 rocblas_int                  k,
+                                                 const void*                  alpha,
+                                                 const void*                  a,
+                                                 rocblas_datatype             a_type,
+                                                 rocblas_int                  lda,
+                                                 rocblas_stride               stride_a,
+                                                 const void*                  b,
+                                                 rocblas_datatype             b_type,
+                                                 rocblas_int                  ldb,
+                                                 rocblas_stride               stride_b,
+                                                 const void*                  beta,
+                                                 const void*                  c,
+                                                 rocblas_datatype             c_type,
+                                                 rocblas_int                  ldc,
+                                                 rocblas_stride               stride_c,
+                                                 void*                        d,
+                                                 rocblas_datatype             d_type,
+                                                 rocblas_int                  ldd,
+                                                 rocblas_stride               stride_d,
+                                                 rocblas_int                  batch_count,
+                                                 rocblas_datatype             compute_type,
+                                                 rocblas_gemm_algo            algo,
+                                                 int32_t                      solution_index,
+                                                 uint32_t                     flags,
+                                                 const rocblas_gemm_epilogue* epilogue)
+    {
+        if(!handle)
+            return rocblas_status_invalid_handle;
+
+        rocblas_perf_scope perf(handle, name);
+
+        const bool HPA = compute_type == rocblas_datatype_f32_r
+                         && (a_type == rocblas_datatype_f16_r || a_type == rocblas_datatype_bf16_r);
+
+        // The epilogue needs no device memory
+        if(!HPA)
+            RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
+
+        // Copy alpha and beta to host if on device
+        rocblas_union_t alpha_h, beta_h;
+        RETURN_IF_ROCBLAS_ERROR(copy_alpha_beta_to_host_if_on_device(
+            handle, alpha, beta, alpha_h, beta_h, k, compute_type));
+        auto saved_pointer_mode = handle->push_pointer_mode(rocblas_pointer_mode_host);
+
+        if(!handle->is_device_memory_size_query())
+        {
+            // Perform logging. The epilogue cannot be given to rocblas-bench, so there is
+            // no bench logging.
+            auto layer_mode = handle->layer_mode;
+            if(layer_mode & (rocblas_layer_mode_log_trace | rocblas_layer_mode_log_profile))
+            {
+                auto a_type_string       = rocblas_datatype_string(a_type);
+                auto b_type_string       = rocblas_datatype_string(b_type);
+                auto c_type_string       = rocblas_datatype_string(c_type);
+                auto d_type_string       = rocblas_datatype_string(d_type);
+                auto compute_type_string = rocblas_datatype_string(compute_type);
+                auto out_type_string     = rocblas_datatype_string(
+                    epilogue && epilogue->out ? epilogue->out_type : d_type);
+
+                if(layer_mode & rocblas_layer_mode_log_trace)
+                {
+                    rocblas_internal_ostream alphass, betass;
+                    if(log_trace_alpha_beta_ex(compute_type, alpha, beta, alphass, betass)
+                       == rocblas_status_success)
+                    {
+                        log_trace(handle,
+                                  name,
+                                  trans_a,
+                                  trans_b,
+                                  m,
+                                  n,
+                                  k,
+                                  alphass.str(),
+                                  a,
+                                  a_type_string,
+                                  lda,
+                                  stride_a,
+                                  b,
+                                  b_type_string,
+                                  ldb,
+                                  stride_b,
+                                  betass.str(),
+                                  c,
+                                  c_type_string,
+                                  ldc,
+                                  stride_c,
+                                  d,
+                                  d_type_string,
+                                  ldd,
+                                  stride_d,
+                                  batch_count,
+                                  compute_type_string,
+                                  algo,
+                                  solution_index,
+                                  rocblas_gemm_flags(flags),
+                                  (const void*)epilogue);
+                    }
+                }
+
+                if(layer_mode & rocblas_layer_mode_log_profile)
+                {
+                    log_profile(handle,
+                                name,
+                                "a_type",
+                                a_type_string,
+                                "b_type",
+                                b_type_string,
+                                "c_type",
+                                c_type_string,
+                                "d_type",
+                                d_type_string,
+                                "compute_type",
+                                compute_type_string,
+                                "out_type",
+                                out_type_string,
+                                "transA",
+                                rocblas_transpose_letter(trans_a),
+                                "transB",
+                                rocblas_transpose_letter(trans_b),
+                                "M",
+                                m,
+                                "N",
+                                n,
+                                "K",
+                                k,
+                                "alpha",
+                                value_category(alpha, compute_type),
+                                "lda",
+                                lda,
+                                "ldb",
+                                ldb,
+                                "beta",
+                                value_category(beta, compute_type),
+                                "ldc",
+                                ldc,
+                                "ldd",
+                                ldd,
+                                "batch_count",
+                                batch_count,
+                                "activation",
+                                epilogue ? epilogue->activation
+                                         : rocblas_gemm_epilogue_activation_none,
+                                "algo",
+                                algo,
+                                "solution_index",
+                                solution_index,
+                                "flags",
+                                rocblas_gemm_flags(flags));
+                }
+            }
+        }
+
+        // The epilogue is checked before the gemm, so that no work is done if it fails
+        auto validArgs = validateArgs(handle,
+                                      trans_a,
+                                      trans_b,
+                                      m,
+                                      n,
+                                      k,
+                                      alpha,
+                                      a,
+                                      lda,
+                                      b,
+                                      ldb,
+                                      beta,
+                                      c,
+                                      ldc,
+                                      d,
+                                      ldd,
+                                      compute_type,
+                                      batch_count);
+        if(validArgs == rocblas_status_continue)
+            validArgs = rocblas_gemm_epilogue_arg_check(epilogue, m, n, batch_count, d_type);
+
+        if(validArgs != rocblas_status_continue)
+        {
+            if(validArgs == rocblas_status_success)
+                RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
+            return validArgs;
+        }
+
+        auto gemm_ex = [&] {
+            RETURN_IF_ROCBLAS_ERROR(rocblas_gemm_ex_template<false>(handle,
+                                                                    trans_a,
+                                                                    trans_b,
+                                                                    m,
+                                                                    n,
+                                                                    k,
+                                                                    alpha,
+                                                                    a,
+                                                                    a_type,
+                                                                    0,
+                                                                    lda,
+                                                                    stride_a,
+                                                                    b,
+                                                                    b_type,
+                                                                    0,
+                                                                    ldb,
+                                                                    stride_b,
+                                                                    beta,
+                                                                    c,
+                                                                    c_type,
+                                                                    0,
+                                                                    ldc,
+                                                                    stride_c,
+                                                                    d,
+                                                                    d_type,
+                                                                    0,
+                                                                    ldd,
+                                                                    stride_d,
+                                                                    batch_count,
+                                                                    compute_type,
+                                                                    flags));
+            if(!epilogue || handle->is_device_memory_size_query())
+                return rocblas_status_success;
+            return rocblas_gemm_epilogue_template(
+                handle, m, n, d, d_type, ldd, stride_d, batch_count, *epilogue);
+        };
+
+        if(HPA && !handle->is_device_memory_size_query())
+        {
+            // Allocate GSU workspace in handle
+            auto gsu_malloc = handle->gsu_malloc();
+            return gemm_ex();
+        }
+        else
+        {
+            return gemm_ex();
+        }
+    }
+} // namespace
+
+extern "C" rocblas_status rocblas_gemm_ex_epilogue(rocblas_handle               handle,
+                                                   rocblas_operation            trans_a,
+                                                   rocblas_operation            trans_b,
+                                                   rocblas_int                  m,
+                                                   rocblas_int                  n,
+                                                   rocblas_int                  k,
+                                                   const void*                  alpha,
+                                                   const void*                  a,
+                                                   rocblas_datatype             a_type,
+                                                   rocblas_int                  lda,
+                                                   const void*                  b,
+                                                   rocblas_datatype             b_type,
+                                                   rocblas_int                  ldb,
+                                                   const void*                  beta,
+                                                   const void*                  c,
+                                                   rocblas_datatype             c_type,
+                                                   rocblas_int                  ldc,
+                                                   void*                        d,
+                                                   rocblas_datatype             d_type,
+                                                   rocblas_int                  ldd,
+                                                   rocblas_datatype             compute_type,
+                                                   rocblas_gemm_algo            algo,
+                                                   int32_t                      solution_index,
+                                                   uint32_t                     flags,
+                                                   const rocblas_gemm_epilogue* epilogue)
+try
+{
+    // TODO: These strides could be 0 ( {} ) instead of 1 ( {1} ) once Tensile is fixed,
+    // as in rocblas_gemm_ex. With one batch the epilogue does not use them.
+    return rocblas_gemm_ex_epilogue_impl("rocblas_gemm_ex_epilogue",
+                                         handle,
+                                         trans_a,
+                                         trans_b,
+                                         m,
+                                         n,
+                                         k,
+                                         alpha,
+                                         a,
+                                         a_type,
+                                         lda,
+                                         1,
+                                         b,
+                                         b_type,
+                                         ldb,
+                                         1,
+                                         beta,
+                                         c,
+                                         c_type,
+                                         ldc,
+                                         1,
+                                         d,
+                                         d_type,
+                                         ldd,
+                                         1,
+                                         1,
+                                         compute_type,
+                                         algo,
+                                         solution_index,
+                                         flags,
+                                         epilogue);
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status
+    rocblas_gemm_strided_batched_ex_epilogue(rocblas_handle               handle,
+                                             rocblas_operation            trans_a,
+                                             rocblas_operation            trans_b,
+                                             rocblas_int                  m,
+                                             rocblas_int                  n,
+                                             rocblas_int                  k,
+                                             const void*                  alpha,
+                                             const void*                  a,
+                                             rocblas_datatype             a_type,
+                                             rocblas_int                  lda,
+                                             rocblas_stride               stride_a,
+                                             const void*                  b,
+                                             rocblas_datatype             b_type,
+                                             rocblas_int                  ldb,
+                                             rocblas_stride               stride_b,
+                                             const void*                  beta,
+                                             const void*                  c,
+                                             rocblas_datatype             c_type,
+                                             rocblas_int                  ldc,
+                                             rocblas_stride               stride_c,
+                                             void*                        d,
+                                             rocblas_datatype             d_type,
+                                             rocblas_int                  ldd,
+                                             rocblas_stride               stride_d,
+                                             rocblas_int                  batch_count,
+                                             rocblas_datatype             compute_type,
+                                             rocblas_gemm_algo            algo,
+                                             int32_t                      solution_index,
+                                             uint32_t                     flags,
+                                             const rocblas_gemm_epilogue* epilogue)
+try
+{
+    return rocblas_gemm_ex_epilogue_impl("rocblas_gemm_strided_batched_ex_epilogue",
+                                         handle,
+                                         trans_a,
+                                         trans_b,
+                                         m,
+                                         n,
+                                         k,
+                                         alpha,
+                                         a,
+                                         a_type,
+                                         lda,
+                                         stride_a,
+                                         b,
+                                         b_type,
+                                         ldb,
+                                         stride_b,
+                                         beta,
+                                         c,
+                                         c_type,
+                                         ldc,
+                                         stride_c,
+                                         d,
+                                         d_type,
+                                         ldd,
+                                         stride_d,
+                                         batch_count,
+                                         compute_type,
+                                         algo,
+                                         solution_index,
+                                         flags,
+                                         epilogue);
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
@@ -176,6 +176,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(handle, "rocblas_gemm_ext2");
+
         const bool HPA = compute_type == rocblas_datatype_f32_r
                          && (a_type == rocblas_datatype_f16_r || a_type == rocblas_datatype_bf16_r);
 
@@ -446,13 +448,13 @@ namespace
             std::unique_ptr<char[]> hd{new char[rocblas_sizeof_datatype(d_type) * size_d]};
 
             if(a)
-                RETURN_IF_HIP_ERROR(hipMemcpy(
+                RETURN_IF_ROCBLAS_ERROR(handle->sync.copy(
                     ha.get(), a, rocblas_sizeof_datatype(a_type) * size_a, hipMemcpyDeviceToHost));
             if(b)
-                RETURN_IF_HIP_ERROR(hipMemcpy(
+                RETURN_IF_ROCBLAS_ERROR(handle->sync.copy(
                     hb.get(), b, rocblas_sizeof_datatype(b_type) * size_b, hipMemcpyDeviceToHost));
             if(c)
-                RETURN_IF_HIP_ERROR(hipMemcpy(
+                RETURN_IF_ROCBLAS_ERROR(handle->sync.copy(
                     hc.get(), c, rocblas_sizeof_datatype(c_type) * size_c, hipMemcpyDeviceToHost));
 
             rocblas_status status = gemm_dispatch<reference_gemm_ext2_call>(a_type,
@@ -479,7 +481,7 @@ namespace
                                                                             col_stride_d);
 
             if(status == rocblas_status_success)
-                RETURN_IF_HIP_ERROR(hipMemcpy(
+                RETURN_IF_ROCBLAS_ERROR(handle->sync.copy(
                     d, hd.get(), rocblas_sizeof_datatype(d_type) * size_d, hipMemcpyHostToDevice));
 
             return status;
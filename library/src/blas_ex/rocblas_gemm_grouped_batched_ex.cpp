@@ -0,0 +1,348 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#include "handle.hpp"
+#include "logging.hpp"
+#include "rocblas.h"
+#include "rocblas_gemm_ex.hpp"
+#include "rocblas_gemm_grouped_plan.hpp"
+#include "utility.hpp"
+
+namespace
+{
+    constexpr int    GATHER_NB         = 256;
+    constexpr int    GATHER_MAX_BLOCKS = 64;
+    constexpr size_t GATHER_SEGMENTS   = rocblas_gemm_grouped_plan::SEGMENTS_PER_GATHER;
+
+    // The A, B, C and D pointer arrays, and the segments copied by one gather launch.
+    // It is passed by value, so the segments need no copy to the device.
+    struct rocblas_gemm_grouped_gather_args
+    {
+        const void* const*        src[4];
+        const void**              dst[4];
+        rocblas_gemm_grouped_copy copies[GATHER_SEGMENTS];
+    };
+
+    ROCBLAS_KERNEL __launch_bounds__(GATHER_NB) void rocblas_gemm_grouped_gather_kernel(
+        rocblas_gemm_grouped_gather_args args)
+    {
+        const auto& copy = args.copies[blockIdx.y];
+        for(size_t i = blockIdx.x * size_t(GATHER_NB) + threadIdx.x; i < copy.count;
+            i += gridDim.x * size_t(GATHER_NB))
+        {
+            for(int j = 0; j < 4; ++j)
+                if(args.src[j])
+                    args.dst[j][copy.dst + i] = args.src[j][copy.src + i];
+        }
+    }
+
+    // Copy the segments of the plan into the gathered pointer arrays
+    rocblas_status gather_pointers(rocblas_handle                   handle,
+                                   const rocblas_gemm_grouped_plan& plan,
+                                   const void* const*               src[4],
+                                   const void**                     dst[4])
+    {
+        const auto& copies = plan.copies();
+        for(size_t first = 0; first < copies.size(); first += GATHER_SEGMENTS)
+        {
+            rocblas_gemm_grouped_gather_args args;
+
+            size_t segments = std::min(copies.size() - first, GATHER_SEGMENTS);
+            size_t count    = 0;
+            for(int j = 0; j < 4; ++j)
+            {
+                args.src[j] = src[j];
+                args.dst[j] = dst[j];
+            }
+            for(size_t s = 0; s < segments; ++s)
+            {
+                args.copies[s] = copies[first + s];
+                count          = std::max(count, copies[first + s].count);
+            }
+
+            dim3 grid(std::min((count - 1) / GATHER_NB + 1, size_t(GATHER_MAX_BLOCKS)), segments);
+            dim3 threads(GATHER_NB);
+            hipLaunchKernelGGL(
+                rocblas_gemm_grouped_gather_kernel, grid, threads, 0, handle->get_stream(), args);
+        }
+        return rocblas_status_success;
+    }
+}
+
+extern "C" rocblas_status rocblas_gemm_grouped_batched_ex(rocblas_handle           handle,
+                                                          rocblas_int              group_count,
+                                                          const rocblas_operation* trans_a,
+                                                          const rocblas_operation* trans_b,
+                                                          const rocblas_int*       m,
+                                                          const rocblas_int*       n,
+                                                          const rocblas_int*       k,
+                                                          const void*              alpha,
+                                                          const void*              a,
+                                                          rocblas_datatype         a_type,
+                                                          const rocblas_int*       lda,
+                                                          const void*              b,
+                                                          rocblas_datatype         b_type,
+                                                          const rocblas_int*       ldb,
+                                                          const void*              beta,
+                                                          const void*              c,
+                                                          rocblas_datatype         c_type,
+                                                          const rocblas_int*       ldc,
+                                                          void*                    d,
+                                                          rocblas_datatype         d_type,
+                                                          const rocblas_int*       ldd,
+                                                          const rocblas_int*       group_size,
+                                                          rocblas_datatype         compute_type,
+                                                          rocblas_gemm_algo        algo,
+                                                          int32_t                  solution_index,
+                                                          uint32_t                 flags)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    rocblas_perf_scope perf(handle, "rocblas_gemm_grouped_batched_ex");
+
+    if(!handle->is_device_memory_size_query())
+    {
+        // Perform logging. The per-group arrays are not logged, and there is no
+        // rocblas-bench equivalent of a grouped call.
+        auto layer_mode = handle->layer_mode;
+        if(layer_mode & (rocblas_layer_mode_log_trace | rocblas_layer_mode_log_profile))
+        {
+            auto a_type_string       = rocblas_datatype_string(a_type);
+            auto b_type_string       = rocblas_datatype_string(b_type);
+            auto c_type_string       = rocblas_datatype_string(c_type);
+            auto d_type_string       = rocblas_datatype_string(d_type);
+            auto compute_type_string = rocblas_datatype_string(compute_type);
+
+            if(layer_mode & rocblas_layer_mode_log_trace)
+                log_trace(handle,
+                          "rocblas_gemm_grouped_batched_ex",
+                          group_count,
+                          a,
+                          a_type_string,
+                          b,
+                          b_type_string,
+                          c,
+                          c_type_string,
+                          d,
+                          d_type_string,
+                          compute_type_string,
+                          algo,
+                          solution_index,
+                          rocblas_gemm_flags(flags));
+
+            if(layer_mode & rocblas_layer_mode_log_profile)
+                log_profile(handle,
+                            "rocblas_gemm_grouped_batched_ex",
+                            "a_type",
+                            a_type_string,
+                            "b_type",
+                            b_type_string,
+                            "c_type",
+                            c_type_string,
+                            "d_type",
+                            d_type_string,
+                            "compute_type",
+                            compute_type_string,
+                            "group_count",
+                            group_count,
+                            "algo",
+                            algo,
+                            "solution_index",
+                            solution_index,
+                            "flags",
+                            rocblas_gemm_flags(flags));
+        }
+    }
+
+    if(group_count < 0)
+        return rocblas_status_invalid_size;
+
+    if(!group_count)
+    {
+        RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
+        return rocblas_status_success;
+    }
+
+    if(!trans_a || !trans_b || !m || !n || !k || !lda || !ldb || !ldc || !ldd || !group_size)
+        return rocblas_status_invalid_pointer;
+
+    // Check the sizes of every group before anything is launched
+    size_t problems = 0;
+    bool   empty    = true;
+    for(rocblas_int g = 0; g < group_count; ++g)
+    {
+        if(m[g] < 0 || n[g] < 0 || k[g] < 0 || group_size[g] < 0)
+            return rocblas_status_invalid_size;
+        if(ldc[g] < m[g] || ldd[g] < m[g]
+           || lda[g] < (trans_a[g] == rocblas_operation_none ? m[g] : k[g])
+           || ldb[g] < (trans_b[g] == rocblas_operation_none ? k[g] : n[g]))
+            return rocblas_status_invalid_size;
+        problems += group_size[g];
+        if(m[g] && n[g] && group_size[g])
+            empty = false;
+    }
+
+    if(empty)
+    {
+        RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
+        return rocblas_status_success;
+    }
+
+    if(!alpha || !beta || !d)
+        return rocblas_status_invalid_pointer;
+
+    size_t scalar_size = rocblas_sizeof_datatype(compute_type);
+    if(!scalar_size || scalar_size > sizeof(rocblas_union_t))
+        return rocblas_status_not_implemented;
+
+    // The gathered pointer arrays hold at most every problem. Without the values
+    // of alpha and beta, which are not copied from the device in a size query,
+    // the size needed for that is reported.
+    if(handle->is_device_memory_size_query())
+        return handle->set_optimal_device_memory_size(4 * problems * sizeof(void*));
+
+    // The plan compares the scalars, so in device pointer mode they are copied to
+    // the host with one synchronization for all groups
+    std::vector<unsigned char> scalars;
+    const unsigned char*       alpha_h = static_cast<const unsigned char*>(alpha);
+    const unsigned char*       beta_h  = static_cast<const unsigned char*>(beta);
+    if(handle->pointer_mode == rocblas_pointer_mode_device)
+    {
+        size_t bytes = scalar_size * group_count;
+        scalars.resize(2 * bytes);
+        RETURN_IF_HIP_ERROR(hipMemcpyAsync(
+            scalars.data(), alpha, bytes, hipMemcpyDeviceToHost, handle->get_stream()));
+        RETURN_IF_HIP_ERROR(hipMemcpyAsync(
+            scalars.data() + bytes, beta, bytes, hipMemcpyDeviceToHost, handle->get_stream()));
+        RETURN_IF_ROCBLAS_ERROR(handle->sync.stream_synchronize(handle->get_stream()));
+        alpha_h = scalars.data();
+        beta_h  = scalars.data() + bytes;
+    }
+    auto saved_pointer_mode = handle->push_pointer_mode(rocblas_pointer_mode_host);
+
+    std::vector<rocblas_gemm_group> groups(group_count);
+    for(rocblas_int g = 0; g < group_count; ++g)
+    {
+        auto& group      = groups[g];
+        group.trans_a    = trans_a[g];
+        group.trans_b    = trans_b[g];
+        group.m          = m[g];
+        group.n          = n[g];
+        group.k          = k[g];
+        group.lda        = lda[g];
+        group.ldb        = ldb[g];
+        group.ldc        = ldc[g];
+        group.ldd        = ldd[g];
+        group.group_size = group_size[g];
+        memcpy(&group.alpha, alpha_h + g * scalar_size, scalar_size);
+        memcpy(&group.beta, beta_h + g * scalar_size, scalar_size);
+
+        // Check the pointers, which may be null when the scalars allow it
+        auto validArgs = validateArgs(handle,
+                                      group.trans_a,
+                                      group.trans_b,
+                                      group.m,
+                                      group.n,
+                                      group.k,
+                                      &group.alpha,
+                                      a,
+                                      group.lda,
+                                      b,
+                                      group.ldb,
+                                      &group.beta,
+                                      c,
+                                      group.ldc,
+                                      d,
+                                      group.ldd,
+                                      compute_type,
+                                      group.group_size);
+        if(validArgs != rocblas_status_continue && validArgs != rocblas_status_success)
+            return validArgs;
+    }
+
+    rocblas_gemm_grouped_plan plan(groups.data(), groups.size(), scalar_size);
+
+    const void* const* src[4] = {static_cast<const void* const*>(a),
+                                 static_cast<const void* const*>(b),
+                                 static_cast<const void* const*>(c),
+                                 static_cast<const void* const*>(d)};
+    const void**       dst[4] = {};
+
+    auto w_mem = handle->device_malloc(4 * plan.gathered() * sizeof(void*));
+    if(!w_mem)
+        return rocblas_status_memory_error;
+    if(plan.gathered())
+    {
+        for(int j = 0; j < 4; ++j)
+            if(src[j])
+                dst[j] = static_cast<const void**>((void*)w_mem) + j * plan.gathered();
+        RETURN_IF_ROCBLAS_ERROR(gather_pointers(handle, plan, src, dst));
+    }
+
+    const bool HPA = compute_type == rocblas_datatype_f32_r
+                     && (a_type == rocblas_datatype_f16_r || a_type == rocblas_datatype_bf16_r);
+
+    auto gemm_launches = [&] {
+        for(const auto& launch : plan.launches())
+        {
+            const auto&        group = groups[launch.group];
+            const void* const* ptrs[4];
+            for(int j = 0; j < 4; ++j)
+            {
+                const void* const* base = launch.gathered ? dst[j] : src[j];
+                ptrs[j]                 = base ? base + launch.offset : nullptr;
+            }
+
+            RETURN_IF_ROCBLAS_ERROR(rocblas_gemm_ex_template<true>(handle,
+                                                                   group.trans_a,
+                                                                   group.trans_b,
+                                                                   group.m,
+                                                                   group.n,
+                                                                   group.k,
+                                                                   &group.alpha,
+                                                                   ptrs[0],
+                                                                   a_type,
+                                                                   0,
+                                                                   group.lda,
+                                                                   0,
+                                                                   ptrs[1],
+                                                                   b_type,
+                                                                   0,
+                                                                   group.ldb,
+                                                                   0,
+                                                                   &group.beta,
+                                                                   ptrs[2],
+                                                                   c_type,
+                                                                   0,
+                                                                   group.ldc,
+                                                                   0,
+                                                                   (void*)ptrs[3],
+                                                                   d_type,
+                                                                   0,
+                                                                   group.ldd,
+                                                                   0,
+                                                                   launch.batch_count,
+                                                                   compute_type,
+                                                                   flags));
+        }
+        return rocblas_status_success;
+    };
+
+    if(HPA)
+    {
+        // Allocate GSU workspace in handle
+        auto gsu_malloc = handle->gsu_malloc();
+        return gemm_launches();
+    }
+    else
+    {
+        return gemm_launches();
+    }
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
@@ -23,6 +23,8 @@ namespace
             return rocblas_status_invalid_handle;
         }
 
+        rocblas_perf_scope perf(handle, "rocblas_nrm2_ex");
+
         size_t dev_bytes = rocblas_reduction_kernel_workspace_size<NB>(n, 1, execution_type);
 
         if(handle->is_device_memory_size_query())
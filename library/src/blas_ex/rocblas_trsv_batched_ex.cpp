@@ -28,6 +28,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(handle, "rocblas_trsv_batched_ex");
+
         if(!handle->is_device_memory_size_query())
         {
             auto layer_mode = handle->layer_mode;
@@ -27,6 +27,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        rocblas_perf_scope perf(handle, "rocblas_trsv_ex");
+
         auto layer_mode = handle->layer_mode;
         if(layer_mode & rocblas_layer_mode_log_trace)
             log_trace(handle, "rocblas_trsv_ex", uplo, transA, diag, m, A, lda, B, incx);
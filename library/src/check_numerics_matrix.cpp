@@ -48,18 +48,6 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     if(!m || !n || !batch_count || !A)
         return rocblas_status_success;
 
-    //Creating structure host object
-    rocblas_check_numerics_t h_abnormal;
-
-    //Allocating memory for device structure
-    auto d_abnormal = handle->device_malloc(sizeof(rocblas_check_numerics_t));
-
-    //Transferring the rocblas_check_numerics_t structure from host to the device
-    RETURN_IF_HIP_ERROR(hipMemcpy((rocblas_check_numerics_t*)d_abnormal,
-                                  &h_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyHostToDevice));
-
     //Checking trans_a to transpose a matrix 'A'
     rocblas_int num_rows_a = trans_a == rocblas_operation_none ? m : n;
     rocblas_int num_cols_a = trans_a == rocblas_operation_none ? n : m;
@@ -73,24 +61,53 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     dim3 blocks(blocks_X, blocks_Y, batch_count);
     dim3 threads(DIM_X, DIM_Y);
 
-    hipLaunchKernelGGL(rocblas_check_numerics_ge_matrix_kernel,
-                       blocks,
-                       threads,
-                       0,
-                       rocblas_stream,
-                       num_rows_a,
-                       num_cols_a,
-                       A,
-                       offset_a,
-                       lda,
-                       stride_a,
-                       (rocblas_check_numerics_t*)d_abnormal);
+    auto launch = [&](rocblas_check_numerics_t* d_abnormal, uint32_t seq) {
+        hipLaunchKernelGGL(rocblas_check_numerics_ge_matrix_kernel,
+                           blocks,
+                           threads,
+                           0,
+                           rocblas_stream,
+                           num_rows_a,
+                           num_cols_a,
+                           A,
+                           offset_a,
+                           lda,
+                           stride_a,
+                           d_abnormal,
+                           seq);
+    };
+
+    //In deferred mode, accumulating the results on the device without synchronizing
+    if(check_numerics & rocblas_check_numerics_mode_deferred)
+    {
+        rocblas_check_numerics_t* d_abnormal;
+        uint32_t                  seq;
+        RETURN_IF_ROCBLAS_ERROR(rocblas_check_numerics_deferred_begin(
+            handle, function_name, is_input, d_abnormal, seq));
+        if(d_abnormal)
+            launch(d_abnormal, seq);
+        return rocblas_status_success;
+    }
+
+    //Creating structure host object
+    rocblas_check_numerics_t h_abnormal;
+
+    //Allocating memory for device structure
+    auto d_abnormal = handle->device_malloc(sizeof(rocblas_check_numerics_t));
+
+    //Transferring the rocblas_check_numerics_t structure from host to the device
+    RETURN_IF_ROCBLAS_ERROR(handle->sync.copy((rocblas_check_numerics_t*)d_abnormal,
+                                              &h_abnormal,
+                                              sizeof(rocblas_check_numerics_t),
+                                              hipMemcpyHostToDevice));
+
+    launch((rocblas_check_numerics_t*)d_abnormal, 0);
 
     //Transferring the rocblas_check_numerics_t structure from device to the host
-    RETURN_IF_HIP_ERROR(hipMemcpy(&h_abnormal,
-                                  (rocblas_check_numerics_t*)d_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyDeviceToHost));
+    RETURN_IF_ROCBLAS_ERROR(handle->sync.copy(&h_abnormal,
+                                              (rocblas_check_numerics_t*)d_abnormal,
+                                              sizeof(rocblas_check_numerics_t),
+                                              hipMemcpyDeviceToHost));
 
     return rocblas_check_numerics_abnormal_struct(
         function_name, check_numerics, is_input, &h_abnormal);
@@ -55,6 +55,36 @@ rocblas_status rocblas_check_numerics_abnormal_struct(const char*
     }
     return rocblas_status_success;
 }
+
+rocblas_status rocblas_check_numerics_deferred_begin(rocblas_handle             handle,
+                                                     const char*                function_name,
+                                                     bool                       is_input,
+                                                     rocblas_check_numerics_t*& d_abnormal,
+                                                     uint32_t&                  seq)
+{
+    d_abnormal = nullptr;
+    seq        = handle->check_numerics_deferred.begin(function_name, is_input);
+    if(!seq)
+        return rocblas_status_success;
+
+    d_abnormal = handle->get_check_numerics_deferred_results();
+    if(d_abnormal)
+        return rocblas_status_success;
+    return handle->sync.capture_safe() ? rocblas_status_capture_unsafe
+                                       : rocblas_status_memory_error;
+}
+
+void rocblas_check_numerics_deferred_host(rocblas_handle                  handle,
+                                          const char*                     function_name,
+                                          bool                            is_input,
+                                          const rocblas_check_numerics_t& h_abnormal)
+{
+    uint32_t seq = handle->check_numerics_deferred.begin(function_name, is_input);
+    if(seq)
+        handle->check_numerics_deferred.record_host(
+            seq, h_abnormal.has_NaN, h_abnormal.has_zero, h_abnormal.has_Inf);
+}
+
 /**
   *
   * rocblas_internal_check_numerics_vector_template(function_name, handle, n, x, offset_x, inc_x, stride_x, batch_count, check_numerics, is_input)
@@ -100,6 +130,38 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
         return rocblas_status_success;
     }
 
+    hipStream_t           rocblas_stream = handle->get_stream();
+    constexpr rocblas_int NB             = 256;
+    dim3                  blocks((n - 1) / NB + 1, batch_count);
+    dim3                  threads(NB);
+
+    auto launch = [&](rocblas_check_numerics_t* d_abnormal, uint32_t seq) {
+        hipLaunchKernelGGL(rocblas_check_numerics_vector_kernel,
+                           blocks,
+                           threads,
+                           0,
+                           rocblas_stream,
+                           n,
+                           x,
+                           offset_x,
+                           inc_x,
+                           stride_x,
+                           d_abnormal,
+                           seq);
+    };
+
+    //In deferred mode, accumulating the results on the device without synchronizing
+    if(check_numerics & rocblas_check_numerics_mode_deferred)
+    {
+        rocblas_check_numerics_t* d_abnormal;
+        uint32_t                  seq;
+        RETURN_IF_ROCBLAS_ERROR(rocblas_check_numerics_deferred_begin(
+            handle, function_name, is_input, d_abnormal, seq));
+        if(d_abnormal)
+            launch(d_abnormal, seq);
+        return rocblas_status_success;
+    }
+
     //Creating structure host object
     rocblas_check_numerics_t h_abnormal;
 
@@ -107,33 +169,18 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     auto d_abnormal = handle->device_malloc(sizeof(rocblas_check_numerics_t));
 
     //Transferring the rocblas_check_numerics_t structure from host to the device
-    RETURN_IF_HIP_ERROR(hipMemcpy((rocblas_check_numerics_t*)d_abnormal,
-                                  &h_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyHostToDevice));
-
-    hipStream_t           rocblas_stream = handle->get_stream();
-    constexpr rocblas_int NB             = 256;
-    dim3                  blocks((n - 1) / NB + 1, batch_count);
-    dim3                  threads(NB);
+    RETURN_IF_ROCBLAS_ERROR(handle->sync.copy((rocblas_check_numerics_t*)d_abnormal,
+                                              &h_abnormal,
+                                              sizeof(rocblas_check_numerics_t),
+                                              hipMemcpyHostToDevice));
 
-    hipLaunchKernelGGL(rocblas_check_numerics_vector_kernel,
-                       blocks,
-                       threads,
-                       0,
-                       rocblas_stream,
-                       n,
-                       x,
-                       offset_x,
-                       inc_x,
-                       stride_x,
-                       (rocblas_check_numerics_t*)d_abnormal);
+    launch((rocblas_check_numerics_t*)d_abnormal, 0);
 
     //Transferring the rocblas_check_numerics_t structure from device to the host
-    RETURN_IF_HIP_ERROR(hipMemcpy(&h_abnormal,
-                                  (rocblas_check_numerics_t*)d_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyDeviceToHost));
+    RETURN_IF_ROCBLAS_ERROR(handle->sync.copy(&h_abnormal,
+                                              (rocblas_check_numerics_t*)d_abnormal,
+                                              sizeof(rocblas_check_numerics_t),
+                                              hipMemcpyDeviceToHost));
 
     return rocblas_check_numerics_abnormal_struct(
         function_name, check_numerics, is_input, &h_abnormal);
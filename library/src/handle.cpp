@@ -2,7 +2,10 @@
  * Copyright 2016-2021 Advanced Micro Devices, Inc.
  * ************************************************************************ */
 #include "handle.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cstdarg>
+#include <fstream>
 #include <limits>
 #ifdef WIN32
 #include <windows.h>
@@ -21,6 +24,7 @@ extern "C" void rocblas_initialize() {}
 // forcing early cleanup
 extern "C" void rocblas_shutdown()
 {
+    rocblas_internal_ostream::flush_workers();
     rocblas_internal_ostream::clear_workers();
 }
 
@@ -51,6 +55,30 @@ extern "C" void rocblas_device_malloc_set_default_memory_size(size_t size)
     t_rocblas_device_malloc_default_memory_size = size;
 }
 
+// The launch tuning entries of ROCBLAS_LAUNCH_TUNING_FILE, followed by those compiled into
+// rocBLAS. The file is read once, by the first handle created.
+static const rocblas_launch_tuning_table& rocblas_launch_tuning_defaults()
+{
+    static const rocblas_launch_tuning_table table = [] {
+        rocblas_launch_tuning_table table;
+        std::string                 error;
+        const char*                 file = read_env("ROCBLAS_LAUNCH_TUNING_FILE");
+        if(file && *file)
+        {
+            std::ifstream is(file);
+            if(!is)
+                error = "cannot be opened";
+            if(!is || !table.parse(is, error))
+                rocblas_cerr << "rocBLAS warning: ignoring ROCBLAS_LAUNCH_TUNING_FILE " << file
+                             << ": " << error << std::endl;
+        }
+        if(!table.parse(rocblas_launch_tuning_default_table, error))
+            throw std::logic_error("rocblas_launch_tuning_default_table " + error);
+        return table;
+    }();
+    return table;
+}
+
 static inline int getActiveDevice()
 {
     int device;
@@ -65,6 +93,215 @@ static inline int getActiveArch(int deviceId)
     return deviceProperties.gcnArch;
 }
 
+/*******************************************************************************
+ * Device memory pool backend
+ * The pool is only used with the HIP default device set to the pool's device.
+ * Memory is allocated and freed through the sync interceptor of the handle on
+ * whose behalf the pool is used, or directly without one.
+ ******************************************************************************/
+void* rocblas_hip_memory_backend::allocate(size_t size, rocblas_hip_sync_interceptor* sync)
+{
+    void*          ptr    = nullptr;
+    rocblas_status status = sync ? sync->device_allocate(&ptr, size)
+                                 : rocblas_hip_sync_backend{}.device_allocate(&ptr, size);
+    return status == rocblas_status_success ? ptr : nullptr;
+}
+
+void rocblas_hip_memory_backend::deallocate(void* ptr, rocblas_hip_sync_interceptor* sync)
+{
+    if(sync)
+        sync->device_free(ptr);
+    else
+        rocblas_hip_sync_backend{}.device_free(ptr);
+}
+
+void rocblas_hip_memory_backend::record(hipEvent_t& event, hipStream_t stream)
+{
+    if(!event)
+        PRINT_IF_HIP_ERROR(hipEventCreateWithFlags(&event, hipEventDisableTiming));
+    PRINT_IF_HIP_ERROR(hipEventRecord(event, stream));
+}
+
+void rocblas_hip_memory_backend::wait(hipEvent_t& event, hipStream_t stream)
+{
+    if(event)
+        PRINT_IF_HIP_ERROR(hipStreamWaitEvent(stream, event, 0));
+}
+
+void rocblas_hip_memory_backend::destroy(hipEvent_t& event)
+{
+    if(event)
+        PRINT_IF_HIP_ERROR(hipEventDestroy(event));
+    event = nullptr;
+}
+
+/*******************************************************************************
+ * Sync interceptor backend
+ ******************************************************************************/
+rocblas_status
+    rocblas_hip_sync_backend::copy(void* dst, const void* src, size_t size, hipMemcpyKind kind)
+{
+    RETURN_IF_HIP_ERROR(hipMemcpy(dst, src, size, kind));
+    return rocblas_status_success;
+}
+
+rocblas_status rocblas_hip_sync_backend::stream_synchronize(hipStream_t stream)
+{
+    RETURN_IF_HIP_ERROR(hipStreamSynchronize(stream));
+    return rocblas_status_success;
+}
+
+rocblas_status rocblas_hip_sync_backend::event_synchronize(hipEvent_t event)
+{
+    RETURN_IF_HIP_ERROR(hipEventSynchronize(event));
+    return rocblas_status_success;
+}
+
+rocblas_status rocblas_hip_sync_backend::device_allocate(void** ptr, size_t size)
+{
+    hipError_t status = (hipMalloc)(ptr, size);
+    if(status != hipSuccess)
+        *ptr = nullptr;
+    return get_rocblas_status_for_hip_status(status);
+}
+
+rocblas_status rocblas_hip_sync_backend::device_free(void* ptr)
+{
+    RETURN_IF_HIP_ERROR((hipFree)(ptr));
+    return rocblas_status_success;
+}
+
+rocblas_status rocblas_hip_sync_backend::host_allocate(void** ptr, size_t size)
+{
+    hipError_t status = hipHostMalloc(ptr, size);
+    if(status != hipSuccess)
+        *ptr = nullptr;
+    return get_rocblas_status_for_hip_status(status);
+}
+
+rocblas_status rocblas_hip_sync_backend::host_free(void* ptr)
+{
+    RETURN_IF_HIP_ERROR(hipHostFree(ptr));
+    return rocblas_status_success;
+}
+
+/*******************************************************************************
+ * Host result staging backend
+ ******************************************************************************/
+void* rocblas_hip_host_result_backend::allocate(size_t size)
+{
+    void* ptr = nullptr;
+    return sync->host_allocate(&ptr, size) == rocblas_status_success ? ptr : nullptr;
+}
+
+void rocblas_hip_host_result_backend::deallocate(void* ptr)
+{
+    PRINT_IF_HIP_ERROR(hipHostFree(ptr));
+}
+
+rocblas_status rocblas_hip_host_result_backend::copy_async(void*       dst,
+                                                           const void* src,
+                                                           size_t      size,
+                                                           hipStream_t stream)
+{
+    RETURN_IF_HIP_ERROR(hipMemcpyAsync(dst, src, size, hipMemcpyDeviceToHost, stream));
+    return rocblas_status_success;
+}
+
+rocblas_status rocblas_hip_host_result_backend::synchronize(hipStream_t stream)
+{
+    return sync->stream_synchronize(stream);
+}
+
+rocblas_status rocblas_hip_host_result_backend::enqueue(hipStream_t               stream,
+                                                        rocblas_host_result_slot* slot)
+{
+    auto callback = [](hipStream_t, hipError_t, void* slot) {
+        rocblas_host_result_slot::complete(static_cast<rocblas_host_result_slot*>(slot));
+    };
+    RETURN_IF_HIP_ERROR(hipStreamAddCallback(stream, callback, slot, 0));
+    return rocblas_status_success;
+}
+
+/*******************************************************************************
+ * TRSM inverse cache backend
+ ******************************************************************************/
+void* rocblas_hip_trsm_inverse_backend::allocate(size_t size)
+{
+    void* ptr = nullptr;
+    return sync->device_allocate(&ptr, size) == rocblas_status_success ? ptr : nullptr;
+}
+
+void rocblas_hip_trsm_inverse_backend::deallocate(void* ptr)
+{
+    sync->device_free(ptr);
+}
+
+bool rocblas_hip_timeline_backend::create(hipEvent_t& event)
+{
+    return hipEventCreateWithFlags(&event, hipEventDefault) == hipSuccess;
+}
+
+void rocblas_hip_timeline_backend::destroy(hipEvent_t event)
+{
+    PRINT_IF_HIP_ERROR(hipEventDestroy(event));
+}
+
+bool rocblas_hip_timeline_backend::record(hipEvent_t event, hipStream_t stream)
+{
+    return hipEventRecord(event, stream) == hipSuccess;
+}
+
+int rocblas_hip_timeline_backend::query(hipEvent_t event)
+{
+    hipError_t status = hipEventQuery(event);
+    return status == hipSuccess ? 1 : status == hipErrorNotReady ? 0 : -1;
+}
+
+bool rocblas_hip_timeline_backend::elapsed_us(hipEvent_t start, hipEvent_t stop, double& us)
+{
+    float ms;
+    if(hipEventElapsedTime(&ms, start, stop) != hipSuccess)
+        return false;
+    us = ms * 1000.0;
+    return true;
+}
+
+void rocblas_hip_timeline_backend::synchronize(hipEvent_t event)
+{
+    PRINT_IF_HIP_ERROR(hipEventSynchronize(event));
+}
+
+uint64_t rocblas_hip_timeline_backend::now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// The pool of each device. The pools are never destroyed, since their memory
+// cannot be freed after the HIP runtime has shut down at exit.
+static rocblas_device_memory_pool* get_device_memory_pool(int device)
+{
+    static const auto* pools = [] {
+        int count = 0;
+        if(hipGetDeviceCount(&count) != hipSuccess)
+            count = 0;
+        auto* pools = new std::vector<std::unique_ptr<rocblas_device_memory_pool>>;
+        for(int dev = 0; dev < count; ++dev)
+            pools->push_back(std::make_unique<rocblas_device_memory_pool>());
+        return pools;
+    }();
+    return device >= 0 && size_t(device) < pools->size() ? (*pools)[device].get() : nullptr;
+}
+
+// The counters are never destroyed, so that calls made during static destruction are counted
+rocblas_perf_counters& rocblas_process_perf_counters()
+{
+    static auto* counters = new rocblas_perf_counters;
+    return *counters;
+}
+
 /*******************************************************************************
  * constructor
  ******************************************************************************/
@@ -106,8 +343,31 @@ _rocblas_handle::_rocblas_handle()
         }
     }
 
+#if ROCBLAS_REALLOC_ON_DEMAND
+    // Draw rocBLAS-managed device memory from the device's pool when it is in use
+    env = read_env("ROCBLAS_DEVICE_MEMORY_POOL");
+    if(env && strtol(env, nullptr, 0)
+       && device_memory_owner == rocblas_device_memory_ownership::rocblas_managed)
+    {
+        device_memory_pool      = get_device_memory_pool(device);
+        device_memory_pool_size = device_memory_size;
+    }
+#endif
+
+    // Crossover of the blocked symmetric and Hermitian BLAS3 paths
+    sym_blocked = rocblas_sym_blocked_arch_params(arch);
+    env         = read_env("ROCBLAS_SYM_BLOCKED_NB");
+    if(env)
+        sym_blocked.nb = strtol(env, nullptr, 0);
+    env = read_env("ROCBLAS_SYM_BLOCKED_MIN_N");
+    if(env)
+        sym_blocked.min_n = strtol(env, nullptr, 0);
+
+    // Launch tuning of BLAS1 and BLAS2 kernels on the handle's architecture
+    launch_tuning.append(rocblas_launch_tuning_defaults(), arch);
+
     // Allocate device memory
-    if(device_memory_size)
+    if(device_memory_size && !device_memory_pool)
         THROW_IF_HIP_ERROR((hipMalloc)(&device_memory, device_memory_size));
 
     // Initialize logging
@@ -130,6 +390,36 @@ _rocblas_handle::~_rocblas_handle()
         rocblas_abort();
     }
 
+    // Wait for deferred host results. Destroying the handle may synchronize in any mode.
+    sync.set_capture_safe(false);
+    host_result_buffers.reset();
+
+    // Free cached TRSM inverses on the handle's device, and write the calls still pending
+    // on the timeline
+    {
+        auto saved_device_id = push_device_id();
+        trsm_inverse_cache.clear();
+        timeline.reset();
+    }
+
+    // Report the results of deferred numerical checking if info or warn is set
+    if(check_numerics_deferred_results)
+    {
+        int print = rocblas_check_numerics_mode_info | rocblas_check_numerics_mode_warn;
+        if((check_numerics & rocblas_check_numerics_mode_deferred) && (check_numerics & print)
+           && check_numerics_deferred.has_checks())
+        {
+            rocblas_check_numerics_report report;
+            read_check_numerics_report(report);
+        }
+        PRINT_IF_HIP_ERROR((hipFree)(check_numerics_deferred_results));
+    }
+
+    if(reduction_counters)
+        PRINT_IF_HIP_ERROR((hipFree)(reduction_counters));
+    if(reduction_counters_event)
+        PRINT_IF_HIP_ERROR(hipEventDestroy(reduction_counters_event));
+
     // Free device memory unless it's user-owned
     if(device_memory_owner != rocblas_device_memory_ownership::user_owned)
     {
@@ -150,6 +440,25 @@ _rocblas_handle::~_rocblas_handle()
 #if ROCBLAS_REALLOC_ON_DEMAND
 bool _rocblas_handle::device_allocator(size_t size)
 {
+    // Acquire a block from the pool when none of the handle's memory is in use
+    if(device_memory_pool && !device_memory_in_use
+       && device_memory_owner == rocblas_device_memory_ownership::rocblas_managed)
+    {
+        if(!size)
+            return true;
+
+        // In capture-safe mode only a cached block may be used
+        auto saved_device_id    = push_device_id();
+        device_memory_pool_size = std::max(device_memory_pool_size, size);
+        device_memory_block     = device_memory_pool->acquire(
+            device_memory_pool_size, stream, &sync, !sync.capture_safe());
+        device_memory           = device_memory_block.ptr;
+        device_memory_size      = device_memory ? device_memory_block.size : 0;
+        if(!device_memory && sync.capture_safe())
+            THROW_IF_ROCBLAS_ERROR(sync.check());
+        return device_memory != nullptr;
+    }
+
     bool success = size <= device_memory_size - device_memory_in_use;
     if(!success && device_memory_owner == rocblas_device_memory_ownership::rocblas_managed)
     {
@@ -160,23 +469,37 @@ bool _rocblas_handle::device_allocator(size_t size)
             rocblas_abort();
         }
 
+        // Reallocating synchronizes. Callers can only report a failure to allocate as
+        // rocblas_status_memory_error, so a refusal in capture-safe mode is thrown.
+        THROW_IF_ROCBLAS_ERROR(sync.check());
+
         // Temporarily change the thread's default device ID to the handle's device ID
         auto saved_device_id = push_device_id();
 
         device_memory_size = 0;
-        if(!device_memory || (hipFree)(device_memory) == hipSuccess)
+        if(!device_memory || sync.device_free(device_memory) == rocblas_status_success)
         {
-            success = (hipMalloc)(&device_memory, size) == hipSuccess;
+            success = sync.device_allocate(&device_memory, size) == rocblas_status_success;
             if(success)
                 device_memory_size = size;
-            else
-                device_memory = nullptr;
         }
     }
     return success;
 }
 #endif
 
+/*******************************************************************************
+ * return the device memory block held by the handle to the pool
+ ******************************************************************************/
+void _rocblas_handle::release_device_memory_block()
+{
+    auto saved_device_id = push_device_id();
+    device_memory_pool->release(device_memory_block, stream);
+    device_memory_block = {};
+    device_memory       = nullptr;
+    device_memory_size  = device_memory_pool_size;
+}
+
 /*******************************************************************************
  * start device memory size queries
  ******************************************************************************/
@@ -252,9 +575,10 @@ static rocblas_status free_existing_device_memory(rocblas_handle handle)
         RETURN_IF_HIP_ERROR((hipFree)(handle->device_memory));
 
     // Clear the memory size and address, and set the memory to be rocBLAS-managed
-    handle->device_memory_size  = 0;
-    handle->device_memory       = nullptr;
-    handle->device_memory_owner = rocblas_device_memory_ownership::rocblas_managed;
+    handle->device_memory_size      = 0;
+    handle->device_memory_pool_size = 0;
+    handle->device_memory           = nullptr;
+    handle->device_memory_owner     = rocblas_device_memory_ownership::rocblas_managed;
 
     return rocblas_status_success;
 }
@@ -339,6 +663,247 @@ catch(...)
     return exception_to_rocblas_status();
 }
 
+/*******************************************************************************
+ * Get the statistics of the device memory pool
+ ******************************************************************************/
+extern "C" rocblas_status
+    rocblas_get_device_memory_pool_stats(rocblas_handle                    handle,
+                                         rocblas_device_memory_pool_stats* stats)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!stats)
+        return rocblas_status_invalid_pointer;
+    auto* pool = get_device_memory_pool(handle->device);
+    *stats     = pool ? pool->get_stats() : rocblas_device_memory_pool_stats{};
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Reset the statistics of the device memory pool
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_reset_device_memory_pool_stats(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(auto* pool = get_device_memory_pool(handle->device))
+        pool->reset_stats();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Free the idle memory cached by the device memory pool
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_trim_device_memory_pool(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    auto saved_device_id = handle->push_device_id();
+    if(auto* pool = get_device_memory_pool(handle->device))
+    {
+        // Freeing cached blocks is refused in capture-safe mode
+        if(pool->get_stats().blocks_cached)
+            RETURN_IF_ROCBLAS_ERROR(handle->sync.check());
+        pool->trim(&handle->sync);
+    }
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Set the most device memory used by the TRSM inverse cache
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_trsm_inverse_cache_size(rocblas_handle handle, size_t size)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    // Evicting entries frees device memory, which is refused in capture-safe mode
+    if(size < handle->trsm_inverse_cache.get_stats().bytes)
+        RETURN_IF_ROCBLAS_ERROR(handle->sync.check());
+    auto saved_device_id = handle->push_device_id();
+    handle->trsm_inverse_cache.set_budget(size);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get the most device memory used by the TRSM inverse cache
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_trsm_inverse_cache_size(rocblas_handle handle, size_t* size)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!size)
+        return rocblas_status_invalid_pointer;
+    *size = handle->trsm_inverse_cache.budget();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Set the generation of triangular matrices which keys the TRSM inverse cache
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_trsm_inverse_cache_generation(rocblas_handle handle,
+                                                                    size_t         generation)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    handle->trsm_inverse_cache.set_generation(generation);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Set whether trsm_batched uses the TRSM inverse cache
+ ******************************************************************************/
+extern "C" rocblas_status
+    rocblas_set_trsm_inverse_cache_batched(rocblas_handle                     handle,
+                                           rocblas_trsm_inverse_cache_batched batched)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(batched != rocblas_trsm_inverse_cache_batched_excluded
+       && batched != rocblas_trsm_inverse_cache_batched_included)
+        return rocblas_status_invalid_value;
+    handle->trsm_inverse_cache.set_batched(batched
+                                           == rocblas_trsm_inverse_cache_batched_included);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get whether trsm_batched uses the TRSM inverse cache
+ ******************************************************************************/
+extern "C" rocblas_status
+    rocblas_get_trsm_inverse_cache_batched(rocblas_handle                      handle,
+                                           rocblas_trsm_inverse_cache_batched* batched)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!batched)
+        return rocblas_status_invalid_pointer;
+    *batched = handle->trsm_inverse_cache.batched()
+                   ? rocblas_trsm_inverse_cache_batched_included
+                   : rocblas_trsm_inverse_cache_batched_excluded;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get the statistics of the TRSM inverse cache
+ ******************************************************************************/
+extern "C" rocblas_status
+    rocblas_get_trsm_inverse_cache_stats(rocblas_handle                    handle,
+                                         rocblas_trsm_inverse_cache_stats* stats)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!stats)
+        return rocblas_status_invalid_pointer;
+    *stats = handle->trsm_inverse_cache.get_stats();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Reset the statistics of the TRSM inverse cache
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_reset_trsm_inverse_cache_stats(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    handle->trsm_inverse_cache.reset_stats();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Free the entries of the TRSM inverse cache
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_clear_trsm_inverse_cache(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    // Freeing entries is refused in capture-safe mode
+    if(handle->trsm_inverse_cache.get_stats().entries)
+        RETURN_IF_ROCBLAS_ERROR(handle->sync.check());
+    auto saved_device_id = handle->push_device_id();
+    handle->trsm_inverse_cache.clear();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Set the launch tuning entries which take precedence in a handle
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_launch_tuning_table(rocblas_handle handle, const char* table)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    rocblas_launch_tuning_table tuning;
+    std::string                 error;
+    if(table && !tuning.parse(table, error))
+    {
+        rocblas_cerr << "rocBLAS error: rocblas_set_launch_tuning_table " << error << std::endl;
+        return rocblas_status_invalid_value;
+    }
+    tuning.append(rocblas_launch_tuning_defaults(), handle->getArch());
+    handle->launch_tuning = std::move(tuning);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /*******************************************************************************
  * Returns whether device memory is rocblas-managed
  ******************************************************************************/
@@ -566,6 +1131,25 @@ static auto open_log_stream(const char* environment_variable_name)
                    : std::make_unique<rocblas_internal_ostream>(STDERR_FILENO);
 }
 
+// The timeline is written to ROCBLAS_LOG_TIMELINE_PATH by the stream's worker. The writer and
+// its stream are never destroyed, so that calls made during static destruction are written.
+rocblas_timeline_writer& rocblas_process_timeline_writer()
+{
+    static auto* writer = [] {
+        rocblas_internal_ostream* os = open_log_stream("ROCBLAS_LOG_TIMELINE_PATH").release();
+        auto sink = [os](const std::string& events) {
+            os->write(events.data(), events.size());
+            os->flush();
+        };
+#ifdef WIN32
+        return new rocblas_timeline_writer(sink, GetCurrentProcessId());
+#else
+        return new rocblas_timeline_writer(sink, getpid());
+#endif
+    }();
+    return *writer;
+}
+
 /*******************************************************************************
  * Logging initialization
  ******************************************************************************/
@@ -588,6 +1172,31 @@ void _rocblas_handle::init_logging()
         // open log_profile file
         if(layer_mode & rocblas_layer_mode_log_profile)
             log_profile_os = open_log_stream("ROCBLAS_LOG_PROFILE_PATH");
+
+        // record calls on the timeline, timing them on the GPU if ROCBLAS_LOG_TIMELINE_GPU
+        // is set
+        if(layer_mode & rocblas_layer_mode_log_timeline)
+        {
+            const char* str_timeline_gpu = read_env("ROCBLAS_LOG_TIMELINE_GPU");
+            timeline                     = std::make_unique<rocblas_hip_timeline>(
+                rocblas_hip_timeline_backend{},
+                [](const rocblas_timeline_call& call) {
+                    rocblas_process_timeline_writer().write(call);
+                },
+                str_timeline_gpu && strtol(str_timeline_gpu, 0, 0));
+        }
+
+        // encode log_trace and log_bench output in the compact binary format
+        const char* str_log_binary = read_env("ROCBLAS_LOG_BINARY");
+        if(str_log_binary && strtol(str_log_binary, 0, 0))
+        {
+            if(log_trace_os)
+                log_trace_binary = std::make_unique<rocblas_binary_log_writer>(
+                    *log_trace_os, rocblas_binary_log::stream_t::trace, this);
+            if(log_bench_os)
+                log_bench_binary = std::make_unique<rocblas_binary_log_writer>(
+                    *log_bench_os, rocblas_binary_log::stream_t::bench, this);
+        }
     }
 }
 
@@ -643,4 +1252,195 @@ void _rocblas_handle::init_check_numerics()
         check_numerics
             = static_cast<rocblas_check_numerics_mode>(strtol(str_check_numerics_mode, 0, 0));
     }
+
+    // check one call in every ROCBLAS_CHECK_NUMERICS_SAMPLE calls in deferred mode
+    const char* str_sample = read_env("ROCBLAS_CHECK_NUMERICS_SAMPLE");
+    if(str_sample)
+        check_numerics_deferred.set_interval(strtoul(str_sample, nullptr, 0));
+}
+
+/*******************************************************************************
+ * Deferred numerical checking
+ ******************************************************************************/
+rocblas_check_numerics_t* _rocblas_handle::get_check_numerics_deferred_results()
+{
+    if(!check_numerics_deferred_results)
+    {
+        auto  saved_device_id = push_device_id();
+        void* results         = nullptr;
+        if(sync.device_allocate(&results, sizeof(rocblas_check_numerics_t))
+           == rocblas_status_success)
+        {
+            if(hipMemsetAsync(results, 0, sizeof(rocblas_check_numerics_t), stream) == hipSuccess)
+                check_numerics_deferred_results = static_cast<rocblas_check_numerics_t*>(results);
+            else
+                sync.device_free(results);
+        }
+    }
+    return check_numerics_deferred_results;
+}
+
+/*******************************************************************************
+ * Counters of single-launch reductions
+ ******************************************************************************/
+rocblas_int* _rocblas_handle::get_reduction_counters(rocblas_int count)
+{
+    auto saved_device_id = push_device_id();
+
+    if(count > reduction_counters_size)
+    {
+        // Without counters, reductions use two launches, so in capture-safe mode
+        // the allocation is refused and nullptr returned
+        if(sync.check() != rocblas_status_success)
+            return nullptr;
+
+        // hipFree waits for the kernels still using the smaller counters
+        if(reduction_counters)
+            sync.device_free(reduction_counters);
+        reduction_counters          = nullptr;
+        reduction_counters_size     = 0;
+        reduction_counters_recorded = false;
+
+        rocblas_int size = std::max(count, 256);
+        void*       ptr  = nullptr;
+        if(sync.device_allocate(&ptr, size * sizeof(rocblas_int)) != rocblas_status_success)
+            return nullptr;
+        if(hipMemsetAsync(ptr, 0, size * sizeof(rocblas_int), stream) != hipSuccess)
+        {
+            sync.device_free(ptr);
+            return nullptr;
+        }
+        reduction_counters        = static_cast<rocblas_int*>(ptr);
+        reduction_counters_size   = size;
+        reduction_counters_stream = stream;
+    }
+    else if(stream != reduction_counters_stream)
+    {
+        // Kernels on this stream must not start while kernels on the previous stream
+        // are still counting. The event recorded after the last of them is waited on,
+        // so the previous stream, which may no longer exist, is never used.
+        if(!reduction_counters_recorded
+           || hipStreamWaitEvent(stream, reduction_counters_event, 0) != hipSuccess)
+            return nullptr;
+        reduction_counters_stream = stream;
+    }
+
+    return reduction_counters;
+}
+
+void _rocblas_handle::record_reduction_counters()
+{
+    auto saved_device_id = push_device_id();
+
+    if(!reduction_counters_event
+       && hipEventCreateWithFlags(&reduction_counters_event, hipEventDisableTiming) != hipSuccess)
+        reduction_counters_event = nullptr;
+
+    reduction_counters_recorded = reduction_counters_event
+                                  && hipEventRecord(reduction_counters_event, stream) == hipSuccess;
+}
+
+rocblas_status _rocblas_handle::read_check_numerics_report(rocblas_check_numerics_report& report)
+{
+    rocblas_check_numerics_t results;
+    if(check_numerics_deferred_results)
+    {
+        RETURN_IF_ROCBLAS_ERROR(sync.stream_synchronize(stream));
+        RETURN_IF_ROCBLAS_ERROR(sync.copy(&results,
+                                          check_numerics_deferred_results,
+                                          sizeof(results),
+                                          hipMemcpyDeviceToHost));
+    }
+    check_numerics_deferred.report(
+        results.has_NaN, results.has_zero, results.has_Inf, results.first_abnormal, report);
+
+    bool is_abnormal = report.has_NaN || report.has_Inf;
+    if((check_numerics & rocblas_check_numerics_mode_info)
+       || ((check_numerics & rocblas_check_numerics_mode_warn) && is_abnormal))
+    {
+        rocblas_cerr << "Deferred check_numerics:\t"
+                     << " checked_calls " << report.checked_calls << " skipped_calls "
+                     << report.skipped_calls << " checked_operands " << report.checked_operands
+                     << " has_NaN " << report.has_NaN << " has_zero " << report.has_zero
+                     << " has_Inf " << report.has_Inf;
+        if(report.first_abnormal_function)
+            rocblas_cerr << " first NaN/Inf in " << report.first_abnormal_function
+                         << (report.first_abnormal_is_input ? " :- Input" : " :- Output");
+        rocblas_cerr << std::endl;
+    }
+
+    return is_abnormal && (check_numerics & rocblas_check_numerics_mode_fail)
+               ? rocblas_status_check_numerics_fail
+               : rocblas_status_success;
+}
+
+extern "C" rocblas_status rocblas_set_check_numerics_sampling(rocblas_handle handle,
+                                                              rocblas_int    interval)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(interval < 1)
+        return rocblas_status_invalid_size;
+    handle->check_numerics_deferred.set_interval(interval);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status rocblas_get_check_numerics_report(rocblas_handle                 handle,
+                                                            rocblas_check_numerics_report* report)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!report)
+        return rocblas_status_invalid_pointer;
+    return handle->read_check_numerics_report(*report);
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status rocblas_reset_check_numerics_report(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    handle->check_numerics_deferred.reset();
+    if(handle->check_numerics_deferred_results)
+    {
+        auto saved_device_id = handle->push_device_id();
+        RETURN_IF_HIP_ERROR(hipMemsetAsync(handle->check_numerics_deferred_results,
+                                           0,
+                                           sizeof(rocblas_check_numerics_t),
+                                           handle->stream));
+    }
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Copy a result from the device to the host through the handle's pinned buffers
+ ******************************************************************************/
+rocblas_status _rocblas_handle::copy_result_to_host(void* dst, const void* src, size_t size)
+{
+    bool deferred = host_result_mode == rocblas_host_result_deferred;
+    if(!deferred && size)
+        RETURN_IF_ROCBLAS_ERROR(sync.check());
+
+    if(!host_result_buffers)
+        host_result_buffers = std::make_unique<rocblas_host_result_buffers>(
+            rocblas_hip_host_result_backend{&sync});
+
+    // A refused allocation of a slot is reported as a memory error by the buffers
+    size_t         refused = sync.counts().refused;
+    rocblas_status status  = host_result_buffers->copy(dst, src, size, stream, deferred);
+    return sync.counts().refused != refused ? rocblas_status_capture_unsafe : status;
 }
@@ -0,0 +1,146 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/******************************************************************************
+ * Host side of the deferred check_numerics mode                               *
+ * (rocblas_check_numerics_mode_deferred).                                     *
+ *                                                                             *
+ * Instead of copying the results of each check back to the host, the check    *
+ * kernels accumulate them into one persistent device struct per handle, and  *
+ * the results are read at rocblas_get_check_numerics_report.                 *
+ *                                                                             *
+ * Each checked operand gets a sequence number, which a kernel that finds a    *
+ * NaN or an Inf records on the device with an atomic max of UINT32_MAX - seq, *
+ * so that the first abnormal operand is known without synchronizing. The     *
+ * names of the functions of the last HISTORY checks are kept to report it.    *
+ *                                                                             *
+ * Sampling checks one rocBLAS call in every interval. A call is the run of    *
+ * checks of the same function starting with its inputs, so the inputs and     *
+ * outputs of a call are either all checked or all skipped.                    *
+ ******************************************************************************/
+class rocblas_check_numerics_deferred
+{
+public:
+    // Number of checks whose function names are remembered
+    static constexpr uint32_t HISTORY = 4096;
+
+    // Check one call in every interval calls, starting with the next call
+    void set_interval(uint32_t interval)
+    {
+        m_interval = interval ? interval : 1;
+        m_function = nullptr;
+    }
+
+    uint32_t interval() const
+    {
+        return m_interval;
+    }
+
+    // Start the check of an operand of function_name, returning its sequence
+    // number, or 0 if the check is skipped by sampling
+    uint32_t begin(const char* function_name, bool is_input)
+    {
+        // A new call starts with another function, or with an input after an output
+        if(function_name != m_function || (is_input && !m_is_input))
+        {
+            m_sampled = m_calls++ % m_interval == 0;
+            if(m_sampled)
+                ++m_checked_calls;
+            m_function = function_name;
+        }
+        m_is_input = is_input;
+
+        if(!m_sampled)
+            return 0;
+
+        ++m_checked_operands;
+        if(m_seq < UINT32_MAX)
+            ++m_seq;
+        if(m_history.empty())
+            m_history.resize(HISTORY);
+        m_history[m_seq % HISTORY] = {function_name, is_input};
+        return m_seq;
+    }
+
+    // Accumulate the results of a check done on the host
+    void record_host(uint32_t seq, bool has_NaN, bool has_zero, bool has_Inf)
+    {
+        m_host_NaN  = m_host_NaN || has_NaN;
+        m_host_zero = m_host_zero || has_zero;
+        m_host_Inf  = m_host_Inf || has_Inf;
+        if((has_NaN || has_Inf) && seq && (!m_host_first || seq < m_host_first))
+            m_host_first = seq;
+    }
+
+    // Whether any operand has been checked since the last reset
+    bool has_checks() const
+    {
+        return m_checked_operands != 0;
+    }
+
+    // Combine the host results with the device results into a report.
+    // device_first is the value accumulated by the kernels: UINT32_MAX - seq
+    // of the first abnormal check, or 0 if none.
+    void report(bool                            device_NaN,
+                bool                            device_zero,
+                bool                            device_Inf,
+                uint32_t                        device_first,
+                rocblas_check_numerics_report& report) const
+    {
+        report.checked_calls    = m_checked_calls;
+        report.skipped_calls    = m_calls - m_checked_calls;
+        report.checked_operands = m_checked_operands;
+        report.has_NaN          = device_NaN || m_host_NaN;
+        report.has_zero         = device_zero || m_host_zero;
+        report.has_Inf          = device_Inf || m_host_Inf;
+
+        uint32_t first = device_first ? UINT32_MAX - device_first : 0;
+        if(m_host_first && (!first || m_host_first < first))
+            first = m_host_first;
+
+        // The name is known if the check is among the last HISTORY checks
+        report.first_abnormal_function = nullptr;
+        report.first_abnormal_is_input = false;
+        if(first && m_seq - first < HISTORY && !m_history.empty())
+        {
+            report.first_abnormal_function = m_history[first % HISTORY].first;
+            report.first_abnormal_is_input = m_history[first % HISTORY].second;
+        }
+    }
+
+    // Forget all checks; the interval is kept
+    void reset()
+    {
+        m_calls = m_checked_calls = m_checked_operands = 0;
+        m_seq = m_host_first = 0;
+        m_host_NaN = m_host_zero = m_host_Inf = false;
+        m_function                            = nullptr;
+    }
+
+private:
+    uint32_t    m_interval         = 1;
+    uint64_t    m_calls            = 0;
+    uint64_t    m_checked_calls    = 0;
+    uint64_t    m_checked_operands = 0;
+    uint32_t    m_seq              = 0; // Sequence number of the last check
+    const char* m_function         = nullptr; // Function of the last check
+    bool        m_is_input         = false; // Whether the last check was of an input
+    bool        m_sampled          = false; // Whether the current call is checked
+
+    // Results of checks done on the host
+    bool     m_host_NaN   = false;
+    bool     m_host_zero  = false;
+    bool     m_host_Inf   = false;
+    uint32_t m_host_first = 0;
+
+    // Function name and is_input of recent checks, indexed by seq % HISTORY
+    std::vector<std::pair<const char*, bool>> m_history;
+};
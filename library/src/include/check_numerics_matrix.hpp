@@ -24,6 +24,7 @@
   *                lda          : specifies the leading dimension of matrix 'Aa'
   *                stride_a     : Specifies the pointer increment between one matrix 'A_i' and the next one (Aa_i+1) (where (Aa_i) is the i-th instance of the batch)
   *                abnormal     : Device pointer to the rocblas_check_numerics_t structure
+  *                seq          : Sequence number of the check in rocblas_check_numerics_mode_deferred, or 0
   *
   * Return Value : Nothing --
   *
@@ -36,7 +37,8 @@ ROCBLAS_KERNEL void rocblas_check_numerics_ge_matrix_kernel(rocblas_int
                                                             ptrdiff_t                 offset_a,
                                                             rocblas_int               lda,
                                                             rocblas_stride            stride_a,
-                                                            rocblas_check_numerics_t* abnormal)
+                                                            rocblas_check_numerics_t* abnormal,
+                                                            uint32_t                  seq)
 {
     rocblas_int tx = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
     rocblas_int ty = hipBlockIdx_y * hipBlockDim_y + hipThreadIdx_y;
@@ -46,13 +48,17 @@ ROCBLAS_KERNEL void rocblas_check_numerics_ge_matrix_kernel(rocblas_int
         auto* A = load_ptr_batch(Aa, hipBlockIdx_z, offset_a, stride_a);
 
         ptrdiff_t tid   = tx + ptrdiff_t(lda) * ty;
-        auto      value = A[tid];
+        auto      value  = A[tid];
+        bool      is_NaN = rocblas_isnan(value);
+        bool      is_Inf = rocblas_isinf(value);
         if(!abnormal->has_zero && rocblas_iszero(value))
             abnormal->has_zero = true;
-        if(!abnormal->has_NaN && rocblas_isnan(value))
+        if(!abnormal->has_NaN && is_NaN)
             abnormal->has_NaN = true;
-        if(!abnormal->has_Inf && rocblas_isinf(value))
+        if(!abnormal->has_Inf && is_Inf)
             abnormal->has_Inf = true;
+        if(is_NaN || is_Inf)
+            rocblas_check_numerics_record_abnormal(abnormal, seq);
     }
 }
 template <typename T>
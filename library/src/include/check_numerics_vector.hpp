@@ -22,18 +22,29 @@
   *                inc_x        : Stride between consecutive values of vector 'xa'
   *                stride_x     : Specifies the pointer increment between one vector 'x_i' and the next one (xa_i+1) (where (xa_i) is the i-th instance of the batch)
   *                abnormal     : Device pointer to the rocblas_check_numerics_t structure
+  *                seq          : Sequence number of the check in rocblas_check_numerics_mode_deferred, or 0
   *
   * Return Value : Nothing --
   *
 **/
 
+// Record that the check with sequence number seq found a NaN or an Inf, unless
+// an earlier check has been recorded. seq is 0 unless the mode is deferred.
+__device__ inline void rocblas_check_numerics_record_abnormal(rocblas_check_numerics_t* abnormal,
+                                                              uint32_t                  seq)
+{
+    if(seq && abnormal->first_abnormal < UINT32_MAX - seq)
+        atomicMax(&abnormal->first_abnormal, UINT32_MAX - seq);
+}
+
 template <typename T>
 ROCBLAS_KERNEL void rocblas_check_numerics_vector_kernel(rocblas_int               n,
                                                          T                         xa,
                                                          ptrdiff_t                 offset_x,
                                                          rocblas_int               inc_x,
                                                          rocblas_stride            stride_x,
-                                                         rocblas_check_numerics_t* abnormal)
+                                                         rocblas_check_numerics_t* abnormal,
+                                                         uint32_t                  seq)
 {
     auto*     x   = load_ptr_batch(xa, hipBlockIdx_y, offset_x, stride_x);
     ptrdiff_t tid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
@@ -41,13 +52,17 @@ ROCBLAS_KERNEL void rocblas_check_numerics_vector_kernel(rocblas_int
     //Check every element of the x vector for a NaN/zero/Inf
     if(tid < n)
     {
-        auto value = x[tid * inc_x];
+        auto value  = x[tid * inc_x];
+        bool is_NaN = rocblas_isnan(value);
+        bool is_Inf = rocblas_isinf(value);
         if(!abnormal->has_zero && rocblas_iszero(value))
             abnormal->has_zero = true;
-        if(!abnormal->has_NaN && rocblas_isnan(value))
+        if(!abnormal->has_NaN && is_NaN)
             abnormal->has_NaN = true;
-        if(!abnormal->has_Inf && rocblas_isinf(value))
+        if(!abnormal->has_Inf && is_Inf)
             abnormal->has_Inf = true;
+        if(is_NaN || is_Inf)
+            rocblas_check_numerics_record_abnormal(abnormal, seq);
     }
 }
 
@@ -56,6 +71,21 @@ rocblas_status rocblas_check_numerics_abnormal_struct(const char*
                                                       bool                      is_input,
                                                       rocblas_check_numerics_t* h_abnormal);
 
+// Start the check of an operand in rocblas_check_numerics_mode_deferred. d_abnormal is
+// set to the handle's persistent device results and seq to the sequence number of the
+// check, or d_abnormal is set to nullptr if the check is skipped by sampling.
+rocblas_status rocblas_check_numerics_deferred_begin(rocblas_handle             handle,
+                                                     const char*                function_name,
+                                                     bool                       is_input,
+                                                     rocblas_check_numerics_t*& d_abnormal,
+                                                     uint32_t&                  seq);
+
+// Record the results of a check done on the host in rocblas_check_numerics_mode_deferred
+void rocblas_check_numerics_deferred_host(rocblas_handle                  handle,
+                                          const char*                     function_name,
+                                          bool                            is_input,
+                                          const rocblas_check_numerics_t& h_abnormal);
+
 template <typename T>
 ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     rocblas_internal_check_numerics_vector_template(const char*    function_name,
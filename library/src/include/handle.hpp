@@ -4,9 +4,19 @@
 
 #pragma once
 
+#include "check_numerics_deferred.hpp"
 #include "macros.hpp"
 #include "rocblas.h"
+#include "rocblas_binary_log.hpp"
+#include "rocblas_device_memory_pool.hpp"
+#include "rocblas_host_result_staging.hpp"
+#include "rocblas_launch_tuning.hpp"
 #include "rocblas_ostream.hpp"
+#include "rocblas_perf_counters.hpp"
+#include "rocblas_sym_block_plan.hpp"
+#include "rocblas_sync_points.hpp"
+#include "rocblas_timeline.hpp"
+#include "rocblas_trsm_inverse_cache.hpp"
 #include "utility.hpp"
 #include <array>
 #include <cstddef>
@@ -55,6 +65,87 @@ enum class rocblas_device_memory_ownership
 // helper function in handle.cpp
 static rocblas_status free_existing_device_memory(rocblas_handle);
 
+// The HIP calls counted, or refused in capture-safe mode, by rocblas_sync_interceptor
+struct rocblas_hip_sync_backend
+{
+    using stream_t    = hipStream_t;
+    using event_t     = hipEvent_t;
+    using copy_kind_t = hipMemcpyKind;
+
+    rocblas_status copy(void* dst, const void* src, size_t size, hipMemcpyKind kind);
+    rocblas_status stream_synchronize(hipStream_t stream);
+    rocblas_status event_synchronize(hipEvent_t event);
+    rocblas_status device_allocate(void** ptr, size_t size);
+    rocblas_status device_free(void* ptr);
+    rocblas_status host_allocate(void** ptr, size_t size);
+    rocblas_status host_free(void* ptr);
+};
+
+using rocblas_hip_sync_interceptor = rocblas_sync_interceptor<rocblas_hip_sync_backend>;
+
+// Device memory for rocblas_size_class_pool, with stream ordering by HIP events. Allocations
+// go through the sync interceptor of the handle which acquires or trims the pool.
+struct rocblas_hip_memory_backend
+{
+    using stream_t  = hipStream_t;
+    using fence_t   = hipEvent_t;
+    using context_t = rocblas_hip_sync_interceptor*;
+
+    void* allocate(size_t size, rocblas_hip_sync_interceptor* sync);
+    void  deallocate(void* ptr, rocblas_hip_sync_interceptor* sync);
+    void  record(hipEvent_t& event, hipStream_t stream);
+    void  wait(hipEvent_t& event, hipStream_t stream);
+    void  destroy(hipEvent_t& event);
+};
+
+using rocblas_device_memory_pool = rocblas_size_class_pool<rocblas_hip_memory_backend>;
+
+// Pinned host memory for rocblas_host_result_staging, with completions run by stream callbacks.
+// Allocations and synchronizations go through the handle's sync interceptor.
+struct rocblas_hip_host_result_backend
+{
+    using stream_t = hipStream_t;
+
+    rocblas_hip_sync_interceptor* sync = nullptr;
+
+    void*          allocate(size_t size);
+    void           deallocate(void* ptr);
+    rocblas_status copy_async(void* dst, const void* src, size_t size, hipStream_t stream);
+    rocblas_status synchronize(hipStream_t stream);
+    rocblas_status enqueue(hipStream_t stream, rocblas_host_result_slot* slot);
+};
+
+using rocblas_host_result_buffers = rocblas_host_result_staging<rocblas_hip_host_result_backend>;
+
+// Device memory for rocblas_trsm_inverse_cache. Allocations go through the handle's sync
+// interceptor.
+struct rocblas_hip_trsm_inverse_backend
+{
+    rocblas_hip_sync_interceptor* sync = nullptr;
+
+    void* allocate(size_t size);
+    void  deallocate(void* ptr);
+};
+
+using rocblas_trsm_inverse_buffers = rocblas_trsm_inverse_cache<rocblas_hip_trsm_inverse_backend>;
+
+// Timing events and host clock of rocblas_timeline_recorder
+struct rocblas_hip_timeline_backend
+{
+    using event_t  = hipEvent_t;
+    using stream_t = hipStream_t;
+
+    bool     create(hipEvent_t& event);
+    void     destroy(hipEvent_t event);
+    bool     record(hipEvent_t event, hipStream_t stream);
+    int      query(hipEvent_t event);
+    bool     elapsed_us(hipEvent_t start, hipEvent_t stop, double& us);
+    void     synchronize(hipEvent_t event);
+    uint64_t now_ns();
+};
+
+using rocblas_hip_timeline = rocblas_timeline_recorder<rocblas_hip_timeline_backend>;
+
 /*******************************************************************************
  * \brief rocblas_handle is a structure holding the rocblas library context.
  * It must be initialized using rocblas_create_handle() and the returned handle mus
@@ -193,18 +284,67 @@ public:
     // default atomics mode allows atomic operations
     rocblas_atomics_mode atomics_mode = rocblas_atomics_allowed;
 
+    // default host result mode waits for results returned in host memory
+    rocblas_host_result_mode host_result_mode = rocblas_host_result_blocking;
+
+    // Counts the host synchronizations and allocations made by rocBLAS functions, and
+    // refuses them in rocblas_capture_safe mode
+    rocblas_hip_sync_interceptor sync;
+
+    // Calls of each function made with the handle, counted with
+    // rocblas_layer_mode_perf_counters
+    rocblas_perf_counters perf_counters;
+
+    // Calls made with the handle, recorded with rocblas_layer_mode_log_timeline into the
+    // process's timeline
+    std::unique_ptr<rocblas_hip_timeline> timeline;
+
+    // Inverted diagonal blocks of TRSM, reused across calls with the same A when a budget
+    // is set with rocblas_set_trsm_inverse_cache_size, and by trsm_batched only after
+    // rocblas_set_trsm_inverse_cache_batched
+    rocblas_trsm_inverse_buffers trsm_inverse_cache{rocblas_hip_trsm_inverse_backend{&sync}};
+
+    // Launch tuning entries of the handle's architecture, set by the constructor and
+    // rocblas_set_launch_tuning_table
+    rocblas_launch_tuning_table launch_tuning;
+
+    // Crossover and diagonal block size of the blocked SYRK, HERK, SYR2K, HER2K, SYMM and
+    // HEMM paths, by architecture unless ROCBLAS_SYM_BLOCKED_NB or _MIN_N are set
+    rocblas_sym_blocked_params sym_blocked;
+
     // Selects the benchmark library to be used for solution selection
     rocblas_performance_metric performance_metric = rocblas_default_performance_metric;
 
     // default check_numerics_mode is no numeric_check
     rocblas_check_numerics_mode check_numerics = rocblas_check_numerics_mode_no_check;
 
+    // Host state of rocblas_check_numerics_mode_deferred
+    rocblas_check_numerics_deferred check_numerics_deferred;
+
+    // Device results of rocblas_check_numerics_mode_deferred, which are allocated and
+    // cleared on first use. Returns nullptr if they cannot be allocated.
+    rocblas_check_numerics_t* get_check_numerics_deferred_results();
+
+    // Device counters of finished blocks for single-launch reductions of count batches,
+    // ordered after their last use on any stream. They are zero, and the kernels using
+    // them leave them zero. Returns nullptr if they cannot be allocated.
+    rocblas_int* get_reduction_counters(rocblas_int count);
+
+    // Records that the counters were used by a kernel just launched on the handle's
+    // stream, so that a later use on another stream is ordered after it.
+    void record_reduction_counters();
+
     // logging streams
     std::unique_ptr<rocblas_internal_ostream> log_trace_os;
     std::unique_ptr<rocblas_internal_ostream> log_bench_os;
     std::unique_ptr<rocblas_internal_ostream> log_profile_os;
-    void                                      init_logging();
-    void                                      init_check_numerics();
+
+    // binary encoders for the trace and bench streams, if ROCBLAS_LOG_BINARY is set
+    std::unique_ptr<rocblas_binary_log_writer> log_trace_binary;
+    std::unique_ptr<rocblas_binary_log_writer> log_bench_binary;
+
+    void init_logging();
+    void init_check_numerics();
 
     // C interfaces for manipulating device memory
     friend rocblas_status(::rocblas_start_device_memory_size_query)(_rocblas_handle*);
@@ -213,10 +353,19 @@ public:
     friend rocblas_status(::rocblas_set_device_memory_size)(_rocblas_handle*, size_t);
     friend rocblas_status(::free_existing_device_memory)(rocblas_handle);
     friend rocblas_status(::rocblas_set_workspace)(_rocblas_handle*, void*, size_t);
+    friend rocblas_status(::rocblas_get_device_memory_pool_stats)(_rocblas_handle*,
+                                                                  rocblas_device_memory_pool_stats*);
+    friend rocblas_status(::rocblas_reset_device_memory_pool_stats)(_rocblas_handle*);
+    friend rocblas_status(::rocblas_trim_device_memory_pool)(_rocblas_handle*);
     friend bool(::rocblas_is_managing_device_memory)(_rocblas_handle*);
     friend bool(::rocblas_is_user_managing_device_memory)(_rocblas_handle*);
     friend rocblas_status(::rocblas_set_stream)(_rocblas_handle*, hipStream_t);
 
+    // C interfaces for deferred numerical checking
+    friend rocblas_status(::rocblas_get_check_numerics_report)(_rocblas_handle*,
+                                                               rocblas_check_numerics_report*);
+    friend rocblas_status(::rocblas_reset_check_numerics_report)(_rocblas_handle*);
+
     // C interfaces that interact with the solution selection process
     friend rocblas_status(::rocblas_set_solution_fitness_query)(_rocblas_handle*, double*);
     friend rocblas_status(::rocblas_set_performance_metric)(_rocblas_handle*,
@@ -281,6 +430,11 @@ public:
         return stream;
     }
 
+    // Copy a result of size bytes computed on the device at src to host memory at dst,
+    // through pinned memory. Unless host_result_mode is rocblas_host_result_deferred,
+    // the copy is complete on return; otherwise it is complete when the stream is.
+    rocblas_status copy_result_to_host(void* dst, const void* src, size_t size);
+
 private:
     // device memory work buffer
     static constexpr size_t DEFAULT_DEVICE_MEMORY_SIZE = 32 * 1024 * 1024;
@@ -304,6 +458,35 @@ private:
     bool device_allocator(size_t size);
 #endif
 
+    // If ROCBLAS_DEVICE_MEMORY_POOL is set, rocBLAS-managed device memory is
+    // drawn from the device's pool while any of it is in use, and returned to
+    // the pool when none of it is in use. device_memory_pool_size is the size
+    // requested from the pool, which grows like device_memory_size otherwise.
+    rocblas_device_memory_pool*         device_memory_pool      = nullptr;
+    rocblas_device_memory_pool::block_t device_memory_block     = {};
+    size_t                              device_memory_pool_size = 0;
+
+    // Return the block held by the handle to the pool
+    void release_device_memory_block();
+
+    // Pinned memory for copy_result_to_host, allocated on first use
+    std::unique_ptr<rocblas_host_result_buffers> host_result_buffers;
+
+    // Counters of get_reduction_counters, the stream they were last used on, and an
+    // event recorded on that stream after their last use, for ordering their use on
+    // another stream after it. Without a recorded event, other streams do not use them.
+    rocblas_int* reduction_counters          = nullptr;
+    rocblas_int  reduction_counters_size     = 0;
+    hipStream_t  reduction_counters_stream   = 0;
+    hipEvent_t   reduction_counters_event    = nullptr;
+    bool         reduction_counters_recorded = false;
+
+    // Results of rocblas_check_numerics_mode_deferred, accumulated by the check kernels
+    rocblas_check_numerics_t* check_numerics_deferred_results = nullptr;
+
+    // Read the deferred results into report, waiting for the stream
+    rocblas_status read_check_numerics_report(rocblas_check_numerics_report& report);
+
     // Device ID is created at handle creation time and remains in effect for the life of the handle.
     const int device;
 
@@ -439,6 +622,10 @@ private:
                         << std::endl;
                     rocblas_abort();
                 }
+
+                // Memory drawn from the pool is returned once none of it is in use
+                if(!handle->device_memory_in_use && handle->device_memory_block.ptr)
+                    handle->release_device_memory_block();
             }
         }
 
@@ -523,6 +710,12 @@ public:
     };
 };
 
+// Calls of each function made with any handle, counted with rocblas_layer_mode_perf_counters
+rocblas_perf_counters& rocblas_process_perf_counters();
+
+// Timeline of the calls made with any handle, written with rocblas_layer_mode_log_timeline
+rocblas_timeline_writer& rocblas_process_timeline_writer();
+
 // For functions which don't use temporary device memory, and won't be likely
 // to use them in the future, the RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle)
 // macro can be used to return from a rocblas function with a requested size of 0.
@@ -5,8 +5,10 @@
 #pragma once
 
 #include "handle.hpp"
+#include "rocblas_binary_log.hpp"
 #include "rocblas_ostream.hpp"
 #include "tuple_helper.hpp"
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <iomanip>
@@ -137,23 +139,19 @@ void log_profile(rocblas_handle handle, const char* func, Ts&&... xs)
 /********************************************
  * Log values (for log_trace and log_bench) *
  ********************************************/
-template <typename H, typename... Ts>
-void log_arguments(rocblas_internal_ostream& os, const char* sep, H&& head, Ts&&... xs)
-{
-    os << std::forward<H>(head);
-    // TODO: Replace with C++17 fold expression
-    // ((os << sep << std::forward<Ts>(xs)), ...);
-    (void)(int[]){(os << sep << std::forward<Ts>(xs), 0)...};
-    os << std::endl;
-}
-
 // if trace logging is turned on with
 // (handle->layer_mode & rocblas_layer_mode_log_trace) != 0
 // log_function will call log_arguments to log arguments with a comma separator
+// if ROCBLAS_LOG_BINARY is set, the arguments are encoded by the handle's
+// rocblas_binary_log_writer instead
 template <typename... Ts>
 void log_trace(rocblas_handle handle, Ts&&... xs)
 {
-    log_arguments(*handle->log_trace_os, ",", std::forward<Ts>(xs)..., handle->atomics_mode);
+    log_arguments(*handle->log_trace_os,
+                  handle->log_trace_binary.get(),
+                  ",",
+                  std::forward<Ts>(xs)...,
+                  handle->atomics_mode);
 }
 
 // if bench logging is turned on with
@@ -164,11 +162,78 @@ template <typename... Ts>
 void log_bench(rocblas_handle handle, Ts&&... xs)
 {
     if(handle->atomics_mode == rocblas_atomics_not_allowed)
-        log_arguments(*handle->log_bench_os, " ", std::forward<Ts>(xs)..., "--atomics_not_allowed");
+        log_arguments(*handle->log_bench_os,
+                      handle->log_bench_binary.get(),
+                      " ",
+                      std::forward<Ts>(xs)...,
+                      "--atomics_not_allowed");
     else
-        log_arguments(*handle->log_bench_os, " ", std::forward<Ts>(xs)...);
+        log_arguments(
+            *handle->log_bench_os, handle->log_bench_binary.get(), " ", std::forward<Ts>(xs)...);
 }
 
+// if performance counters or the timeline are turned on with
+// (handle->layer_mode & (rocblas_layer_mode_perf_counters | rocblas_layer_mode_log_timeline)) != 0
+// rocblas_perf_scope counts a call of func in the handle's and the process's counters, with
+// its host-side latency from construction to destruction, and records the call on the
+// handle's timeline. Every function which logs declares one next to its handle check, named
+// as in its trace log. Functions with a work formula also count the bytes and flops of work.
+// Null handles and device memory size queries are neither counted nor recorded.
+class rocblas_perf_scope
+{
+    rocblas_handle                        handle;
+    const char*                           func;
+    rocblas_perf_work                     work;
+    std::chrono::steady_clock::time_point start;
+    rocblas_hip_timeline::token           timeline_call;
+
+public:
+    rocblas_perf_scope(rocblas_handle           handle,
+                       const char*              func,
+                       const rocblas_perf_work& work = {})
+        : handle(handle
+                         && (handle->layer_mode
+                             & (rocblas_layer_mode_perf_counters | rocblas_layer_mode_log_timeline))
+                         && !handle->is_device_memory_size_query()
+                     ? handle
+                     : nullptr)
+        , func(func)
+        , work(work)
+    {
+        if(!this->handle)
+            return;
+        // Events are not recorded in capture-safe mode, whose streams may be captured
+        if(handle->timeline)
+            timeline_call = handle->timeline->begin(
+                func, handle->get_stream(), !handle->sync.capture_safe());
+        start = std::chrono::steady_clock::now();
+    }
+
+    ~rocblas_perf_scope()
+    try
+    {
+        if(!handle)
+            return;
+        if(handle->layer_mode & rocblas_layer_mode_perf_counters)
+        {
+            uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+            handle->perf_counters.record(func, work.bytes, work.flops, ns);
+            rocblas_process_perf_counters().record(func, work.bytes, work.flops, ns);
+        }
+        if(handle->timeline)
+            handle->timeline->end(timeline_call);
+    }
+    catch(...)
+    {
+        return;
+    }
+
+    rocblas_perf_scope(const rocblas_perf_scope&) = delete;
+    rocblas_perf_scope& operator=(const rocblas_perf_scope&) = delete;
+};
+
 /*************************************************
  * Trace log scalar values pointed to by pointer *
  *************************************************/
@@ -192,17 +257,19 @@ inline T log_trace_scalar_value(const T* value)
 }
 
 template <typename T>
-std::string log_trace_scalar_value(rocblas_handle handle, const T* value)
+auto log_trace_scalar_value(rocblas_handle handle, const T* value)
 {
-    rocblas_internal_ostream os;
-    T                        host;
+    T host;
     if(value && handle->pointer_mode == rocblas_pointer_mode_device)
     {
-        hipMemcpy(&host, value, sizeof(host), hipMemcpyDeviceToHost);
-        value = &host;
+        // In capture-safe mode the value is not read, and is logged as a NaN
+        value = handle->sync.copy(&host, value, sizeof(host), hipMemcpyDeviceToHost)
+                        == rocblas_status_success
+                    ? &host
+                    : nullptr;
     }
-    os << log_trace_scalar_value(value);
-    return os.str();
+    return rocblas_log_trace_scalar<decltype(log_trace_scalar_value(value))>{
+        log_trace_scalar_value(value)};
 }
 
 #define LOG_TRACE_SCALAR_VALUE(handle, value) log_trace_scalar_value(handle, value)
@@ -237,15 +304,25 @@ std::string log_bench_scalar_value(const char* name, const T* value)
 }
 
 template <typename T>
-std::string log_bench_scalar_value(rocblas_handle handle, const char* name, const T* value)
+auto log_bench_scalar_value(rocblas_handle handle, const char* name, const T* value)
 {
     T host;
     if(value && handle->pointer_mode == rocblas_pointer_mode_device)
     {
-        hipMemcpy(&host, value, sizeof(host), hipMemcpyDeviceToHost);
-        value = &host;
+        // In capture-safe mode the value is not read, and is logged as a NaN
+        value = handle->sync.copy(&host, value, sizeof(host), hipMemcpyDeviceToHost)
+                        == rocblas_status_success
+                    ? &host
+                    : nullptr;
     }
-    return log_bench_scalar_value(name, value);
+    auto scalar = log_trace_scalar_value(value);
+
+    // A null complex scalar is logged as a NaN real part only
+    if constexpr(is_complex<T>)
+        if(!value)
+            scalar = T{std::real(scalar), 0};
+
+    return rocblas_log_bench_scalar<decltype(scalar)>{name, scalar};
 }
 
 #define LOG_BENCH_SCALAR_VALUE(handle, name) log_bench_scalar_value(handle, #name, name)
@@ -0,0 +1,405 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas_ostream.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+/*****************************************************************************
+ * Compact binary format for ROCBLAS_LAYER trace and bench logging           *
+ *                                                                           *
+ * When ROCBLAS_LOG_BINARY is set, the trace and bench log streams contain   *
+ * a sequence of records instead of text lines. Every record starts with a   *
+ * byte holding its record_t in the low and its stream_t in the high four   *
+ * bits, followed by the varint id of the writer (one per handle and         *
+ * stream), the varint size of the payload, and the payload:                *
+ *                                                                           *
+ * header:     magic, varint version, uint64 handle address, uint64 time     *
+ *             in ns since the system_clock epoch. Starts a writer's string  *
+ *             table and clock.                                              *
+ * string_def: varint id, varint length, characters                          *
+ * call:       zigzag varint ns since the writer's previous record, varint   *
+ *             number of arguments, and the arguments, each a tag_t byte     *
+ *             followed by the argument's payload                            *
+ *                                                                           *
+ * Varints are unsigned LEB128; signed integers are zigzag encoded first.    *
+ * Floating-point values use the host byte order. Constant strings, like     *
+ * function and option names, are interned per writer, so a call record is  *
+ * mostly small integers and pointers. rocblas-log-decode converts a         *
+ * capture back into the text produced by the default logging mode.         *
+ *                                                                           *
+ * Arguments are tagged rather than stored in a fixed layout per function,   *
+ * because log_trace and log_bench take a different variadic argument list   *
+ * at each of hundreds of call sites. Tags let one decoder read every call,  *
+ * including ones added later, without a schema which must be kept in step  *
+ * with the library, and varints keep the sizes, strides and enumerations   *
+ * which make up most arguments to one or two bytes each.                   *
+ *****************************************************************************/
+namespace rocblas_binary_log
+{
+    constexpr char     magic[8] = {'R', 'O', 'C', 'B', 'L', 'O', 'G', '\0'};
+    constexpr uint32_t version  = 1;
+
+    enum class record_t : uint8_t
+    {
+        header,
+        string_def,
+        call,
+    };
+
+    enum class stream_t : uint8_t
+    {
+        trace,
+        bench,
+    };
+
+    enum class tag_t : uint8_t
+    {
+        sint, // zigzag varint
+        uint, // varint
+        f32, // float, also used for rocblas_half and rocblas_bfloat16
+        f64, // double
+        c32, // rocblas_float_complex
+        c64, // rocblas_double_complex
+        ptr, // varint pointer value
+        boolean, // uint8_t
+        chr, // char
+        str_ref, // varint id of an interned string
+        text, // varint length, characters
+        operation, // varint rocblas_operation
+        fill, // varint rocblas_fill
+        diagonal, // varint rocblas_diagonal
+        side, // varint rocblas_side
+        datatype, // varint rocblas_datatype
+        status, // varint rocblas_status
+        atomics_mode, // varint rocblas_atomics_mode
+        gemm_flags, // varint rocblas_gemm_flags
+        bench_scalar, // varint id of the interned option name, tagged value
+    };
+
+    inline void put_varint(std::string& buf, uint64_t x)
+    {
+        for(; x >= 0x80; x >>= 7)
+            buf.push_back(char(x | 0x80));
+        buf.push_back(char(x));
+    }
+
+    inline uint64_t zigzag(int64_t x)
+    {
+        return (uint64_t(x) << 1) ^ uint64_t(x >> 63);
+    }
+
+    inline int64_t unzigzag(uint64_t x)
+    {
+        return int64_t(x >> 1) ^ -int64_t(x & 1);
+    }
+}
+
+/***********************************************************************
+ * Scalar values captured for log_trace and log_bench. They are copied *
+ * to the host when the call is logged, and formatted on output, so    *
+ * that the binary writer can store them without converting to text.   *
+ ***********************************************************************/
+template <typename T>
+struct rocblas_log_trace_scalar
+{
+    T value;
+
+    friend std::ostream& operator<<(std::ostream& os, const rocblas_log_trace_scalar& x)
+    {
+        return os << x.value;
+    }
+};
+
+template <typename T>
+struct rocblas_log_bench_scalar
+{
+    const char* name;
+    T           value;
+
+    friend std::ostream& operator<<(std::ostream& os, const rocblas_log_bench_scalar& x)
+    {
+        return os << "--" << x.name << " " << x.value;
+    }
+};
+
+template <typename T>
+struct rocblas_log_bench_scalar<rocblas_complex_num<T>>
+{
+    const char*            name;
+    rocblas_complex_num<T> value;
+
+    friend std::ostream& operator<<(std::ostream& os, const rocblas_log_bench_scalar& x)
+    {
+        os << "--" << x.name << " " << std::real(x.value);
+        if(std::imag(x.value))
+            os << " --" << x.name << "i " << std::imag(x.value);
+        return os;
+    }
+};
+
+template <typename>
+struct is_log_trace_scalar : std::false_type
+{
+};
+
+template <typename T>
+struct is_log_trace_scalar<rocblas_log_trace_scalar<T>> : std::true_type
+{
+};
+
+template <typename>
+struct is_log_bench_scalar : std::false_type
+{
+};
+
+template <typename T>
+struct is_log_bench_scalar<rocblas_log_bench_scalar<T>> : std::true_type
+{
+};
+
+/*************************************************************************
+ * rocblas_binary_log_writer encodes log_trace and log_bench arguments   *
+ * of one handle into a rocblas_internal_ostream. Each call is sent to   *
+ * the stream's worker as a single write, preceded by the definitions of *
+ * any strings it uses for the first time.                               *
+ *************************************************************************/
+class rocblas_binary_log_writer
+{
+    using tag_t    = rocblas_binary_log::tag_t;
+    using record_t = rocblas_binary_log::record_t;
+
+    rocblas_internal_ostream&          os;
+    const rocblas_binary_log::stream_t stream;
+    const uint32_t                     id;
+    int64_t                            last_ns;
+
+    std::mutex  mutex;
+    std::string out; // records of the current call
+    std::string args; // arguments of the current call
+
+    // Interned strings, indexed by id. Most strings are literals, so lookups
+    // are first made by address, and confirmed by comparing the contents.
+    std::deque<std::string>                   names;
+    std::unordered_map<const char*, uint32_t> ids_by_address;
+    std::unordered_map<std::string, uint32_t> ids_by_content;
+
+    static int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    template <typename T>
+    static void append(std::string& buf, const T& x)
+    {
+        buf.append(reinterpret_cast<const char*>(&x), sizeof(x));
+    }
+
+    // Append a record with the given payload to out
+    void append_record(record_t kind, const std::string& payload)
+    {
+        out.push_back(char(uint8_t(kind) | uint8_t(stream) << 4));
+        rocblas_binary_log::put_varint(out, id);
+        rocblas_binary_log::put_varint(out, payload.size());
+        out.append(payload);
+    }
+
+    // Return the id of an interned string, defining it if it is new
+    uint32_t intern(const char* s)
+    {
+        auto addr = ids_by_address.find(s);
+        if(addr != ids_by_address.end() && names[addr->second] == s)
+            return addr->second;
+
+        uint32_t str_id;
+        auto     content = ids_by_content.find(s);
+        if(content != ids_by_content.end())
+            str_id = content->second;
+        else
+        {
+            str_id = uint32_t(names.size());
+            names.emplace_back(s);
+            ids_by_content.emplace(names.back(), str_id);
+
+            std::string def;
+            rocblas_binary_log::put_varint(def, str_id);
+            rocblas_binary_log::put_varint(def, names.back().size());
+            def.append(names.back());
+            append_record(record_t::string_def, def);
+        }
+        ids_by_address[s] = str_id;
+        return str_id;
+    }
+
+    void put_tag(tag_t tag)
+    {
+        args.push_back(char(tag));
+    }
+
+    void put_varint(tag_t tag, uint64_t x)
+    {
+        put_tag(tag);
+        rocblas_binary_log::put_varint(args, x);
+    }
+
+    template <typename T>
+    void put_raw(tag_t tag, const T& x)
+    {
+        put_tag(tag);
+        append(args, x);
+    }
+
+    void put_text(const std::string& s)
+    {
+        put_varint(tag_t::text, s.size());
+        args.append(s);
+    }
+
+    template <typename T>
+    void put(const T& x)
+    {
+        using U = std::decay_t<T>;
+        if constexpr(std::is_same<U, const char*>{} || std::is_same<U, char*>{})
+        {
+            const char* s = x;
+            put_varint(tag_t::str_ref, intern(s ? s : "(null)"));
+        }
+        else if constexpr(std::is_same<U, std::string>{})
+            put_text(x);
+        else if constexpr(std::is_same<U, bool>{})
+            put_raw(tag_t::boolean, uint8_t(x));
+        else if constexpr(std::is_same<U, char>{})
+            put_raw(tag_t::chr, x);
+        else if constexpr(std::is_same<U, rocblas_operation>{})
+            put_varint(tag_t::operation, uint32_t(x));
+        else if constexpr(std::is_same<U, rocblas_fill>{})
+            put_varint(tag_t::fill, uint32_t(x));
+        else if constexpr(std::is_same<U, rocblas_diagonal>{})
+            put_varint(tag_t::diagonal, uint32_t(x));
+        else if constexpr(std::is_same<U, rocblas_side>{})
+            put_varint(tag_t::side, uint32_t(x));
+        else if constexpr(std::is_same<U, rocblas_datatype>{})
+            put_varint(tag_t::datatype, uint32_t(x));
+        else if constexpr(std::is_same<U, rocblas_status>{})
+            put_varint(tag_t::status, uint32_t(x));
+        else if constexpr(std::is_same<U, rocblas_atomics_mode>{})
+            put_varint(tag_t::atomics_mode, uint32_t(x));
+        else if constexpr(std::is_same<U, rocblas_gemm_flags>{})
+            put_varint(tag_t::gemm_flags, uint32_t(x));
+        else if constexpr(std::is_enum<U>{} && sizeof(U) == sizeof(int32_t))
+            put_varint(tag_t::sint, rocblas_binary_log::zigzag(int32_t(x)));
+        else if constexpr(std::is_integral<U>{} && sizeof(U) >= sizeof(int32_t)
+                          && std::is_signed<U>{})
+            put_varint(tag_t::sint, rocblas_binary_log::zigzag(x));
+        else if constexpr(std::is_integral<U>{} && sizeof(U) >= sizeof(int32_t))
+            put_varint(tag_t::uint, x);
+        else if constexpr(std::is_same<U, float>{})
+            put_raw(tag_t::f32, x);
+        else if constexpr(std::is_same<U, double>{})
+            put_raw(tag_t::f64, x);
+        else if constexpr(std::is_same<U, rocblas_half>{} || std::is_same<U, rocblas_bfloat16>{})
+            put_raw(tag_t::f32, float(x));
+        else if constexpr(std::is_same<U, rocblas_float_complex>{})
+            put_raw(tag_t::c32, x);
+        else if constexpr(std::is_same<U, rocblas_double_complex>{})
+            put_raw(tag_t::c64, x);
+        else if constexpr(std::is_pointer<U>{})
+            put_varint(tag_t::ptr, uintptr_t(x));
+        else if constexpr(is_log_trace_scalar<U>{})
+            put(x.value);
+        else if constexpr(is_log_bench_scalar<U>{})
+        {
+            put_varint(tag_t::bench_scalar, intern(x.name));
+            put(x.value);
+        }
+        else
+        {
+            // Anything else is stored as its text representation
+            rocblas_internal_ostream ss;
+            ss << x;
+            put_text(ss.str());
+        }
+    }
+
+    static uint32_t next_id()
+    {
+        static std::atomic<uint32_t> count{0};
+        return count++;
+    }
+
+public:
+    rocblas_binary_log_writer(rocblas_internal_ostream&    os,
+                              rocblas_binary_log::stream_t stream,
+                              const void*                  handle)
+        : os(os)
+        , stream(stream)
+        , id(next_id())
+        , last_ns(now_ns())
+    {
+        std::string header(rocblas_binary_log::magic, sizeof(rocblas_binary_log::magic));
+        rocblas_binary_log::put_varint(header, rocblas_binary_log::version);
+        append(header, uint64_t(uintptr_t(handle)));
+        append(header, last_ns);
+        append_record(record_t::header, header);
+        os.write(out.data(), out.size());
+        os.flush();
+    }
+
+    rocblas_binary_log_writer(const rocblas_binary_log_writer&) = delete;
+    rocblas_binary_log_writer& operator=(const rocblas_binary_log_writer&) = delete;
+
+    // Encode one log_trace or log_bench call
+    template <typename... Ts>
+    void record(Ts&&... xs)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        out.clear();
+        args.clear();
+
+        int64_t ns = now_ns();
+        rocblas_binary_log::put_varint(args, rocblas_binary_log::zigzag(ns - last_ns));
+        rocblas_binary_log::put_varint(args, sizeof...(Ts));
+        last_ns = ns;
+        (put(xs), ...);
+
+        append_record(record_t::call, args);
+        os.write(out.data(), out.size());
+        os.flush();
+    }
+};
+
+/******************************************************************************
+ * log_arguments writes the arguments of one log_trace or log_bench call to   *
+ * os as a line of text separated by sep, or encodes them with binary if it   *
+ * is not null. Decoding the binary record reproduces the line of text.       *
+ ******************************************************************************/
+template <typename H, typename... Ts>
+void log_arguments(rocblas_internal_ostream&  os,
+                   rocblas_binary_log_writer* binary,
+                   const char*                sep,
+                   H&&                        head,
+                   Ts&&... xs)
+{
+    if(binary)
+        binary->record(std::forward<H>(head), std::forward<Ts>(xs)...);
+    else
+    {
+        os << std::forward<H>(head);
+        ((os << sep << std::forward<Ts>(xs)), ...);
+        os << std::endl;
+    }
+}
@@ -0,0 +1,233 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/******************************************************************************
+ * rocblas_size_class_pool caches memory blocks in size classes, so that      *
+ * blocks released by one user can be reused by another without returning    *
+ * them to the allocator. It is shared by all handles on a device, which only *
+ * hold a block while a device_malloc() allocation is alive.                   *
+ *                                                                             *
+ * Size classes are spaced four to a power of two, so that a block is never   *
+ * more than 25% larger than the size requested. A request is served from the *
+ * smallest cached block whose class is at most four classes above it.        *
+ *                                                                             *
+ * The Backend provides the memory and the stream ordering:                    *
+ *   void*  allocate(size_t size, context_t c)     nullptr on failure          *
+ *   void   deallocate(void* ptr, context_t c)                                 *
+ *   void   record(fence_t& fence, stream_t s)     release point on stream s   *
+ *   void   wait(fence_t& fence, stream_t s)       order stream s after fence  *
+ *   void   destroy(fence_t& fence)                                            *
+ * A block released on one stream may be acquired on another stream, so the   *
+ * acquiring stream waits for the fence recorded by the releasing stream.      *
+ * The context passed to acquire and trim, by the user on whose behalf memory  *
+ * is allocated or freed, is passed on to allocate and deallocate, so that the *
+ * user can count or refuse them.                                              *
+ * A host backend with empty fences allows testing without a GPU.              *
+ ******************************************************************************/
+template <typename Backend>
+class rocblas_size_class_pool
+{
+public:
+    using stream_t  = typename Backend::stream_t;
+    using fence_t   = typename Backend::fence_t;
+    using context_t = typename Backend::context_t;
+
+    // A block of memory held by a user of the pool
+    struct block_t
+    {
+        void*   ptr       = nullptr;
+        size_t  size      = 0; // Size of the block, which is a class size
+        size_t  requested = 0; // Size requested by the user
+        fence_t fence{};
+    };
+
+    // The smallest block size
+    static constexpr size_t MIN_BLOCK_SIZE = 4096;
+
+    // Size classes from a class up to MAX_CLASS_DISTANCE classes above it may serve a request
+    static constexpr size_t MAX_CLASS_DISTANCE = 4;
+
+    explicit rocblas_size_class_pool(Backend backend = Backend())
+        : m_backend(std::move(backend))
+    {
+    }
+
+    rocblas_size_class_pool(const rocblas_size_class_pool&) = delete;
+    rocblas_size_class_pool& operator=(const rocblas_size_class_pool&) = delete;
+
+    ~rocblas_size_class_pool()
+    {
+        trim();
+    }
+
+    // The size class index of a size
+    static size_t size_class(size_t size)
+    {
+        if(size <= MIN_BLOCK_SIZE)
+            return 0;
+
+        // size lies in (2^e, 2^(e+1)], split into four classes
+        size_t s = size - 1;
+        size_t e = 0;
+        while(s >> (e + 1))
+            ++e;
+        size_t sub = (s >> (e - 2)) & 3;
+        return (e - 12) * 4 + sub + 1;
+    }
+
+    // The block size of a size class
+    static size_t class_size(size_t c)
+    {
+        if(!c)
+            return MIN_BLOCK_SIZE;
+        size_t e   = (c - 1) / 4 + 12;
+        size_t sub = (c - 1) % 4;
+        return (size_t(4) + sub + 1) << (e - 2);
+    }
+
+    // Acquire a block of at least size bytes for use on stream, returning a
+    // block with a nullptr if the memory cannot be allocated. Unless allocate
+    // is true, only a cached block is returned.
+    block_t acquire(size_t size, stream_t stream, context_t context = {}, bool allocate = true)
+    {
+        size_t  c = size_class(size);
+        block_t block;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.allocations;
+
+            // Reuse the smallest cached block which is big enough
+            for(size_t k = c; k < m_free.size() && k <= c + MAX_CLASS_DISTANCE; ++k)
+            {
+                if(!m_free[k].empty())
+                {
+                    block = m_free[k].back();
+                    m_free[k].pop_back();
+                    m_stats.bytes_cached -= block.size;
+                    ++m_stats.reuses;
+                    break;
+                }
+            }
+
+            if(!block.ptr)
+            {
+                if(!allocate)
+                {
+                    ++m_stats.failures;
+                    return {};
+                }
+                block.size = class_size(c);
+                block.ptr  = m_backend.allocate(block.size, context);
+
+                // If the allocation fails, free the cached blocks and try again
+                if(!block.ptr && m_stats.bytes_cached)
+                {
+                    trim_locked(context);
+                    block.ptr = m_backend.allocate(block.size, context);
+                }
+                if(!block.ptr)
+                {
+                    ++m_stats.failures;
+                    return {};
+                }
+                ++m_stats.device_allocations;
+            }
+
+            block.requested = size;
+            m_stats.bytes_in_use += block.size;
+            m_stats.bytes_requested += size;
+            m_stats.high_water_in_use = std::max(m_stats.high_water_in_use, m_stats.bytes_in_use);
+            m_stats.high_water_reserved = std::max(m_stats.high_water_reserved,
+                                                   m_stats.bytes_in_use + m_stats.bytes_cached);
+        }
+
+        // Order the stream after the previous user of the block
+        m_backend.wait(block.fence, stream);
+        return block;
+    }
+
+    // Return a block to the pool after its last use on stream
+    void release(block_t block, stream_t stream)
+    {
+        if(!block.ptr)
+            return;
+
+        m_backend.record(block.fence, stream);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t                      c = size_class(block.size);
+        if(c >= m_free.size())
+            m_free.resize(c + 1);
+        m_stats.bytes_in_use -= block.size;
+        m_stats.bytes_requested -= block.requested;
+        m_stats.bytes_cached += block.size;
+        block.requested = 0;
+        m_free[c].push_back(block);
+    }
+
+    // Free all of the cached blocks
+    void trim(context_t context = {})
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        trim_locked(context);
+    }
+
+    // Get the statistics of the pool
+    rocblas_device_memory_pool_stats get_stats()
+    {
+        std::lock_guard<std::mutex>      lock(m_mutex);
+        rocblas_device_memory_pool_stats stats = m_stats;
+        stats.blocks_cached                    = 0;
+        for(const auto& blocks : m_free)
+            stats.blocks_cached += blocks.size();
+
+        // Fraction of the reserved memory which does not serve a request
+        size_t reserved     = stats.bytes_in_use + stats.bytes_cached;
+        stats.fragmentation = reserved ? 1 - double(stats.bytes_requested) / reserved : 0;
+        return stats;
+    }
+
+    // Reset the counters and high-water marks, keeping the current usage
+    void reset_stats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.allocations         = 0;
+        m_stats.reuses              = 0;
+        m_stats.device_allocations  = 0;
+        m_stats.device_frees        = 0;
+        m_stats.failures            = 0;
+        m_stats.high_water_in_use   = m_stats.bytes_in_use;
+        m_stats.high_water_reserved = m_stats.bytes_in_use + m_stats.bytes_cached;
+    }
+
+private:
+    void trim_locked(context_t context)
+    {
+        for(auto& blocks : m_free)
+        {
+            for(auto& block : blocks)
+            {
+                m_backend.destroy(block.fence);
+                m_backend.deallocate(block.ptr, context);
+                m_stats.bytes_cached -= block.size;
+                ++m_stats.device_frees;
+            }
+            blocks.clear();
+        }
+    }
+
+    Backend                           m_backend;
+    std::mutex                        m_mutex;
+    std::vector<std::vector<block_t>> m_free; // Cached blocks, indexed by size class
+    rocblas_device_memory_pool_stats  m_stats{};
+};
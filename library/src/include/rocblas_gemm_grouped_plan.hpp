@@ -0,0 +1,222 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include <vector>
+
+/*******************************************************************************
+ * rocblas_gemm_grouped_plan turns the groups of a grouped GEMM into batched    *
+ * GEMM launches. The problems of all groups are numbered in group order, which *
+ * is the order of the user's arrays of A, B, C and D pointers.                 *
+ *                                                                              *
+ * Groups which have the same transposes, sizes, leading dimensions, alpha and  *
+ * beta describe the same Tensile problem, so they select the same solution and *
+ * can be solved by one batched launch. They are put in one bucket, in order of *
+ * first appearance. Runs of a bucket's problems which are adjacent in the      *
+ * pointer arrays become segments. A bucket of one segment is launched directly *
+ * on the user's pointer arrays. The segments of the other buckets can be       *
+ * copied into gathered pointer arrays, so that each of those buckets is one    *
+ * launch, by gather launches copying up to SEGMENTS_PER_GATHER segments each.  *
+ * The segments are gathered when this saves more launches than it adds, and   *
+ * are otherwise launched one by one.                                           *
+ *                                                                              *
+ * Empty groups (m == 0, n == 0 or group_size == 0) are skipped. Since alpha is *
+ * not used when k == 0, it does not separate groups with k == 0. A launch has  *
+ * at most max_batch problems, and larger buckets are split.                    *
+ *                                                                              *
+ * The plan is computed on the host only, so it is tested without a GPU.        *
+ *******************************************************************************/
+
+// One group of a grouped GEMM. alpha and beta hold values of the compute type,
+// and their bytes beyond the size of the compute type must be zero.
+struct rocblas_gemm_group
+{
+    rocblas_operation trans_a;
+    rocblas_operation trans_b;
+    rocblas_int       m;
+    rocblas_int       n;
+    rocblas_int       k;
+    rocblas_int       lda;
+    rocblas_int       ldb;
+    rocblas_int       ldc;
+    rocblas_int       ldd;
+    rocblas_int       group_size;
+    rocblas_union_t   alpha;
+    rocblas_union_t   beta;
+};
+
+// A batched launch of problems with the shape, leading dimensions and scalars
+// of group. offset is the index of its first problem in the user's pointer
+// arrays, or in the gathered pointer arrays if gathered is true.
+struct rocblas_gemm_grouped_launch
+{
+    size_t      group;
+    size_t      offset;
+    rocblas_int batch_count;
+    bool        gathered;
+};
+
+// A copy of count pointers from index src of the user's pointer arrays to
+// index dst of the gathered pointer arrays
+struct rocblas_gemm_grouped_copy
+{
+    size_t src;
+    size_t dst;
+    size_t count;
+};
+
+class rocblas_gemm_grouped_plan
+{
+public:
+    static constexpr size_t SEGMENTS_PER_GATHER = 64;
+
+    rocblas_gemm_grouped_plan(const rocblas_gemm_group* groups,
+                              size_t                    group_count,
+                              size_t                    scalar_size,
+                              size_t                    max_batch = INT_MAX)
+    {
+        max_batch = std::max(max_batch, size_t(1));
+
+        // Index of the first problem of each group in the pointer arrays
+        std::vector<size_t> start(group_count);
+        for(size_t g = 0, offset = 0; g < group_count; ++g)
+        {
+            start[g] = offset;
+            offset += std::max(groups[g].group_size, 0);
+        }
+        m_problems = group_count ? start.back() + std::max(groups[group_count - 1].group_size, 0)
+                                 : 0;
+
+        // Bucket the non-empty groups in order of first appearance
+        std::map<key_t, size_t>          bucket_of;
+        std::vector<std::vector<size_t>> buckets;
+        for(size_t g = 0; g < group_count; ++g)
+        {
+            if(groups[g].m <= 0 || groups[g].n <= 0 || groups[g].group_size <= 0)
+                continue;
+            auto it = bucket_of.emplace(make_key(groups[g], scalar_size), buckets.size()).first;
+            if(it->second == buckets.size())
+                buckets.emplace_back();
+            buckets[it->second].push_back(g);
+        }
+
+        // Merge the adjacent problems of each bucket into segments
+        std::vector<std::vector<rocblas_gemm_grouped_copy>> segments(buckets.size());
+        size_t saved = 0, gather_segments = 0;
+        for(size_t b = 0; b < buckets.size(); ++b)
+        {
+            for(size_t g : buckets[b])
+            {
+                auto& seg = segments[b];
+                if(!seg.empty() && seg.back().src + seg.back().count == start[g])
+                    seg.back().count += groups[g].group_size;
+                else
+                    seg.push_back({start[g], 0, size_t(groups[g].group_size)});
+            }
+            if(segments[b].size() > 1)
+            {
+                saved += segments[b].size() - 1;
+                gather_segments += segments[b].size();
+            }
+        }
+        bool gather = saved > (gather_segments + SEGMENTS_PER_GATHER - 1) / SEGMENTS_PER_GATHER;
+
+        for(size_t b = 0; b < buckets.size(); ++b)
+        {
+            size_t group = buckets[b].front();
+            if(gather && segments[b].size() > 1)
+            {
+                size_t dst = m_gathered;
+                for(auto& seg : segments[b])
+                {
+                    seg.dst = m_gathered;
+                    m_gathered += seg.count;
+                    m_copies.push_back(seg);
+                }
+                add_launches(group, dst, m_gathered - dst, true, max_batch);
+            }
+            else
+            {
+                for(auto& seg : segments[b])
+                    add_launches(group, seg.src, seg.count, false, max_batch);
+            }
+        }
+    }
+
+    // Batched launches, in the order they are submitted
+    const std::vector<rocblas_gemm_grouped_launch>& launches() const
+    {
+        return m_launches;
+    }
+
+    // Copies into the gathered pointer arrays, done before the launches
+    const std::vector<rocblas_gemm_grouped_copy>& copies() const
+    {
+        return m_copies;
+    }
+
+    // Number of gather launches needed for the copies
+    size_t gather_launches() const
+    {
+        return (m_copies.size() + SEGMENTS_PER_GATHER - 1) / SEGMENTS_PER_GATHER;
+    }
+
+    // Number of problems in the gathered pointer arrays
+    size_t gathered() const
+    {
+        return m_gathered;
+    }
+
+    // Number of problems in the user's pointer arrays, including empty ones
+    size_t problems() const
+    {
+        return m_problems;
+    }
+
+private:
+    // Everything which selects the Tensile problem, with the scalars as bytes
+    using key_t = std::tuple<int,
+                             int,
+                             rocblas_int,
+                             rocblas_int,
+                             rocblas_int,
+                             rocblas_int,
+                             rocblas_int,
+                             rocblas_int,
+                             rocblas_int,
+                             std::vector<unsigned char>>;
+
+    static key_t make_key(const rocblas_gemm_group& g, size_t scalar_size)
+    {
+        scalar_size = std::min(scalar_size, sizeof(rocblas_union_t));
+        std::vector<unsigned char> scalars(2 * scalar_size);
+        if(g.k)
+            memcpy(scalars.data(), &g.alpha, scalar_size);
+        memcpy(scalars.data() + scalar_size, &g.beta, scalar_size);
+        return key_t{
+            g.trans_a, g.trans_b, g.m, g.n, g.k, g.lda, g.ldb, g.ldc, g.ldd, std::move(scalars)};
+    }
+
+    void add_launches(size_t group, size_t offset, size_t count, bool gathered, size_t max_batch)
+    {
+        for(size_t done = 0; done < count; done += max_batch)
+        {
+            size_t batch = std::min(count - done, max_batch);
+            m_launches.push_back({group, offset + done, rocblas_int(batch), gathered});
+        }
+    }
+
+    std::vector<rocblas_gemm_grouped_launch> m_launches;
+    std::vector<rocblas_gemm_grouped_copy>   m_copies;
+    size_t                                   m_gathered = 0;
+    size_t                                   m_problems = 0;
+};
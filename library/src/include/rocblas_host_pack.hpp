@@ -0,0 +1,288 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/******************************************************************************
+ * Host packing engine for the strided copies of rocblas_set_vector,          *
+ * rocblas_get_vector, rocblas_set_matrix and rocblas_get_matrix, which       *
+ * gather strided host data into staging buffers or scatter it back.          *
+ *                                                                             *
+ * Elements of 1, 2, 4, 8 and 16 bytes are copied as fixed-size values in     *
+ * unrolled loops, which the compiler turns into single vector loads and      *
+ * stores; other sizes use memcpy. Copies of at least parallel_bytes are      *
+ * split across a pool of host threads.                                        *
+ *                                                                             *
+ * Nothing here depends on HIP, so it can be tested and benchmarked on a CPU. *
+ ******************************************************************************/
+
+/*! \brief A fixed set of worker threads which run the iterations of a loop */
+class rocblas_host_thread_pool
+{
+    std::vector<std::thread>    m_threads;
+    std::mutex                  m_busy; // Held by the thread running a loop
+    std::mutex                  m_mutex;
+    std::condition_variable     m_start, m_done;
+    std::function<void(size_t)> m_fn;
+    size_t                      m_count      = 0;
+    std::atomic<size_t>         m_next       = {0};
+    size_t                      m_remaining  = 0; // Workers which have not finished the loop
+    size_t                      m_generation = 0;
+    bool                        m_exit       = false;
+
+    // Run iterations of the current loop until there are none left
+    void run_iterations()
+    {
+        for(size_t i; (i = m_next.fetch_add(1, std::memory_order_relaxed)) < m_count;)
+            m_fn(i);
+    }
+
+    void worker()
+    {
+        size_t generation = 0;
+        for(;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start.wait(lock, [&] { return m_exit || m_generation != generation; });
+                if(m_exit)
+                    return;
+                generation = m_generation;
+            }
+
+            run_iterations();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!--m_remaining)
+                m_done.notify_one();
+        }
+    }
+
+public:
+    /*! \brief Create nthreads workers. The thread calling parallel_for() also runs iterations. */
+    explicit rocblas_host_thread_pool(size_t nthreads)
+    {
+        for(size_t i = 0; i < nthreads; ++i)
+            m_threads.emplace_back([this] { worker(); });
+    }
+
+    ~rocblas_host_thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_exit = true;
+        }
+        m_start.notify_all();
+        for(auto& t : m_threads)
+            t.join();
+    }
+
+    rocblas_host_thread_pool(const rocblas_host_thread_pool&) = delete;
+    rocblas_host_thread_pool& operator=(const rocblas_host_thread_pool&) = delete;
+
+    /*! \brief Number of threads which run iterations, including the caller */
+    size_t concurrency() const
+    {
+        return m_threads.size() + 1;
+    }
+
+    /*! \brief Run fn(i) for i in [0, count), returning when all have finished.
+        If the pool is already running a loop for another thread, this loop is
+        run by the calling thread alone. */
+    template <typename F>
+    void parallel_for(size_t count, F&& fn)
+    {
+        std::unique_lock<std::mutex> busy(m_busy, std::try_to_lock);
+        if(!busy || m_threads.empty() || count <= 1)
+        {
+            for(size_t i = 0; i < count; ++i)
+                fn(i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_fn        = std::ref(fn);
+            m_count     = count;
+            m_next      = 0;
+            m_remaining = m_threads.size();
+            ++m_generation;
+        }
+        m_start.notify_all();
+
+        run_iterations();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&] { return !m_remaining; });
+        m_fn = nullptr;
+    }
+
+    /*! \brief The pool shared by the library. Its number of threads is set with
+        ROCBLAS_HOST_PACK_THREADS, where 0 or 1 disable multithreading; the
+        default is the number of hardware threads, up to 8. */
+    static rocblas_host_thread_pool& shared()
+    {
+        // Never destroyed, so that it may be used during exit
+        static auto* pool = [] {
+            const char* env     = getenv("ROCBLAS_HOST_PACK_THREADS");
+            size_t      threads = env ? strtoul(env, nullptr, 0)
+                                      : std::min<size_t>(std::thread::hardware_concurrency(), 8);
+            return new rocblas_host_thread_pool(threads > 1 ? threads - 1 : 0);
+        }();
+        return *pool;
+    }
+};
+
+/*! \brief Configuration of the host packing engine */
+struct rocblas_host_pack_config
+{
+    /*! \brief Pool which runs large copies, or nullptr to copy on the calling thread */
+    rocblas_host_thread_pool* pool = &rocblas_host_thread_pool::shared();
+
+    /*! \brief Minimum number of bytes copied by each thread */
+    size_t parallel_bytes = 256 * 1024;
+};
+
+namespace rocblas_host_pack_detail
+{
+    template <size_t N>
+    struct elem_t
+    {
+        char bytes[N];
+    };
+
+    // Copy n elements of N bytes with byte strides dinc and sinc
+    template <size_t N>
+    inline void strided_copy(
+        char* __restrict dst, ptrdiff_t dinc, const char* __restrict src, ptrdiff_t sinc, size_t n)
+    {
+        using T  = elem_t<N>;
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            T a, b, c, d;
+            memcpy(&a, src, N);
+            memcpy(&b, src + sinc, N);
+            memcpy(&c, src + 2 * sinc, N);
+            memcpy(&d, src + 3 * sinc, N);
+            memcpy(dst, &a, N);
+            memcpy(dst + dinc, &b, N);
+            memcpy(dst + 2 * dinc, &c, N);
+            memcpy(dst + 3 * dinc, &d, N);
+            src += 4 * sinc;
+            dst += 4 * dinc;
+        }
+        for(; i < n; ++i, src += sinc, dst += dinc)
+            memcpy(dst, src, N);
+    }
+
+    inline void strided_copy_any(char*       dst,
+                                 ptrdiff_t   dinc,
+                                 const char* src,
+                                 ptrdiff_t   sinc,
+                                 size_t      n,
+                                 size_t      elem_size)
+    {
+        if(dinc == ptrdiff_t(elem_size) && sinc == ptrdiff_t(elem_size))
+            return void(memcpy(dst, src, n * elem_size));
+
+        switch(elem_size)
+        {
+        case 1:
+            return strided_copy<1>(dst, dinc, src, sinc, n);
+        case 2:
+            return strided_copy<2>(dst, dinc, src, sinc, n);
+        case 4:
+            return strided_copy<4>(dst, dinc, src, sinc, n);
+        case 8:
+            return strided_copy<8>(dst, dinc, src, sinc, n);
+        case 16:
+            return strided_copy<16>(dst, dinc, src, sinc, n);
+        default:
+            for(size_t i = 0; i < n; ++i, src += sinc, dst += dinc)
+                memcpy(dst, src, elem_size);
+        }
+    }
+
+    // Split count items of item_bytes each into tasks of at least parallel_bytes
+    inline size_t task_count(size_t count, size_t item_bytes, const rocblas_host_pack_config& config)
+    {
+        if(!config.pool || !config.parallel_bytes)
+            return 1;
+        size_t tasks = count * item_bytes / config.parallel_bytes;
+        return std::max<size_t>(1, std::min({tasks, count, config.pool->concurrency()}));
+    }
+}
+
+/*! \brief Copy n elements of elem_size bytes from src, with a stride of sinc
+    elements, to dst, with a stride of dinc elements. Gathering into a
+    contiguous buffer has dinc == 1; scattering from one has sinc == 1. */
+inline void rocblas_host_strided_copy(void*                           dst,
+                                      ptrdiff_t                       dinc,
+                                      const void*                     src,
+                                      ptrdiff_t                       sinc,
+                                      size_t                          n,
+                                      size_t                          elem_size,
+                                      const rocblas_host_pack_config& config = {})
+{
+    ptrdiff_t dinc_bytes = dinc * ptrdiff_t(elem_size);
+    ptrdiff_t sinc_bytes = sinc * ptrdiff_t(elem_size);
+    size_t    tasks      = rocblas_host_pack_detail::task_count(n, elem_size, config);
+    auto      task       = [&](size_t t) {
+        size_t begin = n * t / tasks, end = n * (t + 1) / tasks;
+        rocblas_host_pack_detail::strided_copy_any((char*)dst + ptrdiff_t(begin) * dinc_bytes,
+                                                   dinc_bytes,
+                                                   (const char*)src + ptrdiff_t(begin) * sinc_bytes,
+                                                   sinc_bytes,
+                                                   end - begin,
+                                                   elem_size);
+    };
+
+    if(tasks > 1)
+        config.pool->parallel_for(tasks, task);
+    else
+        task(0);
+}
+
+/*! \brief Copy cols columns of col_bytes bytes from src, whose columns are
+    src_ld_bytes apart, to dst, whose columns are dst_ld_bytes apart. Packing
+    into a contiguous buffer has dst_ld_bytes == col_bytes; unpacking from one
+    has src_ld_bytes == col_bytes. */
+inline void rocblas_host_copy_columns(void*                           dst,
+                                      size_t                          dst_ld_bytes,
+                                      const void*                     src,
+                                      size_t                          src_ld_bytes,
+                                      size_t                          col_bytes,
+                                      size_t                          cols,
+                                      const rocblas_host_pack_config& config = {})
+{
+    if(dst_ld_bytes == col_bytes && src_ld_bytes == col_bytes)
+    {
+        // Contiguous: split the copy into byte ranges
+        rocblas_host_strided_copy(dst, 1, src, 1, cols * col_bytes, 1, config);
+        return;
+    }
+
+    size_t tasks = rocblas_host_pack_detail::task_count(cols, col_bytes, config);
+    auto   task  = [&](size_t t) {
+        for(size_t j = cols * t / tasks, end = cols * (t + 1) / tasks; j < end; ++j)
+            memcpy((char*)dst + j * dst_ld_bytes, (const char*)src + j * src_ld_bytes, col_bytes);
+    };
+
+    if(tasks > 1)
+        config.pool->parallel_for(tasks, task);
+    else
+        task(0);
+}
@@ -0,0 +1,231 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/******************************************************************************
+ * rocblas_host_result_staging copies results computed on the device, such as *
+ * those of reductions in host pointer mode, to the user's host memory through *
+ * pinned slots owned by a handle, instead of copying to pageable memory.      *
+ *                                                                             *
+ * In blocking mode the copy is waited for before returning, as hipMemcpy     *
+ * did. In deferred mode the copy into the slot is queued on the stream, and   *
+ * a completion queued after it copies the slot to the user's memory, so the   *
+ * result is only valid after the stream or an event recorded after the call  *
+ * is synchronized. The slot is busy until then, and a later copy uses another *
+ * slot; when MAX_SLOTS are busy, the oldest stream is synchronized.           *
+ *                                                                             *
+ * The Backend provides the memory and the stream ordering:                    *
+ *   void*          allocate(size_t size)           pinned, nullptr on failure *
+ *   void           deallocate(void* ptr)                                      *
+ *   rocblas_status copy_async(void* dst, const void* src, size_t, stream_t)   *
+ *   rocblas_status synchronize(stream_t s)                                    *
+ *   rocblas_status enqueue(stream_t s, rocblas_host_result_slot* slot)        *
+ * enqueue must arrange for rocblas_host_result_slot::complete(slot) to run on *
+ * the host after the work already queued on s. A host backend which runs the *
+ * completions when synchronized allows testing without a GPU.                 *
+ ******************************************************************************/
+
+// A pinned slot and the copy pending on it
+struct rocblas_host_result_slot
+{
+    void*             ptr   = nullptr;
+    size_t            size  = 0;
+    void*             dst   = nullptr; // User's memory, when deferred
+    size_t            bytes = 0;
+    std::atomic<bool> busy{false};
+
+    // Copy the slot to the user's memory and free the slot. Makes no HIP calls.
+    static void complete(rocblas_host_result_slot* slot)
+    {
+        memcpy(slot->dst, slot->ptr, slot->bytes);
+        slot->busy.store(false, std::memory_order_release);
+    }
+};
+
+template <typename Backend>
+class rocblas_host_result_staging
+{
+public:
+    using stream_t = typename Backend::stream_t;
+
+    // The smallest slot size; slot sizes are powers of two
+    static constexpr size_t MIN_SLOT_SIZE = 256;
+
+    // The most slots, and so the most deferred copies pending at once
+    static constexpr size_t MAX_SLOTS = 64;
+
+    explicit rocblas_host_result_staging(Backend backend = Backend())
+        : m_backend(std::move(backend))
+    {
+    }
+
+    // Waits for pending copies, whose streams must still exist, and frees the slots
+    ~rocblas_host_result_staging()
+    {
+        synchronize();
+        for(auto& e : m_slots)
+            if(e->slot.ptr)
+                m_backend.deallocate(e->slot.ptr);
+    }
+
+    rocblas_host_result_staging(const rocblas_host_result_staging&) = delete;
+    rocblas_host_result_staging& operator=(const rocblas_host_result_staging&) = delete;
+
+    /*! \brief Copy bytes from device memory src, after the work queued on stream,
+        to host memory dst, waiting for the copy unless deferred is true */
+    rocblas_status copy(void* dst, const void* src, size_t bytes, stream_t stream, bool deferred)
+    {
+        if(!bytes)
+            return rocblas_status_success;
+
+        entry_t* e = acquire(bytes);
+        if(!e)
+            return rocblas_status_memory_error;
+
+        e->stream         = stream;
+        e->slot.dst       = dst;
+        e->slot.bytes     = bytes;
+        rocblas_status st = m_backend.copy_async(e->slot.ptr, src, bytes, stream);
+
+        if(st == rocblas_status_success && deferred)
+        {
+            e->sequence = ++m_sequence;
+            if(m_backend.enqueue(stream, &e->slot) == rocblas_status_success)
+                return st;
+        }
+
+        // Blocking, or the completion could not be queued and the copy is waited for
+        if(st == rocblas_status_success)
+            st = m_backend.synchronize(stream);
+        if(st == rocblas_status_success)
+            memcpy(dst, e->slot.ptr, bytes);
+        e->slot.busy.store(false, std::memory_order_release);
+        return st;
+    }
+
+    /*! \brief Wait for all pending deferred copies */
+    rocblas_status synchronize()
+    {
+        rocblas_status st = rocblas_status_success;
+        for(auto& e : m_slots)
+            if(e->slot.busy.load(std::memory_order_acquire))
+            {
+                rocblas_status s = m_backend.synchronize(e->stream);
+                if(s != rocblas_status_success)
+                    st = s;
+            }
+        return st;
+    }
+
+    /*! \brief Number of deferred copies which have not completed */
+    size_t pending() const
+    {
+        size_t n = 0;
+        for(auto& e : m_slots)
+            n += e->slot.busy.load(std::memory_order_acquire);
+        return n;
+    }
+
+    /*! \brief Number of slots allocated */
+    size_t slots() const
+    {
+        return m_slots.size();
+    }
+
+    /*! \brief Total size of the slots */
+    size_t bytes() const
+    {
+        size_t n = 0;
+        for(auto& e : m_slots)
+            n += e->slot.size;
+        return n;
+    }
+
+private:
+    struct entry_t
+    {
+        rocblas_host_result_slot slot;
+        stream_t                 stream{};
+        size_t                   sequence = 0; // Order of deferral, to find the oldest
+    };
+
+    static size_t slot_size(size_t bytes)
+    {
+        size_t size = MIN_SLOT_SIZE;
+        while(size < bytes)
+            size *= 2;
+        return size;
+    }
+
+    // Find an idle slot of at least bytes, growing or adding one if needed,
+    // and mark it busy. Returns nullptr if memory cannot be allocated.
+    entry_t* acquire(size_t bytes)
+    {
+        for(;;)
+        {
+            entry_t* fit    = nullptr; // Smallest idle slot which is large enough
+            entry_t* small  = nullptr; // Largest idle slot which is too small
+            entry_t* oldest = nullptr; // Busy slot deferred first
+            for(auto& p : m_slots)
+            {
+                entry_t* e = p.get();
+                if(e->slot.busy.load(std::memory_order_acquire))
+                {
+                    if(!oldest || e->sequence < oldest->sequence)
+                        oldest = e;
+                }
+                else if(e->slot.size >= bytes)
+                {
+                    if(!fit || e->slot.size < fit->slot.size)
+                        fit = e;
+                }
+                else if(!small || e->slot.size > small->slot.size)
+                    small = e;
+            }
+
+            if(!fit && (small || m_slots.size() < MAX_SLOTS))
+            {
+                size_t size = slot_size(bytes);
+                void*  ptr  = m_backend.allocate(size);
+                if(!ptr)
+                    return nullptr;
+                if(small)
+                {
+                    m_backend.deallocate(small->slot.ptr);
+                    fit = small;
+                }
+                else
+                {
+                    m_slots.push_back(std::make_unique<entry_t>());
+                    fit = m_slots.back().get();
+                }
+                fit->slot.ptr  = ptr;
+                fit->slot.size = size;
+            }
+
+            if(fit)
+            {
+                fit->slot.busy.store(true, std::memory_order_relaxed);
+                return fit;
+            }
+
+            // All slots are busy: wait for the oldest deferred copy
+            if(m_backend.synchronize(oldest->stream) != rocblas_status_success)
+                return nullptr;
+        }
+    }
+
+    Backend                               m_backend;
+    std::vector<std::unique_ptr<entry_t>> m_slots;
+    size_t                                m_sequence = 0;
+};
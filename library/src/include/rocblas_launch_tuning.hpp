@@ -0,0 +1,309 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+ * A launch tuning table selects the block dimensions of BLAS1 and BLAS2       *
+ * kernels by kernel, architecture, precision, transpose and size, so that     *
+ * they are retuned for a GPU without rebuilding rocBLAS. It is text, with one *
+ * entry per line:                                                             *
+ *                                                                             *
+ *   kernel arch precision trans m_min m_max n_min n_max dim_x dim_y           *
+ *                                                                             *
+ * kernel is gemvn, gemvt or scal, arch is as returned by getArch(), e.g. 908, *
+ * precision is f16_r, f32_r, f64_r, f32_c or f64_c, and trans is N, T or C.   *
+ * The entry applies to m_min <= m <= m_max and n_min <= n <= n_max; for scal, *
+ * m is the length of the vector and n is 1. * matches any arch, precision or  *
+ * trans, and as m_max or n_max is unbounded. # starts a comment.              *
+ *                                                                             *
+ * The first matching entry is used. Its dim_x x dim_y must be one of those    *
+ * the kernel is compiled for, as listed by rocblas_launch_tuning_configs.     *
+ * A handle looks up the entries of rocblas_set_launch_tuning_table, then      *
+ * those of the file named by ROCBLAS_LAUNCH_TUNING_FILE, then those of        *
+ * rocblas_launch_tuning_default_table, keeping only those of its arch.        *
+ *                                                                             *
+ * The table is used on the host only, so it is tested without a GPU.          *
+ ******************************************************************************/
+
+// The kernels whose launch is tuned
+enum class rocblas_tuned_kernel
+{
+    gemvn, // gemv with transA == N, except for skinny matrices
+    gemvt, // gemv with transA == T or C, except for few rows, or skinny n with a workspace
+    scal,  // scal, of a vector of length m
+};
+
+struct rocblas_launch_dims
+{
+    rocblas_int dim_x;
+    rocblas_int dim_y;
+};
+
+inline bool operator==(const rocblas_launch_dims& a, const rocblas_launch_dims& b)
+{
+    return a.dim_x == b.dim_x && a.dim_y == b.dim_y;
+}
+
+inline const char* rocblas_tuned_kernel_name(rocblas_tuned_kernel kernel)
+{
+    switch(kernel)
+    {
+    case rocblas_tuned_kernel::gemvn:
+        return "gemvn";
+    case rocblas_tuned_kernel::gemvt:
+        return "gemvt";
+    case rocblas_tuned_kernel::scal:
+        return "scal";
+    }
+    return "invalid";
+}
+
+// The block dimensions each kernel is compiled for
+inline const std::vector<rocblas_launch_dims>&
+    rocblas_launch_tuning_configs(rocblas_tuned_kernel kernel)
+{
+    static const std::vector<rocblas_launch_dims> gemvn{{32, 16}, {64, 16}};
+    static const std::vector<rocblas_launch_dims> gemvt{{256, 1}, {1024, 1}};
+    static const std::vector<rocblas_launch_dims> scal{{256, 1}, {512, 1}, {1024, 1}};
+    switch(kernel)
+    {
+    case rocblas_tuned_kernel::gemvn:
+        return gemvn;
+    case rocblas_tuned_kernel::gemvt:
+        return gemvt;
+    case rocblas_tuned_kernel::scal:
+        break;
+    }
+    return scal;
+}
+
+// The table compiled into rocBLAS. The gemvn entries for gfx906 and gfx908 are the sizes
+// below which 512 threads per block are faster.
+constexpr char rocblas_launch_tuning_default_table[] = R"(
+# kernel arch precision trans m_min m_max n_min n_max dim_x dim_y
+gemvn 908 f32_r N     0 15000     0 15000   32 16
+gemvn 908 f64_r N     0 15000     0 15000   32 16
+gemvn 908 f32_c N     0 15000     0 15000   32 16
+gemvn 908 f64_c N     0 18000     0 18000   32 16
+gemvn 906 f32_c N     0     *     0     *   32 16
+gemvn 906 f32_r N     0  6000     0  6000   32 16
+gemvn 906 f64_r N     0 24000     0 24000   32 16
+gemvn 906 f64_r N 15000     * 15000     *   32 16
+gemvn   *     * N     0     *     0     *   64 16
+gemvt   * f32_r *     0     *     0     *  256  1
+gemvt   *     * *     0     *     0     * 1024  1
+scal    *     * *     0     *     0     *  256  1
+)";
+
+struct rocblas_launch_tuning_entry
+{
+    rocblas_tuned_kernel kernel;
+    int                  arch;      // 0 matches any
+    rocblas_datatype     precision; // rocblas_datatype(-1) matches any
+    char                 trans;     // 0 matches any
+    int64_t              m_min;
+    int64_t              m_max;
+    int64_t              n_min;
+    int64_t              n_max;
+    rocblas_launch_dims  dims;
+};
+
+class rocblas_launch_tuning_table
+{
+public:
+    /*! \brief Appends the entries of a table's text. On an error, it appends none of them,
+        and returns false with the line and what is wrong in error. */
+    bool parse(std::istream& is, std::string& error)
+    {
+        std::vector<rocblas_launch_tuning_entry> entries;
+        size_t                                   line_number = 0;
+        for(std::string line; std::getline(is, line);)
+        {
+            ++line_number;
+            std::istringstream       fields(line.substr(0, line.find('#')));
+            std::vector<std::string> f;
+            for(std::string field; fields >> field;)
+                f.push_back(field);
+            if(f.empty())
+                continue;
+
+            rocblas_launch_tuning_entry entry;
+            std::string                 what = parse_entry(f, entry);
+            if(!what.empty())
+            {
+                error = "line " + std::to_string(line_number) + ": " + what;
+                return false;
+            }
+            entries.push_back(entry);
+        }
+        m_entries.insert(m_entries.end(), entries.begin(), entries.end());
+        return true;
+    }
+
+    bool parse(const char* text, std::string& error)
+    {
+        std::istringstream is(text);
+        return parse(is, error);
+    }
+
+    /*! \brief Appends the entries of other which apply to arch, or all of them if arch is 0 */
+    void append(const rocblas_launch_tuning_table& other, int arch = 0)
+    {
+        for(auto& entry : other.m_entries)
+            if(!arch || !entry.arch || entry.arch == arch)
+                m_entries.push_back(entry);
+    }
+
+    /*! \brief The dimensions of the first entry which matches, or nullptr if none does */
+    const rocblas_launch_dims* lookup(rocblas_tuned_kernel kernel,
+                                      int                  arch,
+                                      rocblas_datatype     precision,
+                                      rocblas_operation    trans,
+                                      int64_t              m,
+                                      int64_t              n) const
+    {
+        char t = trans_char(trans);
+        for(auto& e : m_entries)
+            if(e.kernel == kernel && (!e.arch || e.arch == arch)
+               && (e.precision == rocblas_datatype(-1) || e.precision == precision)
+               && (!e.trans || e.trans == t) && m >= e.m_min && m <= e.m_max && n >= e.n_min
+               && n <= e.n_max)
+                return &e.dims;
+        return nullptr;
+    }
+
+    /*! \brief Writes the entries in the text format which parse reads */
+    void write(std::ostream& os) const
+    {
+        auto bound = [](int64_t b) {
+            return b == INT64_MAX ? std::string("*") : std::to_string(b);
+        };
+        for(auto& e : m_entries)
+        {
+            os << rocblas_tuned_kernel_name(e.kernel) << ' '
+               << (e.arch ? std::to_string(e.arch) : "*") << ' '
+               << (e.precision == rocblas_datatype(-1) ? "*" : precision_name(e.precision)) << ' '
+               << (e.trans ? e.trans : '*') << ' ' << e.m_min << ' ' << bound(e.m_max) << ' '
+               << e.n_min << ' ' << bound(e.n_max) << ' ' << e.dims.dim_x << ' '
+               << e.dims.dim_y << '\n';
+        }
+    }
+
+    void add(const rocblas_launch_tuning_entry& entry)
+    {
+        m_entries.push_back(entry);
+    }
+
+    const std::vector<rocblas_launch_tuning_entry>& entries() const
+    {
+        return m_entries;
+    }
+
+    static char trans_char(rocblas_operation trans)
+    {
+        return trans == rocblas_operation_none        ? 'N'
+               : trans == rocblas_operation_transpose ? 'T'
+                                                      : 'C';
+    }
+
+    static const char* precision_name(rocblas_datatype precision)
+    {
+        for(auto& p : precisions)
+            if(p.type == precision)
+                return p.name;
+        return "invalid";
+    }
+
+private:
+    struct precision_entry
+    {
+        rocblas_datatype type;
+        const char*      name;
+    };
+    static constexpr precision_entry precisions[] = {{rocblas_datatype_f16_r, "f16_r"},
+                                                     {rocblas_datatype_f32_r, "f32_r"},
+                                                     {rocblas_datatype_f64_r, "f64_r"},
+                                                     {rocblas_datatype_f32_c, "f32_c"},
+                                                     {rocblas_datatype_f64_c, "f64_c"}};
+
+    // Parses a non-negative integer, or * as unbounded if star is set
+    static bool parse_number(const std::string& s, bool star, int64_t& value)
+    {
+        if(star && s == "*")
+        {
+            value = INT64_MAX;
+            return true;
+        }
+        char* end;
+        value = strtoll(s.c_str(), &end, 10);
+        return !s.empty() && !*end && value >= 0;
+    }
+
+    // Returns what is wrong with the fields f of an entry, or "" if they are valid
+    static std::string parse_entry(const std::vector<std::string>& f,
+                                   rocblas_launch_tuning_entry&    entry)
+    {
+        if(f.size() != 10)
+            return "expected 10 fields, found " + std::to_string(f.size());
+
+        if(f[0] == "gemvn")
+            entry.kernel = rocblas_tuned_kernel::gemvn;
+        else if(f[0] == "gemvt")
+            entry.kernel = rocblas_tuned_kernel::gemvt;
+        else if(f[0] == "scal")
+            entry.kernel = rocblas_tuned_kernel::scal;
+        else
+            return "unknown kernel " + f[0];
+
+        int64_t arch = 0;
+        if(f[1] != "*" && (!parse_number(f[1], false, arch) || !arch || arch > INT32_MAX))
+            return "invalid arch " + f[1];
+        entry.arch = int(arch);
+
+        entry.precision = rocblas_datatype(-1);
+        if(f[2] != "*")
+        {
+            for(auto& p : precisions)
+                if(f[2] == p.name)
+                    entry.precision = p.type;
+            if(entry.precision == rocblas_datatype(-1))
+                return "invalid precision " + f[2];
+        }
+
+        if(f[3] == "*")
+            entry.trans = 0;
+        else if(f[3] == "N" || f[3] == "T" || f[3] == "C")
+            entry.trans = f[3][0];
+        else
+            return "invalid trans " + f[3];
+
+        if(!parse_number(f[4], false, entry.m_min) || !parse_number(f[5], true, entry.m_max)
+           || entry.m_min > entry.m_max)
+            return "invalid m range " + f[4] + " " + f[5];
+        if(!parse_number(f[6], false, entry.n_min) || !parse_number(f[7], true, entry.n_max)
+           || entry.n_min > entry.n_max)
+            return "invalid n range " + f[6] + " " + f[7];
+
+        int64_t dim_x, dim_y;
+        if(!parse_number(f[8], false, dim_x) || !parse_number(f[9], false, dim_y))
+            return "invalid dimensions " + f[8] + " " + f[9];
+        entry.dims = {rocblas_int(dim_x), rocblas_int(dim_y)};
+        for(auto& dims : rocblas_launch_tuning_configs(entry.kernel))
+            if(dims.dim_x == dim_x && dims.dim_y == dim_y)
+                return "";
+        return f[0] + " is not compiled for " + f[8] + " x " + f[9];
+    }
+
+    std::vector<rocblas_launch_tuning_entry> m_entries;
+};
@@ -0,0 +1,249 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/******************************************************************************
+ * rocblas_lazy_code_objects defers loading code objects until one of their   *
+ * kernels is launched. The code object containing a kernel is found by       *
+ * searching the memory-mapped files for the kernel's symbol name, so only    *
+ * the files which are needed get loaded.                                     *
+ *                                                                            *
+ * load() is called before every launch. Kernel names which have already     *
+ * been resolved are looked up without locking, in an insert-only table of   *
+ * names which are never freed. Only the first launch of a kernel takes the  *
+ * mutex, and a kernel found in a code object which is already loaded is    *
+ * resolved without searching the pending files.                             *
+ *                                                                            *
+ * The Adapter passed to load() provides:                                     *
+ *   bool has_kernel(const std::string& name)  kernel is in a loaded file     *
+ *   void load_file(const std::string& path)                                  *
+ * Kernels are a range of objects with a kernelName member.                   *
+ * A host adapter which records the files loaded allows testing without a GPU.*
+ ******************************************************************************/
+class rocblas_lazy_code_objects
+{
+    struct code_object_t
+    {
+        std::string path;
+        const char* data = nullptr; // Contents of the file, once it is mapped
+        size_t      size = 0;
+    };
+
+    // Number of slots in the table of resolved names, which is a power of 2
+    static constexpr size_t RESOLVED_SLOTS = 4096;
+
+    // Names are only added to the table while it is at most 3/4 full, so that
+    // lookups of names which are not in it end at an empty slot quickly
+    static constexpr size_t MAX_RESOLVED = RESOLVED_SLOTS / 4 * 3;
+
+    std::vector<code_object_t>      m_pending;
+    std::unordered_set<std::string> m_resolved; // Kernel names already searched for
+    std::deque<std::string>         m_names; // Storage for the names in m_resolved_slots
+    std::unique_ptr<std::atomic<const std::string*>[]> m_resolved_slots;
+    std::mutex                                         m_mutex;
+    std::atomic<bool>                                  m_all_loaded{true};
+
+    static void unmap(code_object_t& co)
+    {
+#ifndef WIN32
+        if(co.data)
+            munmap(const_cast<char*>(co.data), co.size);
+#endif
+        co.data = nullptr;
+    }
+
+    // Whether a kernel name has been resolved, without locking
+    bool is_resolved(const std::string& name) const
+    {
+        size_t hash = std::hash<std::string>{}(name);
+        for(size_t i = 0; i < RESOLVED_SLOTS; ++i)
+        {
+            auto slot = m_resolved_slots[(hash + i) % RESOLVED_SLOTS].load(
+                std::memory_order_acquire);
+            if(!slot)
+                return false;
+            if(*slot == name)
+                return true;
+        }
+        return false;
+    }
+
+    // Publish a resolved kernel name to lock-free lookups, with m_mutex held.
+    // Names which do not fit are still found in m_resolved under the mutex.
+    void publish(const std::string& name)
+    {
+        if(m_names.size() >= MAX_RESOLVED)
+            return;
+        m_names.push_back(name);
+        size_t hash = std::hash<std::string>{}(name);
+        for(size_t i = 0;; ++i)
+        {
+            auto& slot = m_resolved_slots[(hash + i) % RESOLVED_SLOTS];
+            if(!slot.load(std::memory_order_relaxed))
+            {
+                slot.store(&m_names.back(), std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    // Whether the code object's file contains the symbol name
+    static bool contains(code_object_t& co, const std::string& name)
+    {
+#ifdef WIN32
+        return true;
+#else
+        if(!co.data)
+        {
+            int fd = open(co.path.c_str(), O_RDONLY | O_CLOEXEC);
+            if(fd == -1)
+                return true; // Let the adapter's load_file() report the error
+            struct stat st;
+            if(!fstat(fd, &st) && st.st_size)
+            {
+                void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(p != MAP_FAILED)
+                {
+                    co.data = static_cast<const char*>(p);
+                    co.size = st.st_size;
+                }
+            }
+            close(fd);
+            if(!co.data)
+                return true;
+        }
+
+        // Symbol names are NUL-terminated in the ELF string tables
+        std::string needle(1, '\0');
+        needle += name;
+        needle += '\0';
+        auto end = co.data + co.size;
+        return std::search(co.data,
+                           end,
+                           std::boyer_moore_horspool_searcher<std::string::const_iterator>(
+                               needle.begin(), needle.end()))
+               != end;
+#endif
+    }
+
+public:
+    rocblas_lazy_code_objects()
+        : m_resolved_slots(new std::atomic<const std::string*>[RESOLVED_SLOTS]())
+    {
+    }
+
+    rocblas_lazy_code_objects(const rocblas_lazy_code_objects&) = delete;
+    rocblas_lazy_code_objects& operator=(const rocblas_lazy_code_objects&) = delete;
+
+    ~rocblas_lazy_code_objects()
+    {
+        for(auto& co : m_pending)
+            unmap(co);
+    }
+
+    // Whether the code object at path should be loaded at initialization.
+    // list is a comma-separated list of items, each either a substring of the
+    // code object file name, or arch:substring to only preload for arch.
+    static bool preload(const std::string& path, const std::string& processor, const char* list)
+    {
+        if(!list)
+            return false;
+
+        std::string       name = path.substr(path.find_last_of("/\\") + 1);
+        std::stringstream items(list);
+        for(std::string item; std::getline(items, item, ',');)
+        {
+            auto colon = item.find(':');
+            if(colon != std::string::npos)
+            {
+                if(item.substr(0, colon) != processor)
+                    continue;
+                item.erase(0, colon + 1);
+            }
+            if(name.find(item) != std::string::npos)
+                return true;
+        }
+        return false;
+    }
+
+    // Add a code object to be loaded when needed
+    void add(std::string path)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        code_object_t               co;
+        co.path = std::move(path);
+        m_pending.push_back(std::move(co));
+        m_all_loaded.store(false, std::memory_order_release);
+    }
+
+    // Number of code objects not loaded yet
+    size_t pending()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.size();
+    }
+
+    // Load the code objects containing the kernels about to be launched
+    template <typename Adapter, typename Kernels>
+    void load(Adapter& adapter, const Kernels& kernels)
+    {
+        if(m_all_loaded.load(std::memory_order_acquire))
+            return;
+
+        if(std::all_of(kernels.begin(), kernels.end(), [this](const auto& kernel) {
+               return is_resolved(kernel.kernelName);
+           }))
+            return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(const auto& kernel : kernels)
+        {
+            const std::string& name = kernel.kernelName;
+            if(!m_resolved.insert(name).second)
+                continue;
+
+            // A kernel in a code object which is already loaded needs no search
+            if(!adapter.has_kernel(name))
+            {
+                for(auto it = m_pending.begin(); it != m_pending.end(); ++it)
+                {
+                    if(contains(*it, name))
+                    {
+                        unmap(*it);
+                        adapter.load_file(it->path);
+                        m_pending.erase(it);
+                        break;
+                    }
+                }
+            }
+
+            // Only published once its code object is loaded
+            publish(name);
+        }
+
+        if(m_pending.empty())
+            m_all_loaded.store(true, std::memory_order_release);
+    }
+};
@@ -24,6 +24,7 @@
 #include <sys/stat.h>
 #include <thread>
 #include <utility>
+#include <vector>
 #ifdef WIN32
 #include <io.h>
 #include <iostream>
@@ -61,24 +62,49 @@ class ROCBLAS_INTERNAL_EXPORT rocblas_internal_ostream
      **************************************************************************/
     class worker
     {
-        // task_t represents a payload of data and a promise to finish
+        // task_t represents a payload of data and an optional promise to finish
         class task_t
         {
-            std::string        str;
-            std::promise<void> promise;
+        public:
+            // Kinds of tasks: write the payload, flush all prior writes, or close the stream
+            enum class kind_t
+            {
+                write,
+                flush,
+                close,
+            };
+
+        private:
+            kind_t                              kind;
+            std::string                         str;
+            std::unique_ptr<std::promise<void>> promise; // nullptr if nobody waits
 
         public:
             // The task takes ownership of the string payload and promise
-            task_t(std::string&& str, std::promise<void>&& promise)
-                : str(std::move(str))
+            task_t(kind_t kind, std::string&& str, std::unique_ptr<std::promise<void>>&& promise)
+                : kind(kind)
+                , str(std::move(str))
                 , promise(std::move(promise))
             {
             }
 
-            // Notify the future to wake up
+            // Notify the future to wake up, if there is one
             void set_value()
             {
-                promise.set_value();
+                if(promise)
+                    promise->set_value();
+            }
+
+            // Whether anybody waits for the task to be completed
+            bool has_promise() const
+            {
+                return promise != nullptr;
+            }
+
+            // Kind of the task
+            kind_t get_kind() const
+            {
+                return kind;
             }
 
             // Size of the string payload
@@ -103,15 +129,36 @@ class ROCBLAS_INTERNAL_EXPORT rocblas_internal_ostream
         // Condition variable for worker notification
         std::condition_variable cond;
 
+        // Condition variable for producers waiting for room in a full asynchronous queue
+        std::condition_variable space_cond;
+
         // Mutex for this thread's queue
         std::mutex mutex;
 
         // Queue of tasks
         std::queue<task_t> queue;
 
-        // Worker thread which waits for and handles tasks sequentially
+        // Whether writes return before the data has been written
+        const bool async;
+
+        // Maximum number of queued asynchronous writes
+        const size_t capacity;
+
+        // Whether asynchronous writes are dropped, rather than blocking, when the queue is full
+        const bool drop;
+
+        // Number of writes dropped because the queue was full or the file could not be written
+        size_t dropped = 0;
+
+        // Whether writing the file failed, after which the worker thread has exited
+        bool failed = false;
+
+        // Worker thread which waits for and handles tasks in batches
         void thread_function();
 
+        // Queue a task and wait for it to be completed
+        void send_and_wait(task_t::kind_t kind, std::string str);
+
     public:
         // Worker constructor creates a worker thread for a raw filehandle
         explicit worker(int fd);
@@ -119,6 +166,9 @@ class ROCBLAS_INTERNAL_EXPORT rocblas_internal_ostream
         // Send a string to be written
         void send(std::string);
 
+        // Wait until all strings sent before this call have been written
+        void flush();
+
         // Destroy a worker when all std::shared_ptr references to it are gone
         ~worker();
     };
@@ -212,6 +262,32 @@ public:
     // For testing to allow file closing and deletion
     static void clear_workers();
 
+    // Wait until all output sent to all workers has been written
+    static void flush_workers();
+
+    /*************************************************************************
+     * Asynchronous logging. By default, flushing a rocblas_internal_ostream *
+     * blocks until the worker has written the data. In asynchronous mode,   *
+     * the data is placed on a bounded queue and written in batches, and the *
+     * caller only waits when the queue is full (or never, if messages are   *
+     * dropped when the queue is full). Settings are initialized from the    *
+     * ROCBLAS_LOG_ASYNC, ROCBLAS_LOG_ASYNC_QUEUE_SIZE and                   *
+     * ROCBLAS_LOG_ASYNC_POLICY environment variables, and apply to workers  *
+     * created after they are changed.                                       *
+     *************************************************************************/
+    struct async_config_t
+    {
+        bool   enabled  = false; // Whether flushing returns before the data is written
+        size_t capacity = 4096; // Maximum number of queued messages per file
+        bool   drop     = false; // Drop messages instead of waiting when the queue is full
+    };
+
+    // Get the current asynchronous logging settings
+    static async_config_t get_async_config();
+
+    // Set the asynchronous logging settings for workers created afterwards
+    static void set_async_config(const async_config_t& config);
+
     // Convert stream output to string
     std::string str() const
     {
@@ -225,6 +301,12 @@ public:
         os.str({});
     }
 
+    // Append unformatted bytes, which may contain embedded NULs
+    void write(const char* data, size_t size)
+    {
+        os.write(data, size);
+    }
+
     // Flush the output
     void flush();
 
@@ -446,6 +528,22 @@ public:
         return os;
     }
 
+    // host result mode output
+    friend rocblas_internal_ostream& operator<<(rocblas_internal_ostream& os,
+                                                rocblas_host_result_mode  mode)
+    {
+        os.os << rocblas_host_result_mode_to_string(mode);
+        return os;
+    }
+
+    // capture mode output
+    friend rocblas_internal_ostream& operator<<(rocblas_internal_ostream& os,
+                                                rocblas_capture_mode      mode)
+    {
+        os.os << rocblas_capture_mode_to_string(mode);
+        return os;
+    }
+
     // gemm flags output
     friend rocblas_internal_ostream& operator<<(rocblas_internal_ostream& os,
                                                 rocblas_gemm_flags        flags)
@@ -0,0 +1,215 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/*******************************************************************************
+ * rocblas_perf_counters counts the calls of each rocBLAS function, the bytes  *
+ * and floating point operations of their work, and a histogram of their       *
+ * host-side latencies, for rocblas_get_perf_counters. Each handle has one,    *
+ * and the process has one for all handles.                                    *
+ *                                                                             *
+ * Calls are recorded in one of a fixed number of shards, each thread always   *
+ * using the same one, so that threads recording at the same time rarely take  *
+ * the same lock. A snapshot merges the shards by function name.               *
+ *                                                                             *
+ * The latency is measured by the caller, so counting is tested without a GPU. *
+ ******************************************************************************/
+
+// Histogram bucket of a latency of ns nanoseconds, as documented by
+// rocblas_function_counters::latency_histogram
+inline size_t rocblas_perf_latency_bucket(uint64_t ns)
+{
+    size_t bucket = 0;
+    for(uint64_t us = ns / 1000; us && bucket < ROCBLAS_PERF_LATENCY_BUCKETS - 1; us >>= 1)
+        ++bucket;
+    return bucket;
+}
+
+class rocblas_perf_counters
+{
+public:
+    static constexpr size_t shards = 16;
+
+    rocblas_perf_counters()                             = default;
+    rocblas_perf_counters(const rocblas_perf_counters&) = delete;
+    rocblas_perf_counters& operator=(const rocblas_perf_counters&) = delete;
+
+    /*! \brief Counts a call of function, which must be a string with static storage, doing
+        bytes and flops of work, and taking ns nanoseconds on the host */
+    void record(const char* function, double bytes, double flops, uint64_t ns)
+    {
+        shard& s = m_shards[shard_index()];
+        double us = ns / 1000.0;
+
+        std::lock_guard<std::mutex> lock(s.mutex);
+        rocblas_function_counters&  c = s.counters[function];
+        c.function = function;
+        c.calls += 1;
+        c.bytes += bytes;
+        c.flops += flops;
+        c.latency_us_sum += us;
+        c.latency_us_max = std::max(c.latency_us_max, us);
+        c.latency_histogram[rocblas_perf_latency_bucket(ns)] += 1;
+    }
+
+    /*! \brief Counts of each function called since construction or the last reset, by name */
+    std::vector<rocblas_function_counters> snapshot() const
+    {
+        std::vector<rocblas_function_counters> merged;
+        for(auto& s : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            for(auto& p : s.counters)
+            {
+                auto it = std::find_if(merged.begin(), merged.end(), [&](auto& c) {
+                    return !strcmp(c.function, p.second.function);
+                });
+                if(it == merged.end())
+                    merged.push_back(p.second);
+                else
+                    merge(*it, p.second);
+            }
+        }
+        std::sort(merged.begin(), merged.end(), [](auto& a, auto& b) {
+            return strcmp(a.function, b.function) < 0;
+        });
+        return merged;
+    }
+
+    void reset()
+    {
+        for(auto& s : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.counters.clear();
+        }
+    }
+
+private:
+    // Function names are compared by address when recording, and by value when merging,
+    // since the same name may be defined in several translation units
+    struct shard
+    {
+        mutable std::mutex                                         mutex;
+        std::unordered_map<const char*, rocblas_function_counters> counters;
+    };
+
+    // The shard of the calling thread, chosen round robin when it first records
+    static size_t shard_index()
+    {
+        static std::atomic<size_t> next{0};
+        thread_local size_t        index = next.fetch_add(1, std::memory_order_relaxed) % shards;
+        return index;
+    }
+
+    static void merge(rocblas_function_counters& to, const rocblas_function_counters& from)
+    {
+        to.calls += from.calls;
+        to.bytes += from.bytes;
+        to.flops += from.flops;
+        to.latency_us_sum += from.latency_us_sum;
+        to.latency_us_max = std::max(to.latency_us_max, from.latency_us_max);
+        for(size_t b = 0; b < ROCBLAS_PERF_LATENCY_BUCKETS; ++b)
+            to.latency_histogram[b] += from.latency_histogram[b];
+    }
+
+    shard m_shards[shards];
+};
+
+/*******************************************************************************
+ * Work of the counted functions: the bytes of the operands read and written   *
+ * in device memory, and the floating point operations as rocblas-bench        *
+ * counts them. Invalid sizes count as 0.                                      *
+ ******************************************************************************/
+struct rocblas_perf_work
+{
+    double bytes;
+    double flops;
+};
+
+inline double rocblas_perf_size(int64_t size)
+{
+    return size > 0 ? double(size) : 0.0;
+}
+
+inline bool rocblas_perf_is_complex(rocblas_datatype type)
+{
+    switch(type)
+    {
+    case rocblas_datatype_f16_c:
+    case rocblas_datatype_f32_c:
+    case rocblas_datatype_f64_c:
+    case rocblas_datatype_i8_c:
+    case rocblas_datatype_u8_c:
+    case rocblas_datatype_i32_c:
+    case rocblas_datatype_u32_c:
+    case rocblas_datatype_bf16_c:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// gemm and gemm_ex, with A and B of ab_size bytes per element, C of c_size and D of d_size
+inline rocblas_perf_work rocblas_perf_gemm_work(int64_t m,
+                                                int64_t n,
+                                                int64_t k,
+                                                int64_t batch_count,
+                                                size_t  ab_size,
+                                                size_t  c_size,
+                                                size_t  d_size,
+                                                bool    complex)
+{
+    double M = rocblas_perf_size(m), N = rocblas_perf_size(n), K = rocblas_perf_size(k);
+    double batches = rocblas_perf_size(batch_count);
+    return {batches * (ab_size * (M * K + K * N) + (c_size + d_size) * M * N),
+            batches * (complex ? 8.0 : 2.0) * M * N * K};
+}
+
+inline rocblas_perf_work rocblas_perf_gemv_work(rocblas_operation trans,
+                                                int64_t           m,
+                                                int64_t           n,
+                                                int64_t           batch_count,
+                                                size_t            size,
+                                                bool              complex)
+{
+    bool   none = trans == rocblas_operation_none;
+    double M = rocblas_perf_size(m), N = rocblas_perf_size(n);
+    double batches = rocblas_perf_size(batch_count);
+    double len_x = none ? N : M, len_y = none ? M : N;
+    return {batches * size * (M * N + len_x + 2 * len_y),
+            batches * (complex ? 8 * M * N + 6 * len_y : 2 * M * N + 2 * len_y)};
+}
+
+inline rocblas_perf_work
+    rocblas_perf_axpy_work(int64_t n, int64_t batch_count, size_t size, bool complex)
+{
+    double elements = rocblas_perf_size(n) * rocblas_perf_size(batch_count);
+    return {size * 3.0 * elements, (complex ? 8.0 : 2.0) * elements};
+}
+
+inline rocblas_perf_work
+    rocblas_perf_dot_work(int64_t n, int64_t batch_count, size_t size, bool complex, bool conj)
+{
+    double elements = rocblas_perf_size(n) * rocblas_perf_size(batch_count);
+    return {size * 2.0 * elements, (complex ? (conj ? 9.0 : 8.0) : 2.0) * elements};
+}
+
+// scal of x of size bytes per element, by a complex alpha if complex_alpha is set
+inline rocblas_perf_work rocblas_perf_scal_work(
+    int64_t n, int64_t batch_count, size_t size, bool complex, bool complex_alpha)
+{
+    double elements = rocblas_perf_size(n) * rocblas_perf_size(batch_count);
+    return {size * 2.0 * elements, (complex ? (complex_alpha ? 6.0 : 2.0) : 1.0) * elements};
+}
@@ -0,0 +1,295 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+/*******************************************************************************
+ * rocblas_sym_block_plan decomposes a large SYRK, HERK, SYR2K, HER2K, SYMM or *
+ * HEMM into diagonal blocks, computed by the routine's own kernels, and GEMMs *
+ * on the off-diagonal panels, which are computed by Tensile.                  *
+ *                                                                             *
+ * The n x n triangle is split recursively: [T11; P T22], where T11 is the     *
+ * first n1 rows and columns, n1 being half of n rounded up to a multiple of   *
+ * nb, and P is the panel between T11 and T22 in the stored triangle. The      *
+ * recursion stops at triangles of at most nb, which become diagonal blocks,   *
+ * so the GEMMs are as large as possible and all diagonal blocks but the last  *
+ * are nb x nb.                                                                *
+ *                                                                             *
+ * For the rank-k updates, a panel of C at rows r and columns c is             *
+ *   alpha * op(A)_r * op(B)_c^T [+ alpha' * op(B)_r * op(A)_c^T] + beta * C   *
+ * where ^T is ^H and alpha' is conj(alpha) for the Hermitian routines, and    *
+ * B is A for SYRK and HERK. For SYMM and HEMM, a panel P of the stored        *
+ * triangle of A adds P and P^T (P^H) times blocks of B to blocks of C, after  *
+ * the diagonal blocks have applied beta to all of C.                          *
+ *                                                                             *
+ * Offsets are in elements, relative to the offsets of the routine's matrices. *
+ * The plan is computed on the host only, so it is tested without a GPU.       *
+ ******************************************************************************/
+
+// Crossover of the blocked path: it is used for n >= min_n, with diagonal
+// blocks of nb. nb <= 0 disables it.
+struct rocblas_sym_blocked_params
+{
+    rocblas_int nb;
+    rocblas_int min_n;
+};
+
+// Initial crossovers by architecture, as returned by _rocblas_handle::getArch().
+// ROCBLAS_SYM_BLOCKED_NB and ROCBLAS_SYM_BLOCKED_MIN_N override them.
+inline rocblas_sym_blocked_params rocblas_sym_blocked_arch_params(int arch)
+{
+    switch(arch)
+    {
+    case 906:
+        return {256, 1536};
+    case 908:
+        return {256, 1024};
+    case 910:
+        return {512, 1024};
+    default:
+        return {256, 2048};
+    }
+}
+
+inline bool rocblas_sym_blocked_use(const rocblas_sym_blocked_params& params, rocblas_int n)
+{
+    return params.nb > 0 && n > params.nb && n >= params.min_n;
+}
+
+// Whether the offsets of a blocked call fit in rocblas_int. The plan's offsets into each
+// matrix, added to the routine's offset of it, are at most (order - 1) * (ld + 1) past it,
+// where order is n for the rank-k updates, and the order of A for SYMM and HEMM. Larger
+// calls use the unblocked kernels, which compute their offsets in 64 bits.
+inline bool rocblas_sym_blocked_offsets_fit(rocblas_int order,
+                                            rocblas_int offset_a,
+                                            rocblas_int lda,
+                                            rocblas_int offset_b,
+                                            rocblas_int ldb,
+                                            rocblas_int offset_c,
+                                            rocblas_int ldc)
+{
+    auto fits = [=](rocblas_int offset, rocblas_int ld) {
+        return offset + (order - 1) * (int64_t(ld) + 1) <= INT_MAX;
+    };
+    return fits(offset_a, lda) && fits(offset_b, ldb) && fits(offset_c, ldc);
+}
+
+// A block of the stored triangle at row and col, of rows x cols
+struct rocblas_sym_block
+{
+    rocblas_int row;
+    rocblas_int col;
+    rocblas_int rows;
+    rocblas_int cols;
+};
+
+// A call of the routine's kernels on a diagonal block, of m x n for SYMM and
+// HEMM, or of n x n for the rank-k updates, in which case m == n
+struct rocblas_sym_diag_call
+{
+    rocblas_int m;
+    rocblas_int n;
+    rocblas_int offset_a;
+    rocblas_int offset_b;
+    rocblas_int offset_c;
+};
+
+// Which of the routine's matrices a GEMM operand is
+enum class rocblas_sym_operand
+{
+    A,
+    B
+};
+
+// A GEMM on a panel. It multiplies by conj(alpha) if conj_alpha is set, and by
+// beta == 1 if accumulate is set.
+struct rocblas_sym_gemm_call
+{
+    rocblas_operation   trans_a;
+    rocblas_operation   trans_b;
+    rocblas_int         m;
+    rocblas_int         n;
+    rocblas_int         k;
+    rocblas_sym_operand first;
+    rocblas_int         offset_first;
+    rocblas_sym_operand second;
+    rocblas_int         offset_second;
+    rocblas_int         offset_c;
+    bool                conj_alpha;
+    bool                accumulate;
+};
+
+class rocblas_sym_block_plan
+{
+public:
+    /*! \brief Diagonal blocks and panels of the uplo triangle of an n x n matrix */
+    static void blocks(rocblas_fill                    uplo,
+                       rocblas_int                     n,
+                       rocblas_int                     nb,
+                       std::vector<rocblas_sym_block>& diagonal,
+                       std::vector<rocblas_sym_block>& panels)
+    {
+        split(uplo, 0, n, nb, diagonal, panels);
+    }
+
+    /*! \brief Plan of SYRK and HERK (with B == A, twok false), SYR2K and HER2K (twok
+        true), or of SYRKX and HERKX (twok false) */
+    static rocblas_sym_block_plan rank_k(rocblas_fill      uplo,
+                                         rocblas_operation trans,
+                                         rocblas_int       n,
+                                         rocblas_int       k,
+                                         rocblas_int       lda,
+                                         rocblas_int       ldb,
+                                         rocblas_int       ldc,
+                                         rocblas_int       nb,
+                                         bool              herm,
+                                         bool              twok)
+    {
+        rocblas_sym_block_plan         plan;
+        std::vector<rocblas_sym_block> diagonal, panels;
+        blocks(uplo, n, nb, diagonal, panels);
+
+        // Stride between rows of op(A) and op(B)
+        bool        none = trans == rocblas_operation_none;
+        rocblas_int a_s1 = none ? 1 : lda;
+        rocblas_int b_s1 = none ? 1 : ldb;
+
+        for(auto& d : diagonal)
+            plan.m_diagonal.push_back(
+                {d.rows, d.rows, d.row * a_s1, d.row * b_s1, d.row + d.row * ldc});
+
+        rocblas_operation op      = herm ? rocblas_operation_conjugate_transpose
+                                         : rocblas_operation_transpose;
+        rocblas_operation trans_a = none ? rocblas_operation_none : op;
+        rocblas_operation trans_b = none ? op : rocblas_operation_none;
+        for(auto& p : panels)
+        {
+            rocblas_int offset_c = p.row + p.col * ldc;
+            plan.m_gemms.push_back({trans_a,
+                                    trans_b,
+                                    p.rows,
+                                    p.cols,
+                                    k,
+                                    rocblas_sym_operand::A,
+                                    p.row * a_s1,
+                                    rocblas_sym_operand::B,
+                                    p.col * b_s1,
+                                    offset_c,
+                                    false,
+                                    false});
+            if(twok)
+                plan.m_gemms.push_back({trans_a,
+                                        trans_b,
+                                        p.rows,
+                                        p.cols,
+                                        k,
+                                        rocblas_sym_operand::B,
+                                        p.row * b_s1,
+                                        rocblas_sym_operand::A,
+                                        p.col * a_s1,
+                                        offset_c,
+                                        herm,
+                                        true});
+        }
+        return plan;
+    }
+
+    /*! \brief Plan of SYMM (herm false) or HEMM (herm true) of an m x n C */
+    static rocblas_sym_block_plan symm(rocblas_side side,
+                                       rocblas_fill uplo,
+                                       rocblas_int  m,
+                                       rocblas_int  n,
+                                       rocblas_int  lda,
+                                       rocblas_int  ldb,
+                                       rocblas_int  ldc,
+                                       rocblas_int  nb,
+                                       bool         herm)
+    {
+        rocblas_sym_block_plan         plan;
+        std::vector<rocblas_sym_block> diagonal, panels;
+        bool                           left = side == rocblas_side_left;
+        blocks(uplo, left ? m : n, nb, diagonal, panels);
+
+        // Diagonal blocks of A multiply block rows (left) or columns (right) of B
+        for(auto& d : diagonal)
+        {
+            rocblas_int i = d.row;
+            if(left)
+                plan.m_diagonal.push_back({d.rows, n, i + i * lda, i, i});
+            else
+                plan.m_diagonal.push_back({m, d.rows, i + i * lda, i * ldb, i * ldc});
+        }
+
+        constexpr auto    N  = rocblas_operation_none;
+        rocblas_operation op = herm ? rocblas_operation_conjugate_transpose
+                                    : rocblas_operation_transpose;
+        constexpr auto    A  = rocblas_sym_operand::A;
+        constexpr auto    B  = rocblas_sym_operand::B;
+        for(auto& p : panels)
+        {
+            rocblas_int r = p.row, c = p.col, offset_p = r + c * lda;
+            if(left)
+            {
+                // C_r += alpha * P * B_c and C_c += alpha * P^T * B_r
+                plan.m_gemms.push_back(
+                    {N, N, p.rows, n, p.cols, A, offset_p, B, c, r, false, true});
+                plan.m_gemms.push_back(
+                    {op, N, p.cols, n, p.rows, A, offset_p, B, r, c, false, true});
+            }
+            else
+            {
+                // C_c += alpha * B_r * P and C_r += alpha * B_c * P^T
+                plan.m_gemms.push_back(
+                    {N, N, m, p.cols, p.rows, B, r * ldb, A, offset_p, c * ldc, false, true});
+                plan.m_gemms.push_back(
+                    {N, op, m, p.rows, p.cols, B, c * ldb, A, offset_p, r * ldc, false, true});
+            }
+        }
+        return plan;
+    }
+
+    /*! \brief Kernel calls on the diagonal blocks, which come before the GEMMs */
+    const std::vector<rocblas_sym_diag_call>& diagonal() const
+    {
+        return m_diagonal;
+    }
+
+    const std::vector<rocblas_sym_gemm_call>& gemms() const
+    {
+        return m_gemms;
+    }
+
+private:
+    static void split(rocblas_fill                    uplo,
+                      rocblas_int                     offset,
+                      rocblas_int                     n,
+                      rocblas_int                     nb,
+                      std::vector<rocblas_sym_block>& diagonal,
+                      std::vector<rocblas_sym_block>& panels)
+    {
+        if(n <= nb)
+        {
+            diagonal.push_back({offset, offset, n, n});
+            return;
+        }
+
+        // n1 is a multiple of nb, and less than n since n > nb
+        rocblas_int n1 = (n / 2 + nb - 1) / nb * nb;
+        rocblas_int n2 = n - n1;
+        split(uplo, offset, n1, nb, diagonal, panels);
+        if(uplo == rocblas_fill_lower)
+            panels.push_back({offset + n1, offset, n2, n1});
+        else
+            panels.push_back({offset, offset + n1, n1, n2});
+        split(uplo, offset + n1, n2, nb, diagonal, panels);
+    }
+
+    std::vector<rocblas_sym_diag_call> m_diagonal;
+    std::vector<rocblas_sym_gemm_call> m_gemms;
+};
@@ -0,0 +1,126 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <cstddef>
+#include <utility>
+
+/******************************************************************************
+ * rocblas_sync_interceptor sits between a handle and the HIP calls which     *
+ * synchronize with the host or allocate memory: blocking copies, stream and  *
+ * event synchronizations, and device and pinned host allocations and frees.  *
+ * It counts each call by kind. In capture-safe mode it refuses them instead, *
+ * counting the refusal and returning rocblas_status_capture_unsafe without   *
+ * calling the Backend.                                                       *
+ *                                                                            *
+ * The Backend makes the calls:                                               *
+ *   rocblas_status copy(void* dst, const void* src, size_t, copy_kind_t)     *
+ *   rocblas_status stream_synchronize(stream_t stream)                       *
+ *   rocblas_status event_synchronize(event_t event)                          *
+ *   rocblas_status device_allocate(void** ptr, size_t size)                  *
+ *   rocblas_status device_free(void* ptr)                                    *
+ *   rocblas_status host_allocate(void** ptr, size_t size)                    *
+ *   rocblas_status host_free(void* ptr)                                      *
+ * A host backend allows counting the sync points of a call without a GPU.    *
+ ******************************************************************************/
+template <typename Backend>
+class rocblas_sync_interceptor
+{
+public:
+    using stream_t    = typename Backend::stream_t;
+    using event_t     = typename Backend::event_t;
+    using copy_kind_t = typename Backend::copy_kind_t;
+
+    explicit rocblas_sync_interceptor(Backend backend = Backend())
+        : m_backend(std::move(backend))
+    {
+    }
+
+    rocblas_sync_interceptor(const rocblas_sync_interceptor&) = delete;
+    rocblas_sync_interceptor& operator=(const rocblas_sync_interceptor&) = delete;
+
+    /*! \brief Refuse synchronizations and allocations if safe is true */
+    void set_capture_safe(bool safe)
+    {
+        m_capture_safe = safe;
+    }
+
+    bool capture_safe() const
+    {
+        return m_capture_safe;
+    }
+
+    /*! \brief Counts since construction or the last reset */
+    const rocblas_sync_point_counts& counts() const
+    {
+        return m_counts;
+    }
+
+    void reset_counts()
+    {
+        m_counts = {};
+    }
+
+    /*! \brief Returns rocblas_status_capture_unsafe, counting a refusal, in capture-safe
+        mode, for a sync point which is not made through the interceptor */
+    rocblas_status check()
+    {
+        if(!m_capture_safe)
+            return rocblas_status_success;
+        ++m_counts.refused;
+        return rocblas_status_capture_unsafe;
+    }
+
+    rocblas_status copy(void* dst, const void* src, size_t size, copy_kind_t kind)
+    {
+        return call(m_counts.copies, [&] { return m_backend.copy(dst, src, size, kind); });
+    }
+
+    rocblas_status stream_synchronize(stream_t stream)
+    {
+        return call(m_counts.stream_syncs, [&] { return m_backend.stream_synchronize(stream); });
+    }
+
+    rocblas_status event_synchronize(event_t event)
+    {
+        return call(m_counts.event_syncs, [&] { return m_backend.event_synchronize(event); });
+    }
+
+    rocblas_status device_allocate(void** ptr, size_t size)
+    {
+        return call(m_counts.allocations, [&] { return m_backend.device_allocate(ptr, size); });
+    }
+
+    rocblas_status device_free(void* ptr)
+    {
+        return call(m_counts.frees, [&] { return m_backend.device_free(ptr); });
+    }
+
+    rocblas_status host_allocate(void** ptr, size_t size)
+    {
+        return call(m_counts.allocations, [&] { return m_backend.host_allocate(ptr, size); });
+    }
+
+    rocblas_status host_free(void* ptr)
+    {
+        return call(m_counts.frees, [&] { return m_backend.host_free(ptr); });
+    }
+
+private:
+    template <typename F>
+    rocblas_status call(size_t& count, F&& f)
+    {
+        rocblas_status status = check();
+        if(status != rocblas_status_success)
+            return status;
+        ++count;
+        return f();
+    }
+
+    Backend                   m_backend;
+    bool                      m_capture_safe = false;
+    rocblas_sync_point_counts m_counts       = {};
+};
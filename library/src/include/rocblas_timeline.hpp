@@ -0,0 +1,336 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/*******************************************************************************
+ * The timeline of rocblas_layer_mode_log_timeline records each call of a      *
+ * rocBLAS function, entered and exited by the rocblas_perf_scope every        *
+ * function declares, with its host entry and exit times and, if GPU timing is *
+ * on, the time the GPU took between two events recorded on the stream before  *
+ * and after the call's work.                                                  *
+ *                                                                             *
+ * rocblas_timeline_recorder takes the event pairs from a pool, and returns a  *
+ * pair to it once its stop event has completed, which it checks without       *
+ * waiting at the end of each later call. The host waits for the GPU only on   *
+ * flush. A call finding all max_pairs pairs in flight is recorded without a   *
+ * GPU time.                                                                   *
+ *                                                                             *
+ * rocblas_timeline_writer serializes calls in the Chrome trace event JSON     *
+ * array format, which chrome://tracing and the Perfetto UI open: a complete   *
+ * event for the host call on the track of its thread, and one for its GPU     *
+ * time on the track of its stream. Since events measure durations only, a GPU *
+ * event starts at the later of its call's entry and the end of the previous   *
+ * GPU event on the stream. The array is left open, as both viewers accept.    *
+ *                                                                             *
+ * The Backend records events and reads the clock:                             *
+ *   bool     create(event_t& event)                                           *
+ *   void     destroy(event_t event)                                           *
+ *   bool     record(event_t event, stream_t stream)                           *
+ *   int      query(event_t event), 1 if complete, 0 if not, -1 on an error    *
+ *   bool     elapsed_us(event_t start, event_t stop, double& us)              *
+ *   void     synchronize(event_t event)                                       *
+ *   uint64_t now_ns()                                                         *
+ * so that recording and serialization are tested with a host-only clock.      *
+ ******************************************************************************/
+
+// A call on the timeline. gpu_us is negative if the call was not timed on the GPU.
+struct rocblas_timeline_call
+{
+    const char* function;
+    uint64_t    thread;
+    const void* stream;
+    uint64_t    begin_ns;
+    uint64_t    end_ns;
+    double      gpu_us;
+};
+
+// Number of the calling thread on timelines, from 1 in the order threads first record
+inline uint64_t rocblas_timeline_thread()
+{
+    static std::atomic<uint64_t> next{1};
+    thread_local uint64_t        thread = next.fetch_add(1, std::memory_order_relaxed);
+    return thread;
+}
+
+class rocblas_timeline_writer
+{
+public:
+    // Tracks of GPU streams are numbered from stream_tracks, after those of threads
+    static constexpr uint64_t stream_tracks = uint64_t(1) << 32;
+
+    rocblas_timeline_writer(std::function<void(const std::string&)> sink, uint64_t pid)
+        : m_sink(std::move(sink))
+        , m_pid(pid)
+    {
+    }
+
+    /*! \brief Writes the events of call, preceded by the names of new tracks and, for the
+        first call, by the opening of the array */
+    void write(const rocblas_timeline_call& call)
+    {
+        std::string                 out;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_started)
+        {
+            out += "[\n";
+            m_started = true;
+        }
+
+        if(m_threads.insert(call.thread).second)
+            append_track_name(out, call.thread, "rocBLAS thread " + std::to_string(call.thread));
+
+        double begin_us = call.begin_ns / 1000.0;
+        double host_us  = call.end_ns > call.begin_ns ? (call.end_ns - call.begin_ns) / 1000.0 : 0;
+        append_event(out, call.function, "host", call.thread, begin_us, host_us, call.gpu_us);
+
+        if(call.gpu_us >= 0)
+        {
+            auto it = m_streams.find(call.stream);
+            if(it == m_streams.end())
+            {
+                uint64_t track = stream_tracks + m_streams.size();
+                it             = m_streams.emplace(call.stream, stream_track{track, 0}).first;
+                char name[64];
+                snprintf(name, sizeof(name), "GPU stream %p", call.stream);
+                append_track_name(out, track, name);
+            }
+            double gpu_begin_us = std::max(begin_us, it->second.end_us);
+            append_event(
+                out, call.function, "gpu", it->second.track, gpu_begin_us, call.gpu_us, -1);
+            it->second.end_us = gpu_begin_us + call.gpu_us;
+        }
+        m_sink(out);
+    }
+
+private:
+    struct stream_track
+    {
+        uint64_t track;
+        double   end_us;
+    };
+
+    void append_track_name(std::string& out, uint64_t track, const std::string& name) const
+    {
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + std::to_string(m_pid)
+               + ",\"tid\":" + std::to_string(track) + ",\"args\":{\"name\":\"" + name
+               + "\"}},\n";
+    }
+
+    // A complete event, with the GPU time of a host event as an argument if it is not negative
+    void append_event(std::string& out,
+                      const char*  name,
+                      const char*  category,
+                      uint64_t     track,
+                      double       ts_us,
+                      double       dur_us,
+                      double       gpu_us) const
+    {
+        char times[96];
+        snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f", ts_us, dur_us);
+        out += "{\"name\":\"" + std::string(name) + "\",\"cat\":\"" + category
+               + "\",\"ph\":\"X\",\"pid\":" + std::to_string(m_pid)
+               + ",\"tid\":" + std::to_string(track) + "," + times;
+        if(gpu_us >= 0)
+        {
+            snprintf(times, sizeof(times), ",\"args\":{\"gpu_us\":%.3f}", gpu_us);
+            out += times;
+        }
+        out += "},\n";
+    }
+
+    std::function<void(const std::string&)>       m_sink;
+    uint64_t                                      m_pid;
+    std::mutex                                    m_mutex;
+    bool                                          m_started = false;
+    std::unordered_set<uint64_t>                  m_threads;
+    std::unordered_map<const void*, stream_track> m_streams;
+};
+
+template <typename Backend>
+class rocblas_timeline_recorder
+{
+public:
+    using event_t  = typename Backend::event_t;
+    using stream_t = typename Backend::stream_t;
+
+    // A call between begin and end, with the index of its event pair, or -1
+    struct token
+    {
+        const char* function = nullptr;
+        stream_t    stream   = {};
+        uint64_t    begin_ns = 0;
+        int         pair     = -1;
+    };
+
+    /*! \brief Records calls into sink, timing them on the GPU if gpu is set, with at most
+        max_pairs event pairs */
+    rocblas_timeline_recorder(Backend                                          backend,
+                              std::function<void(const rocblas_timeline_call&)> sink,
+                              bool                                             gpu,
+                              size_t                                           max_pairs = 1024)
+        : m_backend(std::move(backend))
+        , m_sink(std::move(sink))
+        , m_gpu(gpu)
+        , m_max_pairs(max_pairs)
+    {
+    }
+
+    rocblas_timeline_recorder(const rocblas_timeline_recorder&) = delete;
+    rocblas_timeline_recorder& operator=(const rocblas_timeline_recorder&) = delete;
+
+    ~rocblas_timeline_recorder()
+    {
+        flush();
+        for(auto& pair : m_pairs)
+        {
+            m_backend.destroy(pair.start);
+            m_backend.destroy(pair.stop);
+        }
+    }
+
+    /*! \brief Starts a call of function on stream, timing it on the GPU if gpu is set and a
+        pair of events is available */
+    token begin(const char* function, stream_t stream, bool gpu = true)
+    {
+        token t;
+        t.function = function;
+        t.stream   = stream;
+        if(m_gpu && gpu)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            t.pair = acquire();
+            if(t.pair >= 0 && !m_backend.record(m_pairs[t.pair].start, stream))
+                release(std::exchange(t.pair, -1));
+        }
+        t.begin_ns = m_backend.now_ns();
+        return t;
+    }
+
+    /*! \brief Ends the call of t, and writes the calls which have completed on the GPU */
+    void end(const token& t)
+    {
+        uint64_t                    end_ns = m_backend.now_ns();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        int                         pair = t.pair;
+        if(pair >= 0 && !m_backend.record(m_pairs[pair].stop, t.stream))
+            release(std::exchange(pair, -1));
+        m_pending.push_back(
+            {{t.function, rocblas_timeline_thread(), t.stream, t.begin_ns, end_ns, -1.0}, pair});
+        retire(false);
+    }
+
+    /*! \brief Waits for the GPU to complete the pending calls, and writes them */
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        retire(true);
+    }
+
+    /*! \brief Numbers of event pairs created, and not in flight */
+    size_t pairs() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pairs.size();
+    }
+
+    size_t free_pairs() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_free.size();
+    }
+
+private:
+    struct event_pair
+    {
+        event_t start;
+        event_t stop;
+    };
+
+    struct pending_call
+    {
+        rocblas_timeline_call call;
+        int                   pair;
+    };
+
+    // A free pair, creating one if there are fewer than m_max_pairs, or -1. When all pairs
+    // are in flight, the completed calls are written first to free theirs.
+    int acquire()
+    {
+        if(m_free.empty() && m_pairs.size() >= m_max_pairs)
+            retire(false);
+        if(!m_free.empty())
+        {
+            int pair = m_free.back();
+            m_free.pop_back();
+            return pair;
+        }
+        if(m_pairs.size() >= m_max_pairs)
+            return -1;
+        event_pair pair;
+        if(!m_backend.create(pair.start))
+            return -1;
+        if(!m_backend.create(pair.stop))
+        {
+            m_backend.destroy(pair.start);
+            return -1;
+        }
+        m_pairs.push_back(pair);
+        return int(m_pairs.size() - 1);
+    }
+
+    void release(int pair)
+    {
+        m_free.push_back(pair);
+    }
+
+    // Writes the pending calls in order, up to the first whose stop event has not completed,
+    // or all of them, after waiting for their events, if wait is set. The calls of a stream
+    // complete in order, so a call waits behind another only if they are on different streams.
+    void retire(bool wait)
+    {
+        while(!m_pending.empty())
+        {
+            pending_call& p = m_pending.front();
+            if(p.pair >= 0)
+            {
+                event_pair& pair = m_pairs[p.pair];
+                if(wait)
+                    m_backend.synchronize(pair.stop);
+                int state = m_backend.query(pair.stop);
+                if(state == 0 && !wait)
+                    return;
+                double us;
+                if(state > 0 && m_backend.elapsed_us(pair.start, pair.stop, us))
+                    p.call.gpu_us = us;
+                release(p.pair);
+            }
+            m_sink(p.call);
+            m_pending.pop_front();
+        }
+    }
+
+    Backend                                           m_backend;
+    std::function<void(const rocblas_timeline_call&)> m_sink;
+    bool                                              m_gpu;
+    size_t                                            m_max_pairs;
+    mutable std::mutex                                m_mutex;
+    std::vector<event_pair>                           m_pairs;
+    std::vector<int>                                  m_free;
+    std::deque<pending_call>                          m_pending;
+};
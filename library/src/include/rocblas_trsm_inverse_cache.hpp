@@ -0,0 +1,223 @@
+/* ************************************************************************
+ * Copyright 2021 Advanced Micro Devices, Inc.
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <cstddef>
+#include <list>
+#include <utility>
+
+/******************************************************************************
+ * rocblas_trsm_inverse_cache keeps the inverted diagonal blocks (invA) which *
+ * TRSM computes with TRTRI, so that repeated solves with the same triangular *
+ * factor skip the inversion. Entries are keyed by A's pointer, offset,       *
+ * leading dimension, stride, order, batch count, fill, diagonal and type,    *
+ * and by a generation number which the caller changes when the contents of  *
+ * A change. The cache cannot see A's contents, so an entry is only valid as  *
+ * long as its A, at its generation, is unchanged.                            *
+ *                                                                            *
+ * For batched calls, A is the address of the array of pointers to the        *
+ * matrices, so an entry is also stale once the array holds other pointers.   *
+ * Batched calls therefore use the cache only when set_batched(true) opts in. *
+ *                                                                            *
+ * The entries together use at most a budget of bytes; the least recently    *
+ * used entries are evicted to make room. A budget of 0 disables the cache.   *
+ * There are few entries, since each holds a BLOCK x k inverse per batch, so  *
+ * they are searched linearly in order of use.                                *
+ *                                                                            *
+ * The Backend provides the memory:                                           *
+ *   void* allocate(size_t size)              nullptr on failure              *
+ *   void  deallocate(void* ptr)                                              *
+ ******************************************************************************/
+
+struct rocblas_trsm_inverse_key
+{
+    const void*      A;
+    rocblas_int      offset_A;
+    rocblas_int      lda;
+    rocblas_stride   stride_A;
+    rocblas_int      k;
+    rocblas_int      block;
+    rocblas_int      batch_count;
+    rocblas_fill     uplo;
+    rocblas_diagonal diag;
+    rocblas_datatype type;
+    bool             batched;
+    size_t           generation;
+
+    bool operator==(const rocblas_trsm_inverse_key& rhs) const
+    {
+        return A == rhs.A && offset_A == rhs.offset_A && lda == rhs.lda
+               && stride_A == rhs.stride_A && k == rhs.k && block == rhs.block
+               && batch_count == rhs.batch_count && uplo == rhs.uplo && diag == rhs.diag
+               && type == rhs.type && batched == rhs.batched && generation == rhs.generation;
+    }
+};
+
+template <typename Backend>
+class rocblas_trsm_inverse_cache
+{
+public:
+    explicit rocblas_trsm_inverse_cache(Backend backend = Backend())
+        : m_backend(std::move(backend))
+    {
+    }
+
+    rocblas_trsm_inverse_cache(const rocblas_trsm_inverse_cache&) = delete;
+    rocblas_trsm_inverse_cache& operator=(const rocblas_trsm_inverse_cache&) = delete;
+
+    ~rocblas_trsm_inverse_cache()
+    {
+        clear();
+    }
+
+    /*! \brief Sets the most bytes the entries may use, evicting entries to fit */
+    void set_budget(size_t budget)
+    {
+        m_budget = budget;
+        evict_to(budget);
+    }
+
+    size_t budget() const
+    {
+        return m_budget;
+    }
+
+    bool enabled() const
+    {
+        return m_budget != 0;
+    }
+
+    /*! \brief Generation of A which keys new lookups */
+    void set_generation(size_t generation)
+    {
+        m_generation = generation;
+    }
+
+    size_t generation() const
+    {
+        return m_generation;
+    }
+
+    /*! \brief Whether batched calls, keyed by their array of pointers, use the cache */
+    void set_batched(bool batched)
+    {
+        m_batched = batched;
+    }
+
+    bool batched() const
+    {
+        return m_batched;
+    }
+
+    /*! \brief Whether calls, batched if batched, use the cache */
+    bool enabled(bool batched) const
+    {
+        return enabled() && (!batched || m_batched);
+    }
+
+    /*! \brief Returns the entry for key, whose generation is replaced by the current one,
+        counting a hit, or nullptr, counting a miss */
+    void* find(rocblas_trsm_inverse_key key)
+    {
+        if(!enabled())
+            return nullptr;
+        key.generation = m_generation;
+        for(auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if(it->key == key)
+            {
+                m_entries.splice(m_entries.begin(), m_entries, it);
+                ++m_stats.hits;
+                return it->ptr;
+            }
+        }
+        ++m_stats.misses;
+        return nullptr;
+    }
+
+    /*! \brief Allocates an entry of size bytes for key, for the caller to fill, evicting the
+        least recently used entries to make room. Returns nullptr if size is larger than the
+        budget or cannot be allocated. */
+    void* insert(rocblas_trsm_inverse_key key, size_t size)
+    {
+        if(!size || size > m_budget)
+            return nullptr;
+        key.generation = m_generation;
+        evict_to(m_budget - size);
+        void* ptr = m_backend.allocate(size);
+        if(!ptr)
+            return nullptr;
+        m_entries.push_front({key, ptr, size});
+        m_bytes += size;
+        return ptr;
+    }
+
+    /*! \brief Frees the entry at ptr, whose contents the caller could not compute */
+    void erase(void* ptr)
+    {
+        for(auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if(it->ptr == ptr)
+            {
+                m_bytes -= it->size;
+                m_backend.deallocate(it->ptr);
+                m_entries.erase(it);
+                return;
+            }
+        }
+    }
+
+    /*! \brief Frees all entries */
+    void clear()
+    {
+        for(auto& e : m_entries)
+            m_backend.deallocate(e.ptr);
+        m_entries.clear();
+        m_bytes = 0;
+    }
+
+    rocblas_trsm_inverse_cache_stats get_stats() const
+    {
+        rocblas_trsm_inverse_cache_stats stats = m_stats;
+        stats.entries                          = m_entries.size();
+        stats.bytes                            = m_bytes;
+        return stats;
+    }
+
+    void reset_stats()
+    {
+        m_stats = {};
+    }
+
+private:
+    struct entry_t
+    {
+        rocblas_trsm_inverse_key key;
+        void*                    ptr;
+        size_t                   size;
+    };
+
+    // Evict the least recently used entries until at most bytes are used
+    void evict_to(size_t bytes)
+    {
+        while(m_bytes > bytes)
+        {
+            entry_t& e = m_entries.back();
+            m_bytes -= e.size;
+            m_backend.deallocate(e.ptr);
+            m_entries.pop_back();
+            ++m_stats.evictions;
+        }
+    }
+
+    Backend                          m_backend;
+    std::list<entry_t>               m_entries; // Most recently used first
+    size_t                           m_budget     = 0;
+    size_t                           m_bytes      = 0;
+    size_t                           m_generation = 0;
+    bool                             m_batched    = false;
+    rocblas_trsm_inverse_cache_stats m_stats      = {};
+};
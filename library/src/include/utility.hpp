@@ -291,6 +291,18 @@ constexpr const char* rocblas_atomics_mode_to_string(rocblas_atomics_mode mode)
     return mode != rocblas_atomics_not_allowed ? "atomics_allowed" : "atomics_not_allowed";
 }
 
+// Convert host result mode to string
+constexpr const char* rocblas_host_result_mode_to_string(rocblas_host_result_mode mode)
+{
+    return mode == rocblas_host_result_deferred ? "host_result_deferred" : "host_result_blocking";
+}
+
+// Convert capture mode to string
+constexpr const char* rocblas_capture_mode_to_string(rocblas_capture_mode mode)
+{
+    return mode == rocblas_capture_safe ? "capture_safe" : "capture_default";
+}
+
 // Convert gemm flags to string
 constexpr const char* rocblas_gemm_flags_to_string(rocblas_gemm_flags)
 {
@@ -383,6 +395,10 @@ typedef struct rocblas_check_numerics_s
 
     // Set to true if there is an Infinity in the vector/matrix
     bool has_Inf = false;
+
+    // In rocblas_check_numerics_mode_deferred, UINT32_MAX minus the sequence number of the
+    // first check which found a NaN or an Infinity, or 0 if there is none
+    uint32_t first_abnormal = 0;
 } rocblas_check_numerics_t;
 
 /*******************************************************************************
@@ -564,6 +580,9 @@ constexpr double value_category(const T& beta)
     return beta == T(0) ? 0.0 : beta == T(1) ? 1.0 : beta == T(-1) ? -1.0 : 2.0;
 }
 
+// Read an environment variable, returning nullptr if it is not set
+const char* read_env(const char* env_var);
+
 // Internal use, whether Tensile supports ldc != ldd
 // We assume true if the value is greater than or equal to 906
 bool rocblas_internal_tensile_supports_ldc_ne_ldd(rocblas_handle handle);
@@ -5,10 +5,14 @@
 #include "handle.hpp"
 #include "logging.hpp"
 #include "rocblas-auxiliary.h"
+#include "rocblas_host_pack.hpp"
+#include <algorithm>
 #include <cctype>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 /* ============================================================================================ */
 
@@ -102,6 +106,164 @@ catch(...)
     return exception_to_rocblas_status();
 }
 
+/*******************************************************************************
+ * ! \brief get host result mode
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_host_result_mode(rocblas_handle            handle,
+                                                       rocblas_host_result_mode* mode)
+try
+{
+    // if handle not valid
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!mode)
+        return rocblas_status_invalid_pointer;
+    *mode = handle->host_result_mode;
+    if(handle->layer_mode & rocblas_layer_mode_log_trace)
+        log_trace(handle, "rocblas_get_host_result_mode", *mode);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief set host result mode to blocking or deferred
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_host_result_mode(rocblas_handle           handle,
+                                                       rocblas_host_result_mode mode)
+try
+{
+    // if handle not valid
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(mode != rocblas_host_result_blocking && mode != rocblas_host_result_deferred)
+        return rocblas_status_invalid_value;
+    if(handle->layer_mode & rocblas_layer_mode_log_trace)
+        log_trace(handle, "rocblas_set_host_result_mode", mode);
+    handle->host_result_mode = mode;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief get capture mode
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_capture_mode(rocblas_handle        handle,
+                                                   rocblas_capture_mode* mode)
+try
+{
+    // if handle not valid
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!mode)
+        return rocblas_status_invalid_pointer;
+    *mode = handle->sync.capture_safe() ? rocblas_capture_safe : rocblas_capture_default;
+    if(handle->layer_mode & rocblas_layer_mode_log_trace)
+        log_trace(handle, "rocblas_get_capture_mode", *mode);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief set capture mode to default or safe
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_capture_mode(rocblas_handle handle, rocblas_capture_mode mode)
+try
+{
+    // if handle not valid
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(mode != rocblas_capture_default && mode != rocblas_capture_safe)
+        return rocblas_status_invalid_value;
+    if(handle->layer_mode & rocblas_layer_mode_log_trace)
+        log_trace(handle, "rocblas_set_capture_mode", mode);
+    handle->sync.set_capture_safe(mode == rocblas_capture_safe);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief get the numbers of host synchronizations and allocations
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_sync_point_counts(rocblas_handle             handle,
+                                                        rocblas_sync_point_counts* counts)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!counts)
+        return rocblas_status_invalid_pointer;
+    *counts = handle->sync.counts();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief reset the numbers of host synchronizations and allocations
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_reset_sync_point_counts(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    handle->sync.reset_counts();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief get the calls of each function counted with perf_counters
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_perf_counters(rocblas_handle             handle,
+                                                    rocblas_function_counters* counters,
+                                                    size_t*                    count)
+try
+{
+    if(!count)
+        return rocblas_status_invalid_pointer;
+    auto snapshot
+        = (handle ? handle->perf_counters : rocblas_process_perf_counters()).snapshot();
+    if(counters)
+        std::copy_n(snapshot.begin(), std::min(*count, snapshot.size()), counters);
+    *count = snapshot.size();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief reset the calls of each function counted with perf_counters
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_reset_perf_counters(rocblas_handle handle)
+try
+{
+    (handle ? handle->perf_counters : rocblas_process_perf_counters()).reset();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /*******************************************************************************
  * ! \brief query the preferable supported int8 input layout for gemm by device
  ******************************************************************************/
@@ -225,9 +387,7 @@ catch(...)
  *! \brief  Non-unit stride vector copy on device. Vectors are void pointers
      with element size elem_size
  ******************************************************************************/
-// arbitrarily assign max buffer size to 1Mb
-constexpr size_t      VEC_BUFF_MAX_BYTES = 1048576;
-constexpr rocblas_int NB_X               = 256;
+constexpr rocblas_int NB_X = 256;
 
 ROCBLAS_KERNEL void rocblas_copy_void_ptr_vector_kernel(rocblas_int n,
                                                         rocblas_int elem_size,
@@ -261,130 +421,362 @@ static void device_free(void* ptr)
     PRINT_IF_HIP_ERROR((hipFree)(ptr));
 }
 
-using rocblas_unique_ptr = std::unique_ptr<void, void (*)(void*)>;
+constexpr size_t STAGING_BUFF_BYTES = 4 * 1048576;
 
 /*******************************************************************************
- *! \brief   copies void* vector x with stride incx on host to void* vector
-     y with stride incy on device. Vectors have n elements of size elem_size.
-  TODO: Need to replace device memory allocation with new system
+ * Staging buffers for rocblas_set_matrix, rocblas_get_matrix,
+ * rocblas_set_vector and rocblas_get_vector, when either matrix or vector is
+ * not contiguous. Data is packed into one of several pinned host buffers, so
+ * that packing or unpacking a chunk on the host overlaps the transfer of the
+ * next chunk. The size and number of the buffers are set by
+ * ROCBLAS_MATRIX_STAGING_BYTES (default STAGING_BUFF_BYTES) and
+ * ROCBLAS_MATRIX_STAGING_BUFFERS (default 2; 1 disables the overlap).
+ *
+ * These functions do not take a handle, so the buffers are kept per device
+ * instead: each call takes a set of them for its duration, and returns it for
+ * reuse by later calls. The sets are never freed.
  ******************************************************************************/
-extern "C" rocblas_status rocblas_set_vector(rocblas_int n,
-                                             rocblas_int elem_size,
-                                             const void* x_h,
-                                             rocblas_int incx,
-                                             void*       y_d,
-                                             rocblas_int incy)
-try
+class rocblas_matrix_staging
 {
-    if(n == 0) // quick return
-        return rocblas_status_success;
-    if(n < 0 || incx <= 0 || incy <= 0 || elem_size <= 0)
-        return rocblas_status_invalid_size;
-    if(!x_h || !y_d)
-        return rocblas_status_invalid_pointer;
+    struct buffers_t
+    {
+        std::vector<void*>      host;
+        std::vector<void*>      device;
+        std::vector<hipEvent_t> events;
+    };
 
-    if(incx == 1 && incy == 1) // contiguous host vector -> contiguous device vector
+    int        m_device;
+    buffers_t* m_buffers;
+
+    static std::mutex& free_mutex()
     {
-        PRINT_IF_HIP_ERROR(hipMemcpy(y_d, x_h, elem_size * n, hipMemcpyHostToDevice));
+        static std::mutex mutex;
+        return mutex;
     }
-    else // either non-contiguous host vector or non-contiguous device vector
+
+    // Sets of buffers not in use, indexed by device
+    static std::vector<std::vector<buffers_t*>>& free_buffers()
     {
-        size_t bytes_to_copy = static_cast<size_t>(elem_size) * static_cast<size_t>(n);
-        size_t temp_byte_size
-            = bytes_to_copy < VEC_BUFF_MAX_BYTES ? bytes_to_copy : VEC_BUFF_MAX_BYTES;
-        int n_elem = temp_byte_size / elem_size; // number of elements in buffer
-        int n_copy = ((n - 1) / n_elem) + 1; // number of times buffer is copied
+        static auto* sets = new std::vector<std::vector<buffers_t*>>;
+        return *sets;
+    }
+
+public:
+    static size_t buffer_bytes()
+    {
+        static const size_t bytes = [] {
+            const char* env   = read_env("ROCBLAS_MATRIX_STAGING_BYTES");
+            size_t      bytes = env ? strtoull(env, nullptr, 0) : 0;
+            return bytes ? bytes : STAGING_BUFF_BYTES;
+        }();
+        return bytes;
+    }
 
-        int  blocks = (n_elem - 1) / NB_X + 1; // parameters for device kernel
-        dim3 grid(blocks);
-        dim3 threads(NB_X);
+    static int buffer_count()
+    {
+        static const int count = [] {
+            const char* env   = read_env("ROCBLAS_MATRIX_STAGING_BUFFERS");
+            int         count = env ? atoi(env) : 0;
+            return count > 0 ? count : 2;
+        }();
+        return count;
+    }
 
-        size_t x_h_byte_stride = (size_t)elem_size * incx;
-        size_t y_d_byte_stride = (size_t)elem_size * incy;
-        size_t t_h_byte_stride = (size_t)elem_size;
+    rocblas_matrix_staging()
+        : m_device(0)
+        , m_buffers(nullptr)
+    {
+        THROW_IF_HIP_ERROR(hipGetDevice(&m_device));
+        std::lock_guard<std::mutex> lock(free_mutex());
+        auto&                       sets = free_buffers();
+        if(size_t(m_device) < sets.size() && !sets[m_device].empty())
+        {
+            m_buffers = sets[m_device].back();
+            sets[m_device].pop_back();
+        }
+        else
+        {
+            m_buffers = new buffers_t;
+        }
+    }
 
+    ~rocblas_matrix_staging()
+    {
+        // No transfer may still use the buffers when they are reused, even after an error
+        hipStreamSynchronize(0);
+
+        std::lock_guard<std::mutex> lock(free_mutex());
+        auto&                       sets = free_buffers();
+        if(size_t(m_device) >= sets.size())
+            sets.resize(m_device + 1);
+        sets[m_device].push_back(m_buffers);
+    }
+
+    rocblas_matrix_staging(const rocblas_matrix_staging&) = delete;
+    rocblas_matrix_staging& operator=(const rocblas_matrix_staging&) = delete;
+
+    // Allocate the host buffers and events, and the device buffers if needed.
+    // Returns false if an allocation fails.
+    bool allocate(bool need_device)
+    {
+        int count = buffer_count();
+        m_buffers->host.resize(count, nullptr);
+        m_buffers->events.resize(count, nullptr);
+        for(int i = 0; i < count; i++)
+        {
+            if(!m_buffers->host[i]
+               && hipHostMalloc(&m_buffers->host[i], buffer_bytes()) != hipSuccess)
+            {
+                m_buffers->host[i] = nullptr;
+                return false;
+            }
+            if(!m_buffers->events[i]
+               && hipEventCreateWithFlags(&m_buffers->events[i], hipEventDisableTiming)
+                      != hipSuccess)
+            {
+                m_buffers->events[i] = nullptr;
+                return false;
+            }
+        }
+        if(need_device)
+        {
+            m_buffers->device.resize(count, nullptr);
+            for(int i = 0; i < count; i++)
+                if(!m_buffers->device[i] && !(m_buffers->device[i] = device_malloc(buffer_bytes())))
+                    return false;
+        }
+        return true;
+    }
+
+    void* host(int i) const
+    {
+        return m_buffers->host[i];
+    }
+
+    void* device(int i) const
+    {
+        return m_buffers->device[i];
+    }
+
+    hipEvent_t event(int i) const
+    {
+        return m_buffers->events[i];
+    }
+};
+
+/*******************************************************************************
+ *! \brief  Copies data between the host and the device through the staging
+     buffers, in n_copy chunks of up to one staging buffer each. When copying to
+     the device, the host packs chunk i+1 while chunk i is transferred; when
+     copying to the host, chunks are transferred ahead of the host unpacking
+     them, up to the number of staging buffers.
+
+     chunk_bytes(i) is the packed size of chunk i, and pack(i, t_h) copies it
+     between the host data and the packed host buffer t_h, in the direction of
+     the copy. device_chunk(i) is the device address of chunk i, to which it is
+     transferred directly if device_strided is false. Otherwise copy_device(i,
+     t_d) launches the copy of chunk i between the device data and the packed
+     device buffer t_d.
+ ******************************************************************************/
+template <typename ChunkBytes, typename Pack, typename DeviceChunk, typename CopyDevice>
+static rocblas_status rocblas_copy_staged(bool          to_device,
+                                          bool          device_strided,
+                                          int           n_copy,
+                                          ChunkBytes&&  chunk_bytes,
+                                          Pack&&        pack,
+                                          DeviceChunk&& device_chunk,
+                                          CopyDevice&&  copy_device)
+{
+    rocblas_matrix_staging staging;
+    if(!staging.allocate(device_strided))
+        return rocblas_status_memory_error;
+
+    const int nbuf = rocblas_matrix_staging::buffer_count();
+
+    if(to_device)
+    {
         for(int i_copy = 0; i_copy < n_copy; i_copy++)
         {
-            int         i_start     = i_copy * n_elem;
-            int         n_elem_max  = n - i_start < n_elem ? n - i_start : n_elem;
-            int         contig_size = n_elem_max * elem_size;
-            void*       y_d_start   = (char*)y_d + i_start * y_d_byte_stride;
-            const void* x_h_start   = (const char*)x_h + i_start * x_h_byte_stride;
+            int   buf = i_copy % nbuf;
+            void* t_h = staging.host(buf);
+
+            // Wait for the previous transfer from this buffer before overwriting it
+            if(i_copy >= nbuf)
+                RETURN_IF_HIP_ERROR(hipEventSynchronize(staging.event(buf)));
+
+            // host data -> host buffer
+            pack(i_copy, t_h);
+
+            // host buffer -> contiguous device data, or device buffer -> non-contiguous device data
+            void* dst = device_strided ? staging.device(buf) : device_chunk(i_copy);
+            RETURN_IF_HIP_ERROR(
+                hipMemcpyAsync(dst, t_h, chunk_bytes(i_copy), hipMemcpyHostToDevice, 0));
+            RETURN_IF_HIP_ERROR(hipEventRecord(staging.event(buf), 0));
+            if(device_strided)
+                copy_device(i_copy, dst);
+        }
+    }
+    else
+    {
+        // Enqueue the transfer of a chunk from the device data to a host buffer
+        auto enqueue = [&](int i_copy) {
+            int         buf = i_copy % nbuf;
+            const void* src = device_chunk(i_copy);
+
+            if(device_strided)
+            {
+                // non-contiguous device data -> device buffer
+                copy_device(i_copy, staging.device(buf));
+                src = staging.device(buf);
+            }
+
+            // device data or device buffer -> host buffer
+            RETURN_IF_HIP_ERROR(hipMemcpyAsync(
+                staging.host(buf), src, chunk_bytes(i_copy), hipMemcpyDeviceToHost, 0));
+            RETURN_IF_HIP_ERROR(hipEventRecord(staging.event(buf), 0));
+            return rocblas_status_success;
+        };
 
-            if((incx != 1) && (incy != 1))
+        int issued = 0;
+        for(int i_copy = 0; i_copy < n_copy; i_copy++)
+        {
+            // Keep up to nbuf chunks in flight; the buffer of chunk issued has
+            // been unpacked, since issued - nbuf < i_copy
+            while(issued < n_copy && issued < i_copy + nbuf)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous host vector -> host buffer
-                for(size_t i_b = 0, i_x = i_start; i_b < n_elem_max; i_b++, i_x++)
-                {
-                    memcpy((char*)t_h + i_b * t_h_byte_stride,
-                           (const char*)x_h + i_x * x_h_byte_stride,
-                           elem_size);
-                }
-                // host buffer -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, t_h, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device vector
+                rocblas_status status = enqueue(issued++);
+                if(status != rocblas_status_success)
+                    return status;
+            }
+
+            // host buffer -> host data
+            int buf = i_copy % nbuf;
+            RETURN_IF_HIP_ERROR(hipEventSynchronize(staging.event(buf)));
+            pack(i_copy, staging.host(buf));
+        }
+    }
+
+    // The copy is complete when the call returns, like hipMemcpy
+    RETURN_IF_HIP_ERROR(hipStreamSynchronize(0));
+    return rocblas_status_success;
+}
+
+/*******************************************************************************
+ *! \brief  Copies n elements between a host vector x_h and a device vector y_d
+     with strides incx and incy, through the staging buffers. Each chunk of the
+     host vector is gathered or scattered by the host packing engine as a whole.
+ ******************************************************************************/
+static rocblas_status rocblas_copy_vector_staged(bool        to_device,
+                                                 rocblas_int n,
+                                                 rocblas_int elem_size,
+                                                 void*       x_h,
+                                                 rocblas_int incx,
+                                                 void*       y_d,
+                                                 rocblas_int incy)
+{
+    size_t bytes_to_copy  = size_t(elem_size) * n;
+    size_t temp_byte_size = std::min(bytes_to_copy, rocblas_matrix_staging::buffer_bytes());
+    int    n_elem         = temp_byte_size / elem_size; // number of elements in buffer
+    int    n_copy         = ((n - 1) / n_elem) + 1; // number of chunks
+
+    int  blocks = (n_elem - 1) / NB_X + 1; // parameters for device kernel
+    dim3 grid(blocks);
+    dim3 threads(NB_X);
+
+    size_t x_h_byte_stride = size_t(elem_size) * incx;
+    size_t y_d_byte_stride = size_t(elem_size) * incy;
+
+    auto chunk_elems = [&](int i_copy) { return std::min(n - i_copy * n_elem, n_elem); };
+    auto y_d_start   = [&](int i_copy) {
+        return (char*)y_d + size_t(i_copy) * n_elem * y_d_byte_stride;
+    };
+
+    return rocblas_copy_staged(
+        to_device,
+        incy != 1,
+        n_copy,
+        [&](int i_copy) { return size_t(elem_size) * chunk_elems(i_copy); },
+        [&](int i_copy, void* t_h) {
+            // non-contiguous host vector <-> host buffer
+            char* x_h_start = (char*)x_h + size_t(i_copy) * n_elem * x_h_byte_stride;
+            if(to_device)
+                rocblas_host_strided_copy(t_h, 1, x_h_start, incx, chunk_elems(i_copy), elem_size);
+            else
+                rocblas_host_strided_copy(x_h_start, incx, t_h, 1, chunk_elems(i_copy), elem_size);
+        },
+        y_d_start,
+        [&](int i_copy, void* t_d) {
+            // device buffer <-> non-contiguous device vector
+            if(to_device)
                 hipLaunchKernelGGL(rocblas_copy_void_ptr_vector_kernel,
                                    grid,
                                    threads,
                                    0,
                                    0,
-                                   n_elem_max,
+                                   chunk_elems(i_copy),
                                    elem_size,
                                    t_d,
                                    1,
-                                   y_d_start,
+                                   y_d_start(i_copy),
                                    incy);
-            }
-            else if(incx == 1 && incy != 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // contiguous host vector -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, x_h_start, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device vector
+            else
                 hipLaunchKernelGGL(rocblas_copy_void_ptr_vector_kernel,
                                    grid,
                                    threads,
                                    0,
                                    0,
-                                   n_elem_max,
+                                   chunk_elems(i_copy),
                                    elem_size,
+                                   y_d_start(i_copy),
+                                   incy,
                                    t_d,
-                                   1,
-                                   y_d_start,
-                                   incy);
-            }
-            else if(incx != 1 && incy == 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // non-contiguous host vector -> host buffer
-                for(size_t i_b = 0, i_x = i_start; i_b < n_elem_max; i_b++, i_x++)
-                {
-                    memcpy((char*)t_h + i_b * t_h_byte_stride,
-                           (const char*)x_h + i_x * x_h_byte_stride,
-                           elem_size);
-                }
-                // host buffer -> contiguous device vector
-                PRINT_IF_HIP_ERROR(hipMemcpy(y_d_start, t_h, contig_size, hipMemcpyHostToDevice));
-            }
+                                   1);
+        });
+}
+
+/*******************************************************************************
+ *! \brief   copies void* vector x with stride incx on host to void* vector
+     y with stride incy on device. Vectors have n elements of size elem_size.
+  TODO: Need to replace device memory allocation with new system
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_vector(rocblas_int n,
+                                             rocblas_int elem_size,
+                                             const void* x_h,
+                                             rocblas_int incx,
+                                             void*       y_d,
+                                             rocblas_int incy)
+try
+{
+    if(n == 0) // quick return
+        return rocblas_status_success;
+    if(n < 0 || incx <= 0 || incy <= 0 || elem_size <= 0)
+        return rocblas_status_invalid_size;
+    if(!x_h || !y_d)
+        return rocblas_status_invalid_pointer;
+
+    if(incx == 1 && incy == 1) // contiguous host vector -> contiguous device vector
+    {
+        PRINT_IF_HIP_ERROR(hipMemcpy(y_d, x_h, elem_size * n, hipMemcpyHostToDevice));
+    }
+    // elements too large for the staging buffers, copy element by element
+    else if(size_t(elem_size) > rocblas_matrix_staging::buffer_bytes())
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            PRINT_IF_HIP_ERROR(hipMemcpy((char*)y_d + i * incy * elem_size,
+                                         (const char*)x_h + i * incx * elem_size,
+                                         elem_size,
+                                         hipMemcpyHostToDevice));
         }
     }
+    // either non-contiguous host vector or non-contiguous device vector: pack the
+    // host vector in staging buffers, transfer them to the device and unpack them
+    // on the device, overlapping packing with transfers
+    else
+    {
+        return rocblas_copy_vector_staged(
+            true, n, elem_size, const_cast<void*>(x_h), incx, y_d, incy);
+    }
     return rocblas_status_success;
 }
 catch(...) // catch all exceptions
@@ -415,105 +807,25 @@ try
     {
         PRINT_IF_HIP_ERROR(hipMemcpy(y_h, x_d, elem_size * n, hipMemcpyDeviceToHost));
     }
-    else // either device or host vector is non-contiguous
+    // elements too large for the staging buffers, copy element by element
+    else if(size_t(elem_size) > rocblas_matrix_staging::buffer_bytes())
     {
-        size_t bytes_to_copy = static_cast<size_t>(elem_size) * static_cast<size_t>(n);
-        size_t temp_byte_size
-            = bytes_to_copy < VEC_BUFF_MAX_BYTES ? bytes_to_copy : VEC_BUFF_MAX_BYTES;
-        int n_elem = temp_byte_size / elem_size; // number elements in buffer
-        int n_copy = ((n - 1) / n_elem) + 1; // number of times buffer is copied
-
-        int  blocks = (n_elem - 1) / NB_X + 1; // parameters for device kernel
-        dim3 grid(blocks);
-        dim3 threads(NB_X);
-
-        size_t x_d_byte_stride = (size_t)elem_size * incx;
-        size_t y_h_byte_stride = (size_t)elem_size * incy;
-        size_t t_h_byte_stride = (size_t)elem_size;
-
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
+        for(size_t i = 0; i < n; i++)
         {
-            int i_start           = i_copy * n_elem;
-            int n_elem_max        = n - (n_elem * i_copy) < n_elem ? n - (n_elem * i_copy) : n_elem;
-            int contig_size       = elem_size * n_elem_max;
-            const void* x_d_start = (const char*)x_d + i_start * x_d_byte_stride;
-            void*       y_h_start = (char*)y_h + i_start * y_h_byte_stride;
-
-            if(incx != 1 && incy != 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device vector -> device buffer
-                hipLaunchKernelGGL(rocblas_copy_void_ptr_vector_kernel,
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   x_d_start,
-                                   incx,
-                                   t_d,
-                                   1);
-                // device buffer -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, t_d, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host vector
-                for(size_t i_b = 0, i_y = i_start; i_b < n_elem_max; i_b++, i_y++)
-                {
-                    memcpy((char*)y_h + i_y * y_h_byte_stride,
-                           (const char*)t_h + i_b * t_h_byte_stride,
-                           elem_size);
-                }
-            }
-            else if(incx == 1 && incy != 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // congiguous device vector -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, x_d_start, contig_size, hipMemcpyDeviceToHost));
-
-                // host buffer -> non-contiguous host vector
-                for(size_t i_b = 0, i_y = i_start; i_b < n_elem_max; i_b++, i_y++)
-                {
-                    memcpy((char*)y_h + i_y * y_h_byte_stride,
-                           (const char*)t_h + i_b * t_h_byte_stride,
-                           elem_size);
-                }
-            }
-            else if(incx != 1 && incy == 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device vector -> device buffer
-                hipLaunchKernelGGL(rocblas_copy_void_ptr_vector_kernel,
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   x_d_start,
-                                   incx,
-                                   t_d,
-                                   1);
-                // device buffer -> contiguous host vector
-                PRINT_IF_HIP_ERROR(hipMemcpy(y_h_start, t_d, contig_size, hipMemcpyDeviceToHost));
-            }
+            PRINT_IF_HIP_ERROR(hipMemcpy((char*)y_h + i * incy * elem_size,
+                                         (const char*)x_d + i * incx * elem_size,
+                                         elem_size,
+                                         hipMemcpyDeviceToHost));
         }
     }
+    // either device or host vector is non-contiguous: pack the device vector in
+    // device buffers, transfer them to staging buffers and unpack them on the
+    // host, overlapping unpacking with transfers
+    else
+    {
+        return rocblas_copy_vector_staged(
+            false, n, elem_size, y_h, incy, const_cast<void*>(x_d), incx);
+    }
     return rocblas_status_success;
 }
 catch(...) // catch all exceptions
@@ -612,9 +924,8 @@ catch(...) // catch all exceptions
      size elem_size
  ******************************************************************************/
 
-constexpr size_t      MAT_BUFF_MAX_BYTES = 1048576;
-constexpr rocblas_int MATRIX_DIM_X       = 128;
-constexpr rocblas_int MATRIX_DIM_Y       = 8;
+constexpr rocblas_int MATRIX_DIM_X = 128;
+constexpr rocblas_int MATRIX_DIM_Y = 8;
 
 ROCBLAS_KERNEL void rocblas_copy_void_ptr_matrix_kernel(rocblas_int rows,
                                                         rocblas_int cols,
@@ -633,6 +944,85 @@ ROCBLAS_KERNEL void rocblas_copy_void_ptr_matrix_kernel(rocblas_int rows,
                elem_size);
 }
 
+/*******************************************************************************
+ *! \brief  Copies a rows * cols matrix between a host matrix a_h and a device
+     matrix b_d with leading dimensions lda and ldb, through the staging buffers.
+     Columns are packed into chunks of up to one staging buffer.
+ ******************************************************************************/
+static rocblas_status rocblas_copy_matrix_staged(bool        to_device,
+                                                 rocblas_int rows,
+                                                 rocblas_int cols,
+                                                 rocblas_int elem_size,
+                                                 void*       a_h,
+                                                 rocblas_int lda,
+                                                 void*       b_d,
+                                                 rocblas_int ldb)
+{
+    size_t col_bytes      = size_t(elem_size) * rows;
+    size_t bytes_to_copy  = col_bytes * cols;
+    size_t temp_byte_size = std::min(bytes_to_copy, rocblas_matrix_staging::buffer_bytes());
+    int    n_cols         = temp_byte_size / col_bytes; // number of columns in buffer
+    int    n_copy         = ((cols - 1) / n_cols) + 1; // number of chunks
+
+    rocblas_int blocksX = ((rows - 1) / MATRIX_DIM_X) + 1; // parameters for device kernel
+    rocblas_int blocksY = ((n_cols - 1) / MATRIX_DIM_Y) + 1;
+    dim3        grid(blocksX, blocksY);
+    dim3        threads(MATRIX_DIM_X, MATRIX_DIM_Y);
+
+    size_t lda_h_byte = size_t(elem_size) * lda;
+    size_t ldb_d_byte = size_t(elem_size) * ldb;
+
+    auto chunk_cols = [&](int i_copy) { return std::min(cols - i_copy * n_cols, n_cols); };
+    auto b_d_start  = [&](int i_copy) {
+        return (char*)b_d + size_t(i_copy) * n_cols * ldb_d_byte;
+    };
+
+    return rocblas_copy_staged(
+        to_device,
+        ldb != rows,
+        n_copy,
+        [&](int i_copy) { return col_bytes * chunk_cols(i_copy); },
+        [&](int i_copy, void* t_h) {
+            // columns of the host matrix <-> host buffer
+            char*  a_h_start = (char*)a_h + size_t(i_copy) * n_cols * lda_h_byte;
+            size_t n         = chunk_cols(i_copy);
+            if(to_device)
+                rocblas_host_copy_columns(t_h, col_bytes, a_h_start, lda_h_byte, col_bytes, n);
+            else
+                rocblas_host_copy_columns(a_h_start, lda_h_byte, t_h, col_bytes, col_bytes, n);
+        },
+        b_d_start,
+        [&](int i_copy, void* t_d) {
+            // device buffer <-> non-contiguous device matrix
+            if(to_device)
+                hipLaunchKernelGGL(rocblas_copy_void_ptr_matrix_kernel,
+                                   grid,
+                                   threads,
+                                   0,
+                                   0,
+                                   rows,
+                                   chunk_cols(i_copy),
+                                   elem_size,
+                                   t_d,
+                                   rows,
+                                   b_d_start(i_copy),
+                                   ldb);
+            else
+                hipLaunchKernelGGL(rocblas_copy_void_ptr_matrix_kernel,
+                                   grid,
+                                   threads,
+                                   0,
+                                   0,
+                                   rows,
+                                   chunk_cols(i_copy),
+                                   elem_size,
+                                   b_d_start(i_copy),
+                                   ldb,
+                                   t_d,
+                                   rows);
+        });
+}
+
 /*******************************************************************************
  *! \brief   copies void* matrix a_h with leading dimentsion lda on host to
      void* matrix b_d with leading dimension ldb on device. Matrices have
@@ -663,7 +1053,7 @@ try
         PRINT_IF_HIP_ERROR(hipMemcpy(b_d, a_h, bytes_to_copy, hipMemcpyHostToDevice));
     }
     // matrix colums too large to fit in temp buffer, copy matrix col by col
-    else if(rows * elem_size > MAT_BUFF_MAX_BYTES)
+    else if(size_t(rows) * elem_size > rocblas_matrix_staging::buffer_bytes())
     {
         for(size_t i = 0; i < cols; i++)
         {
@@ -673,109 +1063,12 @@ try
                                          hipMemcpyHostToDevice));
         }
     }
-    // columns fit in temp buffer, pack columns in buffer, hipMemcpy host->device, unpack
-    // columns
+    // columns fit in staging buffers, pack columns in host buffers, transfer to device
+    // and unpack columns, overlapping packing with transfers
     else
     {
-        size_t bytes_to_copy = static_cast<size_t>(elem_size) * static_cast<size_t>(rows)
-                               * static_cast<size_t>(cols);
-        size_t temp_byte_size
-            = bytes_to_copy < MAT_BUFF_MAX_BYTES ? bytes_to_copy : MAT_BUFF_MAX_BYTES;
-        int n_cols = temp_byte_size / (elem_size * rows); // number of columns in buffer
-        int n_copy = ((cols - 1) / n_cols) + 1; // number of times buffer is copied
-
-        rocblas_int blocksX = ((rows - 1) / MATRIX_DIM_X) + 1; // parameters for device kernel
-        rocblas_int blocksY = ((n_cols - 1) / MATRIX_DIM_Y) + 1;
-        dim3        grid(blocksX, blocksY);
-        dim3        threads(MATRIX_DIM_X, MATRIX_DIM_Y);
-
-        size_t lda_h_byte = (size_t)elem_size * lda;
-        size_t ldb_d_byte = (size_t)elem_size * ldb;
-        size_t ldt_h_byte = (size_t)elem_size * rows;
-
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
-        {
-            size_t      i_start     = i_copy * n_cols;
-            int         n_cols_max  = cols - i_start < n_cols ? cols - i_start : n_cols;
-            int         contig_size = elem_size * rows * n_cols_max;
-            void*       b_d_start   = (char*)b_d + i_start * ldb_d_byte;
-            const void* a_h_start   = (const char*)a_h + i_start * lda_h_byte;
-
-            if((lda != rows) && (ldb != rows))
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous host matrix -> host buffer
-                for(size_t i_t = 0, i_a = i_start; i_t < n_cols_max; i_t++, i_a++)
-                {
-                    memcpy((char*)t_h + i_t * ldt_h_byte,
-                           (const char*)a_h + i_a * lda_h_byte,
-                           ldt_h_byte);
-                }
-                // host buffer -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, t_h, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device matrix
-                hipLaunchKernelGGL(rocblas_copy_void_ptr_matrix_kernel,
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   rows,
-                                   n_cols_max,
-                                   elem_size,
-                                   t_d,
-                                   rows,
-                                   b_d_start,
-                                   ldb);
-            }
-            else if(lda == rows && ldb != rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // contiguous host matrix -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, a_h_start, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device matrix
-                hipLaunchKernelGGL(rocblas_copy_void_ptr_matrix_kernel,
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   rows,
-                                   n_cols_max,
-                                   elem_size,
-                                   t_d,
-                                   rows,
-                                   b_d_start,
-                                   ldb);
-            }
-            else if(lda != rows && ldb == rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // non-contiguous host matrix -> host buffer
-                for(size_t i_t = 0, i_a = i_start; i_t < n_cols_max; i_t++, i_a++)
-                {
-                    memcpy((char*)t_h + i_t * ldt_h_byte,
-                           (const char*)a_h + i_a * lda_h_byte,
-                           ldt_h_byte);
-                }
-                // host buffer -> contiguous device matrix
-                PRINT_IF_HIP_ERROR(hipMemcpy(b_d_start, t_h, contig_size, hipMemcpyHostToDevice));
-            }
-        }
+        return rocblas_copy_matrix_staged(
+            true, rows, cols, elem_size, const_cast<void*>(a_h), lda, b_d, ldb);
     }
     return rocblas_status_success;
 }
@@ -813,7 +1106,7 @@ try
         PRINT_IF_HIP_ERROR(hipMemcpy(b_h, a_d, bytes_to_copy, hipMemcpyDeviceToHost));
     }
     // columns too large for temp buffer, hipMemcpy column by column
-    else if(rows * elem_size > MAT_BUFF_MAX_BYTES)
+    else if(size_t(rows) * elem_size > rocblas_matrix_staging::buffer_bytes())
     {
         for(size_t i = 0; i < cols; i++)
         {
@@ -823,107 +1116,12 @@ try
                                          hipMemcpyDeviceToHost));
         }
     }
-    // columns fit in temp buffer, pack columns in buffer, hipMemcpy device->host, unpack
-    // columns
+    // columns fit in staging buffers, pack columns on device, transfer to host buffers
+    // and unpack columns, overlapping unpacking with transfers
     else
     {
-        size_t bytes_to_copy = elem_size * static_cast<size_t>(rows) * cols;
-        size_t temp_byte_size
-            = bytes_to_copy < MAT_BUFF_MAX_BYTES ? bytes_to_copy : MAT_BUFF_MAX_BYTES;
-        int n_cols = temp_byte_size / (elem_size * rows); // number of columns in buffer
-        int n_copy = ((cols - 1) / n_cols) + 1; // number times buffer copied
-
-        rocblas_int blocksX = ((rows - 1) / MATRIX_DIM_X) + 1; // parameters for device kernel
-        rocblas_int blocksY = ((n_cols - 1) / MATRIX_DIM_Y) + 1;
-        dim3        grid(blocksX, blocksY);
-        dim3        threads(MATRIX_DIM_X, MATRIX_DIM_Y);
-
-        size_t lda_d_byte = (size_t)elem_size * lda;
-        size_t ldb_h_byte = (size_t)elem_size * ldb;
-        size_t ldt_h_byte = (size_t)elem_size * rows;
-
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
-        {
-            int         i_start     = i_copy * n_cols;
-            int         n_cols_max  = cols - i_start < n_cols ? cols - i_start : n_cols;
-            size_t      contig_size = elem_size * (size_t)rows * n_cols_max;
-            const void* a_d_start   = (const char*)a_d + i_start * lda_d_byte;
-            void*       b_h_start   = (char*)b_h + i_start * ldb_h_byte;
-            if(lda != rows && ldb != rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device matrix -> device buffer
-                hipLaunchKernelGGL(rocblas_copy_void_ptr_matrix_kernel,
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   rows,
-                                   n_cols_max,
-                                   elem_size,
-                                   a_d_start,
-                                   lda,
-                                   t_d,
-                                   rows);
-                // device buffer -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, t_d, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host matrix
-                for(size_t i_t = 0, i_b = i_start; i_t < n_cols_max; i_t++, i_b++)
-                {
-                    memcpy((char*)b_h + i_b * ldb_h_byte,
-                           (const char*)t_h + i_t * ldt_h_byte,
-                           ldt_h_byte);
-                }
-            }
-            else if(lda == rows && ldb != rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // congiguous device matrix -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, a_d_start, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host matrix
-                for(size_t i_t = 0, i_b = i_start; i_t < n_cols_max; i_t++, i_b++)
-                {
-                    memcpy((char*)b_h + i_b * ldb_h_byte,
-                           (const char*)t_h + i_t * ldt_h_byte,
-                           ldt_h_byte);
-                }
-            }
-            else if(lda != rows && ldb == rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device matrix -> device buffer
-                hipLaunchKernelGGL(rocblas_copy_void_ptr_matrix_kernel,
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   rows,
-                                   n_cols_max,
-                                   elem_size,
-                                   a_d_start,
-                                   lda,
-                                   t_d,
-                                   rows);
-                // device temp buffer -> contiguous host matrix
-                PRINT_IF_HIP_ERROR(hipMemcpy(b_h_start, t_d, contig_size, hipMemcpyDeviceToHost));
-            }
-        }
+        return rocblas_copy_matrix_staged(
+            false, rows, cols, elem_size, b_h, ldb, const_cast<void*>(a_d), lda);
     }
     return rocblas_status_success;
 }
@@ -1049,6 +1247,7 @@ extern "C" const char* rocblas_status_to_string(rocblas_status status)
         CASE(rocblas_status_invalid_value);
         CASE(rocblas_status_continue);
         CASE(rocblas_status_check_numerics_fail);
+        CASE(rocblas_status_capture_unsafe);
     }
 #undef CASE
     // We don't use default: so that the compiler warns us if any valid enums are missing
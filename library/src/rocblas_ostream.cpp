@@ -7,6 +7,7 @@ static void rocblas_abort_once [[noreturn]] ();
 
 #include "rocblas_ostream.hpp"
 #include <csignal>
+#include <cstring>
 #include <fcntl.h>
 #include <iostream>
 #include <type_traits>
@@ -48,6 +49,9 @@ static void rocblas_abort_once()
     alarm(5);
 #endif
 
+    // Write any queued asynchronous output
+    rocblas_internal_ostream::flush_workers();
+
     // Clear the map, stopping all workers
     rocblas_internal_ostream::clear_workers();
 
@@ -180,6 +184,55 @@ void rocblas_internal_ostream::clear_workers()
     worker_map().clear();
 }
 
+// Wait until all output sent to all workers has been written
+void rocblas_internal_ostream::flush_workers()
+{
+    std::lock_guard<std::recursive_mutex> lock(worker_map_mutex());
+    for(auto& p : worker_map())
+        if(p.second)
+            p.second->flush();
+}
+
+// Asynchronous logging settings, initialized from the environment
+// Implemented as singleton to avoid the static initialization order fiasco
+static rocblas_internal_ostream::async_config_t& async_settings()
+{
+    static rocblas_internal_ostream::async_config_t config = [] {
+        rocblas_internal_ostream::async_config_t config;
+
+        // ROCBLAS_LOG_ASYNC=1 turns on asynchronous logging
+        const char* env = read_env("ROCBLAS_LOG_ASYNC");
+        config.enabled  = env && strtol(env, nullptr, 0);
+
+        // ROCBLAS_LOG_ASYNC_QUEUE_SIZE is the maximum number of queued messages per file
+        env = read_env("ROCBLAS_LOG_ASYNC_QUEUE_SIZE");
+        if(env && strtoul(env, nullptr, 0))
+            config.capacity = strtoul(env, nullptr, 0);
+
+        // ROCBLAS_LOG_ASYNC_POLICY=drop drops messages when the queue is full,
+        // ROCBLAS_LOG_ASYNC_POLICY=block (the default) waits for room in the queue
+        env         = read_env("ROCBLAS_LOG_ASYNC_POLICY");
+        config.drop = env && !strcmp(env, "drop");
+
+        return config;
+    }();
+    return config;
+}
+
+// Get the current asynchronous logging settings
+rocblas_internal_ostream::async_config_t rocblas_internal_ostream::get_async_config()
+{
+    std::lock_guard<std::recursive_mutex> lock(worker_map_mutex());
+    return async_settings();
+}
+
+// Set the asynchronous logging settings for workers created afterwards
+void rocblas_internal_ostream::set_async_config(const async_config_t& config)
+{
+    std::lock_guard<std::recursive_mutex> lock(worker_map_mutex());
+    async_settings() = config;
+}
+
 // YAML Manipulators (only used for their addresses now)
 std::ostream& rocblas_internal_ostream::yaml_on(std::ostream& os)
 {
@@ -195,24 +248,32 @@ std::ostream& rocblas_internal_ostream::yaml_off(std::ostream& os)
  * rocblas_internal_ostream::worker functions handle logging in a single thread *
  ***********************************************************************/
 
-// Send a string to the worker thread for this stream's device/inode
-// Empty strings tell the worker thread to exit
-void rocblas_internal_ostream::worker::send(std::string str)
+// Queue a task for the worker thread and wait for it to be completed
+void rocblas_internal_ostream::worker::send_and_wait(task_t::kind_t kind, std::string str)
 {
     // Create a promise to wait for the operation to complete
-    std::promise<void> promise;
+    auto promise = std::make_unique<std::promise<void>>();
 
     // The future indicating when the operation has completed
-    auto future = promise.get_future();
+    auto future = promise->get_future();
 
-    // task_t consists of string and promise
+    // task_t consists of kind, string and promise
     // std::move transfers ownership of str and promise to task
-    task_t worker_task(std::move(str), std::move(promise));
+    task_t worker_task(kind, std::move(str), std::move(promise));
 
     // Submit the task to the worker assigned to this device/inode
     // Hold mutex for as short as possible, to reduce contention
     {
         std::lock_guard<std::mutex> lock(mutex);
+
+        // After a write error there is no worker thread to complete the task
+        if(failed)
+        {
+            if(kind == task_t::kind_t::write)
+                ++dropped;
+            return;
+        }
+
         queue.push(std::move(worker_task));
 
         // no lock needed for notification but keeping here
@@ -221,7 +282,7 @@ void rocblas_internal_ostream::worker::send(std::string str)
 
 // Wait for the task to be completed, to ensure flushed IO
 #ifdef WIN32
-    if(worker_task.size())
+    if(kind != task_t::kind_t::close)
         future.get();
     else
         future.wait_for(std::chrono::seconds(1));
@@ -230,7 +291,44 @@ void rocblas_internal_ostream::worker::send(std::string str)
 #endif
 }
 
+// Send a string to the worker thread for this stream's device/inode
+void rocblas_internal_ostream::worker::send(std::string str)
+{
+    // In synchronous mode, wait for the string to be written
+    if(!async)
+        return send_and_wait(task_t::kind_t::write, std::move(str));
+
+    // In asynchronous mode, queue the string without a promise and return
+    std::unique_lock<std::mutex> lock(mutex);
+    if(!failed && queue.size() >= capacity)
+    {
+        // If the queue is full, either drop the string or wait for the worker to drain it
+        if(drop)
+        {
+            ++dropped;
+            return;
+        }
+        space_cond.wait(lock, [&] { return failed || queue.size() < capacity; });
+    }
+
+    // After a write error the string is dropped, since nothing drains the queue
+    if(failed)
+    {
+        ++dropped;
+        return;
+    }
+    queue.push(task_t(task_t::kind_t::write, std::move(str), nullptr));
+    cond.notify_one();
+}
+
+// Wait until all strings sent to this worker before this call have been written
+void rocblas_internal_ostream::worker::flush()
+{
+    send_and_wait(task_t::kind_t::flush, {});
+}
+
 // Worker thread which serializes data to be written to a device/inode
+// All of the queued tasks are taken at once, written, and flushed with one fflush
 void rocblas_internal_ostream::worker::thread_function()
 {
     // Clear any errors in the FILE
@@ -239,49 +337,77 @@ void rocblas_internal_ostream::worker::thread_function()
     // Lock the mutex in preparation for cond.wait
     std::unique_lock<std::mutex> lock(mutex);
 
-    while(true)
+    for(bool done = false; !done;)
     {
         // Wait for any data, ignoring spurious wakeups, locks lock on continue
         cond.wait(lock, [&] { return !queue.empty(); });
 
-        // With the mutex locked, get and pop data from the front of queue
-        task_t task = std::move(queue.front());
-        queue.pop();
+        // With the mutex locked, take the whole queue as one batch
+        std::queue<task_t> batch;
+        batch.swap(queue);
+
+        // Wake up any producers waiting for room in the queue
+        space_cond.notify_all();
 
         // Temporarily unlock queue mutex, unblocking other threads
         lock.unlock();
 
-        // An empty message indicates the closing of the stream
-        if(!task.size())
+        // Write the data in the batch, keeping the tasks which are waited on
+        std::vector<task_t> waiters;
+        for(; !batch.empty(); batch.pop())
         {
-            // Tell future to wake up
-            task.set_value();
-            break;
+            task_t& task = batch.front();
+            if(task.get_kind() == task_t::kind_t::close)
+                done = true;
+            else if(task.size())
+                fwrite(task.data(), 1, task.size(), file);
+            if(task.has_promise())
+                waiters.push_back(std::move(task));
         }
 
-        // Write the data
-        fwrite(task.data(), 1, task.size(), file);
-
-        // Detect any error and flush the C FILE stream
-        if(ferror(file) || fflush(file))
-        {
+        // Detect any error and flush the C FILE stream once for the whole batch
+        bool error = ferror(file) || fflush(file);
+        if(error)
             perror("Error writing log file");
 
-            // Tell future to wake up
-            task.set_value();
-            break;
-        }
-
         // Promise that the data has been written
-        task.set_value();
+        for(auto& task : waiters)
+            task.set_value();
 
         // Re-lock the mutex in preparation for cond.wait
-        lock.lock();
+        if(!done || error)
+            lock.lock();
+
+        // After an error, exit without touching the file again. Later writes are dropped
+        // and waits return at once; release the tasks queued meanwhile and any producers
+        // waiting for room in the queue.
+        if(error)
+        {
+            failed = true;
+            for(; !queue.empty(); queue.pop())
+            {
+                if(queue.front().get_kind() == task_t::kind_t::write)
+                    ++dropped;
+                queue.front().set_value();
+            }
+            space_cond.notify_all();
+            return;
+        }
     }
 }
 
+// Write any queued asynchronous output before the program exits, registered once
+static void flush_workers_at_exit()
+{
+    static std::once_flag once;
+    std::call_once(once, [] { std::atexit(rocblas_internal_ostream::flush_workers); });
+}
+
 // Constructor creates a worker thread from a file descriptor
 rocblas_internal_ostream::worker::worker(int fd)
+    : async(async_settings().enabled)
+    , capacity(async_settings().capacity)
+    , drop(async_settings().drop)
 {
     // The worker duplicates the file descriptor (RAII)
 #ifdef WIN32
@@ -302,12 +428,24 @@ rocblas_internal_ostream::worker::worker(int fd)
 
     // Detatch from the worker thread
     thread.detach();
+
+    // Write any queued asynchronous output before the program exits
+    if(async)
+        flush_workers_at_exit();
 }
 
 rocblas_internal_ostream::worker::~worker()
 {
-    // Tell worker thread to exit, by sending it an empty string
-    send({});
+    // Tell worker thread to exit, after writing everything queued before
+    send_and_wait(task_t::kind_t::close, {});
+
+    // Report messages which were dropped because the asynchronous queue was full, or the file
+    // could not be written
+    if(dropped)
+        fprintf(stderr,
+                "rocBLAS warning: %zu log messages were dropped because the asynchronous "
+                "logging queue was full or the log file could not be written\n",
+                dropped);
 
     // Close the FILE
     if(file)
@@ -13,6 +13,22 @@ extern "C" void rocblas_shutdown();
 // In the old Tensile client, rocblas_initialize() is a no-op
 extern "C" void rocblas_initialize() {}
 
+// In the old Tensile client, there is no solution cache
+extern "C" rocblas_status rocblas_get_solution_cache_stats(rocblas_handle                handle,
+                                                           rocblas_solution_cache_stats* stats)
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!stats)
+        return rocblas_status_invalid_pointer;
+    return rocblas_status_not_implemented;
+}
+
+extern "C" rocblas_status rocblas_clear_solution_cache(rocblas_handle handle)
+{
+    return handle ? rocblas_status_not_implemented : rocblas_status_invalid_handle;
+}
+
 #else
 
 /*****************************************************************************
@@ -20,6 +36,7 @@ extern "C" void rocblas_initialize() {}
  * or reference Tensile identifiers. tensile_host.hpp defines the interface. *
  *****************************************************************************/
 
+#include "rocblas_lazy_code_objects.hpp"
 #include "tensile_host.hpp"
 //#include <Tensile/AMDGPU.hpp>
 #include <Tensile/Contractions.hpp>
@@ -31,6 +48,7 @@ extern "C" void rocblas_initialize() {}
 #include <Tensile/hip/HipHardware.hpp>
 #include <Tensile/hip/HipSolutionAdapter.hpp>
 #include <Tensile/hip/HipUtils.hpp>
+#include <array>
 #include <atomic>
 #include <complex>
 #include <exception>
@@ -171,6 +189,253 @@ namespace
         }
     }
 
+    // Size of GSU workspace available to Tensile. It is max size_t if this is a size query.
+    size_t TensileWorkspaceSize(rocblas_handle handle)
+    {
+        return handle->is_device_memory_size_query()
+                   ? ~size_t{0}
+                   : (handle->gsu_workspace_size / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
+                         * HPA_GSU_WORKSPACE_SIZE_GRANULARITY;
+    }
+
+    /**************************************************************************
+     * SolutionCache memoizes the solutions selected by findBestSolution for  *
+     * the problems solved on one device. The capacity is bounded, and set by *
+     * ROCBLAS_TENSILE_SOLUTION_CACHE_SIZE. Entries live in 4-way buckets.    *
+     *                                                                        *
+     * Lookups take no locks. Each slot has a sequence number which is odd    *
+     * while the slot is being written; a reader which sees it change treats  *
+     * the slot as a miss. Inserts are serialized by a mutex, and replace the *
+     * entries of a full bucket in round-robin order, with a cursor for each  *
+     * bucket. The cached solutions are owned by the library, which outlives  *
+     * the cache.                                                             *
+     **************************************************************************/
+    class SolutionCache
+    {
+    public:
+        // Compact problem key: types, ops, flags and scalar categories packed into
+        // one word, followed by the sizes, strides, offsets and workspace size
+        using key_t = std::array<uint64_t, 23>;
+
+    private:
+        static constexpr size_t ways = 4;
+
+        struct slot_t
+        {
+            std::atomic<uint64_t>                      seq{0};
+            std::atomic<Tensile::ContractionSolution*> solution{nullptr};
+            std::array<std::atomic<uint64_t>, std::tuple_size<key_t>::value> key{};
+        };
+
+        std::unique_ptr<slot_t[]> m_slots;
+        size_t                    m_bucket_mask = 0;
+        size_t                    m_capacity    = 0;
+
+        std::mutex                 m_mutex;
+        std::unique_ptr<uint8_t[]> m_victims; // Next slot to replace in each bucket
+
+        std::atomic<size_t> m_hits{0};
+        std::atomic<size_t> m_misses{0};
+        std::atomic<size_t> m_evictions{0};
+        std::atomic<size_t> m_entries{0};
+
+        static size_t hash(const key_t& key)
+        {
+            uint64_t h = 0xcbf29ce484222325;
+            for(auto word : key)
+            {
+                h ^= word;
+                h *= 0x100000001b3;
+                h ^= h >> 29;
+            }
+            return h;
+        }
+
+        size_t bucket_index(const key_t& key) const
+        {
+            return hash(key) & m_bucket_mask;
+        }
+
+        slot_t* bucket(const key_t& key) const
+        {
+            return &m_slots[bucket_index(key) * ways];
+        }
+
+        static bool matches(const slot_t& slot, const key_t& key)
+        {
+            for(size_t i = 0; i < key.size(); ++i)
+                if(slot.key[i].load(std::memory_order_relaxed) != key[i])
+                    return false;
+            return true;
+        }
+
+        // Overwrite a slot. Must be called with m_mutex held.
+        static void write(slot_t& slot, const key_t& key, Tensile::ContractionSolution* solution)
+        {
+            uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+            slot.seq.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for(size_t i = 0; i < key.size(); ++i)
+                slot.key[i].store(key[i], std::memory_order_relaxed);
+            slot.solution.store(solution, std::memory_order_relaxed);
+            slot.seq.store(seq + 2, std::memory_order_release);
+        }
+
+    public:
+        SolutionCache()
+        {
+            static const size_t size = [] {
+                const char* env = read_env("ROCBLAS_TENSILE_SOLUTION_CACHE_SIZE");
+                return env ? strtoull(env, nullptr, 0) : size_t{1024};
+            }();
+
+            if(size)
+            {
+                // Round the number of buckets up to a power of 2
+                size_t buckets = 1;
+                while(buckets * ways < size)
+                    buckets *= 2;
+                m_bucket_mask = buckets - 1;
+                m_capacity    = buckets * ways;
+                m_slots       = std::make_unique<slot_t[]>(m_capacity);
+                m_victims     = std::make_unique<uint8_t[]>(buckets);
+            }
+        }
+
+        SolutionCache(const SolutionCache&) = delete;
+        SolutionCache& operator=(const SolutionCache&) = delete;
+
+        bool enabled() const
+        {
+            return m_capacity != 0;
+        }
+
+        // Return the cached solution for key, or nullptr
+        Tensile::ContractionSolution* lookup(const key_t& key)
+        {
+            slot_t* slots = bucket(key);
+            for(size_t i = 0; i < ways; ++i)
+            {
+                slot_t&  slot = slots[i];
+                uint64_t seq  = slot.seq.load(std::memory_order_acquire);
+                if(seq & 1)
+                    continue;
+                auto* solution = slot.solution.load(std::memory_order_relaxed);
+                bool  match    = solution && matches(slot, key);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if(match && slot.seq.load(std::memory_order_relaxed) == seq)
+                {
+                    m_hits.fetch_add(1, std::memory_order_relaxed);
+                    return solution;
+                }
+            }
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        // Cache the solution for key
+        void insert(const key_t& key, Tensile::ContractionSolution* solution)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            size_t                      index  = bucket_index(key);
+            slot_t*                     slots  = &m_slots[index * ways];
+            slot_t*                     victim = nullptr;
+            for(size_t i = 0; i < ways; ++i)
+            {
+                if(!slots[i].solution.load(std::memory_order_relaxed))
+                {
+                    if(!victim)
+                        victim = &slots[i];
+                }
+                else if(matches(slots[i], key))
+                    return; // Another thread inserted it first
+            }
+
+            if(victim)
+                m_entries.fetch_add(1, std::memory_order_relaxed);
+            else
+            {
+                victim = &slots[m_victims[index]++ % ways];
+                m_evictions.fetch_add(1, std::memory_order_relaxed);
+            }
+            write(*victim, key, solution);
+        }
+
+        // Remove all entries and reset the statistics
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for(size_t i = 0; i < m_capacity; ++i)
+                if(m_slots[i].solution.load(std::memory_order_relaxed))
+                    write(m_slots[i], {}, nullptr);
+            m_hits      = 0;
+            m_misses    = 0;
+            m_evictions = 0;
+            m_entries   = 0;
+        }
+
+        void get_stats(rocblas_solution_cache_stats& stats) const
+        {
+            stats.hits      = m_hits.load(std::memory_order_relaxed);
+            stats.misses    = m_misses.load(std::memory_order_relaxed);
+            stats.evictions = m_evictions.load(std::memory_order_relaxed);
+            stats.entries   = m_entries.load(std::memory_order_relaxed);
+            stats.capacity  = m_capacity;
+        }
+    };
+
+    /*******************************************************************
+     * Construct the SolutionCache key of a RocblasContractionProblem. *
+     * It covers everything ConstructTensileProblem uses to select a   *
+     * solution, except process-wide environment settings.             *
+     *******************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    SolutionCache::key_t SolutionCacheKey(const RocblasContractionProblem<Ti, To, Tc>& prob,
+                                          rocblas_performance_metric                   metric)
+    {
+        // Map value_category() results -1, 0, 1, 2 to 0, 1, 2, 3
+        auto category = [](double c) { return uint64_t(c + 1); };
+
+        bool alpha_zero = !prob.k || !*prob.alpha;
+        auto k          = alpha_zero ? 0 : prob.k;
+
+        uint64_t packed = uint64_t(tensile_datatype<Ti>) // 8 bits
+                          | uint64_t(tensile_datatype<To>) << 8 // 8 bits
+                          | uint64_t(tensile_datatype<Tc>) << 16 // 8 bits
+                          | uint64_t(prob.trans_a) << 24 // 8 bits
+                          | uint64_t(prob.trans_b) << 32 // 8 bits
+                          | uint64_t(prob.strided_batch) << 40
+                          | uint64_t(prob.C == prob.D) << 41
+                          | uint64_t(prob.handle->atomics_mode == rocblas_atomics_not_allowed) << 42
+                          | uint64_t(metric) << 44 // 4 bits
+                          | category(value_category(*prob.beta)) << 48 // 4 bits
+                          | (alpha_zero ? 0 : category(value_category(*prob.alpha))) << 52;
+
+        return {packed,
+                uint64_t(prob.flags),
+                prob.m,
+                prob.n,
+                k,
+                prob.batch_count,
+                prob.row_stride_a,
+                prob.col_stride_a,
+                prob.batch_stride_a,
+                prob.buffer_offset_a,
+                prob.row_stride_b,
+                prob.col_stride_b,
+                prob.batch_stride_b,
+                prob.buffer_offset_b,
+                prob.row_stride_c,
+                prob.col_stride_c,
+                prob.batch_stride_c,
+                prob.buffer_offset_c,
+                prob.row_stride_d,
+                prob.col_stride_d,
+                prob.batch_stride_d,
+                prob.buffer_offset_d,
+                TensileWorkspaceSize(prob.handle)};
+    }
+
     /*************************************************************************
      * Class for converting alpha and beta between rocBLAS and Tensile types *
      * By default, alpha and beta are the same type as Tc compute_type       *
@@ -208,9 +473,11 @@ namespace
 
     /****************************************************************
      * Construct a Tensile Problem from a RocblasContractionProblem *
+     * and the performance metric of its handle                     *
      ****************************************************************/
     template <typename Ti, typename To, typename Tc>
-    auto ConstructTensileProblem(const RocblasContractionProblem<Ti, To, Tc>& prob)
+    auto ConstructTensileProblem(const RocblasContractionProblem<Ti, To, Tc>& prob,
+                                 rocblas_performance_metric                   metric)
     {
         // Tensile DataTypes corresponding to rocBLAS data types
         static constexpr Tensile::DataType Tensile_Ti = tensile_datatype<Ti>;
@@ -312,11 +579,7 @@ namespace
                                     prob.buffer_offset_d};
 
         // Size of GSU workspace. We set it to max size_t if this is a size query.
-        size_t workspace_size
-            = prob.handle->is_device_memory_size_query()
-                  ? ~size_t{0}
-                  : (prob.handle->gsu_workspace_size / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
-                        * HPA_GSU_WORKSPACE_SIZE_GRANULARITY;
+        size_t workspace_size = TensileWorkspaceSize(prob.handle);
 
         // The ContractionProblem
         Tensile::ContractionProblem tensileProblem{a,
@@ -357,8 +620,6 @@ namespace
         // set batch mode
         tensileProblem.setStridedBatched(prob.strided_batch);
 
-        rocblas_performance_metric metric;
-        rocblas_get_performance_metric(prob.handle, &metric);
         //If flag is set use CUEfficiency performance metric
         if(prob.flags & rocblas_gemm_flags_use_cu_efficiency)
             tensileProblem.setPerformanceMetric(Tensile::PerformanceMetric::CUEfficiency);
@@ -438,6 +699,37 @@ namespace
         return inputs;
     }
 
+    // Whether Tensile code objects are loaded lazily, when ROCBLAS_TENSILE_LAZY_LOAD is set
+    bool TensileLazyLoad()
+    {
+#ifdef WIN32
+        return false;
+#else
+        static const bool lazy = [] {
+            const char* env = read_env("ROCBLAS_TENSILE_LAZY_LOAD");
+            return env && strtol(env, nullptr, 0);
+        }();
+        return lazy;
+#endif
+    }
+
+    // The interface of rocblas_lazy_code_objects to a Tensile SolutionAdapter
+    struct LazyCodeObjectAdapter
+    {
+        Tensile::hip::SolutionAdapter& adapter;
+
+        bool has_kernel(const std::string& name)
+        {
+            hipFunction_t kernel;
+            return adapter.getKernel(kernel, name) == hipSuccess;
+        }
+
+        void load_file(const std::string& path)
+        {
+            adapter.loadCodeObjectFile(path);
+        }
+    };
+
     /**************************************************
      * The TensileHost struct interfaces with Tensile *
      **************************************************/
@@ -453,6 +745,7 @@ namespace
         {
             mutable std::atomic<Tensile::hip::SolutionAdapter*> adapter{nullptr};
             mutable std::mutex                                  mutex;
+            mutable rocblas_lazy_code_objects                   code_objects;
         };
 
         // Each device contains an adapter
@@ -522,7 +815,9 @@ namespace
          * Initialize adapter and library according to environment variables *
          * and default paths based on librocblas.so location and GPU         *
          *********************************************************************/
-        void initialize(Tensile::hip::SolutionAdapter& adapter, rocblas_int deviceId)
+        void initialize(Tensile::hip::SolutionAdapter& adapter,
+                        rocblas_lazy_code_objects&     code_objects,
+                        rocblas_int                    deviceId)
         {
             std::string path;
 #ifndef WIN32
@@ -592,7 +887,8 @@ namespace
             // only load modules for the current architecture
             auto dir = path + "/*" + processor + "*co";
 
-            bool no_match = false;
+            bool                     no_match = false;
+            std::vector<std::string> codeObjectFiles;
 #ifdef WIN32
             std::replace(dir.begin(), dir.end(), '/', '\\');
             WIN32_FIND_DATAA finddata;
@@ -601,8 +897,7 @@ namespace
             {
                 do
                 {
-                    std::string codeObjectFile = path + "\\" + finddata.cFileName;
-                    adapter.loadCodeObjectFile(codeObjectFile.c_str());
+                    codeObjectFiles.push_back(path + "\\" + finddata.cFileName);
                 } while(FindNextFileA(hfine, &finddata));
             }
             else
@@ -616,7 +911,7 @@ namespace
             if(!g)
             {
                 for(size_t i = 0; i < glob_result.gl_pathc; ++i)
-                    adapter.loadCodeObjectFile(glob_result.gl_pathv[i]);
+                    codeObjectFiles.push_back(glob_result.gl_pathv[i]);
             }
             else if(g == GLOB_NOMATCH)
             {
@@ -635,6 +930,16 @@ namespace
             }
             globfree(&glob_result);
 #endif
+            // Load the code objects now, or when their kernels are first launched
+            bool        lazy    = TensileLazyLoad();
+            const char* preload = read_env("ROCBLAS_TENSILE_PRELOAD");
+            for(auto& codeObjectFile : codeObjectFiles)
+            {
+                if(!lazy || rocblas_lazy_code_objects::preload(codeObjectFile, processor, preload))
+                    adapter.loadCodeObjectFile(codeObjectFile);
+                else
+                    code_objects.add(std::move(codeObjectFile));
+            }
             if(no_match)
             {
                 static auto& once = rocblas_cerr
@@ -689,8 +994,9 @@ namespace
     auto& get_library_and_adapter(
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>>* library
         = nullptr,
-        std::shared_ptr<hipDeviceProp_t>* deviceProp = nullptr,
-        int                               device     = -1)
+        std::shared_ptr<hipDeviceProp_t>* deviceProp   = nullptr,
+        int                               device       = -1,
+        rocblas_lazy_code_objects**       code_objects = nullptr)
     try
     {
         // TensileHost is initialized on the first call
@@ -716,7 +1022,7 @@ namespace
                 adapter = new Tensile::hip::SolutionAdapter;
 
                 // Initialize the adapter and possibly the library
-                host.initialize(*adapter, device);
+                host.initialize(*adapter, a.code_objects, device);
 
                 // Atomically change the adapter stored for this device ID
                 a.adapter.store(adapter, std::memory_order_release);
@@ -728,6 +1034,8 @@ namespace
             *library = host.get_library();
         if(deviceProp)
             *deviceProp = host.get_device_property();
+        if(code_objects)
+            *code_objects = &a.code_objects;
 
         return *adapter;
     }
@@ -745,6 +1053,13 @@ namespace
         rocblas_abort();
     }
 
+    // Return the solution cache for a HIP device
+    SolutionCache& get_solution_cache(int device)
+    {
+        static std::vector<SolutionCache> caches(TensileHost::GetDeviceCount());
+        return caches.at(device);
+    }
+
     /**************************************************************************
     * We normally print error messages only once, to avoid excessive logging *
     **************************************************************************/
@@ -774,23 +1089,42 @@ namespace
 template <typename Ti, typename To, typename Tc>
 rocblas_status runContractionProblem(const RocblasContractionProblem<Ti, To, Tc>& prob)
 {
-    rocblas_status                                status = rocblas_status_internal_error;
-    std::shared_ptr<Tensile::ContractionSolution> solution;
+    rocblas_status                status   = rocblas_status_internal_error;
+    Tensile::ContractionSolution* solution = nullptr;
 
     try
     {
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>> library;
         std::shared_ptr<hipDeviceProp_t>                                             deviceProp;
         std::shared_ptr<Tensile::Hardware>                                           hardware;
+        rocblas_lazy_code_objects*                                                   code_objects;
 
-        auto& adapter = get_library_and_adapter(&library, &deviceProp, prob.handle->getDevice());
+        auto& adapter = get_library_and_adapter(
+            &library, &deviceProp, prob.handle->getDevice(), &code_objects);
 
         hardware            = Tensile::hip::GetDevice(*deviceProp);
-        auto  tensile_prob  = ConstructTensileProblem(prob);
         auto  handle        = prob.handle;
+        auto  metric        = handle->performance_metric;
+        auto  tensile_prob  = ConstructTensileProblem(prob, metric);
         auto* fitness_query = handle->get_solution_fitness_query();
 
-        solution = library->findBestSolution(tensile_prob, *hardware, fitness_query);
+        // Look up the solution in the device's cache, unless the fitness of
+        // the selection is being queried, which requires findBestSolution
+        auto&                cache     = get_solution_cache(handle->getDevice());
+        bool                 use_cache = cache.enabled() && !fitness_query;
+        SolutionCache::key_t key;
+        if(use_cache)
+        {
+            key      = SolutionCacheKey(prob, metric);
+            solution = cache.lookup(key);
+        }
+
+        if(!solution)
+        {
+            solution = library->findBestSolution(tensile_prob, *hardware, fitness_query).get();
+            if(solution && use_cache)
+                cache.insert(key, solution);
+        }
 
         if(!solution)
         {
@@ -812,11 +1146,11 @@ rocblas_status runContractionProblem(const RocblasContractionProblem<Ti, To, Tc>
             }
             else
             {
+                auto kernels = solution->solve(tensile_prob, GetTensileInputs(prob), *hardware);
+                LazyCodeObjectAdapter lazy_adapter{adapter};
+                code_objects->load(lazy_adapter, kernels);
                 adapter.launchKernels(
-                    solution->solve(tensile_prob, GetTensileInputs(prob), *hardware),
-                    handle->get_stream(),
-                    handle->startEvent,
-                    handle->stopEvent);
+                    kernels, handle->get_stream(), handle->startEvent, handle->stopEvent);
                 status = rocblas_status_success;
             }
         }
@@ -846,6 +1180,38 @@ extern "C" void rocblas_initialize()
     get_library_and_adapter();
 }
 
+/*******************************************************************************
+ * Solution cache statistics
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_solution_cache_stats(rocblas_handle                handle,
+                                                           rocblas_solution_cache_stats* stats)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!stats)
+        return rocblas_status_invalid_pointer;
+    get_solution_cache(handle->getDevice()).get_stats(*stats);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status rocblas_clear_solution_cache(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    get_solution_cache(handle->getDevice()).clear();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /******************************************************************************
  * Intantiate the cases of runContractionProblem which are needed to satisfy  *
  * rocBLAS dependencies. This file's template functions are not defined in a  *
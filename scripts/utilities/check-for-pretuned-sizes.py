@@ -40,6 +40,8 @@ Options:
 --help   Displays this message.
 NOTE: Flags cannot currently be combined together as in -lu, they must be specified
 separately in the form -l -u
+NOTE: For large logs, the rocblas-tensile-index client indexes the logic files of a
+checkout once, and reports exact and fallback sizes with their expected GFLOPS.
 """
 
 usageMessage = """Usage: